@@ -0,0 +1,323 @@
+// Z8000 CPU Core Benchmarks
+// Canned guest workloads timed with Google Benchmark.  Each iteration runs
+// one slice of guest cycles; besides host time every benchmark reports
+// emulated MIPS, host nanoseconds per guest instruction and guest cycles
+// per second.  Run through the interpreter (blocks:0) and the block cache
+// (blocks:1).
+//
+// --replay=<binary>,<recording> adds a benchmark that runs the binary from
+// reset against an I/O recording made with z8000emu --record, once per
+// iteration, so a captured production run times the same on every build.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <z8000/z8000.h>
+#include <z8000/z8000_replay.h>
+
+#include "memory.h"
+
+namespace {
+
+constexpr uint64_t SLICE = 1000000;     // guest cycles per iteration
+
+struct Workload {
+    bool segmented;
+    void (*build)(MemoryRegion& mem);
+    void (*attach)(z8002_device& cpu) = nullptr;    // devices, if any
+};
+
+void put(MemoryRegion& mem, uint32_t addr, std::initializer_list<uint16_t> words) {
+    for (uint16_t w : words) {
+        mem.write_word(addr, w);
+        addr += 2;
+    }
+}
+
+// Z8002 reset vector: system mode, entry at 0x0100
+void reset_z8002(MemoryRegion& mem) {
+    put(mem, 0x0002, { 0x4000, 0x0100 });
+}
+
+// Register-only arithmetic and logic
+void build_alu(MemoryRegion& mem) {
+    reset_z8002(mem);
+    put(mem, 0x0100, {
+        0x2101, 0x0000,     // ld   r1,#0
+        0x2102, 0x0001,     // ld   r2,#1
+        0x8121,             // 0108: add r1,r2
+        0x8913,             // xor  r3,r1
+        0x8734,             // and  r4,r3
+        0x8345,             // sub  r5,r4
+        0xA920,             // inc  r2,#1
+        0xB310,             // rl   r1,#1
+        0xE8F9,             // jr   0108
+    });
+}
+
+// 4KB block copies with LDIR
+void build_ldir(MemoryRegion& mem) {
+    reset_z8002(mem);
+    put(mem, 0x0100, {
+        0x2101, 0x2000,     // 0100: ld r1,#2000
+        0x2102, 0x1000,     // ld   r2,#1000
+        0x2103, 0x0800,     // ld   r3,#0800
+        0xBB21, 0x0310,     // ldir @r1,@r2,r3
+        0xE8F7,             // jr   0100
+    });
+    for (uint32_t addr = 0x1000; addr < 0x2000; addr += 2)
+        mem.write_word(addr, addr * 0x9E37);
+}
+
+// Binary recursion, depth 12: 8191 calls per round
+void build_calls(MemoryRegion& mem) {
+    reset_z8002(mem);
+    put(mem, 0x0100, {
+        0x210F, 0xFE00,     // ld   r15,#FE00
+        0x2100, 0x000C,     // 0104: ld r0,#12
+        0x5F00, 0x0200,     // call 0200
+        0xE8FB,             // jr   0104
+    });
+    put(mem, 0x0200, {
+        0x8D04,             // 0200: test r0
+        0x9E06,             // ret  eq
+        0xAB00,             // dec  r0,#1
+        0x93F0,             // push @r15,r0
+        0xD005,             // calr 0200
+        0x97F0,             // pop  r0,@r15
+        0x93F0,             // push @r15,r0
+        0xD008,             // calr 0200
+        0x97F0,             // pop  r0,@r15
+        0x9E08,             // ret
+    });
+}
+
+// Packed BCD counters: ADDB followed by DAB
+void build_bcd(MemoryRegion& mem) {
+    reset_z8002(mem);
+    put(mem, 0x0100, {
+        0xC900,             // ldb  rl1,#00
+        0xCA01,             // ldb  rl2,#01
+        0xC300,             // ldb  rh3,#00
+        0x80A9,             // 0106: addb rl1,rl2
+        0xB090,             // dab  rl1
+        0x8093,             // addb rh3,rl1
+        0xB030,             // dab  rh3
+        0xE8FB,             // jr   0106
+    });
+}
+
+// Z8001 segmented mode: long calls into two other segments
+void build_far_calls(MemoryRegion& mem) {
+    put(mem, 0x0002, { 0xC000, 0x8000, 0x0100 });  // segmented system mode, <<00>>0100
+    put(mem, 0x0100, {
+        0x140E, 0x0000, 0xF000,     // ldl  rr14,#<<00>>F000
+        0x5F00, 0x8100, 0x0000,     // 0106: call <<01>>0000
+        0x5F00, 0x8200, 0x0100,     // call <<02>>0100
+        0xE8F9,                     // jr   0106
+    });
+    put(mem, 0x10000, {
+        0xA910,             // inc  r1,#1
+        0x9E08,             // ret
+    });
+    put(mem, 0x20100, {
+        0xA112,             // ld   r2,r1
+        0x8122,             // add  r2,r2
+        0x9E08,             // ret
+    });
+}
+
+// Back-to-back system calls: trap entry through the PSA and IRET
+void build_traps(MemoryRegion& mem) {
+    reset_z8002(mem);
+    put(mem, 0x0100, {
+        0x210F, 0xFE00,     // ld   r15,#FE00
+        0x2101, 0x0400,     // ld   r1,#0400
+        0x7D1D,             // ldctl psap,r1
+        0x7F01,             // 010A: sc #1
+        0xA920,             // inc  r2,#1
+        0xE8FD,             // jr   010A
+    });
+    put(mem, 0x040C, { 0x4000, 0x0200 });      // SC vector: FCW, PC
+    put(mem, 0x0200, {
+        0xA930,             // inc  r3,#1
+        0x7B00,             // iret
+    });
+}
+
+// A serial controller's worth of vectored interrupts: one every 200
+// cycles, cycling through 16 vectors, into a handler that counts and
+// returns
+void build_interrupts(MemoryRegion& mem) {
+    put(mem, 0x0002, { 0x5000, 0x0100 });      // system mode, VI enabled
+    put(mem, 0x0100, {
+        0x210F, 0xFE00,     // ld   r15,#FE00
+        0x2101, 0x0400,     // ld   r1,#0400
+        0x7D1D,             // ldctl psap,r1
+        0xA920,             // 010A: inc r2,#1
+        0xE8FE,             // jr   010A
+    });
+    put(mem, 0x041C, { 0x4000 });               // VI: FCW, then a PC per vector
+    for (uint32_t vector = 0; vector < 16; vector++)
+        put(mem, 0x041E + 2 * vector, { 0x0200 });
+    put(mem, 0x0200, {
+        0xA930,             // inc  r3,#1
+        0x7B00,             // iret
+    });
+}
+
+// Assert VI and drop it at the next boundary, once the CPU has taken it
+void vi_pulse(z8002_device& cpu, uint64_t due, uint16_t vector) {
+    cpu.set_input_line(z8002_device::VI_LINE, ASSERT_LINE, vector);
+    cpu.schedule_event(cpu.get_cycles() + 1, [&cpu](uint64_t) {
+        cpu.set_input_line(z8002_device::VI_LINE, CLEAR_LINE);
+    });
+    cpu.schedule_event(due + 200, [&cpu, vector](uint64_t next) {
+        vi_pulse(cpu, next, (vector + 1) & 15);
+    });
+}
+
+void attach_interrupts(z8002_device& cpu) {
+    cpu.schedule_event(200, [&cpu](uint64_t due) { vi_pulse(cpu, due, 0); });
+}
+
+void run_workload(benchmark::State& state, Workload workload) {
+    MemoryRegion mem(workload.segmented ? 0x800000 : 0x10000);
+    IOPorts io;
+    workload.build(mem);
+
+    std::unique_ptr<z8002_device> cpu(workload.segmented ? new z8001_device() : new z8002_device());
+    cpu->set_memory(&mem);
+    cpu->set_io(&io);
+    cpu->set_block_cache(state.range(0));
+    cpu->reset();
+    if (workload.attach)
+        workload.attach(*cpu);
+
+    // Instructions per cycle from one profiled slice; the workloads are
+    // steady-state loops, so the ratio holds for the timed slices.  Each
+    // element of a repeating instruction counts as an instruction.
+    cpu->set_profile(z8000_profile::OPCODES);
+    cpu->run_until(SLICE);
+    uint64_t calibration = 0;
+    for (const z8000_profile::counter& c : cpu->get_profile().opcodes)
+        calibration += c.count;
+    const double per_cycle = double(calibration) / cpu->get_cycles();
+    cpu->set_profile(0);
+
+    uint64_t cycles = 0;
+    const auto begin = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        const uint64_t start = cpu->get_cycles();
+        cpu->run_until(start + SLICE);
+        cycles += cpu->get_cycles() - start;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    if (cpu->is_halted())
+        state.SkipWithError("guest halted");
+
+    const double insns = cycles * per_cycle;
+    state.counters["MIPS"] = insns / seconds * 1e-6;
+    state.counters["ns/insn"] = seconds * 1e9 / insns;
+    state.counters["cycles/s"] = benchmark::Counter(cycles, benchmark::Counter::kIsRate);
+}
+
+struct Replay {
+    std::string binary;
+    std::string recording;
+};
+
+void run_replay(benchmark::State& state, Replay replay) {
+    const bool segmented = z8000_io_replayer::recorded_model(replay.recording.c_str()) == 8001;
+    MemoryRegion mem(segmented ? 0x800000 : 0x10000);
+    size_t len;
+    if (const char* error = mem.load_file(0, replay.binary.c_str(), len)) {
+        state.SkipWithError(error);
+        return;
+    }
+    mem.snapshot();
+
+    std::unique_ptr<z8002_device> cpu(segmented ? new z8001_device() : new z8002_device());
+    z8000_io_replayer io(*cpu);
+    if (const char* error = io.open(replay.recording.c_str())) {
+        state.SkipWithError(error);
+        return;
+    }
+    cpu->set_memory(&mem);
+    cpu->set_io(&io);
+    cpu->set_block_cache(state.range(0));
+
+    // Instruction count from one profiled pass, the same for every pass
+    cpu->set_profile(z8000_profile::OPCODES);
+    cpu->reset();
+    io.start();
+    cpu->run_until(io.end_cycle());
+    uint64_t insns_per_pass = 0;
+    for (const z8000_profile::counter& c : cpu->get_profile().opcodes)
+        insns_per_pass += c.count;
+    cpu->set_profile(0);
+
+    uint64_t cycles = 0, passes = 0;
+    const auto begin = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        mem.restore();
+        cpu->invalidate_block_cache();  // restore() rewrote memory behind the CPU's back
+        cpu->reset();
+        io.start();
+        cpu->run_until(io.end_cycle());
+        cycles += cpu->get_cycles();
+        passes++;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    if (io.diverged())
+        state.SkipWithError("replay diverged from the recording");
+
+    const double insns = double(insns_per_pass) * passes;
+    state.counters["MIPS"] = insns / seconds * 1e-6;
+    state.counters["ns/insn"] = seconds * 1e9 / insns;
+    state.counters["cycles/s"] = benchmark::Counter(cycles, benchmark::Counter::kIsRate);
+}
+
+#define Z8000_BENCH(name, segmented, build, ...) \
+    BENCHMARK_CAPTURE(run_workload, name, Workload{segmented, build, ##__VA_ARGS__}) \
+        ->ArgName("blocks")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->MinTime(0.5)
+
+Z8000_BENCH(alu, false, build_alu);
+Z8000_BENCH(ldir, false, build_ldir);
+Z8000_BENCH(calls, false, build_calls);
+Z8000_BENCH(bcd, false, build_bcd);
+Z8000_BENCH(far_calls, true, build_far_calls);
+Z8000_BENCH(traps, false, build_traps);
+Z8000_BENCH(interrupts, false, build_interrupts, attach_interrupts);
+
+} // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    // What Initialize() left over is ours
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* comma = strchr(arg, ',');
+        if (strncmp(arg, "--replay=", 9) != 0 || !comma) {
+            fprintf(stderr, "%s: unknown argument '%s'; expected --replay=<binary>,<recording>\n",
+                    argv[0], arg);
+            return 1;
+        }
+        Replay replay{ std::string(arg + 9, comma), std::string(comma + 1) };
+        const std::string name = "run_replay/" + replay.recording.substr(replay.recording.find_last_of('/') + 1);
+        benchmark::RegisterBenchmark(name.c_str(), run_replay, replay)
+            ->ArgName("blocks")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->MinTime(0.5);
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
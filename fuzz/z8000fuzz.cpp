@@ -0,0 +1,192 @@
+// Z8000 Fuzzing Entry Point
+// libFuzzer target over the CPU core.  Each input is a z8000emu binary:
+// it is loaded at address 0 of a memory region kept for the whole
+// session and run from reset for a bounded number of cycles.  Between
+// inputs the memory goes back to its blank snapshot and the CPU to the
+// state it was saved in after reset, so no input sees another's
+// registers or stores and nothing is allocated per input.
+//
+// The feedback is handler coverage: how often each opcode table entry
+// ran and each kind of trap or interrupt was taken, from the profiler,
+// handed to libFuzzer as extra counters.  Build the library with
+// -fsanitize=fuzzer-no-link to add edge coverage inside the handlers.
+//
+// Options, which libFuzzer passes through because of the double dash:
+//   --segmented    run a Z8001 with 8MB of memory instead of a Z8002
+//   --cycles=<n>   cycles per input (default: 2000)
+//
+// Without libFuzzer, main() below runs the files and directories named
+// on the command line through the same entry point, -runs=<n> times
+// over, and reports the coverage and executions per second.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <z8000/z8000.h>
+
+#include "memory.h"
+
+namespace {
+
+constexpr uint64_t CYCLES = 2000;       // default cycles per input
+constexpr size_t MAX_HANDLERS = 1024;   // opcode table entries, with room
+
+// One counter per opcode table entry, then one per TRAP_* kind; cleared
+// by libFuzzer before each input
+#ifdef Z8000_LIBFUZZER
+__attribute__((used, section("__libfuzzer_extra_counters")))
+#endif
+uint8_t coverage[MAX_HANDLERS + z8000_profile::TRAP_KINDS];
+
+struct Harness {
+    explicit Harness(bool segmented)
+        : memory(segmented ? 0x800000 : 0x10000)
+        , cpu(segmented ? new z8001_device() : new z8002_device()) {
+        cpu->set_memory(&memory);
+        cpu->set_io(&io);
+        cpu->set_profile(z8000_profile::OPCODES | z8000_profile::TRAPS);
+        if (cpu->get_profile().opcodes.size() > MAX_HANDLERS) {
+            fprintf(stderr, "z8000fuzz: opcode table larger than MAX_HANDLERS\n");
+            abort();
+        }
+        cpu->reset();
+        cpu->save_state(reset_state);
+        memory.snapshot();
+    }
+
+    void run(const uint8_t* data, size_t size) {
+        memory.restore();
+        io.clear();
+        memory.load(0, data, size < memory.size() ? size : memory.size());
+        cpu->load_state(reset_state);
+        cpu->clear_profile();
+        cpu->run_until(cpu->get_cycles() + cycles);
+
+        const z8000_profile& prof = cpu->get_profile();
+        for (size_t i = 0; i < prof.opcodes.size(); i++)
+            coverage[i] = saturate(prof.opcodes[i].count);
+        for (unsigned i = 0; i < z8000_profile::TRAP_KINDS; i++)
+            coverage[MAX_HANDLERS + i] = saturate(prof.traps[i]);
+    }
+
+    static uint8_t saturate(uint64_t count) { return count < 255 ? uint8_t(count) : 255; }
+
+    MemoryRegion memory;
+    IOPorts io;
+    std::unique_ptr<z8002_device> cpu;
+    z8000_state reset_state;
+    uint64_t cycles = CYCLES;
+};
+
+std::unique_ptr<Harness> harness;
+
+} // anonymous namespace
+
+extern "C" int LLVMFuzzerInitialize(int* argc, char*** argv) {
+    bool segmented = false;
+    uint64_t cycles = CYCLES;
+    for (int i = 1; i < *argc; i++) {
+        const char* arg = (*argv)[i];
+        if (!strcmp(arg, "--segmented"))
+            segmented = true;
+        else if (!strncmp(arg, "--cycles=", 9))
+            cycles = strtoull(arg + 9, nullptr, 0);
+    }
+    harness.reset(new Harness(segmented));
+    harness->cycles = cycles ? cycles : CYCLES;
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    harness->run(data, size);
+    return 0;
+}
+
+#ifndef Z8000_LIBFUZZER
+
+namespace {
+
+void add_inputs(const std::string& path, std::vector<std::vector<uint8_t>>& inputs) {
+    struct stat st;
+    if (stat(path.c_str(), &st) < 0) {
+        fprintf(stderr, "z8000fuzz: cannot open %s\n", path.c_str());
+        return;
+    }
+    if (S_ISDIR(st.st_mode)) {
+        DIR* dir = opendir(path.c_str());
+        if (!dir)
+            return;
+        while (const dirent* entry = readdir(dir))
+            if (entry->d_name[0] != '.')
+                add_inputs(path + "/" + entry->d_name, inputs);
+        closedir(dir);
+        return;
+    }
+
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f)
+        return;
+    std::vector<uint8_t> data(st.st_size);
+    if (fread(data.data(), 1, data.size(), f) == data.size())
+        inputs.push_back(std::move(data));
+    fclose(f);
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    LLVMFuzzerInitialize(&argc, &argv);
+
+    unsigned runs = 1;
+    std::vector<std::vector<uint8_t>> inputs;
+    for (int i = 1; i < argc; i++) {
+        if (!strncmp(argv[i], "-runs=", 6))
+            runs = strtoul(argv[i] + 6, nullptr, 0);
+        else if (argv[i][0] != '-')
+            add_inputs(argv[i], inputs);
+    }
+    if (inputs.empty()) {
+        fprintf(stderr, "Usage: %s [--segmented] [--cycles=<n>] [-runs=<n>] <file|dir>...\n", argv[0]);
+        return 1;
+    }
+
+    // Coverage of the whole set, as libFuzzer would accumulate it
+    std::vector<bool> seen(sizeof(coverage));
+    const auto begin = std::chrono::steady_clock::now();
+    for (unsigned run = 0; run < runs; run++) {
+        for (const std::vector<uint8_t>& input : inputs) {
+            memset(coverage, 0, sizeof(coverage));
+            LLVMFuzzerTestOneInput(input.data(), input.size());
+            for (size_t i = 0; i < sizeof(coverage); i++)
+                if (coverage[i])
+                    seen[i] = true;
+        }
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    static const char* const trap_names[z8000_profile::TRAP_KINDS] = {
+        "reset", "extended", "privileged", "system_call", "segment", "nmi", "nvi", "vi"
+    };
+    const size_t handlers = harness->cpu->get_profile().opcodes.size();
+    size_t covered = 0;
+    for (size_t i = 0; i < handlers; i++)
+        covered += seen[i];
+    printf("%zu inputs, %u runs: %zu of %zu handlers, traps:", inputs.size(), runs, covered, handlers);
+    for (unsigned i = 0; i < z8000_profile::TRAP_KINDS; i++)
+        if (seen[MAX_HANDLERS + i])
+            printf(" %s", trap_names[i]);
+    printf("\n%.0f execs/s\n", inputs.size() * runs / seconds);
+    return 0;
+}
+
+#endif // Z8000_LIBFUZZER
@@ -180,6 +180,51 @@ void stream_format(std::ostream& stream, const char* fmt, Args... args) {
     stream << buf;
 }
 
+// text_appender - non-allocating text output into a caller's char array,
+// kept NUL-terminated; what does not fit is dropped
+class text_appender {
+public:
+    text_appender(char* buf, size_t size) : m_buf(buf), m_size(size), m_len(0) { buf[0] = 0; }
+
+    text_appender& operator<<(char c) {
+        if (m_len + 1 < m_size) {
+            m_buf[m_len++] = c;
+            m_buf[m_len] = 0;
+        }
+        return *this;
+    }
+
+    void append(const char* s) {
+        while (*s && m_len + 1 < m_size)
+            m_buf[m_len++] = *s++;
+        m_buf[m_len] = 0;
+    }
+
+    template<typename... Args>
+    void format(const char* fmt, Args... args) {
+        const int n = snprintf(m_buf + m_len, m_size - m_len, fmt, args...);
+        if (n > 0)
+            m_len += (size_t(n) < m_size - m_len) ? size_t(n) : m_size - m_len - 1;
+    }
+
+    const char* c_str() const { return m_buf; }
+    size_t size() const { return m_len; }
+
+private:
+    char* m_buf;
+    size_t m_size;
+    size_t m_len;
+};
+
+// stream_format straight into a text_appender, without the bounce buffer
+template<typename... Args>
+void stream_format(text_appender& out, const char* fmt, Args... args) {
+    if constexpr (sizeof...(args) > 0)
+        out.format(fmt, args...);
+    else
+        out.append(fmt);
+}
+
 // Disassembler interface base class
 class disasm_interface {
 public:
@@ -33,9 +33,19 @@
 #ifndef Z8000_H
 #define Z8000_H
 
+#include <array>
+#include <utility>
+#include <vector>
+
 #include <z8000/emu.h>
 #include <z8000/z8000_intf.h>
 #include <z8000/z8000dasm.h>
+#include <z8000/z8000_debug.h>
+#include <z8000/z8000_memstats.h>
+#include <z8000/z8000_mmu.h>
+#include <z8000/z8000_profile.h>
+#include <z8000/z8000_sched.h>
+#include <z8000/z8000_trace.h>
 
 // Register indices
 enum {
@@ -49,6 +59,41 @@ enum {
     Z8000_R12, Z8000_R13, Z8000_R14, Z8000_R15
 };
 
+// Complete CPU state for save_state()/load_state().  Plain data with
+// fixed-size fields and explicit padding, so a checkpoint can be written
+// to disk and mapped back in; fields are in host byte order.  Bump
+// VERSION whenever the layout or meaning of a field changes.
+struct z8000_state {
+    static constexpr uint32_t MAGIC = 0x5a384b53;  // "Z8KS"
+    static constexpr uint16_t VERSION = 2;
+
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;          // sizeof(z8000_state)
+    uint16_t model;         // 8001 or 8002
+    uint8_t  halted;
+    uint8_t  irq_req;       // pending reset/interrupt/trap requests
+    uint16_t fcw;           // flags always materialised
+    uint16_t refresh;
+    uint16_t psapseg, psapoff;
+    uint16_t nspseg, nspoff;
+    uint16_t irq_vec;
+    uint16_t regs[16];      // R0..R15
+    uint16_t irq_ident[3];  // NVI, VI, NMI identifiers from set_input_line()
+    uint32_t pc, ppc;
+    uint32_t op[4];         // current instruction words
+    uint32_t op_valid;
+    int32_t  nmi_state;
+    int32_t  irq_state[2];  // NVI, VI line states
+    int32_t  mi;
+    int32_t  pad0;
+    uint64_t total_cycles;
+};
+
+// Thread safety: the opcode, flag and disassembler tables are constexpr and
+// the core has no other static state, so separate CPU instances (each with
+// its own buses) can run concurrently on different threads.  A single
+// instance must only be used from one thread at a time.
 class z8002_device : public z8000_disassembler::config {
 protected:
     /* Interrupt Types that can be generated by outside sources */
@@ -68,6 +113,22 @@ public:
         NMI_LINE = INPUT_LINE_NMI
     };
 
+    // Why run_until() returned
+    enum class stop_reason {
+        budget,         // reached target_cycle
+        halt,           // CPU executed HALT (or request_halt())
+        breakpoint,     // stopped at a breakpoint
+        watchpoint,     // stopped after a watched access
+        request,        // request_stop() was called
+        no_bus          // no program memory or I/O attached
+    };
+
+    struct run_result {
+        stop_reason reason;
+        uint64_t cycles;        // cycles executed by this call
+        int64_t overshoot;      // get_cycles() - target_cycle; negative if stopped early
+    };
+
     // Construction/destruction
     z8002_device();
     virtual ~z8002_device();
@@ -91,16 +152,176 @@ public:
     // Enable register tracing (dump after each instruction)
     void set_reg_trace(bool enable) { m_reg_trace = enable; }
 
+    // Send instruction and register traces to sink as binary records
+    // instead of printing them; nullptr goes back to printf.  The next
+    // register record after this call carries all registers.
+    void set_trace_sink(z8000_trace_sink* sink) { m_trace_sink = sink; m_trace_mask = 0xffff; }
+
+    // Profile execution: modes is a set of z8000_profile::OPCODES, PCS and
+    // CALLS, or 0 to stop.  The PC histogram takes one sample every
+    // pc_period instructions.  Clears the counters collected so far.
+    // Like tracing, profiling bypasses the block cache.
+    void set_profile(unsigned modes, unsigned pc_period = 1);
+    const z8000_profile& get_profile() const { return m_profile; }
+
+    // Zero the counters in place, keeping the modes; unlike set_profile()
+    // this allocates nothing, for harnesses that reset between short runs
+    void clear_profile();
+
+    // Write the profile as CSV, or as one JSON object if json is set
+    void write_profile(FILE* out, bool json) const;
+
+    // Count memory accesses by page in stats (z8000_memstats.h), or stop
+    // with nullptr.  Each space, and instruction fetches, then goes
+    // through a counting bus without the page map fast path; the block
+    // cache and idle skipping stand down so that every access is made.
+    // stats must stay alive while set.
+    void set_memory_stats(z8000_memory_stats* stats);
+
+    // Enable the pre-decoded basic-block cache used by run().
+    // Blocks on a page are dropped when the CPU writes to that page; call
+    // invalidate_block_cache() after modifying program memory behind the
+    // CPU's back (loading code, DMA, aliased mappings).
+    void set_block_cache(bool enable);
+    void invalidate_block_cache();
+
+    // Drop only the blocks on the pages of [addr, addr + len), program
+    // addresses as the bus sees them, for a store made behind the CPU's
+    // back into a known range
+    void invalidate_code(uint32_t addr, uint32_t len);
+
+    // The NVI and VI vectors are read from the program status area once
+    // and kept until the CPU stores to the area's pages or the PSAP
+    // changes.  The two calls above and reset() also drop them, so
+    // vectors changed behind the CPU's back are covered alike.  Memory
+    // statistics, memory watches and the MMU read them every time.
+
+    // Second tier of the block cache: a block that has run hot times has
+    // its register loads, word arithmetic and logic, INC/DEC and JR/DJNZ
+    // translated to micro-ops with the operands decoded, which run
+    // without a handler call; other instructions keep calling theirs.  A
+    // translated block that branches back to its own start loops without
+    // another lookup.  0 leaves every block untranslated.
+    static constexpr unsigned BLOCK_HOT = 64;
+    void set_block_hot_threshold(unsigned hot) { m_block_hot = hot; }
+
+    // Idle skipping.  With IDLE_SPIN, a JR or JP that jumps to itself and
+    // a DJNZ or DBJNZ that loops on itself are not executed one repeat at
+    // a time: the repeats up to the next event or the end of the run are
+    // charged at once, and a counted loop leaves its register as the
+    // repeats would have.  With IDLE_POLL, a short loop that gets back to
+    // its closing branch with all registers and flags unchanged, having
+    // only read memory and ports, is skipped the same way.  IDLE_POLL
+    // assumes that what the loop reads changes only through device events
+    // and interrupts, not with each read or with the cycle count; the
+    // skipped reads do not reach the bus, so record and replay with the
+    // same setting.  Either way the run ends on the same instruction
+    // boundary at the same cycle as without skipping, and an interrupt is
+    // taken where it would have been.  Skipping stands down for tracing,
+    // profiling, breakpoints and step(), and for run(-1) with no event
+    // scheduled, when nothing could end the wait.
+    static constexpr unsigned IDLE_SPIN = 1 << 0;
+    static constexpr unsigned IDLE_POLL = 1 << 1;
+    static constexpr unsigned IDLE_ALL  = IDLE_SPIN | IDLE_POLL;
+    void set_idle_skip(unsigned modes);
+    uint64_t get_idle_cycles() const { return m_idle_cycles; }  // skipped so far
+
     // CPU control
     void reset();
     void run(int max_cycles = -1);  // -1 = run until halt
     int step();  // Execute one instruction, return cycles consumed
     bool is_halted() const { return m_halt; }
+    bool interrupt_pending() const { return m_irq_req != 0; }  // taken at the next boundary
     void request_halt() { m_halt = true; }
 
+    // Run until the total cycle count reaches target_cycle.  Instructions
+    // are not split, so the run ends on the first instruction boundary at
+    // or past the target; the excess is reported in run_result::overshoot
+    // and already counted in get_cycles().
+    run_result run_until(uint64_t target_cycle);
+
+    // Let a CPU that is halted with no interrupt pending wait until
+    // target_cycle, as its HALT would while the rest of a system runs on:
+    // the clock moves forward and events due on the way fire.  Returns
+    // early when an event raises an interrupt, at once if not halted.
+    void wait_until(uint64_t target_cycle);
+
+    // End the current run()/run_until() at the next instruction boundary.
+    // Meant for bus and device callbacks invoked while the CPU runs.
+    void request_stop() { m_stop_req = true; m_icount = 0; }
+
+    // Drive an interrupt input: line is NVI_LINE, VI_LINE or NMI_LINE,
+    // state ASSERT_LINE or CLEAR_LINE.  NVI and VI are level-sensitive and
+    // are taken while asserted and enabled in the FCW, so a device holds
+    // its line until the handler has dealt with it; NMI is taken once per
+    // assertion.  vector is the identifier word the device returns on
+    // acknowledge: it is pushed on the system stack, and for VI its low
+    // byte selects the PSA entry.
+    // Call it between run() slices or from a bus callback during a run.
+    // Pending requests are checked at every instruction boundary, so an
+    // interrupt raised mid-slice is taken before the next instruction
+    // rather than when the slice ends.
+    void set_input_line(int line, int state, uint16_t vector = 0);
+
+    // Interrupts taken from each line (NVI_LINE, VI_LINE, NMI_LINE) and
+    // their latency: the cycles from the line's assertion to the first
+    // instruction of its handler, or from the previous acknowledge for a
+    // line held asserted.  Time spent masked counts.  Not cleared by
+    // reset().
+    struct irq_stats {
+        uint64_t count;
+        uint64_t latency;       // summed over count
+        uint64_t max_latency;
+    };
+    const irq_stats& get_irq_stats(int line) const { return m_irq_stats[line]; }
+    void clear_irq_stats();
+
+    // Device events.  cb runs at the first instruction boundary at or past
+    // cycle, an absolute get_cycles() count: run() and run_until() execute
+    // exactly up to the earliest deadline, fire what is due and continue,
+    // and step() fires what its instruction made due.  Callbacks may raise
+    // interrupt lines, which are taken before the next instruction, and
+    // schedule further events; scheduling from a bus callback shortens the
+    // slice running at the time if the new deadline comes first.  While
+    // the CPU is halted run_until() and run(n) move the clock to the next
+    // event before the target, as a HALT waits for a device to interrupt
+    // it; run(-1) still returns on HALT.  Events belong to the devices and
+    // are neither reset nor part of z8000_state.
+    uint64_t schedule_event(uint64_t cycle, z8000_scheduler::callback cb);
+    bool cancel_event(uint64_t id) { return m_events.cancel(id); }
+    uint64_t next_event() const { return m_events.next(); }     // NEVER if none
+
+    // Breakpoints and watchpoints.  run() and run_until() stop before an
+    // instruction at a breakpoint, pc as get_pc() reports it, and after
+    // an instruction that makes a watched memory or I/O access; access is
+    // a set of z8000_debug_hit::READ and WRITE.  get_debug_hit() tells
+    // which point fired; it is cleared when the next run or step starts.
+    // Running on from a breakpoint executes its instruction, and a
+    // repeating instruction stops there once rather than per element.
+    // An instruction branching to itself stops at its breakpoint on every
+    // pass.
+    // Memory watches see addresses as the buses do, physical with the MMU
+    // on; I/O watches cover one port space.  step() executes regardless
+    // of breakpoints.  Only pages holding a point are searched: with
+    // breakpoints set the run loop checks a page bitmap before each
+    // instruction and the block cache stands down, and with memory
+    // watches set data accesses leave the page map for a check of the
+    // same kind, so a few points cost little next to tracing.
+    int add_breakpoint(uint32_t pc);
+    int add_watchpoint(uint32_t first, uint32_t last, unsigned access);
+    int add_io_watchpoint(int space, uint16_t first, uint16_t last, unsigned access);
+    bool remove_breakpoint(int id);     // any kind; false if no such id
+    void clear_breakpoints();
+    const z8000_debug_hit& get_debug_hit() const { return m_debug_hit; }
+
     // Access to registers for debugging
     uint32_t get_pc() const { return m_pc; }
+#if Z8000_LAZY_FLAGS
+    uint16_t get_fcw() const { return m_lf_op ? lazy_fcw() : m_fcw; }
+#else
     uint16_t get_fcw() const { return m_fcw; }
+#endif
+    // Raw FCW storage; with Z8000_LAZY_FLAGS the flag bits may be stale
     const uint16_t* get_fcw_ptr() const { return &m_fcw; }
     uint16_t get_reg(int n) const { return m_regs.W[BYTE4_XOR_BE(n)]; }
     uint32_t get_reg_long(int n) const { return m_regs.L[BYTE_XOR_BE(n >> 1)]; }
@@ -111,19 +332,28 @@ public:
     virtual void dump_regs() const;
 
     // Get cycle count
-    int get_cycles() const { return m_total_cycles; }
+    uint64_t get_cycles() const { return m_total_cycles; }
 
     // Access PSAP registers (needed to preserve across warm boots)
     uint16_t get_psap_seg() const { return m_psapseg; }
     uint16_t get_psap_off() const { return m_psapoff; }
 
+    // Checkpointing.  load_state() returns false, leaving the CPU as it
+    // was, if the state has the wrong magic, version, size or CPU model.
+    // It empties the block cache, as restoring a checkpoint normally goes
+    // with restoring memory.
+    void save_state(z8000_state& state) const;
+    bool load_state(const z8000_state& state);
+
     // Direct state initialization (bypasses reset vector read)
     void init_state(uint16_t fcw, uint32_t pc, uint16_t psapseg,
                     uint16_t psapoff, uint16_t nspseg, uint16_t nspoff) {
+        sync_fcw();
         m_fcw = fcw;
         m_pc = pc;
         m_psapseg = psapseg;
-        m_psapoff = psapoff;
+        m_psapoff = psapoff & 0xff00;
+        update_psa();
         m_irq_req = 0;  // clear RESET and any pending interrupts
         m_halt = false;
 
@@ -143,8 +373,6 @@ public:
 protected:
     z8002_device(int addrbits, int vecmult);
 
-    void init_tables();
-
     uint32_t  m_op[4];      /* opcodes/data of current instruction */
     uint32_t  m_ppc;        /* previous program counter */
     uint32_t  m_pc;         /* program counter */
@@ -157,6 +385,14 @@ protected:
     uint8_t   m_irq_req;    /* reset, interrupt or trap request */
     uint16_t  m_irq_vec;    /* interrupt vector */
     uint32_t  m_op_valid;   /* bit field indicating if given op[] field is already initialized */
+#if Z8000_LAZY_FLAGS
+    uint8_t   m_lf_op;      /* operation whose flags are still pending, LF_NONE if m_fcw is current */
+    uint16_t  m_lf_mask;    /* m_fcw flag bits the pending operation sets */
+    uint32_t  m_lf_sign;    /* sign bit of the pending operation's operand size */
+    uint32_t  m_lf_dst;     /* pending operation's operands and result */
+    uint32_t  m_lf_src;
+    uint32_t  m_lf_res;
+#endif
     union {
         uint8_t   B[16]; /* RL0,RH0,RL1,RH1...RL7,RH7 */
         uint16_t  W[16]; /* R0,R1,R2...R15 */
@@ -165,44 +401,85 @@ protected:
     } m_regs;             /* registers */
     int m_nmi_state;      /* NMI line state */
     int m_irq_state[2];   /* IRQ line states (NVI, VI) */
+    uint16_t m_irq_ident[3];  /* identifier each line supplies on acknowledge (NVI, VI, NMI) */
     int m_mi;
     bool m_halt;
-    int m_icount;
-    int m_total_cycles;
+    bool m_stop_req;          /* request_stop() pending */
+    bool m_inline_repeat;     /* repeat instructions may loop in the handler */
+    int64_t m_icount;         /* cycles left in the current run */
+    uint64_t m_total_cycles;
     const int m_vector_mult;
+    const bool m_z8001;     /* which instantiation execute() and step() run */
 
     // Abstract bus interfaces (can point to same object or different ones)
     z8000_memory_bus* m_program_bus;
     z8000_memory_bus* m_data_bus;
     z8000_memory_bus* m_stack_bus;
+    z8000_memory_stats* m_memory_stats;
     z8000_io_bus* m_io_bus;
 
     // Simple wrappers that delegate to z8000_memory_bus*
-    // These replace the MAME memory_access<> cache/specific types
+    // These replace the MAME memory_access<> cache/specific types.
+    // Pages the bus maps to host memory are accessed directly.
     struct mem_cache {
         z8000_memory_bus* bus = nullptr;
+        const z8000_page_map* map = nullptr;
         uint16_t read_word(uint32_t addr) const {
+            if (map) {
+                const uint8_t* p = map->read[(addr >> Z8000_PAGE_SHIFT) & map->mask];
+                if (p) {
+                    p += addr & (Z8000_PAGE_SIZE - 2);
+                    return (p[0] << 8) | p[1];
+                }
+            }
             return bus ? bus->read_word(addr) : 0xFFFF;
         }
     };
 
     struct mem_specific {
         z8000_memory_bus* bus = nullptr;
+        const z8000_page_map* map = nullptr;
+        const uint8_t* read_page(uint32_t addr) const {
+            return map ? map->read[(addr >> Z8000_PAGE_SHIFT) & map->mask] : nullptr;
+        }
+        uint8_t* write_page(uint32_t addr) const {
+            return map ? map->write[(addr >> Z8000_PAGE_SHIFT) & map->mask] : nullptr;
+        }
         uint8_t read_byte(uint32_t addr) const {
+            if (const uint8_t* p = read_page(addr))
+                return p[addr & (Z8000_PAGE_SIZE - 1)];
             return bus ? bus->read_byte(addr) : 0xFF;
         }
         uint16_t read_word(uint32_t addr) const {
+            if (const uint8_t* p = read_page(addr)) {
+                p += addr & (Z8000_PAGE_SIZE - 2);
+                return (p[0] << 8) | p[1];
+            }
             return bus ? bus->read_word(addr) : 0xFFFF;
         }
         void write_byte(uint32_t addr, uint8_t val) {
-            if (bus) bus->write_byte(addr, val);
+            if (uint8_t* p = write_page(addr))
+                p[addr & (Z8000_PAGE_SIZE - 1)] = val;
+            else if (bus) bus->write_byte(addr, val);
         }
         void write_word(uint32_t addr, uint16_t val) {
-            if (bus) bus->write_word(addr, val);
+            if (uint8_t* p = write_page(addr)) {
+                p += addr & (Z8000_PAGE_SIZE - 2);
+                p[0] = val >> 8;
+                p[1] = val;
+            }
+            else if (bus) bus->write_word(addr, val);
         }
         void write_word(uint32_t addr, uint16_t val, uint16_t mask) {
-            if (bus) bus->write_word(addr, val, mask);
+            if (uint8_t* p = write_page(addr)) {
+                p += addr & (Z8000_PAGE_SIZE - 2);
+                p[0] = (p[0] & ~(mask >> 8)) | ((val & mask) >> 8);
+                p[1] = (p[1] & ~mask) | (val & mask);
+            }
+            else if (bus) bus->write_word(addr, val, mask);
         }
+        uint8_t* code_pages = nullptr;  /* block cache page flags, if this space holds code */
+        bool psa = false;               /* stores here can reach the PSA */
     };
 
     mem_cache m_cache;
@@ -215,55 +492,142 @@ protected:
     bool m_trace;
     bool m_reg_trace;
     z8000_disassembler* m_disasm;
+    z8000_trace_sink* m_trace_sink;
+    z8000_trace_insn m_trace_insn;  /* record for the instruction being executed */
+    uint16_t m_trace_regs[16];      /* registers as of the last register record */
+    uint16_t m_trace_mask;          /* registers to send regardless of change */
+
+    // Text trace disassembly cache, direct mapped on the pc.  An entry is
+    // used only while memory still holds its opcode words, so code written
+    // by the CPU or behind its back is disassembled afresh.
+    static constexpr unsigned DASM_CACHE_SLOTS = 1024;
+    struct dasm_entry {
+        uint32_t pc;
+        uint16_t op[4];
+        uint8_t size;               /* bytes; 0 for an empty slot */
+        bool seg;                   /* disassembled in segmented mode */
+        char text[z8000_disassembler::MAX_TEXT];
+    };
+    std::vector<dasm_entry> m_dasm_cache;
+
+    // Profiling
+    z8000_profile m_profile;
+
+    // Device events
+    z8000_scheduler m_events;
+
+    // Idle skipping: the last short backward branch taken, and the state
+    // it left, to tell whether the next pass changed anything
+    struct idle_loop {
+        bool valid;
+        bool pure;              /* the body only reads and sets registers */
+        uint32_t head, branch;  /* branch target and branch address */
+        uint64_t cycle;
+        uint16_t fcw;
+        uint16_t regs[16];
+    };
+    unsigned m_idle_modes;
+    unsigned m_idle_active;     /* m_idle_modes while the run may skip, else 0 */
+    uint64_t m_idle_cycles;
+    idle_loop m_idle_loop;
+    std::vector<uint8_t> m_idle_kind;   /* IDLE_* class of each table entry */
 
     // Device callbacks (stubbed for standalone)
     devcb_write_line m_mo_out;
 
     void clear_internal_state();
-    virtual bool get_segmented_mode() const override;
+    bool get_segmented_mode() const override;
+
+    // The model-dependent helpers and the opcode handlers are instantiated
+    // once per CPU, Z8001 false for the Z8002 and true for the Z8001, so
+    // that for the Z8002 the segmentation checks fold to constants and the
+    // Z8001 tests only its mode bit; execute() and step() pick the set.
+    template<bool Z8001> bool segmented() const { return Z8001 && (m_fcw & 0x8000); }    // F_SEG
     static inline uint32_t addr_add(uint32_t addr, uint32_t addend);
     static inline uint32_t addr_sub(uint32_t addr, uint32_t subtrahend);
     inline uint16_t RDOP();
     inline uint32_t get_operand(int opnum);
-    inline uint32_t get_addr_operand(int opnum);
-    inline uint32_t get_raw_addr_operand(int opnum);
-    virtual uint32_t adjust_addr_for_nonseg_mode(uint32_t addr);
-    inline uint8_t RDMEM_B(mem_specific &space, uint32_t addr);
-    inline uint16_t RDMEM_W(mem_specific &space, uint32_t addr);
-    inline uint32_t RDMEM_L(mem_specific &space, uint32_t addr);
-    inline void WRMEM_B(mem_specific &space, uint32_t addr, uint8_t value);
-    inline void WRMEM_W(mem_specific &space, uint32_t addr, uint16_t value);
-    inline void WRMEM_L(mem_specific &space, uint32_t addr, uint32_t value);
+    template<bool Z8001> inline uint32_t get_addr_operand(int opnum);
+    template<bool Z8001> inline uint32_t get_raw_addr_operand(int opnum);
+    template<bool Z8001> inline uint32_t adjust_addr_for_nonseg_mode(uint32_t addr) const;
+    template<bool Z8001> inline uint8_t RDMEM_B(mem_specific &space, uint32_t addr);
+    template<bool Z8001> inline uint16_t RDMEM_W(mem_specific &space, uint32_t addr);
+    template<bool Z8001> inline uint32_t RDMEM_L(mem_specific &space, uint32_t addr);
+    template<bool Z8001> inline void WRMEM_B(mem_specific &space, uint32_t addr, uint8_t value);
+    template<bool Z8001> inline void WRMEM_W(mem_specific &space, uint32_t addr, uint16_t value);
+    template<bool Z8001> inline void WRMEM_L(mem_specific &space, uint32_t addr, uint32_t value);
+    inline void note_code_write(mem_specific &space, uint32_t addr);
+    void invalidate_code_page(uint32_t page);
     inline uint8_t RDPORT_B(int mode, uint16_t addr);
     inline uint16_t RDPORT_W(int mode, uint16_t addr);
     inline void WRPORT_B(int mode, uint16_t addr, uint8_t value);
     inline void WRPORT_W(int mode, uint16_t addr, uint16_t value);
     inline void cycles(int cycles);
-    virtual void PUSH_PC();
-    virtual void CHANGE_FCW(uint16_t fcw);
+
+    // Lazy flag evaluation (Z8000_LAZY_FLAGS): the arithmetic and logical
+    // helpers record their operands and the flags are worked out when
+    // something reads them.  sync_fcw() brings m_fcw up to date.
+    static constexpr uint8_t LF_NONE  = 0;
+    static constexpr uint8_t LF_ADD   = 1;  // add, add with carry, increment
+    static constexpr uint8_t LF_SUB   = 2;  // subtract, compare, decrement, negate
+    static constexpr uint8_t LF_LOGIC = 3;  // and, or, xor, complement, test
+#if Z8000_LAZY_FLAGS
+    uint16_t sync_fcw() {
+        if (m_lf_op) {
+            m_fcw = lazy_fcw();
+            m_lf_op = LF_NONE;
+        }
+        return m_fcw;
+    }
+    uint16_t lazy_fcw() const;
+    inline void defer_flags(uint8_t op, uint32_t sign, uint16_t mask,
+                            uint32_t dest, uint32_t value, uint32_t result);
+#else
+    uint16_t sync_fcw() { return m_fcw; }
+#endif
+
+    // Repeating block instructions (LDIR, CPIR, INIR, TRIRB, ...)
+    bool repeat_next();
+    uint32_t repeat_bulk_limit(uint8_t cnt);
+    template<bool Z8001> uint16_t addr_reg_mask(uint8_t reg) const;
+    template<bool Z8001> void repeat_move(uint8_t dst, uint8_t src, uint8_t cnt, int step);
+    template<bool Z8001> void repeat_compare(uint8_t dst, bool mem_dst, uint8_t src, uint8_t cnt, int step, uint8_t cc);
+    template<bool Z8001> void repeat_io(uint8_t mem, uint8_t port, uint8_t cnt, int step, int mode, bool input);
+    bool overlaps_insn(const uint8_t *lo, uint32_t bytes) const;
+
+    // Idle skipping: handlers of the branches the loops close with call
+    // idle_branch() while m_idle_active, and DJNZ/DBJNZ idle_count()
+    static constexpr uint32_t IDLE_SPAN = 64;   /* longest polling loop, in bytes */
+    enum : uint8_t { IDLE_OTHER, IDLE_READ, IDLE_READ_ADDR, IDLE_JR };  /* m_idle_kind */
+    bool interrupt_due() const;
+    uint64_t idle_count(uint64_t max);
+    void idle_branch();
+    bool idle_body_pure(uint32_t head, uint32_t branch);
+    template<bool Z8001> void PUSH_PC();
+    template<bool Z8001> void CHANGE_FCW(uint16_t fcw);
     static inline uint32_t make_segmented_addr(uint32_t addr);
     static inline uint32_t segmented_addr(uint32_t addr);
-    inline uint32_t addr_from_reg(int regno);
-    inline void addr_to_reg(int regno, uint32_t addr);
-    inline void add_to_addr_reg(int regno, uint16_t addend);
-    inline void sub_from_addr_reg(int regno, uint16_t subtrahend);
-    inline void set_pc(uint32_t addr);
-    inline uint8_t RDIR_B(uint8_t reg);
-    inline uint16_t RDIR_W(uint8_t reg);
-    inline uint32_t RDIR_L(uint8_t reg);
-    inline void WRIR_B(uint8_t reg, uint8_t value);
-    inline void WRIR_W(uint8_t reg, uint16_t value);
-    inline void WRIR_L(uint8_t reg, uint32_t value);
-    inline uint8_t RDBX_B(uint8_t reg, uint16_t idx);
-    inline uint16_t RDBX_W(uint8_t reg, uint16_t idx);
-    inline uint32_t RDBX_L(uint8_t reg, uint16_t idx);
-    inline void WRBX_B(uint8_t reg, uint16_t idx, uint8_t value);
-    inline void WRBX_W(uint8_t reg, uint16_t idx, uint16_t value);
-    inline void WRBX_L(uint8_t reg, uint16_t idx, uint32_t value);
-    inline void PUSHW(uint8_t dst, uint16_t value);
-    inline uint16_t POPW(uint8_t src);
-    inline void PUSHL(uint8_t dst, uint32_t value);
-    inline uint32_t POPL(uint8_t src);
+    template<bool Z8001> inline uint32_t addr_from_reg(int regno);
+    template<bool Z8001> inline void addr_to_reg(int regno, uint32_t addr);
+    template<bool Z8001> inline void add_to_addr_reg(int regno, uint16_t addend);
+    template<bool Z8001> inline void sub_from_addr_reg(int regno, uint16_t subtrahend);
+    template<bool Z8001> inline void set_pc(uint32_t addr);
+    template<bool Z8001> inline uint8_t RDIR_B(uint8_t reg);
+    template<bool Z8001> inline uint16_t RDIR_W(uint8_t reg);
+    template<bool Z8001> inline uint32_t RDIR_L(uint8_t reg);
+    template<bool Z8001> inline void WRIR_B(uint8_t reg, uint8_t value);
+    template<bool Z8001> inline void WRIR_W(uint8_t reg, uint16_t value);
+    template<bool Z8001> inline void WRIR_L(uint8_t reg, uint32_t value);
+    template<bool Z8001> inline uint8_t RDBX_B(uint8_t reg, uint16_t idx);
+    template<bool Z8001> inline uint16_t RDBX_W(uint8_t reg, uint16_t idx);
+    template<bool Z8001> inline uint32_t RDBX_L(uint8_t reg, uint16_t idx);
+    template<bool Z8001> inline void WRBX_B(uint8_t reg, uint16_t idx, uint8_t value);
+    template<bool Z8001> inline void WRBX_W(uint8_t reg, uint16_t idx, uint16_t value);
+    template<bool Z8001> inline void WRBX_L(uint8_t reg, uint16_t idx, uint32_t value);
+    template<bool Z8001> inline void PUSHW(uint8_t dst, uint16_t value);
+    template<bool Z8001> inline uint16_t POPW(uint8_t src);
+    template<bool Z8001> inline void PUSHL(uint8_t dst, uint32_t value);
+    template<bool Z8001> inline uint32_t POPL(uint8_t src);
     inline uint8_t ADDB(uint8_t dest, uint8_t value);
     inline uint16_t ADDW(uint16_t dest, uint16_t value);
     inline uint32_t ADDL(uint32_t dest, uint32_t value);
@@ -324,428 +688,544 @@ protected:
     inline uint8_t SRLB(uint8_t dest, uint8_t count);
     inline uint16_t SRLW(uint16_t dest, uint8_t count);
     inline uint32_t SRLL(uint32_t dest, uint8_t count);
-    inline void Interrupt();
-    virtual uint32_t GET_PC(uint32_t VEC);
-    virtual uint32_t get_reset_pc();
-    virtual uint16_t GET_FCW(uint32_t VEC);
-    virtual uint32_t F_SEG_Z8001();
-    virtual uint32_t PSA_ADDR();
-    virtual uint32_t read_irq_vector();
+    template<bool Z8001> inline void Interrupt();
+    template<bool Z8001> uint32_t GET_PC(uint32_t VEC);
+    template<bool Z8001> uint32_t get_reset_pc();
+    template<bool Z8001> uint16_t GET_FCW(uint32_t VEC);
+    template<bool Z8001> uint32_t F_SEG_Z8001();
+    template<bool Z8001> uint32_t PSA_ADDR();
+    template<bool Z8001> uint32_t read_irq_vector();
+    virtual uint16_t model() const { return 8002; }
 
     // Trace output
     void trace_instruction();
+    void trace_record();
+    void trace_regs();
+
+    // Profile output
+    inline void profile_insn(unsigned index, uint64_t cycles);
+    void profile_call(uint8_t kind);
+    void profile_trap(uint8_t req);
+
+    // Run loop, specialised on the instrumentation in use so that the
+    // plain loop carries no per-instruction trace checks
+    static constexpr unsigned RUN_TRACE    = 1 << 0;  // disassemble each instruction
+    static constexpr unsigned RUN_REGTRACE = 1 << 1;  // dump registers after each instruction
+    static constexpr unsigned RUN_PROFILE  = 1 << 2;  // count instructions for the profile
+    static constexpr unsigned RUN_BREAK    = 1 << 3;  // check for breakpoints; ignored by step()
+    static constexpr unsigned RUN_FEATURES = 1 << 4;  // number of feature combinations
+    // Budget of a slice with no target or event to end it: large enough
+    // never to run out, small enough that handlers crediting cycles back
+    // cannot overflow it
+    static constexpr int64_t RUN_OPEN = INT64_MAX / 2;
+    unsigned run_features() const;
+    template <unsigned Features, bool Z8001> void execute_one();
+    template <unsigned Features, bool Z8001> void run_loop();
+    void execute(int64_t budget);
+    void run_to(uint64_t target);
+
+    // Block cache execution
+    template<bool Z8001> void run_blocks();
+    template<bool Z8001> void record_block();
+    void translate_block(uint32_t start, uint16_t count);
+    inline bool condition(unsigned cc);
+    void update_code_spaces();
+
+    template<bool Z8001> void zinvalid();
+    template<bool Z8001> void Z00_0000_dddd_imm8();
+    template<bool Z8001> void Z00_ssN0_dddd();
+    template<bool Z8001> void Z01_0000_dddd_imm16();
+    template<bool Z8001> void Z01_ssN0_dddd();
+    template<bool Z8001> void Z02_0000_dddd_imm8();
+    template<bool Z8001> void Z02_ssN0_dddd();
+    template<bool Z8001> void Z03_0000_dddd_imm16();
+    template<bool Z8001> void Z03_ssN0_dddd();
+    template<bool Z8001> void Z04_0000_dddd_imm8();
+    template<bool Z8001> void Z04_ssN0_dddd();
+    template<bool Z8001> void Z05_0000_dddd_imm16();
+    template<bool Z8001> void Z05_ssN0_dddd();
+    template<bool Z8001> void Z06_0000_dddd_imm8();
+    template<bool Z8001> void Z06_ssN0_dddd();
+    template<bool Z8001> void Z07_0000_dddd_imm16();
+    template<bool Z8001> void Z07_ssN0_dddd();
+    template<bool Z8001> void Z08_0000_dddd_imm8();
+    template<bool Z8001> void Z08_ssN0_dddd();
+    template<bool Z8001> void Z09_0000_dddd_imm16();
+    template<bool Z8001> void Z09_ssN0_dddd();
+    template<bool Z8001> void Z0A_0000_dddd_imm8();
+    template<bool Z8001> void Z0A_ssN0_dddd();
+    template<bool Z8001> void Z0B_0000_dddd_imm16();
+    template<bool Z8001> void Z0B_ssN0_dddd();
+    template<bool Z8001> void Z0C_ddN0_0000();
+    template<bool Z8001> void Z0C_ddN0_0001_imm8();
+    template<bool Z8001> void Z0C_ddN0_0010();
+    template<bool Z8001> void Z0C_ddN0_0100();
+    template<bool Z8001> void Z0C_ddN0_0101_imm8();
+    template<bool Z8001> void Z0C_ddN0_0110();
+    template<bool Z8001> void Z0C_ddN0_1000();
+    template<bool Z8001> void Z0D_ddN0_0000();
+    template<bool Z8001> void Z0D_ddN0_0001_imm16();
+    template<bool Z8001> void Z0D_ddN0_0010();
+    template<bool Z8001> void Z0D_ddN0_0100();
+    template<bool Z8001> void Z0D_ddN0_0101_imm16();
+    template<bool Z8001> void Z0D_ddN0_0110();
+    template<bool Z8001> void Z0D_ddN0_1000();
+    template<bool Z8001> void Z0D_ddN0_1001_imm16();
+    template<bool Z8001> void Z0E_imm8();
+    template<bool Z8001> void Z0F_imm8();
+    template<bool Z8001> void Z10_0000_dddd_imm32();
+    template<bool Z8001> void Z10_ssN0_dddd();
+    template<bool Z8001> void Z11_ddN0_ssN0();
+    template<bool Z8001> void Z12_0000_dddd_imm32();
+    template<bool Z8001> void Z12_ssN0_dddd();
+    template<bool Z8001> void Z13_ddN0_ssN0();
+    template<bool Z8001> void Z14_0000_dddd_imm32();
+    template<bool Z8001> void Z14_ssN0_dddd();
+    template<bool Z8001> void Z15_ssN0_ddN0();
+    template<bool Z8001> void Z16_0000_dddd_imm32();
+    template<bool Z8001> void Z16_ssN0_dddd();
+    template<bool Z8001> void Z17_ssN0_ddN0();
+    template<bool Z8001> void Z18_00N0_dddd_imm32();
+    template<bool Z8001> void Z18_ssN0_dddd();
+    template<bool Z8001> void Z19_0000_dddd_imm16();
+    template<bool Z8001> void Z19_ssN0_dddd();
+    template<bool Z8001> void Z1A_0000_dddd_imm32();
+    template<bool Z8001> void Z1A_ssN0_dddd();
+    template<bool Z8001> void Z1B_0000_dddd_imm16();
+    template<bool Z8001> void Z1B_ssN0_dddd();
+    template<bool Z8001> void Z1C_ddN0_1000();
+    template<bool Z8001> void Z1C_ddN0_1001_0000_ssss_0000_nmin1();
+    template<bool Z8001> void Z1C_ssN0_0001_0000_dddd_0000_nmin1();
+    template<bool Z8001> void Z1D_ddN0_ssss();
+    template<bool Z8001> void Z1E_ddN0_cccc();
+    template<bool Z8001> void Z1F_ddN0_0000();
+    template<bool Z8001> void Z20_ssN0_dddd();
+    template<bool Z8001> void Z21_0000_dddd_imm16();
+    template<bool Z8001> void Z21_ssN0_dddd();
+    template<bool Z8001> void Z22_0000_ssss_0000_dddd_0000_0000();
+    template<bool Z8001> void Z22_ddN0_imm4();
+    template<bool Z8001> void Z23_0000_ssss_0000_dddd_0000_0000();
+    template<bool Z8001> void Z23_ddN0_imm4();
+    template<bool Z8001> void Z24_0000_ssss_0000_dddd_0000_0000();
+    template<bool Z8001> void Z24_ddN0_imm4();
+    template<bool Z8001> void Z25_0000_ssss_0000_dddd_0000_0000();
+    template<bool Z8001> void Z25_ddN0_imm4();
+    template<bool Z8001> void Z26_0000_ssss_0000_dddd_0000_0000();
+    template<bool Z8001> void Z26_ddN0_imm4();
+    template<bool Z8001> void Z27_0000_ssss_0000_dddd_0000_0000();
+    template<bool Z8001> void Z27_ddN0_imm4();
+    template<bool Z8001> void Z28_ddN0_imm4m1();
+    template<bool Z8001> void Z29_ddN0_imm4m1();
+    template<bool Z8001> void Z2A_ddN0_imm4m1();
+    template<bool Z8001> void Z2B_ddN0_imm4m1();
+    template<bool Z8001> void Z2C_ssN0_dddd();
+    template<bool Z8001> void Z2D_ssN0_dddd();
+    template<bool Z8001> void Z2E_ddN0_ssss();
+    template<bool Z8001> void Z2F_ddN0_ssss();
+    template<bool Z8001> void Z30_0000_dddd_dsp16();
+    template<bool Z8001> void Z30_ssN0_dddd_imm16();
+    template<bool Z8001> void Z31_0000_dddd_dsp16();
+    template<bool Z8001> void Z31_ssN0_dddd_imm16();
+    template<bool Z8001> void Z32_0000_ssss_dsp16();
+    template<bool Z8001> void Z32_ddN0_ssss_imm16();
+    template<bool Z8001> void Z33_0000_ssss_dsp16();
+    template<bool Z8001> void Z33_ddN0_ssss_imm16();
+    template<bool Z8001> void Z34_0000_dddd_dsp16();
+    template<bool Z8001> void Z34_ssN0_dddd_imm16();
+    template<bool Z8001> void Z35_0000_dddd_dsp16();
+    template<bool Z8001> void Z35_ssN0_dddd_imm16();
+    template<bool Z8001> void Z36_0000_0000();
+    template<bool Z8001> void Z36_imm8();
+    template<bool Z8001> void Z37_0000_ssss_dsp16();
+    template<bool Z8001> void Z37_ddN0_ssss_imm16();
+    template<bool Z8001> void Z38_imm8();
+    template<bool Z8001> void Z39_ssN0_0000();
+    template<bool Z8001> void Z3A_ssss_0000_0000_aaaa_dddd_x000();
+    template<bool Z8001> void Z3A_ssss_0001_0000_aaaa_dddd_x000();
+    template<bool Z8001> void Z3A_ssss_0010_0000_aaaa_dddd_x000();
+    template<bool Z8001> void Z3A_ssss_0011_0000_aaaa_dddd_x000();
+    template<bool Z8001> void Z3A_dddd_0100_imm16();
+    template<bool Z8001> void Z3A_dddd_0101_imm16();
+    template<bool Z8001> void Z3A_ssss_0110_imm16();
+    template<bool Z8001> void Z3A_ssss_0111_imm16();
+    template<bool Z8001> void Z3A_ssss_1000_0000_aaaa_dddd_x000();
+    template<bool Z8001> void Z3A_ssss_1001_0000_aaaa_dddd_x000();
+    template<bool Z8001> void Z3A_ssss_1010_0000_aaaa_dddd_x000();
+    template<bool Z8001> void Z3A_ssss_1011_0000_aaaa_dddd_x000();
+    template<bool Z8001> void Z3B_ssss_0000_0000_aaaa_dddd_x000();
+    template<bool Z8001> void Z3B_ssss_0001_0000_aaaa_dddd_x000();
+    template<bool Z8001> void Z3B_ssss_0010_0000_aaaa_dddd_x000();
+    template<bool Z8001> void Z3B_ssss_0011_0000_aaaa_dddd_x000();
+    template<bool Z8001> void Z3B_dddd_0100_imm16();
+    template<bool Z8001> void Z3B_dddd_0101_imm16();
+    template<bool Z8001> void Z3B_ssss_0110_imm16();
+    template<bool Z8001> void Z3B_ssss_0111_imm16();
+    template<bool Z8001> void Z3B_ssss_1000_0000_aaaa_dddd_x000();
+    template<bool Z8001> void Z3B_ssss_1001_0000_aaaa_dddd_x000();
+    template<bool Z8001> void Z3B_ssss_1010_0000_aaaa_dddd_x000();
+    template<bool Z8001> void Z3B_ssss_1011_0000_aaaa_dddd_x000();
+    template<bool Z8001> void Z3C_ssss_dddd();
+    template<bool Z8001> void Z3D_ssss_dddd();
+    template<bool Z8001> void Z3E_dddd_ssss();
+    template<bool Z8001> void Z3F_dddd_ssss();
+    template<bool Z8001> void Z40_0000_dddd_addr();
+    template<bool Z8001> void Z40_ssN0_dddd_addr();
+    template<bool Z8001> void Z41_0000_dddd_addr();
+    template<bool Z8001> void Z41_ssN0_dddd_addr();
+    template<bool Z8001> void Z42_0000_dddd_addr();
+    template<bool Z8001> void Z42_ssN0_dddd_addr();
+    template<bool Z8001> void Z43_0000_dddd_addr();
+    template<bool Z8001> void Z43_ssN0_dddd_addr();
+    template<bool Z8001> void Z44_0000_dddd_addr();
+    template<bool Z8001> void Z44_ssN0_dddd_addr();
+    template<bool Z8001> void Z45_0000_dddd_addr();
+    template<bool Z8001> void Z45_ssN0_dddd_addr();
+    template<bool Z8001> void Z46_0000_dddd_addr();
+    template<bool Z8001> void Z46_ssN0_dddd_addr();
+    template<bool Z8001> void Z47_0000_dddd_addr();
+    template<bool Z8001> void Z47_ssN0_dddd_addr();
+    template<bool Z8001> void Z48_0000_dddd_addr();
+    template<bool Z8001> void Z48_ssN0_dddd_addr();
+    template<bool Z8001> void Z49_0000_dddd_addr();
+    template<bool Z8001> void Z49_ssN0_dddd_addr();
+    template<bool Z8001> void Z4A_0000_dddd_addr();
+    template<bool Z8001> void Z4A_ssN0_dddd_addr();
+    template<bool Z8001> void Z4B_0000_dddd_addr();
+    template<bool Z8001> void Z4B_ssN0_dddd_addr();
+    template<bool Z8001> void Z4C_0000_0000_addr();
+    template<bool Z8001> void Z4C_0000_0001_addr_imm8();
+    template<bool Z8001> void Z4C_0000_0010_addr();
+    template<bool Z8001> void Z4C_0000_0100_addr();
+    template<bool Z8001> void Z4C_0000_0101_addr_imm8();
+    template<bool Z8001> void Z4C_0000_0110_addr();
+    template<bool Z8001> void Z4C_0000_1000_addr();
+    template<bool Z8001> void Z4C_ddN0_0000_addr();
+    template<bool Z8001> void Z4C_ddN0_0001_addr_imm8();
+    template<bool Z8001> void Z4C_ddN0_0010_addr();
+    template<bool Z8001> void Z4C_ddN0_0100_addr();
+    template<bool Z8001> void Z4C_ddN0_0101_addr_imm8();
+    template<bool Z8001> void Z4C_ddN0_0110_addr();
+    template<bool Z8001> void Z4C_ddN0_1000_addr();
+    template<bool Z8001> void Z4D_0000_0000_addr();
+    template<bool Z8001> void Z4D_0000_0001_addr_imm16();
+    template<bool Z8001> void Z4D_0000_0010_addr();
+    template<bool Z8001> void Z4D_0000_0100_addr();
+    template<bool Z8001> void Z4D_0000_0101_addr_imm16();
+    template<bool Z8001> void Z4D_0000_0110_addr();
+    template<bool Z8001> void Z4D_0000_1000_addr();
+    template<bool Z8001> void Z4D_ddN0_0000_addr();
+    template<bool Z8001> void Z4D_ddN0_0001_addr_imm16();
+    template<bool Z8001> void Z4D_ddN0_0010_addr();
+    template<bool Z8001> void Z4D_ddN0_0100_addr();
+    template<bool Z8001> void Z4D_ddN0_0101_addr_imm16();
+    template<bool Z8001> void Z4D_ddN0_0110_addr();
+    template<bool Z8001> void Z4D_ddN0_1000_addr();
+    template<bool Z8001> void Z4E_ddN0_ssN0_addr();
+    template<bool Z8001> void Z50_0000_dddd_addr();
+    template<bool Z8001> void Z50_ssN0_dddd_addr();
+    template<bool Z8001> void Z51_ddN0_0000_addr();
+    template<bool Z8001> void Z51_ddN0_ssN0_addr();
+    template<bool Z8001> void Z52_0000_dddd_addr();
+    template<bool Z8001> void Z52_ssN0_dddd_addr();
+    template<bool Z8001> void Z53_ddN0_0000_addr();
+    template<bool Z8001> void Z53_ddN0_ssN0_addr();
+    template<bool Z8001> void Z54_0000_dddd_addr();
+    template<bool Z8001> void Z54_ssN0_dddd_addr();
+    template<bool Z8001> void Z55_ssN0_0000_addr();
+    template<bool Z8001> void Z55_ssN0_ddN0_addr();
+    template<bool Z8001> void Z56_0000_dddd_addr();
+    template<bool Z8001> void Z56_ssN0_dddd_addr();
+    template<bool Z8001> void Z57_ssN0_0000_addr();
+    template<bool Z8001> void Z57_ssN0_ddN0_addr();
+    template<bool Z8001> void Z58_0000_dddd_addr();
+    template<bool Z8001> void Z58_ssN0_dddd_addr();
+    template<bool Z8001> void Z59_0000_dddd_addr();
+    template<bool Z8001> void Z59_ssN0_dddd_addr();
+    template<bool Z8001> void Z5A_0000_dddd_addr();
+    template<bool Z8001> void Z5A_ssN0_dddd_addr();
+    template<bool Z8001> void Z5B_0000_dddd_addr();
+    template<bool Z8001> void Z5B_ssN0_dddd_addr();
+    template<bool Z8001> void Z5C_0000_0001_0000_dddd_0000_nmin1_addr();
+    template<bool Z8001> void Z5C_0000_1000_addr();
+    template<bool Z8001> void Z5C_0000_1001_0000_ssss_0000_nmin1_addr();
+    template<bool Z8001> void Z5C_ddN0_1000_addr();
+    template<bool Z8001> void Z5C_ddN0_1001_0000_ssN0_0000_nmin1_addr();
+    template<bool Z8001> void Z5C_ssN0_0001_0000_dddd_0000_nmin1_addr();
+    template<bool Z8001> void Z5D_0000_ssss_addr();
+    template<bool Z8001> void Z5D_ddN0_ssss_addr();
+    template<bool Z8001> void Z5E_0000_cccc_addr();
+    template<bool Z8001> void Z5E_ddN0_cccc_addr();
+    template<bool Z8001> void Z5F_0000_0000_addr();
+    template<bool Z8001> void Z5F_ddN0_0000_addr();
+    template<bool Z8001> void Z60_0000_dddd_addr();
+    template<bool Z8001> void Z60_ssN0_dddd_addr();
+    template<bool Z8001> void Z61_0000_dddd_addr();
+    template<bool Z8001> void Z61_ssN0_dddd_addr();
+    template<bool Z8001> void Z62_0000_imm4_addr();
+    template<bool Z8001> void Z62_ddN0_imm4_addr();
+    template<bool Z8001> void Z63_0000_imm4_addr();
+    template<bool Z8001> void Z63_ddN0_imm4_addr();
+    template<bool Z8001> void Z64_0000_imm4_addr();
+    template<bool Z8001> void Z64_ddN0_imm4_addr();
+    template<bool Z8001> void Z65_0000_imm4_addr();
+    template<bool Z8001> void Z65_ddN0_imm4_addr();
+    template<bool Z8001> void Z66_0000_imm4_addr();
+    template<bool Z8001> void Z66_ddN0_imm4_addr();
+    template<bool Z8001> void Z67_0000_imm4_addr();
+    template<bool Z8001> void Z67_ddN0_imm4_addr();
+    template<bool Z8001> void Z68_0000_imm4m1_addr();
+    template<bool Z8001> void Z68_ddN0_imm4m1_addr();
+    template<bool Z8001> void Z69_0000_imm4m1_addr();
+    template<bool Z8001> void Z69_ddN0_imm4m1_addr();
+    template<bool Z8001> void Z6A_0000_imm4m1_addr();
+    template<bool Z8001> void Z6A_ddN0_imm4m1_addr();
+    template<bool Z8001> void Z6B_0000_imm4m1_addr();
+    template<bool Z8001> void Z6B_ddN0_imm4m1_addr();
+    template<bool Z8001> void Z6C_0000_dddd_addr();
+    template<bool Z8001> void Z6C_ssN0_dddd_addr();
+    template<bool Z8001> void Z6D_0000_dddd_addr();
+    template<bool Z8001> void Z6D_ssN0_dddd_addr();
+    template<bool Z8001> void Z6E_0000_ssss_addr();
+    template<bool Z8001> void Z6E_ddN0_ssss_addr();
+    template<bool Z8001> void Z6F_0000_ssss_addr();
+    template<bool Z8001> void Z6F_ddN0_ssss_addr();
+    template<bool Z8001> void Z70_ssN0_dddd_0000_xxxx_0000_0000();
+    template<bool Z8001> void Z71_ssN0_dddd_0000_xxxx_0000_0000();
+    template<bool Z8001> void Z72_ddN0_ssss_0000_xxxx_0000_0000();
+    template<bool Z8001> void Z73_ddN0_ssss_0000_xxxx_0000_0000();
+    template<bool Z8001> void Z74_ssN0_dddd_0000_xxxx_0000_0000();
+    template<bool Z8001> void Z75_ssN0_dddd_0000_xxxx_0000_0000();
+    template<bool Z8001> void Z76_0000_dddd_addr();
+    template<bool Z8001> void Z76_ssN0_dddd_addr();
+    template<bool Z8001> void Z77_ddN0_ssss_0000_xxxx_0000_0000();
+    template<bool Z8001> void Z78_imm8();
+    template<bool Z8001> void Z79_0000_0000_addr();
+    template<bool Z8001> void Z79_ssN0_0000_addr();
+    template<bool Z8001> void Z7A_0000_0000();
+    template<bool Z8001> void Z7B_0000_0000();
+    template<bool Z8001> void Z7B_0000_1000();
+    template<bool Z8001> void Z7B_0000_1001();
+    template<bool Z8001> void Z7B_0000_1010();
+    template<bool Z8001> void Z7B_dddd_1101();
+    template<bool Z8001> void Z7C_0000_00ii();
+    template<bool Z8001> void Z7C_0000_01ii();
+    template<bool Z8001> void Z7D_dddd_0ccc();
+    template<bool Z8001> void Z7D_ssss_1ccc();
+    template<bool Z8001> void Z7E_imm8();
+    template<bool Z8001> void Z7F_imm8();
+    template<bool Z8001> void Z80_ssss_dddd();
+    template<bool Z8001> void Z81_ssss_dddd();
+    template<bool Z8001> void Z82_ssss_dddd();
+    template<bool Z8001> void Z83_ssss_dddd();
+    template<bool Z8001> void Z84_ssss_dddd();
+    template<bool Z8001> void Z85_ssss_dddd();
+    template<bool Z8001> void Z86_ssss_dddd();
+    template<bool Z8001> void Z87_ssss_dddd();
+    template<bool Z8001> void Z88_ssss_dddd();
+    template<bool Z8001> void Z89_ssss_dddd();
+    template<bool Z8001> void Z8A_ssss_dddd();
+    template<bool Z8001> void Z8B_ssss_dddd();
+    template<bool Z8001> void Z8C_dddd_0000();
+    template<bool Z8001> void Z8C_dddd_0010();
+    template<bool Z8001> void Z8C_dddd_0100();
+    template<bool Z8001> void Z8C_dddd_0110();
+    template<bool Z8001> void Z8C_dddd_0001();
+    template<bool Z8001> void Z8C_dddd_1000();
+    template<bool Z8001> void Z8C_dddd_1001();
+    template<bool Z8001> void Z8D_0000_0111();
+    template<bool Z8001> void Z8D_dddd_0000();
+    template<bool Z8001> void Z8D_dddd_0010();
+    template<bool Z8001> void Z8D_dddd_0100();
+    template<bool Z8001> void Z8D_dddd_0110();
+    template<bool Z8001> void Z8D_dddd_1000();
+    template<bool Z8001> void Z8D_imm4_0001();
+    template<bool Z8001> void Z8D_imm4_0011();
+    template<bool Z8001> void Z8D_imm4_0101();
+    template<bool Z8001> void Z8E_imm8();
+    template<bool Z8001> void Z8F_imm8();
+    template<bool Z8001> void Z90_ssss_dddd();
+    template<bool Z8001> void Z91_ddN0_ssss();
+    template<bool Z8001> void Z92_ssss_dddd();
+    template<bool Z8001> void Z93_ddN0_ssss();
+    template<bool Z8001> void Z94_ssss_dddd();
+    template<bool Z8001> void Z95_ssN0_dddd();
+    template<bool Z8001> void Z96_ssss_dddd();
+    template<bool Z8001> void Z97_ssN0_dddd();
+    template<bool Z8001> void Z98_ssss_dddd();
+    template<bool Z8001> void Z99_ssss_dddd();
+    template<bool Z8001> void Z9A_ssss_dddd();
+    template<bool Z8001> void Z9B_ssss_dddd();
+    template<bool Z8001> void Z9C_dddd_1000();
+    template<bool Z8001> void Z9D_imm8();
+    template<bool Z8001> void Z9E_0000_cccc();
+    template<bool Z8001> void Z9F_imm8();
+    template<bool Z8001> void ZA0_ssss_dddd();
+    template<bool Z8001> void ZA1_ssss_dddd();
+    template<bool Z8001> void ZA2_dddd_imm4();
+    template<bool Z8001> void ZA3_dddd_imm4();
+    template<bool Z8001> void ZA4_dddd_imm4();
+    template<bool Z8001> void ZA5_dddd_imm4();
+    template<bool Z8001> void ZA6_dddd_imm4();
+    template<bool Z8001> void ZA7_dddd_imm4();
+    template<bool Z8001> void ZA8_dddd_imm4m1();
+    template<bool Z8001> void ZA9_dddd_imm4m1();
+    template<bool Z8001> void ZAA_dddd_imm4m1();
+    template<bool Z8001> void ZAB_dddd_imm4m1();
+    template<bool Z8001> void ZAC_ssss_dddd();
+    template<bool Z8001> void ZAD_ssss_dddd();
+    template<bool Z8001> void ZAE_dddd_cccc();
+    template<bool Z8001> void ZAF_dddd_cccc();
+    template<bool Z8001> void ZB0_dddd_0000();
+    template<bool Z8001> void ZB1_dddd_0000();
+    template<bool Z8001> void ZB1_dddd_0111();
+    template<bool Z8001> void ZB1_dddd_1010();
+    template<bool Z8001> void ZB2_dddd_0001_imm8();
+    template<bool Z8001> void ZB2_dddd_0011_0000_ssss_0000_0000();
+    template<bool Z8001> void ZB2_dddd_00I0();
+    template<bool Z8001> void ZB2_dddd_01I0();
+    template<bool Z8001> void ZB2_dddd_1001_imm8();
+    template<bool Z8001> void ZB2_dddd_1011_0000_ssss_0000_0000();
+    template<bool Z8001> void ZB2_dddd_10I0();
+    template<bool Z8001> void ZB2_dddd_11I0();
+    template<bool Z8001> void ZB3_dddd_0001_imm8();
+    template<bool Z8001> void ZB3_dddd_0011_0000_ssss_0000_0000();
+    template<bool Z8001> void ZB3_dddd_00I0();
+    template<bool Z8001> void ZB3_dddd_0101_imm8();
+    template<bool Z8001> void ZB3_dddd_0111_0000_ssss_0000_0000();
+    template<bool Z8001> void ZB3_dddd_01I0();
+    template<bool Z8001> void ZB3_dddd_1001_imm8();
+    template<bool Z8001> void ZB3_dddd_1011_0000_ssss_0000_0000();
+    template<bool Z8001> void ZB3_dddd_10I0();
+    template<bool Z8001> void ZB3_dddd_1101_imm8();
+    template<bool Z8001> void ZB3_dddd_1111_0000_ssss_0000_0000();
+    template<bool Z8001> void ZB3_dddd_11I0();
+    template<bool Z8001> void ZB4_ssss_dddd();
+    template<bool Z8001> void ZB5_ssss_dddd();
+    template<bool Z8001> void ZB6_ssss_dddd();
+    template<bool Z8001> void ZB7_ssss_dddd();
+    template<bool Z8001> void ZB8_ddN0_0010_0000_rrrr_ssN0_0000();
+    template<bool Z8001> void ZB8_ddN0_0110_0000_rrrr_ssN0_1110();
+    template<bool Z8001> void ZB8_ddN0_1010_0000_rrrr_ssN0_0000();
+    template<bool Z8001> void ZB8_ddN0_1110_0000_rrrr_ssN0_1110();
+    template<bool Z8001> void ZB8_ddN0_0000_0000_rrrr_ssN0_0000();
+    template<bool Z8001> void ZB8_ddN0_0100_0000_rrrr_ssN0_0000();
+    template<bool Z8001> void ZB8_ddN0_1000_0000_rrrr_ssN0_0000();
+    template<bool Z8001> void ZB8_ddN0_1100_0000_rrrr_ssN0_0000();
+    template<bool Z8001> void ZB9_imm8();
+    template<bool Z8001> void ZBA_ssN0_0000_0000_rrrr_dddd_cccc();
+    template<bool Z8001> void ZBA_ssN0_0001_0000_rrrr_ddN0_x000();
+    template<bool Z8001> void ZBA_ssN0_0010_0000_rrrr_ddN0_cccc();
+    template<bool Z8001> void ZBA_ssN0_0100_0000_rrrr_dddd_cccc();
+    template<bool Z8001> void ZBA_ssN0_0110_0000_rrrr_ddN0_cccc();
+    template<bool Z8001> void ZBA_ssN0_1000_0000_rrrr_dddd_cccc();
+    template<bool Z8001> void ZBA_ssN0_1001_0000_rrrr_ddN0_x000();
+    template<bool Z8001> void ZBA_ssN0_1010_0000_rrrr_ddN0_cccc();
+    template<bool Z8001> void ZBA_ssN0_1100_0000_rrrr_dddd_cccc();
+    template<bool Z8001> void ZBA_ssN0_1110_0000_rrrr_ddN0_cccc();
+    template<bool Z8001> void ZBB_ssN0_0000_0000_rrrr_dddd_cccc();
+    template<bool Z8001> void ZBB_ssN0_0001_0000_rrrr_ddN0_x000();
+    template<bool Z8001> void ZBB_ssN0_0010_0000_rrrr_ddN0_cccc();
+    template<bool Z8001> void ZBB_ssN0_0100_0000_rrrr_dddd_cccc();
+    template<bool Z8001> void ZBB_ssN0_0110_0000_rrrr_ddN0_cccc();
+    template<bool Z8001> void ZBB_ssN0_1000_0000_rrrr_dddd_cccc();
+    template<bool Z8001> void ZBB_ssN0_1001_0000_rrrr_ddN0_x000();
+    template<bool Z8001> void ZBB_ssN0_1010_0000_rrrr_ddN0_cccc();
+    template<bool Z8001> void ZBB_ssN0_1100_0000_rrrr_dddd_cccc();
+    template<bool Z8001> void ZBB_ssN0_1110_0000_rrrr_ddN0_cccc();
+    template<bool Z8001> void ZBC_aaaa_bbbb();
+    template<bool Z8001> void ZBD_dddd_imm4();
+    template<bool Z8001> void ZBE_aaaa_bbbb();
+    template<bool Z8001> void ZBF_imm8();
+    template<bool Z8001> void Z20_0000_dddd_imm8();
+    template<bool Z8001> void ZC_dddd_imm8();
+    template<bool Z8001> void ZD_dsp12();
+    template<bool Z8001> void ZE_cccc_dsp8();
+    template<bool Z8001> void ZF_dddd_0dsp7();
+    template<bool Z8001> void ZF_dddd_1dsp7();
 
-    void zinvalid();
-    void Z00_0000_dddd_imm8();
-    void Z00_ssN0_dddd();
-    void Z01_0000_dddd_imm16();
-    void Z01_ssN0_dddd();
-    void Z02_0000_dddd_imm8();
-    void Z02_ssN0_dddd();
-    void Z03_0000_dddd_imm16();
-    void Z03_ssN0_dddd();
-    void Z04_0000_dddd_imm8();
-    void Z04_ssN0_dddd();
-    void Z05_0000_dddd_imm16();
-    void Z05_ssN0_dddd();
-    void Z06_0000_dddd_imm8();
-    void Z06_ssN0_dddd();
-    void Z07_0000_dddd_imm16();
-    void Z07_ssN0_dddd();
-    void Z08_0000_dddd_imm8();
-    void Z08_ssN0_dddd();
-    void Z09_0000_dddd_imm16();
-    void Z09_ssN0_dddd();
-    void Z0A_0000_dddd_imm8();
-    void Z0A_ssN0_dddd();
-    void Z0B_0000_dddd_imm16();
-    void Z0B_ssN0_dddd();
-    void Z0C_ddN0_0000();
-    void Z0C_ddN0_0001_imm8();
-    void Z0C_ddN0_0010();
-    void Z0C_ddN0_0100();
-    void Z0C_ddN0_0101_imm8();
-    void Z0C_ddN0_0110();
-    void Z0C_ddN0_1000();
-    void Z0D_ddN0_0000();
-    void Z0D_ddN0_0001_imm16();
-    void Z0D_ddN0_0010();
-    void Z0D_ddN0_0100();
-    void Z0D_ddN0_0101_imm16();
-    void Z0D_ddN0_0110();
-    void Z0D_ddN0_1000();
-    void Z0D_ddN0_1001_imm16();
-    void Z0E_imm8();
-    void Z0F_imm8();
-    void Z10_0000_dddd_imm32();
-    void Z10_ssN0_dddd();
-    void Z11_ddN0_ssN0();
-    void Z12_0000_dddd_imm32();
-    void Z12_ssN0_dddd();
-    void Z13_ddN0_ssN0();
-    void Z14_0000_dddd_imm32();
-    void Z14_ssN0_dddd();
-    void Z15_ssN0_ddN0();
-    void Z16_0000_dddd_imm32();
-    void Z16_ssN0_dddd();
-    void Z17_ssN0_ddN0();
-    void Z18_00N0_dddd_imm32();
-    void Z18_ssN0_dddd();
-    void Z19_0000_dddd_imm16();
-    void Z19_ssN0_dddd();
-    void Z1A_0000_dddd_imm32();
-    void Z1A_ssN0_dddd();
-    void Z1B_0000_dddd_imm16();
-    void Z1B_ssN0_dddd();
-    void Z1C_ddN0_1000();
-    void Z1C_ddN0_1001_0000_ssss_0000_nmin1();
-    void Z1C_ssN0_0001_0000_dddd_0000_nmin1();
-    void Z1D_ddN0_ssss();
-    void Z1E_ddN0_cccc();
-    void Z1F_ddN0_0000();
-    void Z20_ssN0_dddd();
-    void Z21_0000_dddd_imm16();
-    void Z21_ssN0_dddd();
-    void Z22_0000_ssss_0000_dddd_0000_0000();
-    void Z22_ddN0_imm4();
-    void Z23_0000_ssss_0000_dddd_0000_0000();
-    void Z23_ddN0_imm4();
-    void Z24_0000_ssss_0000_dddd_0000_0000();
-    void Z24_ddN0_imm4();
-    void Z25_0000_ssss_0000_dddd_0000_0000();
-    void Z25_ddN0_imm4();
-    void Z26_0000_ssss_0000_dddd_0000_0000();
-    void Z26_ddN0_imm4();
-    void Z27_0000_ssss_0000_dddd_0000_0000();
-    void Z27_ddN0_imm4();
-    void Z28_ddN0_imm4m1();
-    void Z29_ddN0_imm4m1();
-    void Z2A_ddN0_imm4m1();
-    void Z2B_ddN0_imm4m1();
-    void Z2C_ssN0_dddd();
-    void Z2D_ssN0_dddd();
-    void Z2E_ddN0_ssss();
-    void Z2F_ddN0_ssss();
-    void Z30_0000_dddd_dsp16();
-    void Z30_ssN0_dddd_imm16();
-    void Z31_0000_dddd_dsp16();
-    void Z31_ssN0_dddd_imm16();
-    void Z32_0000_ssss_dsp16();
-    void Z32_ddN0_ssss_imm16();
-    void Z33_0000_ssss_dsp16();
-    void Z33_ddN0_ssss_imm16();
-    void Z34_0000_dddd_dsp16();
-    void Z34_ssN0_dddd_imm16();
-    void Z35_0000_dddd_dsp16();
-    void Z35_ssN0_dddd_imm16();
-    void Z36_0000_0000();
-    void Z36_imm8();
-    void Z37_0000_ssss_dsp16();
-    void Z37_ddN0_ssss_imm16();
-    void Z38_imm8();
-    void Z39_ssN0_0000();
-    void Z3A_ssss_0000_0000_aaaa_dddd_x000();
-    void Z3A_ssss_0001_0000_aaaa_dddd_x000();
-    void Z3A_ssss_0010_0000_aaaa_dddd_x000();
-    void Z3A_ssss_0011_0000_aaaa_dddd_x000();
-    void Z3A_dddd_0100_imm16();
-    void Z3A_dddd_0101_imm16();
-    void Z3A_ssss_0110_imm16();
-    void Z3A_ssss_0111_imm16();
-    void Z3A_ssss_1000_0000_aaaa_dddd_x000();
-    void Z3A_ssss_1001_0000_aaaa_dddd_x000();
-    void Z3A_ssss_1010_0000_aaaa_dddd_x000();
-    void Z3A_ssss_1011_0000_aaaa_dddd_x000();
-    void Z3B_ssss_0000_0000_aaaa_dddd_x000();
-    void Z3B_ssss_0001_0000_aaaa_dddd_x000();
-    void Z3B_ssss_0010_0000_aaaa_dddd_x000();
-    void Z3B_ssss_0011_0000_aaaa_dddd_x000();
-    void Z3B_dddd_0100_imm16();
-    void Z3B_dddd_0101_imm16();
-    void Z3B_ssss_0110_imm16();
-    void Z3B_ssss_0111_imm16();
-    void Z3B_ssss_1000_0000_aaaa_dddd_x000();
-    void Z3B_ssss_1001_0000_aaaa_dddd_x000();
-    void Z3B_ssss_1010_0000_aaaa_dddd_x000();
-    void Z3B_ssss_1011_0000_aaaa_dddd_x000();
-    void Z3C_ssss_dddd();
-    void Z3D_ssss_dddd();
-    void Z3E_dddd_ssss();
-    void Z3F_dddd_ssss();
-    void Z40_0000_dddd_addr();
-    void Z40_ssN0_dddd_addr();
-    void Z41_0000_dddd_addr();
-    void Z41_ssN0_dddd_addr();
-    void Z42_0000_dddd_addr();
-    void Z42_ssN0_dddd_addr();
-    void Z43_0000_dddd_addr();
-    void Z43_ssN0_dddd_addr();
-    void Z44_0000_dddd_addr();
-    void Z44_ssN0_dddd_addr();
-    void Z45_0000_dddd_addr();
-    void Z45_ssN0_dddd_addr();
-    void Z46_0000_dddd_addr();
-    void Z46_ssN0_dddd_addr();
-    void Z47_0000_dddd_addr();
-    void Z47_ssN0_dddd_addr();
-    void Z48_0000_dddd_addr();
-    void Z48_ssN0_dddd_addr();
-    void Z49_0000_dddd_addr();
-    void Z49_ssN0_dddd_addr();
-    void Z4A_0000_dddd_addr();
-    void Z4A_ssN0_dddd_addr();
-    void Z4B_0000_dddd_addr();
-    void Z4B_ssN0_dddd_addr();
-    void Z4C_0000_0000_addr();
-    void Z4C_0000_0001_addr_imm8();
-    void Z4C_0000_0010_addr();
-    void Z4C_0000_0100_addr();
-    void Z4C_0000_0101_addr_imm8();
-    void Z4C_0000_0110_addr();
-    void Z4C_0000_1000_addr();
-    void Z4C_ddN0_0000_addr();
-    void Z4C_ddN0_0001_addr_imm8();
-    void Z4C_ddN0_0010_addr();
-    void Z4C_ddN0_0100_addr();
-    void Z4C_ddN0_0101_addr_imm8();
-    void Z4C_ddN0_0110_addr();
-    void Z4C_ddN0_1000_addr();
-    void Z4D_0000_0000_addr();
-    void Z4D_0000_0001_addr_imm16();
-    void Z4D_0000_0010_addr();
-    void Z4D_0000_0100_addr();
-    void Z4D_0000_0101_addr_imm16();
-    void Z4D_0000_0110_addr();
-    void Z4D_0000_1000_addr();
-    void Z4D_ddN0_0000_addr();
-    void Z4D_ddN0_0001_addr_imm16();
-    void Z4D_ddN0_0010_addr();
-    void Z4D_ddN0_0100_addr();
-    void Z4D_ddN0_0101_addr_imm16();
-    void Z4D_ddN0_0110_addr();
-    void Z4D_ddN0_1000_addr();
-    void Z4E_ddN0_ssN0_addr();
-    void Z50_0000_dddd_addr();
-    void Z50_ssN0_dddd_addr();
-    void Z51_ddN0_0000_addr();
-    void Z51_ddN0_ssN0_addr();
-    void Z52_0000_dddd_addr();
-    void Z52_ssN0_dddd_addr();
-    void Z53_ddN0_0000_addr();
-    void Z53_ddN0_ssN0_addr();
-    void Z54_0000_dddd_addr();
-    void Z54_ssN0_dddd_addr();
-    void Z55_ssN0_0000_addr();
-    void Z55_ssN0_ddN0_addr();
-    void Z56_0000_dddd_addr();
-    void Z56_ssN0_dddd_addr();
-    void Z57_ssN0_0000_addr();
-    void Z57_ssN0_ddN0_addr();
-    void Z58_0000_dddd_addr();
-    void Z58_ssN0_dddd_addr();
-    void Z59_0000_dddd_addr();
-    void Z59_ssN0_dddd_addr();
-    void Z5A_0000_dddd_addr();
-    void Z5A_ssN0_dddd_addr();
-    void Z5B_0000_dddd_addr();
-    void Z5B_ssN0_dddd_addr();
-    void Z5C_0000_0001_0000_dddd_0000_nmin1_addr();
-    void Z5C_0000_1000_addr();
-    void Z5C_0000_1001_0000_ssss_0000_nmin1_addr();
-    void Z5C_ddN0_1000_addr();
-    void Z5C_ddN0_1001_0000_ssN0_0000_nmin1_addr();
-    void Z5C_ssN0_0001_0000_dddd_0000_nmin1_addr();
-    void Z5D_0000_ssss_addr();
-    void Z5D_ddN0_ssss_addr();
-    void Z5E_0000_cccc_addr();
-    void Z5E_ddN0_cccc_addr();
-    void Z5F_0000_0000_addr();
-    void Z5F_ddN0_0000_addr();
-    void Z60_0000_dddd_addr();
-    void Z60_ssN0_dddd_addr();
-    void Z61_0000_dddd_addr();
-    void Z61_ssN0_dddd_addr();
-    void Z62_0000_imm4_addr();
-    void Z62_ddN0_imm4_addr();
-    void Z63_0000_imm4_addr();
-    void Z63_ddN0_imm4_addr();
-    void Z64_0000_imm4_addr();
-    void Z64_ddN0_imm4_addr();
-    void Z65_0000_imm4_addr();
-    void Z65_ddN0_imm4_addr();
-    void Z66_0000_imm4_addr();
-    void Z66_ddN0_imm4_addr();
-    void Z67_0000_imm4_addr();
-    void Z67_ddN0_imm4_addr();
-    void Z68_0000_imm4m1_addr();
-    void Z68_ddN0_imm4m1_addr();
-    void Z69_0000_imm4m1_addr();
-    void Z69_ddN0_imm4m1_addr();
-    void Z6A_0000_imm4m1_addr();
-    void Z6A_ddN0_imm4m1_addr();
-    void Z6B_0000_imm4m1_addr();
-    void Z6B_ddN0_imm4m1_addr();
-    void Z6C_0000_dddd_addr();
-    void Z6C_ssN0_dddd_addr();
-    void Z6D_0000_dddd_addr();
-    void Z6D_ssN0_dddd_addr();
-    void Z6E_0000_ssss_addr();
-    void Z6E_ddN0_ssss_addr();
-    void Z6F_0000_ssss_addr();
-    void Z6F_ddN0_ssss_addr();
-    void Z70_ssN0_dddd_0000_xxxx_0000_0000();
-    void Z71_ssN0_dddd_0000_xxxx_0000_0000();
-    void Z72_ddN0_ssss_0000_xxxx_0000_0000();
-    void Z73_ddN0_ssss_0000_xxxx_0000_0000();
-    void Z74_ssN0_dddd_0000_xxxx_0000_0000();
-    void Z75_ssN0_dddd_0000_xxxx_0000_0000();
-    void Z76_0000_dddd_addr();
-    void Z76_ssN0_dddd_addr();
-    void Z77_ddN0_ssss_0000_xxxx_0000_0000();
-    void Z78_imm8();
-    void Z79_0000_0000_addr();
-    void Z79_ssN0_0000_addr();
-    void Z7A_0000_0000();
-    void Z7B_0000_0000();
-    void Z7B_0000_1000();
-    void Z7B_0000_1001();
-    void Z7B_0000_1010();
-    void Z7B_dddd_1101();
-    void Z7C_0000_00ii();
-    void Z7C_0000_01ii();
-    void Z7D_dddd_0ccc();
-    void Z7D_ssss_1ccc();
-    void Z7E_imm8();
-    void Z7F_imm8();
-    void Z80_ssss_dddd();
-    void Z81_ssss_dddd();
-    void Z82_ssss_dddd();
-    void Z83_ssss_dddd();
-    void Z84_ssss_dddd();
-    void Z85_ssss_dddd();
-    void Z86_ssss_dddd();
-    void Z87_ssss_dddd();
-    void Z88_ssss_dddd();
-    void Z89_ssss_dddd();
-    void Z8A_ssss_dddd();
-    void Z8B_ssss_dddd();
-    void Z8C_dddd_0000();
-    void Z8C_dddd_0010();
-    void Z8C_dddd_0100();
-    void Z8C_dddd_0110();
-    void Z8C_dddd_0001();
-    void Z8C_dddd_1000();
-    void Z8C_dddd_1001();
-    void Z8D_0000_0111();
-    void Z8D_dddd_0000();
-    void Z8D_dddd_0010();
-    void Z8D_dddd_0100();
-    void Z8D_dddd_0110();
-    void Z8D_dddd_1000();
-    void Z8D_imm4_0001();
-    void Z8D_imm4_0011();
-    void Z8D_imm4_0101();
-    void Z8E_imm8();
-    void Z8F_imm8();
-    void Z90_ssss_dddd();
-    void Z91_ddN0_ssss();
-    void Z92_ssss_dddd();
-    void Z93_ddN0_ssss();
-    void Z94_ssss_dddd();
-    void Z95_ssN0_dddd();
-    void Z96_ssss_dddd();
-    void Z97_ssN0_dddd();
-    void Z98_ssss_dddd();
-    void Z99_ssss_dddd();
-    void Z9A_ssss_dddd();
-    void Z9B_ssss_dddd();
-    void Z9C_dddd_1000();
-    void Z9D_imm8();
-    void Z9E_0000_cccc();
-    void Z9F_imm8();
-    void ZA0_ssss_dddd();
-    void ZA1_ssss_dddd();
-    void ZA2_dddd_imm4();
-    void ZA3_dddd_imm4();
-    void ZA4_dddd_imm4();
-    void ZA5_dddd_imm4();
-    void ZA6_dddd_imm4();
-    void ZA7_dddd_imm4();
-    void ZA8_dddd_imm4m1();
-    void ZA9_dddd_imm4m1();
-    void ZAA_dddd_imm4m1();
-    void ZAB_dddd_imm4m1();
-    void ZAC_ssss_dddd();
-    void ZAD_ssss_dddd();
-    void ZAE_dddd_cccc();
-    void ZAF_dddd_cccc();
-    void ZB0_dddd_0000();
-    void ZB1_dddd_0000();
-    void ZB1_dddd_0111();
-    void ZB1_dddd_1010();
-    void ZB2_dddd_0001_imm8();
-    void ZB2_dddd_0011_0000_ssss_0000_0000();
-    void ZB2_dddd_00I0();
-    void ZB2_dddd_01I0();
-    void ZB2_dddd_1001_imm8();
-    void ZB2_dddd_1011_0000_ssss_0000_0000();
-    void ZB2_dddd_10I0();
-    void ZB2_dddd_11I0();
-    void ZB3_dddd_0001_imm8();
-    void ZB3_dddd_0011_0000_ssss_0000_0000();
-    void ZB3_dddd_00I0();
-    void ZB3_dddd_0101_imm8();
-    void ZB3_dddd_0111_0000_ssss_0000_0000();
-    void ZB3_dddd_01I0();
-    void ZB3_dddd_1001_imm8();
-    void ZB3_dddd_1011_0000_ssss_0000_0000();
-    void ZB3_dddd_10I0();
-    void ZB3_dddd_1101_imm8();
-    void ZB3_dddd_1111_0000_ssss_0000_0000();
-    void ZB3_dddd_11I0();
-    void ZB4_ssss_dddd();
-    void ZB5_ssss_dddd();
-    void ZB6_ssss_dddd();
-    void ZB7_ssss_dddd();
-    void ZB8_ddN0_0010_0000_rrrr_ssN0_0000();
-    void ZB8_ddN0_0110_0000_rrrr_ssN0_1110();
-    void ZB8_ddN0_1010_0000_rrrr_ssN0_0000();
-    void ZB8_ddN0_1110_0000_rrrr_ssN0_1110();
-    void ZB8_ddN0_0000_0000_rrrr_ssN0_0000();
-    void ZB8_ddN0_0100_0000_rrrr_ssN0_0000();
-    void ZB8_ddN0_1000_0000_rrrr_ssN0_0000();
-    void ZB8_ddN0_1100_0000_rrrr_ssN0_0000();
-    void ZB9_imm8();
-    void ZBA_ssN0_0000_0000_rrrr_dddd_cccc();
-    void ZBA_ssN0_0001_0000_rrrr_ddN0_x000();
-    void ZBA_ssN0_0010_0000_rrrr_ddN0_cccc();
-    void ZBA_ssN0_0100_0000_rrrr_dddd_cccc();
-    void ZBA_ssN0_0110_0000_rrrr_ddN0_cccc();
-    void ZBA_ssN0_1000_0000_rrrr_dddd_cccc();
-    void ZBA_ssN0_1001_0000_rrrr_ddN0_x000();
-    void ZBA_ssN0_1010_0000_rrrr_ddN0_cccc();
-    void ZBA_ssN0_1100_0000_rrrr_dddd_cccc();
-    void ZBA_ssN0_1110_0000_rrrr_ddN0_cccc();
-    void ZBB_ssN0_0000_0000_rrrr_dddd_cccc();
-    void ZBB_ssN0_0001_0000_rrrr_ddN0_x000();
-    void ZBB_ssN0_0010_0000_rrrr_ddN0_cccc();
-    void ZBB_ssN0_0100_0000_rrrr_dddd_cccc();
-    void ZBB_ssN0_0110_0000_rrrr_ddN0_cccc();
-    void ZBB_ssN0_1000_0000_rrrr_dddd_cccc();
-    void ZBB_ssN0_1001_0000_rrrr_ddN0_x000();
-    void ZBB_ssN0_1010_0000_rrrr_ddN0_cccc();
-    void ZBB_ssN0_1100_0000_rrrr_dddd_cccc();
-    void ZBB_ssN0_1110_0000_rrrr_ddN0_cccc();
-    void ZBC_aaaa_bbbb();
-    void ZBD_dddd_imm4();
-    void ZBE_aaaa_bbbb();
-    void ZBF_imm8();
-    void Z20_0000_dddd_imm8();
-    void ZC_dddd_imm8();
-    void ZD_dsp12();
-    void ZE_cccc_dsp8();
-    void ZF_dddd_0dsp7();
-    void ZF_dddd_1dsp7();
+    // Segment translation (z8001_device::set_mmu)
+    enum { MMU_READ, MMU_WRITE, MMU_FETCH };
+    z8000_segment *m_segments;      /* m_segment_table while the MMU is on, else null */
+    std::array<z8000_segment, z8000_segment::COUNT> m_segment_table;
+    z8000_segment_violation m_segment_violation;
+    inline bool translate(uint32_t &addr, int access);
+    void segment_violation(uint32_t addr, int access, uint8_t type);
+    void update_fetch_path();
+
+    // m_cache and m_opcache while the MMU is on; only ever read
+    struct fetch_translator : z8000_memory_bus {
+        z8002_device* cpu;
+        explicit fetch_translator(z8002_device* c) : cpu(c) {}
+        uint8_t read_byte(uint32_t addr) override;
+        uint16_t read_word(uint32_t addr) override;
+        void write_byte(uint32_t, uint8_t) override {}
+        void write_word(uint32_t, uint16_t) override {}
+        void write_word(uint32_t, uint16_t, uint16_t) override {}
+    };
+    fetch_translator m_fetch_translator;
+
+    // The program space as instruction fetches see it: as attached, or
+    // through the memory statistics' own counting bus
+    mem_specific m_fetch_space;
+    void attach_memory();
+
+    // Breakpoints and watchpoints (add_breakpoint)
+    struct debug_point {
+        int id;
+        uint8_t kind;           /* z8000_debug_hit::BREAKPOINT, MEMORY or IO */
+        uint8_t access;         /* watched accesses */
+        uint8_t space;          /* I/O space */
+        uint32_t first, last;
+    };
+    std::vector<debug_point> m_debug_points;
+    int m_debug_next_id;
+    unsigned m_breakpoints;             /* points of each kind */
+    unsigned m_mem_watches;
+    unsigned m_io_watches;
+    std::vector<uint8_t> m_break_pages; /* page holds a breakpoint */
+    std::vector<uint8_t> m_watch_pages; /* page holds a watched address */
+    std::array<uint8_t, 512> m_io_watch_pages;  /* 256-port pages, normal then special */
+    z8000_debug_hit m_debug_hit;
+    bool m_break_skip;                  /* next instruction runs without a breakpoint check */
+    int add_debug_point(uint8_t kind, uint8_t access, uint8_t space, uint32_t first, uint32_t last);
+    void update_debug_points();
+    void update_memory_paths();
+    inline bool at_breakpoint();
+    void watch_memory(uint32_t first, uint32_t last, uint8_t access, uint16_t value);
+    void watch_io(uint16_t port, int mode, bool word, uint8_t access, uint16_t value);
+    void debug_hit(const debug_point &p, uint32_t addr, uint8_t access, uint16_t value);
+
+    // While memory watches are set, m_program, m_data and m_stack have no
+    // page map and go to these, which pass each access on to the space as
+    // attached and check it against the watched pages; attached is kept
+    // up to date either way
+    struct watch_bus : z8000_memory_bus {
+        z8002_device* cpu;
+        mem_specific attached;
+        explicit watch_bus(z8002_device* c) : cpu(c) {}
+        uint8_t read_byte(uint32_t addr) override;
+        uint16_t read_word(uint32_t addr) override;
+        void write_byte(uint32_t addr, uint8_t val) override;
+        void write_word(uint32_t addr, uint16_t val) override;
+        void write_word(uint32_t addr, uint16_t val, uint16_t mask) override;
+    };
+    watch_bus m_program_watch;
+    watch_bus m_data_watch;
+    watch_bus m_stack_watch;
+
+    // m_io_bus while I/O watches are set
+    struct io_watch_bus : z8000_io_bus {
+        z8002_device* cpu;
+        z8000_io_bus* attached = nullptr;
+        explicit io_watch_bus(z8002_device* c) : cpu(c) {}
+        uint8_t read_byte(uint16_t addr, int mode) override;
+        uint16_t read_word(uint16_t addr, int mode) override;
+        void write_byte(uint16_t addr, uint8_t val, int mode) override;
+        void write_word(uint16_t addr, uint16_t val, int mode) override;
+        bool read_block(uint16_t addr, int mode, uint16_t* data, uint32_t count, bool word) override;
+        bool write_block(uint16_t addr, int mode, const uint16_t* data, uint32_t count, bool word) override;
+    };
+    io_watch_bus m_io_watch;
 
 private:
     // structure for the opcode definition table
@@ -754,15 +1234,111 @@ private:
     struct Z8000_init {
         int     beg, end, step;
         int     size, cycles;
-        opcode_func opcode;
+        opcode_func opcode[2];  /* Z8002 and Z8001 instantiation */
     };
 
-    /* opcode execution table */
+    /* opcode execution table, and the opcode -> table index map built
+       from it at compile time; shared by all instances */
     static const Z8000_init table[];
-    u16 z8000_exec[0x10000];
+    static const std::array<u16, 0x10000> z8000_exec;
+    static constexpr std::array<u16, 0x10000> make_exec_table();
+
+#if Z8000_THREADED_DISPATCH
+    /* threaded dispatch: a function per table entry charges the entry's
+       cycles, runs its handler and calls the next instruction's function
+       straight from the opcode word, so each handler gets a dispatch
+       branch of its own.  The chain returns to run_loop() at the latest
+       every THREADED_CHAIN instructions, which bounds the stack where the
+       compiler does not turn the calls into jumps. */
+    typedef void (*threaded_func)(z8002_device &cpu, unsigned chain);
+    static constexpr unsigned THREADED_CHAIN = 64;
+    template <unsigned Index, bool Z8001> static void threaded_op(z8002_device &cpu, unsigned chain);
+    template <bool Z8001, size_t... Index>
+    static constexpr std::array<threaded_func, 0x10000> make_threaded_table(std::index_sequence<Index...>);
+    static const std::array<threaded_func, 0x10000> threaded_dispatch[2];  /* Z8002, Z8001 */
+#endif
 
     /* zero, sign and parity flags for logical byte operations */
-    u8 z8000_zsp[256];
+    static const std::array<u8, 256> z8000_zsp;
+
+    /* the request Interrupt() takes first for a set of Z8000_* bits */
+    static const std::array<u8, 256> z8000_irq_pick;
+
+    /* NVI and VI vectors fetched from the PSA: the VI entries, then the
+       VI FCW and the NVI PC and FCW; valid while gen is m_vector_gen */
+    struct cached_vector {
+        uint32_t value;
+        uint32_t gen;
+    };
+    static constexpr unsigned VEC_VI_FCW = 256, VEC_NVI_PC = 257, VEC_NVI_FCW = 258;
+    static constexpr uint32_t PSA_PAGES = 3;    /* up to VEC00 + 2 * 255 + 4 */
+    std::array<cached_vector, 259> m_vectors;
+    uint32_t m_vector_gen;
+    uint32_t m_psa_page;                        /* first page of the PSA */
+    template<typename Read> uint32_t psa_vector(unsigned slot, Read read);
+    void invalidate_vectors();
+    void update_psa();
+
+    uint64_t m_irq_asserted[3];     /* cycle each line was asserted or last acknowledged */
+    irq_stats m_irq_stats[3];
+    void count_irq(int line);
+
+    /* DAB correction for a C, DA and H state and low digit: a byte at or
+       above carry_from gets adjust[1] added and sets C, one below gets
+       adjust[0] */
+    struct dab_rule {
+        uint16_t carry_from;
+        uint8_t adjust[2];
+    };
+    static const std::array<dab_rule, 16> z8000_dab;
+
+    /* pre-decoded basic-block cache */
+    static constexpr int BLOCK_PAGE_SHIFT = 8;       /* invalidation granularity */
+    static constexpr int BLOCK_MAX_INSNS = 32;
+    static constexpr int BLOCK_SLOTS = 4096;         /* direct-mapped, indexed by pc */
+    static constexpr int BLOCK_ARENA = 0x10000;      /* decoded instructions */
+    static constexpr uint16_t BLOCK_MODE_MASK = 0xe000;  /* F_SEG | F_S_N | F_EPU */
+
+    /* micro-ops of translated blocks: register-only kinds first, then
+       the branches, then a call of the handler, which may do anything */
+    enum : uint8_t {
+        UOP_LD_R, UOP_LD_I, UOP_LDB_R, UOP_LDB_I,
+        UOP_ADD_R, UOP_ADD_I, UOP_SUB_R, UOP_SUB_I, UOP_CP_R, UOP_CP_I,
+        UOP_AND_R, UOP_AND_I, UOP_OR_R, UOP_OR_I, UOP_XOR_R, UOP_XOR_I,
+        UOP_INC, UOP_DEC,
+        UOP_JR, UOP_DJNZ,
+        UOP_CALL
+    };
+
+    struct block_insn {
+        opcode_func opcode;
+        uint32_t    op[4];      /* opcode and operand words, as fetched */
+        uint32_t    next_pc;    /* pc after the operand fetches */
+        uint16_t    cycles;
+        uint8_t     op_valid;
+        uint8_t     uop;        /* UOP_CALL until translated */
+        uint8_t     dst, src;   /* m_regs.W/B indices, or JR condition in src */
+        uint16_t    imm;        /* immediate, increment or branch displacement */
+    };
+
+    struct block_entry {
+        uint32_t pc;
+        uint32_t start;         /* index of the first instruction in m_block_arena */
+        uint32_t gen;           /* m_code_gen[page] when the block was recorded */
+        uint16_t page;
+        uint16_t mode;          /* fcw & BLOCK_MODE_MASK when recorded */
+        uint16_t count;         /* 0 = empty slot */
+        uint32_t hits;          /* runs, counted up to m_block_hot */
+    };
+
+    bool m_block_cache;
+    unsigned m_block_hot;
+    uint32_t m_page_mask;
+    uint32_t m_block_arena_used;
+    std::vector<block_insn> m_block_arena;
+    std::vector<block_entry> m_blocks;
+    std::vector<uint8_t> m_code_pages;   /* page holds at least one cached block */
+    std::vector<uint32_t> m_code_gen;    /* bumped when a code page is written */
 };
 
 // Z8001 segmented mode device
@@ -772,17 +1348,28 @@ public:
 
     void dump_regs() const override;
 
+    // Segment translation, as by a pair of Z8010 MMUs.  With the MMU on,
+    // each logical <<segment>>offset address is mapped through its
+    // segment's descriptor and the memory buses see 24-bit physical
+    // addresses.  An access past the segment's limit or against its
+    // attributes raises a segment trap, taken once the instruction has
+    // finished; get_segment_violation() tells the handler why.  Violating
+    // writes and all CPU-inhibited accesses are suppressed, the latter
+    // reading FFFF; other violating reads go ahead.  The table starts out
+    // as an identity mapping.  Descriptors survive reset() and are not
+    // part of z8000_state.  Expect runs with the MMU on to be slower:
+    // translate() checks the descriptor on every access, fetches included,
+    // as no host page pointers are kept per segment, and the block cache,
+    // the bulk repeat paths and the cached PSA vectors stand down.
+    void set_mmu(bool enable);
+    bool mmu_enabled() const { return m_segments != nullptr; }
+    void set_segment(unsigned seg, const z8000_segment& desc) { m_segment_table[seg % z8000_segment::COUNT] = desc; }
+    const z8000_segment& get_segment(unsigned seg) const { return m_segment_table[seg % z8000_segment::COUNT]; }
+    const z8000_segment_violation& get_segment_violation() const { return m_segment_violation; }
+    void clear_segment_violation() { m_segment_violation = z8000_segment_violation(); }
+
 protected:
-    virtual bool get_segmented_mode() const override;
-    virtual uint32_t adjust_addr_for_nonseg_mode(uint32_t addr) override;
-    virtual void PUSH_PC() override;
-    virtual void CHANGE_FCW(uint16_t fcw) override;
-    virtual uint32_t GET_PC(uint32_t VEC) override;
-    virtual uint32_t get_reset_pc() override;
-    virtual uint16_t GET_FCW(uint32_t VEC) override;
-    virtual uint32_t F_SEG_Z8001() override;
-    virtual uint32_t PSA_ADDR() override;
-    virtual uint32_t read_irq_vector() override;
+    virtual uint16_t model() const override { return 8001; }
 };
 
 /* possible values for z8k_segm_mode */
@@ -0,0 +1,23 @@
+// Z8000 breakpoints and watchpoints
+// What stopped a run, as reported by z8002_device::get_debug_hit(); see
+// z8002_device::add_breakpoint().
+
+#ifndef Z8000_DEBUG_H
+#define Z8000_DEBUG_H
+
+#include <cstdint>
+
+struct z8000_debug_hit {
+    enum : uint8_t { NONE, BREAKPOINT, MEMORY, IO };    // kind
+    enum : uint8_t { READ = 1, WRITE = 2 };             // watched accesses
+
+    uint8_t kind = NONE;
+    uint8_t access = 0;     // READ or WRITE; 0 for a breakpoint
+    uint8_t space = 0;      // I/O space: 0 normal (IN/OUT), 1 special (SIN/SOUT)
+    int id = 0;             // as returned when the point was added
+    uint32_t pc = 0;        // the instruction; not yet executed for a breakpoint
+    uint32_t addr = 0;      // first byte address or port accessed
+    uint16_t value = 0;     // value read or written; bytes in the low half
+};
+
+#endif // Z8000_DEBUG_H
@@ -7,6 +7,23 @@
 
 #include <cstdint>
 
+// Granularity of the optional direct-access page map (see below)
+constexpr int Z8000_PAGE_SHIFT = 8;
+constexpr uint32_t Z8000_PAGE_SIZE = 1u << Z8000_PAGE_SHIFT;
+
+// Direct host-memory page map a RAM-backed bus may publish.
+// Entry (addr >> Z8000_PAGE_SHIFT) & mask points at the host bytes of
+// that page, stored big-endian as the Z8000 sees them; word accesses use
+// the even address.  A null entry (MMIO, ROM for writes, pages being
+// traced) sends the access through the virtual methods instead.  The
+// arrays themselves must not be null.  The CPU consults the entries on
+// every access, so the bus may change them at any time.
+struct z8000_page_map {
+    const uint8_t* const* read = nullptr;
+    uint8_t* const* write = nullptr;
+    uint32_t mask = 0;
+};
+
 // What the CPU needs from the system for memory access.
 // The CPU presents addresses as-is (23-bit for Z8001 with segment info,
 // 16-bit for Z8002). The implementer handles physical address translation.
@@ -18,6 +35,11 @@ public:
     virtual void write_byte(uint32_t addr, uint8_t val) = 0;
     virtual void write_word(uint32_t addr, uint16_t val) = 0;
     virtual void write_word(uint32_t addr, uint16_t val, uint16_t mask) = 0;
+
+    // Optional fast path: return a page map that stays valid while the
+    // bus is attached to a CPU, or nullptr to use the methods above only.
+    // Queried when the bus is attached.
+    virtual const z8000_page_map* page_map() { return nullptr; }
 };
 
 // What the CPU needs from the system for I/O access.
@@ -29,6 +51,16 @@ public:
     virtual uint16_t read_word(uint16_t addr, int mode) = 0;
     virtual void write_byte(uint16_t addr, uint8_t val, int mode) = 0;
     virtual void write_word(uint16_t addr, uint16_t val, int mode) = 0;
+
+    // Optional fast path for the repeating I/O instructions (INIR, OTDRB,
+    // SINIR, ...): transfer count elements with port addr in one call,
+    // one value per element in execution order, bytes in the low half.
+    // Return false, without touching the device, to have the CPU make the
+    // accesses one at a time instead.
+    virtual bool read_block(uint16_t /*addr*/, int /*mode*/, uint16_t* /*data*/,
+                            uint32_t /*count*/, bool /*word*/) { return false; }
+    virtual bool write_block(uint16_t /*addr*/, int /*mode*/, const uint16_t* /*data*/,
+                             uint32_t /*count*/, bool /*word*/) { return false; }
 };
 
 #endif // Z8000_INTF_H
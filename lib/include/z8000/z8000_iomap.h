@@ -0,0 +1,89 @@
+// Z8000 I/O port map
+// A z8000_io_bus that dispatches each port access through a two-level
+// table to the handler registered for that port range, separately for
+// normal (IN/OUT) and special (SIN/SOUT) I/O, instead of every embedding
+// decoding the 64K port space itself.
+
+#ifndef Z8000_IOMAP_H
+#define Z8000_IOMAP_H
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <z8000/z8000_intf.h>
+
+class z8000_io_map : public z8000_io_bus {
+public:
+    // Port spaces, as in the bus's mode argument
+    enum { NORMAL = 0, SPECIAL = 1 };
+
+    // Any member may be empty.  A missing width is made from the other
+    // one: a word as the bytes at the even port and the one after it, a
+    // byte as one half of the word at the even port.  The block handlers
+    // serve INIR/OTIR-style repeats in one call (see z8000_io_bus); without
+    // them the CPU makes one access per element.
+    struct handler {
+        std::function<uint8_t(uint16_t port)> read_byte;
+        std::function<uint16_t(uint16_t port)> read_word;
+        std::function<void(uint16_t port, uint8_t value)> write_byte;
+        std::function<void(uint16_t port, uint16_t value)> write_word;
+        std::function<void(uint16_t port, uint16_t* data, uint32_t count, bool word)> read_block;
+        std::function<void(uint16_t port, const uint16_t* data, uint32_t count, bool word)> write_block;
+    };
+
+    z8000_io_map();
+    z8000_io_map(const z8000_io_map&) = delete;
+    z8000_io_map& operator=(const z8000_io_map&) = delete;
+
+    // Route ports first..last of a space to h, replacing what was there
+    void map(int space, uint16_t first, uint16_t last, handler h);
+
+    // Loopback registers: ports first..last read back what was last
+    // written, kept big-endian in regs[port - first] without any call.
+    // The range is widened to whole words (even first, odd last); regs
+    // must cover it and outlive the mapping.
+    void map_registers(int space, uint16_t first, uint16_t last, uint8_t* regs);
+
+    void unmap(int space, uint16_t first, uint16_t last);
+
+    // Value read from unmapped ports (default FF / FFFF); writes to them
+    // are dropped
+    void set_unmapped(int space, uint8_t byte_value, uint16_t word_value);
+
+    // z8000_io_bus interface
+    uint8_t read_byte(uint16_t port, int mode) override;
+    uint16_t read_word(uint16_t port, int mode) override;
+    void write_byte(uint16_t port, uint8_t value, int mode) override;
+    void write_word(uint16_t port, uint16_t value, int mode) override;
+    bool read_block(uint16_t port, int mode, uint16_t* data, uint32_t count, bool word) override;
+    bool write_block(uint16_t port, int mode, const uint16_t* data, uint32_t count, bool word) override;
+
+private:
+    struct entry {
+        handler h;
+        uint8_t* regs = nullptr;    // loopback storage, indexed from first
+        uint16_t first = 0;
+    };
+
+    // Port table: 256 pages of 256 entry indices.  Index 0 is an unmapped
+    // port; pages without any mapping share one page of zeros.
+    static constexpr unsigned PAGE_SHIFT = 8;
+    using page = std::array<uint16_t, 1 << PAGE_SHIFT>;
+
+    const entry& lookup(uint16_t port, int mode) const {
+        const int space = mode & 1;
+        return m_entries[(*m_pages[space][port >> PAGE_SHIFT])[port & ((1 << PAGE_SHIFT) - 1)]];
+    }
+    void assign(int space, uint16_t first, uint16_t last, uint16_t index);
+
+    std::vector<entry> m_entries;
+    std::array<std::array<page*, 1 << (16 - PAGE_SHIFT)>, 2> m_pages;
+    std::vector<std::unique_ptr<page>> m_owned;
+    page m_empty;
+    uint8_t m_unmapped_byte[2];
+    uint16_t m_unmapped_word[2];
+};
+
+#endif // Z8000_IOMAP_H
@@ -0,0 +1,78 @@
+// Z8000 memory access statistics
+// Counters collected by z8002_device::set_memory_stats(): the reads and
+// writes each page of the program, data and stack spaces sees, and the
+// instruction words fetched from it, in flat arrays indexed by page.
+// write_report() lists every page touched; write_interval() summarises
+// the working set since its last call, for a report every n cycles of a
+// run made in slices.
+
+#ifndef Z8000_MEMSTATS_H
+#define Z8000_MEMSTATS_H
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <z8000/z8000_intf.h>
+
+class z8000_memory_stats {
+public:
+    // Counted spaces.  FETCH is the program space as instruction fetches
+    // see it, PROGRAM the data accesses made there (LDR, vectors, ...).
+    enum : unsigned { PROGRAM, DATA, STACK, FETCH, SPACES };
+
+    static constexpr int PAGE_SHIFT = Z8000_PAGE_SHIFT;
+    static constexpr uint32_t PAGE_SIZE = Z8000_PAGE_SIZE;
+
+    // Pages for addresses below size, a power of two; higher addresses
+    // alias onto them.  0x10000 for the Z8002, 0x800000 for the Z8001.
+    explicit z8000_memory_stats(uint32_t size = 0x800000);
+    z8000_memory_stats(const z8000_memory_stats&) = delete;
+    z8000_memory_stats& operator=(const z8000_memory_stats&) = delete;
+
+    uint32_t pages() const { return m_pages; }
+    uint64_t reads(unsigned space, uint32_t page) const { return m_counts[index(space, false) + page]; }
+    uint64_t writes(unsigned space, uint32_t page) const { return m_counts[index(space, true) + page]; }
+    uint64_t accesses(uint32_t page) const;
+
+    // Zero the counters and start a new interval
+    void clear();
+
+    // Every page touched, in address order, as CSV or one JSON object
+    void write_report(FILE* out, bool json) const;
+
+    // Working set of the interval since the last call, or since clear(),
+    // as one CSV or JSON line: the pages touched in each space and in all,
+    // the pages written, and over the whole run so far the pages touched,
+    // those only ever read or fetched (ROM) and those written (RAM).  The
+    // CSV header comes before the first line; cycle is only printed.
+    void write_interval(FILE* out, uint64_t cycle, bool json);
+
+    // The bus counting space's accesses and passing them on to bus; for
+    // z8002_device::set_memory_stats(), which puts these in front of the
+    // spaces.  They have no page map, so every access is counted.
+    z8000_memory_bus* counting_bus(unsigned space, z8000_memory_bus* bus);
+
+private:
+    struct counting : z8000_memory_bus {
+        z8000_memory_bus* bus = nullptr;
+        uint64_t* reads = nullptr;
+        uint64_t* writes = nullptr;
+        uint32_t mask = 0;
+        uint8_t read_byte(uint32_t addr) override;
+        uint16_t read_word(uint32_t addr) override;
+        void write_byte(uint32_t addr, uint8_t val) override;
+        void write_word(uint32_t addr, uint16_t val) override;
+        void write_word(uint32_t addr, uint16_t val, uint16_t mask) override;
+    };
+
+    size_t index(unsigned space, bool write) const { return (space * 2 + write) * size_t(m_pages); }
+
+    uint32_t m_pages;
+    std::vector<uint64_t> m_counts;     // [space][read, write][page]
+    std::vector<uint64_t> m_interval;   // m_counts when the interval began
+    counting m_buses[SPACES];
+    unsigned m_intervals;               // lines written
+};
+
+#endif // Z8000_MEMSTATS_H
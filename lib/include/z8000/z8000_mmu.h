@@ -0,0 +1,48 @@
+// Z8000 segment translation
+// Descriptors for the optional Z8010-style MMU built into z8001_device;
+// see z8001_device::set_mmu().
+
+#ifndef Z8000_MMU_H
+#define Z8000_MMU_H
+
+#include <cstdint>
+
+struct z8000_segment {
+    // attributes; the same bits as the Z8010's attribute field
+    enum : uint8_t {
+        READ_ONLY   = 0x01,
+        SYSTEM_ONLY = 0x02,     // no access in normal mode
+        CPU_INHIBIT = 0x04,     // no access by the CPU at all
+        EXEC_ONLY   = 0x08,     // instruction fetches only
+        DMA_INHIBIT = 0x10,     // kept for DMA emulation; the CPU ignores it
+        DOWNWARD    = 0x20,     // DIRW: a stack segment, growing down from FFFF
+        CHANGED     = 0x40,     // set by the CPU on a write
+        REFERENCED  = 0x80      // set by the CPU on any access
+    };
+
+    static constexpr unsigned COUNT = 128;
+
+    uint16_t base = 0;          // physical address bits 23..8
+    uint8_t limit = 0;          // last valid 256-byte block; the first valid one if DOWNWARD
+    uint8_t attributes = 0;
+};
+
+// What the segment trap was raised for: the first violating access since
+// the record was last cleared, and every kind of violation since then
+struct z8000_segment_violation {
+    enum : uint8_t {
+        LENGTH      = 0x01,     // offset outside the segment's limit
+        READ_ONLY   = 0x02,
+        SYSTEM_ONLY = 0x04,
+        EXEC_ONLY   = 0x08,
+        CPU_INHIBIT = 0x10
+    };
+
+    uint8_t type = 0;           // 0: none
+    uint8_t segment = 0;
+    uint16_t offset = 0;
+    bool write = false;
+    bool fetch = false;
+};
+
+#endif // Z8000_MMU_H
@@ -0,0 +1,67 @@
+// Z8000 execution profile
+// Counters collected by z8002_device::set_profile(); see write_profile()
+// for the CSV/JSON report.
+
+#ifndef Z8000_PROFILE_H
+#define Z8000_PROFILE_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct z8000_profile {
+    // modes for set_profile()
+    enum : unsigned {
+        OPCODES = 1 << 0,   // executions and cycles per opcode handler
+        PCS     = 1 << 1,   // histogram of instruction addresses
+        CALLS   = 1 << 2,   // call graph from CALL/CALR and RET
+        TRAPS   = 1 << 3,   // traps and interrupts taken, by kind
+        ALL     = OPCODES | PCS | CALLS | TRAPS
+    };
+
+    // traps[] index, in order of priority
+    enum : unsigned {
+        TRAP_RESET, TRAP_EXTENDED, TRAP_PRIVILEGED, TRAP_SYSTEM_CALL,
+        TRAP_SEGMENT, TRAP_NMI, TRAP_NVI, TRAP_VI, TRAP_KINDS
+    };
+
+    static constexpr unsigned PC_SHIFT = 4;            // 16-byte histogram buckets
+    static constexpr uint32_t ROOT = 0xffffffff;      // caller of outermost calls
+
+    struct counter {
+        uint64_t count = 0;
+        uint64_t cycles = 0;     // including data-dependent timing
+    };
+
+    unsigned modes = 0;
+    unsigned pc_period = 1;      // sample every n-th instruction
+
+    // Indexed by the handler's entry in the opcode table
+    std::vector<counter> opcodes;
+
+    // Samples per bucket; bucket n covers addresses n << PC_SHIFT and up
+    std::vector<uint64_t> pcs;
+
+    // Times each TRAP_* kind was taken
+    uint64_t traps[TRAP_KINDS] = {};
+
+    // Keyed by caller entry point << 32 | callee entry point.  count is
+    // the number of calls, cycles the time spent in the callee and below,
+    // credited when it returns.
+    std::unordered_map<uint64_t, counter> calls;
+
+    // Open calls, innermost last
+    struct frame {
+        uint32_t caller;
+        uint32_t callee;
+        uint64_t start;
+    };
+    std::vector<frame> stack;
+
+    // per opcode table entry: 0, CALL_INSN or RET_INSN
+    enum : uint8_t { CALL_INSN = 1, RET_INSN = 2 };
+    std::vector<uint8_t> kind;
+    unsigned pc_countdown = 1;
+};
+
+#endif // Z8000_PROFILE_H
@@ -0,0 +1,141 @@
+// Z8000 I/O record and replay
+// z8000_io_recorder sits between the CPU and a z8000_io_bus and logs
+// every port access and interrupt line change, with its cycle, to an
+// append-only file; z8000_io_replayer plays such a log back in place of
+// the devices.  A run whose only outside input comes through the I/O bus
+// and the interrupt lines is then repeated exactly: the same instructions
+// and the same cycle counts, without the devices, e.g. as a benchmark.
+
+#ifndef Z8000_REPLAY_H
+#define Z8000_REPLAY_H
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <z8000/z8000.h>
+
+// A recording is a header followed by records, all little-endian:
+//   header:  magic "Z8KR" (u32), version (u16), CPU model (u16)
+//   record:  tag (u8), cycle delta from the previous record (LEB128),
+//            then for I/O the port (u16) and the value (u8 or u16), for a
+//            line change the line (u8), state (u8) and vector (u16), and
+//            nothing for END
+// The last record is END, at the cycle count when recording stopped.
+struct z8000_replay_format {
+    static constexpr uint32_t MAGIC = 0x524b385a;  // "Z8KR"
+    static constexpr uint16_t VERSION = 1;
+
+    // tag: kind in bits 0..2, special I/O space in bit 3
+    enum : uint8_t {
+        READ_BYTE = 0, READ_WORD = 1, WRITE_BYTE = 2, WRITE_WORD = 3,
+        LINE = 4, END = 5,
+        SPECIAL = 0x08
+    };
+};
+
+class z8000_io_recorder : public z8000_io_bus {
+public:
+    // Accesses go on to io; cycles are taken from cpu
+    z8000_io_recorder(z8002_device& cpu, z8000_io_bus& io);
+    ~z8000_io_recorder() override;
+    z8000_io_recorder(const z8000_io_recorder&) = delete;
+    z8000_io_recorder& operator=(const z8000_io_recorder&) = delete;
+
+    // Start a recording; false if the file cannot be created.  Meant to
+    // be called before the CPU's reset().  close() writes the END record
+    // and is done by the destructor as well.
+    bool open(const char* path);
+    void close();
+    bool is_open() const { return m_file != nullptr; }
+
+    // The interrupt source: devices raise and clear the CPU's lines
+    // through this, which logs the change and passes it on
+    void set_input_line(int line, int state, uint16_t vector = 0);
+
+    // z8000_io_bus interface
+    uint8_t read_byte(uint16_t port, int mode) override;
+    uint16_t read_word(uint16_t port, int mode) override;
+    void write_byte(uint16_t port, uint8_t value, int mode) override;
+    void write_word(uint16_t port, uint16_t value, int mode) override;
+    bool read_block(uint16_t port, int mode, uint16_t* data, uint32_t count, bool word) override;
+    bool write_block(uint16_t port, int mode, const uint16_t* data, uint32_t count, bool word) override;
+
+private:
+    void record(uint8_t tag, uint16_t port, uint16_t value);
+
+    z8002_device& m_cpu;
+    z8000_io_bus& m_io;
+    FILE* m_file;
+    uint64_t m_last_cycle;
+};
+
+class z8000_io_replayer : public z8000_io_bus {
+public:
+    explicit z8000_io_replayer(z8002_device& cpu);
+    ~z8000_io_replayer() override;
+    z8000_io_replayer(const z8000_io_replayer&) = delete;
+    z8000_io_replayer& operator=(const z8000_io_replayer&) = delete;
+
+    // Load a recording; nullptr or an error message.  It must have been
+    // made on the same CPU model.
+    const char* open(const char* path);
+
+    // CPU model a recording was made on (8001 or 8002), 0 if the file is
+    // not a recording
+    static uint16_t recorded_model(const char* path);
+
+    // Play from the beginning: rewinds the accesses and schedules the
+    // line changes as CPU events.  Call it after the CPU's reset(), with
+    // the CPU and memory in the state the recording started from; it may
+    // be called again to repeat the run.
+    void start();
+
+    // Cycle count at which the recording stopped
+    uint64_t end_cycle() const { return m_end_cycle; }
+
+    // The guest must make the recorded accesses in order, with the same
+    // port, space, width and, for writes, value.  The first access that
+    // does not, or that runs past the recording, stops the CPU with
+    // request_stop(); reads from then on return FF/FFFF and writes are
+    // dropped.
+    bool diverged() const { return m_diverged; }
+    uint64_t divergence_cycle() const { return m_divergence_cycle; }
+    size_t accesses_replayed() const { return m_next; }
+
+    // z8000_io_bus interface
+    uint8_t read_byte(uint16_t port, int mode) override;
+    uint16_t read_word(uint16_t port, int mode) override;
+    void write_byte(uint16_t port, uint8_t value, int mode) override;
+    void write_word(uint16_t port, uint16_t value, int mode) override;
+    bool read_block(uint16_t port, int mode, uint16_t* data, uint32_t count, bool word) override;
+    bool write_block(uint16_t port, int mode, const uint16_t* data, uint32_t count, bool word) override;
+
+private:
+    struct access {
+        uint8_t tag;
+        uint16_t port;
+        uint16_t value;
+    };
+    struct line_change {
+        uint64_t cycle;
+        int line;
+        int state;
+        uint16_t vector;
+    };
+
+    bool expect(uint8_t tag, uint16_t port, int mode);
+    void diverge();
+    void schedule_line(size_t index);
+
+    z8002_device& m_cpu;
+    std::vector<access> m_accesses;
+    std::vector<line_change> m_lines;
+    uint64_t m_end_cycle;
+    size_t m_next;                  // next access to replay
+    uint64_t m_event;               // pending line change event, 0 if none
+    bool m_diverged;
+    uint64_t m_divergence_cycle;
+};
+
+#endif // Z8000_REPLAY_H
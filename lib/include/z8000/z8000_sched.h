@@ -0,0 +1,52 @@
+// Z8000 device event scheduler
+// Callbacks keyed on the CPU's absolute cycle count.  z8002_device keeps
+// one of these: run() and run_until() execute exactly up to the earliest
+// deadline, fire whatever is due and carry on, instead of the caller
+// slicing the run into small budgets and polling its devices in between.
+
+#ifndef Z8000_SCHED_H
+#define Z8000_SCHED_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class z8000_scheduler {
+public:
+    // Called with the cycle the event was scheduled for, which may be a
+    // few cycles before get_cycles(); periodic devices reschedule from it
+    // so they do not drift.
+    using callback = std::function<void(uint64_t cycle)>;
+
+    static constexpr uint64_t NEVER = UINT64_MAX;
+
+    // Returns an id for cancel(); ids are never reused
+    uint64_t add(uint64_t cycle, callback cb);
+    bool cancel(uint64_t id);
+    void clear() { m_heap.clear(); }
+
+    bool empty() const { return m_heap.empty(); }
+    uint64_t next() const { return m_heap.empty() ? NEVER : m_heap.front().cycle; }
+
+    // Fire every event due at or before now, earliest first and in
+    // scheduling order within a cycle.  Callbacks may add and cancel
+    // events; those due by now fire in the same call.
+    void fire(uint64_t now);
+
+private:
+    struct event {
+        uint64_t cycle;
+        uint64_t id;
+        callback cb;
+    };
+
+    // std::*_heap comparator for a min-heap on (cycle, id)
+    static bool later(const event& a, const event& b) {
+        return a.cycle != b.cycle ? a.cycle > b.cycle : a.id > b.id;
+    }
+
+    std::vector<event> m_heap;
+    uint64_t m_next_id = 1;
+};
+
+#endif // Z8000_SCHED_H
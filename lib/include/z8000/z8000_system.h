@@ -0,0 +1,153 @@
+// Z8000 multi-CPU system
+// Runs several CPUs in lockstep: every CPU runs one quantum of cycles up
+// to a common boundary, then all stop while shared RAM is reconciled and
+// the sync callback passes signals between them.  With threads enabled,
+// each CPU but the first runs its quanta on a host thread of its own,
+// and the CPUs meet at a barrier at each boundary.
+//
+// Each CPU keeps its own buses.  RAM the CPUs share is a window: a range
+// of each CPU's own memory, possibly at a different address on each, that
+// reads as the same bytes.  A store one CPU makes to its copy reaches the
+// others at the next quantum boundary, and where two CPUs store to the
+// same byte within one quantum the higher-numbered CPU's value wins, so a
+// run gives the same result with and without threads.  TSET and other
+// read-modify-write sequences are therefore not atomic across CPUs;
+// exchange data through locations that only one side writes.
+
+#ifndef Z8000_SYSTEM_H
+#define Z8000_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <z8000/z8000.h>
+
+class z8000_system {
+public:
+    // Why run_until() returned: budget, halt when every CPU is halted
+    // with nothing left to wake it, request after request_stop(), or the
+    // reason the CPU given in run_result::cpu ended its quantum early
+    // (breakpoint, watchpoint, its own request_stop(), no_bus)
+    using stop_reason = z8002_device::stop_reason;
+
+    struct run_result {
+        stop_reason reason;
+        int cpu;                // CPU that stopped the run, -1 if none
+        uint64_t cycles;        // system cycles run by this call
+    };
+
+    // Called at each quantum boundary with all CPUs stopped and the
+    // windows reconciled, with the system cycle count.  This is where
+    // devices pass interrupts and other signals from one CPU to another:
+    // while the CPUs run, each may only touch its own devices.
+    using sync_callback = std::function<void(uint64_t cycle)>;
+
+    static constexpr uint32_t QUANTUM = 1000;   // default, in cycles
+
+    z8000_system();
+    ~z8000_system();
+    z8000_system(const z8000_system&) = delete;
+    z8000_system& operator=(const z8000_system&) = delete;
+
+    // Add a CPU, not owned, with its buses attached; returns its number.
+    // All CPUs count cycles of the same clock, from where each one's
+    // get_cycles() stands now.  Once added, run it only through the
+    // system.  Two CPUs must not share a bus object.
+    unsigned add_cpu(z8002_device* cpu);
+    unsigned cpus() const { return unsigned(m_cpus.size()); }
+    z8002_device* cpu(unsigned n) const { return m_cpus[n].cpu; }
+
+    // A window of size bytes of shared RAM; returns its id.  map_window()
+    // places it at base in the memory bus of CPU cpu, as that bus sees
+    // addresses.  The window starts out with the contents of its first
+    // mapping, copied to the others when the next run or sync() begins.
+    // Windows on pages the bus maps directly are compared with memcmp()
+    // at each boundary; others are read through read_byte().
+    int add_window(uint32_t size);
+    void map_window(int window, unsigned cpu, z8000_memory_bus* bus, uint32_t base);
+
+    void set_quantum(uint32_t cycles) { m_quantum = cycles ? cycles : 1; }
+    uint32_t get_quantum() const { return m_quantum; }
+
+    // Run CPUs other than the first on host threads of their own.  The
+    // threads spin at the barrier for a short while, then sleep until the
+    // next quantum.
+    void set_threads(bool enable);
+
+    void set_sync(sync_callback cb) { m_sync = std::move(cb); }
+
+    // Run until the system cycle count reaches target_cycle, a quantum
+    // at a time; the last quantum is cut short to end on the target
+    run_result run_until(uint64_t target_cycle);
+    run_result run(uint64_t cycles) { return run_until(m_cycles + cycles); }
+
+    // End run_until() at the next quantum boundary; for sync callbacks
+    void request_stop() { m_stop_req = true; }
+
+    uint64_t get_cycles() const { return m_cycles; }
+
+    // Reconcile the windows now, after changing a CPU's copy between runs
+    void sync();
+
+private:
+    struct cpu_slot {
+        z8002_device* cpu;
+        uint64_t origin;        // cpu->get_cycles() at system cycle 0
+        stop_reason reason;     // how its last quantum ended
+    };
+
+    struct mapping {
+        unsigned cpu;
+        z8000_memory_bus* bus;
+        uint32_t base;
+        std::vector<uint32_t> changed;  // offsets stored to this quantum
+    };
+
+    struct window {
+        std::vector<uint8_t> image;     // contents as of the last boundary
+        std::vector<mapping> maps;      // in CPU order
+        z8000_memory_bus* seed = nullptr;   // bus of the first mapping made
+        bool primed = false;
+    };
+
+    void run_cpu(unsigned n, uint64_t target);
+    void run_quantum(uint64_t target);
+    bool all_waiting() const;
+
+    void prime(window& w);
+    void reconcile(window& w);
+    static uint8_t read(mapping& m, uint32_t offset);
+    static void write(mapping& m, uint32_t offset, uint8_t val);
+
+    void start_threads();
+    void stop_threads();
+    void worker(unsigned n, uint64_t seen);
+
+    std::vector<cpu_slot> m_cpus;
+    std::vector<window> m_windows;
+    sync_callback m_sync;
+    uint32_t m_quantum;
+    uint64_t m_cycles;
+    bool m_stop_req;
+
+    // Barrier: m_go counts quanta started, m_done the workers through
+    // the current one.  Workers that have spun too long sleep on m_wake.
+    bool m_threaded;
+    std::vector<std::thread> m_threads;
+    unsigned m_spins;                   // before yielding; 0 on one core
+    uint64_t m_target;                  // system cycle the quantum ends on
+    std::atomic<uint64_t> m_go;
+    std::atomic<unsigned> m_done;
+    std::atomic<unsigned> m_sleeping;
+    std::atomic<bool> m_quit;
+    std::mutex m_lock;
+    std::condition_variable m_wake;
+    std::vector<uint32_t> m_dirty;      // scratch for reconcile()
+};
+
+#endif // Z8000_SYSTEM_H
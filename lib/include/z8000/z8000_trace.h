@@ -0,0 +1,149 @@
+// Z8000 binary trace records and sinks
+// Compact replacement for the printf trace: the CPU and the buses hand
+// fixed-layout records to a z8000_trace_sink, and tools/z8000trace turns
+// a recorded file back into the familiar listing.
+
+#ifndef Z8000_TRACE_H
+#define Z8000_TRACE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A trace file is a z8000_trace_header followed by records.  Every record
+// starts with its type and its total size in bytes, so readers can skip
+// types they do not know.  Fields are in the byte order given by the
+// header's byte_order mark.
+//
+// Per executed instruction the sink sees, in this order: the memory and
+// I/O accesses the instruction made (including operand fetches when the
+// bus is traced), its Z8000_TRACE_INSN record, then a Z8000_TRACE_REGS
+// record if register tracing is on.  Accesses made while taking an
+// interrupt are attributed to the next instruction.
+
+enum : uint8_t {
+    Z8000_TRACE_INSN = 1,
+    Z8000_TRACE_REGS = 2,
+    Z8000_TRACE_MEM  = 3,
+    Z8000_TRACE_IO   = 4
+};
+
+// flags for Z8000_TRACE_MEM / Z8000_TRACE_IO
+enum : uint8_t {
+    Z8000_TRACE_WRITE   = 0x01,
+    Z8000_TRACE_WORD    = 0x02,
+    Z8000_TRACE_SPECIAL = 0x04     // special I/O space (SIN/SOUT)
+};
+
+struct z8000_trace_header {
+    static constexpr uint32_t MAGIC = 0x54384b5a;  // "ZK8T"
+    static constexpr uint16_t VERSION = 1;
+
+    uint32_t magic;
+    uint16_t version;
+    uint16_t byte_order;    // 0x0102 as written by the producer
+    uint16_t model;         // 8001 or 8002
+    uint16_t pad[3];
+};
+
+// One executed instruction.  Only the first `words` entries of op[] are
+// stored, so the record is 16 + 2 * words bytes long.
+struct z8000_trace_insn {
+    uint8_t  type;
+    uint8_t  size;
+    uint16_t fcw;           // before execution
+    uint32_t pc;
+    uint64_t cycles;        // get_cycles() before execution
+    uint16_t op[4];
+    uint8_t  words() const { return (size - 16) / 2; }
+};
+
+// Registers that changed since the previous Z8000_TRACE_REGS record (all
+// of them in the first record).  value[] holds one entry per set bit of
+// mask, lowest register first: 12 + 2 * popcount(mask) bytes.
+struct z8000_trace_regs {
+    uint8_t  type;
+    uint8_t  size;
+    uint16_t fcw;           // after execution
+    uint32_t pc;            // after execution
+    uint16_t mask;          // bit n: Rn changed
+    uint16_t pad;
+    uint16_t value[16];
+};
+
+struct z8000_trace_mem {
+    uint8_t  type;
+    uint8_t  size;
+    uint8_t  flags;
+    uint8_t  pad;
+    uint32_t addr;
+    uint16_t value;
+    uint16_t mask;          // bits written by a masked word store
+};
+
+struct z8000_trace_io {
+    uint8_t  type;
+    uint8_t  size;
+    uint8_t  flags;
+    uint8_t  pad;
+    uint16_t port;
+    uint16_t value;
+};
+
+class z8000_trace_sink {
+public:
+    virtual ~z8000_trace_sink() = default;
+
+    // record points at `size` bytes; it may be reused once this returns
+    virtual void write(const void* record, size_t size) = 0;
+
+    void mem_access(uint8_t flags, uint32_t addr, uint16_t value, uint16_t mask = 0xffff) {
+        z8000_trace_mem rec = { Z8000_TRACE_MEM, sizeof(rec), flags, 0, addr, value, mask };
+        write(&rec, sizeof(rec));
+    }
+
+    void io_access(uint8_t flags, uint16_t port, uint16_t value) {
+        z8000_trace_io rec = { Z8000_TRACE_IO, sizeof(rec), flags, 0, port, value };
+        write(&rec, sizeof(rec));
+    }
+};
+
+// Writes records to a file through a ring buffer drained by a background
+// thread, so the emulation thread only copies bytes.  It blocks only when
+// the ring is full.
+class z8000_trace_file : public z8000_trace_sink {
+public:
+    explicit z8000_trace_file(size_t ring_size = 16 << 20);
+    ~z8000_trace_file() override;
+
+    // Create path and write the header; false if it cannot be created
+    bool open(const char* path, uint16_t model);
+    // Drain the ring, stop the writer and close the file
+    void close();
+    bool is_open() const { return m_file != nullptr; }
+
+    void write(const void* record, size_t size) override;
+
+private:
+    void writer();
+    void wait_for_space(size_t size);
+
+    std::vector<uint8_t> m_ring;
+    size_t m_ring_mask;
+    size_t m_chunk;                     // wake the writer every this many bytes
+    std::atomic<uint64_t> m_head;       // bytes produced
+    std::atomic<uint64_t> m_tail;       // bytes written to the file
+    std::mutex m_lock;
+    std::condition_variable m_data_ready;
+    std::condition_variable m_space_ready;
+    bool m_stop;
+    FILE* m_file;
+    std::thread m_thread;
+};
+
+#endif // Z8000_TRACE_H
@@ -42,18 +42,18 @@
 #define RQ(n)   m_regs.Q[(n) >> 2]
 
 /* the register used as stack pointer */
-#define SP      (get_segmented_mode() ? 14 : 15)
+#define SP      (segmented<Z8001>() ? 14 : 15)
 
 /* these vectors are based on m_psap */
-#define RST     (PSA_ADDR() + 0)  /* start up m_fcw and m_pc */
-#define EPU     (PSA_ADDR() + m_vector_mult * 0x0004)  /* extension processor unit? trap */
-#define TRAP    (PSA_ADDR() + m_vector_mult * 0x0008)  /* privilege violation trap */
-#define SYSCALL (PSA_ADDR() + m_vector_mult * 0x000c)  /* system call SC */
-#define SEGTRAP (PSA_ADDR() + m_vector_mult * 0x0010)  /* segment trap */
-#define NMI     (PSA_ADDR() + m_vector_mult * 0x0014)  /* non maskable interrupt */
-#define NVI     (PSA_ADDR() + m_vector_mult * 0x0018)  /* non vectored interrupt */
-#define VI      (PSA_ADDR() + m_vector_mult * 0x001c)  /* vectored interrupt */
-#define VEC00   (PSA_ADDR() + m_vector_mult * 0x001e)  /* vector n m_pc value */
+#define RST     (PSA_ADDR<Z8001>() + 0)  /* start up m_fcw and m_pc */
+#define EPU     (PSA_ADDR<Z8001>() + m_vector_mult * 0x0004)  /* extension processor unit? trap */
+#define TRAP    (PSA_ADDR<Z8001>() + m_vector_mult * 0x0008)  /* privilege violation trap */
+#define SYSCALL (PSA_ADDR<Z8001>() + m_vector_mult * 0x000c)  /* system call SC */
+#define SEGTRAP (PSA_ADDR<Z8001>() + m_vector_mult * 0x0010)  /* segment trap */
+#define NMI     (PSA_ADDR<Z8001>() + m_vector_mult * 0x0014)  /* non maskable interrupt */
+#define NVI     (PSA_ADDR<Z8001>() + m_vector_mult * 0x0018)  /* non vectored interrupt */
+#define VI      (PSA_ADDR<Z8001>() + m_vector_mult * 0x001c)  /* vectored interrupt */
+#define VEC00   (PSA_ADDR<Z8001>() + m_vector_mult * 0x001e)  /* vector n m_pc value */
 
 /* bits of the m_fcw */
 #define F_SEG   0x8000              /* segmented mode (Z8001 only) */
@@ -90,43 +90,60 @@
 #define S16 0x8000
 #define S32 0x80000000
 
+/* FCW_FLAGS reads m_fcw with any deferred arithmetic flags folded in
+   (see sync_fcw()); every macro below that reads or modifies C/Z/S/P/V/D/H
+   goes through it.  Control bits in m_fcw are always current. */
+#if Z8000_LAZY_FLAGS
+#define FCW_FLAGS   sync_fcw()
+#define FLAGS_RMW   (sync_fcw(), m_fcw)
+#else
+#define FCW_FLAGS   m_fcw
+#define FLAGS_RMW   m_fcw
+#endif
+
 /* get a single flag bit 0/1 */
-#define GET_C       ((m_fcw >> 7) & 1)
-#define GET_Z       ((m_fcw >> 6) & 1)
-#define GET_S       ((m_fcw >> 5) & 1)
-#define GET_PV      ((m_fcw >> 4) & 1)
-#define GET_DA      ((m_fcw >> 3) & 1)
-#define GET_H       ((m_fcw >> 2) & 1)
+#define GET_C       ((FCW_FLAGS >> 7) & 1)
+#if Z8000_LAZY_FLAGS
+/* every deferred operation sets Z and S, so read them from its result */
+#define GET_Z       (m_lf_op ? m_lf_res == 0 : (m_fcw >> 6) & 1)
+#define GET_S       (m_lf_op ? (m_lf_res & m_lf_sign) != 0 : (m_fcw >> 5) & 1)
+#else
+#define GET_Z       ((FCW_FLAGS >> 6) & 1)
+#define GET_S       ((FCW_FLAGS >> 5) & 1)
+#endif
+#define GET_PV      ((FCW_FLAGS >> 4) & 1)
+#define GET_DA      ((FCW_FLAGS >> 3) & 1)
+#define GET_H       ((FCW_FLAGS >> 2) & 1)
 
 /* clear a single flag bit */
-#define CLR_C       m_fcw &= ~F_C
-#define CLR_Z       m_fcw &= ~F_Z
-#define CLR_S       m_fcw &= ~F_S
-#define CLR_P       m_fcw &= ~F_PV
-#define CLR_V       m_fcw &= ~F_PV
-#define CLR_DA      m_fcw &= ~F_DA
-#define CLR_H       m_fcw &= ~F_H
+#define CLR_C       FLAGS_RMW &= ~F_C
+#define CLR_Z       FLAGS_RMW &= ~F_Z
+#define CLR_S       FLAGS_RMW &= ~F_S
+#define CLR_P       FLAGS_RMW &= ~F_PV
+#define CLR_V       FLAGS_RMW &= ~F_PV
+#define CLR_DA      FLAGS_RMW &= ~F_DA
+#define CLR_H       FLAGS_RMW &= ~F_H
 
 /* clear a flag bit combination */
-#define CLR_CZS     m_fcw &= ~(F_C|F_Z|F_S)
-#define CLR_CZSP    m_fcw &= ~(F_C|F_Z|F_S|F_PV)
-#define CLR_CZSV    m_fcw &= ~(F_C|F_Z|F_S|F_PV)
-#define CLR_CZSVH   m_fcw &= ~(F_C|F_Z|F_S|F_PV|F_H)
-#define CLR_ZS      m_fcw &= ~(F_Z|F_S)
-#define CLR_ZSV     m_fcw &= ~(F_Z|F_S|F_PV)
-#define CLR_ZSP     m_fcw &= ~(F_Z|F_S|F_PV)
+#define CLR_CZS     FLAGS_RMW &= ~(F_C|F_Z|F_S)
+#define CLR_CZSP    FLAGS_RMW &= ~(F_C|F_Z|F_S|F_PV)
+#define CLR_CZSV    FLAGS_RMW &= ~(F_C|F_Z|F_S|F_PV)
+#define CLR_CZSVH   FLAGS_RMW &= ~(F_C|F_Z|F_S|F_PV|F_H)
+#define CLR_ZS      FLAGS_RMW &= ~(F_Z|F_S)
+#define CLR_ZSV     FLAGS_RMW &= ~(F_Z|F_S|F_PV)
+#define CLR_ZSP     FLAGS_RMW &= ~(F_Z|F_S|F_PV)
 
 /* set a single flag bit */
-#define SET_C       m_fcw |= F_C
-#define SET_Z       m_fcw |= F_Z
-#define SET_S       m_fcw |= F_S
-#define SET_P       m_fcw |= F_PV
-#define SET_V       m_fcw |= F_PV
-#define SET_DA      m_fcw |= F_DA
-#define SET_H       m_fcw |= F_H
+#define SET_C       FLAGS_RMW |= F_C
+#define SET_Z       FLAGS_RMW |= F_Z
+#define SET_S       FLAGS_RMW |= F_S
+#define SET_P       FLAGS_RMW |= F_PV
+#define SET_V       FLAGS_RMW |= F_PV
+#define SET_DA      FLAGS_RMW |= F_DA
+#define SET_H       FLAGS_RMW |= F_H
 
 /* set a flag bit combination */
-#define SET_SC      m_fcw |= F_C | F_S
+#define SET_SC      FLAGS_RMW |= F_C | F_S
 
 /* check condition codes */
 #define CC0 (0)                         /* always false */
@@ -173,5 +190,5 @@
 #define GET_DSP7        uint8_t dsp7 = get_operand(0) & 127
 #define GET_DSP8        int8_t dsp8 = (int8_t)get_operand(0)
 #define GET_DSP16       uint16_t tmp16 = get_operand(1); uint32_t dsp16 = addr_add(m_pc, (int16_t)tmp16)
-#define GET_ADDR(o)     uint32_t addr = (uint32_t)get_addr_operand(o)
-#define GET_ADDR_RAW(o)     uint32_t addr = (uint32_t)get_raw_addr_operand(o)
+#define GET_ADDR(o)     uint32_t addr = (uint32_t)get_addr_operand<Z8001>(o)
+#define GET_ADDR_RAW(o)     uint32_t addr = (uint32_t)get_raw_addr_operand<Z8001>(o)
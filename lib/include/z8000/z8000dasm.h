@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <array>
+
 #include <z8000/emu.h>
 
 class z8000_disassembler : public util::disasm_interface
@@ -28,6 +30,11 @@ public:
 	virtual u32 opcode_alignment() const override;
 	virtual offs_t disassemble(std::ostream &stream, offs_t pc, const data_buffer &opcodes, const data_buffer &params) override;
 
+	// Same, into a fixed buffer without allocating; MAX_TEXT bytes hold
+	// any instruction's text
+	static constexpr size_t MAX_TEXT = 64;
+	offs_t disassemble(util::text_appender &stream, offs_t pc, const data_buffer &opcodes, const data_buffer &params);
+
 private:
 	struct opcode {
 		u16     beg, end, step;
@@ -37,14 +44,14 @@ private:
 	};
 
 	static const opcode table[];
+	static const std::array<u16, 0x10000> oplist;
+	static constexpr std::array<u16, 0x10000> make_oplist();
 	static const char *const cc[16];
 	static const char *const flg[16];
 	static const char *const ints[4];
 
 	config *m_config;
 
-	u16 oplist[0x10000];
-
 	void get_op(const data_buffer &opcodes, int i, offs_t &new_pc, u16 *w, u8 *b, u8 *n);
 
 };
@@ -16,9 +16,11 @@
  check new fcw for switch to system mode
  and swap stack pointer if needed
  ******************************************/
+template<bool Z8001>
 void z8002_device::CHANGE_FCW(uint16_t fcw)
 {
 	uint16_t tmp;
+	sync_fcw();                         /* retire deferred flags before fcw replaces them */
 	if ((fcw ^ m_fcw) & F_S_N)            /* system/user mode change? */
 	{
 		tmp = RW(15);
@@ -26,33 +28,13 @@ void z8002_device::CHANGE_FCW(uint16_t fcw)
 		m_nspoff = tmp;
 	}
 
-	fcw &= ~F_SEG;  /* never set segmented mode bit on Z8002 */
-
-	if (!(m_fcw & F_NVIE) && (fcw & F_NVIE) && (m_irq_state[0] != CLEAR_LINE))
-	{
-		m_irq_req |= Z8000_NVI;
-	}
-	if (!(m_fcw & F_VIE) && (fcw & F_VIE) && (m_irq_state[1] != CLEAR_LINE))
-	{
-		m_irq_req |= Z8000_VI;
-	}
-	m_fcw = fcw;  /* set new m_fcw */
-}
-
-void z8001_device::CHANGE_FCW(uint16_t fcw)
-{
-	uint16_t tmp;
-	if ((fcw ^ m_fcw) & F_S_N)            /* system/user mode change? */
-	{
-		tmp = RW(15);
-		RW(15) = m_nspoff;
-		m_nspoff = tmp;
-	}
+	if (!Z8001)
+		fcw &= ~F_SEG;  /* never set segmented mode bit on Z8002 */
 	/* User mode R14 is used in user mode and non-segmented system mode.
 	   System mode R14 is only used in segmented system mode.
 	   There is no transition from user mode to non-segmented system mode,
 	   so this doesn't need to be handled here. */
-	if (fcw & F_S_N)    /* new mode is system mode */
+	else if (fcw & F_S_N)    /* new mode is system mode */
 	{
 		if (!(m_fcw & F_S_N)                /* old mode was user mode */
 			|| ((fcw ^ m_fcw) & F_SEG))     /* or switch between segmented and non-segmented */
@@ -81,6 +63,11 @@ void z8001_device::CHANGE_FCW(uint16_t fcw)
 	{
 		m_irq_req |= Z8000_VI;
 	}
+	/* a disabled line waits for the enable above rather than staying requested */
+	if (!(fcw & F_NVIE))
+		m_irq_req &= ~Z8000_NVI;
+	if (!(fcw & F_VIE))
+		m_irq_req &= ~Z8000_VI;
 	m_fcw = fcw;  /* set new m_fcw */
 }
 
@@ -94,17 +81,19 @@ uint32_t z8002_device::segmented_addr(uint32_t addr)
 	return ((addr & 0x7f000000) >> 8) | (addr & 0xffff);
 }
 
+template<bool Z8001>
 uint32_t z8002_device::addr_from_reg(int regno)
 {
-	if (get_segmented_mode())
+	if (segmented<Z8001>())
 		return segmented_addr(RL(regno));
 	else
 		return RW(regno);
 }
 
+template<bool Z8001>
 void z8002_device::addr_to_reg(int regno, uint32_t addr)
 {
-	if (get_segmented_mode()) {
+	if (segmented<Z8001>()) {
 		uint32_t segaddr = make_segmented_addr(addr);
 		// Segment word is {1, seg, 0}: the low byte is reserved and reads 0,
 		// not preserved from the destination register's prior contents.
@@ -115,120 +104,139 @@ void z8002_device::addr_to_reg(int regno, uint32_t addr)
 		RW(regno) = addr;
 }
 
+template<bool Z8001>
 void z8002_device::add_to_addr_reg(int regno, uint16_t addend)
 {
-	if (get_segmented_mode())
+	if (segmented<Z8001>())
 		regno |= 1;
 	RW(regno) += addend;
 }
 
+template<bool Z8001>
 void z8002_device::sub_from_addr_reg(int regno, uint16_t subtrahend)
 {
-	if (get_segmented_mode())
+	if (segmented<Z8001>())
 		regno |= 1;
 	RW(regno) -= subtrahend;
 }
 
+template<bool Z8001>
 void z8002_device::set_pc(uint32_t addr)
 {
-	if (get_segmented_mode())
+	if (segmented<Z8001>())
 		m_pc = addr;
 	else
 		m_pc = (m_pc & 0xffff0000) | (addr & 0xffff);
 }
 
+template<bool Z8001>
 uint8_t z8002_device::RDIR_B(uint8_t reg)
 {
-	return RDMEM_B(reg == SP ? m_stack : m_data, addr_from_reg(reg));
+	return RDMEM_B<Z8001>(reg == SP ? m_stack : m_data, addr_from_reg<Z8001>(reg));
 }
 
+template<bool Z8001>
 uint16_t z8002_device::RDIR_W(uint8_t reg)
 {
-	return RDMEM_W(reg == SP ? m_stack : m_data, addr_from_reg(reg));
+	return RDMEM_W<Z8001>(reg == SP ? m_stack : m_data, addr_from_reg<Z8001>(reg));
 }
 
+template<bool Z8001>
 uint32_t z8002_device::RDIR_L(uint8_t reg)
 {
-	return RDMEM_L(reg == SP ? m_stack : m_data, addr_from_reg(reg));
+	return RDMEM_L<Z8001>(reg == SP ? m_stack : m_data, addr_from_reg<Z8001>(reg));
 }
 
+template<bool Z8001>
 void z8002_device::WRIR_B(uint8_t reg, uint8_t value)
 {
-	WRMEM_B(reg == SP ? m_stack : m_data, addr_from_reg(reg), value);
+	WRMEM_B<Z8001>(reg == SP ? m_stack : m_data, addr_from_reg<Z8001>(reg), value);
 }
 
+template<bool Z8001>
 void z8002_device::WRIR_W(uint8_t reg, uint16_t value)
 {
-	WRMEM_W(reg == SP ? m_stack : m_data, addr_from_reg(reg), value);
+	WRMEM_W<Z8001>(reg == SP ? m_stack : m_data, addr_from_reg<Z8001>(reg), value);
 }
 
+template<bool Z8001>
 void z8002_device::WRIR_L(uint8_t reg, uint32_t value)
 {
-	WRMEM_L(reg == SP ? m_stack : m_data, addr_from_reg(reg), value);
+	WRMEM_L<Z8001>(reg == SP ? m_stack : m_data, addr_from_reg<Z8001>(reg), value);
 }
 
+template<bool Z8001>
 uint8_t z8002_device::RDBX_B(uint8_t reg, uint16_t idx)
 {
-	return RDMEM_B(reg == SP ? m_stack : m_data, addr_add(addr_from_reg(reg), idx));
+	return RDMEM_B<Z8001>(reg == SP ? m_stack : m_data, addr_add(addr_from_reg<Z8001>(reg), idx));
 }
 
+template<bool Z8001>
 uint16_t z8002_device::RDBX_W(uint8_t reg, uint16_t idx)
 {
-	return RDMEM_W(reg == SP ? m_stack : m_data, addr_add(addr_from_reg(reg), idx));
+	return RDMEM_W<Z8001>(reg == SP ? m_stack : m_data, addr_add(addr_from_reg<Z8001>(reg), idx));
 }
 
+template<bool Z8001>
 uint32_t z8002_device::RDBX_L(uint8_t reg, uint16_t idx)
 {
-	return RDMEM_L(reg == SP ? m_stack : m_data, addr_add(addr_from_reg(reg), idx));
+	return RDMEM_L<Z8001>(reg == SP ? m_stack : m_data, addr_add(addr_from_reg<Z8001>(reg), idx));
 }
 
+template<bool Z8001>
 void z8002_device::WRBX_B(uint8_t reg, uint16_t idx, uint8_t value)
 {
-	WRMEM_B(reg == SP ? m_stack : m_data, addr_add(addr_from_reg(reg), idx), value);
+	WRMEM_B<Z8001>(reg == SP ? m_stack : m_data, addr_add(addr_from_reg<Z8001>(reg), idx), value);
 }
 
+template<bool Z8001>
 void z8002_device::WRBX_W(uint8_t reg, uint16_t idx, uint16_t value)
 {
-	WRMEM_W(reg == SP ? m_stack : m_data, addr_add(addr_from_reg(reg), idx), value);
+	WRMEM_W<Z8001>(reg == SP ? m_stack : m_data, addr_add(addr_from_reg<Z8001>(reg), idx), value);
 }
 
+template<bool Z8001>
 void z8002_device::WRBX_L(uint8_t reg, uint16_t idx, uint32_t value)
 {
-	WRMEM_L(reg == SP ? m_stack : m_data, addr_add(addr_from_reg(reg), idx), value);
+	WRMEM_L<Z8001>(reg == SP ? m_stack : m_data, addr_add(addr_from_reg<Z8001>(reg), idx), value);
 }
 
+template<bool Z8001>
 void z8002_device::PUSHW(uint8_t dst, uint16_t value)
 {
-	if (get_segmented_mode())
+	if (segmented<Z8001>())
 		RW(dst | 1) -= 2;
 	else
 		RW(dst) -= 2;
-	WRIR_W(dst, value);
+	WRIR_W<Z8001>(dst, value);
 }
 
+template<bool Z8001>
 uint16_t z8002_device::POPW(uint8_t src)
 {
-	uint16_t result = RDIR_W(src);
-	if (get_segmented_mode())
+	uint16_t result = RDIR_W<Z8001>(src);
+	if (segmented<Z8001>())
 		RW(src | 1) += 2;
 	else
 		RW(src) += 2;
 	return result;
 }
 
+template<bool Z8001>
 void z8002_device::PUSHL(uint8_t dst, uint32_t value)
 {
-	if (get_segmented_mode())
+	if (segmented<Z8001>())
 		RW(dst | 1) -= 4;
 	else
 		RW(dst) -= 4;
-	WRIR_L(dst, value);
+	WRIR_L<Z8001>(dst, value);
 }
 
+template<bool Z8001>
 uint32_t z8002_device::POPL(uint8_t src)
 {
-	uint32_t result = RDIR_L(src);
-	if (get_segmented_mode())
+	uint32_t result = RDIR_L<Z8001>(src);
+	if (segmented<Z8001>())
 		RW(src | 1) += 4;
 	else
 		RW(src) += 4;
@@ -243,6 +251,11 @@ uint32_t z8002_device::POPL(uint8_t src)
 
 #define CHK_XXXB_ZSP m_fcw |= z8000_zsp[result]
 
+/* Z and S for a signed result, and C, Z, S and V replaced at once by the
+   flags computed for an operation without testing them one by one */
+#define ZS_OF(result) ((!(result) ? F_Z : 0) | ((result) < 0 ? F_S : 0))
+#define SET_CZSV_TO(flags) (FLAGS_RMW = (FCW_FLAGS & ~(F_C|F_Z|F_S|F_PV)) | (flags))
+
 /* check carry for addition and subtraction */
 #define CHK_ADDX_C if (result < dest) SET_C
 #define CHK_ADCX_C if (result < dest || (result == dest && value)) SET_C
@@ -273,6 +286,70 @@ uint32_t z8002_device::POPL(uint8_t src)
 /* if no EPU is present (it isn't), raise an extended intstuction trap */
 #define CHECK_EXT_INSTR()  if (!(m_fcw & F_EPU)) { m_irq_req |= Z8000_EPU; return; }
 
+/* hand the flags of an arithmetic/logical result to lazy evaluation;
+   true if they were deferred, false (always, when built eager) if the
+   caller has to set them itself */
+#if Z8000_LAZY_FLAGS
+#define LAZY_FLAGS(op,sign,mask,dest,value,result) (defer_flags(op, sign, mask, dest, value, result), true)
+
+/******************************************
+ record a result for lazy flag evaluation
+ a pending operation is folded into m_fcw
+ first if the new one leaves some of its
+ flags alone
+ ******************************************/
+void z8002_device::defer_flags(uint8_t op, uint32_t sign, uint16_t mask, uint32_t dest, uint32_t value, uint32_t result)
+{
+	if (m_lf_op && (m_lf_mask & ~mask))
+		sync_fcw();
+	m_lf_op = op;
+	m_lf_mask = mask;
+	m_lf_sign = sign;
+	m_lf_dst = dest;
+	m_lf_src = value;
+	m_lf_res = result;
+}
+
+/******************************************
+ m_fcw with the pending operation's flags
+ add covers adc and inc (the carry-in shows
+ as result == dest with value != 0), sub
+ covers sbc, cp, dec and neg (0 - dest);
+ mask drops the flags an operation leaves
+ ******************************************/
+uint16_t z8002_device::lazy_fcw() const
+{
+	const uint32_t sign = m_lf_sign;
+	const uint32_t dest = m_lf_dst, value = m_lf_src, result = m_lf_res;
+	uint16_t flags = 0;
+
+	if (m_lf_op == LF_LOGIC && sign == S08)
+		flags = z8000_zsp[result];
+	else if (!result)
+		flags = F_Z;
+	else if (result & sign)
+		flags = F_S;
+
+	switch (m_lf_op)
+	{
+	case LF_ADD:
+		if (result < dest || (result == dest && value)) flags |= F_C;
+		if (((value & dest & ~result) | (~value & ~dest & result)) & sign) flags |= F_PV;
+		if ((result & 15) < (dest & 15) || ((result & 15) == (dest & 15) && (value & 15))) flags |= F_H;
+		break;
+	case LF_SUB:
+		if (result > dest || (result == dest && value)) flags |= F_C;
+		if (((~value & dest & ~result) | (value & ~dest & result)) & sign) flags |= F_PV;
+		if ((result & 15) > (dest & 15) || ((result & 15) == (dest & 15) && (value & 15))) flags |= F_H;
+		flags |= F_DA;
+		break;
+	}
+	return (m_fcw & ~m_lf_mask) | (flags & m_lf_mask);
+}
+#else
+#define LAZY_FLAGS(op,sign,mask,dest,value,result) false
+#endif
+
 
 /******************************************
  add byte
@@ -281,6 +358,7 @@ uint32_t z8002_device::POPL(uint8_t src)
 uint8_t z8002_device::ADDB(uint8_t dest, uint8_t value)
 {
 	uint8_t result = dest + value;
+	if (LAZY_FLAGS(LF_ADD, S08, F_C|F_Z|F_S|F_PV|F_DA|F_H, dest, value, result)) return result;
 	CLR_CZSVH;      /* first clear C, Z, S, P/V and H flags    */
 	CLR_DA;         /* clear DA (decimal adjust) flag for addb */
 	CHK_XXXB_ZS;    /* set Z and S flags for result byte       */
@@ -297,6 +375,7 @@ uint8_t z8002_device::ADDB(uint8_t dest, uint8_t value)
 uint16_t z8002_device::ADDW(uint16_t dest, uint16_t value)
 {
 	uint16_t result = dest + value;
+	if (LAZY_FLAGS(LF_ADD, S16, F_C|F_Z|F_S|F_PV, dest, value, result)) return result;
 	CLR_CZSV;       /* first clear C, Z, S, P/V flags          */
 	CHK_XXXW_ZS;    /* set Z and S flags for result word       */
 	CHK_ADDX_C;     /* set C if result overflowed              */
@@ -311,6 +390,7 @@ uint16_t z8002_device::ADDW(uint16_t dest, uint16_t value)
 uint32_t z8002_device::ADDL(uint32_t dest, uint32_t value)
 {
 	uint32_t result = dest + value;
+	if (LAZY_FLAGS(LF_ADD, S32, F_C|F_Z|F_S|F_PV, dest, value, result)) return result;
 	CLR_CZSV;       /* first clear C, Z, S, P/V flags          */
 	CHK_XXXL_ZS;    /* set Z and S flags for result long       */
 	CHK_ADDX_C;     /* set C if result overflowed              */
@@ -325,6 +405,7 @@ uint32_t z8002_device::ADDL(uint32_t dest, uint32_t value)
 uint8_t z8002_device::ADCB(uint8_t dest, uint8_t value)
 {
 	uint8_t result = dest + value + GET_C;
+	if (LAZY_FLAGS(LF_ADD, S08, F_C|F_Z|F_S|F_PV|F_DA|F_H, dest, value, result)) return result;
 	CLR_CZSVH;      /* first clear C, Z, S, P/V and H flags    */
 	CLR_DA;         /* clear DA (decimal adjust) flag for adcb */
 	CHK_XXXB_ZS;    /* set Z and S flags for result byte       */
@@ -341,6 +422,7 @@ uint8_t z8002_device::ADCB(uint8_t dest, uint8_t value)
 uint16_t z8002_device::ADCW(uint16_t dest, uint16_t value)
 {
 	uint16_t result = dest + value + GET_C;
+	if (LAZY_FLAGS(LF_ADD, S16, F_C|F_Z|F_S|F_PV, dest, value, result)) return result;
 	CLR_CZSV;       /* first clear C, Z, S, P/V flags          */
 	CHK_XXXW_ZS;    /* set Z and S flags for result word       */
 	CHK_ADCX_C;     /* set C if result overflowed              */
@@ -355,6 +437,7 @@ uint16_t z8002_device::ADCW(uint16_t dest, uint16_t value)
 uint8_t z8002_device::SUBB(uint8_t dest, uint8_t value)
 {
 	uint8_t result = dest - value;
+	if (LAZY_FLAGS(LF_SUB, S08, F_C|F_Z|F_S|F_PV|F_DA|F_H, dest, value, result)) return result;
 	CLR_CZSVH;      /* first clear C, Z, S, P/V and H flags    */
 	SET_DA;         /* set DA (decimal adjust) flag for subb   */
 	CHK_XXXB_ZS;    /* set Z and S flags for result byte       */
@@ -371,6 +454,7 @@ uint8_t z8002_device::SUBB(uint8_t dest, uint8_t value)
 uint16_t z8002_device::SUBW(uint16_t dest, uint16_t value)
 {
 	uint16_t result = dest - value;
+	if (LAZY_FLAGS(LF_SUB, S16, F_C|F_Z|F_S|F_PV, dest, value, result)) return result;
 	CLR_CZSV;       /* first clear C, Z, S, P/V flags          */
 	CHK_XXXW_ZS;    /* set Z and S flags for result word       */
 	CHK_SUBX_C;     /* set C if result underflowed             */
@@ -385,6 +469,7 @@ uint16_t z8002_device::SUBW(uint16_t dest, uint16_t value)
 uint32_t z8002_device::SUBL(uint32_t dest, uint32_t value)
 {
 	uint32_t result = dest - value;
+	if (LAZY_FLAGS(LF_SUB, S32, F_C|F_Z|F_S|F_PV, dest, value, result)) return result;
 	CLR_CZSV;       /* first clear C, Z, S, P/V flags          */
 	CHK_XXXL_ZS;    /* set Z and S flags for result long       */
 	CHK_SUBX_C;     /* set C if result underflowed             */
@@ -399,6 +484,7 @@ uint32_t z8002_device::SUBL(uint32_t dest, uint32_t value)
 uint8_t z8002_device::SBCB(uint8_t dest, uint8_t value)
 {
 	uint8_t result = dest - value - GET_C;
+	if (LAZY_FLAGS(LF_SUB, S08, F_C|F_Z|F_S|F_PV|F_DA|F_H, dest, value, result)) return result;
 	CLR_CZSVH;      /* first clear C, Z, S, P/V and H flags    */
 	SET_DA;         /* set DA (decimal adjust) flag for sbcb   */
 	CHK_XXXB_ZS;    /* set Z and S flags for result byte       */
@@ -415,6 +501,7 @@ uint8_t z8002_device::SBCB(uint8_t dest, uint8_t value)
 uint16_t z8002_device::SBCW(uint16_t dest, uint16_t value)
 {
 	uint16_t result = dest - value - GET_C;
+	if (LAZY_FLAGS(LF_SUB, S16, F_C|F_Z|F_S|F_PV, dest, value, result)) return result;
 	CLR_CZSV;       /* first clear C, Z, S, P/V flags          */
 	CHK_XXXW_ZS;    /* set Z and S flags for result word       */
 	CHK_SBCX_C;     /* set C if result underflowed             */
@@ -429,6 +516,7 @@ uint16_t z8002_device::SBCW(uint16_t dest, uint16_t value)
 uint8_t z8002_device::ORB(uint8_t dest, uint8_t value)
 {
 	uint8_t result = dest | value;
+	if (LAZY_FLAGS(LF_LOGIC, S08, F_Z|F_S|F_PV, dest, value, result)) return result;
 	CLR_ZSP;        /* first clear Z, S, P/V flags             */
 	CHK_XXXB_ZSP;   /* set Z, S and P flags for result byte    */
 	return result;
@@ -441,6 +529,7 @@ uint8_t z8002_device::ORB(uint8_t dest, uint8_t value)
 uint16_t z8002_device::ORW(uint16_t dest, uint16_t value)
 {
 	uint16_t result = dest | value;
+	if (LAZY_FLAGS(LF_LOGIC, S16, F_Z|F_S, dest, value, result)) return result;
 	CLR_ZS;         /* first clear Z, and S flags              */
 	CHK_XXXW_ZS;    /* set Z and S flags for result word       */
 	return result;
@@ -453,6 +542,7 @@ uint16_t z8002_device::ORW(uint16_t dest, uint16_t value)
 uint8_t z8002_device::ANDB(uint8_t dest, uint8_t value)
 {
 	uint8_t result = dest & value;
+	if (LAZY_FLAGS(LF_LOGIC, S08, F_Z|F_S|F_PV, dest, value, result)) return result;
 	CLR_ZSP;        /* first clear Z,S and P/V flags           */
 	CHK_XXXB_ZSP;   /* set Z, S and P flags for result byte    */
 	return result;
@@ -465,6 +555,7 @@ uint8_t z8002_device::ANDB(uint8_t dest, uint8_t value)
 uint16_t z8002_device::ANDW(uint16_t dest, uint16_t value)
 {
 	uint16_t result = dest & value;
+	if (LAZY_FLAGS(LF_LOGIC, S16, F_Z|F_S, dest, value, result)) return result;
 	CLR_ZS;         /* first clear Z and S flags               */
 	CHK_XXXW_ZS;    /* set Z and S flags for result word       */
 	return result;
@@ -477,6 +568,7 @@ uint16_t z8002_device::ANDW(uint16_t dest, uint16_t value)
 uint8_t z8002_device::XORB(uint8_t dest, uint8_t value)
 {
 	uint8_t result = dest ^ value;
+	if (LAZY_FLAGS(LF_LOGIC, S08, F_Z|F_S|F_PV, dest, value, result)) return result;
 	CLR_ZSP;        /* first clear Z, S and P/V flags          */
 	CHK_XXXB_ZSP;   /* set Z, S and P flags for result byte    */
 	return result;
@@ -489,6 +581,7 @@ uint8_t z8002_device::XORB(uint8_t dest, uint8_t value)
 uint16_t z8002_device::XORW(uint16_t dest, uint16_t value)
 {
 	uint16_t result = dest ^ value;
+	if (LAZY_FLAGS(LF_LOGIC, S16, F_Z|F_S, dest, value, result)) return result;
 	CLR_ZS;         /* first clear Z and S flags               */
 	CHK_XXXW_ZS;    /* set Z and S flags for result word       */
 	return result;
@@ -502,6 +595,7 @@ uint16_t z8002_device::XORW(uint16_t dest, uint16_t value)
 void z8002_device::CPB(uint8_t dest, uint8_t value)
 {
 	uint8_t result = dest - value;
+	if (LAZY_FLAGS(LF_SUB, S08, F_C|F_Z|F_S|F_PV, dest, value, result)) return;
 	CLR_CZSV;       /* first clear C, Z, S and P/V flags       */
 	CHK_XXXB_ZS;    /* set Z and S flags for result byte       */
 	CHK_SUBX_C;     /* set C if result underflowed             */
@@ -515,6 +609,7 @@ void z8002_device::CPB(uint8_t dest, uint8_t value)
 void z8002_device::CPW(uint16_t dest, uint16_t value)
 {
 	uint16_t result = dest - value;
+	if (LAZY_FLAGS(LF_SUB, S16, F_C|F_Z|F_S|F_PV, dest, value, result)) return;
 	CLR_CZSV;
 	CHK_XXXW_ZS;    /* set Z and S flags for result word       */
 	CHK_SUBX_C;     /* set C if result underflowed             */
@@ -528,6 +623,7 @@ void z8002_device::CPW(uint16_t dest, uint16_t value)
 void z8002_device::CPL(uint32_t dest, uint32_t value)
 {
 	uint32_t result = dest - value;
+	if (LAZY_FLAGS(LF_SUB, S32, F_C|F_Z|F_S|F_PV, dest, value, result)) return;
 	CLR_CZSV;
 	CHK_XXXL_ZS;    /* set Z and S flags for result long       */
 	CHK_SUBX_C;     /* set C if result underflowed             */
@@ -541,6 +637,7 @@ void z8002_device::CPL(uint32_t dest, uint32_t value)
 uint8_t z8002_device::COMB(uint8_t dest)
 {
 	uint8_t result = ~dest;
+	if (LAZY_FLAGS(LF_LOGIC, S08, F_Z|F_S|F_PV, dest, 0, result)) return result;
 	CLR_ZSP;
 	CHK_XXXB_ZSP;   /* set Z, S and P flags for result byte    */
 	return result;
@@ -553,6 +650,7 @@ uint8_t z8002_device::COMB(uint8_t dest)
 uint16_t z8002_device::COMW(uint16_t dest)
 {
 	uint16_t result = ~dest;
+	if (LAZY_FLAGS(LF_LOGIC, S16, F_Z|F_S, dest, 0, result)) return result;
 	CLR_ZS;
 	CHK_XXXW_ZS;    /* set Z and S flags for result word       */
 	return result;
@@ -565,6 +663,7 @@ uint16_t z8002_device::COMW(uint16_t dest)
 uint8_t z8002_device::NEGB(uint8_t dest)
 {
 	uint8_t result = (uint8_t) -dest;
+	if (LAZY_FLAGS(LF_SUB, S08, F_C|F_Z|F_S|F_PV, 0, dest, result)) return result;
 	CLR_CZSV;
 	CHK_XXXB_ZS;    /* set Z and S flags for result byte       */
 	if (result > 0) SET_C;
@@ -579,6 +678,7 @@ uint8_t z8002_device::NEGB(uint8_t dest)
 uint16_t z8002_device::NEGW(uint16_t dest)
 {
 	uint16_t result = (uint16_t) -dest;
+	if (LAZY_FLAGS(LF_SUB, S16, F_C|F_Z|F_S|F_PV, 0, dest, result)) return result;
 	CLR_CZSV;
 	CHK_XXXW_ZS;    /* set Z and S flags for result word       */
 	if (result > 0) SET_C;
@@ -592,6 +692,7 @@ uint16_t z8002_device::NEGW(uint16_t dest)
  ******************************************/
 void z8002_device::TESTB(uint8_t result)
 {
+	if (LAZY_FLAGS(LF_LOGIC, S08, F_Z|F_S|F_PV, 0, 0, result)) return;
 	CLR_ZSP;
 	CHK_XXXB_ZSP;   /* set Z and S flags for result byte       */
 }
@@ -602,6 +703,7 @@ void z8002_device::TESTB(uint8_t result)
  ******************************************/
 void z8002_device::TESTW(uint16_t dest)
 {
+	if (LAZY_FLAGS(LF_LOGIC, S16, F_Z|F_S, 0, 0, dest)) return;
 	CLR_ZS;
 	if (!dest) SET_Z; else if (dest & S16) SET_S;
 }
@@ -612,6 +714,7 @@ void z8002_device::TESTW(uint16_t dest)
  ******************************************/
 void z8002_device::TESTL(uint32_t dest)
 {
+	if (LAZY_FLAGS(LF_LOGIC, S32, F_Z|F_S, 0, 0, dest)) return;
 	CLR_ZS;
 	if (!dest) SET_Z; else if (dest & S32) SET_S;
 }
@@ -623,6 +726,7 @@ void z8002_device::TESTL(uint32_t dest)
 uint8_t z8002_device::INCB(uint8_t dest, uint8_t value)
 {
 	uint8_t result = dest + value;
+	if (LAZY_FLAGS(LF_ADD, S08, F_Z|F_S|F_PV, dest, value, result)) return result;
 	CLR_ZSV;
 	CHK_XXXB_ZS;    /* set Z and S flags for result byte       */
 	CHK_ADDB_V;     /* set V if result overflowed              */
@@ -636,6 +740,7 @@ uint8_t z8002_device::INCB(uint8_t dest, uint8_t value)
 uint16_t z8002_device::INCW(uint16_t dest, uint16_t value)
 {
 	uint16_t result = dest + value;
+	if (LAZY_FLAGS(LF_ADD, S16, F_Z|F_S|F_PV, dest, value, result)) return result;
 	CLR_ZSV;
 	CHK_XXXW_ZS;    /* set Z and S flags for result byte       */
 	CHK_ADDW_V;     /* set V if result overflowed              */
@@ -649,6 +754,7 @@ uint16_t z8002_device::INCW(uint16_t dest, uint16_t value)
 uint8_t z8002_device::DECB(uint8_t dest, uint8_t value)
 {
 	uint8_t result = dest - value;
+	if (LAZY_FLAGS(LF_SUB, S08, F_Z|F_S|F_PV, dest, value, result)) return result;
 	CLR_ZSV;
 	CHK_XXXB_ZS;    /* set Z and S flags for result byte       */
 	CHK_SUBB_V;     /* set V if result overflowed              */
@@ -662,6 +768,7 @@ uint8_t z8002_device::DECB(uint8_t dest, uint8_t value)
 uint16_t z8002_device::DECW(uint16_t dest, uint16_t value)
 {
 	uint16_t result = dest - value;
+	if (LAZY_FLAGS(LF_SUB, S16, F_Z|F_S|F_PV, dest, value, result)) return result;
 	CLR_ZSV;
 	CHK_XXXW_ZS;    /* set Z and S flags for result word       */
 	CHK_SUBW_V;     /* set V if result overflowed              */
@@ -674,15 +781,14 @@ uint16_t z8002_device::DECW(uint16_t dest, uint16_t value)
  ******************************************/
 uint32_t z8002_device::MULTW(uint16_t dest, uint16_t value)
 {
-	uint32_t result = (int32_t)(int16_t)dest * (int16_t)value;
-	CLR_CZSV;
-	CHK_XXXL_ZS;
-	if(!value)
+	int32_t result = (int16_t)dest * (int16_t)value;
+	if (!value)
 	{
 		/* multiplication with zero is faster */
-		m_icount += (70-18);
+		cycles(18 - 70);
 	}
-	if((int32_t)result < -0x8000 || (int32_t)result >= 0x8000) SET_C;
+	/* C: the product does not fit in a word */
+	SET_CZSV_TO(ZS_OF(result) | (uint32_t(result) + 0x8000u > 0xffffu ? F_C : 0));
 	return result;
 }
 
@@ -692,21 +798,11 @@ uint32_t z8002_device::MULTW(uint16_t dest, uint16_t value)
  ******************************************/
 uint64_t z8002_device::MULTL(uint32_t dest, uint32_t value)
 {
-	uint64_t result = (int64_t)(int32_t)dest * (int32_t)value;
-	if(!value)
-	{
-		/* multiplication with zero is faster */
-		m_icount += (282 - 30);
-	}
-	else
-	{
-		int n;
-		for(n = 0; n < 32; n++)
-			if(dest & (1L << n)) m_icount -= 7;
-	}
-	CLR_CZSV;
-	CHK_XXXQ_ZS;
-	if((int64_t)result < -0x7fffffffL || (int64_t)result >= 0x7fffffffL) SET_C;
+	int64_t result = (int64_t)(int32_t)dest * (int32_t)value;
+	/* 7 cycles per one bit in the multiplicand; multiplication with zero is faster */
+	cycles(value ? 7 * int(std::bitset<32>(dest).count()) : 30 - 282);
+	/* C: the product is outside -0x7fffffff..0x7ffffffe */
+	SET_CZSV_TO(ZS_OF(result) | (uint64_t(result) + 0x7fffffffu > 0xfffffffdu ? F_C : 0));
 	return result;
 }
 
@@ -716,45 +812,25 @@ uint64_t z8002_device::MULTL(uint32_t dest, uint32_t value)
  ******************************************/
 uint32_t z8002_device::DIVW(uint32_t dest, uint16_t value)
 {
-	uint32_t result = dest;
-	uint16_t remainder = 0;
-	CLR_CZSV;
-	if (value)
+	if (!value)
 	{
-		uint16_t qsign = ((dest >> 16) ^ value) & S16;
-		uint16_t rsign = (dest >> 16) & S16;
-		if ((int32_t)dest < 0) dest = -dest;
-		if ((int16_t)value < 0) value = -value;
-		result = dest / value;
-		remainder = dest % value;
-		if (qsign) result = -result;
-		if (rsign) remainder = -remainder;
-		if ((int32_t)result < -0x8000 || (int32_t)result > 0x7fff)
-		{
-			int32_t temp = (int32_t)result >> 1;
-			SET_V;
-			if (temp >= -0x8000 && temp <= 0x7fff)
-			{
-				/* CASE 4: quotient is a 17-bit two's complement number; the
-				   register holds only the lower 16 bits.  Z/S are set from the
-				   FULL quotient's sign (manual: "according to the value of the
-				   quotient"), not the truncated 16-bit result. */
-				if (!result) SET_Z; else if ((int32_t)result < 0) SET_S;
-				SET_C;
-			}
-		}
-		else
-		{
-			CHK_XXXW_ZS;
-		}
-		result = ((uint32_t)remainder << 16) | (result & 0xffff);
+		SET_CZSV_TO(F_Z | F_PV);
+		return dest;
 	}
-	else
-	{
-		SET_Z;
-		SET_V;
-	}
-	return result;
+	/* host division truncates towards zero and gives the remainder the
+	   dividend's sign, as the Z8000 does; only -0x80000000 / -1 would
+	   trap, and its quotient wraps as the Z8000's does */
+	const int32_t divisor = (int16_t)value;
+	const uint32_t quotient = divisor == -1 ? 0u - dest : uint32_t((int32_t)dest / divisor);
+	const uint16_t remainder = divisor == -1 ? 0 : (int32_t)dest % divisor;
+	/* V: the quotient needs more than 16 bits.  CASE 4: one of 17 bits
+	   also sets C, and Z/S then follow the FULL quotient rather than the
+	   16 bits left in the register ("according to the value of the
+	   quotient"); a wider one leaves them clear */
+	const bool fits = quotient + 0x8000u <= 0xffffu;
+	const bool fits17 = uint32_t((int32_t)quotient >> 1) + 0x8000u <= 0xffffu;
+	SET_CZSV_TO((fits17 ? ZS_OF((int32_t)quotient) : 0) | (fits ? 0 : F_PV) | (fits17 && !fits ? F_C : 0));
+	return ((uint32_t)remainder << 16) | (quotient & 0xffff);
 }
 
 /******************************************
@@ -763,44 +839,19 @@ uint32_t z8002_device::DIVW(uint32_t dest, uint16_t value)
  ******************************************/
 uint64_t z8002_device::DIVL(uint64_t dest, uint32_t value)
 {
-	uint64_t result = dest;
-	uint32_t remainder = 0;
-	CLR_CZSV;
-	if (value)
-	{
-		uint32_t qsign = ((dest >> 32) ^ value) & S32;
-		uint32_t rsign = (dest >> 32) & S32;
-		if ((int64_t)dest < 0) dest = -dest;
-		if ((int32_t)value < 0) value = -value;
-		result = dest / value;
-		remainder = dest % value;
-		if (qsign) result = -result;
-		if (rsign) remainder = -remainder;
-		if ((int64_t)result < -0x80000000LL || (int64_t)result > 0x7fffffff)
-		{
-			int64_t temp = (int64_t)result >> 1;
-			SET_V;
-			if (temp >= -0x80000000LL && temp <= 0x7fffffff)
-			{
-				/* CASE 4: quotient is a 33-bit two's complement number; the
-				   register holds only the lower 32 bits.  Z/S are set from the
-				   FULL quotient's sign, not the truncated 32-bit result. */
-				if (!result) SET_Z; else if ((int64_t)result < 0) SET_S;
-				SET_C;
-			}
-		}
-		else
-		{
-			CHK_XXXL_ZS;    /* Z/S from full 32-bit quotient */
-		}
-		result = ((uint64_t)remainder << 32) | (result & 0xffffffff);
-	}
-	else
+	if (!value)
 	{
-		SET_Z;
-		SET_V;
+		SET_CZSV_TO(F_Z | F_PV);
+		return dest;
 	}
-	return result;
+	/* as DIVW, with a 33-bit quotient for CASE 4 */
+	const int64_t divisor = (int32_t)value;
+	const uint64_t quotient = divisor == -1 ? 0u - dest : uint64_t((int64_t)dest / divisor);
+	const uint32_t remainder = divisor == -1 ? 0 : (int64_t)dest % divisor;
+	const bool fits = quotient + 0x80000000u <= 0xffffffffu;
+	const bool fits33 = uint64_t((int64_t)quotient >> 1) + 0x80000000u <= 0xffffffffu;
+	SET_CZSV_TO((fits33 ? ZS_OF((int64_t)quotient) : 0) | (fits ? 0 : F_PV) | (fits33 && !fits ? F_C : 0));
+	return ((uint64_t)remainder << 32) | (quotient & 0xffffffff);
 }
 
 /******************************************
@@ -1385,15 +1436,17 @@ uint32_t z8002_device::SRLL(uint32_t dest, uint8_t count)
  invalid
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::zinvalid()
 {
-	logerror("Z8000 invalid opcode %05x: %04x (FCW=%04x)\n", m_pc, m_op[0], m_fcw);
+	logerror("Z8000 invalid opcode %05x: %04x (FCW=%04x)\n", m_pc, m_op[0], get_fcw());
 }
 
 /******************************************
  addb    rbd,imm8
  flags:  CZSVDH
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z00_0000_dddd_imm8()
 {
 	GET_DST(OP0,NIB3);
@@ -1405,17 +1458,19 @@ void z8002_device::Z00_0000_dddd_imm8()
  addb    rbd,@rs
  flags:  CZSVDH
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z00_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	RB(dst) = ADDB(RB(dst), RDIR_B(src));
+	RB(dst) = ADDB(RB(dst), RDIR_B<Z8001>(src));
 }
 
 /******************************************
  add     rd,imm16
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z01_0000_dddd_imm16()
 {
 	GET_DST(OP0,NIB3);
@@ -1427,17 +1482,19 @@ void z8002_device::Z01_0000_dddd_imm16()
  add     rd,@rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z01_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	RW(dst) = ADDW(RW(dst), RDIR_W(src));
+	RW(dst) = ADDW(RW(dst), RDIR_W<Z8001>(src));
 }
 
 /******************************************
  subb    rbd,imm8
  flags:  CZSVDH
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z02_0000_dddd_imm8()
 {
 	GET_DST(OP0,NIB3);
@@ -1449,17 +1506,19 @@ void z8002_device::Z02_0000_dddd_imm8()
  subb    rbd,@rs
  flags:  CZSVDH
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z02_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	RB(dst) = SUBB(RB(dst), RDIR_B(src)); /* EHC */
+	RB(dst) = SUBB(RB(dst), RDIR_B<Z8001>(src)); /* EHC */
 }
 
 /******************************************
  sub     rd,imm16
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z03_0000_dddd_imm16()
 {
 	GET_DST(OP0,NIB3);
@@ -1471,17 +1530,19 @@ void z8002_device::Z03_0000_dddd_imm16()
  sub     rd,@rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z03_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	RW(dst) = SUBW(RW(dst), RDIR_W(src));
+	RW(dst) = SUBW(RW(dst), RDIR_W<Z8001>(src));
 }
 
 /******************************************
  orb     rbd,imm8
  flags:  CZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z04_0000_dddd_imm8()
 {
 	GET_DST(OP0,NIB3);
@@ -1493,17 +1554,19 @@ void z8002_device::Z04_0000_dddd_imm8()
  orb     rbd,@rs
  flags:  CZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z04_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	RB(dst) = ORB(RB(dst), RDIR_B(src));
+	RB(dst) = ORB(RB(dst), RDIR_B<Z8001>(src));
 }
 
 /******************************************
  or      rd,imm16
  flags:  CZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z05_0000_dddd_imm16()
 {
 	GET_DST(OP0,NIB3);
@@ -1515,17 +1578,19 @@ void z8002_device::Z05_0000_dddd_imm16()
  or      rd,@rs
  flags:  CZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z05_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	RW(dst) = ORW(RW(dst), RDIR_W(src));
+	RW(dst) = ORW(RW(dst), RDIR_W<Z8001>(src));
 }
 
 /******************************************
  andb    rbd,imm8
  flags:  -ZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z06_0000_dddd_imm8()
 {
 	GET_DST(OP0,NIB3);
@@ -1537,17 +1602,19 @@ void z8002_device::Z06_0000_dddd_imm8()
  andb    rbd,@rs
  flags:  -ZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z06_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	RB(dst) = ANDB(RB(dst), RDIR_B(src));
+	RB(dst) = ANDB(RB(dst), RDIR_B<Z8001>(src));
 }
 
 /******************************************
  and     rd,imm16
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z07_0000_dddd_imm16()
 {
 	GET_DST(OP0,NIB3);
@@ -1559,17 +1626,19 @@ void z8002_device::Z07_0000_dddd_imm16()
  and     rd,@rs
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z07_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	RW(dst) = ANDW(RW(dst), RDIR_W(src));
+	RW(dst) = ANDW(RW(dst), RDIR_W<Z8001>(src));
 }
 
 /******************************************
  xorb    rbd,imm8
  flags:  -ZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z08_0000_dddd_imm8()
 {
 	GET_DST(OP0,NIB3);
@@ -1581,17 +1650,19 @@ void z8002_device::Z08_0000_dddd_imm8()
  xorb    rbd,@rs
  flags:  -ZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z08_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	RB(dst) = XORB(RB(dst), RDIR_B(src));
+	RB(dst) = XORB(RB(dst), RDIR_B<Z8001>(src));
 }
 
 /******************************************
  xor     rd,imm16
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z09_0000_dddd_imm16()
 {
 	GET_DST(OP0,NIB3);
@@ -1603,17 +1674,19 @@ void z8002_device::Z09_0000_dddd_imm16()
  xor     rd,@rs
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z09_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	RW(dst) = XORW(RW(dst), RDIR_W(src));
+	RW(dst) = XORW(RW(dst), RDIR_W<Z8001>(src));
 }
 
 /******************************************
  cpb     rbd,imm8
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0A_0000_dddd_imm8()
 {
 	GET_DST(OP0,NIB3);
@@ -1625,17 +1698,19 @@ void z8002_device::Z0A_0000_dddd_imm8()
  cpb     rbd,@rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0A_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	CPB(RB(dst), RDIR_B(src));
+	CPB(RB(dst), RDIR_B<Z8001>(src));
 }
 
 /******************************************
  cp      rd,imm16
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0B_0000_dddd_imm16()
 {
 	GET_DST(OP0,NIB3);
@@ -1647,186 +1722,203 @@ void z8002_device::Z0B_0000_dddd_imm16()
  cp      rd,@rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0B_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	CPW(RW(dst), RDIR_W(src));
+	CPW(RW(dst), RDIR_W<Z8001>(src));
 }
 
 /******************************************
  comb    @rd
  flags:  -ZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0C_ddN0_0000()
 {
 	GET_DST(OP0,NIB2);
 	mem_specific &space = dst == SP ? m_stack : m_data;
-	uint32_t addr = addr_from_reg(dst);
-	WRMEM_B(space, addr, COMB(RDMEM_B(space, addr)));
+	uint32_t addr = addr_from_reg<Z8001>(dst);
+	WRMEM_B<Z8001>(space, addr, COMB(RDMEM_B<Z8001>(space, addr)));
 }
 
 /******************************************
  cpb     @rd,imm8
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0C_ddN0_0001_imm8()
 {
 	GET_DST(OP0,NIB2);
 	GET_IMM8(OP1);
-	CPB(RDIR_B(dst), imm8); // @@@done
+	CPB(RDIR_B<Z8001>(dst), imm8); // @@@done
 }
 
 /******************************************
  negb    @rd
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0C_ddN0_0010()
 {
 	GET_DST(OP0,NIB2);
 	mem_specific &space = dst == SP ? m_stack : m_data;
-	uint32_t addr = addr_from_reg(dst);
-	WRMEM_B(space, addr, NEGB(RDMEM_B(space, addr)));
+	uint32_t addr = addr_from_reg<Z8001>(dst);
+	WRMEM_B<Z8001>(space, addr, NEGB(RDMEM_B<Z8001>(space, addr)));
 }
 
 /******************************************
  testb   @rd
  flags:  -ZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0C_ddN0_0100()
 {
 	GET_DST(OP0,NIB2);
-	TESTB(RDIR_B(dst));
+	TESTB(RDIR_B<Z8001>(dst));
 }
 
 /******************************************
  ldb     @rd,imm8
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0C_ddN0_0101_imm8()
 {
 	GET_DST(OP0,NIB2);
 	GET_IMM8(OP1);
-	WRIR_B(dst, imm8);
+	WRIR_B<Z8001>(dst, imm8);
 }
 
 /******************************************
  tsetb   @rd
  flags:  --S---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0C_ddN0_0110()
 {
 	GET_DST(OP0,NIB2);
 	mem_specific &space = dst == SP ? m_stack : m_data;
-	uint32_t addr = addr_from_reg(dst);
-	if (RDMEM_B(space, addr) & S08) SET_S; else CLR_S;
-	WRMEM_B(space, addr, 0xff);
+	uint32_t addr = addr_from_reg<Z8001>(dst);
+	if (RDMEM_B<Z8001>(space, addr) & S08) SET_S; else CLR_S;
+	WRMEM_B<Z8001>(space, addr, 0xff);
 }
 
 /******************************************
  clrb    @rd
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0C_ddN0_1000()
 {
 	GET_DST(OP0,NIB2);
-	WRIR_B(dst, 0);
+	WRIR_B<Z8001>(dst, 0);
 }
 
 /******************************************
  com     @rd
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0D_ddN0_0000()
 {
 	GET_DST(OP0,NIB2);
 	mem_specific &space = dst == SP ? m_stack : m_data;
-	uint32_t addr = addr_from_reg(dst);
-	WRMEM_W(space, addr, COMW(RDMEM_W(space, addr)));
+	uint32_t addr = addr_from_reg<Z8001>(dst);
+	WRMEM_W<Z8001>(space, addr, COMW(RDMEM_W<Z8001>(space, addr)));
 }
  
 /******************************************
  cp      @rd,imm16
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0D_ddN0_0001_imm16()
 {
 	GET_DST(OP0,NIB2);
 	GET_IMM16(OP1);
-	CPW(RDIR_W(dst), imm16);
+	CPW(RDIR_W<Z8001>(dst), imm16);
 }
 
 /******************************************
  neg     @rd
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0D_ddN0_0010()
 {
 	GET_DST(OP0,NIB2);
 	mem_specific &space = dst == SP ? m_stack : m_data;
-	uint32_t addr = addr_from_reg(dst);
-	WRMEM_W(space, addr, NEGW(RDMEM_W(space, addr)));
+	uint32_t addr = addr_from_reg<Z8001>(dst);
+	WRMEM_W<Z8001>(space, addr, NEGW(RDMEM_W<Z8001>(space, addr)));
 }
 
 /******************************************
  test    @rd
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0D_ddN0_0100()
 {
 	GET_DST(OP0,NIB2);
-	TESTW(RDIR_W(dst));
+	TESTW(RDIR_W<Z8001>(dst));
 }
 
 /******************************************
  ld      @rd,imm16
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0D_ddN0_0101_imm16()
 {
 	GET_DST(OP0,NIB2);
 	GET_IMM16(OP1);
-	WRIR_W(dst, imm16);
+	WRIR_W<Z8001>(dst, imm16);
 }
 
 /******************************************
  tset    @rd
  flags:  --S---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0D_ddN0_0110()
 {
 	GET_DST(OP0,NIB2);
 	mem_specific &space = dst == SP ? m_stack : m_data;
-	uint32_t addr = addr_from_reg(dst);
-	if (RDMEM_W(space, addr) & S16) SET_S; else CLR_S;
-	WRMEM_W(space, addr, 0xffff);
+	uint32_t addr = addr_from_reg<Z8001>(dst);
+	if (RDMEM_W<Z8001>(space, addr) & S16) SET_S; else CLR_S;
+	WRMEM_W<Z8001>(space, addr, 0xffff);
 }
 
 /******************************************
  clr     @rd
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0D_ddN0_1000()
 {
 	GET_DST(OP0,NIB2);
-	WRIR_W(dst, 0);
+	WRIR_W<Z8001>(dst, 0);
 }
 
 /******************************************
  push    @rd,imm16
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0D_ddN0_1001_imm16()
 {
 	GET_DST(OP0,NIB2);
 	GET_IMM16(OP1);
-	PUSHW(dst, imm16);
+	PUSHW<Z8001>(dst, imm16);
 }
 
 /******************************************
  ext0e   imm8
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0E_imm8()
 {
 	CHECK_EXT_INSTR();
@@ -1842,6 +1934,7 @@ void z8002_device::Z0E_imm8()
  ext0f   imm8
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z0F_imm8()
 {
 	CHECK_EXT_INSTR();
@@ -1857,6 +1950,7 @@ void z8002_device::Z0F_imm8()
  cpl     rrd,imm32
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z10_0000_dddd_imm32()
 {
 	GET_DST(OP0,NIB3);
@@ -1868,28 +1962,31 @@ void z8002_device::Z10_0000_dddd_imm32()
  cpl     rrd,@rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z10_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	CPL(RL(dst), RDIR_L(src));
+	CPL(RL(dst), RDIR_L<Z8001>(src));
 }
 
 /******************************************
  pushl   @rd,@rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z11_ddN0_ssN0()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DST(OP0,NIB2);
-	PUSHL(dst, RDIR_L(src));
+	PUSHL<Z8001>(dst, RDIR_L<Z8001>(src));
 }
 
 /******************************************
  subl    rrd,imm32
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z12_0000_dddd_imm32()
 {
 	GET_DST(OP0,NIB3);
@@ -1901,28 +1998,31 @@ void z8002_device::Z12_0000_dddd_imm32()
  subl    rrd,@rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z12_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	RL(dst) = SUBL(RL(dst), RDIR_L(src));
+	RL(dst) = SUBL(RL(dst), RDIR_L<Z8001>(src));
 }
 
 /******************************************
  push    @rd,@rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z13_ddN0_ssN0()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DST(OP0,NIB2);
-	PUSHW(dst, RDIR_W(src));
+	PUSHW<Z8001>(dst, RDIR_W<Z8001>(src));
 }
 
 /******************************************
  ldl     rrd,imm32
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z14_0000_dddd_imm32()
 {
 	GET_DST(OP0,NIB3);
@@ -1934,28 +2034,31 @@ void z8002_device::Z14_0000_dddd_imm32()
  ldl     rrd,@rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z14_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	RL(dst) = RDIR_L(src);
+	RL(dst) = RDIR_L<Z8001>(src);
 }
 
 /******************************************
  popl    @rd,@rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z15_ssN0_ddN0()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	WRIR_L(dst, POPL(src));
+	WRIR_L<Z8001>(dst, POPL<Z8001>(src));
 }
 
 /******************************************
  addl    rrd,imm32
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z16_0000_dddd_imm32()
 {
 	GET_DST(OP0,NIB3);
@@ -1967,28 +2070,31 @@ void z8002_device::Z16_0000_dddd_imm32()
  addl    rrd,@rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z16_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	RL(dst) = ADDL(RL(dst), RDIR_L(src));
+	RL(dst) = ADDL(RL(dst), RDIR_L<Z8001>(src));
 }
 
 /******************************************
  pop     @rd,@rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z17_ssN0_ddN0()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	WRIR_W(dst, POPW(src));
+	WRIR_W<Z8001>(dst, POPW<Z8001>(src));
 }
 
 /******************************************
  multl   rqd,imm32
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z18_00N0_dddd_imm32()
 {
 	GET_DST(OP0,NIB3);
@@ -2002,11 +2108,12 @@ void z8002_device::Z18_00N0_dddd_imm32()
  multl   rqd,@rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z18_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	uint64_t result = MULTL((uint32_t)RL(dst+2), RDIR_L(src));
+	uint64_t result = MULTL((uint32_t)RL(dst+2), RDIR_L<Z8001>(src));
 	RL(dst) = (uint32_t)(result >> 32);
 	RL(dst+2) = (uint32_t)(result & 0xFFFFFFFF);
 }
@@ -2015,6 +2122,7 @@ void z8002_device::Z18_ssN0_dddd()
  mult    rrd,imm16
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z19_0000_dddd_imm16()
 {
 	GET_DST(OP0,NIB3);
@@ -2026,17 +2134,19 @@ void z8002_device::Z19_0000_dddd_imm16()
  mult    rrd,@rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z19_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	RL(dst) = MULTW(RL(dst), RDIR_W(src));
+	RL(dst) = MULTW(RL(dst), RDIR_W<Z8001>(src));
 }
 
 /******************************************
  divl    rqd,imm32
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z1A_0000_dddd_imm32()
 {
 	GET_DST(OP0,NIB3);
@@ -2055,12 +2165,13 @@ void z8002_device::Z1A_0000_dddd_imm32()
  divl    rqd,@rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z1A_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	uint64_t dividend = ((uint64_t)RL(dst) << 32) | (uint32_t)RL(dst+2);
-	uint64_t result = DIVL(dividend, RDIR_L(src));
+	uint64_t result = DIVL(dividend, RDIR_L<Z8001>(src));
 	RL(dst) = (uint32_t)(result >> 32);
 	RL(dst+2) = (uint32_t)(result & 0xFFFFFFFF);
 }
@@ -2069,6 +2180,7 @@ void z8002_device::Z1A_ssN0_dddd()
  div     rrd,imm16
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z1B_0000_dddd_imm16()
 {
 	GET_DST(OP0,NIB3);
@@ -2080,36 +2192,39 @@ void z8002_device::Z1B_0000_dddd_imm16()
  div     rrd,@rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z1B_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	RL(dst) = DIVW(RL(dst), RDIR_W(src));
+	RL(dst) = DIVW(RL(dst), RDIR_W<Z8001>(src));
 }
 
 /******************************************
  testl   @rd
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z1C_ddN0_1000()
 {
 	GET_DST(OP0,NIB2);
-	TESTL(RDIR_L(dst));
+	TESTL(RDIR_L<Z8001>(dst));
 }
 
 /******************************************
  ldm     @rd,rs,n
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z1C_ddN0_1001_0000_ssss_0000_nmin1()
 {
 	GET_DST(OP0,NIB2);
 	GET_CNT(OP1,NIB3);
 	GET_SRC(OP1,NIB1);
 	mem_specific &space = dst == SP ? m_stack : m_data;
-	uint32_t addr = addr_from_reg(dst);
+	uint32_t addr = addr_from_reg<Z8001>(dst);
 	while (cnt-- >= 0) {
-		WRMEM_W(space, addr, RW(src));
+		WRMEM_W<Z8001>(space, addr, RW(src));
 		addr = addr_add(addr, 2);
 		src = (src+1) & 15;
 	}
@@ -2119,15 +2234,16 @@ void z8002_device::Z1C_ddN0_1001_0000_ssss_0000_nmin1()
  ldm     rd,@rs,n
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z1C_ssN0_0001_0000_dddd_0000_nmin1()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CNT(OP1,NIB3);
 	GET_DST(OP1,NIB1);
 	mem_specific &space = src == SP ? m_stack : m_data;
-	uint32_t addr = addr_from_reg(src);
+	uint32_t addr = addr_from_reg<Z8001>(src);
 	while (cnt-- >= 0) {
-		RW(dst) = RDMEM_W(space, addr);
+		RW(dst) = RDMEM_W<Z8001>(space, addr);
 		addr = addr_add(addr, 2);
 		dst = (dst+1) & 15;
 	}
@@ -2137,70 +2253,77 @@ void z8002_device::Z1C_ssN0_0001_0000_dddd_0000_nmin1()
  ldl     @rd,rrs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z1D_ddN0_ssss()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DST(OP0,NIB2);
-	WRIR_L(dst, RL(src));
+	WRIR_L<Z8001>(dst, RL(src));
 }
 
 /******************************************
  jp      cc,rd
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z1E_ddN0_cccc()
 {
 	GET_CCC(OP0,NIB3);
 	GET_DST(OP0,NIB2);
 	switch (cc) {
-		case  0: if (CC0) set_pc(addr_from_reg(dst)); break;
-		case  1: if (CC1) set_pc(addr_from_reg(dst)); break;
-		case  2: if (CC2) set_pc(addr_from_reg(dst)); break;
-		case  3: if (CC3) set_pc(addr_from_reg(dst)); break;
-		case  4: if (CC4) set_pc(addr_from_reg(dst)); break;
-		case  5: if (CC5) set_pc(addr_from_reg(dst)); break;
-		case  6: if (CC6) set_pc(addr_from_reg(dst)); break;
-		case  7: if (CC7) set_pc(addr_from_reg(dst)); break;
-		case  8: if (CC8) set_pc(addr_from_reg(dst)); break;
-		case  9: if (CC9) set_pc(addr_from_reg(dst)); break;
-		case 10: if (CCA) set_pc(addr_from_reg(dst)); break;
-		case 11: if (CCB) set_pc(addr_from_reg(dst)); break;
-		case 12: if (CCC) set_pc(addr_from_reg(dst)); break;
-		case 13: if (CCD) set_pc(addr_from_reg(dst)); break;
-		case 14: if (CCE) set_pc(addr_from_reg(dst)); break;
-		case 15: if (CCF) set_pc(addr_from_reg(dst)); break;
+		case  0: if (CC0) set_pc<Z8001>(addr_from_reg<Z8001>(dst)); break;
+		case  1: if (CC1) set_pc<Z8001>(addr_from_reg<Z8001>(dst)); break;
+		case  2: if (CC2) set_pc<Z8001>(addr_from_reg<Z8001>(dst)); break;
+		case  3: if (CC3) set_pc<Z8001>(addr_from_reg<Z8001>(dst)); break;
+		case  4: if (CC4) set_pc<Z8001>(addr_from_reg<Z8001>(dst)); break;
+		case  5: if (CC5) set_pc<Z8001>(addr_from_reg<Z8001>(dst)); break;
+		case  6: if (CC6) set_pc<Z8001>(addr_from_reg<Z8001>(dst)); break;
+		case  7: if (CC7) set_pc<Z8001>(addr_from_reg<Z8001>(dst)); break;
+		case  8: if (CC8) set_pc<Z8001>(addr_from_reg<Z8001>(dst)); break;
+		case  9: if (CC9) set_pc<Z8001>(addr_from_reg<Z8001>(dst)); break;
+		case 10: if (CCA) set_pc<Z8001>(addr_from_reg<Z8001>(dst)); break;
+		case 11: if (CCB) set_pc<Z8001>(addr_from_reg<Z8001>(dst)); break;
+		case 12: if (CCC) set_pc<Z8001>(addr_from_reg<Z8001>(dst)); break;
+		case 13: if (CCD) set_pc<Z8001>(addr_from_reg<Z8001>(dst)); break;
+		case 14: if (CCE) set_pc<Z8001>(addr_from_reg<Z8001>(dst)); break;
+		case 15: if (CCF) set_pc<Z8001>(addr_from_reg<Z8001>(dst)); break;
 	}
+	if (m_idle_active)
+		idle_branch();
 }
 
 /******************************************
  call    @rd
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z1F_ddN0_0000()
 {
 	GET_DST(OP0,NIB2);
-	if (get_segmented_mode())
-		PUSHL(SP, make_segmented_addr(m_pc));
+	if (segmented<Z8001>())
+		PUSHL<Z8001>(SP, make_segmented_addr(m_pc));
 	else
-		PUSHW(SP, m_pc);
-	set_pc(addr_from_reg(dst));
+		PUSHW<Z8001>(SP, m_pc);
+	set_pc<Z8001>(addr_from_reg<Z8001>(dst));
 }
 
 /******************************************
  ldb     rbd,@rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z20_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	RB(dst) = RDIR_B(src);
+	RB(dst) = RDIR_B<Z8001>(src);
 }
 
 /******************************************
  ld      rd,imm16
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z21_0000_dddd_imm16()
 {
 	GET_DST(OP0,NIB3);
@@ -2212,17 +2335,19 @@ void z8002_device::Z21_0000_dddd_imm16()
  ld      rd,@rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z21_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	RW(dst) = RDIR_W(src);
+	RW(dst) = RDIR_W<Z8001>(src);
 }
 
 /******************************************
  resb    rbd,rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z22_0000_ssss_0000_dddd_0000_0000()
 {
 	GET_SRC(OP0,NIB3);
@@ -2234,19 +2359,21 @@ void z8002_device::Z22_0000_ssss_0000_dddd_0000_0000()
  resb    @rd,imm4
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z22_ddN0_imm4()
 {
 	GET_BIT(OP0);
 	GET_DST(OP0,NIB2);
 	mem_specific &space = dst == SP ? m_stack : m_data;
-	uint32_t addr = addr_from_reg(dst);
-	WRMEM_B(space, addr, RDMEM_B(space, addr) & ~bit);
+	uint32_t addr = addr_from_reg<Z8001>(dst);
+	WRMEM_B<Z8001>(space, addr, RDMEM_B<Z8001>(space, addr) & ~bit);
 }
 
 /******************************************
  res     rd,rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z23_0000_ssss_0000_dddd_0000_0000()
 {
 	GET_SRC(OP0,NIB3);
@@ -2258,19 +2385,21 @@ void z8002_device::Z23_0000_ssss_0000_dddd_0000_0000()
  res     @rd,imm4
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z23_ddN0_imm4()
 {
 	GET_BIT(OP0);
 	GET_DST(OP0,NIB2);
 	mem_specific &space = dst == SP ? m_stack : m_data;
-	uint32_t addr = addr_from_reg(dst);
-	WRMEM_W(space, addr, RDMEM_W(space, addr) & ~bit);
+	uint32_t addr = addr_from_reg<Z8001>(dst);
+	WRMEM_W<Z8001>(space, addr, RDMEM_W<Z8001>(space, addr) & ~bit);
 }
 
 /******************************************
  setb    rbd,rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z24_0000_ssss_0000_dddd_0000_0000()
 {
 	GET_SRC(OP0,NIB3);
@@ -2282,19 +2411,21 @@ void z8002_device::Z24_0000_ssss_0000_dddd_0000_0000()
  setb    @rd,imm4
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z24_ddN0_imm4()
 {
 	GET_BIT(OP0);
 	GET_DST(OP0,NIB2);
 	mem_specific &space = dst == SP ? m_stack : m_data;
-	uint32_t addr = addr_from_reg(dst);
-	WRMEM_B(space, addr, RDMEM_B(space, addr) | bit);
+	uint32_t addr = addr_from_reg<Z8001>(dst);
+	WRMEM_B<Z8001>(space, addr, RDMEM_B<Z8001>(space, addr) | bit);
 }
 
 /******************************************
  set     rd,rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z25_0000_ssss_0000_dddd_0000_0000()
 {
 	GET_SRC(OP0,NIB3);
@@ -2306,19 +2437,21 @@ void z8002_device::Z25_0000_ssss_0000_dddd_0000_0000()
  set     @rd,imm4
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z25_ddN0_imm4()
 {
 	GET_BIT(OP0);
 	GET_DST(OP0,NIB2);
 	mem_specific &space = dst == SP ? m_stack : m_data;
-	uint32_t addr = addr_from_reg(dst);
-	WRMEM_W(space, addr, RDMEM_W(space, addr) | bit);
+	uint32_t addr = addr_from_reg<Z8001>(dst);
+	WRMEM_W<Z8001>(space, addr, RDMEM_W<Z8001>(space, addr) | bit);
 }
 
 /******************************************
  bitb    rbd,rs
  flags:  -Z----
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z26_0000_ssss_0000_dddd_0000_0000()
 {
 	GET_SRC(OP0,NIB3);
@@ -2330,17 +2463,19 @@ void z8002_device::Z26_0000_ssss_0000_dddd_0000_0000()
  bitb    @rd,imm4
  flags:  -Z----
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z26_ddN0_imm4()
 {
 	GET_BIT(OP0);
 	GET_DST(OP0,NIB2);
-	if (RDIR_B(dst) & bit) CLR_Z; else SET_Z;
+	if (RDIR_B<Z8001>(dst) & bit) CLR_Z; else SET_Z;
 }
 
 /******************************************
  bit     rd,rs
  flags:  -Z----
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z27_0000_ssss_0000_dddd_0000_0000()
 {
 	GET_SRC(OP0,NIB3);
@@ -2352,77 +2487,83 @@ void z8002_device::Z27_0000_ssss_0000_dddd_0000_0000()
  bit     @rd,imm4
  flags:  -Z----
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z27_ddN0_imm4()
 {
 	GET_BIT(OP0);
 	GET_DST(OP0,NIB2);
-	if (RDIR_W(dst) & bit) CLR_Z; else SET_Z;
+	if (RDIR_W<Z8001>(dst) & bit) CLR_Z; else SET_Z;
 }
 
 /******************************************
  incb    @rd,imm4m1
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z28_ddN0_imm4m1()
 {
 	GET_I4M1(OP0,NIB3);
 	GET_DST(OP0,NIB2);
 	mem_specific &space = dst == SP ? m_stack : m_data;
-	uint32_t addr = addr_from_reg(dst);
-	WRMEM_B(space, addr, INCB(RDMEM_B(space, addr), i4p1));
+	uint32_t addr = addr_from_reg<Z8001>(dst);
+	WRMEM_B<Z8001>(space, addr, INCB(RDMEM_B<Z8001>(space, addr), i4p1));
 }
 
 /******************************************
  inc     @rd,imm4m1
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z29_ddN0_imm4m1()
 {
 	GET_I4M1(OP0,NIB3);
 	GET_DST(OP0,NIB2);
 	mem_specific &space = dst == SP ? m_stack : m_data;
-	uint32_t addr = addr_from_reg(dst);
-	WRMEM_W(space, addr, INCW(RDMEM_W(space, addr), i4p1));
+	uint32_t addr = addr_from_reg<Z8001>(dst);
+	WRMEM_W<Z8001>(space, addr, INCW(RDMEM_W<Z8001>(space, addr), i4p1));
 }
 
 /******************************************
  decb    @rd,imm4m1
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z2A_ddN0_imm4m1()
 {
 	GET_I4M1(OP0,NIB3);
 	GET_DST(OP0,NIB2);
 	mem_specific &space = dst == SP ? m_stack : m_data;
-	uint32_t addr = addr_from_reg(dst);
-	WRMEM_B(space, addr, DECB(RDMEM_B(space, addr), i4p1));
+	uint32_t addr = addr_from_reg<Z8001>(dst);
+	WRMEM_B<Z8001>(space, addr, DECB(RDMEM_B<Z8001>(space, addr), i4p1));
 }
 
 /******************************************
  dec     @rd,imm4m1
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z2B_ddN0_imm4m1()
 {
 	GET_I4M1(OP0,NIB3);
 	GET_DST(OP0,NIB2);
 	mem_specific &space = dst == SP ? m_stack : m_data;
-	uint32_t addr = addr_from_reg(dst);
-	WRMEM_W(space, addr, DECW(RDMEM_W(space, addr), i4p1));
+	uint32_t addr = addr_from_reg<Z8001>(dst);
+	WRMEM_W<Z8001>(space, addr, DECW(RDMEM_W<Z8001>(space, addr), i4p1));
 }
 
 /******************************************
  exb     rbd,@rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z2C_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	mem_specific &space = src == SP ? m_stack : m_data;
-	uint32_t addr = addr_from_reg(src);
-	uint8_t tmp = RDMEM_B(space, addr);
-	WRMEM_B(space, addr, RB(dst));
+	uint32_t addr = addr_from_reg<Z8001>(src);
+	uint8_t tmp = RDMEM_B<Z8001>(space, addr);
+	WRMEM_B<Z8001>(space, addr, RB(dst));
 	RB(dst) = tmp;
 }
 
@@ -2430,14 +2571,15 @@ void z8002_device::Z2C_ssN0_dddd()
  ex      rd,@rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z2D_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	mem_specific &space = src == SP ? m_stack : m_data;
-	uint32_t addr = addr_from_reg(src);
-	uint16_t tmp = RDMEM_W(space, addr);
-	WRMEM_W(space, addr, RW(dst));
+	uint32_t addr = addr_from_reg<Z8001>(src);
+	uint16_t tmp = RDMEM_W<Z8001>(space, addr);
+	WRMEM_W<Z8001>(space, addr, RW(dst));
 	RW(dst) = tmp;
 }
 
@@ -2445,172 +2587,187 @@ void z8002_device::Z2D_ssN0_dddd()
  ldb     @rd,rbs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z2E_ddN0_ssss()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DST(OP0,NIB2);
-	WRIR_B(dst, RB(src));
+	WRIR_B<Z8001>(dst, RB(src));
 }
 
 /******************************************
  ld      @rd,rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z2F_ddN0_ssss()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DST(OP0,NIB2);
-	WRIR_W(dst, RW(src));
+	WRIR_W<Z8001>(dst, RW(src));
 }
 
 /******************************************
  ldrb    rbd,dsp16
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z30_0000_dddd_dsp16()
 {
 	GET_DST(OP0,NIB3);
 	GET_DSP16;
-	RB(dst) = RDMEM_B(m_program, dsp16);
+	RB(dst) = RDMEM_B<Z8001>(m_program, dsp16);
 }
 
 /******************************************
  ldb     rbd,rs(idx16)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z30_ssN0_dddd_imm16()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_IDX16(OP1);
-	RB(dst) = RDBX_B(src, idx16);
+	RB(dst) = RDBX_B<Z8001>(src, idx16);
 }
 
 /******************************************
  ldr     rd,dsp16
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z31_0000_dddd_dsp16()
 {
 	GET_DST(OP0,NIB3);
 	GET_DSP16;
-	RW(dst) = RDMEM_W(m_program, dsp16);
+	RW(dst) = RDMEM_W<Z8001>(m_program, dsp16);
 }
 
 /******************************************
  ld      rd,rs(idx16)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z31_ssN0_dddd_imm16()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_IDX16(OP1);
-	RW(dst) = RDBX_W(src, idx16);
+	RW(dst) = RDBX_W<Z8001>(src, idx16);
 }
 
 /******************************************
  ldrb    dsp16,rbs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z32_0000_ssss_dsp16()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DSP16;
-	WRMEM_B(m_program, dsp16, RB(src));
+	WRMEM_B<Z8001>(m_program, dsp16, RB(src));
 }
 
 /******************************************
  ldb     rd(idx16),rbs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z32_ddN0_ssss_imm16()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DST(OP0,NIB2);
 	GET_IDX16(OP1);
-	WRBX_B(dst, idx16, RB(src));
+	WRBX_B<Z8001>(dst, idx16, RB(src));
 }
 
 /******************************************
  ldr     dsp16,rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z33_0000_ssss_dsp16()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DSP16;
-	WRMEM_W(m_program, dsp16, RW(src));
+	WRMEM_W<Z8001>(m_program, dsp16, RW(src));
 }
 
 /******************************************
  ld      rd(idx16),rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z33_ddN0_ssss_imm16()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DST(OP0,NIB2);
 	GET_IDX16(OP1);
-	WRBX_W(dst, idx16, RW(src));
+	WRBX_W<Z8001>(dst, idx16, RW(src));
 }
 
 /******************************************
  ldar    prd,dsp16
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z34_0000_dddd_dsp16()
 {
 	GET_DST(OP0,NIB3);
 	GET_DSP16;
-	addr_to_reg(dst, dsp16);
+	addr_to_reg<Z8001>(dst, dsp16);
 }
 
 /******************************************
  lda     prd,rs(idx16)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z34_ssN0_dddd_imm16()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_IDX16(OP1);
-	if (get_segmented_mode()) {
+	if (segmented<Z8001>()) {
 		RL(dst) = RL(src);
 	}
 	else {
 		RW(dst) = RW(src);
 	}
-	add_to_addr_reg(dst, idx16);
+	add_to_addr_reg<Z8001>(dst, idx16);
 }
 
 /******************************************
  ldrl    rrd,dsp16
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z35_0000_dddd_dsp16()
 {
 	GET_DST(OP0,NIB3);
 	GET_DSP16;
-	RL(dst) = RDMEM_L(m_program, dsp16);
+	RL(dst) = RDMEM_L<Z8001>(m_program, dsp16);
 }
 
 /******************************************
  ldl     rrd,rs(idx16)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z35_ssN0_dddd_imm16()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_IDX16(OP1);
-	RL(dst) = RDBX_L(src, idx16);
+	RL(dst) = RDBX_L<Z8001>(src, idx16);
 }
 
 /******************************************
  bpt
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z36_0000_0000()
 {
 	/* execute break point trap m_irq_req */
@@ -2621,6 +2778,7 @@ void z8002_device::Z36_0000_0000()
  rsvd36
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z36_imm8()
 {
 	GET_IMM8(0);
@@ -2635,29 +2793,32 @@ void z8002_device::Z36_imm8()
  ldrl    dsp16,rrs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z37_0000_ssss_dsp16()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DSP16;
-	WRMEM_L(m_program,  dsp16, RL(src));
+	WRMEM_L<Z8001>(m_program,  dsp16, RL(src));
 }
 
 /******************************************
  ldl     rd(idx16),rrs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z37_ddN0_ssss_imm16()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DST(OP0,NIB2);
 	GET_IDX16(OP1);
-	WRBX_L(dst, idx16, RL(src));
+	WRBX_L<Z8001>(dst, idx16, RL(src));
 }
 
 /******************************************
  rsvd38
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z38_imm8()
 {
 	GET_IMM8(0);
@@ -2672,29 +2833,31 @@ void z8002_device::Z38_imm8()
  ldps    @rs
  flags:  CZSVDH
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z39_ssN0_0000()
 {
 	CHECK_PRIVILEGED_INSTR();
 	GET_SRC(OP0,NIB2);
 	uint16_t fcw;
 	mem_specific &space = src == SP ? m_stack : m_data;
-	if (get_segmented_mode()) {
-		uint32_t addr = addr_from_reg(src);
-		fcw = RDMEM_W(space, addr + 2);
-		set_pc(segmented_addr(RDMEM_L(space, addr + 4)));
+	if (segmented<Z8001>()) {
+		uint32_t addr = addr_from_reg<Z8001>(src);
+		fcw = RDMEM_W<Z8001>(space, addr + 2);
+		set_pc<Z8001>(segmented_addr(RDMEM_L<Z8001>(space, addr + 4)));
 	}
 	else {
-		fcw = RDMEM_W(space, RW(src));
-		set_pc(RDMEM_W(space, (uint16_t)(RW(src) + 2)));
+		fcw = RDMEM_W<Z8001>(space, RW(src));
+		set_pc<Z8001>(RDMEM_W<Z8001>(space, (uint16_t)(RW(src) + 2)));
 	}
 	if ((fcw ^ m_fcw) & F_SEG) printf("ldps 1 (0x%05x): changing from %ssegmented mode to %ssegmented mode\n", m_pc, (m_fcw & F_SEG) ? "non-" : "", (fcw & F_SEG) ? "" : "non-");
-	CHANGE_FCW(fcw); /* check for user/system mode change */
+	CHANGE_FCW<Z8001>(fcw); /* check for user/system mode change */
 }
 
 /******************************************
  inib(r) @rd,@rs,ra
  flags:  ---V--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3A_ssss_0000_0000_aaaa_dddd_x000()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -2702,9 +2865,12 @@ void z8002_device::Z3A_ssss_0000_0000_aaaa_dddd_x000()
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);
-	WRIR_B(dst, RDPORT_B( 0, RW(src)));
-	add_to_addr_reg(dst, 1);
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_io<Z8001>(dst, src, cnt, 1, 0, true);
+		WRIR_B<Z8001>(dst, RDPORT_B( 0, RW(src)));
+		add_to_addr_reg<Z8001>(dst, 1);
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
@@ -2712,6 +2878,7 @@ void z8002_device::Z3A_ssss_0000_0000_aaaa_dddd_x000()
  sinibr  @rd,@rs,ra
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3A_ssss_0001_0000_aaaa_dddd_x000()
 {//@@@@
 	CHECK_PRIVILEGED_INSTR();
@@ -2719,10 +2886,13 @@ void z8002_device::Z3A_ssss_0001_0000_aaaa_dddd_x000()
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);
-	WRIR_B(dst, RDPORT_B( 1, RW(src)));
-	add_to_addr_reg(dst, 1);
-	//RW(src)++;
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_io<Z8001>(dst, src, cnt, 1, 1, true);
+		WRIR_B<Z8001>(dst, RDPORT_B( 1, RW(src)));
+		add_to_addr_reg<Z8001>(dst, 1);
+		//RW(src)++;
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
@@ -2730,6 +2900,7 @@ void z8002_device::Z3A_ssss_0001_0000_aaaa_dddd_x000()
  outibr  @rd,@rs,ra
  flags:  ---V--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3A_ssss_0010_0000_aaaa_dddd_x000()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -2737,9 +2908,12 @@ void z8002_device::Z3A_ssss_0010_0000_aaaa_dddd_x000()
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);
-	WRPORT_B( 0, RW(dst), RDIR_B(src));
-	add_to_addr_reg(src, 1);
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_io<Z8001>(src, dst, cnt, 1, 0, false);
+		WRPORT_B( 0, RW(dst), RDIR_B<Z8001>(src));
+		add_to_addr_reg<Z8001>(src, 1);
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
@@ -2747,6 +2921,7 @@ void z8002_device::Z3A_ssss_0010_0000_aaaa_dddd_x000()
  soutibr @rd,@rs,ra
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3A_ssss_0011_0000_aaaa_dddd_x000()
 {//@@@@
 	CHECK_PRIVILEGED_INSTR();
@@ -2754,16 +2929,20 @@ void z8002_device::Z3A_ssss_0011_0000_aaaa_dddd_x000()
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);
-	WRPORT_B( 1, RW(dst), RDIR_B(src));
-	//RW(dst)++;
-	add_to_addr_reg(src, 1);
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_io<Z8001>(src, dst, cnt, 1, 1, false);
+		WRPORT_B( 1, RW(dst), RDIR_B<Z8001>(src));
+		//RW(dst)++;
+		add_to_addr_reg<Z8001>(src, 1);
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
  inb     rbd,imm16
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3A_dddd_0100_imm16()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -2776,6 +2955,7 @@ void z8002_device::Z3A_dddd_0100_imm16()
  sinb    rbd,imm16
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3A_dddd_0101_imm16()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -2788,6 +2968,7 @@ void z8002_device::Z3A_dddd_0101_imm16()
  outb    imm16,rbs
  flags:  ---V--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3A_ssss_0110_imm16()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -2800,6 +2981,7 @@ void z8002_device::Z3A_ssss_0110_imm16()
  soutb   imm16,rbs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3A_ssss_0111_imm16()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -2813,6 +2995,7 @@ void z8002_device::Z3A_ssss_0111_imm16()
  indbr   @rd,@rs,rba
  flags:  ---V--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3A_ssss_1000_0000_aaaa_dddd_x000()
 {//@@@
 	CHECK_PRIVILEGED_INSTR();
@@ -2820,10 +3003,13 @@ void z8002_device::Z3A_ssss_1000_0000_aaaa_dddd_x000()
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);
-	WRIR_B(dst, RDPORT_B( 0, RW(src)));
-	sub_from_addr_reg(dst, 1);
-	//RW(src)--;
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_io<Z8001>(dst, src, cnt, -1, 0, true);
+		WRIR_B<Z8001>(dst, RDPORT_B( 0, RW(src)));
+		sub_from_addr_reg<Z8001>(dst, 1);
+		//RW(src)--;
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
@@ -2831,6 +3017,7 @@ void z8002_device::Z3A_ssss_1000_0000_aaaa_dddd_x000()
  sindbr  @rd,@rs,rba
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3A_ssss_1001_0000_aaaa_dddd_x000()
 {//@@@
 	CHECK_PRIVILEGED_INSTR();
@@ -2838,10 +3025,13 @@ void z8002_device::Z3A_ssss_1001_0000_aaaa_dddd_x000()
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);
-	WRIR_B(dst, RDPORT_B( 1, RW(src)));
-	sub_from_addr_reg(dst, 1);
-//	RW(src)--;
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_io<Z8001>(dst, src, cnt, -1, 1, true);
+		WRIR_B<Z8001>(dst, RDPORT_B( 1, RW(src)));
+		sub_from_addr_reg<Z8001>(dst, 1);
+	//	RW(src)--;
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
@@ -2849,6 +3039,7 @@ void z8002_device::Z3A_ssss_1001_0000_aaaa_dddd_x000()
  outdbr  @rd,@rs,rba
  flags:  ---V--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3A_ssss_1010_0000_aaaa_dddd_x000()
 {//@@@
 	CHECK_PRIVILEGED_INSTR();
@@ -2856,10 +3047,13 @@ void z8002_device::Z3A_ssss_1010_0000_aaaa_dddd_x000()
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);
-	WRPORT_B( 0, RW(dst), RDIR_B(src));
-//	RW(dst)--;
-	sub_from_addr_reg(src, 1);
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_io<Z8001>(src, dst, cnt, -1, 0, false);
+		WRPORT_B( 0, RW(dst), RDIR_B<Z8001>(src));
+	//	RW(dst)--;
+		sub_from_addr_reg<Z8001>(src, 1);
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
@@ -2867,6 +3061,7 @@ void z8002_device::Z3A_ssss_1010_0000_aaaa_dddd_x000()
  soutdbr @rd,@rs,rba
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3A_ssss_1011_0000_aaaa_dddd_x000()
 {//@@@
 	CHECK_PRIVILEGED_INSTR();
@@ -2874,10 +3069,13 @@ void z8002_device::Z3A_ssss_1011_0000_aaaa_dddd_x000()
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);
-	WRPORT_B( 1, RW(dst), RDIR_B(src));
-//	RW(dst)--;
-	sub_from_addr_reg(src, 1);
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_io<Z8001>(src, dst, cnt, -1, 1, false);
+		WRPORT_B( 1, RW(dst), RDIR_B<Z8001>(src));
+	//	RW(dst)--;
+		sub_from_addr_reg<Z8001>(src, 1);
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
@@ -2885,6 +3083,7 @@ void z8002_device::Z3A_ssss_1011_0000_aaaa_dddd_x000()
  inir    @rd,@rs,ra
  flags:  ---V--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3B_ssss_0000_0000_aaaa_dddd_x000()
 {//@@@
 	CHECK_PRIVILEGED_INSTR();
@@ -2892,10 +3091,13 @@ void z8002_device::Z3B_ssss_0000_0000_aaaa_dddd_x000()
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);
-	WRIR_W(dst, RDPORT_W( 0, RW(src)));
-	add_to_addr_reg(dst, 2);
-//	RW(src) += 2;
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_io<Z8001>(dst, src, cnt, 2, 0, true);
+		WRIR_W<Z8001>(dst, RDPORT_W( 0, RW(src)));
+		add_to_addr_reg<Z8001>(dst, 2);
+	//	RW(src) += 2;
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
@@ -2903,6 +3105,7 @@ void z8002_device::Z3B_ssss_0000_0000_aaaa_dddd_x000()
  sinir   @rd,@rs,ra
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3B_ssss_0001_0000_aaaa_dddd_x000()
 {//@@@
 	CHECK_PRIVILEGED_INSTR();
@@ -2910,10 +3113,13 @@ void z8002_device::Z3B_ssss_0001_0000_aaaa_dddd_x000()
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);
-	WRIR_W(dst, RDPORT_W( 1, RW(src)));
-	add_to_addr_reg(dst, 2);
-	//RW(src) += 2;
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_io<Z8001>(dst, src, cnt, 2, 1, true);
+		WRIR_W<Z8001>(dst, RDPORT_W( 1, RW(src)));
+		add_to_addr_reg<Z8001>(dst, 2);
+		//RW(src) += 2;
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
@@ -2921,6 +3127,7 @@ void z8002_device::Z3B_ssss_0001_0000_aaaa_dddd_x000()
  outir   @rd,@rs,ra
  flags:  ---V--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3B_ssss_0010_0000_aaaa_dddd_x000()
 {//@@@
 	CHECK_PRIVILEGED_INSTR();
@@ -2928,10 +3135,13 @@ void z8002_device::Z3B_ssss_0010_0000_aaaa_dddd_x000()
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);
-	WRPORT_W( 0, RW(dst), RDIR_W(src));
-	//RW(dst) += 2;
-	add_to_addr_reg(src, 2);
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_io<Z8001>(src, dst, cnt, 2, 0, false);
+		WRPORT_W( 0, RW(dst), RDIR_W<Z8001>(src));
+		//RW(dst) += 2;
+		add_to_addr_reg<Z8001>(src, 2);
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
@@ -2939,6 +3149,7 @@ void z8002_device::Z3B_ssss_0010_0000_aaaa_dddd_x000()
  soutir  @rd,@rs,ra
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3B_ssss_0011_0000_aaaa_dddd_x000()
 {//@@@
 	CHECK_PRIVILEGED_INSTR();
@@ -2946,16 +3157,20 @@ void z8002_device::Z3B_ssss_0011_0000_aaaa_dddd_x000()
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);
-	WRPORT_W( 1, RW(dst), RDIR_W(src));
-//	RW(dst) += 2;
-	add_to_addr_reg(src, 2);
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_io<Z8001>(src, dst, cnt, 2, 1, false);
+		WRPORT_W( 1, RW(dst), RDIR_W<Z8001>(src));
+	//	RW(dst) += 2;
+		add_to_addr_reg<Z8001>(src, 2);
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
  in      rd,imm16
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3B_dddd_0100_imm16()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -2968,6 +3183,7 @@ void z8002_device::Z3B_dddd_0100_imm16()
  sin     rd,imm16
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3B_dddd_0101_imm16()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -2980,6 +3196,7 @@ void z8002_device::Z3B_dddd_0101_imm16()
  out     imm16,rs
  flags:  ---V--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3B_ssss_0110_imm16()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -2992,6 +3209,7 @@ void z8002_device::Z3B_ssss_0110_imm16()
  sout    imm16,rbs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3B_ssss_0111_imm16()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -3005,6 +3223,7 @@ void z8002_device::Z3B_ssss_0111_imm16()
  indr    @rd,@rs,ra
  flags:  ---V--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3B_ssss_1000_0000_aaaa_dddd_x000()
 {//@@@
 	CHECK_PRIVILEGED_INSTR();
@@ -3012,10 +3231,13 @@ void z8002_device::Z3B_ssss_1000_0000_aaaa_dddd_x000()
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);
-	WRIR_W(dst, RDPORT_W( 0, RW(src)));
-	sub_from_addr_reg(dst, 2);
-	//RW(src) -= 2;
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_io<Z8001>(dst, src, cnt, -2, 0, true);
+		WRIR_W<Z8001>(dst, RDPORT_W( 0, RW(src)));
+		sub_from_addr_reg<Z8001>(dst, 2);
+		//RW(src) -= 2;
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
@@ -3023,6 +3245,7 @@ void z8002_device::Z3B_ssss_1000_0000_aaaa_dddd_x000()
  sindr   @rd,@rs,ra
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3B_ssss_1001_0000_aaaa_dddd_x000()
 {//@@@
 	CHECK_PRIVILEGED_INSTR();
@@ -3030,10 +3253,13 @@ void z8002_device::Z3B_ssss_1001_0000_aaaa_dddd_x000()
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);
-	WRIR_W(dst, RDPORT_W( 1, RW(src)));
-	sub_from_addr_reg(dst, 2);
-	//RW(src) -= 2;
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_io<Z8001>(dst, src, cnt, -2, 1, true);
+		WRIR_W<Z8001>(dst, RDPORT_W( 1, RW(src)));
+		sub_from_addr_reg<Z8001>(dst, 2);
+		//RW(src) -= 2;
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
@@ -3041,6 +3267,7 @@ void z8002_device::Z3B_ssss_1001_0000_aaaa_dddd_x000()
  outdr   @rd,@rs,ra
  flags:  ---V--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3B_ssss_1010_0000_aaaa_dddd_x000()
 {//@@@
 	CHECK_PRIVILEGED_INSTR();
@@ -3048,10 +3275,13 @@ void z8002_device::Z3B_ssss_1010_0000_aaaa_dddd_x000()
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);
-	WRPORT_W( 0, RW(dst), RDIR_W(src));
-	//RW(dst) -= 2;
-	sub_from_addr_reg(src, 2);
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_io<Z8001>(src, dst, cnt, -2, 0, false);
+		WRPORT_W( 0, RW(dst), RDIR_W<Z8001>(src));
+		//RW(dst) -= 2;
+		sub_from_addr_reg<Z8001>(src, 2);
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
@@ -3059,6 +3289,7 @@ void z8002_device::Z3B_ssss_1010_0000_aaaa_dddd_x000()
  soutdr  @rd,@rs,ra
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3B_ssss_1011_0000_aaaa_dddd_x000()
 {//@@@
 	CHECK_PRIVILEGED_INSTR();
@@ -3066,16 +3297,20 @@ void z8002_device::Z3B_ssss_1011_0000_aaaa_dddd_x000()
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);
-	WRPORT_W( 1, RW(dst), RDIR_W(src));
-	//RW(dst) -= 2;
-	sub_from_addr_reg(src, 2);
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_io<Z8001>(src, dst, cnt, -2, 1, false);
+		WRPORT_W( 1, RW(dst), RDIR_W<Z8001>(src));
+		//RW(dst) -= 2;
+		sub_from_addr_reg<Z8001>(src, 2);
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
  inb     rbd,@rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3C_ssss_dddd()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -3088,6 +3323,7 @@ void z8002_device::Z3C_ssss_dddd()
  in      rd,@rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3D_ssss_dddd()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -3100,6 +3336,7 @@ void z8002_device::Z3D_ssss_dddd()
  outb    @rd,rbs
  flags:  ---V--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3E_dddd_ssss()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -3112,6 +3349,7 @@ void z8002_device::Z3E_dddd_ssss()
  out     @rd,rs
  flags:  ---V--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z3F_dddd_ssss()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -3124,824 +3362,894 @@ void z8002_device::Z3F_dddd_ssss()
  addb    rbd,addr
  flags:  CZSVDH
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z40_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	RB(dst) = ADDB(RB(dst), RDMEM_B(m_data, addr));
+	RB(dst) = ADDB(RB(dst), RDMEM_B<Z8001>(m_data, addr));
 }
 
 /******************************************
  addb    rbd,addr(rs)
  flags:  CZSVDH
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z40_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	RB(dst) = ADDB(RB(dst), RDMEM_B(m_data, addr));
+	RB(dst) = ADDB(RB(dst), RDMEM_B<Z8001>(m_data, addr));
 }
 
 /******************************************
  add     rd,addr
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z41_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	RW(dst) = ADDW(RW(dst), RDMEM_W(m_data, addr)); /* EHC */
+	RW(dst) = ADDW(RW(dst), RDMEM_W<Z8001>(m_data, addr)); /* EHC */
 }
 
 /******************************************
  add     rd,addr(rs)
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z41_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	RW(dst) = ADDW(RW(dst), RDMEM_W(m_data, addr));    /* ASG */
+	RW(dst) = ADDW(RW(dst), RDMEM_W<Z8001>(m_data, addr));    /* ASG */
 }
 
 /******************************************
  subb    rbd,addr
  flags:  CZSVDH
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z42_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	RB(dst) = SUBB(RB(dst), RDMEM_B(m_data, addr)); /* EHC */
+	RB(dst) = SUBB(RB(dst), RDMEM_B<Z8001>(m_data, addr)); /* EHC */
 }
 
 /******************************************
  subb    rbd,addr(rs)
  flags:  CZSVDH
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z42_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	RB(dst) = SUBB(RB(dst), RDMEM_B(m_data, addr));
+	RB(dst) = SUBB(RB(dst), RDMEM_B<Z8001>(m_data, addr));
 }
 
 /******************************************
  sub     rd,addr
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z43_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	RW(dst) = SUBW(RW(dst), RDMEM_W(m_data, addr));
+	RW(dst) = SUBW(RW(dst), RDMEM_W<Z8001>(m_data, addr));
 }
 
 /******************************************
  sub     rd,addr(rs)
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z43_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	RW(dst) = SUBW(RW(dst), RDMEM_W(m_data, addr));
+	RW(dst) = SUBW(RW(dst), RDMEM_W<Z8001>(m_data, addr));
 }
 
 /******************************************
  orb     rbd,addr
  flags:  CZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z44_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	RB(dst) = ORB(RB(dst), RDMEM_B(m_data, addr));
+	RB(dst) = ORB(RB(dst), RDMEM_B<Z8001>(m_data, addr));
 }
 
 /******************************************
  orb     rbd,addr(rs)
  flags:  CZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z44_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	RB(dst) = ORB(RB(dst), RDMEM_B(m_data, addr));
+	RB(dst) = ORB(RB(dst), RDMEM_B<Z8001>(m_data, addr));
 }
 
 /******************************************
  or      rd,addr
  flags:  CZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z45_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	RW(dst) = ORW(RW(dst), RDMEM_W(m_data, addr));
+	RW(dst) = ORW(RW(dst), RDMEM_W<Z8001>(m_data, addr));
 }
 
 /******************************************
  or      rd,addr(rs)
  flags:  CZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z45_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	RW(dst) = ORW(RW(dst), RDMEM_W(m_data, addr));
+	RW(dst) = ORW(RW(dst), RDMEM_W<Z8001>(m_data, addr));
 }
 
 /******************************************
  andb    rbd,addr
  flags:  -ZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z46_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	RB(dst) = ANDB(RB(dst), RDMEM_B(m_data, addr));
+	RB(dst) = ANDB(RB(dst), RDMEM_B<Z8001>(m_data, addr));
 }
 
 /******************************************
  andb    rbd,addr(rs)
  flags:  -ZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z46_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	RB(dst) = ANDB(RB(dst), RDMEM_B(m_data, addr));
+	RB(dst) = ANDB(RB(dst), RDMEM_B<Z8001>(m_data, addr));
 }
 
 /******************************************
  and     rd,addr
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z47_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	RW(dst) = ANDW(RW(dst), RDMEM_W(m_data, addr));
+	RW(dst) = ANDW(RW(dst), RDMEM_W<Z8001>(m_data, addr));
 }
 
 /******************************************
  and     rd,addr(rs)
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z47_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	RW(dst) = ANDW(RW(dst), RDMEM_W(m_data, addr));
+	RW(dst) = ANDW(RW(dst), RDMEM_W<Z8001>(m_data, addr));
 }
 
 /******************************************
  xorb    rbd,addr
  flags:  -ZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z48_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	RB(dst) = XORB(RB(dst), RDMEM_B(m_data, addr));
+	RB(dst) = XORB(RB(dst), RDMEM_B<Z8001>(m_data, addr));
 }
 
 /******************************************
  xorb    rbd,addr(rs)
  flags:  -ZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z48_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	RB(dst) = XORB(RB(dst), RDMEM_B(m_data, addr));
+	RB(dst) = XORB(RB(dst), RDMEM_B<Z8001>(m_data, addr));
 }
 
 /******************************************
  xor     rd,addr
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z49_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	RW(dst) = XORW(RW(dst), RDMEM_W(m_data, addr));
+	RW(dst) = XORW(RW(dst), RDMEM_W<Z8001>(m_data, addr));
 }
 
 /******************************************
  xor     rd,addr(rs)
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z49_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	RW(dst) = XORW(RW(dst), RDMEM_W(m_data, addr));
+	RW(dst) = XORW(RW(dst), RDMEM_W<Z8001>(m_data, addr));
 }
 
 /******************************************
  cpb     rbd,addr
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4A_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	CPB(RB(dst), RDMEM_B(m_data, addr));
+	CPB(RB(dst), RDMEM_B<Z8001>(m_data, addr));
 }
 
 /******************************************
  cpb     rbd,addr(rs)
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4A_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	CPB(RB(dst), RDMEM_B(m_data, addr));
+	CPB(RB(dst), RDMEM_B<Z8001>(m_data, addr));
 }
 
 /******************************************
  cp      rd,addr
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4B_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	CPW(RW(dst), RDMEM_W(m_data, addr));
+	CPW(RW(dst), RDMEM_W<Z8001>(m_data, addr));
 }
 
 /******************************************
  cp      rd,addr(rs)
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4B_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	CPW(RW(dst), RDMEM_W(m_data, addr));
+	CPW(RW(dst), RDMEM_W<Z8001>(m_data, addr));
 }
 
 /******************************************
  comb    addr
  flags:  -ZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4C_0000_0000_addr()
 {
 	GET_ADDR(OP1);
-	WRMEM_B(m_data,  addr, COMB(RDMEM_B(m_data, addr)));
+	WRMEM_B<Z8001>(m_data,  addr, COMB(RDMEM_B<Z8001>(m_data, addr)));
 }
 
 /******************************************
  cpb     addr,imm8
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4C_0000_0001_addr_imm8()
 {
 	GET_ADDR(OP1);
 	GET_IMM8(OP2);
-	CPB(RDMEM_B(m_data, addr), imm8);
+	CPB(RDMEM_B<Z8001>(m_data, addr), imm8);
 }
 
 /******************************************
  negb    addr
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4C_0000_0010_addr()
 {
 	GET_ADDR(OP1);
-	WRMEM_B(m_data,  addr, NEGB(RDMEM_B(m_data, addr)));
+	WRMEM_B<Z8001>(m_data,  addr, NEGB(RDMEM_B<Z8001>(m_data, addr)));
 }
 
 /******************************************
  testb   addr
  flags:  -ZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4C_0000_0100_addr()
 {
 	GET_ADDR(OP1);
-	TESTB(RDMEM_B(m_data, addr));
+	TESTB(RDMEM_B<Z8001>(m_data, addr));
 }
 
 /******************************************
  ldb     addr,imm8
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4C_0000_0101_addr_imm8()
 {
 	GET_ADDR(OP1);
 	GET_IMM8(OP2);
-	WRMEM_B(m_data,  addr, imm8);
+	WRMEM_B<Z8001>(m_data,  addr, imm8);
 }
 
 /******************************************
  tsetb   addr
  flags:  --S---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4C_0000_0110_addr()
 {
 	GET_ADDR(OP1);
-	if (RDMEM_B(m_data, addr) & S08) SET_S; else CLR_S;
-	WRMEM_B(m_data, addr, 0xff);
+	if (RDMEM_B<Z8001>(m_data, addr) & S08) SET_S; else CLR_S;
+	WRMEM_B<Z8001>(m_data, addr, 0xff);
 }
 
 /******************************************
  clrb    addr
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4C_0000_1000_addr()
 {
 	GET_ADDR(OP1);
-	WRMEM_B(m_data,  addr, 0);
+	WRMEM_B<Z8001>(m_data,  addr, 0);
 }
 
 /******************************************
  comb    addr(rd)
  flags:  -ZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4C_ddN0_0000_addr()
 {
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_B(m_data,  addr, COMB(RDMEM_B(m_data, addr)));
+	WRMEM_B<Z8001>(m_data,  addr, COMB(RDMEM_B<Z8001>(m_data, addr)));
 }
 
 /******************************************
  cpb     addr(rd),imm8
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4C_ddN0_0001_addr_imm8()
 {
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	GET_IMM8(OP2);
 	addr = addr_add(addr, RW(dst));
-	CPB(RDMEM_B(m_data, addr), imm8);
+	CPB(RDMEM_B<Z8001>(m_data, addr), imm8);
 }
 
 /******************************************
  negb    addr(rd)
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4C_ddN0_0010_addr()
 {
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_B(m_data, addr, NEGB(RDMEM_B(m_data, addr)));
+	WRMEM_B<Z8001>(m_data, addr, NEGB(RDMEM_B<Z8001>(m_data, addr)));
 }
 
 /******************************************
  testb   addr(rd)
  flags:  -ZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4C_ddN0_0100_addr()
 {
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	TESTB(RDMEM_B(m_data, addr));
+	TESTB(RDMEM_B<Z8001>(m_data, addr));
 }
 
 /******************************************
  ldb     addr(rd),imm8
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4C_ddN0_0101_addr_imm8()
 {
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	GET_IMM8(OP2);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_B(m_data, addr, imm8);
+	WRMEM_B<Z8001>(m_data, addr, imm8);
 }
 
 /******************************************
  tsetb   addr(rd)
  flags:  --S---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4C_ddN0_0110_addr()
 {
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	if (RDMEM_B(m_data, addr) & S08) SET_S; else CLR_S;
-	WRMEM_B(m_data, addr, 0xff);
+	if (RDMEM_B<Z8001>(m_data, addr) & S08) SET_S; else CLR_S;
+	WRMEM_B<Z8001>(m_data, addr, 0xff);
 }
 
 /******************************************
  clrb    addr(rd)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4C_ddN0_1000_addr()
 {
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_B(m_data, addr, 0);
+	WRMEM_B<Z8001>(m_data, addr, 0);
 }
 
 /******************************************
  com     addr
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4D_0000_0000_addr()
 {
 	GET_ADDR(OP1);
-	WRMEM_W(m_data,  addr, COMW(RDMEM_W(m_data, addr)));
+	WRMEM_W<Z8001>(m_data,  addr, COMW(RDMEM_W<Z8001>(m_data, addr)));
 }
 
 /******************************************
  cp      addr,imm16
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4D_0000_0001_addr_imm16()
 {
 	GET_ADDR(OP1);
 	GET_IMM16(OP2);
-	CPW(RDMEM_W(m_data, addr), imm16);
+	CPW(RDMEM_W<Z8001>(m_data, addr), imm16);
 }
 
 /******************************************
  neg     addr
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4D_0000_0010_addr()
 {
 	GET_ADDR(OP1);
-	WRMEM_W(m_data,  addr, NEGW(RDMEM_W(m_data, addr)));
+	WRMEM_W<Z8001>(m_data,  addr, NEGW(RDMEM_W<Z8001>(m_data, addr)));
 }
 
 /******************************************
  test    addr
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4D_0000_0100_addr()
 {
 	GET_ADDR(OP1);
-	TESTW(RDMEM_W(m_data, addr));
+	TESTW(RDMEM_W<Z8001>(m_data, addr));
 }
 
 /******************************************
  ld      addr,imm16
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4D_0000_0101_addr_imm16()
 {
 	GET_ADDR(OP1);
 	GET_IMM16(OP2);
-	WRMEM_W(m_data,  addr, imm16);
+	WRMEM_W<Z8001>(m_data,  addr, imm16);
 }
 
 /******************************************
  tset    addr
  flags:  --S---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4D_0000_0110_addr()
 {
 	GET_ADDR(OP1);
-	if (RDMEM_W(m_data, addr) & S16) SET_S; else CLR_S;
-	WRMEM_W(m_data, addr, 0xffff);
+	if (RDMEM_W<Z8001>(m_data, addr) & S16) SET_S; else CLR_S;
+	WRMEM_W<Z8001>(m_data, addr, 0xffff);
 }
 
 /******************************************
  clr     addr
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4D_0000_1000_addr()
 {
 	GET_ADDR(OP1);
-	WRMEM_W(m_data,  addr, 0);
+	WRMEM_W<Z8001>(m_data,  addr, 0);
 }
 
 /******************************************
  com     addr(rd)
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4D_ddN0_0000_addr()
 {
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_W(m_data, addr, COMW(RDMEM_W(m_data, addr)));
+	WRMEM_W<Z8001>(m_data, addr, COMW(RDMEM_W<Z8001>(m_data, addr)));
 }
 
 /******************************************
  cp      addr(rd),imm16
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4D_ddN0_0001_addr_imm16()
 {
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	GET_IMM16(OP2);
 	addr = addr_add(addr, RW(dst));
-	CPW(RDMEM_W(m_data, addr), imm16);
+	CPW(RDMEM_W<Z8001>(m_data, addr), imm16);
 }
 
 /******************************************
  neg     addr(rd)
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4D_ddN0_0010_addr()
 {
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_W(m_data, addr, NEGW(RDMEM_W(m_data, addr)));
+	WRMEM_W<Z8001>(m_data, addr, NEGW(RDMEM_W<Z8001>(m_data, addr)));
 }
 
 /******************************************
  test    addr(rd)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4D_ddN0_0100_addr()
 {
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	TESTW(RDMEM_W(m_data, addr));
+	TESTW(RDMEM_W<Z8001>(m_data, addr));
 }
 
 /******************************************
  ld      addr(rd),imm16
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4D_ddN0_0101_addr_imm16()
 {
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	GET_IMM16(OP2);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_W(m_data, addr, imm16);
+	WRMEM_W<Z8001>(m_data, addr, imm16);
 }
 
 /******************************************
  tset    addr(rd)
  flags:  --S---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4D_ddN0_0110_addr()
 {
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	if (RDMEM_W(m_data, addr) & S16) SET_S; else CLR_S;
-	WRMEM_W(m_data, addr, 0xffff);
+	if (RDMEM_W<Z8001>(m_data, addr) & S16) SET_S; else CLR_S;
+	WRMEM_W<Z8001>(m_data, addr, 0xffff);
 }
 
 /******************************************
  clr     addr(rd)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4D_ddN0_1000_addr()
 {
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_W(m_data, addr, 0);
+	WRMEM_W<Z8001>(m_data, addr, 0);
 }
 
 /******************************************
  ldb     addr(rd),rbs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z4E_ddN0_ssN0_addr()
 {
 	GET_DST(OP0,NIB2);
 	GET_SRC(OP0,NIB3);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_B(m_data, addr, RB(src));
+	WRMEM_B<Z8001>(m_data, addr, RB(src));
 }
 
 /******************************************
  cpl     rrd,addr
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z50_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	CPL(RL(dst), RDMEM_L(m_data, addr));
+	CPL(RL(dst), RDMEM_L<Z8001>(m_data, addr));
 }
 
 /******************************************
  cpl     rrd,addr(rs)
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z50_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	CPL(RL(dst), RDMEM_L(m_data, addr));
+	CPL(RL(dst), RDMEM_L<Z8001>(m_data, addr));
 }
 
 /******************************************
  pushl   @rd,addr
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z51_ddN0_0000_addr()
 {
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
-	PUSHL(dst, RDMEM_L(m_data, addr));
+	PUSHL<Z8001>(dst, RDMEM_L<Z8001>(m_data, addr));
 }
 
 /******************************************
  pushl   @rd,addr(rs)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z51_ddN0_ssN0_addr()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	PUSHL(dst, RDMEM_L(m_data, addr));
+	PUSHL<Z8001>(dst, RDMEM_L<Z8001>(m_data, addr));
 }
 
 /******************************************
  subl    rrd,addr
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z52_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	RL(dst) = SUBL(RL(dst), RDMEM_L(m_data, addr));
+	RL(dst) = SUBL(RL(dst), RDMEM_L<Z8001>(m_data, addr));
 }
 
 /******************************************
  subl    rrd,addr(rs)
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z52_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	RL(dst) = SUBL(RL(dst), RDMEM_L(m_data, addr));
+	RL(dst) = SUBL(RL(dst), RDMEM_L<Z8001>(m_data, addr));
 }
 
 /******************************************
  push    @rd,addr
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z53_ddN0_0000_addr()
 {
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
-	PUSHW(dst, RDMEM_W(m_data, addr));
+	PUSHW<Z8001>(dst, RDMEM_W<Z8001>(m_data, addr));
 }
 
 /******************************************
  push    @rd,addr(rs)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z53_ddN0_ssN0_addr()
 {
 	GET_DST(OP0,NIB2);
 	GET_SRC(OP0,NIB3);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	PUSHW(dst, RDMEM_W(m_data, addr));
+	PUSHW<Z8001>(dst, RDMEM_W<Z8001>(m_data, addr));
 }
 
 /******************************************
  ldl     rrd,addr
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z54_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	RL(dst) = RDMEM_L(m_data, addr);
+	RL(dst) = RDMEM_L<Z8001>(m_data, addr);
 }
 
 /******************************************
  ldl     rrd,addr(rs)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z54_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	RL(dst) = RDMEM_L(m_data, addr);
+	RL(dst) = RDMEM_L<Z8001>(m_data, addr);
 }
 
 /******************************************
  popl    addr,@rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z55_ssN0_0000_addr()
 {
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
-	WRMEM_L(m_data, addr, POPL(src));
+	WRMEM_L<Z8001>(m_data, addr, POPL<Z8001>(src));
 }
 
 /******************************************
  popl    addr(rd),@rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z55_ssN0_ddN0_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_L(m_data, addr, POPL(src));
+	WRMEM_L<Z8001>(m_data, addr, POPL<Z8001>(src));
 }
 
 /******************************************
  addl    rrd,addr
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z56_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	RL(dst) = ADDL(RL(dst), RDMEM_L(m_data, addr));
+	RL(dst) = ADDL(RL(dst), RDMEM_L<Z8001>(m_data, addr));
 }
 
 /******************************************
  addl    rrd,addr(rs)
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z56_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	RL(dst) = ADDL(RL(dst), RDMEM_L(m_data, addr));
+	RL(dst) = ADDL(RL(dst), RDMEM_L<Z8001>(m_data, addr));
 }
 
 /******************************************
  pop     addr,@rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z57_ssN0_0000_addr()
 {
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
-	WRMEM_W(m_data, addr, POPW(src));
+	WRMEM_W<Z8001>(m_data, addr, POPW<Z8001>(src));
 }
 
 /******************************************
  pop     addr(rd),@rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z57_ssN0_ddN0_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_W(m_data, addr, POPW(src));
+	WRMEM_W<Z8001>(m_data, addr, POPW<Z8001>(src));
 }
 
 /******************************************
  multl   rqd,addr
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z58_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	uint64_t result = MULTL((uint32_t)RL(dst+2), RDMEM_L(m_data, addr));
+	uint64_t result = MULTL((uint32_t)RL(dst+2), RDMEM_L<Z8001>(m_data, addr));
 	RL(dst) = (uint32_t)(result >> 32);
 	RL(dst+2) = (uint32_t)(result & 0xFFFFFFFF);
 }
@@ -3950,13 +4258,14 @@ void z8002_device::Z58_0000_dddd_addr()
  multl   rqd,addr(rs)
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z58_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	uint64_t result = MULTL((uint32_t)RL(dst+2), RDMEM_L(m_data, addr));
+	uint64_t result = MULTL((uint32_t)RL(dst+2), RDMEM_L<Z8001>(m_data, addr));
 	RL(dst) = (uint32_t)(result >> 32);
 	RL(dst+2) = (uint32_t)(result & 0xFFFFFFFF);
 }
@@ -3965,36 +4274,39 @@ void z8002_device::Z58_ssN0_dddd_addr()
  mult    rrd,addr
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z59_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	RL(dst) = MULTW(RL(dst), RDMEM_W(m_data, addr));
+	RL(dst) = MULTW(RL(dst), RDMEM_W<Z8001>(m_data, addr));
 }
 
 /******************************************
  mult    rrd,addr(rs)
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z59_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	RL(dst) = MULTW(RL(dst), RDMEM_W(m_data, addr));
+	RL(dst) = MULTW(RL(dst), RDMEM_W<Z8001>(m_data, addr));
 }
 
 /******************************************
  divl    rqd,addr
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z5A_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
 	uint64_t dividend = ((uint64_t)RL(dst) << 32) | (uint32_t)RL(dst+2);
-	uint64_t result = DIVL(dividend, RDMEM_L(m_data, addr));
+	uint64_t result = DIVL(dividend, RDMEM_L<Z8001>(m_data, addr));
 	RL(dst) = (uint32_t)(result >> 32);
 	RL(dst+2) = (uint32_t)(result & 0xFFFFFFFF);
 }
@@ -4003,6 +4315,7 @@ void z8002_device::Z5A_0000_dddd_addr()
  divl    rqd,addr(rs)
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z5A_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
@@ -4010,7 +4323,7 @@ void z8002_device::Z5A_ssN0_dddd_addr()
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
 	uint64_t dividend = ((uint64_t)RL(dst) << 32) | (uint32_t)RL(dst+2);
-	uint64_t result = DIVL(dividend, RDMEM_L(m_data, addr));
+	uint64_t result = DIVL(dividend, RDMEM_L<Z8001>(m_data, addr));
 	RL(dst) = (uint32_t)(result >> 32);
 	RL(dst+2) = (uint32_t)(result & 0xFFFFFFFF);
 }
@@ -4019,37 +4332,40 @@ void z8002_device::Z5A_ssN0_dddd_addr()
  div     rrd,addr
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z5B_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	RL(dst) = DIVW(RL(dst), RDMEM_W(m_data, addr));
+	RL(dst) = DIVW(RL(dst), RDMEM_W<Z8001>(m_data, addr));
 }
 
 /******************************************
  div     rrd,addr(rs)
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z5B_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	RL(dst) = DIVW(RL(dst), RDMEM_W(m_data, addr));
+	RL(dst) = DIVW(RL(dst), RDMEM_W<Z8001>(m_data, addr));
 }
 
 /******************************************
  ldm     rd,addr,n
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z5C_0000_0001_0000_dddd_0000_nmin1_addr()
 {
 	GET_DST(OP1,NIB1);
 	GET_CNT(OP1,NIB3);
 	GET_ADDR(OP2);
 	while (cnt-- >= 0) {
-		RW(dst) = RDMEM_W(m_data, addr);
+		RW(dst) = RDMEM_W<Z8001>(m_data, addr);
 		dst = (dst+1) & 15;
 		addr = addr_add (addr, 2);
 	}
@@ -4059,23 +4375,25 @@ void z8002_device::Z5C_0000_0001_0000_dddd_0000_nmin1_addr()
  testl   addr
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z5C_0000_1000_addr()
 {
 	GET_ADDR(OP1);
-	TESTL(RDMEM_L(m_data, addr));
+	TESTL(RDMEM_L<Z8001>(m_data, addr));
 }
 
 /******************************************
  ldm     addr,rs,n
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z5C_0000_1001_0000_ssss_0000_nmin1_addr()
 {
 	GET_SRC(OP1,NIB1);
 	GET_CNT(OP1,NIB3);
 	GET_ADDR(OP2);
 	while (cnt-- >= 0) {
-		WRMEM_W(m_data, addr, RW(src));
+		WRMEM_W<Z8001>(m_data, addr, RW(src));
 		src = (src+1) & 15;
 		addr = addr_add (addr, 2);
 	}
@@ -4085,18 +4403,20 @@ void z8002_device::Z5C_0000_1001_0000_ssss_0000_nmin1_addr()
  testl   addr(rd)
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z5C_ddN0_1000_addr()
 {
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	TESTL(RDMEM_L(m_data, addr));
+	TESTL(RDMEM_L<Z8001>(m_data, addr));
 }
 
 /******************************************
  ldm     addr(rd),rs,n
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z5C_ddN0_1001_0000_ssN0_0000_nmin1_addr()
 {
 	GET_DST(OP0,NIB2);
@@ -4105,7 +4425,7 @@ void z8002_device::Z5C_ddN0_1001_0000_ssN0_0000_nmin1_addr()
 	GET_ADDR(OP2);
 	addr = addr_add(addr, RW(dst));
 	while (cnt-- >= 0) {
-		WRMEM_W(m_data, addr, RW(src));
+		WRMEM_W<Z8001>(m_data, addr, RW(src));
 		src = (src+1) & 15;
 		addr = addr_add(addr, 2);
 	}
@@ -4115,6 +4435,7 @@ void z8002_device::Z5C_ddN0_1001_0000_ssN0_0000_nmin1_addr()
  ldm     rd,addr(rs),n
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z5C_ssN0_0001_0000_dddd_0000_nmin1_addr()
 {
 	GET_SRC(OP0,NIB2);
@@ -4123,7 +4444,7 @@ void z8002_device::Z5C_ssN0_0001_0000_dddd_0000_nmin1_addr()
 	GET_ADDR(OP2);
 	addr = addr_add(addr, RW(src));
 	while (cnt-- >= 0) {
-		RW(dst) = RDMEM_W(m_data, addr);
+		RW(dst) = RDMEM_W<Z8001>(m_data, addr);
 		dst = (dst+1) & 15;
 		addr = addr_add(addr, 2);
 	}
@@ -4133,58 +4454,64 @@ void z8002_device::Z5C_ssN0_0001_0000_dddd_0000_nmin1_addr()
  ldl     addr,rrs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z5D_0000_ssss_addr()
 {
 	GET_SRC(OP0,NIB3);
 	GET_ADDR(OP1);
-	WRMEM_L(m_data, addr, RL(src));
+	WRMEM_L<Z8001>(m_data, addr, RL(src));
 }
 
 /******************************************
  ldl     addr(rd),rrs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z5D_ddN0_ssss_addr()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_L(m_data, addr, RL(src));
+	WRMEM_L<Z8001>(m_data, addr, RL(src));
 }
 
 /******************************************
  jp      cc,addr
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z5E_0000_cccc_addr()
 {
 	GET_CCC(OP0,NIB3);
 	GET_ADDR(OP1);
 	switch (cc) {
-		case  0: if (CC0) set_pc(addr); break;
-		case  1: if (CC1) set_pc(addr); break;
-		case  2: if (CC2) set_pc(addr); break;
-		case  3: if (CC3) set_pc(addr); break;
-		case  4: if (CC4) set_pc(addr); break;
-		case  5: if (CC5) set_pc(addr); break;
-		case  6: if (CC6) set_pc(addr); break;
-		case  7: if (CC7) set_pc(addr); break;
-		case  8: if (CC8) set_pc(addr); break;
-		case  9: if (CC9) set_pc(addr); break;
-		case 10: if (CCA) set_pc(addr); break;
-		case 11: if (CCB) set_pc(addr); break;
-		case 12: if (CCC) set_pc(addr); break;
-		case 13: if (CCD) set_pc(addr); break;
-		case 14: if (CCE) set_pc(addr); break;
-		case 15: if (CCF) set_pc(addr); break;
+		case  0: if (CC0) set_pc<Z8001>(addr); break;
+		case  1: if (CC1) set_pc<Z8001>(addr); break;
+		case  2: if (CC2) set_pc<Z8001>(addr); break;
+		case  3: if (CC3) set_pc<Z8001>(addr); break;
+		case  4: if (CC4) set_pc<Z8001>(addr); break;
+		case  5: if (CC5) set_pc<Z8001>(addr); break;
+		case  6: if (CC6) set_pc<Z8001>(addr); break;
+		case  7: if (CC7) set_pc<Z8001>(addr); break;
+		case  8: if (CC8) set_pc<Z8001>(addr); break;
+		case  9: if (CC9) set_pc<Z8001>(addr); break;
+		case 10: if (CCA) set_pc<Z8001>(addr); break;
+		case 11: if (CCB) set_pc<Z8001>(addr); break;
+		case 12: if (CCC) set_pc<Z8001>(addr); break;
+		case 13: if (CCD) set_pc<Z8001>(addr); break;
+		case 14: if (CCE) set_pc<Z8001>(addr); break;
+		case 15: if (CCF) set_pc<Z8001>(addr); break;
 	}
+	if (m_idle_active)
+		idle_branch();
 }
 
 /******************************************
  jp      cc,addr(rd)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z5E_ddN0_cccc_addr()
 {
 	GET_CCC(OP0,NIB3);
@@ -4192,353 +4519,382 @@ void z8002_device::Z5E_ddN0_cccc_addr()
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
 	switch (cc) {
-		case  0: if (CC0) set_pc(addr); break;
-		case  1: if (CC1) set_pc(addr); break;
-		case  2: if (CC2) set_pc(addr); break;
-		case  3: if (CC3) set_pc(addr); break;
-		case  4: if (CC4) set_pc(addr); break;
-		case  5: if (CC5) set_pc(addr); break;
-		case  6: if (CC6) set_pc(addr); break;
-		case  7: if (CC7) set_pc(addr); break;
-		case  8: if (CC8) set_pc(addr); break;
-		case  9: if (CC9) set_pc(addr); break;
-		case 10: if (CCA) set_pc(addr); break;
-		case 11: if (CCB) set_pc(addr); break;
-		case 12: if (CCC) set_pc(addr); break;
-		case 13: if (CCD) set_pc(addr); break;
-		case 14: if (CCE) set_pc(addr); break;
-		case 15: if (CCF) set_pc(addr); break;
+		case  0: if (CC0) set_pc<Z8001>(addr); break;
+		case  1: if (CC1) set_pc<Z8001>(addr); break;
+		case  2: if (CC2) set_pc<Z8001>(addr); break;
+		case  3: if (CC3) set_pc<Z8001>(addr); break;
+		case  4: if (CC4) set_pc<Z8001>(addr); break;
+		case  5: if (CC5) set_pc<Z8001>(addr); break;
+		case  6: if (CC6) set_pc<Z8001>(addr); break;
+		case  7: if (CC7) set_pc<Z8001>(addr); break;
+		case  8: if (CC8) set_pc<Z8001>(addr); break;
+		case  9: if (CC9) set_pc<Z8001>(addr); break;
+		case 10: if (CCA) set_pc<Z8001>(addr); break;
+		case 11: if (CCB) set_pc<Z8001>(addr); break;
+		case 12: if (CCC) set_pc<Z8001>(addr); break;
+		case 13: if (CCD) set_pc<Z8001>(addr); break;
+		case 14: if (CCE) set_pc<Z8001>(addr); break;
+		case 15: if (CCF) set_pc<Z8001>(addr); break;
 	}
+	if (m_idle_active)
+		idle_branch();
 }
 
 /******************************************
  call    addr
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z5F_0000_0000_addr()
 {
 	GET_ADDR(OP1);
-	if (get_segmented_mode())
-		PUSHL(SP, make_segmented_addr(m_pc));
+	if (segmented<Z8001>())
+		PUSHL<Z8001>(SP, make_segmented_addr(m_pc));
 	else
-		PUSHW(SP, m_pc);
-	set_pc(addr);
+		PUSHW<Z8001>(SP, m_pc);
+	set_pc<Z8001>(addr);
 }
 
 /******************************************
  call    addr(rd)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z5F_ddN0_0000_addr()
 {
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
-	if (get_segmented_mode())
-		PUSHL(SP, make_segmented_addr(m_pc));
+	if (segmented<Z8001>())
+		PUSHL<Z8001>(SP, make_segmented_addr(m_pc));
 	else
-		PUSHW(SP, m_pc);
+		PUSHW<Z8001>(SP, m_pc);
 	addr = addr_add(addr, RW(dst));
-	set_pc(addr);
+	set_pc<Z8001>(addr);
 }
 
 /******************************************
  ldb     rbd,addr
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z60_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	RB(dst) = RDMEM_B(m_data, addr);
+	RB(dst) = RDMEM_B<Z8001>(m_data, addr);
 }
 
 /******************************************
  ldb     rbd,addr(rs)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z60_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	RB(dst) = RDMEM_B(m_data, addr);
+	RB(dst) = RDMEM_B<Z8001>(m_data, addr);
 }
 
 /******************************************
  ld      rd,addr
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z61_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	RW(dst) = RDMEM_W(m_data, addr);
+	RW(dst) = RDMEM_W<Z8001>(m_data, addr);
 }
 
 /******************************************
  ld      rd,addr(rs)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z61_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(src));
-	RW(dst) = RDMEM_W(m_data, addr);
+	RW(dst) = RDMEM_W<Z8001>(m_data, addr);
 }
 
 /******************************************
  resb    addr,imm4
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z62_0000_imm4_addr()
 {
 	GET_BIT(OP0);
 	GET_ADDR(OP1);
-	WRMEM_B(m_data, addr, RDMEM_B(m_data, addr) & ~bit);
+	WRMEM_B<Z8001>(m_data, addr, RDMEM_B<Z8001>(m_data, addr) & ~bit);
 }
 
 /******************************************
  resb    addr(rd),imm4
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z62_ddN0_imm4_addr()
 {
 	GET_BIT(OP0);
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_B(m_data, addr, RDMEM_B(m_data, addr) & ~bit);
+	WRMEM_B<Z8001>(m_data, addr, RDMEM_B<Z8001>(m_data, addr) & ~bit);
 }
 
 /******************************************
  res     addr,imm4
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z63_0000_imm4_addr()
 {
 	GET_BIT(OP0);
 	GET_ADDR(OP1);
-	WRMEM_W(m_data, addr, RDMEM_W(m_data, addr) & ~bit);
+	WRMEM_W<Z8001>(m_data, addr, RDMEM_W<Z8001>(m_data, addr) & ~bit);
 }
 
 /******************************************
  res     addr(rd),imm4
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z63_ddN0_imm4_addr()
 {
 	GET_BIT(OP0);
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_W(m_data, addr, RDMEM_W(m_data, addr) & ~bit);
+	WRMEM_W<Z8001>(m_data, addr, RDMEM_W<Z8001>(m_data, addr) & ~bit);
 }
 
 /******************************************
  setb    addr,imm4
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z64_0000_imm4_addr()
 {
 	GET_BIT(OP0);
 	GET_ADDR(OP1);
-	WRMEM_B(m_data, addr, RDMEM_B(m_data, addr) | bit);
+	WRMEM_B<Z8001>(m_data, addr, RDMEM_B<Z8001>(m_data, addr) | bit);
 }
 
 /******************************************
  setb    addr(rd),imm4
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z64_ddN0_imm4_addr()
 {
 	GET_BIT(OP0);
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_B(m_data, addr, RDMEM_B(m_data, addr) | bit);
+	WRMEM_B<Z8001>(m_data, addr, RDMEM_B<Z8001>(m_data, addr) | bit);
 }
 
 /******************************************
  set     addr,imm4
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z65_0000_imm4_addr()
 {
 	GET_BIT(OP0);
 	GET_ADDR(OP1);
-	WRMEM_W(m_data, addr, RDMEM_W(m_data, addr) | bit);
+	WRMEM_W<Z8001>(m_data, addr, RDMEM_W<Z8001>(m_data, addr) | bit);
 }
 
 /******************************************
  set     addr(rd),imm4
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z65_ddN0_imm4_addr()
 {
 	GET_BIT(OP0);
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_W(m_data, addr, RDMEM_W(m_data, addr) | bit);
+	WRMEM_W<Z8001>(m_data, addr, RDMEM_W<Z8001>(m_data, addr) | bit);
 }
 
 /******************************************
  bitb    addr,imm4
  flags:  -Z----
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z66_0000_imm4_addr()
 {
 	GET_BIT(OP0);
 	GET_ADDR(OP1);
-	if (RDMEM_B(m_data, addr) & bit) CLR_Z; else SET_Z;
+	if (RDMEM_B<Z8001>(m_data, addr) & bit) CLR_Z; else SET_Z;
 }
 
 /******************************************
  bitb    addr(rd),imm4
  flags:  -Z----
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z66_ddN0_imm4_addr()
 {
 	GET_BIT(OP0);
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	if (RDMEM_B(m_data, addr) & bit) CLR_Z; else SET_Z;
+	if (RDMEM_B<Z8001>(m_data, addr) & bit) CLR_Z; else SET_Z;
 }
 
 /******************************************
  bit     addr,imm4
  flags:  -Z----
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z67_0000_imm4_addr()
 {
 	GET_BIT(OP0);
 	GET_ADDR(OP1);
-	if (RDMEM_W(m_data, addr) & bit) CLR_Z; else SET_Z;
+	if (RDMEM_W<Z8001>(m_data, addr) & bit) CLR_Z; else SET_Z;
 }
 
 /******************************************
  bit     addr(rd),imm4
  flags:  -Z----
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z67_ddN0_imm4_addr()
 {
 	GET_BIT(OP0);
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	if (RDMEM_W(m_data, addr) & bit) CLR_Z; else SET_Z;
+	if (RDMEM_W<Z8001>(m_data, addr) & bit) CLR_Z; else SET_Z;
 }
 
 /******************************************
  incb    addr,imm4m1
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z68_0000_imm4m1_addr()
 {
 	GET_I4M1(OP0,NIB3);
 	GET_ADDR(OP1);
-	WRMEM_B(m_data, addr, INCB(RDMEM_B(m_data, addr), i4p1));
+	WRMEM_B<Z8001>(m_data, addr, INCB(RDMEM_B<Z8001>(m_data, addr), i4p1));
 }
 
 /******************************************
  incb    addr(rd),imm4m1
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z68_ddN0_imm4m1_addr()
 {
 	GET_I4M1(OP0,NIB3);
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_B(m_data, addr, INCB(RDMEM_B(m_data, addr), i4p1));
+	WRMEM_B<Z8001>(m_data, addr, INCB(RDMEM_B<Z8001>(m_data, addr), i4p1));
 }
 
 /******************************************
  inc     addr,imm4m1
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z69_0000_imm4m1_addr()
 {
 	GET_I4M1(OP0,NIB3);
 	GET_ADDR(OP1);
-	WRMEM_W(m_data, addr, INCW(RDMEM_W(m_data, addr), i4p1));
+	WRMEM_W<Z8001>(m_data, addr, INCW(RDMEM_W<Z8001>(m_data, addr), i4p1));
 }
 
 /******************************************
  inc     addr(rd),imm4m1
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z69_ddN0_imm4m1_addr()
 {
 	GET_I4M1(OP0,NIB3);
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_W(m_data, addr, INCW(RDMEM_W(m_data, addr), i4p1));
+	WRMEM_W<Z8001>(m_data, addr, INCW(RDMEM_W<Z8001>(m_data, addr), i4p1));
 }
 
 /******************************************
  decb    addr,imm4m1
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z6A_0000_imm4m1_addr()
 {
 	GET_I4M1(OP0,NIB3);
 	GET_ADDR(OP1);
-	WRMEM_B(m_data, addr, DECB(RDMEM_B(m_data, addr), i4p1));
+	WRMEM_B<Z8001>(m_data, addr, DECB(RDMEM_B<Z8001>(m_data, addr), i4p1));
 }
 
 /******************************************
  decb    addr(rd),imm4m1
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z6A_ddN0_imm4m1_addr()
 {
 	GET_I4M1(OP0,NIB3);
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_B(m_data, addr, DECB(RDMEM_B(m_data, addr), i4p1));
+	WRMEM_B<Z8001>(m_data, addr, DECB(RDMEM_B<Z8001>(m_data, addr), i4p1));
 }
 
 /******************************************
  dec     addr,imm4m1
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z6B_0000_imm4m1_addr()
 {
 	GET_I4M1(OP0,NIB3);
 	GET_ADDR(OP1);
-	WRMEM_W(m_data, addr, DECW(RDMEM_W(m_data, addr), i4p1));
+	WRMEM_W<Z8001>(m_data, addr, DECW(RDMEM_W<Z8001>(m_data, addr), i4p1));
 }
 
 /******************************************
  dec     addr(rd),imm4m1
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z6B_ddN0_imm4m1_addr()
 {
 	GET_I4M1(OP0,NIB3);
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_W(m_data, addr, DECW(RDMEM_W(m_data, addr), i4p1));
+	WRMEM_W<Z8001>(m_data, addr, DECW(RDMEM_W<Z8001>(m_data, addr), i4p1));
 }
 
 /******************************************
  exb     rbd,addr
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z6C_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	uint8_t tmp = RDMEM_B(m_data, addr);
-	WRMEM_B(m_data, addr, RB(dst));
+	uint8_t tmp = RDMEM_B<Z8001>(m_data, addr);
+	WRMEM_B<Z8001>(m_data, addr, RB(dst));
 	RB(dst) = tmp;
 }
 
@@ -4546,6 +4902,7 @@ void z8002_device::Z6C_0000_dddd_addr()
  exb     rbd,addr(rs)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z6C_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
@@ -4553,8 +4910,8 @@ void z8002_device::Z6C_ssN0_dddd_addr()
 	GET_ADDR(OP1);
 	uint8_t tmp;
 	addr = addr_add(addr, RW(src));
-	tmp = RDMEM_B(m_data, addr);
-	WRMEM_B(m_data, addr, RB(dst));
+	tmp = RDMEM_B<Z8001>(m_data, addr);
+	WRMEM_B<Z8001>(m_data, addr, RB(dst));
 	RB(dst) = tmp;
 }
 
@@ -4562,12 +4919,13 @@ void z8002_device::Z6C_ssN0_dddd_addr()
  ex      rd,addr
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z6D_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR(OP1);
-	uint16_t tmp = RDMEM_W(m_data, addr);
-	WRMEM_W(m_data, addr, RW(dst));
+	uint16_t tmp = RDMEM_W<Z8001>(m_data, addr);
+	WRMEM_W<Z8001>(m_data, addr, RW(dst));
 	RW(dst) = tmp;
 }
 
@@ -4575,6 +4933,7 @@ void z8002_device::Z6D_0000_dddd_addr()
  ex      rd,addr(rs)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z6D_ssN0_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
@@ -4582,8 +4941,8 @@ void z8002_device::Z6D_ssN0_dddd_addr()
 	GET_ADDR(OP1);
 	uint16_t tmp;
 	addr = addr_add(addr, RW(src));
-	tmp = RDMEM_W(m_data, addr);
-	WRMEM_W(m_data, addr, RW(dst));
+	tmp = RDMEM_W<Z8001>(m_data, addr);
+	WRMEM_W<Z8001>(m_data, addr, RW(dst));
 	RW(dst) = tmp;
 }
 
@@ -4591,137 +4950,148 @@ void z8002_device::Z6D_ssN0_dddd_addr()
  ldb     addr,rbs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z6E_0000_ssss_addr()
 {
 	GET_SRC(OP0,NIB3);
 	GET_ADDR(OP1);
-	WRMEM_B(m_data,  addr, RB(src));
+	WRMEM_B<Z8001>(m_data,  addr, RB(src));
 }
 
 /******************************************
  ldb     addr(rd),rbs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z6E_ddN0_ssss_addr()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_B(m_data, addr, RB(src));
+	WRMEM_B<Z8001>(m_data, addr, RB(src));
 }
 
 /******************************************
  ld      addr,rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z6F_0000_ssss_addr()
 {
 	GET_SRC(OP0,NIB3);
 	GET_ADDR(OP1);
-	WRMEM_W(m_data,  addr, RW(src));
+	WRMEM_W<Z8001>(m_data,  addr, RW(src));
 }
 
 /******************************************
  ld      addr(rd),rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z6F_ddN0_ssss_addr()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DST(OP0,NIB2);
 	GET_ADDR(OP1);
 	addr = addr_add(addr, RW(dst));
-	WRMEM_W(m_data, addr, RW(src));
+	WRMEM_W<Z8001>(m_data, addr, RW(src));
 }
 
 /******************************************
  ldb     rbd,rs(rx)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z70_ssN0_dddd_0000_xxxx_0000_0000()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_IDX(OP1,NIB1);
-	RB(dst) = RDBX_B(src, RW(idx));
+	RB(dst) = RDBX_B<Z8001>(src, RW(idx));
 }
 
 /******************************************
  ld      rd,rs(rx)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z71_ssN0_dddd_0000_xxxx_0000_0000()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_IDX(OP1,NIB1);
-	RW(dst) = RDBX_W(src, RW(idx));
+	RW(dst) = RDBX_W<Z8001>(src, RW(idx));
 }
 
 /******************************************
  ldb     rd(rx),rbs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z72_ddN0_ssss_0000_xxxx_0000_0000()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DST(OP0,NIB2);
 	GET_IDX(OP1,NIB1);
-	WRBX_B(dst, RW(idx), RB(src));
+	WRBX_B<Z8001>(dst, RW(idx), RB(src));
 }
 
 /******************************************
  ld      rd(rx),rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z73_ddN0_ssss_0000_xxxx_0000_0000()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DST(OP0,NIB2);
 	GET_IDX(OP1,NIB1);
-	WRBX_W(dst, RW(idx), RW(src));
+	WRBX_W<Z8001>(dst, RW(idx), RW(src));
 }
 
 /******************************************
  lda     prd,rs(rx)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z74_ssN0_dddd_0000_xxxx_0000_0000()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_IDX(OP1,NIB1);
-	if (get_segmented_mode()) {
+	if (segmented<Z8001>()) {
 		RL(dst) = RL(src);
 	}
 	else {
 		RW(dst) = RW(src);
 	}
-	add_to_addr_reg(dst, RW(idx));
+	add_to_addr_reg<Z8001>(dst, RW(idx));
 }
 
 /******************************************
  ldl     rrd,rs(rx)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z75_ssN0_dddd_0000_xxxx_0000_0000()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_IDX(OP1,NIB1);
-	RL(dst) = RDBX_L(src, RW(idx));
+	RL(dst) = RDBX_L<Z8001>(src, RW(idx));
 }
 
 /******************************************
  lda     prd,addr
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z76_0000_dddd_addr()
 {
 	GET_DST(OP0,NIB3);
 	GET_ADDR_RAW(OP1);
-	if (get_segmented_mode()) {
+	if (segmented<Z8001>()) {
 		RL(dst) = addr;
 	}
 	else {
@@ -4733,37 +5103,40 @@ void z8002_device::Z76_0000_dddd_addr()
  lda     prd,addr(rs)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z76_ssN0_dddd_addr()
 {//@@@
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
 	GET_ADDR_RAW(OP1);
 	uint16_t temp = RW(src);  // store src in case dst == src
-	if (get_segmented_mode()) {
+	if (segmented<Z8001>()) {
 		RL(dst) = addr;
 	}
 	else {
 		RW(dst) = addr;
 	}
-	add_to_addr_reg(dst, temp);
+	add_to_addr_reg<Z8001>(dst, temp);
 }
 
 /******************************************
  ldl     rd(rx),rrs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z77_ddN0_ssss_0000_xxxx_0000_0000()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DST(OP0,NIB2);
 	GET_IDX(OP1,NIB1);
-	WRBX_L(dst, RW(idx), RL(src));
+	WRBX_L<Z8001>(dst, RW(idx), RL(src));
 }
 
 /******************************************
  rsvd78
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z78_imm8()
 {
 	GET_IMM8(0);
@@ -4778,26 +5151,28 @@ void z8002_device::Z78_imm8()
  ldps    addr
  flags:  CZSVDH
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z79_0000_0000_addr()
 {
 	CHECK_PRIVILEGED_INSTR();
 	GET_ADDR(OP1);
 	uint16_t fcw;
-	if (get_segmented_mode()) {
-		fcw = RDMEM_W(m_data, addr + 2);
-		set_pc(segmented_addr(RDMEM_L(m_data, addr + 4)));
+	if (segmented<Z8001>()) {
+		fcw = RDMEM_W<Z8001>(m_data, addr + 2);
+		set_pc<Z8001>(segmented_addr(RDMEM_L<Z8001>(m_data, addr + 4)));
 	}
 	else {
-		fcw = RDMEM_W(m_data, addr);
-		set_pc(RDMEM_W(m_data, (uint16_t)(addr + 2)));
+		fcw = RDMEM_W<Z8001>(m_data, addr);
+		set_pc<Z8001>(RDMEM_W<Z8001>(m_data, (uint16_t)(addr + 2)));
 	}
-	CHANGE_FCW(fcw); /* check for user/system mode change */
+	CHANGE_FCW<Z8001>(fcw); /* check for user/system mode change */
 }
 
 /******************************************
  ldps    addr(rs)
  flags:  CZSVDH
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z79_ssN0_0000_addr()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -4805,22 +5180,23 @@ void z8002_device::Z79_ssN0_0000_addr()
 	GET_ADDR(OP1);
 	uint16_t fcw;
 	addr = addr_add(addr, RW(src));
-	if (get_segmented_mode()) {
-		fcw = RDMEM_W(m_data, addr + 2);
-		set_pc(segmented_addr(RDMEM_L(m_data, addr + 4)));
+	if (segmented<Z8001>()) {
+		fcw = RDMEM_W<Z8001>(m_data, addr + 2);
+		set_pc<Z8001>(segmented_addr(RDMEM_L<Z8001>(m_data, addr + 4)));
 	}
 	else {
-		fcw = RDMEM_W(m_data, addr);
-		m_pc = RDMEM_W(m_data, (uint16_t)(addr + 2));
+		fcw = RDMEM_W<Z8001>(m_data, addr);
+		m_pc = RDMEM_W<Z8001>(m_data, (uint16_t)(addr + 2));
 	}
 	if ((fcw ^ m_fcw) & F_SEG) printf("ldps 3 (0x%05x): changing from %ssegmented mode to %ssegmented mode\n", m_pc, (fcw & F_SEG) ? "non-" : "", (fcw & F_SEG) ? "" : "non-");
-	CHANGE_FCW(fcw); /* check for user/system mode change */
+	CHANGE_FCW<Z8001>(fcw); /* check for user/system mode change */
 }
 
 /******************************************
  halt
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z7A_0000_0000()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -4832,17 +5208,18 @@ void z8002_device::Z7A_0000_0000()
  iret
  flags:  CZSVDH
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z7B_0000_0000()
 {
 	uint16_t tag, fcw;
 	CHECK_PRIVILEGED_INSTR();
-	tag = POPW(SP);   /* get type tag */
-	fcw = POPW(SP);   /* get m_fcw  */
-	if (get_segmented_mode())
-		set_pc(segmented_addr(POPL(SP)));
+	tag = POPW<Z8001>(SP);   /* get type tag */
+	fcw = POPW<Z8001>(SP);   /* get m_fcw  */
+	if (segmented<Z8001>())
+		set_pc<Z8001>(segmented_addr(POPL<Z8001>(SP)));
 	else
-		m_pc    = POPW(SP);   /* get m_pc   */
-	CHANGE_FCW(fcw);       /* check for user/system mode change */
+		m_pc    = POPW<Z8001>(SP);   /* get m_pc   */
+	CHANGE_FCW<Z8001>(fcw);       /* check for user/system mode change */
 	LOG("Z8K IRET tag $%04x, fcw $%04x, pc $%04x\n", tag, fcw, m_pc);
 }
 
@@ -4850,6 +5227,7 @@ void z8002_device::Z7B_0000_0000()
  mset
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z7B_0000_1000()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -4860,6 +5238,7 @@ void z8002_device::Z7B_0000_1000()
  mres
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z7B_0000_1001()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -4870,6 +5249,7 @@ void z8002_device::Z7B_0000_1001()
  mbit
  flags:  CZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z7B_0000_1010()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -4880,6 +5260,7 @@ void z8002_device::Z7B_0000_1010()
  mreq    rd
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z7B_dddd_1101()
 {
 	CHECK_PRIVILEGED_INSTR();
@@ -4908,32 +5289,35 @@ void z8002_device::Z7B_dddd_1101()
  di      i2
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z7C_0000_00ii()
 {
 	CHECK_PRIVILEGED_INSTR();
 	GET_IMM2(OP0,NIB3);
-	uint16_t fcw = m_fcw;
+	uint16_t fcw = sync_fcw();
 	fcw &= (imm2 << 11) | 0xe7ff;
-	CHANGE_FCW(fcw);
+	CHANGE_FCW<Z8001>(fcw);
 }
 
 /******************************************
  ei      i2
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z7C_0000_01ii()
 {
 	CHECK_PRIVILEGED_INSTR();
 	GET_IMM2(OP0,NIB3);
-	uint16_t fcw = m_fcw;
+	uint16_t fcw = sync_fcw();
 	fcw |= ((~imm2) << 11) & 0x1800;
-	CHANGE_FCW(fcw);
+	CHANGE_FCW<Z8001>(fcw);
 }
 
 /******************************************
  ldctl   rd,ctrl
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z7D_dddd_0ccc()
 {//@@@
 	CHECK_PRIVILEGED_INSTR();
@@ -4941,7 +5325,7 @@ void z8002_device::Z7D_dddd_0ccc()
 	GET_DST(OP0,NIB2);
 	switch (imm3) {
 		case 2:
-			RW(dst) = m_fcw;
+			RW(dst) = sync_fcw();
 			break;
 		case 3:
 			RW(dst) = m_refresh;
@@ -4967,6 +5351,7 @@ void z8002_device::Z7D_dddd_0ccc()
  ldctl   ctrl,rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z7D_ssss_1ccc()
 {//@@@
 	CHECK_PRIVILEGED_INSTR();
@@ -4977,7 +5362,7 @@ void z8002_device::Z7D_ssss_1ccc()
 			{
 				uint16_t fcw;
 				fcw = RW(src);
-				CHANGE_FCW(fcw); /* check for user/system mode change */
+				CHANGE_FCW<Z8001>(fcw); /* check for user/system mode change */
 			}
 			break;
 		case 3:
@@ -4985,9 +5370,11 @@ void z8002_device::Z7D_ssss_1ccc()
 			break;
 		case 4:
 			m_psapseg = RW(src);
+			update_psa();
 			break;
 		case 5:
 			m_psapoff = RW(src) & 0xff00;  // PSAP is 256-byte aligned; low byte is reserved (reads back 0)
+			update_psa();
 			break;
 		case 6:
 			m_nspseg = RW(src);
@@ -5004,6 +5391,7 @@ void z8002_device::Z7D_ssss_1ccc()
  rsvd7e
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z7E_imm8()
 {
 	GET_IMM8(0);
@@ -5018,6 +5406,7 @@ void z8002_device::Z7E_imm8()
  sc      imm8
  flags:  CZSVDH
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z7F_imm8()
 {
 	GET_IMM8(0);
@@ -5030,6 +5419,7 @@ void z8002_device::Z7F_imm8()
  addb    rbd,rbs
  flags:  CZSVDH
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z80_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5041,6 +5431,7 @@ void z8002_device::Z80_ssss_dddd()
  add     rd,rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z81_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5052,6 +5443,7 @@ void z8002_device::Z81_ssss_dddd()
  subb    rbd,rbs
  flags:  CZSVDH
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z82_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5063,6 +5455,7 @@ void z8002_device::Z82_ssss_dddd()
  sub     rd,rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z83_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5074,6 +5467,7 @@ void z8002_device::Z83_ssss_dddd()
  orb     rbd,rbs
  flags:  CZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z84_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5085,6 +5479,7 @@ void z8002_device::Z84_ssss_dddd()
  or      rd,rs
  flags:  CZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z85_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5096,6 +5491,7 @@ void z8002_device::Z85_ssss_dddd()
  andb    rbd,rbs
  flags:  -ZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z86_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5107,6 +5503,7 @@ void z8002_device::Z86_ssss_dddd()
  and     rd,rs
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z87_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5118,6 +5515,7 @@ void z8002_device::Z87_ssss_dddd()
  xorb    rbd,rbs
  flags:  -ZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z88_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5129,6 +5527,7 @@ void z8002_device::Z88_ssss_dddd()
  xor     rd,rs
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z89_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5140,6 +5539,7 @@ void z8002_device::Z89_ssss_dddd()
  cpb     rbd,rbs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8A_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5151,6 +5551,7 @@ void z8002_device::Z8A_ssss_dddd()
  cp      rd,rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8B_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5162,6 +5563,7 @@ void z8002_device::Z8B_ssss_dddd()
  comb    rbd
  flags:  -ZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8C_dddd_0000()
 {
 	GET_DST(OP0,NIB2);
@@ -5172,6 +5574,7 @@ void z8002_device::Z8C_dddd_0000()
  negb    rbd
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8C_dddd_0010()
 {
 	GET_DST(OP0,NIB2);
@@ -5182,6 +5585,7 @@ void z8002_device::Z8C_dddd_0010()
  testb   rbd
  flags:  -ZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8C_dddd_0100()
 {
 	GET_DST(OP0,NIB2);
@@ -5192,6 +5596,7 @@ void z8002_device::Z8C_dddd_0100()
  tsetb   rbd
  flags:  --S---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8C_dddd_0110()
 {
 	GET_DST(OP0,NIB2);
@@ -5203,16 +5608,18 @@ void z8002_device::Z8C_dddd_0110()
  ldctlb rbd,flags
  flags:  CZSVDH
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8C_dddd_0001()
 {
 	GET_DST(OP0,NIB2);
-	RB(dst) = m_fcw & 0xfc;
+	RB(dst) = FCW_FLAGS & 0xfc;
 }
 
 /******************************************
  clrb    rbd
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8C_dddd_1000()
 {
 	GET_DST(OP0,NIB2);
@@ -5223,10 +5630,11 @@ void z8002_device::Z8C_dddd_1000()
  ldctlb flags,rbd
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8C_dddd_1001()
 {
 	GET_DST(OP0,NIB2);
-	m_fcw &= ~0x00fc;
+	FLAGS_RMW &= ~0x00fc;
 	m_fcw |= (RB(dst) & 0xfc);
 }
 
@@ -5234,6 +5642,7 @@ void z8002_device::Z8C_dddd_1001()
  nop
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8D_0000_0111()
 {
 	/* nothing */
@@ -5243,6 +5652,7 @@ void z8002_device::Z8D_0000_0111()
  com     rd
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8D_dddd_0000()
 {
 	GET_DST(OP0,NIB2);
@@ -5253,6 +5663,7 @@ void z8002_device::Z8D_dddd_0000()
  neg     rd
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8D_dddd_0010()
 {
 	GET_DST(OP0,NIB2);
@@ -5263,6 +5674,7 @@ void z8002_device::Z8D_dddd_0010()
  test    rd
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8D_dddd_0100()
 {
 	GET_DST(OP0,NIB2);
@@ -5273,6 +5685,7 @@ void z8002_device::Z8D_dddd_0100()
  tset    rd
  flags:  --S---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8D_dddd_0110()
 {
 	GET_DST(OP0,NIB2);
@@ -5284,6 +5697,7 @@ void z8002_device::Z8D_dddd_0110()
  clr     rd
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8D_dddd_1000()
 {
 	GET_DST(OP0,NIB2);
@@ -5294,27 +5708,30 @@ void z8002_device::Z8D_dddd_1000()
  setflg  imm4
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8D_imm4_0001()
 {
-	m_fcw |= m_op[0] & 0x00f0;
+	FLAGS_RMW |= m_op[0] & 0x00f0;
 }
 
 /******************************************
  resflg  imm4
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8D_imm4_0011()
 {
-	m_fcw &= ~(m_op[0] & 0x00f0);
+	FLAGS_RMW &= ~(m_op[0] & 0x00f0);
 }
 
 /******************************************
  comflg  flags
  flags:  CZSP--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8D_imm4_0101()
 {
-	m_fcw ^= (m_op[0] & 0x00f0);
+	FLAGS_RMW ^= (m_op[0] & 0x00f0);
 	m_fcw ^= F_H;   /* Hardware XORs (toggles) H flag — IR[2]=1 for COMFLG */
 }
 
@@ -5322,6 +5739,7 @@ void z8002_device::Z8D_imm4_0101()
  ext8e   imm8
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8E_imm8()
 {
 	CHECK_EXT_INSTR();
@@ -5337,6 +5755,7 @@ void z8002_device::Z8E_imm8()
  ext8f   imm8
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z8F_imm8()
 {
 	//CHECK_EXT_INSTR();
@@ -5352,6 +5771,7 @@ void z8002_device::Z8F_imm8()
  cpl     rrd,rrs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z90_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5363,17 +5783,19 @@ void z8002_device::Z90_ssss_dddd()
  pushl   @rd,rrs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z91_ddN0_ssss()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DST(OP0,NIB2);
-	PUSHL(dst, RL(src));
+	PUSHL<Z8001>(dst, RL(src));
 }
 
 /******************************************
  subl    rrd,rrs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z92_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5385,17 +5807,19 @@ void z8002_device::Z92_ssss_dddd()
  push    @rd,rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z93_ddN0_ssss()
 {
 	GET_SRC(OP0,NIB3);
 	GET_DST(OP0,NIB2);
-	PUSHW(dst, RW(src));
+	PUSHW<Z8001>(dst, RW(src));
 }
 
 /******************************************
  ldl     rrd,rrs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z94_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5407,17 +5831,19 @@ void z8002_device::Z94_ssss_dddd()
  popl    rrd,@rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z95_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	RL(dst) = POPL(src);
+	RL(dst) = POPL<Z8001>(src);
 }
 
 /******************************************
  addl    rrd,rrs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z96_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5429,17 +5855,19 @@ void z8002_device::Z96_ssss_dddd()
  pop     rd,@rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z97_ssN0_dddd()
 {
 	GET_DST(OP0,NIB3);
 	GET_SRC(OP0,NIB2);
-	RW(dst) = POPW(src);
+	RW(dst) = POPW<Z8001>(src);
 }
 
 /******************************************
  multl   rqd,rrs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z98_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5453,6 +5881,7 @@ void z8002_device::Z98_ssss_dddd()
  mult    rrd,rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z99_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5464,6 +5893,7 @@ void z8002_device::Z99_ssss_dddd()
  divl    rqd,rrs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z9A_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5478,6 +5908,7 @@ void z8002_device::Z9A_ssss_dddd()
  div     rrd,rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z9B_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5489,6 +5920,7 @@ void z8002_device::Z9B_ssss_dddd()
  testl   rrd
  flags:  -ZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z9C_dddd_1000()
 {
 	GET_DST(OP0,NIB2);
@@ -5501,6 +5933,7 @@ void z8002_device::Z9C_dddd_1000()
  rsvd9d
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z9D_imm8()
 {
 	GET_IMM8(0);
@@ -5515,47 +5948,48 @@ void z8002_device::Z9D_imm8()
  ret     cc
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z9E_0000_cccc()
 {
 	GET_CCC(OP0,NIB3);
-	if (get_segmented_mode()) {
+	if (segmented<Z8001>()) {
 		switch (cc) {
-			case  0: if (CC0) set_pc(segmented_addr(POPL(SP))); break;
-			case  1: if (CC1) set_pc(segmented_addr(POPL(SP))); break;
-			case  2: if (CC2) set_pc(segmented_addr(POPL(SP))); break;
-			case  3: if (CC3) set_pc(segmented_addr(POPL(SP))); break;
-			case  4: if (CC4) set_pc(segmented_addr(POPL(SP))); break;
-			case  5: if (CC5) set_pc(segmented_addr(POPL(SP))); break;
-			case  6: if (CC6) set_pc(segmented_addr(POPL(SP))); break;
-			case  7: if (CC7) set_pc(segmented_addr(POPL(SP))); break;
-			case  8: if (CC8) set_pc(segmented_addr(POPL(SP))); break;
-			case  9: if (CC9) set_pc(segmented_addr(POPL(SP))); break;
-			case 10: if (CCA) set_pc(segmented_addr(POPL(SP))); break;
-			case 11: if (CCB) set_pc(segmented_addr(POPL(SP))); break;
-			case 12: if (CCC) set_pc(segmented_addr(POPL(SP))); break;
-			case 13: if (CCD) set_pc(segmented_addr(POPL(SP))); break;
-			case 14: if (CCE) set_pc(segmented_addr(POPL(SP))); break;
-			case 15: if (CCF) set_pc(segmented_addr(POPL(SP))); break;
+			case  0: if (CC0) set_pc<Z8001>(segmented_addr(POPL<Z8001>(SP))); break;
+			case  1: if (CC1) set_pc<Z8001>(segmented_addr(POPL<Z8001>(SP))); break;
+			case  2: if (CC2) set_pc<Z8001>(segmented_addr(POPL<Z8001>(SP))); break;
+			case  3: if (CC3) set_pc<Z8001>(segmented_addr(POPL<Z8001>(SP))); break;
+			case  4: if (CC4) set_pc<Z8001>(segmented_addr(POPL<Z8001>(SP))); break;
+			case  5: if (CC5) set_pc<Z8001>(segmented_addr(POPL<Z8001>(SP))); break;
+			case  6: if (CC6) set_pc<Z8001>(segmented_addr(POPL<Z8001>(SP))); break;
+			case  7: if (CC7) set_pc<Z8001>(segmented_addr(POPL<Z8001>(SP))); break;
+			case  8: if (CC8) set_pc<Z8001>(segmented_addr(POPL<Z8001>(SP))); break;
+			case  9: if (CC9) set_pc<Z8001>(segmented_addr(POPL<Z8001>(SP))); break;
+			case 10: if (CCA) set_pc<Z8001>(segmented_addr(POPL<Z8001>(SP))); break;
+			case 11: if (CCB) set_pc<Z8001>(segmented_addr(POPL<Z8001>(SP))); break;
+			case 12: if (CCC) set_pc<Z8001>(segmented_addr(POPL<Z8001>(SP))); break;
+			case 13: if (CCD) set_pc<Z8001>(segmented_addr(POPL<Z8001>(SP))); break;
+			case 14: if (CCE) set_pc<Z8001>(segmented_addr(POPL<Z8001>(SP))); break;
+			case 15: if (CCF) set_pc<Z8001>(segmented_addr(POPL<Z8001>(SP))); break;
 		}
 	}
 	else {
 		switch (cc) {
-			case  0: if (CC0) set_pc(POPW(SP)); break;
-			case  1: if (CC1) set_pc(POPW(SP)); break;
-			case  2: if (CC2) set_pc(POPW(SP)); break;
-			case  3: if (CC3) set_pc(POPW(SP)); break;
-			case  4: if (CC4) set_pc(POPW(SP)); break;
-			case  5: if (CC5) set_pc(POPW(SP)); break;
-			case  6: if (CC6) set_pc(POPW(SP)); break;
-			case  7: if (CC7) set_pc(POPW(SP)); break;
-			case  8: if (CC8) set_pc(POPW(SP)); break;
-			case  9: if (CC9) set_pc(POPW(SP)); break;
-			case 10: if (CCA) set_pc(POPW(SP)); break;
-			case 11: if (CCB) set_pc(POPW(SP)); break;
-			case 12: if (CCC) set_pc(POPW(SP)); break;
-			case 13: if (CCD) set_pc(POPW(SP)); break;
-			case 14: if (CCE) set_pc(POPW(SP)); break;
-			case 15: if (CCF) set_pc(POPW(SP)); break;
+			case  0: if (CC0) set_pc<Z8001>(POPW<Z8001>(SP)); break;
+			case  1: if (CC1) set_pc<Z8001>(POPW<Z8001>(SP)); break;
+			case  2: if (CC2) set_pc<Z8001>(POPW<Z8001>(SP)); break;
+			case  3: if (CC3) set_pc<Z8001>(POPW<Z8001>(SP)); break;
+			case  4: if (CC4) set_pc<Z8001>(POPW<Z8001>(SP)); break;
+			case  5: if (CC5) set_pc<Z8001>(POPW<Z8001>(SP)); break;
+			case  6: if (CC6) set_pc<Z8001>(POPW<Z8001>(SP)); break;
+			case  7: if (CC7) set_pc<Z8001>(POPW<Z8001>(SP)); break;
+			case  8: if (CC8) set_pc<Z8001>(POPW<Z8001>(SP)); break;
+			case  9: if (CC9) set_pc<Z8001>(POPW<Z8001>(SP)); break;
+			case 10: if (CCA) set_pc<Z8001>(POPW<Z8001>(SP)); break;
+			case 11: if (CCB) set_pc<Z8001>(POPW<Z8001>(SP)); break;
+			case 12: if (CCC) set_pc<Z8001>(POPW<Z8001>(SP)); break;
+			case 13: if (CCD) set_pc<Z8001>(POPW<Z8001>(SP)); break;
+			case 14: if (CCE) set_pc<Z8001>(POPW<Z8001>(SP)); break;
+			case 15: if (CCF) set_pc<Z8001>(POPW<Z8001>(SP)); break;
 		}
 	}
 }
@@ -5564,6 +5998,7 @@ void z8002_device::Z9E_0000_cccc()
  rsvd9f
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z9F_imm8()
 {
 	GET_IMM8(0);
@@ -5578,6 +6013,7 @@ void z8002_device::Z9F_imm8()
  ldb     rbd,rbs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZA0_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5589,6 +6025,7 @@ void z8002_device::ZA0_ssss_dddd()
  ld      rd,rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZA1_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5600,6 +6037,7 @@ void z8002_device::ZA1_ssss_dddd()
  resb    rbd,imm4
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZA2_dddd_imm4()
 {
 	GET_BIT(OP0);
@@ -5611,6 +6049,7 @@ void z8002_device::ZA2_dddd_imm4()
  res     rd,imm4
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZA3_dddd_imm4()
 {
 	GET_BIT(OP0);
@@ -5622,6 +6061,7 @@ void z8002_device::ZA3_dddd_imm4()
  setb    rbd,imm4
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZA4_dddd_imm4()
 {
 	GET_BIT(OP0);
@@ -5633,6 +6073,7 @@ void z8002_device::ZA4_dddd_imm4()
  set     rd,imm4
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZA5_dddd_imm4()
 {
 	GET_BIT(OP0);
@@ -5644,6 +6085,7 @@ void z8002_device::ZA5_dddd_imm4()
  bitb    rbd,imm4
  flags:  -Z----
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZA6_dddd_imm4()
 {
 	GET_BIT(OP0);
@@ -5655,6 +6097,7 @@ void z8002_device::ZA6_dddd_imm4()
  bit     rd,imm4
  flags:  -Z----
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZA7_dddd_imm4()
 {
 	GET_BIT(OP0);
@@ -5666,6 +6109,7 @@ void z8002_device::ZA7_dddd_imm4()
  incb    rbd,imm4m1
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZA8_dddd_imm4m1()
 {
 	GET_I4M1(OP0,NIB3);
@@ -5677,6 +6121,7 @@ void z8002_device::ZA8_dddd_imm4m1()
  inc     rd,imm4m1
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZA9_dddd_imm4m1()
 {
 	GET_I4M1(OP0,NIB3);
@@ -5688,6 +6133,7 @@ void z8002_device::ZA9_dddd_imm4m1()
  decb    rbd,imm4m1
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZAA_dddd_imm4m1()
 {
 	GET_I4M1(OP0,NIB3);
@@ -5699,6 +6145,7 @@ void z8002_device::ZAA_dddd_imm4m1()
  dec     rd,imm4m1
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZAB_dddd_imm4m1()
 {
 	GET_I4M1(OP0,NIB3);
@@ -5710,6 +6157,7 @@ void z8002_device::ZAB_dddd_imm4m1()
  exb     rbd,rbs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZAC_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5723,6 +6171,7 @@ void z8002_device::ZAC_ssss_dddd()
  ex      rd,rs
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZAD_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -5736,6 +6185,7 @@ void z8002_device::ZAD_ssss_dddd()
  tccb    cc,rbd
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZAE_dddd_cccc()
 {
 	GET_CCC(OP0,NIB3);
@@ -5766,6 +6216,7 @@ void z8002_device::ZAE_dddd_cccc()
  tcc     cc,rd
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZAF_dddd_cccc()
 {
 	GET_CCC(OP0,NIB3);
@@ -5796,18 +6247,16 @@ void z8002_device::ZAF_dddd_cccc()
  dab     rbd
  flags:  CZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB0_dddd_0000()
 {
 	GET_DST(OP0,NIB2);
-	uint8_t result;
-	uint16_t idx = RB(dst);
-	if (m_fcw & F_C)    idx |= 0x100;
-	if (m_fcw & F_H)    idx |= 0x200;
-	if (m_fcw & F_DA) idx |= 0x400;
-	result = Z8000_dab[idx];
-	CLR_CZS;
-	CHK_XXXB_ZS;
-	if (Z8000_dab[idx] & 0x100) SET_C;
+	const uint8_t dest = RB(dst);
+	const uint16_t fcw = FCW_FLAGS;
+	const dab_rule &rule = z8000_dab[((fcw & F_C) >> 4) | ((fcw & (F_DA|F_H)) >> 1) | ((dest & 0x0f) >= 0x0a)];
+	const unsigned carry = dest >= rule.carry_from;
+	const uint8_t result = dest + rule.adjust[carry];
+	FLAGS_RMW = (fcw & ~(F_C|F_Z|F_S)) | (carry * F_C) | (z8000_zsp[result] & (F_Z|F_S));
 	RB(dst) = result;
 }
 
@@ -5815,6 +6264,7 @@ void z8002_device::ZB0_dddd_0000()
  extsb   rd
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB1_dddd_0000()
 {
 	GET_DST(OP0,NIB2);
@@ -5825,6 +6275,7 @@ void z8002_device::ZB1_dddd_0000()
  extsl   rqd
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB1_dddd_0111()
 {
 	GET_DST(OP0,NIB2);
@@ -5835,6 +6286,7 @@ void z8002_device::ZB1_dddd_0111()
  exts    rrd
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB1_dddd_1010()
 {
 	GET_DST(OP0,NIB2);
@@ -5847,6 +6299,7 @@ void z8002_device::ZB1_dddd_1010()
  srlb    rbd,imm8
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB2_dddd_0001_imm8()
 {
 	GET_DST(OP0,NIB2);
@@ -5861,6 +6314,7 @@ void z8002_device::ZB2_dddd_0001_imm8()
  sdlb    rbd,rs
  flags:  CZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB2_dddd_0011_0000_ssss_0000_0000()
 {
 	GET_DST(OP0,NIB2);
@@ -5872,6 +6326,7 @@ void z8002_device::ZB2_dddd_0011_0000_ssss_0000_0000()
  rlb     rbd,imm1or2
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB2_dddd_00I0()
 {
 	GET_DST(OP0,NIB2);
@@ -5883,6 +6338,7 @@ void z8002_device::ZB2_dddd_00I0()
  rrb     rbd,imm1or2
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB2_dddd_01I0()
 {
 	GET_DST(OP0,NIB2);
@@ -5896,6 +6352,7 @@ void z8002_device::ZB2_dddd_01I0()
  srab    rbd,imm8
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB2_dddd_1001_imm8()
 {
 	GET_DST(OP0,NIB2);
@@ -5910,6 +6367,7 @@ void z8002_device::ZB2_dddd_1001_imm8()
  sdab    rbd,rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB2_dddd_1011_0000_ssss_0000_0000()
 {
 	GET_DST(OP0,NIB2);
@@ -5921,6 +6379,7 @@ void z8002_device::ZB2_dddd_1011_0000_ssss_0000_0000()
  rlcb    rbd,imm1or2
  flags:  -Z----
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB2_dddd_10I0()
 {
 	GET_DST(OP0,NIB2);
@@ -5932,6 +6391,7 @@ void z8002_device::ZB2_dddd_10I0()
  rrcb    rbd,imm1or2
  flags:  -Z----
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB2_dddd_11I0()
 {
 	GET_DST(OP0,NIB2);
@@ -5945,6 +6405,7 @@ void z8002_device::ZB2_dddd_11I0()
  srl     rd,imm8
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB3_dddd_0001_imm8()
 {
 	GET_DST(OP0,NIB2);
@@ -5959,6 +6420,7 @@ void z8002_device::ZB3_dddd_0001_imm8()
  sdl     rd,rs
  flags:  CZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB3_dddd_0011_0000_ssss_0000_0000()
 {
 	GET_DST(OP0,NIB2);
@@ -5970,6 +6432,7 @@ void z8002_device::ZB3_dddd_0011_0000_ssss_0000_0000()
  rl      rd,imm1or2
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB3_dddd_00I0()
 {
 	GET_DST(OP0,NIB2);
@@ -5983,6 +6446,7 @@ void z8002_device::ZB3_dddd_00I0()
  srll    rrd,imm8
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB3_dddd_0101_imm8()
 {
 	GET_DST(OP0,NIB2);
@@ -5997,6 +6461,7 @@ void z8002_device::ZB3_dddd_0101_imm8()
  sdll    rrd,rs
  flags:  CZS---
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB3_dddd_0111_0000_ssss_0000_0000()
 {
 	GET_DST(OP0,NIB2);
@@ -6008,6 +6473,7 @@ void z8002_device::ZB3_dddd_0111_0000_ssss_0000_0000()
  rr      rd,imm1or2
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB3_dddd_01I0()
 {
 	GET_DST(OP0,NIB2);
@@ -6021,6 +6487,7 @@ void z8002_device::ZB3_dddd_01I0()
  sra     rd,imm8
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB3_dddd_1001_imm8()
 {
 	GET_DST(OP0,NIB2);
@@ -6035,6 +6502,7 @@ void z8002_device::ZB3_dddd_1001_imm8()
  sda     rd,rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB3_dddd_1011_0000_ssss_0000_0000()
 {
 	GET_DST(OP0,NIB2);
@@ -6046,6 +6514,7 @@ void z8002_device::ZB3_dddd_1011_0000_ssss_0000_0000()
  rlc     rd,imm1or2
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB3_dddd_10I0()
 {
 	GET_DST(OP0,NIB2);
@@ -6059,6 +6528,7 @@ void z8002_device::ZB3_dddd_10I0()
  sral    rrd,imm8
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB3_dddd_1101_imm8()
 {
 	GET_DST(OP0,NIB2);
@@ -6073,6 +6543,7 @@ void z8002_device::ZB3_dddd_1101_imm8()
  sdal    rrd,rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB3_dddd_1111_0000_ssss_0000_0000()
 {
 	GET_DST(OP0,NIB2);
@@ -6084,6 +6555,7 @@ void z8002_device::ZB3_dddd_1111_0000_ssss_0000_0000()
  rrc     rd,imm1or2
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB3_dddd_11I0()
 {
 	GET_DST(OP0,NIB2);
@@ -6095,6 +6567,7 @@ void z8002_device::ZB3_dddd_11I0()
  adcb    rbd,rbs
  flags:  CZSVDH
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB4_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -6106,6 +6579,7 @@ void z8002_device::ZB4_ssss_dddd()
  adc     rd,rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB5_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -6117,6 +6591,7 @@ void z8002_device::ZB5_ssss_dddd()
  sbcb    rbd,rbs
  flags:  CZSVDH
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB6_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -6128,6 +6603,7 @@ void z8002_device::ZB6_ssss_dddd()
  sbc     rd,rs
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB7_ssss_dddd()
 {
 	GET_DST(OP0,NIB3);
@@ -6139,14 +6615,15 @@ void z8002_device::ZB7_ssss_dddd()
  trtib   @rd,@rs,rr
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB8_ddN0_0010_0000_rrrr_ssN0_0000()
 {
 	GET_DST(OP0,NIB2);
 	GET_SRC(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	uint8_t xlt = RDBX_B(src, RDIR_B(dst));
+	uint8_t xlt = RDBX_B<Z8001>(src, RDIR_B<Z8001>(dst));
 	if (xlt) CLR_Z; else SET_Z;
-	add_to_addr_reg(dst, 1);
+	add_to_addr_reg<Z8001>(dst, 1);
 	if (--RW(cnt)) CLR_V; else SET_V;
 	RB(1) = xlt;  /* load RH1 - must be last, after addr update */
 }
@@ -6155,35 +6632,39 @@ void z8002_device::ZB8_ddN0_0010_0000_rrrr_ssN0_0000()
  trtirb  @rd,@rs,rbr
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB8_ddN0_0110_0000_rrrr_ssN0_1110()
 {
 	GET_DST(OP0,NIB2);
 	GET_SRC(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	uint8_t xlt = RDBX_B(src, RDIR_B(dst));
-	if (xlt) CLR_Z; else SET_Z;
-	add_to_addr_reg(dst, 1);
-	if (--RW(cnt)) {
-		CLR_V;
-		if (!xlt)
-		m_pc -= 4;
-	}
-	else SET_V;
-	RB(1) = xlt;  /* load RH1 - must be last, after addr update */
+	do {
+		uint8_t xlt = RDBX_B<Z8001>(src, RDIR_B<Z8001>(dst));
+		if (xlt) CLR_Z; else SET_Z;
+		add_to_addr_reg<Z8001>(dst, 1);
+		if (--RW(cnt)) {
+			CLR_V;
+			if (!xlt)
+			m_pc -= 4;
+		}
+		else SET_V;
+		RB(1) = xlt;  /* load RH1 - must be last, after addr update */
+	} while (repeat_next());
 }
 
 /******************************************
  trtdb   @rd,@rs,rbr
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB8_ddN0_1010_0000_rrrr_ssN0_0000()
 {
 	GET_DST(OP0,NIB2);
 	GET_SRC(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	uint8_t xlt = RDBX_B(src, RDIR_B(dst));
+	uint8_t xlt = RDBX_B<Z8001>(src, RDIR_B<Z8001>(dst));
 	if (xlt) CLR_Z; else SET_Z;
-	sub_from_addr_reg(dst, 1);
+	sub_from_addr_reg<Z8001>(dst, 1);
 	if (--RW(cnt)) CLR_V; else SET_V;
 	RB(1) = xlt;  /* load RH1 - must be last, after addr update */
 }
@@ -6192,37 +6673,41 @@ void z8002_device::ZB8_ddN0_1010_0000_rrrr_ssN0_0000()
  trtdrb  @rd,@rs,rbr
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB8_ddN0_1110_0000_rrrr_ssN0_1110()
 {
 	GET_DST(OP0,NIB2);
 	GET_SRC(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	uint8_t xlt = RDBX_B(src, RDIR_B(dst));
-	if (xlt) CLR_Z; else SET_Z;
-	sub_from_addr_reg(dst, 1);
-	if (--RW(cnt)) {
-		CLR_V;
-		if (!xlt)
-		m_pc -= 4;
-	}
-	else SET_V;
-	RB(1) = xlt;  /* load RH1 - must be last, after addr update */
+	do {
+		uint8_t xlt = RDBX_B<Z8001>(src, RDIR_B<Z8001>(dst));
+		if (xlt) CLR_Z; else SET_Z;
+		sub_from_addr_reg<Z8001>(dst, 1);
+		if (--RW(cnt)) {
+			CLR_V;
+			if (!xlt)
+			m_pc -= 4;
+		}
+		else SET_V;
+		RB(1) = xlt;  /* load RH1 - must be last, after addr update */
+	} while (repeat_next());
 }
 
 /******************************************
  trib    @rd,@rs,rbr
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB8_ddN0_0000_0000_rrrr_ssN0_0000()
 {
 	GET_DST(OP0,NIB2);
 	GET_SRC(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
 	mem_specific &dstspace = dst == SP ? m_stack : m_data;
-	uint32_t dstaddr = addr_from_reg(dst);
-	uint8_t xlt = RDBX_B(src, RDMEM_B(dstspace, dstaddr));
-	WRMEM_B(dstspace, dstaddr, xlt);
-	add_to_addr_reg(dst, 1);
+	uint32_t dstaddr = addr_from_reg<Z8001>(dst);
+	uint8_t xlt = RDBX_B<Z8001>(src, RDMEM_B<Z8001>(dstspace, dstaddr));
+	WRMEM_B<Z8001>(dstspace, dstaddr, xlt);
+	add_to_addr_reg<Z8001>(dst, 1);
 	if (--RW(cnt)) CLR_V; else SET_V;
 	RB(1) = xlt;  /* destroy RH1 - must be last, after addr update */
 }
@@ -6231,34 +6716,38 @@ void z8002_device::ZB8_ddN0_0000_0000_rrrr_ssN0_0000()
  trirb   @rd,@rs,rbr
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB8_ddN0_0100_0000_rrrr_ssN0_0000()
 {
 	GET_DST(OP0,NIB2);
 	GET_SRC(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	mem_specific &dstspace = dst == SP ? m_stack : m_data;
-	uint32_t dstaddr = addr_from_reg(dst);
-	uint8_t xlt = RDBX_B(src, RDMEM_B(dstspace, dstaddr));
-	WRMEM_B(dstspace, dstaddr, xlt);
-	add_to_addr_reg(dst, 1);
-	if (--RW(cnt)) { CLR_V; m_pc -= 4; } else SET_V;
-	RB(1) = xlt;  /* destroy RH1 - must be last, after addr update */
+	do {
+		mem_specific &dstspace = dst == SP ? m_stack : m_data;
+		uint32_t dstaddr = addr_from_reg<Z8001>(dst);
+		uint8_t xlt = RDBX_B<Z8001>(src, RDMEM_B<Z8001>(dstspace, dstaddr));
+		WRMEM_B<Z8001>(dstspace, dstaddr, xlt);
+		add_to_addr_reg<Z8001>(dst, 1);
+		if (--RW(cnt)) { CLR_V; m_pc -= 4; } else SET_V;
+		RB(1) = xlt;  /* destroy RH1 - must be last, after addr update */
+	} while (repeat_next());
 }
 
 /******************************************
  trdb    @rd,@rs,rbr
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB8_ddN0_1000_0000_rrrr_ssN0_0000()
 {
 	GET_DST(OP0,NIB2);
 	GET_SRC(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
 	mem_specific &dstspace = dst == SP ? m_stack : m_data;
-	uint32_t dstaddr = addr_from_reg(dst);
-	uint8_t xlt = RDBX_B(src, RDMEM_B(dstspace, dstaddr));
-	WRMEM_B(dstspace, dstaddr, xlt);
-	sub_from_addr_reg(dst, 1);
+	uint32_t dstaddr = addr_from_reg<Z8001>(dst);
+	uint8_t xlt = RDBX_B<Z8001>(src, RDMEM_B<Z8001>(dstspace, dstaddr));
+	WRMEM_B<Z8001>(dstspace, dstaddr, xlt);
+	sub_from_addr_reg<Z8001>(dst, 1);
 	if (--RW(cnt)) CLR_V; else SET_V;
 	RB(1) = xlt;  /* destroy RH1 - must be last, after addr update */
 }
@@ -6267,24 +6756,28 @@ void z8002_device::ZB8_ddN0_1000_0000_rrrr_ssN0_0000()
  trdrb   @rd,@rs,rbr
  flags:  -ZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB8_ddN0_1100_0000_rrrr_ssN0_0000()
 {
 	GET_DST(OP0,NIB2);
 	GET_SRC(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	mem_specific &dstspace = dst == SP ? m_stack : m_data;
-	uint32_t dstaddr = addr_from_reg(dst);
-	uint8_t xlt = RDBX_B(src, RDMEM_B(dstspace, dstaddr));
-	WRMEM_B(dstspace, dstaddr, xlt);
-	sub_from_addr_reg(dst, 1);
-	if (--RW(cnt)) { CLR_V; m_pc -= 4; } else SET_V;
-	RB(1) = xlt;  /* destroy RH1 - must be last, after addr update */
+	do {
+		mem_specific &dstspace = dst == SP ? m_stack : m_data;
+		uint32_t dstaddr = addr_from_reg<Z8001>(dst);
+		uint8_t xlt = RDBX_B<Z8001>(src, RDMEM_B<Z8001>(dstspace, dstaddr));
+		WRMEM_B<Z8001>(dstspace, dstaddr, xlt);
+		sub_from_addr_reg<Z8001>(dst, 1);
+		if (--RW(cnt)) { CLR_V; m_pc -= 4; } else SET_V;
+		RB(1) = xlt;  /* destroy RH1 - must be last, after addr update */
+	} while (repeat_next());
 }
 
 /******************************************
  rsvdb9
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZB9_imm8()
 {
 	GET_IMM8(0);
@@ -6300,13 +6793,14 @@ void z8002_device::ZB9_imm8()
  cpib    rbd,@rs,rr,cc
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBA_ssN0_0000_0000_rrrr_dddd_cccc()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CCC(OP1,NIB3);
 	GET_DST(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	CPB(RB(dst), RDIR_B(src));
+	CPB(RB(dst), RDIR_B<Z8001>(src));
 	switch (cc) {
 		case  0: if (CC0) SET_Z; else CLR_Z; break;
 		case  1: if (CC1) SET_Z; else CLR_Z; break;
@@ -6325,7 +6819,7 @@ void z8002_device::ZBA_ssN0_0000_0000_rrrr_dddd_cccc()
 		case 14: if (CCE) SET_Z; else CLR_Z; break;
 		case 15: if (CCF) SET_Z; else CLR_Z; break;
 	}
-	add_to_addr_reg(src, 1);
+	add_to_addr_reg<Z8001>(src, 1);
 	if (--RW(cnt)) CLR_V; else SET_V;
 }
 
@@ -6334,29 +6828,34 @@ void z8002_device::ZBA_ssN0_0000_0000_rrrr_dddd_cccc()
  ldibr   @rd,@rs,rr
  flags:  ---V--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBA_ssN0_0001_0000_rrrr_ddN0_x000()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);  /* repeat? */
-	WRIR_B(dst, RDIR_B(src));
-	add_to_addr_reg(src, 1);
-	add_to_addr_reg(dst, 1);
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_move<Z8001>(dst, src, cnt, 1);
+		WRIR_B<Z8001>(dst, RDIR_B<Z8001>(src));
+		add_to_addr_reg<Z8001>(src, 1);
+		add_to_addr_reg<Z8001>(dst, 1);
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
  cpsib   @rd,@rs,rr,cc
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBA_ssN0_0010_0000_rrrr_ddN0_cccc()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CCC(OP1,NIB3);
 	GET_DST(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	CPB(RDIR_B(dst), RDIR_B(src));
+	CPB(RDIR_B<Z8001>(dst), RDIR_B<Z8001>(src));
 	switch (cc) {
 		case  0: if (CC0) SET_Z; else CLR_Z; break;
 		case  1: if (CC1) SET_Z; else CLR_Z; break;
@@ -6375,8 +6874,8 @@ void z8002_device::ZBA_ssN0_0010_0000_rrrr_ddN0_cccc()
 		case 14: if (CCE) SET_Z; else CLR_Z; break;
 		case 15: if (CCF) SET_Z; else CLR_Z; break;
 	}
-	add_to_addr_reg(src, 1);
-	add_to_addr_reg(dst, 1);
+	add_to_addr_reg<Z8001>(src, 1);
+	add_to_addr_reg<Z8001>(dst, 1);
 	if (--RW(cnt)) CLR_V; else SET_V;
 }
 
@@ -6384,80 +6883,89 @@ void z8002_device::ZBA_ssN0_0010_0000_rrrr_ddN0_cccc()
  cpirb   rbd,@rs,rr,cc
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBA_ssN0_0100_0000_rrrr_dddd_cccc()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CCC(OP1,NIB3);
 	GET_DST(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	CPB(RB(dst), RDIR_B(src));
-	switch (cc) {
-		case  0: if (CC0) SET_Z; else CLR_Z; break;
-		case  1: if (CC1) SET_Z; else CLR_Z; break;
-		case  2: if (CC2) SET_Z; else CLR_Z; break;
-		case  3: if (CC3) SET_Z; else CLR_Z; break;
-		case  4: if (CC4) SET_Z; else CLR_Z; break;
-		case  5: if (CC5) SET_Z; else CLR_Z; break;
-		case  6: if (CC6) SET_Z; else CLR_Z; break;
-		case  7: if (CC7) SET_Z; else CLR_Z; break;
-		case  8: if (CC8) SET_Z; else CLR_Z; break;
-		case  9: if (CC9) SET_Z; else CLR_Z; break;
-		case 10: if (CCA) SET_Z; else CLR_Z; break;
-		case 11: if (CCB) SET_Z; else CLR_Z; break;
-		case 12: if (CCC) SET_Z; else CLR_Z; break;
-		case 13: if (CCD) SET_Z; else CLR_Z; break;
-		case 14: if (CCE) SET_Z; else CLR_Z; break;
-		case 15: if (CCF) SET_Z; else CLR_Z; break;
-	}
-	add_to_addr_reg(src, 1);
-	if (--RW(cnt)) { CLR_V; if (!(m_fcw & F_Z)) m_pc -= 4; } else SET_V;
+	do {
+		repeat_compare<Z8001>(dst, false, src, cnt, 1, cc);
+		CPB(RB(dst), RDIR_B<Z8001>(src));
+		switch (cc) {
+			case  0: if (CC0) SET_Z; else CLR_Z; break;
+			case  1: if (CC1) SET_Z; else CLR_Z; break;
+			case  2: if (CC2) SET_Z; else CLR_Z; break;
+			case  3: if (CC3) SET_Z; else CLR_Z; break;
+			case  4: if (CC4) SET_Z; else CLR_Z; break;
+			case  5: if (CC5) SET_Z; else CLR_Z; break;
+			case  6: if (CC6) SET_Z; else CLR_Z; break;
+			case  7: if (CC7) SET_Z; else CLR_Z; break;
+			case  8: if (CC8) SET_Z; else CLR_Z; break;
+			case  9: if (CC9) SET_Z; else CLR_Z; break;
+			case 10: if (CCA) SET_Z; else CLR_Z; break;
+			case 11: if (CCB) SET_Z; else CLR_Z; break;
+			case 12: if (CCC) SET_Z; else CLR_Z; break;
+			case 13: if (CCD) SET_Z; else CLR_Z; break;
+			case 14: if (CCE) SET_Z; else CLR_Z; break;
+			case 15: if (CCF) SET_Z; else CLR_Z; break;
+		}
+		add_to_addr_reg<Z8001>(src, 1);
+		if (--RW(cnt)) { CLR_V; if (!GET_Z) m_pc -= 4; } else SET_V;
+	} while (repeat_next());
 }
 
 /******************************************
  cpsirb  @rd,@rs,rr,cc
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBA_ssN0_0110_0000_rrrr_ddN0_cccc()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CCC(OP1,NIB3);
 	GET_DST(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	CPB(RDIR_B(dst), RDIR_B(src));
-	switch (cc) {
-		case  0: if (CC0) SET_Z; else CLR_Z; break;
-		case  1: if (CC1) SET_Z; else CLR_Z; break;
-		case  2: if (CC2) SET_Z; else CLR_Z; break;
-		case  3: if (CC3) SET_Z; else CLR_Z; break;
-		case  4: if (CC4) SET_Z; else CLR_Z; break;
-		case  5: if (CC5) SET_Z; else CLR_Z; break;
-		case  6: if (CC6) SET_Z; else CLR_Z; break;
-		case  7: if (CC7) SET_Z; else CLR_Z; break;
-		case  8: if (CC8) SET_Z; else CLR_Z; break;
-		case  9: if (CC9) SET_Z; else CLR_Z; break;
-		case 10: if (CCA) SET_Z; else CLR_Z; break;
-		case 11: if (CCB) SET_Z; else CLR_Z; break;
-		case 12: if (CCC) SET_Z; else CLR_Z; break;
-		case 13: if (CCD) SET_Z; else CLR_Z; break;
-		case 14: if (CCE) SET_Z; else CLR_Z; break;
-		case 15: if (CCF) SET_Z; else CLR_Z; break;
-	}
-	add_to_addr_reg(src, 1);
-	add_to_addr_reg(dst, 1);
-	if (--RW(cnt)) { CLR_V; if (!(m_fcw & F_Z)) m_pc -= 4; } else SET_V;
+	do {
+		repeat_compare<Z8001>(dst, true, src, cnt, 1, cc);
+		CPB(RDIR_B<Z8001>(dst), RDIR_B<Z8001>(src));
+		switch (cc) {
+			case  0: if (CC0) SET_Z; else CLR_Z; break;
+			case  1: if (CC1) SET_Z; else CLR_Z; break;
+			case  2: if (CC2) SET_Z; else CLR_Z; break;
+			case  3: if (CC3) SET_Z; else CLR_Z; break;
+			case  4: if (CC4) SET_Z; else CLR_Z; break;
+			case  5: if (CC5) SET_Z; else CLR_Z; break;
+			case  6: if (CC6) SET_Z; else CLR_Z; break;
+			case  7: if (CC7) SET_Z; else CLR_Z; break;
+			case  8: if (CC8) SET_Z; else CLR_Z; break;
+			case  9: if (CC9) SET_Z; else CLR_Z; break;
+			case 10: if (CCA) SET_Z; else CLR_Z; break;
+			case 11: if (CCB) SET_Z; else CLR_Z; break;
+			case 12: if (CCC) SET_Z; else CLR_Z; break;
+			case 13: if (CCD) SET_Z; else CLR_Z; break;
+			case 14: if (CCE) SET_Z; else CLR_Z; break;
+			case 15: if (CCF) SET_Z; else CLR_Z; break;
+		}
+		add_to_addr_reg<Z8001>(src, 1);
+		add_to_addr_reg<Z8001>(dst, 1);
+		if (--RW(cnt)) { CLR_V; if (!GET_Z) m_pc -= 4; } else SET_V;
+	} while (repeat_next());
 }
 
 /******************************************
  cpdb    rbd,@rs,rr,cc
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBA_ssN0_1000_0000_rrrr_dddd_cccc()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CCC(OP1,NIB3);
 	GET_DST(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	CPB(RB(dst), RDIR_B(src));
+	CPB(RB(dst), RDIR_B<Z8001>(src));
 	switch (cc) {
 		case  0: if (CC0) SET_Z; else CLR_Z; break;
 		case  1: if (CC1) SET_Z; else CLR_Z; break;
@@ -6476,7 +6984,7 @@ void z8002_device::ZBA_ssN0_1000_0000_rrrr_dddd_cccc()
 		case 14: if (CCE) SET_Z; else CLR_Z; break;
 		case 15: if (CCF) SET_Z; else CLR_Z; break;
 	}
-	sub_from_addr_reg(src, 1);
+	sub_from_addr_reg<Z8001>(src, 1);
 	if (--RW(cnt)) CLR_V; else SET_V;
 }
 
@@ -6485,29 +6993,34 @@ void z8002_device::ZBA_ssN0_1000_0000_rrrr_dddd_cccc()
  lddbr   @rs,@rd,rr
  flags:  ---V--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBA_ssN0_1001_0000_rrrr_ddN0_x000()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);
-	WRIR_B(dst, RDIR_B(src));
-	sub_from_addr_reg(src, 1);
-	sub_from_addr_reg(dst, 1);
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_move<Z8001>(dst, src, cnt, -1);
+		WRIR_B<Z8001>(dst, RDIR_B<Z8001>(src));
+		sub_from_addr_reg<Z8001>(src, 1);
+		sub_from_addr_reg<Z8001>(dst, 1);
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
  cpsdb   @rd,@rs,rr,cc
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBA_ssN0_1010_0000_rrrr_ddN0_cccc()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CCC(OP1,NIB3);
 	GET_DST(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	CPB(RDIR_B(dst), RDIR_B(src));
+	CPB(RDIR_B<Z8001>(dst), RDIR_B<Z8001>(src));
 	switch (cc) {
 		case  0: if (CC0) SET_Z; else CLR_Z; break;
 		case  1: if (CC1) SET_Z; else CLR_Z; break;
@@ -6526,8 +7039,8 @@ void z8002_device::ZBA_ssN0_1010_0000_rrrr_ddN0_cccc()
 		case 14: if (CCE) SET_Z; else CLR_Z; break;
 		case 15: if (CCF) SET_Z; else CLR_Z; break;
 	}
-	sub_from_addr_reg(src, 1);
-	sub_from_addr_reg(dst, 1);
+	sub_from_addr_reg<Z8001>(src, 1);
+	sub_from_addr_reg<Z8001>(dst, 1);
 	if (--RW(cnt)) CLR_V; else SET_V;
 }
 
@@ -6535,80 +7048,89 @@ void z8002_device::ZBA_ssN0_1010_0000_rrrr_ddN0_cccc()
  cpdrb   rbd,@rs,rr,cc
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBA_ssN0_1100_0000_rrrr_dddd_cccc()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CCC(OP1,NIB3);
 	GET_DST(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	CPB(RB(dst), RDIR_B(src));
-	switch (cc) {
-		case  0: if (CC0) SET_Z; else CLR_Z; break;
-		case  1: if (CC1) SET_Z; else CLR_Z; break;
-		case  2: if (CC2) SET_Z; else CLR_Z; break;
-		case  3: if (CC3) SET_Z; else CLR_Z; break;
-		case  4: if (CC4) SET_Z; else CLR_Z; break;
-		case  5: if (CC5) SET_Z; else CLR_Z; break;
-		case  6: if (CC6) SET_Z; else CLR_Z; break;
-		case  7: if (CC7) SET_Z; else CLR_Z; break;
-		case  8: if (CC8) SET_Z; else CLR_Z; break;
-		case  9: if (CC9) SET_Z; else CLR_Z; break;
-		case 10: if (CCA) SET_Z; else CLR_Z; break;
-		case 11: if (CCB) SET_Z; else CLR_Z; break;
-		case 12: if (CCC) SET_Z; else CLR_Z; break;
-		case 13: if (CCD) SET_Z; else CLR_Z; break;
-		case 14: if (CCE) SET_Z; else CLR_Z; break;
-		case 15: if (CCF) SET_Z; else CLR_Z; break;
-	}
-	sub_from_addr_reg(src, 1);
-	if (--RW(cnt)) { CLR_V; if (!(m_fcw & F_Z)) m_pc -= 4; } else SET_V;
+	do {
+		repeat_compare<Z8001>(dst, false, src, cnt, -1, cc);
+		CPB(RB(dst), RDIR_B<Z8001>(src));
+		switch (cc) {
+			case  0: if (CC0) SET_Z; else CLR_Z; break;
+			case  1: if (CC1) SET_Z; else CLR_Z; break;
+			case  2: if (CC2) SET_Z; else CLR_Z; break;
+			case  3: if (CC3) SET_Z; else CLR_Z; break;
+			case  4: if (CC4) SET_Z; else CLR_Z; break;
+			case  5: if (CC5) SET_Z; else CLR_Z; break;
+			case  6: if (CC6) SET_Z; else CLR_Z; break;
+			case  7: if (CC7) SET_Z; else CLR_Z; break;
+			case  8: if (CC8) SET_Z; else CLR_Z; break;
+			case  9: if (CC9) SET_Z; else CLR_Z; break;
+			case 10: if (CCA) SET_Z; else CLR_Z; break;
+			case 11: if (CCB) SET_Z; else CLR_Z; break;
+			case 12: if (CCC) SET_Z; else CLR_Z; break;
+			case 13: if (CCD) SET_Z; else CLR_Z; break;
+			case 14: if (CCE) SET_Z; else CLR_Z; break;
+			case 15: if (CCF) SET_Z; else CLR_Z; break;
+		}
+		sub_from_addr_reg<Z8001>(src, 1);
+		if (--RW(cnt)) { CLR_V; if (!GET_Z) m_pc -= 4; } else SET_V;
+	} while (repeat_next());
 }
 
 /******************************************
  cpsdrb  @rd,@rs,rr,cc
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBA_ssN0_1110_0000_rrrr_ddN0_cccc()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CCC(OP1,NIB3);
 	GET_DST(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	CPB(RDIR_B(dst), RDIR_B(src));
-	switch (cc) {
-		case  0: if (CC0) SET_Z; else CLR_Z; break;
-		case  1: if (CC1) SET_Z; else CLR_Z; break;
-		case  2: if (CC2) SET_Z; else CLR_Z; break;
-		case  3: if (CC3) SET_Z; else CLR_Z; break;
-		case  4: if (CC4) SET_Z; else CLR_Z; break;
-		case  5: if (CC5) SET_Z; else CLR_Z; break;
-		case  6: if (CC6) SET_Z; else CLR_Z; break;
-		case  7: if (CC7) SET_Z; else CLR_Z; break;
-		case  8: if (CC8) SET_Z; else CLR_Z; break;
-		case  9: if (CC9) SET_Z; else CLR_Z; break;
-		case 10: if (CCA) SET_Z; else CLR_Z; break;
-		case 11: if (CCB) SET_Z; else CLR_Z; break;
-		case 12: if (CCC) SET_Z; else CLR_Z; break;
-		case 13: if (CCD) SET_Z; else CLR_Z; break;
-		case 14: if (CCE) SET_Z; else CLR_Z; break;
-		case 15: if (CCF) SET_Z; else CLR_Z; break;
-	}
-	sub_from_addr_reg(src, 1);
-	sub_from_addr_reg(dst, 1);
-	if (--RW(cnt)) { CLR_V; if (!(m_fcw & F_Z)) m_pc -= 4; } else SET_V;
+	do {
+		repeat_compare<Z8001>(dst, true, src, cnt, -1, cc);
+		CPB(RDIR_B<Z8001>(dst), RDIR_B<Z8001>(src));
+		switch (cc) {
+			case  0: if (CC0) SET_Z; else CLR_Z; break;
+			case  1: if (CC1) SET_Z; else CLR_Z; break;
+			case  2: if (CC2) SET_Z; else CLR_Z; break;
+			case  3: if (CC3) SET_Z; else CLR_Z; break;
+			case  4: if (CC4) SET_Z; else CLR_Z; break;
+			case  5: if (CC5) SET_Z; else CLR_Z; break;
+			case  6: if (CC6) SET_Z; else CLR_Z; break;
+			case  7: if (CC7) SET_Z; else CLR_Z; break;
+			case  8: if (CC8) SET_Z; else CLR_Z; break;
+			case  9: if (CC9) SET_Z; else CLR_Z; break;
+			case 10: if (CCA) SET_Z; else CLR_Z; break;
+			case 11: if (CCB) SET_Z; else CLR_Z; break;
+			case 12: if (CCC) SET_Z; else CLR_Z; break;
+			case 13: if (CCD) SET_Z; else CLR_Z; break;
+			case 14: if (CCE) SET_Z; else CLR_Z; break;
+			case 15: if (CCF) SET_Z; else CLR_Z; break;
+		}
+		sub_from_addr_reg<Z8001>(src, 1);
+		sub_from_addr_reg<Z8001>(dst, 1);
+		if (--RW(cnt)) { CLR_V; if (!GET_Z) m_pc -= 4; } else SET_V;
+	} while (repeat_next());
 }
 
 /******************************************
  cpi     rd,@rs,rr,cc
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBB_ssN0_0000_0000_rrrr_dddd_cccc()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CCC(OP1,NIB3);
 	GET_DST(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	CPW(RW(dst), RDIR_W(src));
+	CPW(RW(dst), RDIR_W<Z8001>(src));
 	switch (cc) {
 		case  0: if (CC0) SET_Z; else CLR_Z; break;
 		case  1: if (CC1) SET_Z; else CLR_Z; break;
@@ -6627,7 +7149,7 @@ void z8002_device::ZBB_ssN0_0000_0000_rrrr_dddd_cccc()
 		case 14: if (CCE) SET_Z; else CLR_Z; break;
 		case 15: if (CCF) SET_Z; else CLR_Z; break;
 	}
-	add_to_addr_reg(src, 2);
+	add_to_addr_reg<Z8001>(src, 2);
 	if (--RW(cnt)) CLR_V; else SET_V;
 }
 
@@ -6636,29 +7158,34 @@ void z8002_device::ZBB_ssN0_0000_0000_rrrr_dddd_cccc()
  ldir    @rd,@rs,rr
  flags:  ---V--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBB_ssN0_0001_0000_rrrr_ddN0_x000()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);
-	WRIR_W(dst, RDIR_W(src));
-	add_to_addr_reg(src, 2);
-	add_to_addr_reg(dst, 2);
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_move<Z8001>(dst, src, cnt, 2);
+		WRIR_W<Z8001>(dst, RDIR_W<Z8001>(src));
+		add_to_addr_reg<Z8001>(src, 2);
+		add_to_addr_reg<Z8001>(dst, 2);
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
  cpsi    @rd,@rs,rr,cc
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBB_ssN0_0010_0000_rrrr_ddN0_cccc()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CCC(OP1,NIB3);
 	GET_DST(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	CPW(RDIR_W(dst), RDIR_W(src));
+	CPW(RDIR_W<Z8001>(dst), RDIR_W<Z8001>(src));
 	switch (cc) {
 		case  0: if (CC0) SET_Z; else CLR_Z; break;
 		case  1: if (CC1) SET_Z; else CLR_Z; break;
@@ -6677,8 +7204,8 @@ void z8002_device::ZBB_ssN0_0010_0000_rrrr_ddN0_cccc()
 		case 14: if (CCE) SET_Z; else CLR_Z; break;
 		case 15: if (CCF) SET_Z; else CLR_Z; break;
 	}
-	add_to_addr_reg(src, 2);
-	add_to_addr_reg(dst, 2);
+	add_to_addr_reg<Z8001>(src, 2);
+	add_to_addr_reg<Z8001>(dst, 2);
 	if (--RW(cnt)) CLR_V; else SET_V;
 }
 
@@ -6686,80 +7213,89 @@ void z8002_device::ZBB_ssN0_0010_0000_rrrr_ddN0_cccc()
  cpir    rd,@rs,rr,cc
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBB_ssN0_0100_0000_rrrr_dddd_cccc()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CCC(OP1,NIB3);
 	GET_DST(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	CPW(RW(dst), RDIR_W(src));
-	switch (cc) {
-		case  0: if (CC0) SET_Z; else CLR_Z; break;
-		case  1: if (CC1) SET_Z; else CLR_Z; break;
-		case  2: if (CC2) SET_Z; else CLR_Z; break;
-		case  3: if (CC3) SET_Z; else CLR_Z; break;
-		case  4: if (CC4) SET_Z; else CLR_Z; break;
-		case  5: if (CC5) SET_Z; else CLR_Z; break;
-		case  6: if (CC6) SET_Z; else CLR_Z; break;
-		case  7: if (CC7) SET_Z; else CLR_Z; break;
-		case  8: if (CC8) SET_Z; else CLR_Z; break;
-		case  9: if (CC9) SET_Z; else CLR_Z; break;
-		case 10: if (CCA) SET_Z; else CLR_Z; break;
-		case 11: if (CCB) SET_Z; else CLR_Z; break;
-		case 12: if (CCC) SET_Z; else CLR_Z; break;
-		case 13: if (CCD) SET_Z; else CLR_Z; break;
-		case 14: if (CCE) SET_Z; else CLR_Z; break;
-		case 15: if (CCF) SET_Z; else CLR_Z; break;
-	}
-	add_to_addr_reg(src, 2);
-	if (--RW(cnt)) { CLR_V; if (!(m_fcw & F_Z)) m_pc -= 4; } else SET_V;
+	do {
+		repeat_compare<Z8001>(dst, false, src, cnt, 2, cc);
+		CPW(RW(dst), RDIR_W<Z8001>(src));
+		switch (cc) {
+			case  0: if (CC0) SET_Z; else CLR_Z; break;
+			case  1: if (CC1) SET_Z; else CLR_Z; break;
+			case  2: if (CC2) SET_Z; else CLR_Z; break;
+			case  3: if (CC3) SET_Z; else CLR_Z; break;
+			case  4: if (CC4) SET_Z; else CLR_Z; break;
+			case  5: if (CC5) SET_Z; else CLR_Z; break;
+			case  6: if (CC6) SET_Z; else CLR_Z; break;
+			case  7: if (CC7) SET_Z; else CLR_Z; break;
+			case  8: if (CC8) SET_Z; else CLR_Z; break;
+			case  9: if (CC9) SET_Z; else CLR_Z; break;
+			case 10: if (CCA) SET_Z; else CLR_Z; break;
+			case 11: if (CCB) SET_Z; else CLR_Z; break;
+			case 12: if (CCC) SET_Z; else CLR_Z; break;
+			case 13: if (CCD) SET_Z; else CLR_Z; break;
+			case 14: if (CCE) SET_Z; else CLR_Z; break;
+			case 15: if (CCF) SET_Z; else CLR_Z; break;
+		}
+		add_to_addr_reg<Z8001>(src, 2);
+		if (--RW(cnt)) { CLR_V; if (!GET_Z) m_pc -= 4; } else SET_V;
+	} while (repeat_next());
 }
 
 /******************************************
  cpsir   @rd,@rs,rr,cc
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBB_ssN0_0110_0000_rrrr_ddN0_cccc()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CCC(OP1,NIB3);
 	GET_DST(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	CPW(RDIR_W(dst), RDIR_W(src));
-	switch (cc) {
-		case  0: if (CC0) SET_Z; else CLR_Z; break;
-		case  1: if (CC1) SET_Z; else CLR_Z; break;
-		case  2: if (CC2) SET_Z; else CLR_Z; break;
-		case  3: if (CC3) SET_Z; else CLR_Z; break;
-		case  4: if (CC4) SET_Z; else CLR_Z; break;
-		case  5: if (CC5) SET_Z; else CLR_Z; break;
-		case  6: if (CC6) SET_Z; else CLR_Z; break;
-		case  7: if (CC7) SET_Z; else CLR_Z; break;
-		case  8: if (CC8) SET_Z; else CLR_Z; break;
-		case  9: if (CC9) SET_Z; else CLR_Z; break;
-		case 10: if (CCA) SET_Z; else CLR_Z; break;
-		case 11: if (CCB) SET_Z; else CLR_Z; break;
-		case 12: if (CCC) SET_Z; else CLR_Z; break;
-		case 13: if (CCD) SET_Z; else CLR_Z; break;
-		case 14: if (CCE) SET_Z; else CLR_Z; break;
-		case 15: if (CCF) SET_Z; else CLR_Z; break;
-	}
-	add_to_addr_reg(src, 2);
-	add_to_addr_reg(dst, 2);
-	if (--RW(cnt)) { CLR_V; if (!(m_fcw & F_Z)) m_pc -= 4; } else SET_V;
+	do {
+		repeat_compare<Z8001>(dst, true, src, cnt, 2, cc);
+		CPW(RDIR_W<Z8001>(dst), RDIR_W<Z8001>(src));
+		switch (cc) {
+			case  0: if (CC0) SET_Z; else CLR_Z; break;
+			case  1: if (CC1) SET_Z; else CLR_Z; break;
+			case  2: if (CC2) SET_Z; else CLR_Z; break;
+			case  3: if (CC3) SET_Z; else CLR_Z; break;
+			case  4: if (CC4) SET_Z; else CLR_Z; break;
+			case  5: if (CC5) SET_Z; else CLR_Z; break;
+			case  6: if (CC6) SET_Z; else CLR_Z; break;
+			case  7: if (CC7) SET_Z; else CLR_Z; break;
+			case  8: if (CC8) SET_Z; else CLR_Z; break;
+			case  9: if (CC9) SET_Z; else CLR_Z; break;
+			case 10: if (CCA) SET_Z; else CLR_Z; break;
+			case 11: if (CCB) SET_Z; else CLR_Z; break;
+			case 12: if (CCC) SET_Z; else CLR_Z; break;
+			case 13: if (CCD) SET_Z; else CLR_Z; break;
+			case 14: if (CCE) SET_Z; else CLR_Z; break;
+			case 15: if (CCF) SET_Z; else CLR_Z; break;
+		}
+		add_to_addr_reg<Z8001>(src, 2);
+		add_to_addr_reg<Z8001>(dst, 2);
+		if (--RW(cnt)) { CLR_V; if (!GET_Z) m_pc -= 4; } else SET_V;
+	} while (repeat_next());
 }
 
 /******************************************
  cpd     rd,@rs,rr,cc
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBB_ssN0_1000_0000_rrrr_dddd_cccc()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CCC(OP1,NIB3);
 	GET_DST(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	CPW(RW(dst), RDIR_W(src));
+	CPW(RW(dst), RDIR_W<Z8001>(src));
 	switch (cc) {
 		case  0: if (CC0) SET_Z; else CLR_Z; break;
 		case  1: if (CC1) SET_Z; else CLR_Z; break;
@@ -6778,7 +7314,7 @@ void z8002_device::ZBB_ssN0_1000_0000_rrrr_dddd_cccc()
 		case 14: if (CCE) SET_Z; else CLR_Z; break;
 		case 15: if (CCF) SET_Z; else CLR_Z; break;
 	}
-	sub_from_addr_reg(src, 2);
+	sub_from_addr_reg<Z8001>(src, 2);
 	if (--RW(cnt)) CLR_V; else SET_V;
 }
 
@@ -6787,29 +7323,34 @@ void z8002_device::ZBB_ssN0_1000_0000_rrrr_dddd_cccc()
  lddr    @rs,@rd,rr
  flags:  ---V--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBB_ssN0_1001_0000_rrrr_ddN0_x000()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CNT(OP1,NIB1);
 	GET_DST(OP1,NIB2);
 	GET_CCC(OP1,NIB3);
-	WRIR_W(dst, RDIR_W(src));
-	sub_from_addr_reg(src, 2);
-	sub_from_addr_reg(dst, 2);
-	if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	do {
+		if (cc == 0) repeat_move<Z8001>(dst, src, cnt, -2);
+		WRIR_W<Z8001>(dst, RDIR_W<Z8001>(src));
+		sub_from_addr_reg<Z8001>(src, 2);
+		sub_from_addr_reg<Z8001>(dst, 2);
+		if (--RW(cnt)) { CLR_V; CLR_Z; if (cc == 0) m_pc -= 4; } else { SET_V; SET_Z; }
+	} while (repeat_next());
 }
 
 /******************************************
  cpsd    @rd,@rs,rr,cc
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBB_ssN0_1010_0000_rrrr_ddN0_cccc()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CCC(OP1,NIB3);
 	GET_DST(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	CPW(RDIR_W(dst), RDIR_W(src));
+	CPW(RDIR_W<Z8001>(dst), RDIR_W<Z8001>(src));
 	switch (cc) {
 		case  0: if (CC0) SET_Z; else CLR_Z; break;
 		case  1: if (CC1) SET_Z; else CLR_Z; break;
@@ -6828,8 +7369,8 @@ void z8002_device::ZBB_ssN0_1010_0000_rrrr_ddN0_cccc()
 		case 14: if (CCE) SET_Z; else CLR_Z; break;
 		case 15: if (CCF) SET_Z; else CLR_Z; break;
 	}
-	sub_from_addr_reg(src, 2);
-	sub_from_addr_reg(dst, 2);
+	sub_from_addr_reg<Z8001>(src, 2);
+	sub_from_addr_reg<Z8001>(dst, 2);
 	if (--RW(cnt)) CLR_V; else SET_V;
 }
 
@@ -6837,73 +7378,82 @@ void z8002_device::ZBB_ssN0_1010_0000_rrrr_ddN0_cccc()
  cpdr    rd,@rs,rr,cc
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBB_ssN0_1100_0000_rrrr_dddd_cccc()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CCC(OP1,NIB3);
 	GET_DST(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	CPW(RW(dst), RDIR_W(src));
-	switch (cc) {
-		case  0: if (CC0) SET_Z; else CLR_Z; break;
-		case  1: if (CC1) SET_Z; else CLR_Z; break;
-		case  2: if (CC2) SET_Z; else CLR_Z; break;
-		case  3: if (CC3) SET_Z; else CLR_Z; break;
-		case  4: if (CC4) SET_Z; else CLR_Z; break;
-		case  5: if (CC5) SET_Z; else CLR_Z; break;
-		case  6: if (CC6) SET_Z; else CLR_Z; break;
-		case  7: if (CC7) SET_Z; else CLR_Z; break;
-		case  8: if (CC8) SET_Z; else CLR_Z; break;
-		case  9: if (CC9) SET_Z; else CLR_Z; break;
-		case 10: if (CCA) SET_Z; else CLR_Z; break;
-		case 11: if (CCB) SET_Z; else CLR_Z; break;
-		case 12: if (CCC) SET_Z; else CLR_Z; break;
-		case 13: if (CCD) SET_Z; else CLR_Z; break;
-		case 14: if (CCE) SET_Z; else CLR_Z; break;
-		case 15: if (CCF) SET_Z; else CLR_Z; break;
-	}
-	sub_from_addr_reg(src, 2);
-	if (--RW(cnt)) { CLR_V; if (!(m_fcw & F_Z)) m_pc -= 4; } else SET_V;
+	do {
+		repeat_compare<Z8001>(dst, false, src, cnt, -2, cc);
+		CPW(RW(dst), RDIR_W<Z8001>(src));
+		switch (cc) {
+			case  0: if (CC0) SET_Z; else CLR_Z; break;
+			case  1: if (CC1) SET_Z; else CLR_Z; break;
+			case  2: if (CC2) SET_Z; else CLR_Z; break;
+			case  3: if (CC3) SET_Z; else CLR_Z; break;
+			case  4: if (CC4) SET_Z; else CLR_Z; break;
+			case  5: if (CC5) SET_Z; else CLR_Z; break;
+			case  6: if (CC6) SET_Z; else CLR_Z; break;
+			case  7: if (CC7) SET_Z; else CLR_Z; break;
+			case  8: if (CC8) SET_Z; else CLR_Z; break;
+			case  9: if (CC9) SET_Z; else CLR_Z; break;
+			case 10: if (CCA) SET_Z; else CLR_Z; break;
+			case 11: if (CCB) SET_Z; else CLR_Z; break;
+			case 12: if (CCC) SET_Z; else CLR_Z; break;
+			case 13: if (CCD) SET_Z; else CLR_Z; break;
+			case 14: if (CCE) SET_Z; else CLR_Z; break;
+			case 15: if (CCF) SET_Z; else CLR_Z; break;
+		}
+		sub_from_addr_reg<Z8001>(src, 2);
+		if (--RW(cnt)) { CLR_V; if (!GET_Z) m_pc -= 4; } else SET_V;
+	} while (repeat_next());
 }
 
 /******************************************
  cpsdr   @rd,@rs,rr,cc
  flags:  CZSV--
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBB_ssN0_1110_0000_rrrr_ddN0_cccc()
 {
 	GET_SRC(OP0,NIB2);
 	GET_CCC(OP1,NIB3);
 	GET_DST(OP1,NIB2);
 	GET_CNT(OP1,NIB1);
-	CPW(RDIR_W(dst), RDIR_W(src));
-	switch (cc) {
-		case  0: if (CC0) SET_Z; else CLR_Z; break;
-		case  1: if (CC1) SET_Z; else CLR_Z; break;
-		case  2: if (CC2) SET_Z; else CLR_Z; break;
-		case  3: if (CC3) SET_Z; else CLR_Z; break;
-		case  4: if (CC4) SET_Z; else CLR_Z; break;
-		case  5: if (CC5) SET_Z; else CLR_Z; break;
-		case  6: if (CC6) SET_Z; else CLR_Z; break;
-		case  7: if (CC7) SET_Z; else CLR_Z; break;
-		case  8: if (CC8) SET_Z; else CLR_Z; break;
-		case  9: if (CC9) SET_Z; else CLR_Z; break;
-		case 10: if (CCA) SET_Z; else CLR_Z; break;
-		case 11: if (CCB) SET_Z; else CLR_Z; break;
-		case 12: if (CCC) SET_Z; else CLR_Z; break;
-		case 13: if (CCD) SET_Z; else CLR_Z; break;
-		case 14: if (CCE) SET_Z; else CLR_Z; break;
-		case 15: if (CCF) SET_Z; else CLR_Z; break;
-	}
-	sub_from_addr_reg(src, 2);
-	sub_from_addr_reg(dst, 2);
-	if (--RW(cnt)) { CLR_V; if (!(m_fcw & F_Z)) m_pc -= 4; } else SET_V;
+	do {
+		repeat_compare<Z8001>(dst, true, src, cnt, -2, cc);
+		CPW(RDIR_W<Z8001>(dst), RDIR_W<Z8001>(src));
+		switch (cc) {
+			case  0: if (CC0) SET_Z; else CLR_Z; break;
+			case  1: if (CC1) SET_Z; else CLR_Z; break;
+			case  2: if (CC2) SET_Z; else CLR_Z; break;
+			case  3: if (CC3) SET_Z; else CLR_Z; break;
+			case  4: if (CC4) SET_Z; else CLR_Z; break;
+			case  5: if (CC5) SET_Z; else CLR_Z; break;
+			case  6: if (CC6) SET_Z; else CLR_Z; break;
+			case  7: if (CC7) SET_Z; else CLR_Z; break;
+			case  8: if (CC8) SET_Z; else CLR_Z; break;
+			case  9: if (CC9) SET_Z; else CLR_Z; break;
+			case 10: if (CCA) SET_Z; else CLR_Z; break;
+			case 11: if (CCB) SET_Z; else CLR_Z; break;
+			case 12: if (CCC) SET_Z; else CLR_Z; break;
+			case 13: if (CCD) SET_Z; else CLR_Z; break;
+			case 14: if (CCE) SET_Z; else CLR_Z; break;
+			case 15: if (CCF) SET_Z; else CLR_Z; break;
+		}
+		sub_from_addr_reg<Z8001>(src, 2);
+		sub_from_addr_reg<Z8001>(dst, 2);
+		if (--RW(cnt)) { CLR_V; if (!GET_Z) m_pc -= 4; } else SET_V;
+	} while (repeat_next());
 }
 
 /******************************************
  rrdb    rbb,rba
  flags:  -Z----
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBC_aaaa_bbbb()
 {
 	uint8_t b = m_op[0] & 15;
@@ -6919,6 +7469,7 @@ void z8002_device::ZBC_aaaa_bbbb()
  ldk     rd,imm4
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBD_dddd_imm4()
 {
 	GET_DST(OP0,NIB2);
@@ -6930,6 +7481,7 @@ void z8002_device::ZBD_dddd_imm4()
  rldb    rbb,rba
  flags:  -Z----
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBE_aaaa_bbbb()
 {
 	uint8_t b = m_op[0] & 15;
@@ -6945,6 +7497,7 @@ void z8002_device::ZBE_aaaa_bbbb()
  rsvdbf
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZBF_imm8()
 {
 	GET_IMM8(0);
@@ -6960,6 +7513,7 @@ void z8002_device::ZBF_imm8()
  ldb     rbd,imm8   (long version)
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::Z20_0000_dddd_imm8()
 {
 	GET_DST(OP0,NIB3);
@@ -6971,6 +7525,7 @@ void z8002_device::Z20_0000_dddd_imm8()
  ldb     rbd,imm8
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZC_dddd_imm8()
 {
 	GET_DST(OP0,NIB1);
@@ -6982,56 +7537,63 @@ void z8002_device::ZC_dddd_imm8()
  calr    dsp12
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZD_dsp12()
 {
 	int16_t dsp12 = m_op[0] & 0xfff;
-	if (get_segmented_mode())
-		PUSHL(SP, make_segmented_addr(m_pc));
+	if (segmented<Z8001>())
+		PUSHL<Z8001>(SP, make_segmented_addr(m_pc));
 	else
-		PUSHW(SP, m_pc);
+		PUSHW<Z8001>(SP, m_pc);
 	dsp12 = (dsp12 & 2048) ? 4096 - 2 * (dsp12 & 2047) : -2 * (dsp12 & 2047);
-	set_pc(addr_add(m_pc, dsp12));
+	set_pc<Z8001>(addr_add(m_pc, dsp12));
 }
 
 /******************************************
  jr      cc,dsp8
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZE_cccc_dsp8()
 {
 	GET_DSP8;
 	GET_CCC(OP0,NIB1);
 	switch (cc) {
-		case  0: if (CC0) set_pc(addr_add(m_pc, dsp8 * 2)); break;
-		case  1: if (CC1) set_pc(addr_add(m_pc, dsp8 * 2)); break;
-		case  2: if (CC2) set_pc(addr_add(m_pc, dsp8 * 2)); break;
-		case  3: if (CC3) set_pc(addr_add(m_pc, dsp8 * 2)); break;
-		case  4: if (CC4) set_pc(addr_add(m_pc, dsp8 * 2)); break;
-		case  5: if (CC5) set_pc(addr_add(m_pc, dsp8 * 2)); break;
-		case  6: if (CC6) set_pc(addr_add(m_pc, dsp8 * 2)); break;
-		case  7: if (CC7) set_pc(addr_add(m_pc, dsp8 * 2)); break;
-		case  8: if (CC8) set_pc(addr_add(m_pc, dsp8 * 2)); break;
-		case  9: if (CC9) set_pc(addr_add(m_pc, dsp8 * 2)); break;
-		case  10: if (CCA) set_pc(addr_add(m_pc, dsp8 * 2)); break;
-		case  11: if (CCB) set_pc(addr_add(m_pc, dsp8 * 2)); break;
-		case  12: if (CCC) set_pc(addr_add(m_pc, dsp8 * 2)); break;
-		case  13: if (CCD) set_pc(addr_add(m_pc, dsp8 * 2)); break;
-		case  14: if (CCE) set_pc(addr_add(m_pc, dsp8 * 2)); break;
-		case  15: if (CCF) set_pc(addr_add(m_pc, dsp8 * 2)); break;
+		case  0: if (CC0) set_pc<Z8001>(addr_add(m_pc, dsp8 * 2)); break;
+		case  1: if (CC1) set_pc<Z8001>(addr_add(m_pc, dsp8 * 2)); break;
+		case  2: if (CC2) set_pc<Z8001>(addr_add(m_pc, dsp8 * 2)); break;
+		case  3: if (CC3) set_pc<Z8001>(addr_add(m_pc, dsp8 * 2)); break;
+		case  4: if (CC4) set_pc<Z8001>(addr_add(m_pc, dsp8 * 2)); break;
+		case  5: if (CC5) set_pc<Z8001>(addr_add(m_pc, dsp8 * 2)); break;
+		case  6: if (CC6) set_pc<Z8001>(addr_add(m_pc, dsp8 * 2)); break;
+		case  7: if (CC7) set_pc<Z8001>(addr_add(m_pc, dsp8 * 2)); break;
+		case  8: if (CC8) set_pc<Z8001>(addr_add(m_pc, dsp8 * 2)); break;
+		case  9: if (CC9) set_pc<Z8001>(addr_add(m_pc, dsp8 * 2)); break;
+		case  10: if (CCA) set_pc<Z8001>(addr_add(m_pc, dsp8 * 2)); break;
+		case  11: if (CCB) set_pc<Z8001>(addr_add(m_pc, dsp8 * 2)); break;
+		case  12: if (CCC) set_pc<Z8001>(addr_add(m_pc, dsp8 * 2)); break;
+		case  13: if (CCD) set_pc<Z8001>(addr_add(m_pc, dsp8 * 2)); break;
+		case  14: if (CCE) set_pc<Z8001>(addr_add(m_pc, dsp8 * 2)); break;
+		case  15: if (CCF) set_pc<Z8001>(addr_add(m_pc, dsp8 * 2)); break;
 	}
+	if (m_idle_active)
+		idle_branch();
 }
 
 /******************************************
  dbjnz   rbd,dsp7
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZF_dddd_0dsp7()
 {
 	GET_DST(OP0,NIB1);
 	GET_DSP7;
 	RB(dst) -= 1;
 	if (RB(dst)) {
-		set_pc(addr_sub(m_pc, 2 * dsp7));
+		set_pc<Z8001>(addr_sub(m_pc, 2 * dsp7));
+		if (m_idle_active && m_pc == m_ppc)
+			RB(dst) -= idle_count(RB(dst) - 1);
 	}
 }
 
@@ -7039,12 +7601,15 @@ void z8002_device::ZF_dddd_0dsp7()
  djnz    rd,dsp7
  flags:  ------
  ******************************************/
+template<bool Z8001>
 void z8002_device::ZF_dddd_1dsp7()
 {
 	GET_DST(OP0,NIB1);
 	GET_DSP7;
 	RW(dst) -= 1;
 	if (RW(dst)) {
-		set_pc(addr_sub(m_pc, 2 * dsp7));
+		set_pc<Z8001>(addr_sub(m_pc, 2 * dsp7));
+		if (m_idle_active && m_pc == m_ppc)
+			RW(dst) -= idle_count(RW(dst) - 1);
 	}
 }
@@ -8,526 +8,531 @@
  *
  *****************************************************************************/
 
-const z8002_device::Z8000_init z8002_device::table[] = {
-	{ 0x0000, 0xffff,  1, 1,   4, &z8002_device::zinvalid },
+/* the Z8002 and Z8001 instantiations of a handler */
+#define OPS(f)  { &z8002_device::f<false>, &z8002_device::f<true> }
 
-	{ 0x0000, 0x000f,  1, 2,   7, &z8002_device::Z00_0000_dddd_imm8 },
-	{ 0x0010, 0x00ff,  1, 1,   7, &z8002_device::Z00_ssN0_dddd },
-	{ 0x0100, 0x010f,  1, 2,   7, &z8002_device::Z01_0000_dddd_imm16 },
-	{ 0x0110, 0x01ff,  1, 1,   7, &z8002_device::Z01_ssN0_dddd },
-	{ 0x0200, 0x020f,  1, 2,   7, &z8002_device::Z02_0000_dddd_imm8 },
-	{ 0x0210, 0x02ff,  1, 1,   7, &z8002_device::Z02_ssN0_dddd },
-	{ 0x0300, 0x030f,  1, 2,   7, &z8002_device::Z03_0000_dddd_imm16 },
-	{ 0x0310, 0x03ff,  1, 1,   7, &z8002_device::Z03_ssN0_dddd },
-	{ 0x0400, 0x040f,  1, 2,   7, &z8002_device::Z04_0000_dddd_imm8 },
-	{ 0x0410, 0x04ff,  1, 1,   7, &z8002_device::Z04_ssN0_dddd },
-	{ 0x0500, 0x050f,  1, 2,   7, &z8002_device::Z05_0000_dddd_imm16 },
-	{ 0x0510, 0x05ff,  1, 1,   7, &z8002_device::Z05_ssN0_dddd },
-	{ 0x0600, 0x060f,  1, 2,   7, &z8002_device::Z06_0000_dddd_imm8 },
-	{ 0x0610, 0x06ff,  1, 1,   7, &z8002_device::Z06_ssN0_dddd },
-	{ 0x0700, 0x070f,  1, 2,   7, &z8002_device::Z07_0000_dddd_imm16 },
-	{ 0x0710, 0x07ff,  1, 1,   7, &z8002_device::Z07_ssN0_dddd },
-	{ 0x0800, 0x080f,  1, 2,   7, &z8002_device::Z08_0000_dddd_imm8 },
-	{ 0x0810, 0x08ff,  1, 1,   7, &z8002_device::Z08_ssN0_dddd },
-	{ 0x0900, 0x090f,  1, 2,   7, &z8002_device::Z09_0000_dddd_imm16 },
-	{ 0x0910, 0x09ff,  1, 1,   7, &z8002_device::Z09_ssN0_dddd },
-	{ 0x0a00, 0x0a0f,  1, 2,   7, &z8002_device::Z0A_0000_dddd_imm8 },
-	{ 0x0a10, 0x0aff,  1, 1,   7, &z8002_device::Z0A_ssN0_dddd },
-	{ 0x0b00, 0x0b0f,  1, 2,   7, &z8002_device::Z0B_0000_dddd_imm16 },
-	{ 0x0b10, 0x0bff,  1, 1,   7, &z8002_device::Z0B_ssN0_dddd },
-	{ 0x0c10, 0x0cf0, 16, 1,  12, &z8002_device::Z0C_ddN0_0000 },
-	{ 0x0c11, 0x0cf1, 16, 2,  11, &z8002_device::Z0C_ddN0_0001_imm8 },
-	{ 0x0c12, 0x0cf2, 16, 1,  12, &z8002_device::Z0C_ddN0_0010 },
-	{ 0x0c14, 0x0cf4, 16, 1,   8, &z8002_device::Z0C_ddN0_0100 },
-	{ 0x0c15, 0x0cf5, 16, 2,   7, &z8002_device::Z0C_ddN0_0101_imm8 },
-	{ 0x0c16, 0x0cf6, 16, 1,  11, &z8002_device::Z0C_ddN0_0110 },
-	{ 0x0c18, 0x0cf8, 16, 1,   8, &z8002_device::Z0C_ddN0_1000 },
-	{ 0x0d10, 0x0df0, 16, 1,  12, &z8002_device::Z0D_ddN0_0000 },
-	{ 0x0d11, 0x0df1, 16, 2,  11, &z8002_device::Z0D_ddN0_0001_imm16 },
-	{ 0x0d12, 0x0df2, 16, 1,  12, &z8002_device::Z0D_ddN0_0010 },
-	{ 0x0d14, 0x0df4, 16, 1,   8, &z8002_device::Z0D_ddN0_0100 },
-	{ 0x0d15, 0x0df5, 16, 2,  11, &z8002_device::Z0D_ddN0_0101_imm16 }, /* fix cycles ld IR,IM */
-	{ 0x0d16, 0x0df6, 16, 1,  11, &z8002_device::Z0D_ddN0_0110 },
-	{ 0x0d18, 0x0df8, 16, 1,   8, &z8002_device::Z0D_ddN0_1000 },
-	{ 0x0d19, 0x0df9, 16, 2,  12, &z8002_device::Z0D_ddN0_1001_imm16 },
-	{ 0x0e00, 0x0eff,  1, 1,  10, &z8002_device::Z0E_imm8 },
-	{ 0x0f00, 0x0fff,  1, 1,  10, &z8002_device::Z0F_imm8 },
-	{ 0x1000, 0x100f,  1, 3,  14, &z8002_device::Z10_0000_dddd_imm32 },
-	{ 0x1010, 0x10ff,  1, 1,  14, &z8002_device::Z10_ssN0_dddd },
-	{ 0x1111, 0x11ff,  1, 1,  20, &z8002_device::Z11_ddN0_ssN0 },
-	{ 0x1200, 0x120f,  1, 3,  14, &z8002_device::Z12_0000_dddd_imm32 },
-	{ 0x1210, 0x12ff,  1, 1,  14, &z8002_device::Z12_ssN0_dddd },
-	{ 0x1311, 0x13ff,  1, 1,  13, &z8002_device::Z13_ddN0_ssN0 },
-	{ 0x1400, 0x140f,  1, 3,  11, &z8002_device::Z14_0000_dddd_imm32 },
-	{ 0x1410, 0x14ff,  1, 1,  11, &z8002_device::Z14_ssN0_dddd },
-	{ 0x1511, 0x15ff,  1, 1,  19, &z8002_device::Z15_ssN0_ddN0 },
-	{ 0x1600, 0x160f,  1, 3,  14, &z8002_device::Z16_0000_dddd_imm32 },
-	{ 0x1610, 0x16ff,  1, 1,  14, &z8002_device::Z16_ssN0_dddd },
-	{ 0x1711, 0x17ff,  1, 1,  12, &z8002_device::Z17_ssN0_ddN0 },
-	{ 0x1800, 0x180f,  1, 1, 282, &z8002_device::Z18_00N0_dddd_imm32 },
-	{ 0x1810, 0x18ff,  1, 1, 282, &z8002_device::Z18_ssN0_dddd },
-	{ 0x1900, 0x190f,  1, 2,  70, &z8002_device::Z19_0000_dddd_imm16 },
-	{ 0x1910, 0x19ff,  1, 1,  70, &z8002_device::Z19_ssN0_dddd },
-	{ 0x1a00, 0x1a0f,  1, 3, 744, &z8002_device::Z1A_0000_dddd_imm32 },
-	{ 0x1a10, 0x1aff,  1, 1, 744, &z8002_device::Z1A_ssN0_dddd },
-	{ 0x1b00, 0x1b0f,  1, 2, 107, &z8002_device::Z1B_0000_dddd_imm16 },
-	{ 0x1b10, 0x1bff,  1, 1, 107, &z8002_device::Z1B_ssN0_dddd },
-	{ 0x1c11, 0x1cf1, 16, 2,  11, &z8002_device::Z1C_ssN0_0001_0000_dddd_0000_nmin1 },
-	{ 0x1c18, 0x1cf8, 16, 1,  13, &z8002_device::Z1C_ddN0_1000 },
-	{ 0x1c19, 0x1cf9, 16, 2,  11, &z8002_device::Z1C_ddN0_1001_0000_ssss_0000_nmin1 },
-	{ 0x1d10, 0x1dff,  1, 1,  11, &z8002_device::Z1D_ddN0_ssss },
-	{ 0x1e10, 0x1eff,  1, 1,  10, &z8002_device::Z1E_ddN0_cccc },
-	{ 0x1f10, 0x1ff0, 16, 1,  10, &z8002_device::Z1F_ddN0_0000 },
-	{ 0x2000, 0x200f,  1, 2,   7, &z8002_device::Z20_0000_dddd_imm8 },
-	{ 0x2010, 0x20ff,  1, 1,   7, &z8002_device::Z20_ssN0_dddd },
-	{ 0x2100, 0x210f,  1, 2,   7, &z8002_device::Z21_0000_dddd_imm16 },
-	{ 0x2110, 0x21ff,  1, 1,   7, &z8002_device::Z21_ssN0_dddd },
-	{ 0x2200, 0x220f,  1, 2,  10, &z8002_device::Z22_0000_ssss_0000_dddd_0000_0000 },
-	{ 0x2210, 0x22ff,  1, 1,  11, &z8002_device::Z22_ddN0_imm4 },
-	{ 0x2300, 0x230f,  1, 2,  10, &z8002_device::Z23_0000_ssss_0000_dddd_0000_0000 },
-	{ 0x2310, 0x23ff,  1, 1,  11, &z8002_device::Z23_ddN0_imm4 },
-	{ 0x2400, 0x240f,  1, 2,  10, &z8002_device::Z24_0000_ssss_0000_dddd_0000_0000 },
-	{ 0x2410, 0x24ff,  1, 1,  11, &z8002_device::Z24_ddN0_imm4 },
-	{ 0x2500, 0x250f,  1, 2,  10, &z8002_device::Z25_0000_ssss_0000_dddd_0000_0000 },
-	{ 0x2510, 0x25ff,  1, 1,  11, &z8002_device::Z25_ddN0_imm4 },
-	{ 0x2600, 0x260f,  1, 2,  10, &z8002_device::Z26_0000_ssss_0000_dddd_0000_0000 },
-	{ 0x2610, 0x26ff,  1, 1,   8, &z8002_device::Z26_ddN0_imm4 },
-	{ 0x2700, 0x270f,  1, 2,  10, &z8002_device::Z27_0000_ssss_0000_dddd_0000_0000 },
-	{ 0x2710, 0x27ff,  1, 1,   8, &z8002_device::Z27_ddN0_imm4 },
-	{ 0x2810, 0x28ff,  1, 1,  11, &z8002_device::Z28_ddN0_imm4m1 },
-	{ 0x2910, 0x29ff,  1, 1,  11, &z8002_device::Z29_ddN0_imm4m1 },
-	{ 0x2a10, 0x2aff,  1, 1,  11, &z8002_device::Z2A_ddN0_imm4m1 },
-	{ 0x2b10, 0x2bff,  1, 1,  11, &z8002_device::Z2B_ddN0_imm4m1 },
-	{ 0x2c10, 0x2cff,  1, 1,  12, &z8002_device::Z2C_ssN0_dddd },
-	{ 0x2d10, 0x2dff,  1, 1,  12, &z8002_device::Z2D_ssN0_dddd },
-	{ 0x2e10, 0x2eff,  1, 1,   8, &z8002_device::Z2E_ddN0_ssss },
-	{ 0x2f10, 0x2fff,  1, 1,   8, &z8002_device::Z2F_ddN0_ssss },
-	{ 0x3000, 0x300f,  1, 2,  14, &z8002_device::Z30_0000_dddd_dsp16 },
-	{ 0x3010, 0x30ff,  1, 2,  14, &z8002_device::Z30_ssN0_dddd_imm16 },
-	{ 0x3100, 0x310f,  1, 2,  14, &z8002_device::Z31_0000_dddd_dsp16 },
-	{ 0x3110, 0x31ff,  1, 2,  14, &z8002_device::Z31_ssN0_dddd_imm16 },
-	{ 0x3200, 0x320f,  1, 2,  14, &z8002_device::Z32_0000_ssss_dsp16 },
-	{ 0x3210, 0x32ff,  1, 2,  14, &z8002_device::Z32_ddN0_ssss_imm16 },
-	{ 0x3300, 0x330f,  1, 2,  14, &z8002_device::Z33_0000_ssss_dsp16 },
-	{ 0x3310, 0x33ff,  1, 2,  14, &z8002_device::Z33_ddN0_ssss_imm16 },
-	{ 0x3400, 0x340f,  1, 2,  15, &z8002_device::Z34_0000_dddd_dsp16 },
-	{ 0x3410, 0x34ff,  1, 2,  15, &z8002_device::Z34_ssN0_dddd_imm16 },
-	{ 0x3500, 0x350f,  1, 2,  17, &z8002_device::Z35_0000_dddd_dsp16 },
-	{ 0x3510, 0x35ff,  1, 2,  17, &z8002_device::Z35_ssN0_dddd_imm16 },
-	{ 0x3600, 0x3600,  1, 1,   2, &z8002_device::Z36_0000_0000 },
-	{ 0x3601, 0x36ff,  1, 1,  10, &z8002_device::Z36_imm8 },
-	{ 0x3700, 0x370f,  1, 2,  17, &z8002_device::Z37_0000_ssss_dsp16 },
-	{ 0x3710, 0x37ff,  1, 2,  17, &z8002_device::Z37_ddN0_ssss_imm16 },
-	{ 0x3800, 0x38ff,  1, 1,  10, &z8002_device::Z38_imm8 },
-	{ 0x3910, 0x39f0, 16, 1,  12, &z8002_device::Z39_ssN0_0000 },
-	{ 0x3a00, 0x3af0, 16, 2,  21, &z8002_device::Z3A_ssss_0000_0000_aaaa_dddd_x000 },
-	{ 0x3a01, 0x3af1, 16, 2,  21, &z8002_device::Z3A_ssss_0001_0000_aaaa_dddd_x000 },
-	{ 0x3a02, 0x3af2, 16, 2,  21, &z8002_device::Z3A_ssss_0010_0000_aaaa_dddd_x000 },
-	{ 0x3a03, 0x3af3, 16, 2,  21, &z8002_device::Z3A_ssss_0011_0000_aaaa_dddd_x000 },
-	{ 0x3a04, 0x3af4, 16, 2,  10, &z8002_device::Z3A_dddd_0100_imm16 },
-	{ 0x3a05, 0x3af5, 16, 2,  10, &z8002_device::Z3A_dddd_0101_imm16 },
-	{ 0x3a06, 0x3af6, 16, 2,  12, &z8002_device::Z3A_ssss_0110_imm16 },
-	{ 0x3a07, 0x3af7, 16, 2,  12, &z8002_device::Z3A_ssss_0111_imm16 },
-	{ 0x3a08, 0x3af8, 16, 2,  21, &z8002_device::Z3A_ssss_1000_0000_aaaa_dddd_x000 },
-	{ 0x3a09, 0x3af9, 16, 2,  21, &z8002_device::Z3A_ssss_1001_0000_aaaa_dddd_x000 },
-	{ 0x3a0a, 0x3afa, 16, 2,  21, &z8002_device::Z3A_ssss_1010_0000_aaaa_dddd_x000 },
-	{ 0x3a0b, 0x3afb, 16, 2,  21, &z8002_device::Z3A_ssss_1011_0000_aaaa_dddd_x000 },
-	{ 0x3b00, 0x3bf0, 16, 2,  21, &z8002_device::Z3B_ssss_0000_0000_aaaa_dddd_x000 },
-	{ 0x3b01, 0x3bf1, 16, 2,  21, &z8002_device::Z3B_ssss_0001_0000_aaaa_dddd_x000 },
-	{ 0x3b02, 0x3bf2, 16, 2,  21, &z8002_device::Z3B_ssss_0010_0000_aaaa_dddd_x000 },
-	{ 0x3b03, 0x3bf3, 16, 2,  21, &z8002_device::Z3B_ssss_0011_0000_aaaa_dddd_x000 },
-	{ 0x3b04, 0x3bf4, 16, 2,  12, &z8002_device::Z3B_dddd_0100_imm16 },
-	{ 0x3b05, 0x3bf5, 16, 2,  12, &z8002_device::Z3B_dddd_0101_imm16 },
-	{ 0x3b06, 0x3bf6, 16, 2,  12, &z8002_device::Z3B_ssss_0110_imm16 },
-	{ 0x3b07, 0x3bf7, 16, 2,  12, &z8002_device::Z3B_ssss_0111_imm16 },
-	{ 0x3b08, 0x3bf8, 16, 2,  21, &z8002_device::Z3B_ssss_1000_0000_aaaa_dddd_x000 },
-	{ 0x3b09, 0x3bf9, 16, 2,  21, &z8002_device::Z3B_ssss_1001_0000_aaaa_dddd_x000 },
-	{ 0x3b0a, 0x3bfa, 16, 2,  21, &z8002_device::Z3B_ssss_1010_0000_aaaa_dddd_x000 },
-	{ 0x3b0b, 0x3bfb, 16, 2,  21, &z8002_device::Z3B_ssss_1011_0000_aaaa_dddd_x000 },
-	{ 0x3c00, 0x3cff,  1, 1,  10, &z8002_device::Z3C_ssss_dddd },
-	{ 0x3d00, 0x3dff,  1, 1,  10, &z8002_device::Z3D_ssss_dddd },
-	{ 0x3e00, 0x3eff,  1, 1,  12, &z8002_device::Z3E_dddd_ssss },
-	{ 0x3f00, 0x3fff,  1, 1,  12, &z8002_device::Z3F_dddd_ssss },
-	{ 0x4000, 0x400f,  1, 2,   9, &z8002_device::Z40_0000_dddd_addr },
-	{ 0x4010, 0x40ff,  1, 2,  10, &z8002_device::Z40_ssN0_dddd_addr },
-	{ 0x4100, 0x410f,  1, 2,   9, &z8002_device::Z41_0000_dddd_addr },
-	{ 0x4110, 0x41ff,  1, 2,  10, &z8002_device::Z41_ssN0_dddd_addr },
-	{ 0x4200, 0x420f,  1, 2,   9, &z8002_device::Z42_0000_dddd_addr },
-	{ 0x4210, 0x42ff,  1, 2,  10, &z8002_device::Z42_ssN0_dddd_addr },
-	{ 0x4300, 0x430f,  1, 2,   9, &z8002_device::Z43_0000_dddd_addr },
-	{ 0x4310, 0x43ff,  1, 2,  10, &z8002_device::Z43_ssN0_dddd_addr },
-	{ 0x4400, 0x440f,  1, 2,   9, &z8002_device::Z44_0000_dddd_addr },
-	{ 0x4410, 0x44ff,  1, 2,  10, &z8002_device::Z44_ssN0_dddd_addr },
-	{ 0x4500, 0x450f,  1, 2,   9, &z8002_device::Z45_0000_dddd_addr },
-	{ 0x4510, 0x45ff,  1, 2,  10, &z8002_device::Z45_ssN0_dddd_addr },
-	{ 0x4600, 0x460f,  1, 2,   9, &z8002_device::Z46_0000_dddd_addr },
-	{ 0x4610, 0x46ff,  1, 2,  10, &z8002_device::Z46_ssN0_dddd_addr },
-	{ 0x4700, 0x470f,  1, 2,   9, &z8002_device::Z47_0000_dddd_addr },
-	{ 0x4710, 0x47ff,  1, 2,  10, &z8002_device::Z47_ssN0_dddd_addr },
-	{ 0x4800, 0x480f,  1, 2,   9, &z8002_device::Z48_0000_dddd_addr },
-	{ 0x4810, 0x48ff,  1, 2,  10, &z8002_device::Z48_ssN0_dddd_addr },
-	{ 0x4900, 0x490f,  1, 2,   9, &z8002_device::Z49_0000_dddd_addr },
-	{ 0x4910, 0x49ff,  1, 2,  10, &z8002_device::Z49_ssN0_dddd_addr },
-	{ 0x4a00, 0x4a0f,  1, 2,   9, &z8002_device::Z4A_0000_dddd_addr },
-	{ 0x4a10, 0x4aff,  1, 2,  10, &z8002_device::Z4A_ssN0_dddd_addr },
-	{ 0x4b00, 0x4b0f,  1, 2,   9, &z8002_device::Z4B_0000_dddd_addr },
-	{ 0x4b10, 0x4bff,  1, 2,  10, &z8002_device::Z4B_ssN0_dddd_addr },
-	{ 0x4c00, 0x4c00,  1, 2,  15, &z8002_device::Z4C_0000_0000_addr },
-	{ 0x4c01, 0x4c01,  1, 3,  14, &z8002_device::Z4C_0000_0001_addr_imm8 },
-	{ 0x4c02, 0x4c02,  1, 2,  15, &z8002_device::Z4C_0000_0010_addr },
-	{ 0x4c04, 0x4c04,  1, 2,  11, &z8002_device::Z4C_0000_0100_addr },
-	{ 0x4c05, 0x4c05,  1, 3,  14, &z8002_device::Z4C_0000_0101_addr_imm8 },
-	{ 0x4c06, 0x4c06,  1, 2,  14, &z8002_device::Z4C_0000_0110_addr },
-	{ 0x4c08, 0x4c08,  1, 2,  11, &z8002_device::Z4C_0000_1000_addr },
-	{ 0x4c10, 0x4cf0, 16, 2,  16, &z8002_device::Z4C_ddN0_0000_addr },
-	{ 0x4c11, 0x4cf1, 16, 3,  15, &z8002_device::Z4C_ddN0_0001_addr_imm8 },
-	{ 0x4c12, 0x4cf2, 16, 2,  16, &z8002_device::Z4C_ddN0_0010_addr },
-	{ 0x4c14, 0x4cf4, 16, 2,  12, &z8002_device::Z4C_ddN0_0100_addr },
-	{ 0x4c15, 0x4cf5, 16, 3,  15, &z8002_device::Z4C_ddN0_0101_addr_imm8 },
-	{ 0x4c16, 0x4cf6, 16, 2,  15, &z8002_device::Z4C_ddN0_0110_addr },
-	{ 0x4c18, 0x4cf8, 16, 2,  12, &z8002_device::Z4C_ddN0_1000_addr },
-	{ 0x4d00, 0x4d00,  1, 2,  15, &z8002_device::Z4D_0000_0000_addr },
-	{ 0x4d01, 0x4d01,  1, 3,  14, &z8002_device::Z4D_0000_0001_addr_imm16 },
-	{ 0x4d02, 0x4d02,  1, 2,  15, &z8002_device::Z4D_0000_0010_addr },
-	{ 0x4d04, 0x4d04,  1, 2,  11, &z8002_device::Z4D_0000_0100_addr },
-	{ 0x4d05, 0x4d05,  1, 3,  14, &z8002_device::Z4D_0000_0101_addr_imm16 },
-	{ 0x4d06, 0x4d06,  1, 2,  14, &z8002_device::Z4D_0000_0110_addr },
-	{ 0x4d08, 0x4d08,  1, 2,  11, &z8002_device::Z4D_0000_1000_addr },
-	{ 0x4d10, 0x4df0, 16, 2,  16, &z8002_device::Z4D_ddN0_0000_addr },
-	{ 0x4d11, 0x4df1, 16, 3,  15, &z8002_device::Z4D_ddN0_0001_addr_imm16 },
-	{ 0x4d12, 0x4df2, 16, 2,  16, &z8002_device::Z4D_ddN0_0010_addr },
-	{ 0x4d14, 0x4df4, 16, 2,  12, &z8002_device::Z4D_ddN0_0100_addr },
-	{ 0x4d15, 0x4df5, 16, 3,  15, &z8002_device::Z4D_ddN0_0101_addr_imm16 },
-	{ 0x4d16, 0x4df6, 16, 2,  15, &z8002_device::Z4D_ddN0_0110_addr },
-	{ 0x4d18, 0x4df8, 16, 2,  12, &z8002_device::Z4D_ddN0_1000_addr },
-	{ 0x4e11, 0x4ef0, 16, 2,  12, &z8002_device::Z4E_ddN0_ssN0_addr },
-	{ 0x5000, 0x500f,  1, 2,  15, &z8002_device::Z50_0000_dddd_addr },
-	{ 0x5010, 0x50ff,  1, 2,  16, &z8002_device::Z50_ssN0_dddd_addr },
-	{ 0x5110, 0x51f0, 16, 2,  21, &z8002_device::Z51_ddN0_0000_addr },
-	{ 0x5111, 0x51f1, 16, 2,  21, &z8002_device::Z51_ddN0_ssN0_addr },
-	{ 0x5112, 0x51f2, 16, 2,  21, &z8002_device::Z51_ddN0_ssN0_addr },
-	{ 0x5113, 0x51f3, 16, 2,  21, &z8002_device::Z51_ddN0_ssN0_addr },
-	{ 0x5114, 0x51f4, 16, 2,  21, &z8002_device::Z51_ddN0_ssN0_addr },
-	{ 0x5115, 0x51f5, 16, 2,  21, &z8002_device::Z51_ddN0_ssN0_addr },
-	{ 0x5116, 0x51f6, 16, 2,  21, &z8002_device::Z51_ddN0_ssN0_addr },
-	{ 0x5117, 0x51f7, 16, 2,  21, &z8002_device::Z51_ddN0_ssN0_addr },
-	{ 0x5118, 0x51f8, 16, 2,  21, &z8002_device::Z51_ddN0_ssN0_addr },
-	{ 0x5119, 0x51f9, 16, 2,  21, &z8002_device::Z51_ddN0_ssN0_addr },
-	{ 0x511a, 0x51fa, 16, 2,  21, &z8002_device::Z51_ddN0_ssN0_addr },
-	{ 0x511b, 0x51fb, 16, 2,  21, &z8002_device::Z51_ddN0_ssN0_addr },
-	{ 0x511c, 0x51fc, 16, 2,  21, &z8002_device::Z51_ddN0_ssN0_addr },
-	{ 0x511d, 0x51fd, 16, 2,  21, &z8002_device::Z51_ddN0_ssN0_addr },
-	{ 0x511e, 0x51fe, 16, 2,  21, &z8002_device::Z51_ddN0_ssN0_addr },
-	{ 0x511f, 0x51ff, 16, 2,  21, &z8002_device::Z51_ddN0_ssN0_addr },
-	{ 0x5200, 0x520f,  1, 2,  15, &z8002_device::Z52_0000_dddd_addr },
-	{ 0x5210, 0x52ff,  1, 2,  16, &z8002_device::Z52_ssN0_dddd_addr },
-	{ 0x5310, 0x53f0, 16, 2,  14, &z8002_device::Z53_ddN0_0000_addr },
-	{ 0x5311, 0x53f1, 16, 2,  14, &z8002_device::Z53_ddN0_ssN0_addr },
-	{ 0x5312, 0x53f2, 16, 2,  14, &z8002_device::Z53_ddN0_ssN0_addr },
-	{ 0x5313, 0x53f3, 16, 2,  14, &z8002_device::Z53_ddN0_ssN0_addr },
-	{ 0x5314, 0x53f4, 16, 2,  14, &z8002_device::Z53_ddN0_ssN0_addr },
-	{ 0x5315, 0x53f5, 16, 2,  14, &z8002_device::Z53_ddN0_ssN0_addr },
-	{ 0x5316, 0x53f6, 16, 2,  14, &z8002_device::Z53_ddN0_ssN0_addr },
-	{ 0x5317, 0x53f7, 16, 2,  14, &z8002_device::Z53_ddN0_ssN0_addr },
-	{ 0x5318, 0x53f8, 16, 2,  14, &z8002_device::Z53_ddN0_ssN0_addr },
-	{ 0x5319, 0x53f9, 16, 2,  14, &z8002_device::Z53_ddN0_ssN0_addr },
-	{ 0x531a, 0x53fa, 16, 2,  14, &z8002_device::Z53_ddN0_ssN0_addr },
-	{ 0x531b, 0x53fb, 16, 2,  14, &z8002_device::Z53_ddN0_ssN0_addr },
-	{ 0x531c, 0x53fc, 16, 2,  14, &z8002_device::Z53_ddN0_ssN0_addr },
-	{ 0x531d, 0x53fd, 16, 2,  14, &z8002_device::Z53_ddN0_ssN0_addr },
-	{ 0x531e, 0x53fe, 16, 2,  14, &z8002_device::Z53_ddN0_ssN0_addr },
-	{ 0x531f, 0x53ff, 16, 2,  14, &z8002_device::Z53_ddN0_ssN0_addr },
-	{ 0x5400, 0x540f,  1, 2,  12, &z8002_device::Z54_0000_dddd_addr },
-	{ 0x5410, 0x54ff,  1, 2,  13, &z8002_device::Z54_ssN0_dddd_addr },
-	{ 0x5510, 0x55f0, 16, 2,  23, &z8002_device::Z55_ssN0_0000_addr },
-	{ 0x5511, 0x55f1, 16, 2,  23, &z8002_device::Z55_ssN0_ddN0_addr },
-	{ 0x5512, 0x55f2, 16, 2,  23, &z8002_device::Z55_ssN0_ddN0_addr },
-	{ 0x5513, 0x55f3, 16, 2,  23, &z8002_device::Z55_ssN0_ddN0_addr },
-	{ 0x5514, 0x55f4, 16, 2,  23, &z8002_device::Z55_ssN0_ddN0_addr },
-	{ 0x5515, 0x55f5, 16, 2,  23, &z8002_device::Z55_ssN0_ddN0_addr },
-	{ 0x5516, 0x55f6, 16, 2,  23, &z8002_device::Z55_ssN0_ddN0_addr },
-	{ 0x5517, 0x55f7, 16, 2,  23, &z8002_device::Z55_ssN0_ddN0_addr },
-	{ 0x5518, 0x55f8, 16, 2,  23, &z8002_device::Z55_ssN0_ddN0_addr },
-	{ 0x5519, 0x55f9, 16, 2,  23, &z8002_device::Z55_ssN0_ddN0_addr },
-	{ 0x551a, 0x55fa, 16, 2,  23, &z8002_device::Z55_ssN0_ddN0_addr },
-	{ 0x551b, 0x55fb, 16, 2,  23, &z8002_device::Z55_ssN0_ddN0_addr },
-	{ 0x551c, 0x55fc, 16, 2,  23, &z8002_device::Z55_ssN0_ddN0_addr },
-	{ 0x551d, 0x55fd, 16, 2,  23, &z8002_device::Z55_ssN0_ddN0_addr },
-	{ 0x551e, 0x55fe, 16, 2,  23, &z8002_device::Z55_ssN0_ddN0_addr },
-	{ 0x551f, 0x55ff, 16, 2,  23, &z8002_device::Z55_ssN0_ddN0_addr },
-	{ 0x5600, 0x560f,  1, 2,  15, &z8002_device::Z56_0000_dddd_addr },
-	{ 0x5610, 0x56ff,  1, 2,  16, &z8002_device::Z56_ssN0_dddd_addr },
-	{ 0x5710, 0x57f0, 16, 2,  16, &z8002_device::Z57_ssN0_0000_addr },
-	{ 0x5711, 0x57f1, 16, 2,  16, &z8002_device::Z57_ssN0_ddN0_addr },
-	{ 0x5712, 0x57f2, 16, 2,  16, &z8002_device::Z57_ssN0_ddN0_addr },
-	{ 0x5713, 0x57f3, 16, 2,  16, &z8002_device::Z57_ssN0_ddN0_addr },
-	{ 0x5714, 0x57f4, 16, 2,  16, &z8002_device::Z57_ssN0_ddN0_addr },
-	{ 0x5715, 0x57f5, 16, 2,  16, &z8002_device::Z57_ssN0_ddN0_addr },
-	{ 0x5716, 0x57f6, 16, 2,  16, &z8002_device::Z57_ssN0_ddN0_addr },
-	{ 0x5717, 0x57f7, 16, 2,  16, &z8002_device::Z57_ssN0_ddN0_addr },
-	{ 0x5718, 0x57f8, 16, 2,  16, &z8002_device::Z57_ssN0_ddN0_addr },
-	{ 0x5719, 0x57f9, 16, 2,  16, &z8002_device::Z57_ssN0_ddN0_addr },
-	{ 0x571a, 0x57fa, 16, 2,  16, &z8002_device::Z57_ssN0_ddN0_addr },
-	{ 0x571b, 0x57fb, 16, 2,  16, &z8002_device::Z57_ssN0_ddN0_addr },
-	{ 0x571c, 0x57fc, 16, 2,  16, &z8002_device::Z57_ssN0_ddN0_addr },
-	{ 0x571d, 0x57fd, 16, 2,  16, &z8002_device::Z57_ssN0_ddN0_addr },
-	{ 0x571e, 0x57fe, 16, 2,  16, &z8002_device::Z57_ssN0_ddN0_addr },
-	{ 0x571f, 0x57ff, 16, 2,  16, &z8002_device::Z57_ssN0_ddN0_addr },
-	{ 0x5800, 0x580f,  1, 2, 283, &z8002_device::Z58_0000_dddd_addr },
-	{ 0x5810, 0x58ff,  1, 2, 284, &z8002_device::Z58_ssN0_dddd_addr },
-	{ 0x5900, 0x590f,  1, 2,  71, &z8002_device::Z59_0000_dddd_addr },
-	{ 0x5910, 0x59ff,  1, 2,  72, &z8002_device::Z59_ssN0_dddd_addr },
-	{ 0x5a00, 0x5a0f,  1, 2, 745, &z8002_device::Z5A_0000_dddd_addr },
-	{ 0x5a10, 0x5aff,  1, 2, 746, &z8002_device::Z5A_ssN0_dddd_addr },
-	{ 0x5b00, 0x5b0f,  1, 2, 108, &z8002_device::Z5B_0000_dddd_addr },
-	{ 0x5b10, 0x5bff,  1, 2, 109, &z8002_device::Z5B_ssN0_dddd_addr },
-	{ 0x5c01, 0x5c01,  1, 3,  14, &z8002_device::Z5C_0000_0001_0000_dddd_0000_nmin1_addr },
-	{ 0x5c08, 0x5c08,  1, 2,  16, &z8002_device::Z5C_0000_1000_addr },
-	{ 0x5c09, 0x5c09,  1, 3,  14, &z8002_device::Z5C_0000_1001_0000_ssss_0000_nmin1_addr },
-	{ 0x5c11, 0x5cf1, 16, 3,  15, &z8002_device::Z5C_ssN0_0001_0000_dddd_0000_nmin1_addr },
-	{ 0x5c18, 0x5cf8, 16, 2,  17, &z8002_device::Z5C_ddN0_1000_addr },
-	{ 0x5c19, 0x5cf9, 16, 3,  15, &z8002_device::Z5C_ddN0_1001_0000_ssN0_0000_nmin1_addr },
-	{ 0x5d00, 0x5d0f,  1, 2,  15, &z8002_device::Z5D_0000_ssss_addr },
-	{ 0x5d10, 0x5dff,  1, 2,  14, &z8002_device::Z5D_ddN0_ssss_addr },
-	{ 0x5e00, 0x5e0f,  1, 2,   7, &z8002_device::Z5E_0000_cccc_addr },
-	{ 0x5e10, 0x5eff,  1, 2,   8, &z8002_device::Z5E_ddN0_cccc_addr },
-	{ 0x5f00, 0x5f00,  1, 2,  12, &z8002_device::Z5F_0000_0000_addr },
-	{ 0x5f10, 0x5ff0, 16, 2,  13, &z8002_device::Z5F_ddN0_0000_addr },
-	{ 0x6000, 0x600f,  1, 2,   9, &z8002_device::Z60_0000_dddd_addr },
-	{ 0x6010, 0x60ff,  1, 2,  10, &z8002_device::Z60_ssN0_dddd_addr },
-	{ 0x6100, 0x610f,  1, 2,   9, &z8002_device::Z61_0000_dddd_addr },
-	{ 0x6110, 0x61ff,  1, 2,  10, &z8002_device::Z61_ssN0_dddd_addr },
-	{ 0x6200, 0x620f,  1, 2,  13, &z8002_device::Z62_0000_imm4_addr },
-	{ 0x6210, 0x62ff,  1, 2,  14, &z8002_device::Z62_ddN0_imm4_addr },
-	{ 0x6300, 0x630f,  1, 2,  13, &z8002_device::Z63_0000_imm4_addr },
-	{ 0x6310, 0x63ff,  1, 2,  14, &z8002_device::Z63_ddN0_imm4_addr },
-	{ 0x6400, 0x640f,  1, 2,  13, &z8002_device::Z64_0000_imm4_addr },
-	{ 0x6410, 0x64ff,  1, 2,  14, &z8002_device::Z64_ddN0_imm4_addr },
-	{ 0x6500, 0x650f,  1, 2,  13, &z8002_device::Z65_0000_imm4_addr },
-	{ 0x6510, 0x65ff,  1, 2,  14, &z8002_device::Z65_ddN0_imm4_addr },
-	{ 0x6600, 0x660f,  1, 2,  10, &z8002_device::Z66_0000_imm4_addr },
-	{ 0x6610, 0x66ff,  1, 2,  11, &z8002_device::Z66_ddN0_imm4_addr },
-	{ 0x6700, 0x670f,  1, 2,  10, &z8002_device::Z67_0000_imm4_addr },
-	{ 0x6710, 0x67ff,  1, 2,  11, &z8002_device::Z67_ddN0_imm4_addr },
-	{ 0x6800, 0x680f,  1, 2,  13, &z8002_device::Z68_0000_imm4m1_addr },
-	{ 0x6810, 0x68ff,  1, 2,  14, &z8002_device::Z68_ddN0_imm4m1_addr },
-	{ 0x6900, 0x690f,  1, 2,  13, &z8002_device::Z69_0000_imm4m1_addr },
-	{ 0x6910, 0x69ff,  1, 2,  14, &z8002_device::Z69_ddN0_imm4m1_addr },
-	{ 0x6a00, 0x6a0f,  1, 2,  13, &z8002_device::Z6A_0000_imm4m1_addr },
-	{ 0x6a10, 0x6aff,  1, 2,  14, &z8002_device::Z6A_ddN0_imm4m1_addr },
-	{ 0x6b00, 0x6b0f,  1, 2,  13, &z8002_device::Z6B_0000_imm4m1_addr },
-	{ 0x6b10, 0x6bff,  1, 2,  14, &z8002_device::Z6B_ddN0_imm4m1_addr },
-	{ 0x6c00, 0x6c0f,  1, 2,  15, &z8002_device::Z6C_0000_dddd_addr },
-	{ 0x6c10, 0x6cff,  1, 2,  16, &z8002_device::Z6C_ssN0_dddd_addr },
-	{ 0x6d00, 0x6d0f,  1, 2,  15, &z8002_device::Z6D_0000_dddd_addr },
-	{ 0x6d10, 0x6dff,  1, 2,  16, &z8002_device::Z6D_ssN0_dddd_addr },
-	{ 0x6e00, 0x6e0f,  1, 2,  11, &z8002_device::Z6E_0000_ssss_addr },
-	{ 0x6e10, 0x6eff,  1, 2,  11, &z8002_device::Z6E_ddN0_ssss_addr },
-	{ 0x6f00, 0x6f0f,  1, 2,  11, &z8002_device::Z6F_0000_ssss_addr },
-	{ 0x6f10, 0x6fff,  1, 2,  12, &z8002_device::Z6F_ddN0_ssss_addr },
-	{ 0x7010, 0x70ff,  1, 2,  14, &z8002_device::Z70_ssN0_dddd_0000_xxxx_0000_0000 },
-	{ 0x7110, 0x71ff,  1, 2,  14, &z8002_device::Z71_ssN0_dddd_0000_xxxx_0000_0000 },
-	{ 0x7210, 0x72ff,  1, 2,  14, &z8002_device::Z72_ddN0_ssss_0000_xxxx_0000_0000 },
-	{ 0x7310, 0x73ff,  1, 2,  14, &z8002_device::Z73_ddN0_ssss_0000_xxxx_0000_0000 },
-	{ 0x7410, 0x74ff,  1, 2,  15, &z8002_device::Z74_ssN0_dddd_0000_xxxx_0000_0000 },
-	{ 0x7510, 0x75ff,  1, 2,  17, &z8002_device::Z75_ssN0_dddd_0000_xxxx_0000_0000 },
-	{ 0x7600, 0x760f,  1, 2,  12, &z8002_device::Z76_0000_dddd_addr },
-	{ 0x7610, 0x76ff,  1, 2,  13, &z8002_device::Z76_ssN0_dddd_addr },
-	{ 0x7710, 0x77ff,  1, 2,  17, &z8002_device::Z77_ddN0_ssss_0000_xxxx_0000_0000 },
-	{ 0x7800, 0x78ff,  1, 1,  10, &z8002_device::Z78_imm8 },
-	{ 0x7900, 0x7900,  1, 2,  16, &z8002_device::Z79_0000_0000_addr },
-	{ 0x7910, 0x79f0, 16, 2,  17, &z8002_device::Z79_ssN0_0000_addr },
-	{ 0x7a00, 0x7a00,  1, 1,   8, &z8002_device::Z7A_0000_0000 },
-	{ 0x7b00, 0x7b00,  1, 1,  13, &z8002_device::Z7B_0000_0000 },
-	{ 0x7b08, 0x7b08,  1, 1,   5, &z8002_device::Z7B_0000_1000 },
-	{ 0x7b09, 0x7b09,  1, 1,   5, &z8002_device::Z7B_0000_1001 },
-	{ 0x7b0a, 0x7b0a,  1, 1,   7, &z8002_device::Z7B_0000_1010 },
-	{ 0x7b0d, 0x7bfd, 16, 1,  12, &z8002_device::Z7B_dddd_1101 },
-	{ 0x7c00, 0x7c03,  1, 1,   7, &z8002_device::Z7C_0000_00ii },
-	{ 0x7c04, 0x7c07,  1, 1,   7, &z8002_device::Z7C_0000_01ii },
-	{ 0x7d00, 0x7df0, 16, 1,   7, &z8002_device::Z7D_dddd_0ccc },
-	{ 0x7d01, 0x7df1, 16, 1,   7, &z8002_device::Z7D_dddd_0ccc },
-	{ 0x7d02, 0x7df2, 16, 1,   7, &z8002_device::Z7D_dddd_0ccc },
-	{ 0x7d03, 0x7df3, 16, 1,   7, &z8002_device::Z7D_dddd_0ccc },
-	{ 0x7d04, 0x7df4, 16, 1,   7, &z8002_device::Z7D_dddd_0ccc },
-	{ 0x7d05, 0x7df5, 16, 1,   7, &z8002_device::Z7D_dddd_0ccc },
-	{ 0x7d06, 0x7df6, 16, 1,   7, &z8002_device::Z7D_dddd_0ccc },
-	{ 0x7d07, 0x7df7, 16, 1,   7, &z8002_device::Z7D_dddd_0ccc },
-	{ 0x7d08, 0x7df8, 16, 1,   7, &z8002_device::Z7D_ssss_1ccc },
-	{ 0x7d09, 0x7df9, 16, 1,   7, &z8002_device::Z7D_ssss_1ccc },
-	{ 0x7d0a, 0x7dfa, 16, 1,   7, &z8002_device::Z7D_ssss_1ccc },
-	{ 0x7d0b, 0x7dfb, 16, 1,   7, &z8002_device::Z7D_ssss_1ccc },
-	{ 0x7d0c, 0x7dfc, 16, 1,   7, &z8002_device::Z7D_ssss_1ccc },
-	{ 0x7d0d, 0x7dfd, 16, 1,   7, &z8002_device::Z7D_ssss_1ccc },
-	{ 0x7d0e, 0x7dfe, 16, 1,   7, &z8002_device::Z7D_ssss_1ccc },
-	{ 0x7d0f, 0x7dff, 16, 1,   7, &z8002_device::Z7D_ssss_1ccc },
-	{ 0x7e00, 0x7eff,  1, 1,  10, &z8002_device::Z7E_imm8 },
-	{ 0x7f00, 0x7fff,  1, 1,  33, &z8002_device::Z7F_imm8 },
-	{ 0x8000, 0x80ff,  1, 1,   4, &z8002_device::Z80_ssss_dddd },
-	{ 0x8100, 0x81ff,  1, 1,   4, &z8002_device::Z81_ssss_dddd },
-	{ 0x8200, 0x82ff,  1, 1,   4, &z8002_device::Z82_ssss_dddd },
-	{ 0x8300, 0x83ff,  1, 1,   4, &z8002_device::Z83_ssss_dddd },
-	{ 0x8400, 0x84ff,  1, 1,   4, &z8002_device::Z84_ssss_dddd },
-	{ 0x8500, 0x85ff,  1, 1,   4, &z8002_device::Z85_ssss_dddd },
-	{ 0x8600, 0x86ff,  1, 1,   4, &z8002_device::Z86_ssss_dddd },
-	{ 0x8700, 0x87ff,  1, 1,   4, &z8002_device::Z87_ssss_dddd },
-	{ 0x8800, 0x88ff,  1, 1,   4, &z8002_device::Z88_ssss_dddd },
-	{ 0x8900, 0x89ff,  1, 1,   4, &z8002_device::Z89_ssss_dddd },
-	{ 0x8a00, 0x8aff,  1, 1,   4, &z8002_device::Z8A_ssss_dddd },
-	{ 0x8b00, 0x8bff,  1, 1,   4, &z8002_device::Z8B_ssss_dddd },
-	{ 0x8c00, 0x8cf0, 16, 1,   7, &z8002_device::Z8C_dddd_0000 },
-	{ 0x8c02, 0x8cf2, 16, 1,   7, &z8002_device::Z8C_dddd_0010 },
-	{ 0x8c04, 0x8cf4, 16, 1,   7, &z8002_device::Z8C_dddd_0100 },
-	{ 0x8c06, 0x8cf6, 16, 1,   7, &z8002_device::Z8C_dddd_0110 },
-	{ 0x8c01, 0x8cf1, 16, 1,   7, &z8002_device::Z8C_dddd_0001 },
-	{ 0x8c08, 0x8cf8, 16, 1,   7, &z8002_device::Z8C_dddd_1000 },
-	{ 0x8c09, 0x8cf9, 16, 1,   7, &z8002_device::Z8C_dddd_1001 },
-	{ 0x8d00, 0x8df0, 16, 1,   7, &z8002_device::Z8D_dddd_0000 },
-	{ 0x8d01, 0x8df1, 16, 1,   7, &z8002_device::Z8D_imm4_0001 },
-	{ 0x8d02, 0x8df2, 16, 1,   7, &z8002_device::Z8D_dddd_0010 },
-	{ 0x8d03, 0x8df3, 16, 1,   7, &z8002_device::Z8D_imm4_0011 },
-	{ 0x8d04, 0x8df4, 16, 1,   7, &z8002_device::Z8D_dddd_0100 },
-	{ 0x8d05, 0x8df5, 16, 1,   7, &z8002_device::Z8D_imm4_0101 },
-	{ 0x8d06, 0x8df6, 16, 1,   7, &z8002_device::Z8D_dddd_0110 },
-	{ 0x8d07, 0x8d07,  1, 1,   7, &z8002_device::Z8D_0000_0111 },
-	{ 0x8d08, 0x8df8, 16, 1,   7, &z8002_device::Z8D_dddd_1000 },
-	{ 0x8e00, 0x8eff,  1, 1,  10, &z8002_device::Z8E_imm8 },
-	{ 0x8f00, 0x8fff,  1, 1,  10, &z8002_device::Z8F_imm8 },
-	{ 0x9000, 0x90ff,  1, 1,   8, &z8002_device::Z90_ssss_dddd },
-	{ 0x9110, 0x91ff,  1, 1,  12, &z8002_device::Z91_ddN0_ssss },
-	{ 0x9200, 0x92ff,  1, 1,   8, &z8002_device::Z92_ssss_dddd },
-	{ 0x9310, 0x93ff,  1, 1,   9, &z8002_device::Z93_ddN0_ssss },
-	{ 0x9400, 0x94ff,  1, 1,   5, &z8002_device::Z94_ssss_dddd },
-	{ 0x9510, 0x95ff,  1, 1,  12, &z8002_device::Z95_ssN0_dddd },
-	{ 0x9600, 0x96ff,  1, 1,   8, &z8002_device::Z96_ssss_dddd },
-	{ 0x9710, 0x97ff,  1, 1,   8, &z8002_device::Z97_ssN0_dddd },
-	{ 0x9800, 0x98ff,  1, 1, 282, &z8002_device::Z98_ssss_dddd },
-	{ 0x9900, 0x99ff,  1, 1,  70, &z8002_device::Z99_ssss_dddd },
-	{ 0x9a00, 0x9aff,  1, 1, 744, &z8002_device::Z9A_ssss_dddd },
-	{ 0x9b00, 0x9bff,  1, 1, 107, &z8002_device::Z9B_ssss_dddd },
-	{ 0x9c00, 0x9cf8,  8, 1,  13, &z8002_device::Z9C_dddd_1000 },
-	{ 0x9d00, 0x9dff,  1, 1,  10, &z8002_device::Z9D_imm8 },
-	{ 0x9e00, 0x9e0f,  1, 1,  10, &z8002_device::Z9E_0000_cccc },
-	{ 0x9f00, 0x9fff,  1, 1,  10, &z8002_device::Z9F_imm8 },
-	{ 0xa000, 0xa0ff,  1, 1,   3, &z8002_device::ZA0_ssss_dddd },
-	{ 0xa100, 0xa1ff,  1, 1,   3, &z8002_device::ZA1_ssss_dddd },
-	{ 0xa200, 0xa2ff,  1, 1,   4, &z8002_device::ZA2_dddd_imm4 },
-	{ 0xa300, 0xa3ff,  1, 1,   4, &z8002_device::ZA3_dddd_imm4 },
-	{ 0xa400, 0xa4ff,  1, 1,   4, &z8002_device::ZA4_dddd_imm4 },
-	{ 0xa500, 0xa5ff,  1, 1,   4, &z8002_device::ZA5_dddd_imm4 },
-	{ 0xa600, 0xa6ff,  1, 1,   4, &z8002_device::ZA6_dddd_imm4 },
-	{ 0xa700, 0xa7ff,  1, 1,   4, &z8002_device::ZA7_dddd_imm4 },
-	{ 0xa800, 0xa8ff,  1, 1,   4, &z8002_device::ZA8_dddd_imm4m1 },
-	{ 0xa900, 0xa9ff,  1, 1,   4, &z8002_device::ZA9_dddd_imm4m1 },
-	{ 0xaa00, 0xaaff,  1, 1,   4, &z8002_device::ZAA_dddd_imm4m1 },
-	{ 0xab00, 0xabff,  1, 1,   4, &z8002_device::ZAB_dddd_imm4m1 },
-	{ 0xac00, 0xacff,  1, 1,   6, &z8002_device::ZAC_ssss_dddd },
-	{ 0xad00, 0xadff,  1, 1,   6, &z8002_device::ZAD_ssss_dddd },
-	{ 0xae00, 0xaeff,  1, 1,   5, &z8002_device::ZAE_dddd_cccc },
-	{ 0xaf00, 0xafff,  1, 1,   5, &z8002_device::ZAF_dddd_cccc },
-	{ 0xb000, 0xb0f0, 16, 1,   5, &z8002_device::ZB0_dddd_0000 },
-	{ 0xb100, 0xb1f0, 16, 1,  11, &z8002_device::ZB1_dddd_0000 },
-	{ 0xb107, 0xb1f7, 16, 1,  11, &z8002_device::ZB1_dddd_0111 },
-	{ 0xb10a, 0xb1fa, 16, 1,  11, &z8002_device::ZB1_dddd_1010 },
-	{ 0xb200, 0xb2f0, 16, 1,   6, &z8002_device::ZB2_dddd_00I0 },
-	{ 0xb201, 0xb2f1, 16, 2,  13, &z8002_device::ZB2_dddd_0001_imm8 },
-	{ 0xb202, 0xb2f2, 16, 1,   6, &z8002_device::ZB2_dddd_00I0 },
-	{ 0xb203, 0xb2f3, 16, 2,  15, &z8002_device::ZB2_dddd_0011_0000_ssss_0000_0000 },
-	{ 0xb204, 0xb2f4, 16, 1,   6, &z8002_device::ZB2_dddd_01I0 },
-	{ 0xb206, 0xb2f6, 16, 1,   6, &z8002_device::ZB2_dddd_01I0 },
-	{ 0xb208, 0xb2f8, 16, 1,   9, &z8002_device::ZB2_dddd_10I0 },
-	{ 0xb209, 0xb2f9, 16, 2,  13, &z8002_device::ZB2_dddd_1001_imm8 },
-	{ 0xb20a, 0xb2fa, 16, 1,   9, &z8002_device::ZB2_dddd_10I0 },
-	{ 0xb20b, 0xb2fb, 16, 2,  15, &z8002_device::ZB2_dddd_1011_0000_ssss_0000_0000 },
-	{ 0xb20c, 0xb2fc, 16, 1,   9, &z8002_device::ZB2_dddd_11I0 },
-	{ 0xb20e, 0xb2fe, 16, 1,   9, &z8002_device::ZB2_dddd_11I0 },
-	{ 0xb300, 0xb3f0, 16, 1,   6, &z8002_device::ZB3_dddd_00I0 },
-	{ 0xb301, 0xb3f1, 16, 2,  13, &z8002_device::ZB3_dddd_0001_imm8 },
-	{ 0xb302, 0xb3f2, 16, 1,   6, &z8002_device::ZB3_dddd_00I0 },
-	{ 0xb303, 0xb3f3, 16, 2,  15, &z8002_device::ZB3_dddd_0011_0000_ssss_0000_0000 },
-	{ 0xb304, 0xb3f4, 16, 1,   6, &z8002_device::ZB3_dddd_01I0 },
-	{ 0xb305, 0xb3f5, 16, 2,  13, &z8002_device::ZB3_dddd_0101_imm8 },
-	{ 0xb306, 0xb3f6, 16, 1,   6, &z8002_device::ZB3_dddd_01I0 },
-	{ 0xb307, 0xb3f7, 16, 2,  15, &z8002_device::ZB3_dddd_0111_0000_ssss_0000_0000 },
-	{ 0xb308, 0xb3f8, 16, 1,   6, &z8002_device::ZB3_dddd_10I0 },
-	{ 0xb309, 0xb3f9, 16, 2,  13, &z8002_device::ZB3_dddd_1001_imm8 },
-	{ 0xb30a, 0xb3fa, 16, 1,   6, &z8002_device::ZB3_dddd_10I0 },
-	{ 0xb30b, 0xb3fb, 16, 2,  15, &z8002_device::ZB3_dddd_1011_0000_ssss_0000_0000 },
-	{ 0xb30c, 0xb3fc, 16, 1,   6, &z8002_device::ZB3_dddd_11I0 },
-	{ 0xb30d, 0xb3fd, 16, 2,  13, &z8002_device::ZB3_dddd_1101_imm8 },
-	{ 0xb30e, 0xb3fe, 16, 1,   6, &z8002_device::ZB3_dddd_11I0 },
-	{ 0xb30f, 0xb3ff, 16, 2,  15, &z8002_device::ZB3_dddd_1111_0000_ssss_0000_0000 },
-	{ 0xb400, 0xb4ff,  1, 1,   5, &z8002_device::ZB4_ssss_dddd },
-	{ 0xb500, 0xb5ff,  1, 1,   5, &z8002_device::ZB5_ssss_dddd },
-	{ 0xb600, 0xb6ff,  1, 1,   5, &z8002_device::ZB6_ssss_dddd },
-	{ 0xb700, 0xb7ff,  1, 1,   5, &z8002_device::ZB7_ssss_dddd },
-	{ 0xb810, 0xb8f0, 16, 2,  25, &z8002_device::ZB8_ddN0_0000_0000_rrrr_ssN0_0000 },
-	{ 0xb812, 0xb8f2, 16, 2,  25, &z8002_device::ZB8_ddN0_0010_0000_rrrr_ssN0_0000 },
-	{ 0xb814, 0xb8f4, 16, 2,  25, &z8002_device::ZB8_ddN0_0100_0000_rrrr_ssN0_0000 },
-	{ 0xb816, 0xb8f6, 16, 2,  25, &z8002_device::ZB8_ddN0_0110_0000_rrrr_ssN0_1110 },
-	{ 0xb818, 0xb8f8, 16, 2,  25, &z8002_device::ZB8_ddN0_1000_0000_rrrr_ssN0_0000 },
-	{ 0xb81a, 0xb8fa, 16, 2,  25, &z8002_device::ZB8_ddN0_1010_0000_rrrr_ssN0_0000 },
-	{ 0xb81c, 0xb8fc, 16, 2,  25, &z8002_device::ZB8_ddN0_1100_0000_rrrr_ssN0_0000 },
-	{ 0xb81e, 0xb8fe, 16, 2,  25, &z8002_device::ZB8_ddN0_1110_0000_rrrr_ssN0_1110 },
-	{ 0xb900, 0xb9ff, 16, 1,  10, &z8002_device::ZB9_imm8 },
-	{ 0xba10, 0xbaf0, 16, 2,  11, &z8002_device::ZBA_ssN0_0000_0000_rrrr_dddd_cccc },
-	{ 0xba11, 0xbaf1, 16, 2,  11, &z8002_device::ZBA_ssN0_0001_0000_rrrr_ddN0_x000 },
-	{ 0xba12, 0xbaf2, 16, 2,  11, &z8002_device::ZBA_ssN0_0010_0000_rrrr_ddN0_cccc },
-	{ 0xba14, 0xbaf4, 16, 2,  11, &z8002_device::ZBA_ssN0_0100_0000_rrrr_dddd_cccc },
-	{ 0xba16, 0xbaf6, 16, 2,  11, &z8002_device::ZBA_ssN0_0110_0000_rrrr_ddN0_cccc },
-	{ 0xba18, 0xbaf8, 16, 2,  11, &z8002_device::ZBA_ssN0_1000_0000_rrrr_dddd_cccc },
-	{ 0xba19, 0xbaf9, 16, 2,  11, &z8002_device::ZBA_ssN0_1001_0000_rrrr_ddN0_x000 },
-	{ 0xba1a, 0xbafa, 16, 2,  11, &z8002_device::ZBA_ssN0_1010_0000_rrrr_ddN0_cccc },
-	{ 0xba1c, 0xbafc, 16, 2,  11, &z8002_device::ZBA_ssN0_1100_0000_rrrr_dddd_cccc },
-	{ 0xba1e, 0xbafe, 16, 2,  11, &z8002_device::ZBA_ssN0_1110_0000_rrrr_ddN0_cccc },
-	{ 0xbb10, 0xbbf0, 16, 2,  11, &z8002_device::ZBB_ssN0_0000_0000_rrrr_dddd_cccc },
-	{ 0xbb11, 0xbbf1, 16, 2,  11, &z8002_device::ZBB_ssN0_0001_0000_rrrr_ddN0_x000 },
-	{ 0xbb12, 0xbbf2, 16, 2,  11, &z8002_device::ZBB_ssN0_0010_0000_rrrr_ddN0_cccc },
-	{ 0xbb14, 0xbbf4, 16, 2,  11, &z8002_device::ZBB_ssN0_0100_0000_rrrr_dddd_cccc },
-	{ 0xbb16, 0xbbf6, 16, 2,  11, &z8002_device::ZBB_ssN0_0110_0000_rrrr_ddN0_cccc },
-	{ 0xbb18, 0xbbf8, 16, 2,  11, &z8002_device::ZBB_ssN0_1000_0000_rrrr_dddd_cccc },
-	{ 0xbb19, 0xbbf9, 16, 2,  11, &z8002_device::ZBB_ssN0_1001_0000_rrrr_ddN0_x000 },
-	{ 0xbb1a, 0xbbfa, 16, 2,  11, &z8002_device::ZBB_ssN0_1010_0000_rrrr_ddN0_cccc },
-	{ 0xbb1c, 0xbbfc, 16, 2,  11, &z8002_device::ZBB_ssN0_1100_0000_rrrr_dddd_cccc },
-	{ 0xbb1e, 0xbbfe, 16, 2,  11, &z8002_device::ZBB_ssN0_1110_0000_rrrr_ddN0_cccc },
-	{ 0xbc00, 0xbcff,  1, 1,   9, &z8002_device::ZBC_aaaa_bbbb },
-	{ 0xbd00, 0xbdff,  1, 1,   5, &z8002_device::ZBD_dddd_imm4 },
-	{ 0xbe00, 0xbeff,  1, 1,   9, &z8002_device::ZBE_aaaa_bbbb },
-	{ 0xbf00, 0xbfff,  1, 1,  10, &z8002_device::ZBF_imm8 },
-	{ 0xc000, 0xcfff,  1, 1,   5, &z8002_device::ZC_dddd_imm8 },
-	{ 0xd000, 0xdfff,  1, 1,  10, &z8002_device::ZD_dsp12 },
-	{ 0xe000, 0xefff,  1, 1,   6, &z8002_device::ZE_cccc_dsp8 },
-	{ 0xf000, 0xf07f,  1, 1,  11, &z8002_device::ZF_dddd_0dsp7 },
-	{ 0xf100, 0xf17f,  1, 1,  11, &z8002_device::ZF_dddd_0dsp7 },
-	{ 0xf200, 0xf27f,  1, 1,  11, &z8002_device::ZF_dddd_0dsp7 },
-	{ 0xf300, 0xf37f,  1, 1,  11, &z8002_device::ZF_dddd_0dsp7 },
-	{ 0xf400, 0xf47f,  1, 1,  11, &z8002_device::ZF_dddd_0dsp7 },
-	{ 0xf500, 0xf57f,  1, 1,  11, &z8002_device::ZF_dddd_0dsp7 },
-	{ 0xf600, 0xf67f,  1, 1,  11, &z8002_device::ZF_dddd_0dsp7 },
-	{ 0xf700, 0xf77f,  1, 1,  11, &z8002_device::ZF_dddd_0dsp7 },
-	{ 0xf800, 0xf87f,  1, 1,  11, &z8002_device::ZF_dddd_0dsp7 },
-	{ 0xf900, 0xf97f,  1, 1,  11, &z8002_device::ZF_dddd_0dsp7 },
-	{ 0xfa00, 0xfa7f,  1, 1,  11, &z8002_device::ZF_dddd_0dsp7 },
-	{ 0xfb00, 0xfb7f,  1, 1,  11, &z8002_device::ZF_dddd_0dsp7 },
-	{ 0xfc00, 0xfc7f,  1, 1,  11, &z8002_device::ZF_dddd_0dsp7 },
-	{ 0xfd00, 0xfd7f,  1, 1,  11, &z8002_device::ZF_dddd_0dsp7 },
-	{ 0xfe00, 0xfe7f,  1, 1,  11, &z8002_device::ZF_dddd_0dsp7 },
-	{ 0xff00, 0xff7f,  1, 1,  11, &z8002_device::ZF_dddd_0dsp7 },
-	{ 0xf080, 0xf0ff,  1, 1,  11, &z8002_device::ZF_dddd_1dsp7 },
-	{ 0xf180, 0xf1ff,  1, 1,  11, &z8002_device::ZF_dddd_1dsp7 },
-	{ 0xf280, 0xf2ff,  1, 1,  11, &z8002_device::ZF_dddd_1dsp7 },
-	{ 0xf380, 0xf3ff,  1, 1,  11, &z8002_device::ZF_dddd_1dsp7 },
-	{ 0xf480, 0xf4ff,  1, 1,  11, &z8002_device::ZF_dddd_1dsp7 },
-	{ 0xf580, 0xf5ff,  1, 1,  11, &z8002_device::ZF_dddd_1dsp7 },
-	{ 0xf680, 0xf6ff,  1, 1,  11, &z8002_device::ZF_dddd_1dsp7 },
-	{ 0xf780, 0xf7ff,  1, 1,  11, &z8002_device::ZF_dddd_1dsp7 },
-	{ 0xf880, 0xf8ff,  1, 1,  11, &z8002_device::ZF_dddd_1dsp7 },
-	{ 0xf980, 0xf9ff,  1, 1,  11, &z8002_device::ZF_dddd_1dsp7 },
-	{ 0xfa80, 0xfaff,  1, 1,  11, &z8002_device::ZF_dddd_1dsp7 },
-	{ 0xfb80, 0xfbff,  1, 1,  11, &z8002_device::ZF_dddd_1dsp7 },
-	{ 0xfc80, 0xfcff,  1, 1,  11, &z8002_device::ZF_dddd_1dsp7 },
-	{ 0xfd80, 0xfdff,  1, 1,  11, &z8002_device::ZF_dddd_1dsp7 },
-	{ 0xfe80, 0xfeff,  1, 1,  11, &z8002_device::ZF_dddd_1dsp7 },
-	{ 0xff80, 0xffff,  1, 1,  11, &z8002_device::ZF_dddd_1dsp7 },
-	{ 0,      0,       0, 0,   0, nullptr },
+constexpr z8002_device::Z8000_init z8002_device::table[] = {
+	{ 0x0000, 0xffff,  1, 1,   4, OPS(zinvalid) },
+
+	{ 0x0000, 0x000f,  1, 2,   7, OPS(Z00_0000_dddd_imm8) },
+	{ 0x0010, 0x00ff,  1, 1,   7, OPS(Z00_ssN0_dddd) },
+	{ 0x0100, 0x010f,  1, 2,   7, OPS(Z01_0000_dddd_imm16) },
+	{ 0x0110, 0x01ff,  1, 1,   7, OPS(Z01_ssN0_dddd) },
+	{ 0x0200, 0x020f,  1, 2,   7, OPS(Z02_0000_dddd_imm8) },
+	{ 0x0210, 0x02ff,  1, 1,   7, OPS(Z02_ssN0_dddd) },
+	{ 0x0300, 0x030f,  1, 2,   7, OPS(Z03_0000_dddd_imm16) },
+	{ 0x0310, 0x03ff,  1, 1,   7, OPS(Z03_ssN0_dddd) },
+	{ 0x0400, 0x040f,  1, 2,   7, OPS(Z04_0000_dddd_imm8) },
+	{ 0x0410, 0x04ff,  1, 1,   7, OPS(Z04_ssN0_dddd) },
+	{ 0x0500, 0x050f,  1, 2,   7, OPS(Z05_0000_dddd_imm16) },
+	{ 0x0510, 0x05ff,  1, 1,   7, OPS(Z05_ssN0_dddd) },
+	{ 0x0600, 0x060f,  1, 2,   7, OPS(Z06_0000_dddd_imm8) },
+	{ 0x0610, 0x06ff,  1, 1,   7, OPS(Z06_ssN0_dddd) },
+	{ 0x0700, 0x070f,  1, 2,   7, OPS(Z07_0000_dddd_imm16) },
+	{ 0x0710, 0x07ff,  1, 1,   7, OPS(Z07_ssN0_dddd) },
+	{ 0x0800, 0x080f,  1, 2,   7, OPS(Z08_0000_dddd_imm8) },
+	{ 0x0810, 0x08ff,  1, 1,   7, OPS(Z08_ssN0_dddd) },
+	{ 0x0900, 0x090f,  1, 2,   7, OPS(Z09_0000_dddd_imm16) },
+	{ 0x0910, 0x09ff,  1, 1,   7, OPS(Z09_ssN0_dddd) },
+	{ 0x0a00, 0x0a0f,  1, 2,   7, OPS(Z0A_0000_dddd_imm8) },
+	{ 0x0a10, 0x0aff,  1, 1,   7, OPS(Z0A_ssN0_dddd) },
+	{ 0x0b00, 0x0b0f,  1, 2,   7, OPS(Z0B_0000_dddd_imm16) },
+	{ 0x0b10, 0x0bff,  1, 1,   7, OPS(Z0B_ssN0_dddd) },
+	{ 0x0c10, 0x0cf0, 16, 1,  12, OPS(Z0C_ddN0_0000) },
+	{ 0x0c11, 0x0cf1, 16, 2,  11, OPS(Z0C_ddN0_0001_imm8) },
+	{ 0x0c12, 0x0cf2, 16, 1,  12, OPS(Z0C_ddN0_0010) },
+	{ 0x0c14, 0x0cf4, 16, 1,   8, OPS(Z0C_ddN0_0100) },
+	{ 0x0c15, 0x0cf5, 16, 2,   7, OPS(Z0C_ddN0_0101_imm8) },
+	{ 0x0c16, 0x0cf6, 16, 1,  11, OPS(Z0C_ddN0_0110) },
+	{ 0x0c18, 0x0cf8, 16, 1,   8, OPS(Z0C_ddN0_1000) },
+	{ 0x0d10, 0x0df0, 16, 1,  12, OPS(Z0D_ddN0_0000) },
+	{ 0x0d11, 0x0df1, 16, 2,  11, OPS(Z0D_ddN0_0001_imm16) },
+	{ 0x0d12, 0x0df2, 16, 1,  12, OPS(Z0D_ddN0_0010) },
+	{ 0x0d14, 0x0df4, 16, 1,   8, OPS(Z0D_ddN0_0100) },
+	{ 0x0d15, 0x0df5, 16, 2,  11, OPS(Z0D_ddN0_0101_imm16) }, /* fix cycles ld IR,IM */
+	{ 0x0d16, 0x0df6, 16, 1,  11, OPS(Z0D_ddN0_0110) },
+	{ 0x0d18, 0x0df8, 16, 1,   8, OPS(Z0D_ddN0_1000) },
+	{ 0x0d19, 0x0df9, 16, 2,  12, OPS(Z0D_ddN0_1001_imm16) },
+	{ 0x0e00, 0x0eff,  1, 1,  10, OPS(Z0E_imm8) },
+	{ 0x0f00, 0x0fff,  1, 1,  10, OPS(Z0F_imm8) },
+	{ 0x1000, 0x100f,  1, 3,  14, OPS(Z10_0000_dddd_imm32) },
+	{ 0x1010, 0x10ff,  1, 1,  14, OPS(Z10_ssN0_dddd) },
+	{ 0x1111, 0x11ff,  1, 1,  20, OPS(Z11_ddN0_ssN0) },
+	{ 0x1200, 0x120f,  1, 3,  14, OPS(Z12_0000_dddd_imm32) },
+	{ 0x1210, 0x12ff,  1, 1,  14, OPS(Z12_ssN0_dddd) },
+	{ 0x1311, 0x13ff,  1, 1,  13, OPS(Z13_ddN0_ssN0) },
+	{ 0x1400, 0x140f,  1, 3,  11, OPS(Z14_0000_dddd_imm32) },
+	{ 0x1410, 0x14ff,  1, 1,  11, OPS(Z14_ssN0_dddd) },
+	{ 0x1511, 0x15ff,  1, 1,  19, OPS(Z15_ssN0_ddN0) },
+	{ 0x1600, 0x160f,  1, 3,  14, OPS(Z16_0000_dddd_imm32) },
+	{ 0x1610, 0x16ff,  1, 1,  14, OPS(Z16_ssN0_dddd) },
+	{ 0x1711, 0x17ff,  1, 1,  12, OPS(Z17_ssN0_ddN0) },
+	{ 0x1800, 0x180f,  1, 1, 282, OPS(Z18_00N0_dddd_imm32) },
+	{ 0x1810, 0x18ff,  1, 1, 282, OPS(Z18_ssN0_dddd) },
+	{ 0x1900, 0x190f,  1, 2,  70, OPS(Z19_0000_dddd_imm16) },
+	{ 0x1910, 0x19ff,  1, 1,  70, OPS(Z19_ssN0_dddd) },
+	{ 0x1a00, 0x1a0f,  1, 3, 744, OPS(Z1A_0000_dddd_imm32) },
+	{ 0x1a10, 0x1aff,  1, 1, 744, OPS(Z1A_ssN0_dddd) },
+	{ 0x1b00, 0x1b0f,  1, 2, 107, OPS(Z1B_0000_dddd_imm16) },
+	{ 0x1b10, 0x1bff,  1, 1, 107, OPS(Z1B_ssN0_dddd) },
+	{ 0x1c11, 0x1cf1, 16, 2,  11, OPS(Z1C_ssN0_0001_0000_dddd_0000_nmin1) },
+	{ 0x1c18, 0x1cf8, 16, 1,  13, OPS(Z1C_ddN0_1000) },
+	{ 0x1c19, 0x1cf9, 16, 2,  11, OPS(Z1C_ddN0_1001_0000_ssss_0000_nmin1) },
+	{ 0x1d10, 0x1dff,  1, 1,  11, OPS(Z1D_ddN0_ssss) },
+	{ 0x1e10, 0x1eff,  1, 1,  10, OPS(Z1E_ddN0_cccc) },
+	{ 0x1f10, 0x1ff0, 16, 1,  10, OPS(Z1F_ddN0_0000) },
+	{ 0x2000, 0x200f,  1, 2,   7, OPS(Z20_0000_dddd_imm8) },
+	{ 0x2010, 0x20ff,  1, 1,   7, OPS(Z20_ssN0_dddd) },
+	{ 0x2100, 0x210f,  1, 2,   7, OPS(Z21_0000_dddd_imm16) },
+	{ 0x2110, 0x21ff,  1, 1,   7, OPS(Z21_ssN0_dddd) },
+	{ 0x2200, 0x220f,  1, 2,  10, OPS(Z22_0000_ssss_0000_dddd_0000_0000) },
+	{ 0x2210, 0x22ff,  1, 1,  11, OPS(Z22_ddN0_imm4) },
+	{ 0x2300, 0x230f,  1, 2,  10, OPS(Z23_0000_ssss_0000_dddd_0000_0000) },
+	{ 0x2310, 0x23ff,  1, 1,  11, OPS(Z23_ddN0_imm4) },
+	{ 0x2400, 0x240f,  1, 2,  10, OPS(Z24_0000_ssss_0000_dddd_0000_0000) },
+	{ 0x2410, 0x24ff,  1, 1,  11, OPS(Z24_ddN0_imm4) },
+	{ 0x2500, 0x250f,  1, 2,  10, OPS(Z25_0000_ssss_0000_dddd_0000_0000) },
+	{ 0x2510, 0x25ff,  1, 1,  11, OPS(Z25_ddN0_imm4) },
+	{ 0x2600, 0x260f,  1, 2,  10, OPS(Z26_0000_ssss_0000_dddd_0000_0000) },
+	{ 0x2610, 0x26ff,  1, 1,   8, OPS(Z26_ddN0_imm4) },
+	{ 0x2700, 0x270f,  1, 2,  10, OPS(Z27_0000_ssss_0000_dddd_0000_0000) },
+	{ 0x2710, 0x27ff,  1, 1,   8, OPS(Z27_ddN0_imm4) },
+	{ 0x2810, 0x28ff,  1, 1,  11, OPS(Z28_ddN0_imm4m1) },
+	{ 0x2910, 0x29ff,  1, 1,  11, OPS(Z29_ddN0_imm4m1) },
+	{ 0x2a10, 0x2aff,  1, 1,  11, OPS(Z2A_ddN0_imm4m1) },
+	{ 0x2b10, 0x2bff,  1, 1,  11, OPS(Z2B_ddN0_imm4m1) },
+	{ 0x2c10, 0x2cff,  1, 1,  12, OPS(Z2C_ssN0_dddd) },
+	{ 0x2d10, 0x2dff,  1, 1,  12, OPS(Z2D_ssN0_dddd) },
+	{ 0x2e10, 0x2eff,  1, 1,   8, OPS(Z2E_ddN0_ssss) },
+	{ 0x2f10, 0x2fff,  1, 1,   8, OPS(Z2F_ddN0_ssss) },
+	{ 0x3000, 0x300f,  1, 2,  14, OPS(Z30_0000_dddd_dsp16) },
+	{ 0x3010, 0x30ff,  1, 2,  14, OPS(Z30_ssN0_dddd_imm16) },
+	{ 0x3100, 0x310f,  1, 2,  14, OPS(Z31_0000_dddd_dsp16) },
+	{ 0x3110, 0x31ff,  1, 2,  14, OPS(Z31_ssN0_dddd_imm16) },
+	{ 0x3200, 0x320f,  1, 2,  14, OPS(Z32_0000_ssss_dsp16) },
+	{ 0x3210, 0x32ff,  1, 2,  14, OPS(Z32_ddN0_ssss_imm16) },
+	{ 0x3300, 0x330f,  1, 2,  14, OPS(Z33_0000_ssss_dsp16) },
+	{ 0x3310, 0x33ff,  1, 2,  14, OPS(Z33_ddN0_ssss_imm16) },
+	{ 0x3400, 0x340f,  1, 2,  15, OPS(Z34_0000_dddd_dsp16) },
+	{ 0x3410, 0x34ff,  1, 2,  15, OPS(Z34_ssN0_dddd_imm16) },
+	{ 0x3500, 0x350f,  1, 2,  17, OPS(Z35_0000_dddd_dsp16) },
+	{ 0x3510, 0x35ff,  1, 2,  17, OPS(Z35_ssN0_dddd_imm16) },
+	{ 0x3600, 0x3600,  1, 1,   2, OPS(Z36_0000_0000) },
+	{ 0x3601, 0x36ff,  1, 1,  10, OPS(Z36_imm8) },
+	{ 0x3700, 0x370f,  1, 2,  17, OPS(Z37_0000_ssss_dsp16) },
+	{ 0x3710, 0x37ff,  1, 2,  17, OPS(Z37_ddN0_ssss_imm16) },
+	{ 0x3800, 0x38ff,  1, 1,  10, OPS(Z38_imm8) },
+	{ 0x3910, 0x39f0, 16, 1,  12, OPS(Z39_ssN0_0000) },
+	{ 0x3a00, 0x3af0, 16, 2,  21, OPS(Z3A_ssss_0000_0000_aaaa_dddd_x000) },
+	{ 0x3a01, 0x3af1, 16, 2,  21, OPS(Z3A_ssss_0001_0000_aaaa_dddd_x000) },
+	{ 0x3a02, 0x3af2, 16, 2,  21, OPS(Z3A_ssss_0010_0000_aaaa_dddd_x000) },
+	{ 0x3a03, 0x3af3, 16, 2,  21, OPS(Z3A_ssss_0011_0000_aaaa_dddd_x000) },
+	{ 0x3a04, 0x3af4, 16, 2,  10, OPS(Z3A_dddd_0100_imm16) },
+	{ 0x3a05, 0x3af5, 16, 2,  10, OPS(Z3A_dddd_0101_imm16) },
+	{ 0x3a06, 0x3af6, 16, 2,  12, OPS(Z3A_ssss_0110_imm16) },
+	{ 0x3a07, 0x3af7, 16, 2,  12, OPS(Z3A_ssss_0111_imm16) },
+	{ 0x3a08, 0x3af8, 16, 2,  21, OPS(Z3A_ssss_1000_0000_aaaa_dddd_x000) },
+	{ 0x3a09, 0x3af9, 16, 2,  21, OPS(Z3A_ssss_1001_0000_aaaa_dddd_x000) },
+	{ 0x3a0a, 0x3afa, 16, 2,  21, OPS(Z3A_ssss_1010_0000_aaaa_dddd_x000) },
+	{ 0x3a0b, 0x3afb, 16, 2,  21, OPS(Z3A_ssss_1011_0000_aaaa_dddd_x000) },
+	{ 0x3b00, 0x3bf0, 16, 2,  21, OPS(Z3B_ssss_0000_0000_aaaa_dddd_x000) },
+	{ 0x3b01, 0x3bf1, 16, 2,  21, OPS(Z3B_ssss_0001_0000_aaaa_dddd_x000) },
+	{ 0x3b02, 0x3bf2, 16, 2,  21, OPS(Z3B_ssss_0010_0000_aaaa_dddd_x000) },
+	{ 0x3b03, 0x3bf3, 16, 2,  21, OPS(Z3B_ssss_0011_0000_aaaa_dddd_x000) },
+	{ 0x3b04, 0x3bf4, 16, 2,  12, OPS(Z3B_dddd_0100_imm16) },
+	{ 0x3b05, 0x3bf5, 16, 2,  12, OPS(Z3B_dddd_0101_imm16) },
+	{ 0x3b06, 0x3bf6, 16, 2,  12, OPS(Z3B_ssss_0110_imm16) },
+	{ 0x3b07, 0x3bf7, 16, 2,  12, OPS(Z3B_ssss_0111_imm16) },
+	{ 0x3b08, 0x3bf8, 16, 2,  21, OPS(Z3B_ssss_1000_0000_aaaa_dddd_x000) },
+	{ 0x3b09, 0x3bf9, 16, 2,  21, OPS(Z3B_ssss_1001_0000_aaaa_dddd_x000) },
+	{ 0x3b0a, 0x3bfa, 16, 2,  21, OPS(Z3B_ssss_1010_0000_aaaa_dddd_x000) },
+	{ 0x3b0b, 0x3bfb, 16, 2,  21, OPS(Z3B_ssss_1011_0000_aaaa_dddd_x000) },
+	{ 0x3c00, 0x3cff,  1, 1,  10, OPS(Z3C_ssss_dddd) },
+	{ 0x3d00, 0x3dff,  1, 1,  10, OPS(Z3D_ssss_dddd) },
+	{ 0x3e00, 0x3eff,  1, 1,  12, OPS(Z3E_dddd_ssss) },
+	{ 0x3f00, 0x3fff,  1, 1,  12, OPS(Z3F_dddd_ssss) },
+	{ 0x4000, 0x400f,  1, 2,   9, OPS(Z40_0000_dddd_addr) },
+	{ 0x4010, 0x40ff,  1, 2,  10, OPS(Z40_ssN0_dddd_addr) },
+	{ 0x4100, 0x410f,  1, 2,   9, OPS(Z41_0000_dddd_addr) },
+	{ 0x4110, 0x41ff,  1, 2,  10, OPS(Z41_ssN0_dddd_addr) },
+	{ 0x4200, 0x420f,  1, 2,   9, OPS(Z42_0000_dddd_addr) },
+	{ 0x4210, 0x42ff,  1, 2,  10, OPS(Z42_ssN0_dddd_addr) },
+	{ 0x4300, 0x430f,  1, 2,   9, OPS(Z43_0000_dddd_addr) },
+	{ 0x4310, 0x43ff,  1, 2,  10, OPS(Z43_ssN0_dddd_addr) },
+	{ 0x4400, 0x440f,  1, 2,   9, OPS(Z44_0000_dddd_addr) },
+	{ 0x4410, 0x44ff,  1, 2,  10, OPS(Z44_ssN0_dddd_addr) },
+	{ 0x4500, 0x450f,  1, 2,   9, OPS(Z45_0000_dddd_addr) },
+	{ 0x4510, 0x45ff,  1, 2,  10, OPS(Z45_ssN0_dddd_addr) },
+	{ 0x4600, 0x460f,  1, 2,   9, OPS(Z46_0000_dddd_addr) },
+	{ 0x4610, 0x46ff,  1, 2,  10, OPS(Z46_ssN0_dddd_addr) },
+	{ 0x4700, 0x470f,  1, 2,   9, OPS(Z47_0000_dddd_addr) },
+	{ 0x4710, 0x47ff,  1, 2,  10, OPS(Z47_ssN0_dddd_addr) },
+	{ 0x4800, 0x480f,  1, 2,   9, OPS(Z48_0000_dddd_addr) },
+	{ 0x4810, 0x48ff,  1, 2,  10, OPS(Z48_ssN0_dddd_addr) },
+	{ 0x4900, 0x490f,  1, 2,   9, OPS(Z49_0000_dddd_addr) },
+	{ 0x4910, 0x49ff,  1, 2,  10, OPS(Z49_ssN0_dddd_addr) },
+	{ 0x4a00, 0x4a0f,  1, 2,   9, OPS(Z4A_0000_dddd_addr) },
+	{ 0x4a10, 0x4aff,  1, 2,  10, OPS(Z4A_ssN0_dddd_addr) },
+	{ 0x4b00, 0x4b0f,  1, 2,   9, OPS(Z4B_0000_dddd_addr) },
+	{ 0x4b10, 0x4bff,  1, 2,  10, OPS(Z4B_ssN0_dddd_addr) },
+	{ 0x4c00, 0x4c00,  1, 2,  15, OPS(Z4C_0000_0000_addr) },
+	{ 0x4c01, 0x4c01,  1, 3,  14, OPS(Z4C_0000_0001_addr_imm8) },
+	{ 0x4c02, 0x4c02,  1, 2,  15, OPS(Z4C_0000_0010_addr) },
+	{ 0x4c04, 0x4c04,  1, 2,  11, OPS(Z4C_0000_0100_addr) },
+	{ 0x4c05, 0x4c05,  1, 3,  14, OPS(Z4C_0000_0101_addr_imm8) },
+	{ 0x4c06, 0x4c06,  1, 2,  14, OPS(Z4C_0000_0110_addr) },
+	{ 0x4c08, 0x4c08,  1, 2,  11, OPS(Z4C_0000_1000_addr) },
+	{ 0x4c10, 0x4cf0, 16, 2,  16, OPS(Z4C_ddN0_0000_addr) },
+	{ 0x4c11, 0x4cf1, 16, 3,  15, OPS(Z4C_ddN0_0001_addr_imm8) },
+	{ 0x4c12, 0x4cf2, 16, 2,  16, OPS(Z4C_ddN0_0010_addr) },
+	{ 0x4c14, 0x4cf4, 16, 2,  12, OPS(Z4C_ddN0_0100_addr) },
+	{ 0x4c15, 0x4cf5, 16, 3,  15, OPS(Z4C_ddN0_0101_addr_imm8) },
+	{ 0x4c16, 0x4cf6, 16, 2,  15, OPS(Z4C_ddN0_0110_addr) },
+	{ 0x4c18, 0x4cf8, 16, 2,  12, OPS(Z4C_ddN0_1000_addr) },
+	{ 0x4d00, 0x4d00,  1, 2,  15, OPS(Z4D_0000_0000_addr) },
+	{ 0x4d01, 0x4d01,  1, 3,  14, OPS(Z4D_0000_0001_addr_imm16) },
+	{ 0x4d02, 0x4d02,  1, 2,  15, OPS(Z4D_0000_0010_addr) },
+	{ 0x4d04, 0x4d04,  1, 2,  11, OPS(Z4D_0000_0100_addr) },
+	{ 0x4d05, 0x4d05,  1, 3,  14, OPS(Z4D_0000_0101_addr_imm16) },
+	{ 0x4d06, 0x4d06,  1, 2,  14, OPS(Z4D_0000_0110_addr) },
+	{ 0x4d08, 0x4d08,  1, 2,  11, OPS(Z4D_0000_1000_addr) },
+	{ 0x4d10, 0x4df0, 16, 2,  16, OPS(Z4D_ddN0_0000_addr) },
+	{ 0x4d11, 0x4df1, 16, 3,  15, OPS(Z4D_ddN0_0001_addr_imm16) },
+	{ 0x4d12, 0x4df2, 16, 2,  16, OPS(Z4D_ddN0_0010_addr) },
+	{ 0x4d14, 0x4df4, 16, 2,  12, OPS(Z4D_ddN0_0100_addr) },
+	{ 0x4d15, 0x4df5, 16, 3,  15, OPS(Z4D_ddN0_0101_addr_imm16) },
+	{ 0x4d16, 0x4df6, 16, 2,  15, OPS(Z4D_ddN0_0110_addr) },
+	{ 0x4d18, 0x4df8, 16, 2,  12, OPS(Z4D_ddN0_1000_addr) },
+	{ 0x4e11, 0x4ef0, 16, 2,  12, OPS(Z4E_ddN0_ssN0_addr) },
+	{ 0x5000, 0x500f,  1, 2,  15, OPS(Z50_0000_dddd_addr) },
+	{ 0x5010, 0x50ff,  1, 2,  16, OPS(Z50_ssN0_dddd_addr) },
+	{ 0x5110, 0x51f0, 16, 2,  21, OPS(Z51_ddN0_0000_addr) },
+	{ 0x5111, 0x51f1, 16, 2,  21, OPS(Z51_ddN0_ssN0_addr) },
+	{ 0x5112, 0x51f2, 16, 2,  21, OPS(Z51_ddN0_ssN0_addr) },
+	{ 0x5113, 0x51f3, 16, 2,  21, OPS(Z51_ddN0_ssN0_addr) },
+	{ 0x5114, 0x51f4, 16, 2,  21, OPS(Z51_ddN0_ssN0_addr) },
+	{ 0x5115, 0x51f5, 16, 2,  21, OPS(Z51_ddN0_ssN0_addr) },
+	{ 0x5116, 0x51f6, 16, 2,  21, OPS(Z51_ddN0_ssN0_addr) },
+	{ 0x5117, 0x51f7, 16, 2,  21, OPS(Z51_ddN0_ssN0_addr) },
+	{ 0x5118, 0x51f8, 16, 2,  21, OPS(Z51_ddN0_ssN0_addr) },
+	{ 0x5119, 0x51f9, 16, 2,  21, OPS(Z51_ddN0_ssN0_addr) },
+	{ 0x511a, 0x51fa, 16, 2,  21, OPS(Z51_ddN0_ssN0_addr) },
+	{ 0x511b, 0x51fb, 16, 2,  21, OPS(Z51_ddN0_ssN0_addr) },
+	{ 0x511c, 0x51fc, 16, 2,  21, OPS(Z51_ddN0_ssN0_addr) },
+	{ 0x511d, 0x51fd, 16, 2,  21, OPS(Z51_ddN0_ssN0_addr) },
+	{ 0x511e, 0x51fe, 16, 2,  21, OPS(Z51_ddN0_ssN0_addr) },
+	{ 0x511f, 0x51ff, 16, 2,  21, OPS(Z51_ddN0_ssN0_addr) },
+	{ 0x5200, 0x520f,  1, 2,  15, OPS(Z52_0000_dddd_addr) },
+	{ 0x5210, 0x52ff,  1, 2,  16, OPS(Z52_ssN0_dddd_addr) },
+	{ 0x5310, 0x53f0, 16, 2,  14, OPS(Z53_ddN0_0000_addr) },
+	{ 0x5311, 0x53f1, 16, 2,  14, OPS(Z53_ddN0_ssN0_addr) },
+	{ 0x5312, 0x53f2, 16, 2,  14, OPS(Z53_ddN0_ssN0_addr) },
+	{ 0x5313, 0x53f3, 16, 2,  14, OPS(Z53_ddN0_ssN0_addr) },
+	{ 0x5314, 0x53f4, 16, 2,  14, OPS(Z53_ddN0_ssN0_addr) },
+	{ 0x5315, 0x53f5, 16, 2,  14, OPS(Z53_ddN0_ssN0_addr) },
+	{ 0x5316, 0x53f6, 16, 2,  14, OPS(Z53_ddN0_ssN0_addr) },
+	{ 0x5317, 0x53f7, 16, 2,  14, OPS(Z53_ddN0_ssN0_addr) },
+	{ 0x5318, 0x53f8, 16, 2,  14, OPS(Z53_ddN0_ssN0_addr) },
+	{ 0x5319, 0x53f9, 16, 2,  14, OPS(Z53_ddN0_ssN0_addr) },
+	{ 0x531a, 0x53fa, 16, 2,  14, OPS(Z53_ddN0_ssN0_addr) },
+	{ 0x531b, 0x53fb, 16, 2,  14, OPS(Z53_ddN0_ssN0_addr) },
+	{ 0x531c, 0x53fc, 16, 2,  14, OPS(Z53_ddN0_ssN0_addr) },
+	{ 0x531d, 0x53fd, 16, 2,  14, OPS(Z53_ddN0_ssN0_addr) },
+	{ 0x531e, 0x53fe, 16, 2,  14, OPS(Z53_ddN0_ssN0_addr) },
+	{ 0x531f, 0x53ff, 16, 2,  14, OPS(Z53_ddN0_ssN0_addr) },
+	{ 0x5400, 0x540f,  1, 2,  12, OPS(Z54_0000_dddd_addr) },
+	{ 0x5410, 0x54ff,  1, 2,  13, OPS(Z54_ssN0_dddd_addr) },
+	{ 0x5510, 0x55f0, 16, 2,  23, OPS(Z55_ssN0_0000_addr) },
+	{ 0x5511, 0x55f1, 16, 2,  23, OPS(Z55_ssN0_ddN0_addr) },
+	{ 0x5512, 0x55f2, 16, 2,  23, OPS(Z55_ssN0_ddN0_addr) },
+	{ 0x5513, 0x55f3, 16, 2,  23, OPS(Z55_ssN0_ddN0_addr) },
+	{ 0x5514, 0x55f4, 16, 2,  23, OPS(Z55_ssN0_ddN0_addr) },
+	{ 0x5515, 0x55f5, 16, 2,  23, OPS(Z55_ssN0_ddN0_addr) },
+	{ 0x5516, 0x55f6, 16, 2,  23, OPS(Z55_ssN0_ddN0_addr) },
+	{ 0x5517, 0x55f7, 16, 2,  23, OPS(Z55_ssN0_ddN0_addr) },
+	{ 0x5518, 0x55f8, 16, 2,  23, OPS(Z55_ssN0_ddN0_addr) },
+	{ 0x5519, 0x55f9, 16, 2,  23, OPS(Z55_ssN0_ddN0_addr) },
+	{ 0x551a, 0x55fa, 16, 2,  23, OPS(Z55_ssN0_ddN0_addr) },
+	{ 0x551b, 0x55fb, 16, 2,  23, OPS(Z55_ssN0_ddN0_addr) },
+	{ 0x551c, 0x55fc, 16, 2,  23, OPS(Z55_ssN0_ddN0_addr) },
+	{ 0x551d, 0x55fd, 16, 2,  23, OPS(Z55_ssN0_ddN0_addr) },
+	{ 0x551e, 0x55fe, 16, 2,  23, OPS(Z55_ssN0_ddN0_addr) },
+	{ 0x551f, 0x55ff, 16, 2,  23, OPS(Z55_ssN0_ddN0_addr) },
+	{ 0x5600, 0x560f,  1, 2,  15, OPS(Z56_0000_dddd_addr) },
+	{ 0x5610, 0x56ff,  1, 2,  16, OPS(Z56_ssN0_dddd_addr) },
+	{ 0x5710, 0x57f0, 16, 2,  16, OPS(Z57_ssN0_0000_addr) },
+	{ 0x5711, 0x57f1, 16, 2,  16, OPS(Z57_ssN0_ddN0_addr) },
+	{ 0x5712, 0x57f2, 16, 2,  16, OPS(Z57_ssN0_ddN0_addr) },
+	{ 0x5713, 0x57f3, 16, 2,  16, OPS(Z57_ssN0_ddN0_addr) },
+	{ 0x5714, 0x57f4, 16, 2,  16, OPS(Z57_ssN0_ddN0_addr) },
+	{ 0x5715, 0x57f5, 16, 2,  16, OPS(Z57_ssN0_ddN0_addr) },
+	{ 0x5716, 0x57f6, 16, 2,  16, OPS(Z57_ssN0_ddN0_addr) },
+	{ 0x5717, 0x57f7, 16, 2,  16, OPS(Z57_ssN0_ddN0_addr) },
+	{ 0x5718, 0x57f8, 16, 2,  16, OPS(Z57_ssN0_ddN0_addr) },
+	{ 0x5719, 0x57f9, 16, 2,  16, OPS(Z57_ssN0_ddN0_addr) },
+	{ 0x571a, 0x57fa, 16, 2,  16, OPS(Z57_ssN0_ddN0_addr) },
+	{ 0x571b, 0x57fb, 16, 2,  16, OPS(Z57_ssN0_ddN0_addr) },
+	{ 0x571c, 0x57fc, 16, 2,  16, OPS(Z57_ssN0_ddN0_addr) },
+	{ 0x571d, 0x57fd, 16, 2,  16, OPS(Z57_ssN0_ddN0_addr) },
+	{ 0x571e, 0x57fe, 16, 2,  16, OPS(Z57_ssN0_ddN0_addr) },
+	{ 0x571f, 0x57ff, 16, 2,  16, OPS(Z57_ssN0_ddN0_addr) },
+	{ 0x5800, 0x580f,  1, 2, 283, OPS(Z58_0000_dddd_addr) },
+	{ 0x5810, 0x58ff,  1, 2, 284, OPS(Z58_ssN0_dddd_addr) },
+	{ 0x5900, 0x590f,  1, 2,  71, OPS(Z59_0000_dddd_addr) },
+	{ 0x5910, 0x59ff,  1, 2,  72, OPS(Z59_ssN0_dddd_addr) },
+	{ 0x5a00, 0x5a0f,  1, 2, 745, OPS(Z5A_0000_dddd_addr) },
+	{ 0x5a10, 0x5aff,  1, 2, 746, OPS(Z5A_ssN0_dddd_addr) },
+	{ 0x5b00, 0x5b0f,  1, 2, 108, OPS(Z5B_0000_dddd_addr) },
+	{ 0x5b10, 0x5bff,  1, 2, 109, OPS(Z5B_ssN0_dddd_addr) },
+	{ 0x5c01, 0x5c01,  1, 3,  14, OPS(Z5C_0000_0001_0000_dddd_0000_nmin1_addr) },
+	{ 0x5c08, 0x5c08,  1, 2,  16, OPS(Z5C_0000_1000_addr) },
+	{ 0x5c09, 0x5c09,  1, 3,  14, OPS(Z5C_0000_1001_0000_ssss_0000_nmin1_addr) },
+	{ 0x5c11, 0x5cf1, 16, 3,  15, OPS(Z5C_ssN0_0001_0000_dddd_0000_nmin1_addr) },
+	{ 0x5c18, 0x5cf8, 16, 2,  17, OPS(Z5C_ddN0_1000_addr) },
+	{ 0x5c19, 0x5cf9, 16, 3,  15, OPS(Z5C_ddN0_1001_0000_ssN0_0000_nmin1_addr) },
+	{ 0x5d00, 0x5d0f,  1, 2,  15, OPS(Z5D_0000_ssss_addr) },
+	{ 0x5d10, 0x5dff,  1, 2,  14, OPS(Z5D_ddN0_ssss_addr) },
+	{ 0x5e00, 0x5e0f,  1, 2,   7, OPS(Z5E_0000_cccc_addr) },
+	{ 0x5e10, 0x5eff,  1, 2,   8, OPS(Z5E_ddN0_cccc_addr) },
+	{ 0x5f00, 0x5f00,  1, 2,  12, OPS(Z5F_0000_0000_addr) },
+	{ 0x5f10, 0x5ff0, 16, 2,  13, OPS(Z5F_ddN0_0000_addr) },
+	{ 0x6000, 0x600f,  1, 2,   9, OPS(Z60_0000_dddd_addr) },
+	{ 0x6010, 0x60ff,  1, 2,  10, OPS(Z60_ssN0_dddd_addr) },
+	{ 0x6100, 0x610f,  1, 2,   9, OPS(Z61_0000_dddd_addr) },
+	{ 0x6110, 0x61ff,  1, 2,  10, OPS(Z61_ssN0_dddd_addr) },
+	{ 0x6200, 0x620f,  1, 2,  13, OPS(Z62_0000_imm4_addr) },
+	{ 0x6210, 0x62ff,  1, 2,  14, OPS(Z62_ddN0_imm4_addr) },
+	{ 0x6300, 0x630f,  1, 2,  13, OPS(Z63_0000_imm4_addr) },
+	{ 0x6310, 0x63ff,  1, 2,  14, OPS(Z63_ddN0_imm4_addr) },
+	{ 0x6400, 0x640f,  1, 2,  13, OPS(Z64_0000_imm4_addr) },
+	{ 0x6410, 0x64ff,  1, 2,  14, OPS(Z64_ddN0_imm4_addr) },
+	{ 0x6500, 0x650f,  1, 2,  13, OPS(Z65_0000_imm4_addr) },
+	{ 0x6510, 0x65ff,  1, 2,  14, OPS(Z65_ddN0_imm4_addr) },
+	{ 0x6600, 0x660f,  1, 2,  10, OPS(Z66_0000_imm4_addr) },
+	{ 0x6610, 0x66ff,  1, 2,  11, OPS(Z66_ddN0_imm4_addr) },
+	{ 0x6700, 0x670f,  1, 2,  10, OPS(Z67_0000_imm4_addr) },
+	{ 0x6710, 0x67ff,  1, 2,  11, OPS(Z67_ddN0_imm4_addr) },
+	{ 0x6800, 0x680f,  1, 2,  13, OPS(Z68_0000_imm4m1_addr) },
+	{ 0x6810, 0x68ff,  1, 2,  14, OPS(Z68_ddN0_imm4m1_addr) },
+	{ 0x6900, 0x690f,  1, 2,  13, OPS(Z69_0000_imm4m1_addr) },
+	{ 0x6910, 0x69ff,  1, 2,  14, OPS(Z69_ddN0_imm4m1_addr) },
+	{ 0x6a00, 0x6a0f,  1, 2,  13, OPS(Z6A_0000_imm4m1_addr) },
+	{ 0x6a10, 0x6aff,  1, 2,  14, OPS(Z6A_ddN0_imm4m1_addr) },
+	{ 0x6b00, 0x6b0f,  1, 2,  13, OPS(Z6B_0000_imm4m1_addr) },
+	{ 0x6b10, 0x6bff,  1, 2,  14, OPS(Z6B_ddN0_imm4m1_addr) },
+	{ 0x6c00, 0x6c0f,  1, 2,  15, OPS(Z6C_0000_dddd_addr) },
+	{ 0x6c10, 0x6cff,  1, 2,  16, OPS(Z6C_ssN0_dddd_addr) },
+	{ 0x6d00, 0x6d0f,  1, 2,  15, OPS(Z6D_0000_dddd_addr) },
+	{ 0x6d10, 0x6dff,  1, 2,  16, OPS(Z6D_ssN0_dddd_addr) },
+	{ 0x6e00, 0x6e0f,  1, 2,  11, OPS(Z6E_0000_ssss_addr) },
+	{ 0x6e10, 0x6eff,  1, 2,  11, OPS(Z6E_ddN0_ssss_addr) },
+	{ 0x6f00, 0x6f0f,  1, 2,  11, OPS(Z6F_0000_ssss_addr) },
+	{ 0x6f10, 0x6fff,  1, 2,  12, OPS(Z6F_ddN0_ssss_addr) },
+	{ 0x7010, 0x70ff,  1, 2,  14, OPS(Z70_ssN0_dddd_0000_xxxx_0000_0000) },
+	{ 0x7110, 0x71ff,  1, 2,  14, OPS(Z71_ssN0_dddd_0000_xxxx_0000_0000) },
+	{ 0x7210, 0x72ff,  1, 2,  14, OPS(Z72_ddN0_ssss_0000_xxxx_0000_0000) },
+	{ 0x7310, 0x73ff,  1, 2,  14, OPS(Z73_ddN0_ssss_0000_xxxx_0000_0000) },
+	{ 0x7410, 0x74ff,  1, 2,  15, OPS(Z74_ssN0_dddd_0000_xxxx_0000_0000) },
+	{ 0x7510, 0x75ff,  1, 2,  17, OPS(Z75_ssN0_dddd_0000_xxxx_0000_0000) },
+	{ 0x7600, 0x760f,  1, 2,  12, OPS(Z76_0000_dddd_addr) },
+	{ 0x7610, 0x76ff,  1, 2,  13, OPS(Z76_ssN0_dddd_addr) },
+	{ 0x7710, 0x77ff,  1, 2,  17, OPS(Z77_ddN0_ssss_0000_xxxx_0000_0000) },
+	{ 0x7800, 0x78ff,  1, 1,  10, OPS(Z78_imm8) },
+	{ 0x7900, 0x7900,  1, 2,  16, OPS(Z79_0000_0000_addr) },
+	{ 0x7910, 0x79f0, 16, 2,  17, OPS(Z79_ssN0_0000_addr) },
+	{ 0x7a00, 0x7a00,  1, 1,   8, OPS(Z7A_0000_0000) },
+	{ 0x7b00, 0x7b00,  1, 1,  13, OPS(Z7B_0000_0000) },
+	{ 0x7b08, 0x7b08,  1, 1,   5, OPS(Z7B_0000_1000) },
+	{ 0x7b09, 0x7b09,  1, 1,   5, OPS(Z7B_0000_1001) },
+	{ 0x7b0a, 0x7b0a,  1, 1,   7, OPS(Z7B_0000_1010) },
+	{ 0x7b0d, 0x7bfd, 16, 1,  12, OPS(Z7B_dddd_1101) },
+	{ 0x7c00, 0x7c03,  1, 1,   7, OPS(Z7C_0000_00ii) },
+	{ 0x7c04, 0x7c07,  1, 1,   7, OPS(Z7C_0000_01ii) },
+	{ 0x7d00, 0x7df0, 16, 1,   7, OPS(Z7D_dddd_0ccc) },
+	{ 0x7d01, 0x7df1, 16, 1,   7, OPS(Z7D_dddd_0ccc) },
+	{ 0x7d02, 0x7df2, 16, 1,   7, OPS(Z7D_dddd_0ccc) },
+	{ 0x7d03, 0x7df3, 16, 1,   7, OPS(Z7D_dddd_0ccc) },
+	{ 0x7d04, 0x7df4, 16, 1,   7, OPS(Z7D_dddd_0ccc) },
+	{ 0x7d05, 0x7df5, 16, 1,   7, OPS(Z7D_dddd_0ccc) },
+	{ 0x7d06, 0x7df6, 16, 1,   7, OPS(Z7D_dddd_0ccc) },
+	{ 0x7d07, 0x7df7, 16, 1,   7, OPS(Z7D_dddd_0ccc) },
+	{ 0x7d08, 0x7df8, 16, 1,   7, OPS(Z7D_ssss_1ccc) },
+	{ 0x7d09, 0x7df9, 16, 1,   7, OPS(Z7D_ssss_1ccc) },
+	{ 0x7d0a, 0x7dfa, 16, 1,   7, OPS(Z7D_ssss_1ccc) },
+	{ 0x7d0b, 0x7dfb, 16, 1,   7, OPS(Z7D_ssss_1ccc) },
+	{ 0x7d0c, 0x7dfc, 16, 1,   7, OPS(Z7D_ssss_1ccc) },
+	{ 0x7d0d, 0x7dfd, 16, 1,   7, OPS(Z7D_ssss_1ccc) },
+	{ 0x7d0e, 0x7dfe, 16, 1,   7, OPS(Z7D_ssss_1ccc) },
+	{ 0x7d0f, 0x7dff, 16, 1,   7, OPS(Z7D_ssss_1ccc) },
+	{ 0x7e00, 0x7eff,  1, 1,  10, OPS(Z7E_imm8) },
+	{ 0x7f00, 0x7fff,  1, 1,  33, OPS(Z7F_imm8) },
+	{ 0x8000, 0x80ff,  1, 1,   4, OPS(Z80_ssss_dddd) },
+	{ 0x8100, 0x81ff,  1, 1,   4, OPS(Z81_ssss_dddd) },
+	{ 0x8200, 0x82ff,  1, 1,   4, OPS(Z82_ssss_dddd) },
+	{ 0x8300, 0x83ff,  1, 1,   4, OPS(Z83_ssss_dddd) },
+	{ 0x8400, 0x84ff,  1, 1,   4, OPS(Z84_ssss_dddd) },
+	{ 0x8500, 0x85ff,  1, 1,   4, OPS(Z85_ssss_dddd) },
+	{ 0x8600, 0x86ff,  1, 1,   4, OPS(Z86_ssss_dddd) },
+	{ 0x8700, 0x87ff,  1, 1,   4, OPS(Z87_ssss_dddd) },
+	{ 0x8800, 0x88ff,  1, 1,   4, OPS(Z88_ssss_dddd) },
+	{ 0x8900, 0x89ff,  1, 1,   4, OPS(Z89_ssss_dddd) },
+	{ 0x8a00, 0x8aff,  1, 1,   4, OPS(Z8A_ssss_dddd) },
+	{ 0x8b00, 0x8bff,  1, 1,   4, OPS(Z8B_ssss_dddd) },
+	{ 0x8c00, 0x8cf0, 16, 1,   7, OPS(Z8C_dddd_0000) },
+	{ 0x8c02, 0x8cf2, 16, 1,   7, OPS(Z8C_dddd_0010) },
+	{ 0x8c04, 0x8cf4, 16, 1,   7, OPS(Z8C_dddd_0100) },
+	{ 0x8c06, 0x8cf6, 16, 1,   7, OPS(Z8C_dddd_0110) },
+	{ 0x8c01, 0x8cf1, 16, 1,   7, OPS(Z8C_dddd_0001) },
+	{ 0x8c08, 0x8cf8, 16, 1,   7, OPS(Z8C_dddd_1000) },
+	{ 0x8c09, 0x8cf9, 16, 1,   7, OPS(Z8C_dddd_1001) },
+	{ 0x8d00, 0x8df0, 16, 1,   7, OPS(Z8D_dddd_0000) },
+	{ 0x8d01, 0x8df1, 16, 1,   7, OPS(Z8D_imm4_0001) },
+	{ 0x8d02, 0x8df2, 16, 1,   7, OPS(Z8D_dddd_0010) },
+	{ 0x8d03, 0x8df3, 16, 1,   7, OPS(Z8D_imm4_0011) },
+	{ 0x8d04, 0x8df4, 16, 1,   7, OPS(Z8D_dddd_0100) },
+	{ 0x8d05, 0x8df5, 16, 1,   7, OPS(Z8D_imm4_0101) },
+	{ 0x8d06, 0x8df6, 16, 1,   7, OPS(Z8D_dddd_0110) },
+	{ 0x8d07, 0x8d07,  1, 1,   7, OPS(Z8D_0000_0111) },
+	{ 0x8d08, 0x8df8, 16, 1,   7, OPS(Z8D_dddd_1000) },
+	{ 0x8e00, 0x8eff,  1, 1,  10, OPS(Z8E_imm8) },
+	{ 0x8f00, 0x8fff,  1, 1,  10, OPS(Z8F_imm8) },
+	{ 0x9000, 0x90ff,  1, 1,   8, OPS(Z90_ssss_dddd) },
+	{ 0x9110, 0x91ff,  1, 1,  12, OPS(Z91_ddN0_ssss) },
+	{ 0x9200, 0x92ff,  1, 1,   8, OPS(Z92_ssss_dddd) },
+	{ 0x9310, 0x93ff,  1, 1,   9, OPS(Z93_ddN0_ssss) },
+	{ 0x9400, 0x94ff,  1, 1,   5, OPS(Z94_ssss_dddd) },
+	{ 0x9510, 0x95ff,  1, 1,  12, OPS(Z95_ssN0_dddd) },
+	{ 0x9600, 0x96ff,  1, 1,   8, OPS(Z96_ssss_dddd) },
+	{ 0x9710, 0x97ff,  1, 1,   8, OPS(Z97_ssN0_dddd) },
+	{ 0x9800, 0x98ff,  1, 1, 282, OPS(Z98_ssss_dddd) },
+	{ 0x9900, 0x99ff,  1, 1,  70, OPS(Z99_ssss_dddd) },
+	{ 0x9a00, 0x9aff,  1, 1, 744, OPS(Z9A_ssss_dddd) },
+	{ 0x9b00, 0x9bff,  1, 1, 107, OPS(Z9B_ssss_dddd) },
+	{ 0x9c00, 0x9cf8,  8, 1,  13, OPS(Z9C_dddd_1000) },
+	{ 0x9d00, 0x9dff,  1, 1,  10, OPS(Z9D_imm8) },
+	{ 0x9e00, 0x9e0f,  1, 1,  10, OPS(Z9E_0000_cccc) },
+	{ 0x9f00, 0x9fff,  1, 1,  10, OPS(Z9F_imm8) },
+	{ 0xa000, 0xa0ff,  1, 1,   3, OPS(ZA0_ssss_dddd) },
+	{ 0xa100, 0xa1ff,  1, 1,   3, OPS(ZA1_ssss_dddd) },
+	{ 0xa200, 0xa2ff,  1, 1,   4, OPS(ZA2_dddd_imm4) },
+	{ 0xa300, 0xa3ff,  1, 1,   4, OPS(ZA3_dddd_imm4) },
+	{ 0xa400, 0xa4ff,  1, 1,   4, OPS(ZA4_dddd_imm4) },
+	{ 0xa500, 0xa5ff,  1, 1,   4, OPS(ZA5_dddd_imm4) },
+	{ 0xa600, 0xa6ff,  1, 1,   4, OPS(ZA6_dddd_imm4) },
+	{ 0xa700, 0xa7ff,  1, 1,   4, OPS(ZA7_dddd_imm4) },
+	{ 0xa800, 0xa8ff,  1, 1,   4, OPS(ZA8_dddd_imm4m1) },
+	{ 0xa900, 0xa9ff,  1, 1,   4, OPS(ZA9_dddd_imm4m1) },
+	{ 0xaa00, 0xaaff,  1, 1,   4, OPS(ZAA_dddd_imm4m1) },
+	{ 0xab00, 0xabff,  1, 1,   4, OPS(ZAB_dddd_imm4m1) },
+	{ 0xac00, 0xacff,  1, 1,   6, OPS(ZAC_ssss_dddd) },
+	{ 0xad00, 0xadff,  1, 1,   6, OPS(ZAD_ssss_dddd) },
+	{ 0xae00, 0xaeff,  1, 1,   5, OPS(ZAE_dddd_cccc) },
+	{ 0xaf00, 0xafff,  1, 1,   5, OPS(ZAF_dddd_cccc) },
+	{ 0xb000, 0xb0f0, 16, 1,   5, OPS(ZB0_dddd_0000) },
+	{ 0xb100, 0xb1f0, 16, 1,  11, OPS(ZB1_dddd_0000) },
+	{ 0xb107, 0xb1f7, 16, 1,  11, OPS(ZB1_dddd_0111) },
+	{ 0xb10a, 0xb1fa, 16, 1,  11, OPS(ZB1_dddd_1010) },
+	{ 0xb200, 0xb2f0, 16, 1,   6, OPS(ZB2_dddd_00I0) },
+	{ 0xb201, 0xb2f1, 16, 2,  13, OPS(ZB2_dddd_0001_imm8) },
+	{ 0xb202, 0xb2f2, 16, 1,   6, OPS(ZB2_dddd_00I0) },
+	{ 0xb203, 0xb2f3, 16, 2,  15, OPS(ZB2_dddd_0011_0000_ssss_0000_0000) },
+	{ 0xb204, 0xb2f4, 16, 1,   6, OPS(ZB2_dddd_01I0) },
+	{ 0xb206, 0xb2f6, 16, 1,   6, OPS(ZB2_dddd_01I0) },
+	{ 0xb208, 0xb2f8, 16, 1,   9, OPS(ZB2_dddd_10I0) },
+	{ 0xb209, 0xb2f9, 16, 2,  13, OPS(ZB2_dddd_1001_imm8) },
+	{ 0xb20a, 0xb2fa, 16, 1,   9, OPS(ZB2_dddd_10I0) },
+	{ 0xb20b, 0xb2fb, 16, 2,  15, OPS(ZB2_dddd_1011_0000_ssss_0000_0000) },
+	{ 0xb20c, 0xb2fc, 16, 1,   9, OPS(ZB2_dddd_11I0) },
+	{ 0xb20e, 0xb2fe, 16, 1,   9, OPS(ZB2_dddd_11I0) },
+	{ 0xb300, 0xb3f0, 16, 1,   6, OPS(ZB3_dddd_00I0) },
+	{ 0xb301, 0xb3f1, 16, 2,  13, OPS(ZB3_dddd_0001_imm8) },
+	{ 0xb302, 0xb3f2, 16, 1,   6, OPS(ZB3_dddd_00I0) },
+	{ 0xb303, 0xb3f3, 16, 2,  15, OPS(ZB3_dddd_0011_0000_ssss_0000_0000) },
+	{ 0xb304, 0xb3f4, 16, 1,   6, OPS(ZB3_dddd_01I0) },
+	{ 0xb305, 0xb3f5, 16, 2,  13, OPS(ZB3_dddd_0101_imm8) },
+	{ 0xb306, 0xb3f6, 16, 1,   6, OPS(ZB3_dddd_01I0) },
+	{ 0xb307, 0xb3f7, 16, 2,  15, OPS(ZB3_dddd_0111_0000_ssss_0000_0000) },
+	{ 0xb308, 0xb3f8, 16, 1,   6, OPS(ZB3_dddd_10I0) },
+	{ 0xb309, 0xb3f9, 16, 2,  13, OPS(ZB3_dddd_1001_imm8) },
+	{ 0xb30a, 0xb3fa, 16, 1,   6, OPS(ZB3_dddd_10I0) },
+	{ 0xb30b, 0xb3fb, 16, 2,  15, OPS(ZB3_dddd_1011_0000_ssss_0000_0000) },
+	{ 0xb30c, 0xb3fc, 16, 1,   6, OPS(ZB3_dddd_11I0) },
+	{ 0xb30d, 0xb3fd, 16, 2,  13, OPS(ZB3_dddd_1101_imm8) },
+	{ 0xb30e, 0xb3fe, 16, 1,   6, OPS(ZB3_dddd_11I0) },
+	{ 0xb30f, 0xb3ff, 16, 2,  15, OPS(ZB3_dddd_1111_0000_ssss_0000_0000) },
+	{ 0xb400, 0xb4ff,  1, 1,   5, OPS(ZB4_ssss_dddd) },
+	{ 0xb500, 0xb5ff,  1, 1,   5, OPS(ZB5_ssss_dddd) },
+	{ 0xb600, 0xb6ff,  1, 1,   5, OPS(ZB6_ssss_dddd) },
+	{ 0xb700, 0xb7ff,  1, 1,   5, OPS(ZB7_ssss_dddd) },
+	{ 0xb810, 0xb8f0, 16, 2,  25, OPS(ZB8_ddN0_0000_0000_rrrr_ssN0_0000) },
+	{ 0xb812, 0xb8f2, 16, 2,  25, OPS(ZB8_ddN0_0010_0000_rrrr_ssN0_0000) },
+	{ 0xb814, 0xb8f4, 16, 2,  25, OPS(ZB8_ddN0_0100_0000_rrrr_ssN0_0000) },
+	{ 0xb816, 0xb8f6, 16, 2,  25, OPS(ZB8_ddN0_0110_0000_rrrr_ssN0_1110) },
+	{ 0xb818, 0xb8f8, 16, 2,  25, OPS(ZB8_ddN0_1000_0000_rrrr_ssN0_0000) },
+	{ 0xb81a, 0xb8fa, 16, 2,  25, OPS(ZB8_ddN0_1010_0000_rrrr_ssN0_0000) },
+	{ 0xb81c, 0xb8fc, 16, 2,  25, OPS(ZB8_ddN0_1100_0000_rrrr_ssN0_0000) },
+	{ 0xb81e, 0xb8fe, 16, 2,  25, OPS(ZB8_ddN0_1110_0000_rrrr_ssN0_1110) },
+	{ 0xb900, 0xb9ff, 16, 1,  10, OPS(ZB9_imm8) },
+	{ 0xba10, 0xbaf0, 16, 2,  11, OPS(ZBA_ssN0_0000_0000_rrrr_dddd_cccc) },
+	{ 0xba11, 0xbaf1, 16, 2,  11, OPS(ZBA_ssN0_0001_0000_rrrr_ddN0_x000) },
+	{ 0xba12, 0xbaf2, 16, 2,  11, OPS(ZBA_ssN0_0010_0000_rrrr_ddN0_cccc) },
+	{ 0xba14, 0xbaf4, 16, 2,  11, OPS(ZBA_ssN0_0100_0000_rrrr_dddd_cccc) },
+	{ 0xba16, 0xbaf6, 16, 2,  11, OPS(ZBA_ssN0_0110_0000_rrrr_ddN0_cccc) },
+	{ 0xba18, 0xbaf8, 16, 2,  11, OPS(ZBA_ssN0_1000_0000_rrrr_dddd_cccc) },
+	{ 0xba19, 0xbaf9, 16, 2,  11, OPS(ZBA_ssN0_1001_0000_rrrr_ddN0_x000) },
+	{ 0xba1a, 0xbafa, 16, 2,  11, OPS(ZBA_ssN0_1010_0000_rrrr_ddN0_cccc) },
+	{ 0xba1c, 0xbafc, 16, 2,  11, OPS(ZBA_ssN0_1100_0000_rrrr_dddd_cccc) },
+	{ 0xba1e, 0xbafe, 16, 2,  11, OPS(ZBA_ssN0_1110_0000_rrrr_ddN0_cccc) },
+	{ 0xbb10, 0xbbf0, 16, 2,  11, OPS(ZBB_ssN0_0000_0000_rrrr_dddd_cccc) },
+	{ 0xbb11, 0xbbf1, 16, 2,  11, OPS(ZBB_ssN0_0001_0000_rrrr_ddN0_x000) },
+	{ 0xbb12, 0xbbf2, 16, 2,  11, OPS(ZBB_ssN0_0010_0000_rrrr_ddN0_cccc) },
+	{ 0xbb14, 0xbbf4, 16, 2,  11, OPS(ZBB_ssN0_0100_0000_rrrr_dddd_cccc) },
+	{ 0xbb16, 0xbbf6, 16, 2,  11, OPS(ZBB_ssN0_0110_0000_rrrr_ddN0_cccc) },
+	{ 0xbb18, 0xbbf8, 16, 2,  11, OPS(ZBB_ssN0_1000_0000_rrrr_dddd_cccc) },
+	{ 0xbb19, 0xbbf9, 16, 2,  11, OPS(ZBB_ssN0_1001_0000_rrrr_ddN0_x000) },
+	{ 0xbb1a, 0xbbfa, 16, 2,  11, OPS(ZBB_ssN0_1010_0000_rrrr_ddN0_cccc) },
+	{ 0xbb1c, 0xbbfc, 16, 2,  11, OPS(ZBB_ssN0_1100_0000_rrrr_dddd_cccc) },
+	{ 0xbb1e, 0xbbfe, 16, 2,  11, OPS(ZBB_ssN0_1110_0000_rrrr_ddN0_cccc) },
+	{ 0xbc00, 0xbcff,  1, 1,   9, OPS(ZBC_aaaa_bbbb) },
+	{ 0xbd00, 0xbdff,  1, 1,   5, OPS(ZBD_dddd_imm4) },
+	{ 0xbe00, 0xbeff,  1, 1,   9, OPS(ZBE_aaaa_bbbb) },
+	{ 0xbf00, 0xbfff,  1, 1,  10, OPS(ZBF_imm8) },
+	{ 0xc000, 0xcfff,  1, 1,   5, OPS(ZC_dddd_imm8) },
+	{ 0xd000, 0xdfff,  1, 1,  10, OPS(ZD_dsp12) },
+	{ 0xe000, 0xefff,  1, 1,   6, OPS(ZE_cccc_dsp8) },
+	{ 0xf000, 0xf07f,  1, 1,  11, OPS(ZF_dddd_0dsp7) },
+	{ 0xf100, 0xf17f,  1, 1,  11, OPS(ZF_dddd_0dsp7) },
+	{ 0xf200, 0xf27f,  1, 1,  11, OPS(ZF_dddd_0dsp7) },
+	{ 0xf300, 0xf37f,  1, 1,  11, OPS(ZF_dddd_0dsp7) },
+	{ 0xf400, 0xf47f,  1, 1,  11, OPS(ZF_dddd_0dsp7) },
+	{ 0xf500, 0xf57f,  1, 1,  11, OPS(ZF_dddd_0dsp7) },
+	{ 0xf600, 0xf67f,  1, 1,  11, OPS(ZF_dddd_0dsp7) },
+	{ 0xf700, 0xf77f,  1, 1,  11, OPS(ZF_dddd_0dsp7) },
+	{ 0xf800, 0xf87f,  1, 1,  11, OPS(ZF_dddd_0dsp7) },
+	{ 0xf900, 0xf97f,  1, 1,  11, OPS(ZF_dddd_0dsp7) },
+	{ 0xfa00, 0xfa7f,  1, 1,  11, OPS(ZF_dddd_0dsp7) },
+	{ 0xfb00, 0xfb7f,  1, 1,  11, OPS(ZF_dddd_0dsp7) },
+	{ 0xfc00, 0xfc7f,  1, 1,  11, OPS(ZF_dddd_0dsp7) },
+	{ 0xfd00, 0xfd7f,  1, 1,  11, OPS(ZF_dddd_0dsp7) },
+	{ 0xfe00, 0xfe7f,  1, 1,  11, OPS(ZF_dddd_0dsp7) },
+	{ 0xff00, 0xff7f,  1, 1,  11, OPS(ZF_dddd_0dsp7) },
+	{ 0xf080, 0xf0ff,  1, 1,  11, OPS(ZF_dddd_1dsp7) },
+	{ 0xf180, 0xf1ff,  1, 1,  11, OPS(ZF_dddd_1dsp7) },
+	{ 0xf280, 0xf2ff,  1, 1,  11, OPS(ZF_dddd_1dsp7) },
+	{ 0xf380, 0xf3ff,  1, 1,  11, OPS(ZF_dddd_1dsp7) },
+	{ 0xf480, 0xf4ff,  1, 1,  11, OPS(ZF_dddd_1dsp7) },
+	{ 0xf580, 0xf5ff,  1, 1,  11, OPS(ZF_dddd_1dsp7) },
+	{ 0xf680, 0xf6ff,  1, 1,  11, OPS(ZF_dddd_1dsp7) },
+	{ 0xf780, 0xf7ff,  1, 1,  11, OPS(ZF_dddd_1dsp7) },
+	{ 0xf880, 0xf8ff,  1, 1,  11, OPS(ZF_dddd_1dsp7) },
+	{ 0xf980, 0xf9ff,  1, 1,  11, OPS(ZF_dddd_1dsp7) },
+	{ 0xfa80, 0xfaff,  1, 1,  11, OPS(ZF_dddd_1dsp7) },
+	{ 0xfb80, 0xfbff,  1, 1,  11, OPS(ZF_dddd_1dsp7) },
+	{ 0xfc80, 0xfcff,  1, 1,  11, OPS(ZF_dddd_1dsp7) },
+	{ 0xfd80, 0xfdff,  1, 1,  11, OPS(ZF_dddd_1dsp7) },
+	{ 0xfe80, 0xfeff,  1, 1,  11, OPS(ZF_dddd_1dsp7) },
+	{ 0xff80, 0xffff,  1, 1,  11, OPS(ZF_dddd_1dsp7) },
+	{ 0,      0,       0, 0,   0, { nullptr, nullptr } },
 };
+
+#undef OPS
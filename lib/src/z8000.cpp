@@ -9,9 +9,13 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
+#include <bitset>
+#include <cstdlib>
+#include <cstring>
 #include <cstdio>
 #include <cassert>
-#include <sstream>
+#include <type_traits>
 
 #include <z8000/z8000.h>
 #include <z8000/z8000cpu.h>
@@ -38,33 +42,50 @@ u16 data_buffer::r16(offs_t addr) const {
 z8002_device::z8002_device()
     : m_ppc(0), m_pc(0), m_psapseg(0), m_psapoff(0), m_fcw(0), m_refresh(0)
     , m_nspseg(0), m_nspoff(0), m_irq_req(0), m_irq_vec(0), m_op_valid(0)
-    , m_nmi_state(0), m_mi(0), m_halt(false), m_icount(0), m_total_cycles(0)
-    , m_vector_mult(1)
-    , m_program_bus(nullptr), m_data_bus(nullptr), m_stack_bus(nullptr)
+    , m_nmi_state(0), m_mi(0), m_halt(false), m_stop_req(false), m_inline_repeat(false), m_icount(0), m_total_cycles(0)
+    , m_vector_mult(1), m_z8001(false)
+    , m_program_bus(nullptr), m_data_bus(nullptr), m_stack_bus(nullptr), m_memory_stats(nullptr)
     , m_io_bus(nullptr), m_trace(false), m_reg_trace(false), m_disasm(nullptr)
+    , m_trace_sink(nullptr), m_trace_insn(), m_trace_regs(), m_trace_mask(0xffff)
+    , m_idle_modes(0), m_idle_active(0), m_idle_cycles(0), m_idle_loop()
+    , m_segments(nullptr), m_fetch_translator(this)
+    , m_debug_next_id(1), m_breakpoints(0), m_mem_watches(0), m_io_watches(0), m_io_watch_pages(), m_break_skip(false)
+    , m_program_watch(this), m_data_watch(this), m_stack_watch(this), m_io_watch(this)
+    , m_vectors(), m_vector_gen(1), m_psa_page(0), m_irq_asserted(), m_irq_stats()
+    , m_block_cache(false), m_block_hot(BLOCK_HOT), m_page_mask(0xffff >> BLOCK_PAGE_SHIFT), m_block_arena_used(0)
 {
     clear_internal_state();
-    init_tables();
     m_disasm = new z8000_disassembler(this);
 }
 
 z8002_device::z8002_device(int addrbits, int vecmult)
     : m_ppc(0), m_pc(0), m_psapseg(0), m_psapoff(0), m_fcw(0), m_refresh(0)
     , m_nspseg(0), m_nspoff(0), m_irq_req(0), m_irq_vec(0), m_op_valid(0)
-    , m_nmi_state(0), m_mi(0), m_halt(false), m_icount(0), m_total_cycles(0)
-    , m_vector_mult(vecmult)
-    , m_program_bus(nullptr), m_data_bus(nullptr), m_stack_bus(nullptr)
+    , m_nmi_state(0), m_mi(0), m_halt(false), m_stop_req(false), m_inline_repeat(false), m_icount(0), m_total_cycles(0)
+    , m_vector_mult(vecmult), m_z8001(addrbits > 16)
+    , m_program_bus(nullptr), m_data_bus(nullptr), m_stack_bus(nullptr), m_memory_stats(nullptr)
     , m_io_bus(nullptr), m_trace(false), m_reg_trace(false), m_disasm(nullptr)
+    , m_trace_sink(nullptr), m_trace_insn(), m_trace_regs(), m_trace_mask(0xffff)
+    , m_idle_modes(0), m_idle_active(0), m_idle_cycles(0), m_idle_loop()
+    , m_segments(nullptr), m_fetch_translator(this)
+    , m_debug_next_id(1), m_breakpoints(0), m_mem_watches(0), m_io_watches(0), m_io_watch_pages(), m_break_skip(false)
+    , m_program_watch(this), m_data_watch(this), m_stack_watch(this), m_io_watch(this)
+    , m_vectors(), m_vector_gen(1), m_psa_page(0), m_irq_asserted(), m_irq_stats()
+    , m_block_cache(false), m_block_hot(BLOCK_HOT), m_page_mask(((1u << addrbits) - 1) >> BLOCK_PAGE_SHIFT)
+    , m_block_arena_used(0)
 {
-    (void)addrbits;  // May be used for Z8001 in future
     clear_internal_state();
-    init_tables();
     m_disasm = new z8000_disassembler(this);
 }
 
 z8001_device::z8001_device()
     : z8002_device(23, 2)
 {
+    for (unsigned seg = 0; seg < z8000_segment::COUNT; seg++)
+    {
+        m_segment_table[seg].base = seg << 8;
+        m_segment_table[seg].limit = 0xff;
+    }
 }
 
 z8002_device::~z8002_device()
@@ -75,34 +96,91 @@ z8002_device::~z8002_device()
 void z8002_device::set_program_memory(z8000_memory_bus* mem)
 {
     m_program_bus = mem;
-    m_cache.bus = mem;
-    m_opcache.bus = mem;
-    m_program.bus = mem;
+    attach_memory();
+}
+
+/* with the MMU on, instruction fetches go through m_fetch_translator, so
+   that without it they carry no check at all */
+void z8002_device::update_fetch_path()
+{
+    const mem_specific &program = m_fetch_space;
+    z8000_memory_bus* bus = m_segments ? &m_fetch_translator : program.bus;
+    const z8000_page_map* map = m_segments ? nullptr : program.map;
+    m_cache.bus = bus;
+    m_cache.map = map;
+    m_opcache.bus = bus;
+    m_opcache.map = map;
+}
+
+uint8_t z8002_device::fetch_translator::read_byte(uint32_t addr)
+{
+    return cpu->translate(addr, MMU_FETCH) ? cpu->m_fetch_space.read_byte(addr) : 0xff;
+}
+
+uint16_t z8002_device::fetch_translator::read_word(uint32_t addr)
+{
+    return cpu->translate(addr, MMU_FETCH) ? cpu->m_fetch_space.read_word(addr) : 0xffff;
 }
 
 void z8002_device::set_data_memory(z8000_memory_bus* mem)
 {
     m_data_bus = mem;
-    m_data.bus = mem;
+    attach_memory();
 }
 
 void z8002_device::set_stack_memory(z8000_memory_bus* mem)
 {
     m_stack_bus = mem;
-    m_stack.bus = mem;
+    attach_memory();
+}
+
+void z8002_device::set_memory_stats(z8000_memory_stats* stats)
+{
+    m_memory_stats = stats;
+    attach_memory();
+}
+
+/* the spaces as attached, or through the counting buses of m_memory_stats,
+   which have no page map; instruction fetches count apart from the
+   program space's data accesses */
+void z8002_device::attach_memory()
+{
+    auto attach = [this](mem_specific &space, z8000_memory_bus* bus, unsigned counted) {
+        space.bus = m_memory_stats ? m_memory_stats->counting_bus(counted, bus) : bus;
+        space.map = (bus && !m_memory_stats) ? bus->page_map() : nullptr;
+    };
+    attach(m_program_watch.attached, m_program_bus, z8000_memory_stats::PROGRAM);
+    attach(m_data_watch.attached, m_data_bus, z8000_memory_stats::DATA);
+    attach(m_stack_watch.attached, m_stack_bus, z8000_memory_stats::STACK);
+    attach(m_fetch_space, m_program_bus, z8000_memory_stats::FETCH);
+    update_memory_paths();
+    update_fetch_path();
 }
 
 void z8002_device::set_io(z8000_io_bus* io)
 {
-    m_io_bus = io;
+    m_io_watch.attached = io;
+    update_memory_paths();
 }
 
-bool z8002_device::get_segmented_mode() const
+/* route the data spaces and I/O directly to the buses as attached, or
+   through the watch buses while watchpoints are set */
+void z8002_device::update_memory_paths()
 {
-    return false;
+    auto route = [this](mem_specific &space, watch_bus &w) {
+        const bool watched = m_mem_watches && w.attached.bus;
+        space.bus = watched ? &w : w.attached.bus;
+        space.map = watched ? nullptr : w.attached.map;
+    };
+    route(m_program, m_program_watch);
+    route(m_data, m_data_watch);
+    route(m_stack, m_stack_watch);
+    m_io_bus = (m_io_watches && m_io_watch.attached) ? &m_io_watch : m_io_watch.attached;
+    update_code_spaces();
 }
 
-bool z8001_device::get_segmented_mode() const
+/* CHANGE_FCW never sets F_SEG on the Z8002 */
+bool z8002_device::get_segmented_mode() const
 {
     return (m_fcw & F_SEG) ? true : false;
 }
@@ -117,8 +195,63 @@ uint32_t z8002_device::addr_sub(uint32_t addr, uint32_t subtrahend)
     return (addr & 0xffff0000) | ((addr - subtrahend) & 0xffff);
 }
 
-/* conversion table for Z8000 DAB opcode */
-#include <z8000/z8000dab.h>
+/* non-segmented mode on the Z8001 stays in the pc's segment */
+template<bool Z8001>
+uint32_t z8002_device::adjust_addr_for_nonseg_mode(uint32_t addr) const
+{
+    if (!Z8001 || (m_fcw & F_SEG))
+        return addr;
+    return (addr & 0xffff) | (m_pc & 0x7f0000);
+}
+
+/* map a logical <<segment>>offset address to its physical address; false
+   if the access is to be suppressed */
+bool z8002_device::translate(uint32_t &addr, int access)
+{
+    z8000_segment &s = m_segments[(addr >> 16) & 0x7f];
+    const uint16_t offset = addr & 0xffff;
+    const uint8_t block = offset >> 8;
+
+    uint8_t type = 0;
+    if ((s.attributes & z8000_segment::DOWNWARD) ? block < s.limit : block > s.limit)
+        type |= z8000_segment_violation::LENGTH;
+    if (s.attributes & (z8000_segment::READ_ONLY | z8000_segment::SYSTEM_ONLY |
+                        z8000_segment::CPU_INHIBIT | z8000_segment::EXEC_ONLY))
+    {
+        if ((s.attributes & z8000_segment::READ_ONLY) && access == MMU_WRITE)
+            type |= z8000_segment_violation::READ_ONLY;
+        if ((s.attributes & z8000_segment::SYSTEM_ONLY) && !(m_fcw & F_S_N))
+            type |= z8000_segment_violation::SYSTEM_ONLY;
+        if ((s.attributes & z8000_segment::EXEC_ONLY) && access != MMU_FETCH)
+            type |= z8000_segment_violation::EXEC_ONLY;
+        if (s.attributes & z8000_segment::CPU_INHIBIT)
+            type |= z8000_segment_violation::CPU_INHIBIT;
+    }
+    if (type)
+    {
+        segment_violation(addr, access, type);
+        if (access == MMU_WRITE || (type & z8000_segment_violation::CPU_INHIBIT))
+            return false;
+    }
+
+    s.attributes |= (access == MMU_WRITE) ? z8000_segment::REFERENCED | z8000_segment::CHANGED
+                                          : z8000_segment::REFERENCED;
+    addr = ((uint32_t(s.base) << 8) + offset) & 0xffffff;
+    return true;
+}
+
+void z8002_device::segment_violation(uint32_t addr, int access, uint8_t type)
+{
+    if (!m_segment_violation.type)
+    {
+        m_segment_violation.segment = (addr >> 16) & 0x7f;
+        m_segment_violation.offset = addr & 0xffff;
+        m_segment_violation.write = access == MMU_WRITE;
+        m_segment_violation.fetch = access == MMU_FETCH;
+    }
+    m_segment_violation.type |= type;
+    m_irq_req |= Z8000_SEGTRAP;
+}
 
 uint16_t z8002_device::RDOP()
 {
@@ -145,6 +278,7 @@ uint32_t z8002_device::get_operand(int opnum)
     return m_op[opnum];
 }
 
+template<bool Z8001>
 uint32_t z8002_device::get_addr_operand(int opnum)
 {
     int i;
@@ -158,7 +292,7 @@ uint32_t z8002_device::get_addr_operand(int opnum)
     {
         uint32_t seg = m_cache.read_word(m_pc);
         m_pc += 2;
-        if (get_segmented_mode())
+        if (segmented<Z8001>())
         {
             if (seg & 0x8000)
             {
@@ -175,6 +309,7 @@ uint32_t z8002_device::get_addr_operand(int opnum)
     return m_op[opnum];
 }
 
+template<bool Z8001>
 uint32_t z8002_device::get_raw_addr_operand(int opnum)
 {
     int i;
@@ -188,7 +323,7 @@ uint32_t z8002_device::get_raw_addr_operand(int opnum)
     {
         uint32_t seg = m_cache.read_word(m_pc);
         m_pc += 2;
-        if (get_segmented_mode())
+        if (segmented<Z8001>())
         {
             if (seg & 0x8000)
             {
@@ -205,63 +340,97 @@ uint32_t z8002_device::get_raw_addr_operand(int opnum)
     return m_op[opnum];
 }
 
-uint32_t z8002_device::adjust_addr_for_nonseg_mode(uint32_t addr)
-{
-    return addr;
-}
-
-uint32_t z8001_device::adjust_addr_for_nonseg_mode(uint32_t addr)
-{
-    if (!(m_fcw & F_SEG))
-    {
-        return (addr & 0xffff) | (m_pc & 0x7f0000);
-    }
-    else
-    {
-        return addr;
-    }
-}
-
+template<bool Z8001>
 uint8_t z8002_device::RDMEM_B(mem_specific &space, uint32_t addr)
 {
-    addr = adjust_addr_for_nonseg_mode(addr);
+    addr = adjust_addr_for_nonseg_mode<Z8001>(addr);
+    if (Z8001 && m_segments && !translate(addr, MMU_READ))
+        return 0xff;
     return space.read_byte(addr);
 }
 
+template<bool Z8001>
 uint16_t z8002_device::RDMEM_W(mem_specific &space, uint32_t addr)
 {
-    addr = adjust_addr_for_nonseg_mode(addr);
+    addr = adjust_addr_for_nonseg_mode<Z8001>(addr);
     addr &= ~1;
+    if (Z8001 && m_segments && !translate(addr, MMU_READ))
+        return 0xffff;
     return space.read_word(addr);
 }
 
+template<bool Z8001>
 uint32_t z8002_device::RDMEM_L(mem_specific &space, uint32_t addr)
 {
     uint32_t result;
-    addr = adjust_addr_for_nonseg_mode(addr);
+    addr = adjust_addr_for_nonseg_mode<Z8001>(addr);
     addr &= ~1;
+    if (Z8001 && m_segments)
+    {
+        uint32_t lo = addr_add(addr, 2);
+        result = translate(addr, MMU_READ) ? space.read_word(addr) << 16 : 0xffff0000;
+        return result | (translate(lo, MMU_READ) ? space.read_word(lo) : 0xffff);
+    }
     result = space.read_word(addr) << 16;
     return result + space.read_word(addr_add(addr, 2));
 }
 
+void z8002_device::note_code_write(mem_specific &space, uint32_t addr)
+{
+    if (space.psa && (addr >> Z8000_PAGE_SHIFT) - m_psa_page < PSA_PAGES)
+        invalidate_vectors();
+    if (space.code_pages)
+    {
+        uint32_t page = (addr >> BLOCK_PAGE_SHIFT) & m_page_mask;
+        if (space.code_pages[page])
+            invalidate_code_page(page);
+    }
+}
+
+template<bool Z8001>
 void z8002_device::WRMEM_B(mem_specific &space, uint32_t addr, uint8_t value)
 {
-    addr = adjust_addr_for_nonseg_mode(addr);
+    addr = adjust_addr_for_nonseg_mode<Z8001>(addr);
+    if (Z8001 && m_segments && !translate(addr, MMU_WRITE))
+        return;
+    note_code_write(space, addr);
     uint16_t value16 = value | (value << 8);
     space.write_word(addr & ~1, value16, BIT(addr, 0) ? 0x00ff : 0xff00);
 }
 
+template<bool Z8001>
 void z8002_device::WRMEM_W(mem_specific &space, uint32_t addr, uint16_t value)
 {
-    addr = adjust_addr_for_nonseg_mode(addr);
+    addr = adjust_addr_for_nonseg_mode<Z8001>(addr);
     addr &= ~1;
+    if (Z8001 && m_segments && !translate(addr, MMU_WRITE))
+        return;
+    note_code_write(space, addr);
     space.write_word(addr, value);
 }
 
+template<bool Z8001>
 void z8002_device::WRMEM_L(mem_specific &space, uint32_t addr, uint32_t value)
 {
-    addr = adjust_addr_for_nonseg_mode(addr);
+    addr = adjust_addr_for_nonseg_mode<Z8001>(addr);
     addr &= ~1;
+    if (Z8001 && m_segments)
+    {
+        uint32_t lo = addr_add(addr, 2);
+        if (translate(addr, MMU_WRITE))
+        {
+            note_code_write(space, addr);
+            space.write_word(addr, value >> 16);
+        }
+        if (translate(lo, MMU_WRITE))
+        {
+            note_code_write(space, lo);
+            space.write_word(lo, value & 0xffff);
+        }
+        return;
+    }
+    note_code_write(space, addr);
+    note_code_write(space, addr_add(addr, 2));
     space.write_word(addr, value >> 16);
     space.write_word(addr_add(addr, 2), value & 0xffff);
 }
@@ -295,186 +464,369 @@ void z8002_device::cycles(int cyc)
 #include <z8000/z8000ops.hxx>
 #include <z8000/z8000tbl.hxx>
 
-void z8002_device::PUSH_PC()
+/* the zero, sign, parity lookup table */
+static constexpr std::array<u8, 256> make_zsp_table()
 {
-    PUSHW(SP, m_pc);        /* save current pc */
+    std::array<u8, 256> zsp{};
+    for (int i = 0; i < 256; i++)
+        zsp[i] = ((i == 0) ? F_Z : 0) |
+                 ((i & 128) ? F_S : 0) |
+                 ((((i>>7)^(i>>6)^(i>>5)^(i>>4)^(i>>3)^(i>>2)^(i>>1)^i) & 1) ? 0 : F_PV);
+    return zsp;
 }
 
-void z8001_device::PUSH_PC()
+/* map every opcode word to its entry in table[]; later entries override
+   the catch-all zinvalid entry at the top */
+constexpr std::array<u16, 0x10000> z8002_device::make_exec_table()
 {
-    PUSHL(SP, make_segmented_addr(m_pc));        /* save current pc */
+    std::array<u16, 0x10000> exec{};
+    for (const Z8000_init *opc = table; opc->size; opc++)
+        for (int val = opc->beg; val <= opc->end; val += opc->step)
+            exec[val] = opc - table;
+    return exec;
 }
 
+constexpr std::array<u16, 0x10000> z8002_device::z8000_exec = make_exec_table();
 
-uint32_t z8002_device::GET_PC(uint32_t VEC)
+#if Z8000_THREADED_DISPATCH
+template <unsigned Index, bool Z8001>
+void z8002_device::threaded_op(z8002_device &cpu, unsigned chain)
 {
-    return RDMEM_W(m_program, VEC + 2);
+    constexpr int cycles = table[Index].cycles;
+    constexpr opcode_func opcode = table[Index].opcode[Z8001];
+
+    cpu.m_icount -= cycles;
+    cpu.m_total_cycles += cycles;
+    (cpu.*opcode)();
+    cpu.m_op_valid = 0;
+
+    /* anything run_loop() looks at between instructions ends the chain */
+    if (--chain == 0 || cpu.m_icount <= 0 || cpu.m_halt || cpu.m_irq_req)
+        return;
+
+    cpu.m_ppc = cpu.m_pc;
+    cpu.m_op[0] = cpu.RDOP();
+    cpu.m_op_valid = 1;
+    threaded_dispatch[Z8001][cpu.m_op[0]](cpu, chain);
 }
 
-uint32_t z8001_device::GET_PC(uint32_t VEC)
+/* the entry function of every opcode word, one 8-byte pointer each */
+template <bool Z8001, size_t... Index>
+constexpr std::array<z8002_device::threaded_func, 0x10000>
+z8002_device::make_threaded_table(std::index_sequence<Index...>)
 {
-    return segmented_addr(RDMEM_L(m_program, VEC + 4));
+    constexpr threaded_func entries[] = { &threaded_op<Index, Z8001>... };
+    std::array<threaded_func, 0x10000> dispatch{};
+    for (int op = 0; op < 0x10000; op++)
+        dispatch[op] = entries[z8000_exec[op]];
+    return dispatch;
 }
 
-uint32_t z8002_device::get_reset_pc()
+/* all entries but the terminating one */
+constexpr std::array<z8002_device::threaded_func, 0x10000> z8002_device::threaded_dispatch[2] = {
+    make_threaded_table<false>(std::make_index_sequence<std::size(table) - 1>()),
+    make_threaded_table<true>(std::make_index_sequence<std::size(table) - 1>()),
+};
+#endif
+constexpr std::array<u8, 256> z8002_device::z8000_zsp = make_zsp_table();
+
+/* the request bits do not run in priority order (SYSCALL, bit 1, comes
+   before SEGTRAP and NMI) and are part of z8000_state, so the highest
+   priority one is looked up rather than bit scanned */
+static constexpr std::array<u8, 256> make_irq_pick_table()
 {
-    return RDMEM_W(m_program, 4);
+    constexpr u8 order[] = { 0x01, 0x80, 0x40, 0x02, 0x10, 0x20, 0x08, 0x04 };
+    std::array<u8, 256> pick{};
+    for (int req = 1; req < 256; req++)
+        for (u8 bit : order)
+            if (req & bit)
+            {
+                pick[req] = bit;
+                break;
+            }
+    return pick;
 }
 
-uint32_t z8001_device::get_reset_pc()
+constexpr std::array<u8, 256> z8002_device::z8000_irq_pick = make_irq_pick_table();
+
+/* the former 2KB Z8000_dab table, now tests/z8000dab.h, reduced to the
+   correction its entries add: index C<<3 | DA<<2 | H<<1 | (low digit > 9).
+   After an add/adc the upper digit wants adjusting from 0x90 up once the
+   lower one carries, from 0xa0 up otherwise; after a sub/sbc the carry
+   and half carry alone decide. */
+constexpr std::array<z8002_device::dab_rule, 16> z8002_device::z8000_dab = {{
+    /* add, no carry */
+    { 0x0a0, { 0x00, 0x60 } }, { 0x090, { 0x06, 0x66 } }, { 0x0a0, { 0x06, 0x66 } }, { 0x0a0, { 0x06, 0x66 } },
+    /* sub, no borrow */
+    { 0x100, { 0x00, 0x00 } }, { 0x100, { 0x00, 0x00 } }, { 0x000, { 0x00, 0xfa } }, { 0x000, { 0x00, 0xfa } },
+    /* add, carry */
+    { 0x000, { 0x00, 0x60 } }, { 0x000, { 0x00, 0x66 } }, { 0x000, { 0x00, 0x60 } }, { 0x000, { 0x00, 0x66 } },
+    /* sub, borrow */
+    { 0x000, { 0x00, 0xa0 } }, { 0x000, { 0x00, 0x9a } }, { 0x000, { 0x00, 0x9a } }, { 0x000, { 0x00, 0x9a } },
+}};
+
+template<bool Z8001>
+void z8002_device::PUSH_PC()
 {
-    return segmented_addr(RDMEM_L(m_program, 4));
+    if (Z8001)
+        PUSHL<Z8001>(SP, make_segmented_addr(m_pc));        /* save current pc */
+    else
+        PUSHW<Z8001>(SP, m_pc);        /* save current pc */
 }
 
-uint16_t z8002_device::GET_FCW(uint32_t VEC)
+
+template<bool Z8001>
+uint32_t z8002_device::GET_PC(uint32_t VEC)
 {
-    return RDMEM_W(m_program, VEC);
+    if (Z8001)
+        return segmented_addr(RDMEM_L<Z8001>(m_program, VEC + 4));
+    return RDMEM_W<Z8001>(m_program, VEC + 2);
 }
 
-uint16_t z8001_device::GET_FCW(uint32_t VEC)
+template<bool Z8001>
+uint32_t z8002_device::get_reset_pc()
 {
-    return RDMEM_W(m_program, VEC + 2);
+    if (Z8001)
+        return segmented_addr(RDMEM_L<Z8001>(m_program, 4));
+    return RDMEM_W<Z8001>(m_program, 4);
 }
 
-uint32_t z8002_device::F_SEG_Z8001()
+template<bool Z8001>
+uint16_t z8002_device::GET_FCW(uint32_t VEC)
 {
-    return 0;
+    return RDMEM_W<Z8001>(m_program, Z8001 ? VEC + 2 : VEC);
 }
 
-uint32_t z8001_device::F_SEG_Z8001()
+template<bool Z8001>
+uint32_t z8002_device::F_SEG_Z8001()
 {
-    return F_SEG;
+    return Z8001 ? F_SEG : 0;
 }
 
+template<bool Z8001>
 uint32_t z8002_device::PSA_ADDR()
 {
+    if (Z8001)
+        return segmented_addr((m_psapseg << 16) | m_psapoff);
     return m_psapoff;
 }
 
-uint32_t z8001_device::PSA_ADDR()
-{
-    return segmented_addr((m_psapseg << 16) | m_psapoff);
-}
-
 
+template<bool Z8001>
 void z8002_device::Interrupt()
 {
-    uint16_t fcw = m_fcw;
+    uint16_t fcw = sync_fcw();
+    const uint8_t req = m_irq_req;
+
+    /* NVI and VI only while enabled */
+    const uint8_t masked = ((fcw & F_NVIE) ? 0 : Z8000_NVI) | ((fcw & F_VIE) ? 0 : Z8000_VI);
+
+    const uint8_t pick = z8000_irq_pick[req & ~masked];
 
-    if (m_irq_req & Z8000_RESET)
+    switch (pick)
     {
+    case Z8000_RESET:
         m_irq_req &= Z8000_NVI | Z8000_VI;
-        CHANGE_FCW(RDMEM_W(m_program, 2)); /* get reset m_fcw */
-        m_pc = get_reset_pc(); /* get reset m_pc  */
-    }
-    else
+        CHANGE_FCW<Z8001>(RDMEM_W<Z8001>(m_program, 2)); /* get reset m_fcw */
+        m_pc = get_reset_pc<Z8001>(); /* get reset m_pc  */
+        break;
+
     /* trap ? */
-    if (m_irq_req & Z8000_EPU)
-    {
-        CHANGE_FCW(fcw | F_S_N | F_SEG_Z8001());/* switch to segmented (on Z8001) system mode */
-        PUSH_PC();
-        PUSHW(SP, fcw);       /* save current m_fcw */
-        PUSHW(SP, m_op[0]);   /* for internal traps, the 1st word of the instruction is pushed */
+    case Z8000_EPU:
+        CHANGE_FCW<Z8001>(fcw | F_S_N | F_SEG_Z8001<Z8001>());/* switch to segmented (on Z8001) system mode */
+        PUSH_PC<Z8001>();
+        PUSHW<Z8001>(SP, fcw);       /* save current m_fcw */
+        PUSHW<Z8001>(SP, m_op[0]);   /* for internal traps, the 1st word of the instruction is pushed */
         m_irq_req &= ~Z8000_EPU;
-        CHANGE_FCW(GET_FCW(EPU));
-        m_pc = GET_PC(EPU);
+        CHANGE_FCW<Z8001>(GET_FCW<Z8001>(EPU));
+        m_pc = GET_PC<Z8001>(EPU);
         LOG("Z8K ext instr trap $%04x\n", m_pc);
-    }
-    else
-    if (m_irq_req & Z8000_TRAP)
-    {
-        CHANGE_FCW(fcw | F_S_N | F_SEG_Z8001());/* switch to segmented (on Z8001) system mode */
-        PUSH_PC();
-        PUSHW(SP, fcw);       /* save current m_fcw */
-        PUSHW(SP, m_op[0]);   /* for internal traps, the 1st word of the instruction is pushed */
+        break;
+
+    case Z8000_TRAP:
+        CHANGE_FCW<Z8001>(fcw | F_S_N | F_SEG_Z8001<Z8001>());/* switch to segmented (on Z8001) system mode */
+        PUSH_PC<Z8001>();
+        PUSHW<Z8001>(SP, fcw);       /* save current m_fcw */
+        PUSHW<Z8001>(SP, m_op[0]);   /* for internal traps, the 1st word of the instruction is pushed */
         m_irq_req &= ~Z8000_TRAP;
-        CHANGE_FCW(GET_FCW(TRAP));
-        m_pc = GET_PC(TRAP);
+        CHANGE_FCW<Z8001>(GET_FCW<Z8001>(TRAP));
+        m_pc = GET_PC<Z8001>(TRAP);
         LOG("Z8K priv instr trap $%04x\n", m_pc);
-    }
-    else
-    if (m_irq_req & Z8000_SYSCALL)
-    {
-        CHANGE_FCW(fcw | F_S_N | F_SEG_Z8001());/* switch to segmented (on Z8001) system mode */
-        PUSH_PC();
-        PUSHW(SP, fcw);       /* save current m_fcw */
-        PUSHW(SP, m_op[0]);   /* for internal traps, the 1st word of the instruction is pushed */
+        break;
+
+    case Z8000_SYSCALL:
+        CHANGE_FCW<Z8001>(fcw | F_S_N | F_SEG_Z8001<Z8001>());/* switch to segmented (on Z8001) system mode */
+        PUSH_PC<Z8001>();
+        PUSHW<Z8001>(SP, fcw);       /* save current m_fcw */
+        PUSHW<Z8001>(SP, m_op[0]);   /* for internal traps, the 1st word of the instruction is pushed */
         m_irq_req &= ~Z8000_SYSCALL;
-        CHANGE_FCW(GET_FCW(SYSCALL));
-        m_pc = GET_PC(SYSCALL);
+        CHANGE_FCW<Z8001>(GET_FCW<Z8001>(SYSCALL));
+        m_pc = GET_PC<Z8001>(SYSCALL);
         LOG("Z8K syscall [$%02x/$%04x]\n", m_op[0] & 0xff, m_pc);
-    }
-    else
-    if (m_irq_req & Z8000_SEGTRAP)
-    {
+        break;
+
+    case Z8000_SEGTRAP:
         m_irq_vec = 0;  // No interrupt acknowledge in standalone
 
-        CHANGE_FCW(fcw | F_S_N | F_SEG_Z8001());/* switch to segmented (on Z8001) system mode */
-        PUSH_PC();
-        PUSHW(SP, fcw);       /* save current m_fcw */
-        PUSHW(SP, m_irq_vec);   /* save interrupt/trap type tag */
+        CHANGE_FCW<Z8001>(fcw | F_S_N | F_SEG_Z8001<Z8001>());/* switch to segmented (on Z8001) system mode */
+        PUSH_PC<Z8001>();
+        PUSHW<Z8001>(SP, fcw);       /* save current m_fcw */
+        PUSHW<Z8001>(SP, m_irq_vec);   /* save interrupt/trap type tag */
         m_irq_req &= ~Z8000_SEGTRAP;
-        CHANGE_FCW(GET_FCW(SEGTRAP));
-        m_pc = GET_PC(SEGTRAP);
+        CHANGE_FCW<Z8001>(GET_FCW<Z8001>(SEGTRAP));
+        m_pc = GET_PC<Z8001>(SEGTRAP);
         LOG("Z8K segtrap $%04x\n", m_pc);
-    }
-    else
-    if (m_irq_req & Z8000_NMI)
-    {
-        m_irq_vec = 0;
+        break;
+
+    case Z8000_NMI:
+        m_irq_vec = m_irq_ident[NMI_LINE];
         m_halt = false;
+        count_irq(NMI_LINE);
 
-        CHANGE_FCW(fcw | F_S_N | F_SEG_Z8001());/* switch to segmented (on Z8001) system mode */
-        PUSH_PC();
-        PUSHW(SP, fcw);       /* save current m_fcw */
-        PUSHW(SP, m_irq_vec);   /* save interrupt/trap type tag */
-        m_pc = RDMEM_W(m_program, NMI);
+        CHANGE_FCW<Z8001>(fcw | F_S_N | F_SEG_Z8001<Z8001>());/* switch to segmented (on Z8001) system mode */
+        PUSH_PC<Z8001>();
+        PUSHW<Z8001>(SP, fcw);       /* save current m_fcw */
+        PUSHW<Z8001>(SP, m_irq_vec);   /* save interrupt/trap type tag */
+        m_pc = RDMEM_W<Z8001>(m_program, NMI);
         m_irq_req &= ~Z8000_NMI;
-        CHANGE_FCW(GET_FCW(NMI));
-        m_pc = GET_PC(NMI);
+        CHANGE_FCW<Z8001>(GET_FCW<Z8001>(NMI));
+        m_pc = GET_PC<Z8001>(NMI);
         LOG("Z8K NMI $%04x\n", m_pc);
-    }
-    else
-    if ((m_irq_req & Z8000_NVI) && (m_fcw & F_NVIE))
-    {
-        m_irq_vec = 0;
+        break;
+
+    case Z8000_NVI:
+        m_irq_vec = m_irq_ident[NVI_LINE];
         m_halt = false;
+        count_irq(NVI_LINE);
 
-        CHANGE_FCW(fcw | F_S_N | F_SEG_Z8001());/* switch to segmented (on Z8001) system mode */
-        PUSH_PC();
-        PUSHW(SP, fcw);       /* save current m_fcw */
-        PUSHW(SP, m_irq_vec);   /* save interrupt/trap type tag */
-        m_pc = GET_PC(NVI);
+        CHANGE_FCW<Z8001>(fcw | F_S_N | F_SEG_Z8001<Z8001>());/* switch to segmented (on Z8001) system mode */
+        PUSH_PC<Z8001>();
+        PUSHW<Z8001>(SP, fcw);       /* save current m_fcw */
+        PUSHW<Z8001>(SP, m_irq_vec);   /* save interrupt/trap type tag */
+        m_pc = psa_vector(VEC_NVI_PC, [this] { return GET_PC<Z8001>(NVI); });
         m_irq_req &= ~Z8000_NVI;
-        CHANGE_FCW(GET_FCW(NVI));
+        CHANGE_FCW<Z8001>(psa_vector(VEC_NVI_FCW, [this] { return GET_FCW<Z8001>(NVI); }));
         LOG("Z8K NVI $%04x\n", m_pc);
-    }
-    else
-    if ((m_irq_req & Z8000_VI) && (m_fcw & F_VIE))
-    {
-        m_irq_vec = 0;
+        break;
+
+    case Z8000_VI:
+        m_irq_vec = m_irq_ident[VI_LINE];
         m_halt = false;
+        count_irq(VI_LINE);
 
-        CHANGE_FCW(fcw | F_S_N | F_SEG_Z8001());/* switch to segmented (on Z8001) system mode */
-        PUSH_PC();
-        PUSHW(SP, fcw);       /* save current m_fcw */
-        PUSHW(SP, m_irq_vec);   /* save interrupt/trap type tag */
-        m_pc = read_irq_vector();
+        CHANGE_FCW<Z8001>(fcw | F_S_N | F_SEG_Z8001<Z8001>());/* switch to segmented (on Z8001) system mode */
+        PUSH_PC<Z8001>();
+        PUSHW<Z8001>(SP, fcw);       /* save current m_fcw */
+        PUSHW<Z8001>(SP, m_irq_vec);   /* save interrupt/trap type tag */
+        m_pc = psa_vector(m_irq_vec & 0xff, [this] { return read_irq_vector<Z8001>(); });
         m_irq_req &= ~Z8000_VI;
-        CHANGE_FCW(GET_FCW(VI));
+        CHANGE_FCW<Z8001>(psa_vector(VEC_VI_FCW, [this] { return GET_FCW<Z8001>(VI); }));
         LOG("Z8K VI [$%04x/$%04x] fcw $%04x, pc $%04x\n", m_irq_vec, VEC00 + 2 * (m_irq_vec & 0xff), m_fcw, m_pc);
+        break;
     }
+
+    /* whatever was taken clears its request; a loop it broke into has
+       run other code since its last pass, and the instruction it was
+       going to step past is not the next one any more */
+    if (m_irq_req != req)
+    {
+        m_idle_loop.valid = false;
+        m_break_skip = false;
+    }
+
+    if (pick && (m_profile.modes & z8000_profile::TRAPS))
+        profile_trap(pick);
 }
 
-uint32_t z8002_device::read_irq_vector()
+/* a vector as read(), from the cache where it can be trusted */
+template<typename Read>
+uint32_t z8002_device::psa_vector(unsigned slot, Read read)
 {
-    return RDMEM_W(m_program, VEC00 + 2 * (m_irq_vec & 0xff));
+    if (m_segments || m_memory_stats || m_mem_watches)
+        return read();
+    cached_vector &v = m_vectors[slot];
+    if (v.gen != m_vector_gen)
+    {
+        v.value = read();
+        v.gen = m_vector_gen;
+    }
+    return v.value;
 }
 
+void z8002_device::invalidate_vectors()
+{
+    /* a wrapped generation would match stale entries */
+    if (++m_vector_gen == 0)
+    {
+        m_vectors.fill(cached_vector());
+        m_vector_gen = 1;
+    }
+}
+
+void z8002_device::update_psa()
+{
+    const uint32_t psa = m_z8001 ? segmented_addr((m_psapseg << 16) | m_psapoff) : m_psapoff;
+    m_psa_page = psa >> Z8000_PAGE_SHIFT;
+    invalidate_vectors();
+}
+
+void z8002_device::count_irq(int line)
+{
+    irq_stats &s = m_irq_stats[line];
+    const uint64_t latency = m_total_cycles - m_irq_asserted[line];
+    s.count++;
+    s.latency += latency;
+    s.max_latency = std::max(s.max_latency, latency);
+
+    /* a level-sensitive line still asserted comes round again from here */
+    m_irq_asserted[line] = m_total_cycles;
+}
+
+void z8002_device::clear_irq_stats()
+{
+    for (irq_stats &s : m_irq_stats)
+        s = irq_stats();
+}
+
+void z8002_device::set_input_line(int line, int state, uint16_t vector)
+{
+    const bool asserted = state != CLEAR_LINE;
+
+    if (line == NMI_LINE)
+    {
+        /* edge triggered: one request per assertion */
+        if (asserted && m_nmi_state == CLEAR_LINE)
+        {
+            m_irq_req |= Z8000_NMI;
+            m_irq_asserted[NMI_LINE] = m_total_cycles;
+        }
+        m_nmi_state = state;
+        m_irq_ident[NMI_LINE] = vector;
+        return;
+    }
+    if (line != NVI_LINE && line != VI_LINE)
+        return;
+
+    /* level sensitive: requested while asserted and enabled; CHANGE_FCW
+       follows the enable bits from here on */
+    const uint8_t req = (line == NVI_LINE) ? Z8000_NVI : Z8000_VI;
+    const uint16_t enable = (line == NVI_LINE) ? F_NVIE : F_VIE;
+    if (asserted && m_irq_state[line] == CLEAR_LINE)
+        m_irq_asserted[line] = m_total_cycles;
+    m_irq_state[line] = state;
+    m_irq_ident[line] = vector;
+    if (asserted && (m_fcw & enable))
+        m_irq_req |= req;
+    else
+        m_irq_req &= ~req;
+}
 
-uint32_t z8001_device::read_irq_vector()
+template<bool Z8001>
+uint32_t z8002_device::read_irq_vector()
 {
-    return segmented_addr(RDMEM_L(m_program, VEC00 + 2 * (m_irq_vec & 0xff)));
+    if (Z8001)
+        return segmented_addr(RDMEM_L<Z8001>(m_program, VEC00 + 2 * (m_irq_vec & 0xff)));
+    return RDMEM_W<Z8001>(m_program, VEC00 + 2 * (m_irq_vec & 0xff));
 }
 
 
@@ -483,9 +835,13 @@ void z8002_device::clear_internal_state()
     m_op[0] = m_op[1] = m_op[2] = m_op[3] = 0;
     m_ppc = 0;
     m_pc = 0;
+    m_break_skip = false;
     m_psapseg = 0;
     m_psapoff = 0;
     m_fcw = 0;
+#if Z8000_LAZY_FLAGS
+    m_lf_op = LF_NONE;
+#endif
     m_refresh = 0;
     m_nspseg = 0;
     m_nspoff = 0;
@@ -495,21 +851,12 @@ void z8002_device::clear_internal_state()
     m_regs.Q[0] = m_regs.Q[1] = m_regs.Q[2] = m_regs.Q[3] = 0;
     m_nmi_state = 0;
     m_irq_state[0] = m_irq_state[1] = 0;
+    m_irq_ident[0] = m_irq_ident[1] = m_irq_ident[2] = 0;
     m_halt = false;
     m_total_cycles = 0;
-}
-
-void z8002_device::init_tables()
-{
-    /* set up the zero, sign, parity lookup table */
-    for (int i = 0; i < 256; i++)
-        z8000_zsp[i] = ((i == 0) ? F_Z : 0) |
-                        ((i & 128) ? F_S : 0) |
-                        ((((i>>7)^(i>>6)^(i>>5)^(i>>4)^(i>>3)^(i>>2)^(i>>1)^i) & 1) ? 0 : F_PV);
-
-    for (const Z8000_init *opc = table; opc->size; opc++)
-        for (int val = opc->beg; val <= opc->end; val += opc->step)
-            z8000_exec[val] = opc - table;
+    for (uint64_t &cycle : m_irq_asserted)
+        cycle = 0;
+    update_psa();
 }
 
 void z8002_device::reset()
@@ -521,41 +868,324 @@ void z8002_device::reset()
     m_mi = CLEAR_LINE;
 }
 
+static_assert(sizeof(z8000_state) == 120, "z8000_state layout changed, bump VERSION");
+static_assert(std::is_trivially_copyable<z8000_state>::value, "z8000_state must stay plain data");
+
+void z8002_device::save_state(z8000_state& state) const
+{
+    memset(&state, 0, sizeof(state));
+    state.magic = z8000_state::MAGIC;
+    state.version = z8000_state::VERSION;
+    state.size = sizeof(state);
+    state.model = model();
+    state.halted = m_halt;
+    state.irq_req = m_irq_req;
+    state.fcw = get_fcw();
+    state.refresh = m_refresh;
+    state.psapseg = m_psapseg;
+    state.psapoff = m_psapoff;
+    state.nspseg = m_nspseg;
+    state.nspoff = m_nspoff;
+    state.irq_vec = m_irq_vec;
+    for (int i = 0; i < 16; i++)
+        state.regs[i] = get_reg(i);
+    state.pc = m_pc;
+    state.ppc = m_ppc;
+    for (int i = 0; i < 4; i++)
+        state.op[i] = m_op[i];
+    state.op_valid = m_op_valid;
+    state.nmi_state = m_nmi_state;
+    state.irq_state[0] = m_irq_state[0];
+    state.irq_state[1] = m_irq_state[1];
+    for (int i = 0; i < 3; i++)
+        state.irq_ident[i] = m_irq_ident[i];
+    state.mi = m_mi;
+    state.total_cycles = m_total_cycles;
+}
+
+bool z8002_device::load_state(const z8000_state& state)
+{
+    if (state.magic != z8000_state::MAGIC || state.version != z8000_state::VERSION
+        || state.size != sizeof(state)) {
+        fprintf(stderr, "Error: Unsupported CPU state (version %u, %u bytes)\n",
+                state.version, state.size);
+        return false;
+    }
+    if (state.model != model()) {
+        fprintf(stderr, "Error: CPU state is for a Z%u, not a Z%u\n", state.model, model());
+        return false;
+    }
+
+    sync_fcw();
+    m_halt = state.halted;
+    m_irq_req = state.irq_req;
+    m_fcw = state.fcw;
+    m_refresh = state.refresh;
+    m_psapseg = state.psapseg;
+    m_psapoff = state.psapoff & 0xff00;  /* as LDCTL stores it */
+    m_nspseg = state.nspseg;
+    m_nspoff = state.nspoff;
+    m_irq_vec = state.irq_vec;
+    for (int i = 0; i < 16; i++)
+        set_reg(i, state.regs[i]);
+    m_pc = state.pc;
+    m_ppc = state.ppc;
+    m_break_skip = false;
+    for (int i = 0; i < 4; i++)
+        m_op[i] = state.op[i];
+    m_op_valid = state.op_valid;
+    m_nmi_state = state.nmi_state;
+    m_irq_state[0] = state.irq_state[0];
+    m_irq_state[1] = state.irq_state[1];
+    for (int i = 0; i < 3; i++)
+        m_irq_ident[i] = state.irq_ident[i];
+    m_mi = state.mi;
+    m_total_cycles = state.total_cycles;
+    m_stop_req = false;
+    for (uint64_t &cycle : m_irq_asserted)
+        cycle = m_total_cycles;
+    update_psa();
+
+    if (m_block_cache)
+        invalidate_block_cache();
+    return true;
+}
+
+namespace {
+
+/* program memory as the MMU maps it, for the tracer's own reads: no
+   violation checks and no referenced bits */
+class segment_reader : public z8000_memory_bus {
+public:
+    segment_reader(z8000_memory_bus* bus, const z8000_segment* segments) : m_bus(bus), m_segments(segments) {}
+    uint8_t read_byte(uint32_t addr) override { return m_bus->read_byte(physical(addr)); }
+    uint16_t read_word(uint32_t addr) override { return m_bus->read_word(physical(addr)); }
+    void write_byte(uint32_t addr, uint8_t val) override { m_bus->write_byte(physical(addr), val); }
+    void write_word(uint32_t addr, uint16_t val) override { m_bus->write_word(physical(addr), val); }
+    void write_word(uint32_t addr, uint16_t val, uint16_t mask) override { m_bus->write_word(physical(addr), val, mask); }
+private:
+    uint32_t physical(uint32_t addr) const {
+        return ((uint32_t(m_segments[(addr >> 16) & 0x7f].base) << 8) + (addr & 0xffff)) & 0xffffff;
+    }
+    z8000_memory_bus* m_bus;
+    const z8000_segment* m_segments;
+};
+
+} // anonymous namespace
+
 void z8002_device::trace_instruction()
 {
-    // Create a data buffer from program memory bus for the disassembler
-    data_buffer opcodes;
-    if (m_program_bus) {
-        opcodes.set_bus(m_program_bus);
+    if (m_trace_sink) {
+        // The opcode words are only known once the handler has fetched
+        // them, so the record is completed by trace_record()
+        m_trace_insn.type = Z8000_TRACE_INSN;
+        m_trace_insn.fcw = get_fcw();
+        m_trace_insn.pc = m_ppc;
+        m_trace_insn.cycles = m_total_cycles;
+        return;
     }
 
-    // Disassemble the instruction
+    if (!m_program_bus)
+        return;
+
     // Use full address (with segment for Z8001) so the bus reads from
     // the correct segment and the disassembler sees the right opcodes.
-    std::ostringstream stream;
-    offs_t pc = m_ppc;  // Full address including segment
-    offs_t result = m_disasm->disassemble(stream, pc, opcodes, opcodes);
-    offs_t size = result & 0x0FFFFFFF;  // Mask off STEP_* flags
-
-    // Print PC and opcode bytes
-    if (get_segmented_mode() && (pc >> 16)) {
-        printf("<<%X>>%04X:", (pc >> 16) & 0x7F, pc & 0xFFFF);
-    } else {
-        printf("PC=%04X:", pc & 0xFFFF);
+    const offs_t pc = m_ppc;
+    const bool seg = get_segmented_mode();
+    segment_reader mapped(m_program_bus, m_segments);
+    z8000_memory_bus* program = m_segments ? &mapped : m_program_bus;
+    if (m_dasm_cache.empty())
+        m_dasm_cache.resize(DASM_CACHE_SLOTS);
+    dasm_entry &e = m_dasm_cache[(pc >> 1) & (DASM_CACHE_SLOTS - 1)];
+
+    uint16_t op[4];
+    op[0] = program->read_word(pc);
+    bool hit = e.size && e.pc == pc && e.seg == seg && e.op[0] == op[0];
+    for (offs_t i = 1; hit && i < e.size / 2u; i++)
+    {
+        op[i] = program->read_word(pc + 2 * i);
+        hit = e.op[i] == op[i];
+    }
+
+    if (!hit)
+    {
+        data_buffer opcodes;
+        opcodes.set_bus(program);
+        util::text_appender text(e.text, sizeof(e.text));
+        e.size = m_disasm->disassemble(text, pc, opcodes, opcodes) & 0x0FFFFFFF;  // Mask off STEP_* flags
+        e.pc = pc;
+        e.seg = seg;
+        e.op[0] = op[0];
+        for (offs_t i = 1; i < e.size / 2u; i++)
+            e.op[i] = program->read_word(pc + 2 * i);
+    }
+
+    // PC, opcode words padded for alignment (max 3 words), disassembly
+    char line[48 + sizeof(e.text)];
+    util::text_appender out(line, sizeof(line));
+    if (seg && (pc >> 16))
+        out.format("<<%X>>%04X:", (pc >> 16) & 0x7F, pc & 0xFFFF);
+    else
+        out.format("PC=%04X:", pc & 0xFFFF);
+    for (offs_t i = 0; i < e.size / 2u; i++)
+        out.format(" %04X", e.op[i]);
+    for (offs_t i = e.size; i < 6; i += 2)
+        out.append("     ");
+    out.append("  ");
+    out.append(e.text);
+    puts(line);
+}
+
+void z8002_device::trace_record()
+{
+    uint8_t words = 0;
+    while (words < 4 && (m_op_valid & (1 << words))) {
+        m_trace_insn.op[words] = m_op[words];
+        words++;
+    }
+    m_trace_insn.size = 16 + 2 * words;
+    m_trace_sink->write(&m_trace_insn, m_trace_insn.size);
+}
+
+void z8002_device::trace_regs()
+{
+    z8000_trace_regs rec;
+    rec.type = Z8000_TRACE_REGS;
+    rec.fcw = get_fcw();
+    rec.pc = m_pc;
+    rec.mask = 0;
+    rec.pad = 0;
+    int n = 0;
+    for (int i = 0; i < 16; i++) {
+        const uint16_t val = get_reg(i);
+        if (val != m_trace_regs[i] || (m_trace_mask & (1 << i))) {
+            m_trace_regs[i] = val;
+            rec.mask |= 1 << i;
+            rec.value[n++] = val;
+        }
     }
-    for (offs_t i = 0; i < size; i += 2) {
-        if (m_program_bus) {
-            printf(" %04X", m_program_bus->read_word(pc + i));
+    m_trace_mask = 0;
+    rec.size = 12 + 2 * n;
+    m_trace_sink->write(&rec, rec.size);
+}
+
+unsigned z8002_device::run_features() const
+{
+    return (m_trace ? RUN_TRACE : 0) | (m_reg_trace ? RUN_REGTRACE : 0) |
+           (m_profile.modes ? RUN_PROFILE : 0) | (m_breakpoints ? RUN_BREAK : 0);
+}
+
+/* about to execute a breakpoint's instruction?  Searches only pages
+   holding a breakpoint */
+inline bool z8002_device::at_breakpoint()
+{
+    if (!m_break_pages[(m_pc >> BLOCK_PAGE_SHIFT) & m_page_mask])
+        return false;
+
+    for (const debug_point &p : m_debug_points)
+    {
+        if (p.kind == z8000_debug_hit::BREAKPOINT && p.first == m_pc)
+        {
+            m_ppc = m_pc;
+            m_break_skip = true;
+            debug_hit(p, m_pc, 0, 0);
+            return true;
         }
     }
+    return false;
+}
+
+/* count one executed instruction; flat counters only, the report is
+   built by write_profile() */
+inline void z8002_device::profile_insn(unsigned index, uint64_t cycles)
+{
+    z8000_profile &prof = m_profile;
+
+    if (prof.modes & z8000_profile::OPCODES)
+    {
+        prof.opcodes[index].count++;
+        prof.opcodes[index].cycles += cycles;
+    }
 
-    // Pad for alignment (max 3 words = 6 bytes)
-    for (offs_t i = size; i < 6; i += 2) {
-        printf("     ");
+    if ((prof.modes & z8000_profile::PCS) && --prof.pc_countdown == 0)
+    {
+        prof.pc_countdown = prof.pc_period;
+        prof.pcs[(m_ppc >> z8000_profile::PC_SHIFT) & (prof.pcs.size() - 1)]++;
     }
 
-    // Print disassembly
-    printf("  %s\n", stream.str().c_str());
+    if ((prof.modes & z8000_profile::CALLS) && prof.kind[index])
+        profile_call(prof.kind[index]);
+}
+
+/* fetch and execute the instruction at m_pc */
+template <unsigned Features, bool Z8001>
+inline void z8002_device::execute_one()
+{
+    m_op[0] = RDOP();
+    m_op_valid = 1;
+
+    if (Features & RUN_TRACE)
+        trace_instruction();
+
+    const unsigned index = z8000_exec[m_op[0]];
+    const Z8000_init &exec = table[index];
+    const uint64_t start = m_total_cycles;
+
+    m_icount -= exec.cycles;
+    m_total_cycles += exec.cycles;
+    (this->*exec.opcode[Z8001])();
+    if ((Features & RUN_TRACE) && m_trace_sink)
+        trace_record();
+    if (Features & RUN_PROFILE)
+        profile_insn(index, m_total_cycles - start);
+    m_op_valid = 0;
+
+    if (Features & RUN_REGTRACE) {
+        if (m_trace_sink)
+            trace_regs();
+        else
+            dump_regs();
+    }
+}
+
+template <unsigned Features, bool Z8001>
+void z8002_device::run_loop()
+{
+    do
+    {
+        /* any interrupt request pending? */
+        if (m_irq_req)
+            Interrupt<Z8001>();
+
+        /* the instruction a breakpoint stopped at, or the next element
+           of a repeat instruction, runs without another check */
+        if ((Features & RUN_BREAK) && !m_halt)
+        {
+            if (m_break_skip)
+                m_break_skip = false;
+            else if (at_breakpoint())
+                break;
+        }
+
+        m_ppc = m_pc;
+
+        if (m_halt)
+        {
+            m_icount = 0;
+        }
+#if Z8000_THREADED_DISPATCH
+        else if (Features == 0)
+        {
+            m_op[0] = RDOP();
+            m_op_valid = 1;
+            threaded_dispatch[Z8001][m_op[0]](*this, THREADED_CHAIN);
+        }
+#endif
+        else
+        {
+            execute_one<Features, Z8001>();
+        }
+    } while (m_icount > 0 && !m_halt);
 }
 
 int z8002_device::step()
@@ -563,29 +1193,159 @@ int z8002_device::step()
     if (!m_program_bus || !m_io_bus) return -1;
 
     if (m_irq_req)
-        Interrupt();
+    {
+        if (m_z8001)
+            Interrupt<true>();
+        else
+            Interrupt<false>();
+    }
 
     if (m_halt)
         return 0;
 
     m_ppc = m_pc;
 
-    m_op[0] = RDOP();
-    m_op_valid = 1;
+    /* one element of a repeating instruction per step, as before */
+    m_inline_repeat = false;
+    m_idle_active = 0;
+    m_break_skip = false;
+    m_debug_hit = z8000_debug_hit();
 
-    if (m_trace)
-        trace_instruction();
+    /* report what was charged, including data-dependent timing */
+    const uint64_t start = m_total_cycles;
+    static void (z8002_device::*const steps[2][RUN_BREAK])() = {
+        {
+            &z8002_device::execute_one<0, false>,
+            &z8002_device::execute_one<RUN_TRACE, false>,
+            &z8002_device::execute_one<RUN_REGTRACE, false>,
+            &z8002_device::execute_one<RUN_TRACE | RUN_REGTRACE, false>,
+            &z8002_device::execute_one<RUN_PROFILE, false>,
+            &z8002_device::execute_one<RUN_PROFILE | RUN_TRACE, false>,
+            &z8002_device::execute_one<RUN_PROFILE | RUN_REGTRACE, false>,
+            &z8002_device::execute_one<RUN_PROFILE | RUN_TRACE | RUN_REGTRACE, false>,
+        },
+        {
+            &z8002_device::execute_one<0, true>,
+            &z8002_device::execute_one<RUN_TRACE, true>,
+            &z8002_device::execute_one<RUN_REGTRACE, true>,
+            &z8002_device::execute_one<RUN_TRACE | RUN_REGTRACE, true>,
+            &z8002_device::execute_one<RUN_PROFILE, true>,
+            &z8002_device::execute_one<RUN_PROFILE | RUN_TRACE, true>,
+            &z8002_device::execute_one<RUN_PROFILE | RUN_REGTRACE, true>,
+            &z8002_device::execute_one<RUN_PROFILE | RUN_TRACE | RUN_REGTRACE, true>,
+        },
+    };
+    (this->*steps[m_z8001][run_features() & ~RUN_BREAK])();
+    m_events.fire(m_total_cycles);
+    return m_total_cycles - start;
+}
 
-    const Z8000_init &exec = table[z8000_exec[m_op[0]]];
-    int cycles = exec.cycles;
-    m_total_cycles += cycles;
-    (this->*exec.opcode)();
-    m_op_valid = 0;
+void z8002_device::execute(int64_t budget)
+{
+    static void (z8002_device::*const loops[2][RUN_FEATURES])() = {
+        {
+            &z8002_device::run_loop<0, false>,
+            &z8002_device::run_loop<RUN_TRACE, false>,
+            &z8002_device::run_loop<RUN_REGTRACE, false>,
+            &z8002_device::run_loop<RUN_TRACE | RUN_REGTRACE, false>,
+            &z8002_device::run_loop<RUN_PROFILE, false>,
+            &z8002_device::run_loop<RUN_PROFILE | RUN_TRACE, false>,
+            &z8002_device::run_loop<RUN_PROFILE | RUN_REGTRACE, false>,
+            &z8002_device::run_loop<RUN_PROFILE | RUN_TRACE | RUN_REGTRACE, false>,
+            &z8002_device::run_loop<RUN_BREAK, false>,
+            &z8002_device::run_loop<RUN_BREAK | RUN_TRACE, false>,
+            &z8002_device::run_loop<RUN_BREAK | RUN_REGTRACE, false>,
+            &z8002_device::run_loop<RUN_BREAK | RUN_TRACE | RUN_REGTRACE, false>,
+            &z8002_device::run_loop<RUN_BREAK | RUN_PROFILE, false>,
+            &z8002_device::run_loop<RUN_BREAK | RUN_PROFILE | RUN_TRACE, false>,
+            &z8002_device::run_loop<RUN_BREAK | RUN_PROFILE | RUN_REGTRACE, false>,
+            &z8002_device::run_loop<RUN_BREAK | RUN_PROFILE | RUN_TRACE | RUN_REGTRACE, false>,
+        },
+        {
+            &z8002_device::run_loop<0, true>,
+            &z8002_device::run_loop<RUN_TRACE, true>,
+            &z8002_device::run_loop<RUN_REGTRACE, true>,
+            &z8002_device::run_loop<RUN_TRACE | RUN_REGTRACE, true>,
+            &z8002_device::run_loop<RUN_PROFILE, true>,
+            &z8002_device::run_loop<RUN_PROFILE | RUN_TRACE, true>,
+            &z8002_device::run_loop<RUN_PROFILE | RUN_REGTRACE, true>,
+            &z8002_device::run_loop<RUN_PROFILE | RUN_TRACE | RUN_REGTRACE, true>,
+            &z8002_device::run_loop<RUN_BREAK, true>,
+            &z8002_device::run_loop<RUN_BREAK | RUN_TRACE, true>,
+            &z8002_device::run_loop<RUN_BREAK | RUN_REGTRACE, true>,
+            &z8002_device::run_loop<RUN_BREAK | RUN_TRACE | RUN_REGTRACE, true>,
+            &z8002_device::run_loop<RUN_BREAK | RUN_PROFILE, true>,
+            &z8002_device::run_loop<RUN_BREAK | RUN_PROFILE | RUN_TRACE, true>,
+            &z8002_device::run_loop<RUN_BREAK | RUN_PROFILE | RUN_REGTRACE, true>,
+            &z8002_device::run_loop<RUN_BREAK | RUN_PROFILE | RUN_TRACE | RUN_REGTRACE, true>,
+        },
+    };
+
+    m_icount = budget;
+
+    /* instrumentation wants to see every element of a repeat instruction;
+       breakpoints only look at its first */
+    const unsigned features = run_features();
+    m_inline_repeat = !(features & ~RUN_BREAK);
+    if (!(features & RUN_BREAK))
+        m_break_skip = false;
+
+    /* an open-ended wait is left to spin: skipping it gains nothing */
+    m_idle_active = (!features && !m_memory_stats && budget < RUN_OPEN) ? m_idle_modes : 0;
+    m_idle_loop.valid = false;
+
+    if (m_block_cache && !features && !m_segments && !m_memory_stats)
+    {
+        if (m_z8001)
+            run_blocks<true>();
+        else
+            run_blocks<false>();
+    }
+    else
+        (this->*loops[m_z8001][features])();
+}
+
+/* execute up to target, stopping on each device event deadline on the way */
+void z8002_device::run_to(uint64_t target)
+{
+    for (;;)
+    {
+        m_events.fire(m_total_cycles);
+        if (m_stop_req || m_total_cycles >= target)
+            break;
 
-    if (m_reg_trace)
-        dump_regs();
+        const uint64_t until = std::min(target, m_events.next());
+        if (m_halt && !m_irq_req)
+        {
+            /* nothing but a device can end the HALT; skip to its event,
+               unless running open-ended, which means until HALT */
+            if (until == target || target == z8000_scheduler::NEVER)
+                break;
+            m_total_cycles = until;
+            continue;
+        }
+
+        execute(int64_t(std::min<uint64_t>(until - m_total_cycles, RUN_OPEN)));
+    }
+}
+
+void z8002_device::wait_until(uint64_t target)
+{
+    for (;;)
+    {
+        m_events.fire(m_total_cycles);
+        if (!m_halt || m_irq_req || m_total_cycles >= target)
+            break;
+        m_total_cycles = std::min(target, m_events.next());
+    }
+}
 
-    return cycles;
+uint64_t z8002_device::schedule_event(uint64_t cycle, z8000_scheduler::callback cb)
+{
+    /* called from a bus callback: end the running slice in time */
+    if (m_icount > 0 && cycle < m_total_cycles + m_icount)
+        m_icount = cycle > m_total_cycles ? int64_t(cycle - m_total_cycles) : 0;
+    return m_events.add(cycle, std::move(cb));
 }
 
 void z8002_device::run(int max_cycles)
@@ -599,54 +1359,881 @@ void z8002_device::run(int max_cycles)
         return;
     }
 
-    m_icount = (max_cycles < 0) ? 1000000 : max_cycles;
+    m_stop_req = false;
+    m_debug_hit = z8000_debug_hit();
+    run_to((max_cycles < 0) ? z8000_scheduler::NEVER : m_total_cycles + max_cycles);
+}
+
+z8002_device::run_result z8002_device::run_until(uint64_t target_cycle)
+{
+    run_result result;
+    const uint64_t start = m_total_cycles;
+
+    if (!m_program_bus || !m_io_bus) {
+        result.reason = stop_reason::no_bus;
+    } else {
+        m_stop_req = false;
+        m_debug_hit = z8000_debug_hit();
+        run_to(target_cycle);
+
+        if (m_debug_hit.kind == z8000_debug_hit::BREAKPOINT)
+            result.reason = stop_reason::breakpoint;
+        else if (m_debug_hit.kind != z8000_debug_hit::NONE)
+            result.reason = stop_reason::watchpoint;
+        else if (m_halt)
+            result.reason = stop_reason::halt;
+        else if (m_stop_req)
+            result.reason = stop_reason::request;
+        else
+            result.reason = stop_reason::budget;
+    }
+
+    result.cycles = m_total_cycles - start;
+    result.overshoot = int64_t(m_total_cycles - target_cycle);
+    return result;
+}
+
+/**************************************************************************
+ * Repeating block instructions
+ *
+ * The repeat forms process one element and rewind the pc, so the run loop
+ * fetches and dispatches the instruction again for the next element.
+ * repeat_next() lets the handler continue with the next element itself
+ * whenever that round trip would change nothing: no interrupt pending, the
+ * cycle budget not used up, no instrumentation and the instruction words
+ * unchanged.  On top of that, block moves and EQ/NE/never compares over
+ * directly mapped pages are done in bulk, a page at a time.  All
+ * elements are charged the instruction's table cycles, as if they had
+ * been re-dispatched.
+ **************************************************************************/
+
+bool z8002_device::repeat_next()
+{
+    if (m_pc != m_ppc)
+        return false;
+    if (!m_inline_repeat || m_irq_req || m_icount <= 0)
+    {
+        /* the run loop fetches the next element: no breakpoint there */
+        m_break_skip = m_breakpoints != 0;
+        return false;
+    }
+
+    /* the last element may have overwritten the instruction itself */
+    if (m_opcache.read_word(m_pc) != m_op[0] || m_opcache.read_word(m_pc + 2) != m_op[1])
+        return false;
+
+    m_pc += 4;
+    cycles(table[z8000_exec[m_op[0]]].cycles);
+    return true;
+}
+
+/* how many elements the bulk paths may process ahead of the one the handler
+   executes next: all but the last remaining element, and only as many as
+   the run loop would still start with the cycle budget left */
+uint32_t z8002_device::repeat_bulk_limit(uint8_t cnt)
+{
+    /* the bulk paths address memory without translation */
+    if (!m_inline_repeat || m_irq_req || m_icount <= 0 || m_segments)
+        return 0;
+
+    const int64_t cyc = table[z8000_exec[m_op[0]]].cycles;
+    const uint32_t left = (RW(cnt) ? RW(cnt) : 0x10000) - 1;
+    return uint32_t(std::min<int64_t>(left, (m_icount + cyc - 1) / cyc));
+}
+
+/**************************************************************************
+ * Idle skipping
+ *
+ * A loop is skipped only where running it out would end the same way:
+ * no interrupt due, budget left, and every pass identical.  A jump to
+ * itself repeats one instruction and a DJNZ on itself only counts down.
+ * For a polling loop, the body between the branch target and the branch
+ * is checked to only read memory and ports into registers and to have
+ * no branches but forward JRs within it; control then stays in the body
+ * until the closing branch falls through or an interrupt is taken, and
+ * a pass that ends with the registers and flags it started with will be
+ * followed by the same pass as long as what it reads stays put.  All but
+ * the pass that used up the budget are skipped, so the run ends inside
+ * the loop just where it would have.
+ **************************************************************************/
+
+/* an interrupt or trap the run loop would take before the next instruction */
+bool z8002_device::interrupt_due() const
+{
+    return (m_irq_req & ~(Z8000_NVI | Z8000_VI))
+        || ((m_irq_req & Z8000_NVI) && (m_fcw & F_NVIE))
+        || ((m_irq_req & Z8000_VI) && (m_fcw & F_VIE));
+}
+
+/* skip up to max more executions of the instruction just executed, which
+   branched to itself, as far as the budget reaches; returns how many */
+uint64_t z8002_device::idle_count(uint64_t max)
+{
+    if (!(m_idle_active & IDLE_SPIN) || m_icount <= 0 || interrupt_due())
+        return 0;
+
+    const int64_t cyc = table[z8000_exec[m_op[0]]].cycles;
+    const uint64_t n = std::min<uint64_t>(max, (m_icount + cyc - 1) / cyc);
+    m_icount -= int64_t(n) * cyc;
+    m_total_cycles += n * cyc;
+    m_idle_cycles += n * cyc;
+    return n;
+}
+
+/* after a JR or JP, taken or not */
+void z8002_device::idle_branch()
+{
+    if (m_pc == m_ppc)
+    {
+        idle_count(UINT64_MAX);
+        return;
+    }
+    if (!(m_idle_active & IDLE_POLL))
+        return;
 
+    idle_loop &l = m_idle_loop;
+    if (m_ppc - m_pc >= IDLE_SPAN)
+    {
+        /* forward, far or not taken; the latter leaves the loop */
+        if (m_ppc == l.branch)
+            l.valid = false;
+        return;
+    }
+
+    const uint16_t fcw = sync_fcw();
+    if (!l.valid || l.head != m_pc || l.branch != m_ppc)
+    {
+        l.valid = true;
+        l.head = m_pc;
+        l.branch = m_ppc;
+        l.pure = idle_body_pure(m_pc, m_ppc);
+    }
+    else if (l.pure && fcw == l.fcw && !memcmp(m_regs.W, l.regs, sizeof l.regs)
+             && m_icount > 0 && !interrupt_due())
+    {
+        const uint64_t pass = m_total_cycles - l.cycle;
+        const uint64_t n = uint64_t(m_icount - 1) / pass;
+        m_icount -= int64_t(n * pass);
+        m_total_cycles += n * pass;
+        m_idle_cycles += n * pass;
+    }
+    l.cycle = m_total_cycles;
+    l.fcw = fcw;
+    memcpy(l.regs, m_regs.W, sizeof l.regs);
+}
+
+/* the instructions from head up to the branch only read and set registers */
+bool z8002_device::idle_body_pure(uint32_t head, uint32_t branch)
+{
+    const bool seg = m_z8001 && (m_fcw & F_SEG);
+    for (uint32_t pc = head; pc != branch; )
+    {
+        /* an instruction straddling the branch means the walk is off */
+        if (branch - pc >= IDLE_SPAN)
+            return false;
+
+        const uint16_t op = m_opcache.read_word(pc);
+        const unsigned index = z8000_exec[op];
+        uint32_t words = table[index].size;
+        switch (m_idle_kind[index])
+        {
+        case IDLE_READ:
+            break;
+
+        case IDLE_READ_ADDR:
+            /* a long segmented address takes another word */
+            if (seg && (m_opcache.read_word(addr_add(pc, 2)) & 0x8000))
+                words++;
+            break;
+
+        case IDLE_JR: {
+            const uint32_t target = addr_add(pc, 2 + 2 * int8_t(op & 0xff));
+            if (target - pc - 1 >= branch - pc)
+                return false;
+            break;
+        }
+
+        default:
+            return false;
+        }
+        pc = addr_add(pc, 2 * words);
+    }
+    return true;
+}
+
+/* the word registers holding an address register, as a bit mask */
+template<bool Z8001>
+uint16_t z8002_device::addr_reg_mask(uint8_t reg) const
+{
+    return segmented<Z8001>() ? 3 << (reg & ~1) : 1 << reg;
+}
+
+namespace {
+
+/* elements of |step| bytes from addr, walking by step, inside its page */
+uint32_t page_elements(uint32_t addr, int step)
+{
+    const uint32_t offset = addr & (Z8000_PAGE_SIZE - 1);
+    return step > 0 ? (Z8000_PAGE_SIZE - offset) / step : offset / -step + 1;
+}
+
+uint16_t element_at(const uint8_t *p, int size)
+{
+    return size == 1 ? p[0] : (p[0] << 8) | p[1];
+}
+
+} // anonymous namespace
+
+template<bool Z8001>
+void z8002_device::repeat_move(uint8_t dst, uint8_t src, uint8_t cnt, int step)
+{
+    /* each element must update the registers independently */
+    const uint16_t srcregs = addr_reg_mask<Z8001>(src), dstregs = addr_reg_mask<Z8001>(dst), cntreg = 1 << cnt;
+    if ((srcregs & dstregs) || ((srcregs | dstregs) & cntreg))
+        return;
+
+    uint32_t n = repeat_bulk_limit(cnt);
+    if (!n)
+        return;
+
+    mem_specific &srcspace = src == SP ? m_stack : m_data;
+    mem_specific &dstspace = dst == SP ? m_stack : m_data;
+    const uint32_t srcaddr = adjust_addr_for_nonseg_mode<Z8001>(addr_from_reg<Z8001>(src));
+    const uint32_t dstaddr = adjust_addr_for_nonseg_mode<Z8001>(addr_from_reg<Z8001>(dst));
+    const uint8_t *s = srcspace.read_page(srcaddr);
+    uint8_t *d = dstspace.write_page(dstaddr);
+    const int size = std::abs(step);
+    if (!s || !d || ((srcaddr | dstaddr) & (size - 1)))
+        return;
+
+    n = std::min({n, page_elements(srcaddr, step), page_elements(dstaddr, step)});
+    s += srcaddr & (Z8000_PAGE_SIZE - 1);
+    d += dstaddr & (Z8000_PAGE_SIZE - 1);
+
+    /* lowest source/destination bytes touched, in address order */
+    const uint32_t bytes = n * size;
+    const uint8_t *s_lo = step > 0 ? s : s - bytes + size;
+    uint8_t *d_lo = step > 0 ? d : d - bytes + size;
+
+    /* stores over the instruction are left to the per-element path */
+    if (overlaps_insn(d_lo, bytes))
+        return;
+
+    note_code_write(dstspace, dstaddr);
+
+    /* an element reading what an earlier one wrote replicates a pattern,
+       which memmove would not */
+    const bool replicate = step > 0 ? (d > s && d < s + bytes) : (s > d && s < d + bytes);
+    if (!replicate)
+        memmove(d_lo, s_lo, bytes);
+    else if (step > 0)
+        for (uint32_t i = 0; i < bytes; i++)
+            d[i] = s[i];
+    else
+        for (uint32_t i = 0; i < bytes; i += size)
+            for (int b = 0; b < size; b++)
+                d[b - int(i)] = s[b - int(i)];
+
+    add_to_addr_reg<Z8001>(src, step * int(n));
+    add_to_addr_reg<Z8001>(dst, step * int(n));
+    RW(cnt) -= n;
+    cycles(int(n) * table[z8000_exec[m_op[0]]].cycles);
+}
+
+/* whether host bytes [lo, lo + bytes) hold part of the instruction being
+   executed, or it is not in directly mapped memory at all */
+bool z8002_device::overlaps_insn(const uint8_t *lo, uint32_t bytes) const
+{
+    for (uint32_t pc = m_ppc; pc != m_ppc + 4; pc += 2)
+    {
+        const uint8_t *insn = m_program.read_page(pc);
+        if (!insn)
+            return true;
+        insn += pc & (Z8000_PAGE_SIZE - 2);
+        if (insn + 2 > lo && insn < lo + bytes)
+            return true;
+    }
+    return false;
+}
+
+/* repeating I/O: the elements that fit the memory page in one bus call */
+template<bool Z8001>
+void z8002_device::repeat_io(uint8_t mem, uint8_t port, uint8_t cnt, int step, int mode, bool input)
+{
+    const uint16_t memregs = addr_reg_mask<Z8001>(mem), portreg = 1 << port, cntreg = 1 << cnt;
+    if ((memregs & (portreg | cntreg)) || (portreg & cntreg))
+        return;
+
+    uint32_t n = repeat_bulk_limit(cnt);
+    if (!n)
+        return;
+
+    mem_specific &space = mem == SP ? m_stack : m_data;
+    const uint32_t addr = adjust_addr_for_nonseg_mode<Z8001>(addr_from_reg<Z8001>(mem));
+    const int size = std::abs(step);
+    const uint8_t *page = input ? space.write_page(addr) : space.read_page(addr);
+    if (!page || (addr & (size - 1)))
+        return;
+
+    n = std::min(n, page_elements(addr, step));
+    const uint32_t offset = addr & (Z8000_PAGE_SIZE - 1);
+    uint16_t values[Z8000_PAGE_SIZE];
+
+    if (input)
+    {
+        uint8_t *p = space.write_page(addr) + offset;
+        const uint32_t bytes = n * size;
+        if (overlaps_insn(step > 0 ? p : p - bytes + size, bytes))
+            return;
+        if (!m_io_bus->read_block(RW(port), mode, values, n, size == 2))
+            return;
+
+        note_code_write(space, addr);
+        for (uint32_t i = 0; i < n; i++, p += step)
+        {
+            if (size == 1)
+                p[0] = values[i];
+            else
+            {
+                p[0] = values[i] >> 8;
+                p[1] = values[i];
+            }
+        }
+    }
+    else
+    {
+        const uint8_t *p = page + offset;
+        for (uint32_t i = 0; i < n; i++, p += step)
+            values[i] = element_at(p, size);
+        if (!m_io_bus->write_block(RW(port), mode, values, n, size == 2))
+            return;
+    }
+
+    add_to_addr_reg<Z8001>(mem, step * int(n));
+    RW(cnt) -= n;
+    cycles(int(n) * table[z8000_exec[m_op[0]]].cycles);
+}
+
+template<bool Z8001>
+void z8002_device::repeat_compare(uint8_t dst, bool mem_dst, uint8_t src, uint8_t cnt, int step, uint8_t cc)
+{
+    /* only conditions decided by (in)equality alone: never, EQ, NE */
+    if (cc != 0 && cc != 6 && cc != 14)
+        return;
+
+    /* the pointers, the count and a compared register must not overlap */
+    const int size = std::abs(step);
+    const uint16_t srcregs = addr_reg_mask<Z8001>(src), cntreg = 1 << cnt;
+    const uint16_t dstregs = mem_dst ? addr_reg_mask<Z8001>(dst) : 1 << (size == 1 ? dst & 7 : dst);
+    if ((srcregs & dstregs) || ((srcregs | dstregs) & cntreg))
+        return;
+
+    uint32_t n = repeat_bulk_limit(cnt);
+    if (!n)
+        return;
+
+    const uint32_t srcaddr = adjust_addr_for_nonseg_mode<Z8001>(addr_from_reg<Z8001>(src));
+    const uint8_t *s = (src == SP ? m_stack : m_data).read_page(srcaddr);
+    if (!s || (srcaddr & (size - 1)))
+        return;
+    n = std::min(n, page_elements(srcaddr, step));
+    s += srcaddr & (Z8000_PAGE_SIZE - 1);
+
+    const uint8_t *d = nullptr;
+    uint16_t value = 0;
+    if (mem_dst)
+    {
+        const uint32_t dstaddr = adjust_addr_for_nonseg_mode<Z8001>(addr_from_reg<Z8001>(dst));
+        d = (dst == SP ? m_stack : m_data).read_page(dstaddr);
+        if (!d || (dstaddr & (size - 1)))
+            return;
+        n = std::min(n, page_elements(dstaddr, step));
+        d += dstaddr & (Z8000_PAGE_SIZE - 1);
+    }
+    else
+    {
+        value = size == 1 ? RB(dst) : RW(dst);
+    }
+
+    /* skip the elements that do not end the repeat; the handler then
+       executes the next one, which sets the flags */
+    uint32_t i = 0;
+    if (cc == 0)
+        i = n;
+    else if (!mem_dst && step == 1 && cc == 6)
+    {
+        const void *hit = memchr(s, value, n);
+        i = hit ? static_cast<const uint8_t *>(hit) - s : n;
+    }
+    else
+    {
+        const bool stop_on_equal = cc == 6;
+        for (; i < n; i++)
+        {
+            const int offset = step * int(i);
+            const uint16_t other = mem_dst ? element_at(d + offset, size) : value;
+            if ((element_at(s + offset, size) == other) == stop_on_equal)
+                break;
+        }
+    }
+    if (!i)
+        return;
+
+    add_to_addr_reg<Z8001>(src, step * int(i));
+    if (mem_dst)
+        add_to_addr_reg<Z8001>(dst, step * int(i));
+    RW(cnt) -= i;
+    cycles(int(i) * table[z8000_exec[m_op[0]]].cycles);
+}
+
+/**************************************************************************
+ * Pre-decoded basic-block cache
+ *
+ * A block is a straight-line run of instructions inside one code page.
+ * It is recorded the first time its start address is executed: the
+ * instructions run through the normal interpreter while the operand
+ * fetches are captured.  Later visits replay the recorded opcode words
+ * and handlers without touching the bus for instruction fetches.
+ *
+ * Replay performs the same per-instruction steps as the interpreter loop
+ * (cycle accounting before the handler, m_ppc/m_op setup), and leaves the
+ * block as soon as control flow, the FCW mode bits, a pending interrupt
+ * or the cycle budget diverge from straight-line execution.
+ **************************************************************************/
+
+namespace {
+
+// Forwards operand fetches and remembers where the instruction ended
+class fetch_recorder : public z8000_memory_bus {
+public:
+    fetch_recorder(z8000_memory_bus* bus, uint32_t end) : m_bus(bus), m_end(end) {}
+
+    uint32_t end() const { return m_end; }
+
+    uint8_t read_byte(uint32_t addr) override { return m_bus->read_byte(addr); }
+    uint16_t read_word(uint32_t addr) override {
+        if (addr + 2 > m_end)
+            m_end = addr + 2;
+        return m_bus->read_word(addr);
+    }
+    void write_byte(uint32_t addr, uint8_t val) override { m_bus->write_byte(addr, val); }
+    void write_word(uint32_t addr, uint16_t val) override { m_bus->write_word(addr, val); }
+    void write_word(uint32_t addr, uint16_t val, uint16_t mask) override { m_bus->write_word(addr, val, mask); }
+
+private:
+    z8000_memory_bus* m_bus;
+    uint32_t m_end;
+};
+
+} // anonymous namespace
+
+void z8002_device::set_block_cache(bool enable)
+{
+    m_block_cache = enable;
+    if (enable)
+    {
+        m_block_arena.resize(BLOCK_ARENA);
+        m_blocks.resize(BLOCK_SLOTS);
+        m_code_pages.assign(m_page_mask + 1, 0);
+        m_code_gen.assign(m_page_mask + 1, 0);
+        invalidate_block_cache();
+    }
+    else
+    {
+        m_block_arena.clear();
+        m_blocks.clear();
+        m_code_pages.clear();
+        m_code_gen.clear();
+    }
+    update_code_spaces();
+}
+
+void z8002_device::invalidate_block_cache()
+{
+    invalidate_vectors();
+    for (block_entry &b : m_blocks)
+        b.count = 0;
+    std::fill(m_code_pages.begin(), m_code_pages.end(), 0);
+    m_block_arena_used = 0;
+}
+
+void z8002_device::invalidate_code(uint32_t addr, uint32_t len)
+{
+    if (!len)
+        return;
+    if ((addr >> Z8000_PAGE_SHIFT) < m_psa_page + PSA_PAGES
+        && ((addr + len - 1) >> Z8000_PAGE_SHIFT) >= m_psa_page)
+        invalidate_vectors();
+    if (!m_block_cache)
+        return;
+    const uint32_t last = (addr + len - 1) >> BLOCK_PAGE_SHIFT;
+    for (uint32_t page = addr >> BLOCK_PAGE_SHIFT; page <= last; page++)
+        if (m_code_pages[page & m_page_mask])
+            invalidate_code_page(page & m_page_mask);
+}
+
+void z8002_device::update_code_spaces()
+{
+    uint8_t* pages = m_block_cache ? m_code_pages.data() : nullptr;
+    m_program.code_pages = pages;
+    m_data.code_pages = (m_data_bus == m_program_bus) ? pages : nullptr;
+    m_stack.code_pages = (m_stack_bus == m_program_bus) ? pages : nullptr;
+    m_program.psa = true;
+    m_data.psa = m_data_bus == m_program_bus;
+    m_stack.psa = m_stack_bus == m_program_bus;
+    invalidate_vectors();
+}
+
+void z8002_device::invalidate_code_page(uint32_t page)
+{
+    m_code_pages[page] = 0;
+    m_code_gen[page]++;
+}
+
+template<bool Z8001>
+void z8002_device::record_block()
+{
+    const uint32_t start_pc = m_pc;
+    const uint32_t page = (start_pc >> BLOCK_PAGE_SHIFT) & m_page_mask;
+    const uint16_t mode = m_fcw & BLOCK_MODE_MASK;
+
+    if (m_block_arena_used + BLOCK_MAX_INSNS > BLOCK_ARENA)
+        invalidate_block_cache();
+
+    /* flag the page first so stores made while recording are noticed */
+    m_code_pages[page] = 1;
+    const uint32_t gen = m_code_gen[page];
+    block_insn *insns = &m_block_arena[m_block_arena_used];
+    int count = 0;
+
+    for (;;)
+    {
+        const uint32_t pc = m_pc;
+        m_ppc = pc;
+
+        m_op[0] = RDOP();
+        m_op_valid = 1;
+
+        const Z8000_init &exec = table[z8000_exec[m_op[0]]];
+
+        m_icount -= exec.cycles;
+        m_total_cycles += exec.cycles;
+
+        /* operand fetches must go through the recorder, not the page map */
+        fetch_recorder rec(m_cache.bus, pc + 2);
+        m_cache.bus = &rec;
+        m_cache.map = nullptr;
+        (this->*exec.opcode[Z8001])();
+        update_fetch_path();
+
+        const uint32_t next_pc = rec.end();
+
+        /* instructions straddling the page end stay with the interpreter */
+        if (((next_pc - 1) >> BLOCK_PAGE_SHIFT) != (start_pc >> BLOCK_PAGE_SHIFT))
+        {
+            m_op_valid = 0;
+            break;
+        }
+
+        block_insn &insn = insns[count++];
+        insn.opcode = exec.opcode[Z8001];
+        insn.op[0] = m_op[0];
+        insn.op[1] = m_op[1];
+        insn.op[2] = m_op[2];
+        insn.op[3] = m_op[3];
+        insn.next_pc = next_pc;
+        insn.cycles = exec.cycles;
+        insn.op_valid = m_op_valid;
+        insn.uop = UOP_CALL;
+        m_op_valid = 0;
+
+        /* only the start page's generation guards the block, so stop at its end */
+        if (count == BLOCK_MAX_INSNS || m_pc != next_pc || m_irq_req || m_halt
+            || (next_pc >> BLOCK_PAGE_SHIFT) != (start_pc >> BLOCK_PAGE_SHIFT)
+            || m_icount <= 0 || (m_fcw & BLOCK_MODE_MASK) != mode
+            || m_code_gen[page] != gen)
+            break;
+    }
+
+    /* drop the block if it modified its own page while being recorded */
+    if (count == 0 || m_code_gen[page] != gen)
+        return;
+
+    block_entry &b = m_blocks[(start_pc >> 1) & (BLOCK_SLOTS - 1)];
+    b.pc = start_pc;
+    b.start = m_block_arena_used;
+    b.gen = gen;
+    b.page = page;
+    b.mode = mode;
+    b.count = count;
+    b.hits = 0;
+    m_block_arena_used += count;
+}
+
+/* decode the operands of the instructions with a micro-op; their handlers
+   charge no cycles beyond the table's, which the run loop does */
+void z8002_device::translate_block(uint32_t start, uint16_t count)
+{
+    for (block_insn *insn = &m_block_arena[start]; count--; insn++)
+    {
+        const uint16_t op = insn->op[0];
+        const unsigned n1 = (op >> 8) & 15, n2 = (op >> 4) & 15, n3 = op & 15;
+        auto word = [](unsigned n) { return uint8_t(BYTE4_XOR_BE(n)); };
+        auto byte = [](unsigned n) { return uint8_t(BYTE8_XOR_BE(((n & 7) << 1) | ((n & 8) >> 3))); };
+        auto alu = [&](uint8_t reg_uop) {
+            insn->uop = reg_uop;
+            insn->dst = word(n3);
+            insn->src = word(n2);
+        };
+        auto alu_imm = [&](uint8_t imm_uop) {
+            insn->uop = imm_uop;
+            insn->dst = word(n3);
+            insn->imm = insn->op[1];
+        };
+
+        switch (op >> 8)
+        {
+        case 0xa1: alu(UOP_LD_R); break;
+        case 0x81: alu(UOP_ADD_R); break;
+        case 0x83: alu(UOP_SUB_R); break;
+        case 0x8b: alu(UOP_CP_R); break;
+        case 0x87: alu(UOP_AND_R); break;
+        case 0x85: alu(UOP_OR_R); break;
+        case 0x89: alu(UOP_XOR_R); break;
+        case 0x21: if (!n2) alu_imm(UOP_LD_I); break;
+        case 0x01: if (!n2) alu_imm(UOP_ADD_I); break;
+        case 0x03: if (!n2) alu_imm(UOP_SUB_I); break;
+        case 0x0b: if (!n2) alu_imm(UOP_CP_I); break;
+        case 0x07: if (!n2) alu_imm(UOP_AND_I); break;
+        case 0x05: if (!n2) alu_imm(UOP_OR_I); break;
+        case 0x09: if (!n2) alu_imm(UOP_XOR_I); break;
+        case 0xa9: case 0xab:       /* inc/dec rd,#n */
+            insn->uop = (op >> 8) == 0xa9 ? UOP_INC : UOP_DEC;
+            insn->dst = word(n2);
+            insn->imm = n3 + 1;
+            break;
+        case 0xbd:                  /* ldk rd,#n */
+            insn->uop = UOP_LD_I;
+            insn->dst = word(n2);
+            insn->imm = n3;
+            break;
+        case 0x8d:                  /* clr rd */
+            if (n3 == 8)
+            {
+                insn->uop = UOP_LD_I;
+                insn->dst = word(n2);
+                insn->imm = 0;
+            }
+            break;
+        case 0xa0:                  /* ldb rbd,rbs */
+            insn->uop = UOP_LDB_R;
+            insn->dst = byte(n3);
+            insn->src = byte(n2);
+            break;
+        default:
+            if ((op >> 12) == 0xc)              /* ldb rbd,#imm8 */
+            {
+                insn->uop = UOP_LDB_I;
+                insn->dst = byte(n1);
+                insn->imm = op & 0xff;
+            }
+            else if ((op >> 12) == 0xe)         /* jr cc,dsp8 */
+            {
+                insn->uop = UOP_JR;
+                insn->src = n1;
+                insn->imm = uint16_t(int8_t(op & 0xff) * 2);
+            }
+            else if ((op & 0xf080) == 0xf080)   /* djnz rd,dsp7 */
+            {
+                insn->uop = UOP_DJNZ;
+                insn->dst = word(n1);
+                insn->imm = 2 * (op & 0x7f);
+            }
+            break;
+        }
+    }
+}
+
+/* condition code cc of JR, JP, CALL, RET, ... */
+inline bool z8002_device::condition(unsigned cc)
+{
+    switch (cc)
+    {
+        case  0: return CC0;
+        case  1: return CC1;
+        case  2: return CC2;
+        case  3: return CC3;
+        case  4: return CC4;
+        case  5: return CC5;
+        case  6: return CC6;
+        case  7: return CC7;
+        case  8: return CC8;
+        case  9: return CC9;
+        case 10: return CCA;
+        case 11: return CCB;
+        case 12: return CCC;
+        case 13: return CCD;
+        case 14: return CCE;
+        default: return CCF;
+    }
+}
+
+template<bool Z8001>
+void z8002_device::run_blocks()
+{
     do
     {
         /* any interrupt request pending? */
         if (m_irq_req)
-            Interrupt();
+            Interrupt<Z8001>();
 
         m_ppc = m_pc;
 
         if (m_halt)
         {
             m_icount = 0;
+            break;
         }
-        else
+
+        block_entry &b = m_blocks[(m_pc >> 1) & (BLOCK_SLOTS - 1)];
+        if (!b.count || b.pc != m_pc || b.mode != (m_fcw & BLOCK_MODE_MASK)
+            || b.gen != m_code_gen[b.page])
         {
-            m_op[0] = RDOP();
-            m_op_valid = 1;
+            record_block<Z8001>();
+            continue;
+        }
 
-            if (m_trace)
-                trace_instruction();
+        const uint32_t &gen = m_code_gen[b.page];
+        const uint32_t block_gen = b.gen;
+        const uint16_t mode = b.mode;
+        const block_insn *insn = &m_block_arena[b.start];
+        const block_insn *end = insn + b.count;
 
-            const Z8000_init &exec = table[z8000_exec[m_op[0]]];
+        if (b.hits < m_block_hot && ++b.hits == m_block_hot)
+            translate_block(b.start, b.count);
 
-            m_icount -= exec.cycles;
-            m_total_cycles += exec.cycles;
-            (this->*exec.opcode)();
+        /* translated: micro-ops run inline and only a handler call, which
+           may raise an interrupt, halt, change mode or store into the
+           block's page, needs the full set of checks after it */
+        if (b.hits >= m_block_hot && m_block_hot)
+        {
+            const block_insn *first = insn;
+            for (;;)
+            {
+                m_ppc = m_pc;
+                m_pc = insn->next_pc;
+                m_icount -= insn->cycles;
+                m_total_cycles += insn->cycles;
+
+                uint16_t *const w = m_regs.W;
+                uint8_t *const b8 = m_regs.B;
+                switch (insn->uop)
+                {
+                    case UOP_LD_R:  w[insn->dst] = w[insn->src]; break;
+                    case UOP_LD_I:  w[insn->dst] = insn->imm; break;
+                    case UOP_LDB_R: b8[insn->dst] = b8[insn->src]; break;
+                    case UOP_LDB_I: b8[insn->dst] = insn->imm; break;
+                    case UOP_ADD_R: w[insn->dst] = ADDW(w[insn->dst], w[insn->src]); break;
+                    case UOP_ADD_I: w[insn->dst] = ADDW(w[insn->dst], insn->imm); break;
+                    case UOP_SUB_R: w[insn->dst] = SUBW(w[insn->dst], w[insn->src]); break;
+                    case UOP_SUB_I: w[insn->dst] = SUBW(w[insn->dst], insn->imm); break;
+                    case UOP_CP_R:  CPW(w[insn->dst], w[insn->src]); break;
+                    case UOP_CP_I:  CPW(w[insn->dst], insn->imm); break;
+                    case UOP_AND_R: w[insn->dst] = ANDW(w[insn->dst], w[insn->src]); break;
+                    case UOP_AND_I: w[insn->dst] = ANDW(w[insn->dst], insn->imm); break;
+                    case UOP_OR_R:  w[insn->dst] = ORW(w[insn->dst], w[insn->src]); break;
+                    case UOP_OR_I:  w[insn->dst] = ORW(w[insn->dst], insn->imm); break;
+                    case UOP_XOR_R: w[insn->dst] = XORW(w[insn->dst], w[insn->src]); break;
+                    case UOP_XOR_I: w[insn->dst] = XORW(w[insn->dst], insn->imm); break;
+                    case UOP_INC:   w[insn->dst] = INCW(w[insn->dst], insn->imm); break;
+                    case UOP_DEC:   w[insn->dst] = DECW(w[insn->dst], insn->imm); break;
+                    case UOP_JR:
+                        if (condition(insn->src))
+                            set_pc<Z8001>(addr_add(m_pc, int16_t(insn->imm)));
+                        if (m_idle_active)
+                        {
+                            /* idle_count() charges m_op[0]'s cycles */
+                            m_op[0] = insn->op[0];
+                            idle_branch();
+                        }
+                        break;
+                    case UOP_DJNZ:
+                        if (--w[insn->dst])
+                        {
+                            set_pc<Z8001>(addr_sub(m_pc, insn->imm));
+                            if (m_idle_active && m_pc == m_ppc)
+                            {
+                                m_op[0] = insn->op[0];
+                                w[insn->dst] -= idle_count(w[insn->dst] - 1);
+                            }
+                        }
+                        break;
+                    default:
+                        m_op[0] = insn->op[0];
+                        m_op[1] = insn->op[1];
+                        m_op[2] = insn->op[2];
+                        m_op[3] = insn->op[3];
+                        m_op_valid = insn->op_valid;
+                        (this->*insn->opcode)();
+                        m_op_valid = 0;
+                        if (m_irq_req || m_halt || (m_fcw & BLOCK_MODE_MASK) != mode || gen != block_gen)
+                            goto leave;
+                        break;
+                }
+
+                const block_insn *done = insn++;
+                if (m_icount <= 0)
+                    break;
+                if (m_pc != done->next_pc)
+                {
+                    /* a branch back to the start runs the block again */
+                    if (m_pc != b.pc || m_irq_req)
+                        break;
+                    insn = first;
+                }
+                else if (insn == end)
+                    break;
+            }
+        leave:
+            continue;
+        }
+
+        for (;;)
+        {
+            m_ppc = m_pc;
+            m_op[0] = insn->op[0];
+            m_op[1] = insn->op[1];
+            m_op[2] = insn->op[2];
+            m_op[3] = insn->op[3];
+            m_op_valid = insn->op_valid;
+            m_pc = insn->next_pc;
+
+            m_icount -= insn->cycles;
+            m_total_cycles += insn->cycles;
+            (this->*insn->opcode)();
             m_op_valid = 0;
 
-            if (m_reg_trace) {
-                dump_regs();
-            }
+            if (++insn == end || m_pc != insn[-1].next_pc || m_irq_req || m_halt
+                || m_icount <= 0 || (m_fcw & BLOCK_MODE_MASK) != mode
+                || gen != block_gen)
+                break;
         }
     } while (m_icount > 0 && !m_halt);
 }
 
 void z8002_device::dump_regs() const
 {
+    const uint16_t fcw = get_fcw();
     printf("\n=== Z8002 Registers ===\n");
     printf("PC=%04X  FCW=%04X  PSAP=%04X  NSP=%04X\n",
-           m_pc & 0xFFFF, m_fcw, m_psapoff, m_nspoff);
+           m_pc & 0xFFFF, fcw, m_psapoff, m_nspoff);
     printf("Flags: %c%c%c%c%c%c\n",
-           (m_fcw & F_C) ? 'C' : '-',
-           (m_fcw & F_Z) ? 'Z' : '-',
-           (m_fcw & F_S) ? 'S' : '-',
-           (m_fcw & F_PV) ? 'V' : '-',
-           (m_fcw & F_DA) ? 'D' : '-',
-           (m_fcw & F_H) ? 'H' : '-');
+           (fcw & F_C) ? 'C' : '-',
+           (fcw & F_Z) ? 'Z' : '-',
+           (fcw & F_S) ? 'S' : '-',
+           (fcw & F_PV) ? 'V' : '-',
+           (fcw & F_DA) ? 'D' : '-',
+           (fcw & F_H) ? 'H' : '-');
     printf("\n");
     for (int i = 0; i < 16; i += 4) {
         printf("R%-2d=%04X  R%-2d=%04X  R%-2d=%04X  R%-2d=%04X\n",
@@ -657,21 +2244,31 @@ void z8002_device::dump_regs() const
     }
 }
 
+void z8001_device::set_mmu(bool enable)
+{
+    m_segments = enable ? m_segment_table.data() : nullptr;
+    update_fetch_path();
+
+    /* blocks were recorded under the other mapping */
+    invalidate_block_cache();
+}
+
 void z8001_device::dump_regs() const
 {
+    const uint16_t fcw = get_fcw();
     printf("\n=== Z8001 Registers ===\n");
     printf("PC=<<%02X>>%04X  FCW=%04X  PSAP=<<%02X>>%04X  NSP=<<%02X>>%04X\n",
-           (m_pc >> 16) & 0x7F, m_pc & 0xFFFF, m_fcw,
+           (m_pc >> 16) & 0x7F, m_pc & 0xFFFF, fcw,
            m_psapseg & 0x7F, m_psapoff,
            m_nspseg & 0x7F, m_nspoff);
     printf("Flags: %c%c%c%c%c%c%c\n",
-           (m_fcw & F_SEG) ? 'G' : '-',
-           (m_fcw & F_C) ? 'C' : '-',
-           (m_fcw & F_Z) ? 'Z' : '-',
-           (m_fcw & F_S) ? 'S' : '-',
-           (m_fcw & F_PV) ? 'V' : '-',
-           (m_fcw & F_DA) ? 'D' : '-',
-           (m_fcw & F_H) ? 'H' : '-');
+           (fcw & F_SEG) ? 'G' : '-',
+           (fcw & F_C) ? 'C' : '-',
+           (fcw & F_Z) ? 'Z' : '-',
+           (fcw & F_S) ? 'S' : '-',
+           (fcw & F_PV) ? 'V' : '-',
+           (fcw & F_DA) ? 'D' : '-',
+           (fcw & F_H) ? 'H' : '-');
     printf("\n");
     for (int i = 0; i < 16; i += 4) {
         printf("R%-2d=%04X  R%-2d=%04X  R%-2d=%04X  R%-2d=%04X\n",
@@ -0,0 +1,223 @@
+// Z8000 breakpoints and watchpoints: setup and the watching buses
+
+#include <algorithm>
+
+#include <z8000/z8000.h>
+
+int z8002_device::add_breakpoint(uint32_t pc)
+{
+    return add_debug_point(z8000_debug_hit::BREAKPOINT, 0, 0, pc, pc);
+}
+
+int z8002_device::add_watchpoint(uint32_t first, uint32_t last, unsigned access)
+{
+    return add_debug_point(z8000_debug_hit::MEMORY, access, 0, first, last);
+}
+
+int z8002_device::add_io_watchpoint(int space, uint16_t first, uint16_t last, unsigned access)
+{
+    return add_debug_point(z8000_debug_hit::IO, access, space & 1, first, last);
+}
+
+int z8002_device::add_debug_point(uint8_t kind, uint8_t access, uint8_t space, uint32_t first, uint32_t last)
+{
+    debug_point p;
+    p.id = m_debug_next_id++;
+    p.kind = kind;
+    p.access = access & (z8000_debug_hit::READ | z8000_debug_hit::WRITE);
+    p.space = space;
+    p.first = std::min(first, last);
+    p.last = std::max(first, last);
+    m_debug_points.push_back(p);
+    update_debug_points();
+    return p.id;
+}
+
+bool z8002_device::remove_breakpoint(int id)
+{
+    auto it = std::find_if(m_debug_points.begin(), m_debug_points.end(),
+                           [id](const debug_point &p) { return p.id == id; });
+    if (it == m_debug_points.end())
+        return false;
+    m_debug_points.erase(it);
+    update_debug_points();
+    return true;
+}
+
+void z8002_device::clear_breakpoints()
+{
+    m_debug_points.clear();
+    update_debug_points();
+}
+
+/* rebuild the page bitmaps and reroute the buses for the points now set */
+void z8002_device::update_debug_points()
+{
+    m_breakpoints = m_mem_watches = m_io_watches = 0;
+    m_break_pages.assign(m_page_mask + 1, 0);
+    m_watch_pages.assign(m_page_mask + 1, 0);
+    m_io_watch_pages.fill(0);
+
+    for (const debug_point &p : m_debug_points)
+    {
+        switch (p.kind)
+        {
+        case z8000_debug_hit::BREAKPOINT:
+            m_breakpoints++;
+            m_break_pages[(p.first >> BLOCK_PAGE_SHIFT) & m_page_mask] = 1;
+            break;
+
+        case z8000_debug_hit::MEMORY:
+            m_mem_watches++;
+            /* addresses past the page table alias onto it, like the bus's */
+            if (((p.last - p.first) >> BLOCK_PAGE_SHIFT) >= m_page_mask)
+                std::fill(m_watch_pages.begin(), m_watch_pages.end(), 1);
+            else
+                for (uint32_t page = p.first >> BLOCK_PAGE_SHIFT; page <= p.last >> BLOCK_PAGE_SHIFT; page++)
+                    m_watch_pages[page & m_page_mask] = 1;
+            break;
+
+        case z8000_debug_hit::IO:
+            m_io_watches++;
+            for (uint32_t page = p.first >> 8; page <= p.last >> 8; page++)
+                m_io_watch_pages[(p.space << 8) | page] = 1;
+            break;
+        }
+    }
+
+    if (!m_breakpoints)
+        m_break_pages.clear();
+    if (!m_mem_watches)
+        m_watch_pages.clear();
+    update_memory_paths();
+}
+
+/* first pc/address match of the point; a run stops after the instruction
+   that made the access */
+void z8002_device::debug_hit(const debug_point &p, uint32_t addr, uint8_t access, uint16_t value)
+{
+    if (m_debug_hit.kind == z8000_debug_hit::NONE)
+    {
+        m_debug_hit.kind = p.kind;
+        m_debug_hit.access = access;
+        m_debug_hit.space = p.space;
+        m_debug_hit.id = p.id;
+        m_debug_hit.pc = m_ppc;
+        m_debug_hit.addr = addr;
+        m_debug_hit.value = value;
+    }
+    request_stop();
+}
+
+void z8002_device::watch_memory(uint32_t first, uint32_t last, uint8_t access, uint16_t value)
+{
+    if (!m_watch_pages[(first >> BLOCK_PAGE_SHIFT) & m_page_mask])
+        return;
+
+    for (const debug_point &p : m_debug_points)
+    {
+        if (p.kind == z8000_debug_hit::MEMORY && (p.access & access) && first <= p.last && last >= p.first)
+        {
+            debug_hit(p, first, access, value);
+            return;
+        }
+    }
+}
+
+void z8002_device::watch_io(uint16_t port, int mode, bool word, uint8_t access, uint16_t value)
+{
+    const uint8_t space = mode & 1;
+    if (!m_io_watch_pages[(space << 8) | (port >> 8)])
+        return;
+
+    const uint32_t last = word ? port | 1 : port;
+    for (const debug_point &p : m_debug_points)
+    {
+        if (p.kind == z8000_debug_hit::IO && p.space == space && (p.access & access)
+            && port <= p.last && last >= p.first)
+        {
+            debug_hit(p, port, access, value);
+            return;
+        }
+    }
+}
+
+uint8_t z8002_device::watch_bus::read_byte(uint32_t addr)
+{
+    const uint8_t value = attached.read_byte(addr);
+    cpu->watch_memory(addr, addr, z8000_debug_hit::READ, value);
+    return value;
+}
+
+uint16_t z8002_device::watch_bus::read_word(uint32_t addr)
+{
+    const uint16_t value = attached.read_word(addr);
+    cpu->watch_memory(addr, addr | 1, z8000_debug_hit::READ, value);
+    return value;
+}
+
+void z8002_device::watch_bus::write_byte(uint32_t addr, uint8_t val)
+{
+    attached.write_byte(addr, val);
+    cpu->watch_memory(addr, addr, z8000_debug_hit::WRITE, val);
+}
+
+void z8002_device::watch_bus::write_word(uint32_t addr, uint16_t val)
+{
+    attached.write_word(addr, val);
+    cpu->watch_memory(addr, addr | 1, z8000_debug_hit::WRITE, val);
+}
+
+/* byte stores come here as one half of a word */
+void z8002_device::watch_bus::write_word(uint32_t addr, uint16_t val, uint16_t mask)
+{
+    attached.write_word(addr, val, mask);
+    if (mask == 0xff00)
+        cpu->watch_memory(addr, addr, z8000_debug_hit::WRITE, val >> 8);
+    else if (mask == 0x00ff)
+        cpu->watch_memory(addr | 1, addr | 1, z8000_debug_hit::WRITE, val & 0xff);
+    else
+        cpu->watch_memory(addr, addr | 1, z8000_debug_hit::WRITE, val & mask);
+}
+
+uint8_t z8002_device::io_watch_bus::read_byte(uint16_t addr, int mode)
+{
+    const uint8_t value = attached->read_byte(addr, mode);
+    cpu->watch_io(addr, mode, false, z8000_debug_hit::READ, value);
+    return value;
+}
+
+uint16_t z8002_device::io_watch_bus::read_word(uint16_t addr, int mode)
+{
+    const uint16_t value = attached->read_word(addr, mode);
+    cpu->watch_io(addr, mode, true, z8000_debug_hit::READ, value);
+    return value;
+}
+
+void z8002_device::io_watch_bus::write_byte(uint16_t addr, uint8_t val, int mode)
+{
+    attached->write_byte(addr, val, mode);
+    cpu->watch_io(addr, mode, false, z8000_debug_hit::WRITE, val);
+}
+
+void z8002_device::io_watch_bus::write_word(uint16_t addr, uint16_t val, int mode)
+{
+    attached->write_word(addr, val, mode);
+    cpu->watch_io(addr, mode, true, z8000_debug_hit::WRITE, val);
+}
+
+/* block transfers to watched ports are made one element at a time, so
+   the run stops at the element's instruction boundary like any other */
+bool z8002_device::io_watch_bus::read_block(uint16_t addr, int mode, uint16_t* data, uint32_t count, bool word)
+{
+    if (cpu->m_io_watch_pages[((mode & 1) << 8) | (addr >> 8)])
+        return false;
+    return attached->read_block(addr, mode, data, count, word);
+}
+
+bool z8002_device::io_watch_bus::write_block(uint16_t addr, int mode, const uint16_t* data, uint32_t count, bool word)
+{
+    if (cpu->m_io_watch_pages[((mode & 1) << 8) | (addr >> 8)])
+        return false;
+    return attached->write_block(addr, mode, data, count, word);
+}
@@ -0,0 +1,97 @@
+// Z8000 idle skipping: setup and the instructions a polling loop may hold
+
+#include <algorithm>
+
+#include <z8000/z8000.h>
+
+#define OP(f)   &z8002_device::f<false>
+
+void z8002_device::set_idle_skip(unsigned modes)
+{
+    /* register and flag operations, and loads, compares and tests reading
+       memory or ports; memory through an address operand in word 1 */
+    static const opcode_func reads[] = {
+        OP(Z00_0000_dddd_imm8), OP(Z00_ssN0_dddd), OP(Z01_0000_dddd_imm16), OP(Z01_ssN0_dddd),
+        OP(Z02_0000_dddd_imm8), OP(Z02_ssN0_dddd), OP(Z03_0000_dddd_imm16), OP(Z03_ssN0_dddd),
+        OP(Z04_0000_dddd_imm8), OP(Z04_ssN0_dddd), OP(Z05_0000_dddd_imm16), OP(Z05_ssN0_dddd),
+        OP(Z06_0000_dddd_imm8), OP(Z06_ssN0_dddd), OP(Z07_0000_dddd_imm16), OP(Z07_ssN0_dddd),
+        OP(Z08_0000_dddd_imm8), OP(Z08_ssN0_dddd), OP(Z09_0000_dddd_imm16), OP(Z09_ssN0_dddd),
+        OP(Z0A_0000_dddd_imm8), OP(Z0A_ssN0_dddd), OP(Z0B_0000_dddd_imm16), OP(Z0B_ssN0_dddd),
+        OP(Z0C_ddN0_0001_imm8), OP(Z0C_ddN0_0100), OP(Z0D_ddN0_0001_imm16), OP(Z0D_ddN0_0100),
+        OP(Z10_0000_dddd_imm32), OP(Z10_ssN0_dddd), OP(Z12_0000_dddd_imm32), OP(Z12_ssN0_dddd),
+        OP(Z14_0000_dddd_imm32), OP(Z14_ssN0_dddd), OP(Z16_0000_dddd_imm32), OP(Z16_ssN0_dddd),
+        OP(Z1C_ddN0_1000),
+        OP(Z20_0000_dddd_imm8), OP(Z20_ssN0_dddd), OP(Z21_0000_dddd_imm16), OP(Z21_ssN0_dddd),
+        OP(Z22_0000_ssss_0000_dddd_0000_0000), OP(Z23_0000_ssss_0000_dddd_0000_0000),
+        OP(Z24_0000_ssss_0000_dddd_0000_0000), OP(Z25_0000_ssss_0000_dddd_0000_0000),
+        OP(Z26_0000_ssss_0000_dddd_0000_0000), OP(Z26_ddN0_imm4),
+        OP(Z27_0000_ssss_0000_dddd_0000_0000), OP(Z27_ddN0_imm4),
+        OP(Z30_0000_dddd_dsp16), OP(Z30_ssN0_dddd_imm16), OP(Z31_0000_dddd_dsp16), OP(Z31_ssN0_dddd_imm16),
+        OP(Z34_0000_dddd_dsp16), OP(Z34_ssN0_dddd_imm16), OP(Z35_0000_dddd_dsp16), OP(Z35_ssN0_dddd_imm16),
+        OP(Z3A_dddd_0100_imm16), OP(Z3A_dddd_0101_imm16), OP(Z3B_dddd_0100_imm16), OP(Z3B_dddd_0101_imm16),
+        OP(Z3C_ssss_dddd), OP(Z3D_ssss_dddd),
+        OP(Z70_ssN0_dddd_0000_xxxx_0000_0000), OP(Z71_ssN0_dddd_0000_xxxx_0000_0000),
+        OP(Z74_ssN0_dddd_0000_xxxx_0000_0000), OP(Z75_ssN0_dddd_0000_xxxx_0000_0000),
+        OP(Z80_ssss_dddd), OP(Z81_ssss_dddd), OP(Z82_ssss_dddd), OP(Z83_ssss_dddd),
+        OP(Z84_ssss_dddd), OP(Z85_ssss_dddd), OP(Z86_ssss_dddd), OP(Z87_ssss_dddd),
+        OP(Z88_ssss_dddd), OP(Z89_ssss_dddd), OP(Z8A_ssss_dddd), OP(Z8B_ssss_dddd),
+        OP(Z8C_dddd_0000), OP(Z8C_dddd_0001), OP(Z8C_dddd_0010), OP(Z8C_dddd_0100),
+        OP(Z8C_dddd_1000), OP(Z8C_dddd_1001),
+        OP(Z8D_0000_0111), OP(Z8D_dddd_0000), OP(Z8D_dddd_0010), OP(Z8D_dddd_0100), OP(Z8D_dddd_1000),
+        OP(Z8D_imm4_0001), OP(Z8D_imm4_0011), OP(Z8D_imm4_0101),
+        OP(Z90_ssss_dddd), OP(Z92_ssss_dddd), OP(Z94_ssss_dddd), OP(Z96_ssss_dddd), OP(Z9C_dddd_1000),
+        OP(ZA0_ssss_dddd), OP(ZA1_ssss_dddd), OP(ZA2_dddd_imm4), OP(ZA3_dddd_imm4),
+        OP(ZA4_dddd_imm4), OP(ZA5_dddd_imm4), OP(ZA6_dddd_imm4), OP(ZA7_dddd_imm4),
+        OP(ZA8_dddd_imm4m1), OP(ZA9_dddd_imm4m1), OP(ZAA_dddd_imm4m1), OP(ZAB_dddd_imm4m1),
+        OP(ZAC_ssss_dddd), OP(ZAD_ssss_dddd), OP(ZAE_dddd_cccc), OP(ZAF_dddd_cccc),
+        OP(ZB0_dddd_0000), OP(ZB1_dddd_0000), OP(ZB1_dddd_0111), OP(ZB1_dddd_1010),
+        OP(ZB2_dddd_0001_imm8), OP(ZB2_dddd_0011_0000_ssss_0000_0000), OP(ZB2_dddd_00I0), OP(ZB2_dddd_01I0),
+        OP(ZB2_dddd_1001_imm8), OP(ZB2_dddd_1011_0000_ssss_0000_0000), OP(ZB2_dddd_10I0), OP(ZB2_dddd_11I0),
+        OP(ZB3_dddd_0001_imm8), OP(ZB3_dddd_0011_0000_ssss_0000_0000), OP(ZB3_dddd_00I0),
+        OP(ZB3_dddd_0101_imm8), OP(ZB3_dddd_0111_0000_ssss_0000_0000), OP(ZB3_dddd_01I0),
+        OP(ZB3_dddd_1001_imm8), OP(ZB3_dddd_1011_0000_ssss_0000_0000), OP(ZB3_dddd_10I0),
+        OP(ZB3_dddd_1101_imm8), OP(ZB3_dddd_1111_0000_ssss_0000_0000), OP(ZB3_dddd_11I0),
+        OP(ZB4_ssss_dddd), OP(ZB5_ssss_dddd), OP(ZB6_ssss_dddd), OP(ZB7_ssss_dddd),
+        OP(ZBD_dddd_imm4), OP(ZC_dddd_imm8),
+    };
+    static const opcode_func addr_reads[] = {
+        OP(Z40_0000_dddd_addr), OP(Z40_ssN0_dddd_addr), OP(Z41_0000_dddd_addr), OP(Z41_ssN0_dddd_addr),
+        OP(Z42_0000_dddd_addr), OP(Z42_ssN0_dddd_addr), OP(Z43_0000_dddd_addr), OP(Z43_ssN0_dddd_addr),
+        OP(Z44_0000_dddd_addr), OP(Z44_ssN0_dddd_addr), OP(Z45_0000_dddd_addr), OP(Z45_ssN0_dddd_addr),
+        OP(Z46_0000_dddd_addr), OP(Z46_ssN0_dddd_addr), OP(Z47_0000_dddd_addr), OP(Z47_ssN0_dddd_addr),
+        OP(Z48_0000_dddd_addr), OP(Z48_ssN0_dddd_addr), OP(Z49_0000_dddd_addr), OP(Z49_ssN0_dddd_addr),
+        OP(Z4A_0000_dddd_addr), OP(Z4A_ssN0_dddd_addr), OP(Z4B_0000_dddd_addr), OP(Z4B_ssN0_dddd_addr),
+        OP(Z4C_0000_0001_addr_imm8), OP(Z4C_0000_0100_addr), OP(Z4C_ddN0_0001_addr_imm8), OP(Z4C_ddN0_0100_addr),
+        OP(Z4D_0000_0001_addr_imm16), OP(Z4D_0000_0100_addr), OP(Z4D_ddN0_0001_addr_imm16), OP(Z4D_ddN0_0100_addr),
+        OP(Z50_0000_dddd_addr), OP(Z50_ssN0_dddd_addr), OP(Z52_0000_dddd_addr), OP(Z52_ssN0_dddd_addr),
+        OP(Z54_0000_dddd_addr), OP(Z54_ssN0_dddd_addr), OP(Z56_0000_dddd_addr), OP(Z56_ssN0_dddd_addr),
+        OP(Z5C_0000_1000_addr), OP(Z5C_ddN0_1000_addr),
+        OP(Z60_0000_dddd_addr), OP(Z60_ssN0_dddd_addr), OP(Z61_0000_dddd_addr), OP(Z61_ssN0_dddd_addr),
+        OP(Z66_0000_imm4_addr), OP(Z66_ddN0_imm4_addr), OP(Z67_0000_imm4_addr), OP(Z67_ddN0_imm4_addr),
+        OP(Z76_0000_dddd_addr), OP(Z76_ssN0_dddd_addr),
+    };
+
+    m_idle_modes = modes & IDLE_ALL;
+    m_idle_loop.valid = false;
+    m_idle_kind.clear();
+    if (!(m_idle_modes & IDLE_POLL))
+        return;
+
+    size_t entries = 0;
+    while (table[entries].size)
+        entries++;
+
+    m_idle_kind.assign(entries, IDLE_OTHER);
+    for (size_t i = 0; i < entries; i++)
+    {
+        const opcode_func op = table[i].opcode[0];
+        if (std::find(std::begin(reads), std::end(reads), op) != std::end(reads))
+            m_idle_kind[i] = IDLE_READ;
+        else if (std::find(std::begin(addr_reads), std::end(addr_reads), op) != std::end(addr_reads))
+            m_idle_kind[i] = IDLE_READ_ADDR;
+        else if (op == OP(ZE_cccc_dsp8))
+            m_idle_kind[i] = IDLE_JR;
+    }
+}
+
+#undef OP
@@ -0,0 +1,144 @@
+// Z8000 I/O port map
+
+#include "z8000/z8000_iomap.h"
+
+#include <algorithm>
+
+z8000_io_map::z8000_io_map()
+    : m_entries(1)
+{
+    m_empty.fill(0);
+    for (auto& space : m_pages)
+        space.fill(&m_empty);
+    set_unmapped(NORMAL, 0xFF, 0xFFFF);
+    set_unmapped(SPECIAL, 0xFF, 0xFFFF);
+}
+
+void z8000_io_map::assign(int space, uint16_t first, uint16_t last, uint16_t index)
+{
+    space &= 1;
+    for (uint32_t port = first; port <= last; port++) {
+        page*& p = m_pages[space][port >> PAGE_SHIFT];
+        if (p == &m_empty) {
+            m_owned.push_back(std::make_unique<page>(m_empty));
+            p = m_owned.back().get();
+        }
+        (*p)[port & ((1 << PAGE_SHIFT) - 1)] = index;
+    }
+}
+
+void z8000_io_map::map(int space, uint16_t first, uint16_t last, handler h)
+{
+    entry e;
+    e.h = std::move(h);
+    e.first = first;
+    m_entries.push_back(std::move(e));
+    assign(space, first, last, uint16_t(m_entries.size() - 1));
+}
+
+void z8000_io_map::map_registers(int space, uint16_t first, uint16_t last, uint8_t* regs)
+{
+    entry e;
+    e.regs = regs;
+    e.first = first & ~1;
+    m_entries.push_back(std::move(e));
+    assign(space, first & ~1, last | 1, uint16_t(m_entries.size() - 1));
+}
+
+void z8000_io_map::unmap(int space, uint16_t first, uint16_t last)
+{
+    assign(space, first, last, 0);
+}
+
+void z8000_io_map::set_unmapped(int space, uint8_t byte_value, uint16_t word_value)
+{
+    m_unmapped_byte[space & 1] = byte_value;
+    m_unmapped_word[space & 1] = word_value;
+}
+
+uint8_t z8000_io_map::read_byte(uint16_t port, int mode)
+{
+    const entry& e = lookup(port, mode);
+    if (e.regs)
+        return e.regs[uint16_t(port - e.first)];
+    if (e.h.read_byte)
+        return e.h.read_byte(port);
+    if (e.h.read_word) {
+        const uint16_t word = e.h.read_word(port & ~1);
+        return (port & 1) ? word : word >> 8;
+    }
+    return m_unmapped_byte[mode & 1];
+}
+
+uint16_t z8000_io_map::read_word(uint16_t port, int mode)
+{
+    const entry& e = lookup(port, mode);
+    if (e.regs) {
+        const uint8_t* reg = &e.regs[uint16_t((port & ~1) - e.first)];
+        return (reg[0] << 8) | reg[1];
+    }
+    if (e.h.read_word)
+        return e.h.read_word(port);
+    if (e.h.read_byte)
+        return (e.h.read_byte(port & ~1) << 8) | e.h.read_byte(port | 1);
+    return m_unmapped_word[mode & 1];
+}
+
+void z8000_io_map::write_byte(uint16_t port, uint8_t value, int mode)
+{
+    const entry& e = lookup(port, mode);
+    if (e.regs)
+        e.regs[uint16_t(port - e.first)] = value;
+    else if (e.h.write_byte)
+        e.h.write_byte(port, value);
+    else if (e.h.write_word)
+        e.h.write_word(port & ~1, (port & 1) ? value : value << 8);
+}
+
+void z8000_io_map::write_word(uint16_t port, uint16_t value, int mode)
+{
+    const entry& e = lookup(port, mode);
+    if (e.regs) {
+        uint8_t* reg = &e.regs[uint16_t((port & ~1) - e.first)];
+        reg[0] = value >> 8;
+        reg[1] = value;
+    } else if (e.h.write_word) {
+        e.h.write_word(port, value);
+    } else if (e.h.write_byte) {
+        e.h.write_byte(port & ~1, value >> 8);
+        e.h.write_byte(port | 1, value);
+    }
+}
+
+bool z8000_io_map::read_block(uint16_t port, int mode, uint16_t* data, uint32_t count, bool word)
+{
+    const entry& e = lookup(port, mode);
+    if (e.h.read_block) {
+        e.h.read_block(port, data, count, word);
+        return true;
+    }
+    // Registers and unmapped ports return the same value every time
+    if (!e.regs && (e.h.read_byte || e.h.read_word))
+        return false;
+    std::fill(data, data + count, word ? read_word(port, mode) : read_byte(port, mode));
+    return true;
+}
+
+bool z8000_io_map::write_block(uint16_t port, int mode, const uint16_t* data, uint32_t count, bool word)
+{
+    const entry& e = lookup(port, mode);
+    if (e.h.write_block) {
+        e.h.write_block(port, data, count, word);
+        return true;
+    }
+    // A register keeps the last value; unmapped ports drop them all
+    if (!e.regs && (e.h.write_byte || e.h.write_word))
+        return false;
+    if (count) {
+        if (word)
+            write_word(port, data[count - 1], mode);
+        else
+            write_byte(port, data[count - 1], mode);
+    }
+    return true;
+}
@@ -0,0 +1,152 @@
+// Z8000 memory access statistics: the counting buses and the reports
+
+#include <algorithm>
+
+#include <z8000/z8000.h>
+
+z8000_memory_stats::z8000_memory_stats(uint32_t size)
+    : m_pages(1), m_intervals(0)
+{
+    while (m_pages < (size >> PAGE_SHIFT))
+        m_pages <<= 1;
+    m_counts.assign(SPACES * 2 * size_t(m_pages), 0);
+    m_interval = m_counts;
+    for (unsigned s = 0; s < SPACES; s++) {
+        m_buses[s].reads = &m_counts[index(s, false)];
+        m_buses[s].writes = &m_counts[index(s, true)];
+        m_buses[s].mask = m_pages - 1;
+    }
+}
+
+uint64_t z8000_memory_stats::accesses(uint32_t page) const
+{
+    uint64_t n = 0;
+    for (unsigned s = 0; s < SPACES; s++)
+        n += reads(s, page) + writes(s, page);
+    return n;
+}
+
+void z8000_memory_stats::clear()
+{
+    std::fill(m_counts.begin(), m_counts.end(), 0);
+    std::fill(m_interval.begin(), m_interval.end(), 0);
+}
+
+z8000_memory_bus* z8000_memory_stats::counting_bus(unsigned space, z8000_memory_bus* bus)
+{
+    if (!bus || space >= SPACES)
+        return bus;
+    m_buses[space].bus = bus;
+    return &m_buses[space];
+}
+
+uint8_t z8000_memory_stats::counting::read_byte(uint32_t addr)
+{
+    reads[(addr >> PAGE_SHIFT) & mask]++;
+    return bus->read_byte(addr);
+}
+
+uint16_t z8000_memory_stats::counting::read_word(uint32_t addr)
+{
+    reads[(addr >> PAGE_SHIFT) & mask]++;
+    return bus->read_word(addr);
+}
+
+void z8000_memory_stats::counting::write_byte(uint32_t addr, uint8_t val)
+{
+    writes[(addr >> PAGE_SHIFT) & mask]++;
+    bus->write_byte(addr, val);
+}
+
+void z8000_memory_stats::counting::write_word(uint32_t addr, uint16_t val)
+{
+    writes[(addr >> PAGE_SHIFT) & mask]++;
+    bus->write_word(addr, val);
+}
+
+/* byte stores come here as one half of a word and count once */
+void z8000_memory_stats::counting::write_word(uint32_t addr, uint16_t val, uint16_t mask)
+{
+    writes[(addr >> PAGE_SHIFT) & this->mask]++;
+    bus->write_word(addr, val, mask);
+}
+
+void z8000_memory_stats::write_report(FILE* out, bool json) const
+{
+    static const char* const names[SPACES] = { "program", "data", "stack", "fetch" };
+    const char* addr_fmt = m_pages > 0x100 ? "%06X" : "%04X";
+
+    if (json)
+        fprintf(out, "{\"page_size\":%u,\"pages\":[", PAGE_SIZE);
+    else
+        fprintf(out, "start,end,fetches,program_reads,program_writes,data_reads,data_writes,stack_reads,stack_writes\n");
+
+    const char* sep = "";
+    for (uint32_t page = 0; page < m_pages; page++) {
+        if (!accesses(page))
+            continue;
+        const uint32_t start = page << PAGE_SHIFT;
+        if (json) {
+            fprintf(out, "%s{\"start\":%u", sep, start);
+            for (unsigned s = 0; s < SPACES; s++) {
+                if (s == FETCH)
+                    fprintf(out, ",\"fetches\":%llu", (unsigned long long)reads(s, page));
+                else
+                    fprintf(out, ",\"%s_reads\":%llu,\"%s_writes\":%llu", names[s],
+                            (unsigned long long)reads(s, page), names[s], (unsigned long long)writes(s, page));
+            }
+            fprintf(out, "}");
+        } else {
+            fprintf(out, addr_fmt, start);
+            fprintf(out, ",");
+            fprintf(out, addr_fmt, start + PAGE_SIZE - 1);
+            fprintf(out, ",%llu", (unsigned long long)reads(FETCH, page));
+            for (unsigned s = PROGRAM; s <= STACK; s++)
+                fprintf(out, ",%llu,%llu", (unsigned long long)reads(s, page), (unsigned long long)writes(s, page));
+            fprintf(out, "\n");
+        }
+        sep = ",";
+    }
+
+    if (json)
+        fprintf(out, "]}\n");
+}
+
+/* pages whose counters moved since the interval began were touched in it */
+void z8000_memory_stats::write_interval(FILE* out, uint64_t cycle, bool json)
+{
+    uint32_t spaces[SPACES] = {}, touched = 0, written = 0, footprint = 0, rom = 0, ram = 0;
+    for (uint32_t page = 0; page < m_pages; page++) {
+        bool now = false, now_written = false, ever = false, ever_written = false;
+        for (unsigned s = 0; s < SPACES; s++) {
+            const size_t r = index(s, false) + page, w = index(s, true) + page;
+            const bool wrote = m_counts[w] != m_interval[w];
+            if (wrote || m_counts[r] != m_interval[r]) {
+                spaces[s]++;
+                now = true;
+            }
+            now_written |= wrote;
+            ever |= m_counts[r] || m_counts[w];
+            ever_written |= m_counts[w] != 0;
+        }
+        touched += now;
+        written += now_written;
+        footprint += ever;
+        ram += ever_written;
+        rom += ever && !ever_written;
+    }
+    m_interval = m_counts;
+
+    if (json)
+        fprintf(out, "{\"cycle\":%llu,\"pages\":%u,\"program\":%u,\"data\":%u,\"stack\":%u,\"code\":%u,"
+                "\"written\":%u,\"footprint\":%u,\"rom\":%u,\"ram\":%u}\n",
+                (unsigned long long)cycle, touched, spaces[PROGRAM], spaces[DATA], spaces[STACK], spaces[FETCH],
+                written, footprint, rom, ram);
+    else {
+        if (!m_intervals)
+            fprintf(out, "cycle,pages,program,data,stack,code,written,footprint,rom,ram\n");
+        fprintf(out, "%llu,%u,%u,%u,%u,%u,%u,%u,%u,%u\n", (unsigned long long)cycle, touched,
+                spaces[PROGRAM], spaces[DATA], spaces[STACK], spaces[FETCH], written, footprint, rom, ram);
+    }
+    m_intervals++;
+}
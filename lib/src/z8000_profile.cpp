@@ -0,0 +1,222 @@
+// Z8000 execution profiler: setup, call graph and report
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include <z8000/z8000.h>
+
+void z8002_device::set_profile(unsigned modes, unsigned pc_period)
+{
+    z8000_profile &prof = m_profile;
+    prof = z8000_profile();
+    prof.modes = modes & z8000_profile::ALL;
+    prof.pc_period = prof.pc_countdown = pc_period ? pc_period : 1;
+
+    size_t entries = 0;
+    while (table[entries].size)
+        entries++;
+
+    if (prof.modes & z8000_profile::OPCODES)
+        prof.opcodes.resize(entries);
+
+    if (prof.modes & z8000_profile::PCS)
+        prof.pcs.resize(size_t(m_page_mask + 1) << (BLOCK_PAGE_SHIFT - z8000_profile::PC_SHIFT));
+
+    if (prof.modes & z8000_profile::CALLS)
+    {
+        prof.kind.resize(entries);
+        for (size_t i = 0; i < entries; i++)
+        {
+            const opcode_func op = table[i].opcode[0];
+            if (op == &z8002_device::Z1F_ddN0_0000<false> || op == &z8002_device::Z5F_0000_0000_addr<false> ||
+                op == &z8002_device::Z5F_ddN0_0000_addr<false> || op == &z8002_device::ZD_dsp12<false>)
+                prof.kind[i] = z8000_profile::CALL_INSN;
+            else if (op == &z8002_device::Z9E_0000_cccc<false>)
+                prof.kind[i] = z8000_profile::RET_INSN;
+        }
+    }
+}
+
+void z8002_device::clear_profile()
+{
+    z8000_profile &prof = m_profile;
+    std::fill(prof.opcodes.begin(), prof.opcodes.end(), z8000_profile::counter());
+    std::fill(prof.pcs.begin(), prof.pcs.end(), 0);
+    std::fill(std::begin(prof.traps), std::end(prof.traps), 0);
+    prof.calls.clear();
+    prof.stack.clear();
+    prof.pc_countdown = prof.pc_period;
+}
+
+/* req is the single request Interrupt() just serviced */
+void z8002_device::profile_trap(uint8_t req)
+{
+    unsigned kind;
+    switch (req)
+    {
+    case Z8000_RESET:   kind = z8000_profile::TRAP_RESET; break;
+    case Z8000_EPU:     kind = z8000_profile::TRAP_EXTENDED; break;
+    case Z8000_TRAP:    kind = z8000_profile::TRAP_PRIVILEGED; break;
+    case Z8000_SYSCALL: kind = z8000_profile::TRAP_SYSTEM_CALL; break;
+    case Z8000_SEGTRAP: kind = z8000_profile::TRAP_SEGMENT; break;
+    case Z8000_NMI:     kind = z8000_profile::TRAP_NMI; break;
+    case Z8000_NVI:     kind = z8000_profile::TRAP_NVI; break;
+    default:            kind = z8000_profile::TRAP_VI; break;
+    }
+    m_profile.traps[kind]++;
+}
+
+void z8002_device::profile_call(uint8_t kind)
+{
+    z8000_profile &prof = m_profile;
+
+    if (kind == z8000_profile::CALL_INSN)
+    {
+        /* key on the address alone, without the Z8001's flag bits */
+        const uint32_t callee = m_pc & ((uint32_t(m_page_mask) << BLOCK_PAGE_SHIFT) | ((1u << BLOCK_PAGE_SHIFT) - 1));
+        const uint32_t caller = prof.stack.empty() ? z8000_profile::ROOT : prof.stack.back().callee;
+        prof.calls[uint64_t(caller) << 32 | callee].count++;
+
+        /* code that discards its return addresses would grow this forever;
+           forget the outermost calls instead */
+        if (prof.stack.size() >= 0x10000)
+            prof.stack.erase(prof.stack.begin(), prof.stack.begin() + 0x8000);
+        prof.stack.push_back({caller, callee, m_total_cycles});
+        return;
+    }
+
+    /* a RET whose condition failed falls through to the next word */
+    const uint32_t next = (m_ppc & ~0xffffu) | ((m_ppc + 2) & 0xffff);
+    if (m_pc == next || prof.stack.empty())
+        return;
+
+    const z8000_profile::frame &frame = prof.stack.back();
+    prof.calls[uint64_t(frame.caller) << 32 | frame.callee].cycles += m_total_cycles - frame.start;
+    prof.stack.pop_back();
+}
+
+void z8002_device::write_profile(FILE* out, bool json) const
+{
+    const z8000_profile &prof = m_profile;
+    const char *addr_fmt = (m_page_mask >> (16 - BLOCK_PAGE_SHIFT)) ? "%06X" : "%04X";
+
+    /* most expensive handlers first */
+    std::vector<size_t> opcodes;
+    for (size_t i = 0; i < prof.opcodes.size(); i++)
+        if (prof.opcodes[i].count)
+            opcodes.push_back(i);
+    std::sort(opcodes.begin(), opcodes.end(), [&](size_t a, size_t b) {
+        return prof.opcodes[a].cycles > prof.opcodes[b].cycles;
+    });
+
+    std::vector<std::pair<uint64_t, z8000_profile::counter>> calls(prof.calls.begin(), prof.calls.end());
+    std::sort(calls.begin(), calls.end(), [](const auto &a, const auto &b) {
+        return a.second.cycles != b.second.cycles ? a.second.cycles > b.second.cycles : a.first < b.first;
+    });
+
+    if (json)
+        fprintf(out, "{\"opcodes\":[");
+    else
+        fprintf(out, "kind,start,end,name,count,cycles\n");
+
+    const char *sep = "";
+    for (size_t i : opcodes)
+    {
+        /* the handler's mnemonic, from its first opcode word; placed past
+           the reset vector, which the disassembler shows as data */
+        uint8_t bytes[0x108] = {};
+        bytes[0x100] = table[i].beg >> 8;
+        bytes[0x101] = table[i].beg;
+        data_buffer buf(bytes, sizeof(bytes));
+        char text[z8000_disassembler::MAX_TEXT];
+        util::text_appender stream(text, sizeof(text));
+        m_disasm->disassemble(stream, 0x100, buf, buf);
+        const std::string name(text, strcspn(text, " \t"));
+
+        if (json)
+            fprintf(out, "%s{\"first\":%d,\"last\":%d,\"mnemonic\":\"%s\",\"count\":%llu,\"cycles\":%llu}",
+                    sep, table[i].beg, table[i].end, name.c_str(),
+                    (unsigned long long)prof.opcodes[i].count, (unsigned long long)prof.opcodes[i].cycles);
+        else
+            fprintf(out, "opcode,%04X,%04X,%s,%llu,%llu\n", table[i].beg, table[i].end, name.c_str(),
+                    (unsigned long long)prof.opcodes[i].count, (unsigned long long)prof.opcodes[i].cycles);
+        sep = ",";
+    }
+
+    if (json)
+        fprintf(out, "],\"pcs\":[");
+    sep = "";
+    for (size_t i = 0; i < prof.pcs.size(); i++)
+    {
+        if (!prof.pcs[i])
+            continue;
+        const unsigned start = i << z8000_profile::PC_SHIFT;
+        const unsigned end = start + (1 << z8000_profile::PC_SHIFT) - 1;
+        if (json)
+        {
+            fprintf(out, "%s{\"start\":%u,\"samples\":%llu}", sep, start, (unsigned long long)prof.pcs[i]);
+        }
+        else
+        {
+            fprintf(out, "pc,");
+            fprintf(out, addr_fmt, start);
+            fprintf(out, ",");
+            fprintf(out, addr_fmt, end);
+            fprintf(out, ",,%llu,\n", (unsigned long long)prof.pcs[i]);
+        }
+        sep = ",";
+    }
+
+    if (json)
+        fprintf(out, "],\"calls\":[");
+    sep = "";
+    for (const auto &call : calls)
+    {
+        const uint32_t caller = call.first >> 32;
+        const uint32_t callee = uint32_t(call.first);
+        if (json)
+        {
+            if (caller == z8000_profile::ROOT)
+                fprintf(out, "%s{\"caller\":null", sep);
+            else
+                fprintf(out, "%s{\"caller\":%u", sep, caller);
+            fprintf(out, ",\"callee\":%u,\"count\":%llu,\"cycles\":%llu}", callee,
+                    (unsigned long long)call.second.count, (unsigned long long)call.second.cycles);
+        }
+        else
+        {
+            fprintf(out, "call,");
+            if (caller == z8000_profile::ROOT)
+                fprintf(out, "root");
+            else
+                fprintf(out, addr_fmt, caller);
+            fprintf(out, ",");
+            fprintf(out, addr_fmt, callee);
+            fprintf(out, ",,%llu,%llu\n", (unsigned long long)call.second.count,
+                    (unsigned long long)call.second.cycles);
+        }
+        sep = ",";
+    }
+
+    static const char *const trap_names[z8000_profile::TRAP_KINDS] = {
+        "reset", "extended", "privileged", "system_call", "segment", "nmi", "nvi", "vi"
+    };
+    if (json)
+        fprintf(out, "],\"traps\":[");
+    sep = "";
+    for (unsigned i = 0; i < z8000_profile::TRAP_KINDS; i++)
+    {
+        if (!prof.traps[i])
+            continue;
+        if (json)
+            fprintf(out, "%s{\"kind\":\"%s\",\"count\":%llu}", sep, trap_names[i],
+                    (unsigned long long)prof.traps[i]);
+        else
+            fprintf(out, "trap,,,%s,%llu,\n", trap_names[i], (unsigned long long)prof.traps[i]);
+        sep = ",";
+    }
+
+    if (json)
+        fprintf(out, "]}\n");
+}
@@ -0,0 +1,385 @@
+// Z8000 I/O record and replay
+
+#include "z8000/z8000_replay.h"
+
+namespace {
+
+using fmt = z8000_replay_format;
+
+// Encoding into a record buffer, little-endian
+struct record_buffer {
+    uint8_t bytes[16];
+    unsigned size = 0;
+
+    void put8(uint8_t v) { bytes[size++] = v; }
+    void put16(uint16_t v) { put8(v & 0xff); put8(v >> 8); }
+    void put_cycles(uint64_t v) {
+        do {
+            put8((v & 0x7f) | (v > 0x7f ? 0x80 : 0));
+            v >>= 7;
+        } while (v);
+    }
+};
+
+// Decoding a loaded recording; any read past the end makes it bad
+struct record_reader {
+    const std::vector<uint8_t>& data;
+    size_t pos = 0;
+    bool bad = false;
+
+    bool at_end() const { return pos >= data.size(); }
+    uint8_t get8() {
+        if (pos >= data.size()) {
+            bad = true;
+            return 0;
+        }
+        return data[pos++];
+    }
+    uint16_t get16() {
+        const uint8_t lo = get8();
+        return lo | (get8() << 8);
+    }
+    uint64_t get_cycles() {
+        uint64_t v = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            const uint8_t b = get8();
+            v |= uint64_t(b & 0x7f) << shift;
+            if (!(b & 0x80))
+                return v;
+        }
+        bad = true;
+        return v;
+    }
+};
+
+uint8_t io_tag(uint8_t kind, int mode) {
+    return kind | ((mode & 1) ? fmt::SPECIAL : 0);
+}
+
+// A record's tag and its cycle delta from the last one
+record_buffer begin_record(uint8_t tag, uint64_t now, uint64_t& last) {
+    record_buffer rec;
+    rec.put8(tag);
+    rec.put_cycles(now - last);
+    last = now;
+    return rec;
+}
+
+uint16_t cpu_model(const z8002_device& cpu) {
+    z8000_state state;
+    cpu.save_state(state);
+    return state.model;
+}
+
+} // anonymous namespace
+
+z8000_io_recorder::z8000_io_recorder(z8002_device& cpu, z8000_io_bus& io)
+    : m_cpu(cpu), m_io(io), m_file(nullptr), m_last_cycle(0)
+{
+}
+
+z8000_io_recorder::~z8000_io_recorder()
+{
+    close();
+}
+
+bool z8000_io_recorder::open(const char* path)
+{
+    close();
+    if (!(m_file = fopen(path, "wb")))
+        return false;
+    setvbuf(m_file, nullptr, _IOFBF, 1 << 16);
+
+    record_buffer header;
+    header.put16(fmt::MAGIC & 0xffff);
+    header.put16(fmt::MAGIC >> 16);
+    header.put16(fmt::VERSION);
+    header.put16(cpu_model(m_cpu));
+    fwrite(header.bytes, 1, header.size, m_file);
+    m_last_cycle = 0;
+    return true;
+}
+
+void z8000_io_recorder::close()
+{
+    if (!m_file)
+        return;
+    record_buffer rec = begin_record(fmt::END, m_cpu.get_cycles(), m_last_cycle);
+    fwrite(rec.bytes, 1, rec.size, m_file);
+    fclose(m_file);
+    m_file = nullptr;
+}
+
+void z8000_io_recorder::record(uint8_t tag, uint16_t port, uint16_t value)
+{
+    if (!m_file)
+        return;
+    record_buffer rec = begin_record(tag, m_cpu.get_cycles(), m_last_cycle);
+    rec.put16(port);
+    if ((tag & 7) == fmt::READ_WORD || (tag & 7) == fmt::WRITE_WORD)
+        rec.put16(value);
+    else
+        rec.put8(value);
+    fwrite(rec.bytes, 1, rec.size, m_file);
+}
+
+void z8000_io_recorder::set_input_line(int line, int state, uint16_t vector)
+{
+    if (m_file) {
+        record_buffer rec = begin_record(fmt::LINE, m_cpu.get_cycles(), m_last_cycle);
+        rec.put8(line);
+        rec.put8(state != CLEAR_LINE);
+        rec.put16(vector);
+        fwrite(rec.bytes, 1, rec.size, m_file);
+    }
+    m_cpu.set_input_line(line, state, vector);
+}
+
+uint8_t z8000_io_recorder::read_byte(uint16_t port, int mode)
+{
+    const uint8_t value = m_io.read_byte(port, mode);
+    record(io_tag(fmt::READ_BYTE, mode), port, value);
+    return value;
+}
+
+uint16_t z8000_io_recorder::read_word(uint16_t port, int mode)
+{
+    const uint16_t value = m_io.read_word(port, mode);
+    record(io_tag(fmt::READ_WORD, mode), port, value);
+    return value;
+}
+
+void z8000_io_recorder::write_byte(uint16_t port, uint8_t value, int mode)
+{
+    record(io_tag(fmt::WRITE_BYTE, mode), port, value);
+    m_io.write_byte(port, value, mode);
+}
+
+void z8000_io_recorder::write_word(uint16_t port, uint16_t value, int mode)
+{
+    record(io_tag(fmt::WRITE_WORD, mode), port, value);
+    m_io.write_word(port, value, mode);
+}
+
+/* a block transfer is logged as its elements, all at the call's cycle */
+bool z8000_io_recorder::read_block(uint16_t port, int mode, uint16_t* data, uint32_t count, bool word)
+{
+    if (!m_io.read_block(port, mode, data, count, word))
+        return false;
+    for (uint32_t i = 0; i < count; i++)
+        record(io_tag(word ? fmt::READ_WORD : fmt::READ_BYTE, mode), port, data[i]);
+    return true;
+}
+
+bool z8000_io_recorder::write_block(uint16_t port, int mode, const uint16_t* data, uint32_t count, bool word)
+{
+    if (!m_io.write_block(port, mode, data, count, word))
+        return false;
+    for (uint32_t i = 0; i < count; i++)
+        record(io_tag(word ? fmt::WRITE_WORD : fmt::WRITE_BYTE, mode), port, data[i]);
+    return true;
+}
+
+z8000_io_replayer::z8000_io_replayer(z8002_device& cpu)
+    : m_cpu(cpu), m_end_cycle(0), m_next(0), m_event(0), m_diverged(false), m_divergence_cycle(0)
+{
+}
+
+z8000_io_replayer::~z8000_io_replayer()
+{
+    if (m_event)
+        m_cpu.cancel_event(m_event);
+}
+
+const char* z8000_io_replayer::open(const char* path)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f)
+        return "cannot open file";
+    std::vector<uint8_t> data;
+    uint8_t chunk[1 << 16];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof chunk, f)) > 0)
+        data.insert(data.end(), chunk, chunk + n);
+    fclose(f);
+
+    record_reader in{data};
+    const uint32_t magic = in.get16() | (uint32_t(in.get16()) << 16);
+    const uint16_t version = in.get16();
+    const uint16_t model = in.get16();
+    if (in.bad || magic != fmt::MAGIC)
+        return "not a recording";
+    if (version != fmt::VERSION)
+        return "unsupported recording version";
+    if (model != cpu_model(m_cpu))
+        return "recorded on a different CPU model";
+
+    std::vector<access> accesses;
+    std::vector<line_change> lines;
+    uint64_t cycle = 0;
+    bool ended = false;
+    while (!ended && !in.at_end() && !in.bad) {
+        const uint8_t tag = in.get8();
+        cycle += in.get_cycles();
+        switch (tag & 7) {
+            case fmt::READ_BYTE:
+            case fmt::WRITE_BYTE: {
+                const uint16_t port = in.get16();
+                accesses.push_back({ tag, port, in.get8() });
+                break;
+            }
+            case fmt::READ_WORD:
+            case fmt::WRITE_WORD: {
+                const uint16_t port = in.get16();
+                accesses.push_back({ tag, port, in.get16() });
+                break;
+            }
+            case fmt::LINE: {
+                line_change l;
+                l.cycle = cycle;
+                l.line = in.get8();
+                l.state = in.get8() ? ASSERT_LINE : CLEAR_LINE;
+                l.vector = in.get16();
+                lines.push_back(l);
+                break;
+            }
+            case fmt::END:
+                ended = true;
+                break;
+            default:
+                in.bad = true;
+                break;
+        }
+    }
+    if (in.bad)
+        return "corrupt recording";
+    if (!ended)
+        return "recording is truncated";
+
+    m_accesses.swap(accesses);
+    m_lines.swap(lines);
+    m_end_cycle = cycle;
+    start();
+    return nullptr;
+}
+
+uint16_t z8000_io_replayer::recorded_model(const char* path)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f)
+        return 0;
+    std::vector<uint8_t> header(8);
+    header.resize(fread(header.data(), 1, header.size(), f));
+    fclose(f);
+
+    record_reader in{header};
+    const uint32_t magic = in.get16() | (uint32_t(in.get16()) << 16);
+    in.get16();     // version
+    const uint16_t model = in.get16();
+    return (in.bad || magic != fmt::MAGIC) ? 0 : model;
+}
+
+void z8000_io_replayer::start()
+{
+    if (m_event)
+        m_cpu.cancel_event(m_event);
+    m_event = 0;
+    m_next = 0;
+    m_diverged = false;
+    m_divergence_cycle = 0;
+    schedule_line(0);
+}
+
+/* the line changes are chained, one CPU event at a time */
+void z8000_io_replayer::schedule_line(size_t index)
+{
+    m_event = 0;
+    if (index >= m_lines.size())
+        return;
+    m_event = m_cpu.schedule_event(m_lines[index].cycle, [this, index](uint64_t) {
+        const line_change& l = m_lines[index];
+        m_cpu.set_input_line(l.line, l.state, l.vector);
+        schedule_line(index + 1);
+    });
+}
+
+void z8000_io_replayer::diverge()
+{
+    if (!m_diverged) {
+        m_diverged = true;
+        m_divergence_cycle = m_cpu.get_cycles();
+    }
+    m_cpu.request_stop();
+}
+
+/* the next access is the one given; diverges if not */
+bool z8000_io_replayer::expect(uint8_t tag, uint16_t port, int mode)
+{
+    tag = io_tag(tag, mode);
+    if (!m_diverged && m_next < m_accesses.size()
+        && m_accesses[m_next].tag == tag && m_accesses[m_next].port == port)
+        return true;
+    diverge();
+    return false;
+}
+
+uint8_t z8000_io_replayer::read_byte(uint16_t port, int mode)
+{
+    return expect(fmt::READ_BYTE, port, mode) ? uint8_t(m_accesses[m_next++].value) : 0xff;
+}
+
+uint16_t z8000_io_replayer::read_word(uint16_t port, int mode)
+{
+    return expect(fmt::READ_WORD, port, mode) ? m_accesses[m_next++].value : 0xffff;
+}
+
+void z8000_io_replayer::write_byte(uint16_t port, uint8_t value, int mode)
+{
+    if (expect(fmt::WRITE_BYTE, port, mode)) {
+        if (m_accesses[m_next].value != value)
+            diverge();
+        else
+            m_next++;
+    }
+}
+
+void z8000_io_replayer::write_word(uint16_t port, uint16_t value, int mode)
+{
+    if (expect(fmt::WRITE_WORD, port, mode)) {
+        if (m_accesses[m_next].value != value)
+            diverge();
+        else
+            m_next++;
+    }
+}
+
+/* blocks are served whole when the recording has all their elements in a
+   row; otherwise element by element, to find where it departs */
+bool z8000_io_replayer::read_block(uint16_t port, int mode, uint16_t* data, uint32_t count, bool word)
+{
+    const uint8_t tag = io_tag(word ? fmt::READ_WORD : fmt::READ_BYTE, mode);
+    if (m_diverged || m_accesses.size() - m_next < count)
+        return false;
+    for (uint32_t i = 0; i < count; i++) {
+        const access& a = m_accesses[m_next + i];
+        if (a.tag != tag || a.port != port)
+            return false;
+        data[i] = a.value;
+    }
+    m_next += count;
+    return true;
+}
+
+bool z8000_io_replayer::write_block(uint16_t port, int mode, const uint16_t* data, uint32_t count, bool word)
+{
+    const uint8_t tag = io_tag(word ? fmt::WRITE_WORD : fmt::WRITE_BYTE, mode);
+    if (m_diverged || m_accesses.size() - m_next < count)
+        return false;
+    for (uint32_t i = 0; i < count; i++) {
+        const access& a = m_accesses[m_next + i];
+        if (a.tag != tag || a.port != port || a.value != data[i])
+            return false;
+    }
+    m_next += count;
+    return true;
+}
@@ -0,0 +1,39 @@
+// Z8000 device event scheduler
+
+#include "z8000/z8000_sched.h"
+
+#include <algorithm>
+
+uint64_t z8000_scheduler::add(uint64_t cycle, callback cb)
+{
+    const uint64_t id = m_next_id++;
+    m_heap.push_back({cycle, id, std::move(cb)});
+    std::push_heap(m_heap.begin(), m_heap.end(), later);
+    return id;
+}
+
+bool z8000_scheduler::cancel(uint64_t id)
+{
+    // A system has a handful of devices, so a linear scan is cheaper
+    // than keeping an index into the heap up to date
+    for (size_t i = 0; i < m_heap.size(); i++) {
+        if (m_heap[i].id != id)
+            continue;
+        m_heap[i] = std::move(m_heap.back());
+        m_heap.pop_back();
+        std::make_heap(m_heap.begin(), m_heap.end(), later);
+        return true;
+    }
+    return false;
+}
+
+void z8000_scheduler::fire(uint64_t now)
+{
+    while (!m_heap.empty() && m_heap.front().cycle <= now) {
+        // Off the heap before the call, which may schedule or cancel
+        std::pop_heap(m_heap.begin(), m_heap.end(), later);
+        event e = std::move(m_heap.back());
+        m_heap.pop_back();
+        e.cb(e.cycle);
+    }
+}
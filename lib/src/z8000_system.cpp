@@ -0,0 +1,330 @@
+// Z8000 multi-CPU system
+
+#include "z8000/z8000_system.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Barrier waits: pure spins, with a core to spare, then spins that
+// yield, then sleep
+constexpr unsigned SPINS = 2000;
+constexpr unsigned YIELDS = 20000;
+
+} // anonymous namespace
+
+z8000_system::z8000_system()
+    : m_quantum(QUANTUM), m_cycles(0), m_stop_req(false), m_threaded(false), m_spins(0),
+      m_target(0), m_go(0), m_done(0), m_sleeping(0), m_quit(false)
+{
+}
+
+z8000_system::~z8000_system()
+{
+    stop_threads();
+}
+
+unsigned z8000_system::add_cpu(z8002_device* cpu)
+{
+    stop_threads();
+    m_cpus.push_back({cpu, cpu->get_cycles() - m_cycles, stop_reason::budget});
+    return unsigned(m_cpus.size() - 1);
+}
+
+int z8000_system::add_window(uint32_t size)
+{
+    m_windows.emplace_back();
+    m_windows.back().image.assign(size, 0);
+    return int(m_windows.size() - 1);
+}
+
+void z8000_system::map_window(int id, unsigned cpu, z8000_memory_bus* bus, uint32_t base)
+{
+    window& w = m_windows[id];
+    if (w.maps.empty())
+        w.seed = bus;
+    w.maps.push_back({cpu, bus, base, {}});
+
+    // Stores are merged in CPU order
+    std::stable_sort(w.maps.begin(), w.maps.end(),
+                     [](const mapping& a, const mapping& b) { return a.cpu < b.cpu; });
+    w.primed = false;
+}
+
+void z8000_system::set_threads(bool enable)
+{
+    m_threaded = enable;
+    if (!enable)
+        stop_threads();
+}
+
+/**************************************************************************
+ * Running
+ **************************************************************************/
+
+z8000_system::run_result z8000_system::run_until(uint64_t target_cycle)
+{
+    run_result result{stop_reason::budget, -1, 0};
+    const uint64_t start = m_cycles;
+
+    m_stop_req = false;
+    sync();
+    if (m_threaded && m_threads.size() + 1 != m_cpus.size())
+        start_threads();
+
+    while (m_cycles < target_cycle) {
+        const uint64_t next = std::min(target_cycle, m_cycles + m_quantum);
+        run_quantum(next);
+        m_cycles = next;
+
+        for (window& w : m_windows)
+            reconcile(w);
+        if (m_sync)
+            m_sync(m_cycles);
+
+        for (unsigned n = 0; n < m_cpus.size() && result.cpu < 0; n++) {
+            const stop_reason r = m_cpus[n].reason;
+            if (r != stop_reason::budget && r != stop_reason::halt) {
+                result.reason = r;
+                result.cpu = int(n);
+            }
+        }
+        if (result.cpu >= 0)
+            break;
+        if (m_stop_req) {
+            result.reason = stop_reason::request;
+            break;
+        }
+        if (all_waiting()) {
+            result.reason = stop_reason::halt;
+            break;
+        }
+    }
+
+    result.cycles = m_cycles - start;
+    return result;
+}
+
+void z8000_system::run_cpu(unsigned n, uint64_t target)
+{
+    cpu_slot& s = m_cpus[n];
+    const uint64_t until = s.origin + target;
+
+    // A HALT waits out the quantum unless an event interrupts it
+    for (;;) {
+        s.reason = s.cpu->run_until(until).reason;
+        if (s.reason != stop_reason::halt)
+            break;
+        s.cpu->wait_until(until);
+        if (s.cpu->get_cycles() >= until)
+            break;
+    }
+}
+
+void z8000_system::run_quantum(uint64_t target)
+{
+    if (m_threads.empty()) {
+        for (unsigned n = 0; n < m_cpus.size(); n++)
+            run_cpu(n, target);
+        return;
+    }
+
+    // m_target and the CPUs' state are published by the m_go increment
+    // and handed back by the workers' m_done increments
+    m_target = target;
+    m_done.store(0, std::memory_order_relaxed);
+    m_go.fetch_add(1);
+    if (m_sleeping.load()) {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_wake.notify_all();
+    }
+
+    run_cpu(0, target);
+
+    const unsigned workers = unsigned(m_threads.size());
+    for (unsigned spins = 0; m_done.load(std::memory_order_acquire) != workers; spins++)
+        if (spins >= m_spins)
+            std::this_thread::yield();
+}
+
+// Nothing left that could end a HALT: no events and no interrupt
+bool z8000_system::all_waiting() const
+{
+    for (const cpu_slot& s : m_cpus)
+        if (!s.cpu->is_halted() || s.cpu->interrupt_pending()
+            || s.cpu->next_event() != z8000_scheduler::NEVER)
+            return false;
+    return true;
+}
+
+/**************************************************************************
+ * Worker threads
+ **************************************************************************/
+
+void z8000_system::start_threads()
+{
+    stop_threads();
+    m_quit = false;
+    m_spins = std::thread::hardware_concurrency() > 1 ? SPINS : 0;
+    const uint64_t go = m_go.load();
+    for (unsigned n = 1; n < m_cpus.size(); n++)
+        m_threads.emplace_back(&z8000_system::worker, this, n, go);
+}
+
+void z8000_system::stop_threads()
+{
+    if (m_threads.empty())
+        return;
+    m_quit = true;
+    m_go.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_wake.notify_all();
+    }
+    for (std::thread& t : m_threads)
+        t.join();
+    m_threads.clear();
+}
+
+// seen is m_go before the thread's first quantum
+void z8000_system::worker(unsigned n, uint64_t seen)
+{
+    for (;;) {
+        uint64_t go;
+        for (unsigned spins = 0; (go = m_go.load(std::memory_order_acquire)) == seen; spins++) {
+            if (spins < m_spins)
+                continue;
+            if (spins < YIELDS) {
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_sleeping++;
+            m_wake.wait(lock, [&] { return m_go.load() != seen; });
+            m_sleeping--;
+        }
+        seen = go;
+        if (m_quit)
+            return;
+
+        run_cpu(n, m_target);
+        m_done.fetch_add(1, std::memory_order_release);
+    }
+}
+
+/**************************************************************************
+ * Shared windows
+ *
+ * At each boundary every mapping is compared with the image of the
+ * window as of the previous boundary, all before any is changed.  The
+ * bytes that differ are the stores made this quantum; they are merged
+ * into the image in CPU order and copied to every mapping still holding
+ * another value, whose CPU drops its cached blocks there.
+ **************************************************************************/
+
+void z8000_system::sync()
+{
+    for (window& w : m_windows)
+        if (!w.primed)
+            prime(w);
+    for (window& w : m_windows)
+        reconcile(w);
+}
+
+uint8_t z8000_system::read(mapping& m, uint32_t offset)
+{
+    const uint32_t addr = m.base + offset;
+    const z8000_page_map* map = m.bus->page_map();
+    const uint8_t* page = map ? map->read[(addr >> Z8000_PAGE_SHIFT) & map->mask] : nullptr;
+    return page ? page[addr & (Z8000_PAGE_SIZE - 1)] : m.bus->read_byte(addr);
+}
+
+void z8000_system::write(mapping& m, uint32_t offset, uint8_t val)
+{
+    const uint32_t addr = m.base + offset;
+    const z8000_page_map* map = m.bus->page_map();
+    uint8_t* page = map ? map->write[(addr >> Z8000_PAGE_SHIFT) & map->mask] : nullptr;
+    if (page)
+        page[addr & (Z8000_PAGE_SIZE - 1)] = val;
+    else
+        m.bus->write_byte(addr, val);
+}
+
+void z8000_system::prime(window& w)
+{
+    w.primed = true;
+    const auto seed = std::find_if(w.maps.begin(), w.maps.end(),
+                                   [&](const mapping& m) { return m.bus == w.seed; });
+    if (seed == w.maps.end())
+        return;
+
+    const uint32_t size = uint32_t(w.image.size());
+    for (uint32_t i = 0; i < size; i++)
+        w.image[i] = read(*seed, i);
+    for (mapping& m : w.maps) {
+        uint32_t first = UINT32_MAX, last = 0;
+        for (uint32_t i = 0; i < size; i++) {
+            if (read(m, i) == w.image[i])
+                continue;
+            write(m, i, w.image[i]);
+            first = std::min(first, i);
+            last = i;
+        }
+        if (first <= last)
+            m_cpus[m.cpu].cpu->invalidate_code(m.base + first, last - first + 1);
+    }
+}
+
+void z8000_system::reconcile(window& w)
+{
+    const uint32_t size = uint32_t(w.image.size());
+
+    for (mapping& m : w.maps) {
+        m.changed.clear();
+        const z8000_page_map* map = m.bus->page_map();
+        for (uint32_t offset = 0; offset < size; ) {
+            const uint32_t addr = m.base + offset;
+            const uint32_t in_page = addr & (Z8000_PAGE_SIZE - 1);
+            const uint32_t len = std::min(size - offset, Z8000_PAGE_SIZE - in_page);
+            const uint8_t* page = map ? map->read[(addr >> Z8000_PAGE_SHIFT) & map->mask] : nullptr;
+            const uint8_t* image = &w.image[offset];
+            if (page) {
+                page += in_page;
+                if (memcmp(page, image, len))
+                    for (uint32_t i = 0; i < len; i++)
+                        if (page[i] != image[i])
+                            m.changed.push_back(offset + i);
+            } else {
+                for (uint32_t i = 0; i < len; i++)
+                    if (m.bus->read_byte(addr + i) != image[i])
+                        m.changed.push_back(offset + i);
+            }
+            offset += len;
+        }
+    }
+
+    for (mapping& m : w.maps)
+        for (uint32_t offset : m.changed) {
+            w.image[offset] = read(m, offset);
+            m_dirty.push_back(offset);
+        }
+    if (m_dirty.empty())
+        return;
+    std::sort(m_dirty.begin(), m_dirty.end());
+    m_dirty.erase(std::unique(m_dirty.begin(), m_dirty.end()), m_dirty.end());
+
+    for (mapping& m : w.maps) {
+        uint32_t first = UINT32_MAX, last = 0;
+        for (uint32_t offset : m_dirty) {
+            if (read(m, offset) == w.image[offset])
+                continue;
+            write(m, offset, w.image[offset]);
+            first = std::min(first, offset);
+            last = offset;
+        }
+        if (first <= last)
+            m_cpus[m.cpu].cpu->invalidate_code(m.base + first, last - first + 1);
+    }
+    m_dirty.clear();
+}
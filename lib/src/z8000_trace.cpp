@@ -0,0 +1,127 @@
+// Z8000 binary trace file writer
+
+#include "z8000/z8000_trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+z8000_trace_file::z8000_trace_file(size_t ring_size)
+    : m_head(0), m_tail(0), m_stop(false), m_file(nullptr)
+{
+    // Power of two so positions wrap with a mask
+    size_t size = 4096;
+    while (size < ring_size)
+        size <<= 1;
+    m_ring.resize(size);
+    m_ring_mask = size - 1;
+    m_chunk = size / 8;
+}
+
+z8000_trace_file::~z8000_trace_file()
+{
+    close();
+}
+
+bool z8000_trace_file::open(const char* path, uint16_t model)
+{
+    close();
+    m_file = fopen(path, "wb");
+    if (!m_file)
+        return false;
+
+    z8000_trace_header header = {};
+    header.magic = z8000_trace_header::MAGIC;
+    header.version = z8000_trace_header::VERSION;
+    header.byte_order = 0x0102;
+    header.model = model;
+    fwrite(&header, sizeof(header), 1, m_file);
+
+    m_head = 0;
+    m_tail = 0;
+    m_stop = false;
+    m_thread = std::thread(&z8000_trace_file::writer, this);
+    return true;
+}
+
+void z8000_trace_file::close()
+{
+    if (!m_file)
+        return;
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_stop = true;
+    }
+    m_data_ready.notify_one();
+    m_thread.join();
+    fclose(m_file);
+    m_file = nullptr;
+}
+
+void z8000_trace_file::write(const void* record, size_t size)
+{
+    if (!m_file)
+        return;
+
+    const uint64_t head = m_head.load(std::memory_order_relaxed);
+    if (head + size - m_tail.load(std::memory_order_acquire) > m_ring.size())
+        wait_for_space(size);
+
+    const size_t pos = head & m_ring_mask;
+    const size_t first = std::min(size, m_ring.size() - pos);
+    memcpy(&m_ring[pos], record, first);
+    memcpy(&m_ring[0], static_cast<const uint8_t*>(record) + first, size - first);
+    m_head.store(head + size, std::memory_order_release);
+
+    // Wake the writer once per chunk rather than per record
+    if ((head ^ (head + size)) & ~(m_chunk - 1)) {
+        { std::lock_guard<std::mutex> guard(m_lock); }
+        m_data_ready.notify_one();
+    }
+}
+
+void z8000_trace_file::wait_for_space(size_t size)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_data_ready.notify_one();
+    m_space_ready.wait(lock, [&] {
+        return m_head.load(std::memory_order_relaxed) + size
+               - m_tail.load(std::memory_order_acquire) <= m_ring.size();
+    });
+}
+
+void z8000_trace_file::writer()
+{
+    for (;;) {
+        bool stop;
+        {
+            // Time out now and then so a slow trace still reaches the disk
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_data_ready.wait_for(lock, std::chrono::milliseconds(100), [&] {
+                return m_stop || m_head.load(std::memory_order_acquire)
+                                 - m_tail.load(std::memory_order_relaxed) >= m_chunk;
+            });
+            stop = m_stop;
+        }
+
+        const uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        const uint64_t head = m_head.load(std::memory_order_acquire);
+        if (head != tail) {
+            const size_t pos = tail & m_ring_mask;
+            const size_t len = head - tail;
+            const size_t first = std::min(len, m_ring.size() - pos);
+            fwrite(&m_ring[pos], 1, first, m_file);
+            fwrite(&m_ring[0], 1, len - first, m_file);
+            {
+                std::lock_guard<std::mutex> guard(m_lock);
+                m_tail.store(head, std::memory_order_release);
+            }
+            m_space_ready.notify_one();
+        }
+
+        // The producer is done once m_stop is set, so this pass drained it
+        if (stop)
+            break;
+    }
+    fflush(m_file);
+}
@@ -4,14 +4,14 @@
  *
  *   8000dasm.c
  *   Portable Z8000(2) emulator
- *   Z8000 disassembler; requires the z8000_exec table to be initialized
+ *   Z8000 disassembler
  *
  *****************************************************************************/
 
 #include <z8000/emu.h>
 #include <z8000/z8000dasm.h>
 
-const z8000_disassembler::opcode z8000_disassembler::table[] = {
+constexpr z8000_disassembler::opcode z8000_disassembler::table[] = {
 	{ 0x0000, 0xffff,  1, 1, ".word   %#w0",                    0 },
 
 	{ 0x0000, 0x000f,  1, 2, "addb    %rb3,%#b3",               0 },
@@ -535,11 +535,19 @@ const z8000_disassembler::opcode z8000_disassembler::table[] = {
 	{ 0,      0,       0, 0, nullptr,                            0}
 };
 
-z8000_disassembler::z8000_disassembler(config *conf) : m_config(conf)
+constexpr std::array<u16, 0x10000> z8000_disassembler::make_oplist()
 {
+	std::array<u16, 0x10000> list{};
 	for (const opcode *opc = table; opc->size; opc++)
 		for (u32 val = opc->beg; val <= opc->end; val += opc->step)
-			oplist[val] = opc - table;
+			list[val] = opc - table;
+	return list;
+}
+
+constexpr std::array<u16, 0x10000> z8000_disassembler::oplist = make_oplist();
+
+z8000_disassembler::z8000_disassembler(config *conf) : m_config(conf)
+{
 }
 
 
@@ -575,7 +583,16 @@ u32 z8000_disassembler::opcode_alignment() const
 	return 2;
 }
 
-offs_t z8000_disassembler::disassemble(std::ostream &stream, offs_t pc, const data_buffer &opcodes, const data_buffer &)
+offs_t z8000_disassembler::disassemble(std::ostream &stream, offs_t pc, const data_buffer &opcodes, const data_buffer &params)
+{
+	char text[MAX_TEXT];
+	util::text_appender out(text, sizeof(text));
+	const offs_t result = disassemble(out, pc, opcodes, params);
+	stream << text;
+	return result;
+}
+
+offs_t z8000_disassembler::disassemble(util::text_appender &stream, offs_t pc, const data_buffer &opcodes, const data_buffer &)
 {
 	u8 n[16];   /* opcode nibbles */
 	u8 b[8];    /* opcode bytes */
@@ -1,12 +1,16 @@
 // Z8000 Standalone Emulator - Main Entry Point
 // Loads binary files and executes Z8001/Z8002 code with optional tracing
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <getopt.h>
+#include <memory>
+#include <vector>
 
 #include <z8000/z8000.h>
+#include <z8000/z8000_replay.h>
 
 #include "memory.h"
 
@@ -18,9 +22,31 @@ void print_usage(const char* progname) {
     printf("  -b, --base <addr>    Load address in hex (default: 0x0000)\n");
     printf("  -e, --entry <addr>   Override entry point (writes to reset vector at addr 4)\n");
     printf("  -t, --trace          Enable instruction tracing\n");
+    printf("  -T, --trace-file <f> Write the trace to file f in binary form (implies -t;\n");
+    printf("                       view it with z8000trace)\n");
     printf("  -r, --regtrace       Enable register tracing (dump after each instruction)\n");
     printf("  -m, --memtrace       Enable memory access tracing\n");
     printf("  -i, --iotrace        Enable I/O access tracing\n");
+    printf("  -P, --profile <f>    Write an execution profile to file f (JSON if f ends\n");
+    printf("                       in .json, CSV otherwise)\n");
+    printf("  --profile-sample <n> Sample the PC histogram every n instructions (default: 1)\n");
+    printf("  --memstats <f>       Count memory accesses by 256-byte page and space and\n");
+    printf("                       write them to file f (JSON if f ends in .json, CSV\n");
+    printf("                       otherwise)\n");
+    printf("  --working-set <f>    Write a working-set summary to file f every period\n");
+    printf("  --working-set-period <n>  Cycles per summary (default: 1000000)\n");
+    printf("  -B, --blocks         Execute through the pre-decoded block cache\n");
+    printf("  --idle-skip          Skip the cycles the guest spends waiting in jumps to\n");
+    printf("                       themselves, DJNZ countdowns and polling loops\n");
+    printf("  --break <addr>       Stop before executing the instruction at addr (hex,\n");
+    printf("                       segment in bits 22..16 on the Z8001); repeatable\n");
+    printf("  --watch <range>      Stop after an access to memory in range: first[-last]\n");
+    printf("                       in hex, with :r or :w for reads or writes only\n");
+    printf("  --watch-io <range>   The same for I/O ports (IN/OUT; use s:range for\n");
+    printf("                       SIN/SOUT)\n");
+    printf("  --record <f>         Log all I/O to file f for --replay\n");
+    printf("  --replay <f>         Feed the I/O logged in file f back instead of using\n");
+    printf("                       the console and ports\n");
     printf("  -c, --cycles <n>     Max cycles to execute (default: unlimited)\n");
     printf("  -d, --dump           Dump memory after execution\n");
     printf("  -h, --help           Show this help\n");
@@ -49,6 +75,37 @@ uint32_t parse_hex(const char* str) {
     return val;
 }
 
+// Watchpoint argument: [s:]first[-last][:r|:w]
+struct watch_arg {
+    int space = 0;
+    uint32_t first = 0, last = 0;
+    unsigned access = z8000_debug_hit::READ | z8000_debug_hit::WRITE;
+};
+
+bool parse_watch(const char* str, watch_arg& w) {
+    if (str[0] == 's' && str[1] == ':') {
+        w.space = 1;
+        str += 2;
+    }
+    char* end;
+    w.first = w.last = strtoul(str, &end, 16);
+    if (end == str)
+        return false;
+    if (*end == '-') {
+        str = end + 1;
+        w.last = strtoul(str, &end, 16);
+        if (end == str)
+            return false;
+    }
+    if (strcmp(end, ":r") == 0)
+        w.access = z8000_debug_hit::READ;
+    else if (strcmp(end, ":w") == 0)
+        w.access = z8000_debug_hit::WRITE;
+    else if (*end)
+        return false;
+    return true;
+}
+
 int main(int argc, char* argv[]) {
     uint32_t base_addr = 0x0000;
     uint32_t entry_addr = 0x0000;
@@ -58,18 +115,43 @@ int main(int argc, char* argv[]) {
     bool reg_trace = false;
     bool mem_trace = false;
     bool io_trace = false;
+    const char* trace_file = nullptr;
+    const char* profile_file = nullptr;
+    unsigned profile_period = 1;
+    const char* memstats_file = nullptr;
+    const char* working_set_file = nullptr;
+    uint64_t working_set_period = 1000000;
+    bool block_cache = false;
+    bool idle_skip = false;
     bool dump_mem = false;
     int max_cycles = -1;
     const char* filename = nullptr;
+    std::vector<uint32_t> breakpoints;
+    std::vector<watch_arg> watches, io_watches;
+    const char* record_file = nullptr;
+    const char* replay_file = nullptr;
 
     static struct option long_options[] = {
         {"segmented",    no_argument,       0, 's'},
         {"base",         required_argument, 0, 'b'},
         {"entry",        required_argument, 0, 'e'},
         {"trace",        no_argument,       0, 't'},
+        {"trace-file",   required_argument, 0, 'T'},
         {"regtrace",     no_argument,       0, 'r'},
         {"memtrace",     no_argument,       0, 'm'},
         {"iotrace",      no_argument,       0, 'i'},
+        {"profile",      required_argument, 0, 'P'},
+        {"profile-sample", required_argument, 0, 'S'},
+        {"memstats",     required_argument, 0, 'M'},
+        {"working-set",  required_argument, 0, 'G'},
+        {"working-set-period", required_argument, 0, 'N'},
+        {"blocks",       no_argument,       0, 'B'},
+        {"idle-skip",    no_argument,       0, 'I'},
+        {"break",        required_argument, 0, 'K'},
+        {"watch",        required_argument, 0, 'W'},
+        {"watch-io",     required_argument, 0, 'O'},
+        {"record",       required_argument, 0, 'R'},
+        {"replay",       required_argument, 0, 'Y'},
         {"cycles",       required_argument, 0, 'c'},
         {"dump",         no_argument,       0, 'd'},
         {"help",         no_argument,       0, 'h'},
@@ -77,7 +159,7 @@ int main(int argc, char* argv[]) {
     };
 
     int opt;
-    while ((opt = getopt_long(argc, argv, "sb:e:trmic:dh", long_options, nullptr)) != -1) {
+    while ((opt = getopt_long(argc, argv, "sb:e:tT:rmiP:Bc:dh", long_options, nullptr)) != -1) {
         switch (opt) {
             case 's':
                 segmented = true;
@@ -92,6 +174,10 @@ int main(int argc, char* argv[]) {
             case 't':
                 trace = true;
                 break;
+            case 'T':
+                trace = true;
+                trace_file = optarg;
+                break;
             case 'r':
                 reg_trace = true;
                 break;
@@ -101,6 +187,46 @@ int main(int argc, char* argv[]) {
             case 'i':
                 io_trace = true;
                 break;
+            case 'P':
+                profile_file = optarg;
+                break;
+            case 'S':
+                profile_period = atoi(optarg);
+                break;
+            case 'M':
+                memstats_file = optarg;
+                break;
+            case 'G':
+                working_set_file = optarg;
+                break;
+            case 'N':
+                working_set_period = strtoull(optarg, nullptr, 0);
+                break;
+            case 'B':
+                block_cache = true;
+                break;
+            case 'I':
+                idle_skip = true;
+                break;
+            case 'K':
+                breakpoints.push_back(parse_hex(optarg));
+                break;
+            case 'W':
+            case 'O': {
+                watch_arg w;
+                if (!parse_watch(optarg, w) || (opt == 'W' && w.space)) {
+                    fprintf(stderr, "Error: Bad watch range '%s'\n", optarg);
+                    return 1;
+                }
+                (opt == 'W' ? watches : io_watches).push_back(w);
+                break;
+            }
+            case 'R':
+                record_file = optarg;
+                break;
+            case 'Y':
+                replay_file = optarg;
+                break;
             case 'c':
                 max_cycles = atoi(optarg);
                 break;
@@ -132,40 +258,6 @@ int main(int argc, char* argv[]) {
     // Z8001 has 23-bit (8MB) address space, Z8002 has 16-bit (64KB)
     size_t mem_size = segmented ? 0x800000 : 0x10000;
 
-    // Load binary file
-    FILE* f = fopen(filename, "rb");
-    if (!f) {
-        fprintf(stderr, "Error: Cannot open file '%s'\n", filename);
-        return 1;
-    }
-
-    fseek(f, 0, SEEK_END);
-    long filesize = ftell(f);
-    fseek(f, 0, SEEK_SET);
-
-    if ((size_t)filesize > mem_size - base_addr) {
-        fprintf(stderr, "Error: File too large (%ld bytes) for load address 0x%04X\n",
-                filesize, base_addr);
-        fclose(f);
-        return 1;
-    }
-
-    uint8_t* buffer = new uint8_t[filesize];
-    size_t bytes_read = fread(buffer, 1, filesize, f);
-    fclose(f);
-
-    if (bytes_read != (size_t)filesize) {
-        fprintf(stderr, "Error: Could not read entire file\n");
-        delete[] buffer;
-        return 1;
-    }
-
-    printf("Z8000 Standalone Emulator\n");
-    printf("=========================\n");
-    printf("CPU: %s\n", segmented ? "Z8001 (segmented)" : "Z8002 (non-segmented)");
-    printf("Loaded: %s (%ld bytes)\n", filename, filesize);
-    printf("Base address: 0x%04X\n", base_addr);
-
     // Create memory region (shared for program, data, stack)
     MemoryRegion memory(mem_size);
     memory.set_name("MEM");
@@ -175,26 +267,99 @@ int main(int argc, char* argv[]) {
     IOPorts io;
     io.set_trace(io_trace);
 
-    // Load binary into memory
-    if (!memory.load(base_addr, buffer, filesize)) {
-        delete[] buffer;
+    // Load binary into memory (mapped from the file where possible)
+    size_t filesize = 0;
+    if (const char* error = memory.load_file(base_addr, filename, filesize)) {
+        fprintf(stderr, "Error: '%s': %s (load address 0x%04X)\n", filename, error, base_addr);
         return 1;
     }
-    delete[] buffer;
+
+    printf("Z8000 Standalone Emulator\n");
+    printf("=========================\n");
+    printf("CPU: %s\n", segmented ? "Z8001 (segmented)" : "Z8002 (non-segmented)");
+    printf("Loaded: %s (%zu bytes)\n", filename, filesize);
+    printf("Base address: 0x%04X\n", base_addr);
 
     // Create CPU (Z8001 or Z8002)
-    z8001_device cpu_seg;
-    z8002_device cpu_nonseg;
-    z8002_device& cpu = segmented ? static_cast<z8002_device&>(cpu_seg) : cpu_nonseg;
+    std::unique_ptr<z8002_device> cpu_ptr(segmented ? new z8001_device() : new z8002_device());
+    z8002_device& cpu = *cpu_ptr;
 
     // Set all memory spaces to same region
     cpu.set_memory(&memory);
     cpu.set_io(&io);
+
+    // I/O recording goes between the CPU and the ports; a replay
+    // replaces them
+    z8000_io_recorder recorder(cpu, io);
+    if (record_file) {
+        if (!recorder.open(record_file)) {
+            fprintf(stderr, "Error: Cannot create recording '%s'\n", record_file);
+            return 1;
+        }
+        cpu.set_io(&recorder);
+    }
+    z8000_io_replayer replayer(cpu);
+    if (replay_file) {
+        if (const char* error = replayer.open(replay_file)) {
+            fprintf(stderr, "Error: '%s': %s\n", replay_file, error);
+            return 1;
+        }
+        cpu.set_io(&replayer);
+    }
     cpu.set_trace(trace);
     cpu.set_reg_trace(reg_trace);
+    cpu.set_block_cache(block_cache);
+    cpu.set_idle_skip(idle_skip ? z8002_device::IDLE_ALL : 0);
+    for (uint32_t pc : breakpoints)
+        cpu.add_breakpoint(pc);
+    for (const watch_arg& w : watches)
+        cpu.add_watchpoint(w.first, w.last, w.access);
+    for (const watch_arg& w : io_watches)
+        cpu.add_io_watchpoint(w.space, w.first, w.last, w.access);
+
+    // Binary trace: instructions, registers and bus accesses all go to the file
+    z8000_trace_file trace_sink;
+    if (trace_file) {
+        if (!trace_sink.open(trace_file, segmented ? 8001 : 8002)) {
+            fprintf(stderr, "Error: Cannot create trace file '%s'\n", trace_file);
+            return 1;
+        }
+        cpu.set_trace_sink(&trace_sink);
+        memory.set_trace_sink(&trace_sink);
+        io.set_trace_sink(&trace_sink);
+    }
+
+    // Opened up front so a bad path fails before a long run
+    FILE* profile_out = nullptr;
+    if (profile_file) {
+        if (!(profile_out = fopen(profile_file, "w"))) {
+            fprintf(stderr, "Error: Cannot create profile '%s'\n", profile_file);
+            return 1;
+        }
+        cpu.set_profile(z8000_profile::ALL, profile_period);
+    }
+
+    // Memory statistics count between the CPU and the memory
+    z8000_memory_stats memstats(mem_size);
+    FILE* memstats_out = nullptr;
+    FILE* working_set_out = nullptr;
+    if (memstats_file && !(memstats_out = fopen(memstats_file, "w"))) {
+        fprintf(stderr, "Error: Cannot create memory statistics '%s'\n", memstats_file);
+        return 1;
+    }
+    if (working_set_file) {
+        if (!(working_set_out = fopen(working_set_file, "w"))) {
+            fprintf(stderr, "Error: Cannot create working-set summary '%s'\n", working_set_file);
+            return 1;
+        }
+    }
+    if (memstats_out || working_set_out)
+        cpu.set_memory_stats(&memstats);
 
     // Reset CPU
     cpu.reset();
+    if (replay_file)
+        replayer.start();
 
     // Show reset vector from memory
     if (entry_set) {
@@ -237,19 +402,63 @@ int main(int argc, char* argv[]) {
         printf("---\n");
     }
 
-    // Run CPU
-    cpu.run(max_cycles);
+    // Run CPU, in slices of the working-set period if summaries are wanted
+    if (working_set_out) {
+        const char* ext = strrchr(working_set_file, '.');
+        const bool json = ext && strcmp(ext, ".json") == 0;
+        const uint64_t end = max_cycles < 0 ? UINT64_MAX : cpu.get_cycles() + max_cycles;
+        const uint64_t period = std::max<uint64_t>(working_set_period, 1);
+        z8002_device::run_result result;
+        do {
+            result = cpu.run_until(std::min(end, cpu.get_cycles() + period));
+            memstats.write_interval(working_set_out, cpu.get_cycles(), json);
+        } while (result.reason == z8002_device::stop_reason::budget && cpu.get_cycles() < end);
+        fclose(working_set_out);
+    } else {
+        cpu.run(max_cycles);
+    }
 
     if (trace) {
         printf("---\n");
     }
+    trace_sink.close();
+    recorder.close();
+
+    if (replay_file && replayer.diverged()) {
+        printf("\nReplay diverged from the recording at cycle %llu, after %zu accesses\n",
+               (unsigned long long)replayer.divergence_cycle(), replayer.accesses_replayed());
+    }
+
+    const z8000_debug_hit& hit = cpu.get_debug_hit();
+    if (hit.kind == z8000_debug_hit::BREAKPOINT) {
+        printf("\nBreakpoint %d at 0x%04X\n", hit.id, hit.pc);
+    } else if (hit.kind != z8000_debug_hit::NONE) {
+        printf("\nWatchpoint %d: %s %s 0x%04X (value 0x%04X) at PC 0x%04X\n", hit.id,
+               hit.access == z8000_debug_hit::READ ? "read" : "write",
+               hit.kind == z8000_debug_hit::IO ? (hit.space ? "special port" : "port") : "address",
+               hit.addr, hit.value, hit.pc);
+    }
+
+    if (profile_out) {
+        const char* ext = strrchr(profile_file, '.');
+        cpu.write_profile(profile_out, ext && strcmp(ext, ".json") == 0);
+        fclose(profile_out);
+    }
+
+    if (memstats_out) {
+        const char* ext = strrchr(memstats_file, '.');
+        memstats.write_report(memstats_out, ext && strcmp(ext, ".json") == 0);
+        fclose(memstats_out);
+    }
 
     // Print final state (always show so test scripts can parse results)
     printf("\n");
     cpu.dump_regs();
 
     // Print summary
-    printf("\nTotal cycles: %d\n", cpu.get_cycles());
+    printf("\nTotal cycles: %llu\n", (unsigned long long)cpu.get_cycles());
+    if (idle_skip)
+        printf("Idle cycles skipped: %llu\n", (unsigned long long)cpu.get_idle_cycles());
     printf("Halted: %s\n", cpu.is_halted() ? "Yes" : "No");
 
     // Optional memory dump
@@ -8,27 +8,67 @@
 #include <cstdio>
 #include <cstring>
 #include <cstdlib>
+#include <algorithm>
+#include <new>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <z8000/emu.h>
 #include <z8000/z8000_intf.h>
+#include <z8000/z8000_iomap.h>
+#include <z8000/z8000_trace.h>
 
-// Flat-array memory region implementing z8000_memory_bus
+// Flat-array memory region implementing z8000_memory_bus.
+// Publishes a page map so the CPU reads and writes the array directly;
+// the map is emptied while memory tracing is on so every access is seen.
+//
+// The array is an anonymous private mapping, so untouched pages cost
+// nothing and clear() hands back fresh zero pages instead of a memset.
+//
+// snapshot() takes a copy-on-write snapshot: every page is write-protected
+// in the page map, and the first store to a page goes through write_*(),
+// which saves the page's snapshot contents before unprotecting it.
+// restore() copies back only the pages written since the snapshot (or the
+// previous restore), so rolling back is proportional to what the guest
+// touched.  Stores through data() bypass this tracking.
 class MemoryRegion : public z8000_memory_bus {
 public:
-    MemoryRegion(size_t size = 0x10000) : m_size(size), m_trace(false), m_name("mem") {
-        m_data = new u8[m_size];
-        clear();
+    MemoryRegion(size_t size = 0x10000) : m_size(size), m_trace(false), m_trace_sink(nullptr),
+                                          m_name("mem"), m_snap(nullptr) {
+        void* p = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+            throw std::bad_alloc();
+        m_data = static_cast<u8*>(p);
+        m_pages.resize(m_size >= Z8000_PAGE_SIZE ? m_size >> Z8000_PAGE_SHIFT : 0);
+        m_write_pages.resize(m_pages.size());
+        m_page_map.read = m_pages.data();
+        m_page_map.write = m_write_pages.data();
+        m_page_map.mask = m_pages.empty() ? 0 : m_pages.size() - 1;
+        update_pages();
     }
 
     ~MemoryRegion() {
-        delete[] m_data;
+        delete[] m_snap;
+        munmap(m_data, m_size);
     }
 
+    // Zero the whole region.  Any snapshot is dropped rather than first
+    // given a copy of every page it has not saved yet.
     void clear() {
-        memset(m_data, 0, m_size);
+        if (m_snap)
+            drop_snapshot();
+        if (mmap(m_data, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED,
+                 -1, 0) == MAP_FAILED)
+            memset(m_data, 0, m_size);
     }
 
-    void set_trace(bool enable) { m_trace = enable; }
+    void set_trace(bool enable) { m_trace = enable; update_pages(); }
+    // Traced accesses go to sink as binary records instead of stdout
+    void set_trace_sink(z8000_trace_sink* sink) { m_trace_sink = sink; }
     void set_name(const char* name) { m_name = name; }
 
     size_t size() const { return m_size; }
@@ -40,16 +80,92 @@ public:
                     addr, len, m_size);
             return false;
         }
+        touch_range(addr, len);
         memcpy(&m_data[addr], data, len);
         return true;
     }
 
+    // Load a binary file at addr; returns nullptr or an error message.
+    // The file is read in rather than mapped: a private mapping would
+    // raise SIGBUS if the file were truncated while in use, and let later
+    // changes to the file show through in pages the guest has not written.
+    const char* load_file(u32 addr, const char* path, size_t& len) {
+        int fd = open(path, O_RDONLY);
+        if (fd < 0)
+            return "cannot open file";
+        struct stat st;
+        if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+            close(fd);
+            return "not a regular file";
+        }
+        len = st.st_size;
+        if (addr > m_size || len > m_size - addr) {
+            close(fd);
+            return "file too large for load address";
+        }
+
+        touch_range(addr, len);
+        size_t done = 0;
+        while (done < len) {
+            ssize_t n = pread(fd, &m_data[addr + done], len - done, done);
+            if (n <= 0) {
+                close(fd);
+                return "could not read entire file";
+            }
+            done += n;
+        }
+        close(fd);
+        return nullptr;
+    }
+
+    // Copy-on-write snapshot of the current contents (replaces any
+    // previous snapshot)
+    void snapshot() {
+        if (!m_snap) {
+            m_snap = new u8[m_size];
+            m_page_state.resize(snap_pages());
+        }
+        std::fill(m_page_state.begin(), m_page_state.end(), 0);
+        m_dirty.clear();
+        update_pages();
+    }
+
+    // Roll memory back to the snapshot; the snapshot stays in place
+    void restore() {
+        if (!m_snap)
+            return;
+        for (u32 page : m_dirty) {
+            size_t offset = size_t(page) << Z8000_PAGE_SHIFT;
+            memcpy(&m_data[offset], &m_snap[offset], std::min<size_t>(Z8000_PAGE_SIZE, m_size - offset));
+            m_page_state[page] &= ~PAGE_DIRTY;
+            if (page < m_write_pages.size())
+                m_write_pages[page] = nullptr;
+        }
+        m_dirty.clear();
+    }
+
+    void drop_snapshot() {
+        delete[] m_snap;
+        m_snap = nullptr;
+        m_page_state.clear();
+        m_dirty.clear();
+        update_pages();
+    }
+
+    bool has_snapshot() const { return m_snap != nullptr; }
+
+    // Pages written since the snapshot or the last restore()
+    size_t dirty_pages() const { return m_dirty.size(); }
+
     // z8000_memory_bus interface
     u8 read_byte(u32 addr) override {
         addr &= (m_size - 1);
         u8 val = m_data[addr];
         if (m_trace) {
-            printf("  %s RD8  [%04X] -> %02X\n", m_name, addr, val);
+            if (m_trace_sink)
+                m_trace_sink->mem_access(0, addr, val);
+            else
+                printf("  %s RD8  [%04X] -> %02X\n", m_name, addr, val);
         }
         return val;
     }
@@ -58,7 +174,10 @@ public:
         addr &= (m_size - 1) & ~1;  // Word aligned
         u16 val = (static_cast<u16>(m_data[addr]) << 8) | m_data[addr + 1];
         if (m_trace) {
-            printf("  %s RD16 [%04X] -> %04X\n", m_name, addr, val);
+            if (m_trace_sink)
+                m_trace_sink->mem_access(Z8000_TRACE_WORD, addr, val);
+            else
+                printf("  %s RD16 [%04X] -> %04X\n", m_name, addr, val);
         }
         return val;
     }
@@ -66,16 +185,24 @@ public:
     void write_byte(u32 addr, u8 val) override {
         addr &= (m_size - 1);
         if (m_trace) {
-            printf("  %s WR8  [%04X] <- %02X\n", m_name, addr, val);
+            if (m_trace_sink)
+                m_trace_sink->mem_access(Z8000_TRACE_WRITE, addr, val);
+            else
+                printf("  %s WR8  [%04X] <- %02X\n", m_name, addr, val);
         }
+        touch(addr);
         m_data[addr] = val;
     }
 
     void write_word(u32 addr, u16 val) override {
         addr &= (m_size - 1) & ~1;  // Word aligned
         if (m_trace) {
-            printf("  %s WR16 [%04X] <- %04X\n", m_name, addr, val);
+            if (m_trace_sink)
+                m_trace_sink->mem_access(Z8000_TRACE_WRITE | Z8000_TRACE_WORD, addr, val);
+            else
+                printf("  %s WR16 [%04X] <- %04X\n", m_name, addr, val);
         }
+        touch(addr);
         m_data[addr] = (val >> 8) & 0xFF;
         m_data[addr + 1] = val & 0xFF;
     }
@@ -85,12 +212,20 @@ public:
         u16 existing = read_word(addr);
         u16 new_val = (existing & ~mask) | (val & mask);
         if (m_trace) {
-            printf("  %s WR16 [%04X] <- %04X (mask %04X)\n", m_name, addr, new_val, mask);
+            if (m_trace_sink)
+                m_trace_sink->mem_access(Z8000_TRACE_WRITE | Z8000_TRACE_WORD, addr, new_val, mask);
+            else
+                printf("  %s WR16 [%04X] <- %04X (mask %04X)\n", m_name, addr, new_val, mask);
         }
+        touch(addr);
         m_data[addr] = (new_val >> 8) & 0xFF;
         m_data[addr + 1] = new_val & 0xFF;
     }
 
+    const z8000_page_map* page_map() override {
+        return m_pages.empty() ? nullptr : &m_page_map;
+    }
+
     // Get raw pointer (for debugging/display)
     const u8* data() const { return m_data; }
     u8* data() { return m_data; }
@@ -107,10 +242,56 @@ public:
     }
 
 private:
+    static constexpr u8 PAGE_SAVED = 0x01;   // snapshot copy of the page is in m_snap
+    static constexpr u8 PAGE_DIRTY = 0x02;   // written since snapshot()/restore()
+
+    size_t snap_pages() const { return (m_size + Z8000_PAGE_SIZE - 1) >> Z8000_PAGE_SHIFT; }
+
+    bool write_protected(size_t page) const {
+        return m_snap && !(m_page_state[page] & PAGE_DIRTY);
+    }
+
+    void update_pages() {
+        for (size_t i = 0; i < m_pages.size(); i++) {
+            m_pages[i] = m_trace ? nullptr : &m_data[i << Z8000_PAGE_SHIFT];
+            m_write_pages[i] = write_protected(i) ? nullptr : m_pages[i];
+        }
+    }
+
+    void touch_range(u32 addr, size_t len) {
+        if (!m_snap || !len)
+            return;
+        for (size_t page = addr >> Z8000_PAGE_SHIFT; page <= (addr + len - 1) >> Z8000_PAGE_SHIFT; page++)
+            touch(page << Z8000_PAGE_SHIFT);
+    }
+
+    // First store to a page since snapshot()/restore(): save its snapshot
+    // contents if not done yet, then let the CPU write it directly again
+    void touch(u32 addr) {
+        size_t page = addr >> Z8000_PAGE_SHIFT;
+        if (!write_protected(page))
+            return;
+        size_t offset = page << Z8000_PAGE_SHIFT;
+        if (!(m_page_state[page] & PAGE_SAVED))
+            memcpy(&m_snap[offset], &m_data[offset], std::min<size_t>(Z8000_PAGE_SIZE, m_size - offset));
+        m_page_state[page] |= PAGE_SAVED | PAGE_DIRTY;
+        m_dirty.push_back(page);
+        if (page < m_pages.size())
+            m_write_pages[page] = m_pages[page];
+    }
+
     u8* m_data;
     size_t m_size;
     bool m_trace;
+    z8000_trace_sink* m_trace_sink;
     const char* m_name;
+    std::vector<u8*> m_pages;
+    std::vector<u8*> m_write_pages;
+    z8000_page_map m_page_map;
+
+    u8* m_snap;                     // snapshot contents, valid for PAGE_SAVED pages
+    std::vector<u8> m_page_state;   // PAGE_* flags
+    std::vector<u32> m_dirty;       // pages to copy back on restore()
 };
 
 // I/O Ports - mock I/O space for testing
@@ -129,123 +310,91 @@ private:
 //     - 0x0020-0x0021: sio_data_reg (initial: 0x5678)
 //   Other ports: Returns 0xBEEF (word) or 0xBE (byte)
 //
-class IOPorts : public z8000_io_bus {
+class IOPorts : public z8000_io_map {
 public:
-    IOPorts() : m_trace(false) {
+    IOPorts() : m_trace(false), m_trace_sink(nullptr) {
+        map_registers(NORMAL, 0x0000, 0x0003, m_io_regs);
+        map_registers(SPECIAL, 0x0020, 0x0021, m_sio_regs);
+        handler fixed;
+        fixed.read_byte = [](u16 addr) -> u8 { return (addr & 1) ? 0x55 : 0xAA; };
+        fixed.read_word = [](u16) -> u16 { return 0xAA00; };   // Fixed value for block I/O tests
+        map(NORMAL, 0x0010, 0x0011, fixed);
+        set_unmapped(NORMAL, 0xDE, 0xDEAD);
+        set_unmapped(SPECIAL, 0xBE, 0xBEEF);
         clear();
     }
 
     void clear() {
         // Initialize loopback registers with distinct values
-        m_io_data_reg = 0x1234;
-        m_io_ctrl_reg = 0x0000;
-        m_sio_data_reg = 0x5678;
+        z8000_io_map::write_word(0x0000, 0x1234, NORMAL);   // io_data_reg
+        z8000_io_map::write_word(0x0002, 0x0000, NORMAL);   // io_ctrl_reg
+        z8000_io_map::write_word(0x0020, 0x5678, SPECIAL);  // sio_data_reg
     }
 
     void set_trace(bool enable) { m_trace = enable; }
+    // Traced accesses go to sink as binary records instead of stdout
+    void set_trace_sink(z8000_trace_sink* sink) { m_trace_sink = sink; }
 
     // z8000_io_bus interface (mode: 0=normal, 1=special)
     u8 read_byte(u16 addr, int mode) override {
-        u8 val;
-        if (mode == 0) {
-            // Normal I/O space
-            switch (addr & 0xFFFE) {
-                case 0x0000: val = (addr & 1) ? (m_io_data_reg & 0xFF) : (m_io_data_reg >> 8); break;
-                case 0x0002: val = (addr & 1) ? (m_io_ctrl_reg & 0xFF) : (m_io_ctrl_reg >> 8); break;
-                case 0x0010: val = (addr & 1) ? 0x55 : 0xAA; break;  // 0x10=0xAA, 0x11=0x55
-                default: val = 0xDE; break;      // Undefined port
-            }
-        } else {
-            // Special I/O space
-            switch (addr & 0xFFFE) {
-                case 0x0020: val = (addr & 1) ? (m_sio_data_reg & 0xFF) : (m_sio_data_reg >> 8); break;
-                default: val = 0xBE; break;      // Undefined special port
-            }
-        }
+        u8 val = z8000_io_map::read_byte(addr, mode);
         if (m_trace) {
-            printf("  %sI/O RD8  [%04X] -> %02X\n", mode ? "S" : "", addr, val);
+            if (m_trace_sink)
+                m_trace_sink->io_access(mode ? Z8000_TRACE_SPECIAL : 0, addr, val);
+            else
+                printf("  %sI/O RD8  [%04X] -> %02X\n", mode ? "S" : "", addr, val);
         }
         return val;
     }
 
     u16 read_word(u16 addr, int mode) override {
         addr &= 0xFFFE;
-        u16 val;
-        if (mode == 0) {
-            // Normal I/O space
-            switch (addr) {
-                case 0x0000: val = m_io_data_reg; break;
-                case 0x0002: val = m_io_ctrl_reg; break;
-                case 0x0010: val = 0xAA00; break;  // Fixed value for block I/O tests
-                default: val = 0xDEAD; break;      // Undefined port
-            }
-        } else {
-            // Special I/O space
-            switch (addr) {
-                case 0x0020: val = m_sio_data_reg; break;
-                default: val = 0xBEEF; break;      // Undefined special port
-            }
-        }
+        u16 val = z8000_io_map::read_word(addr, mode);
         if (m_trace) {
-            printf("  %sI/O RD16 [%04X] -> %04X\n", mode ? "S" : "", addr, val);
+            if (m_trace_sink)
+                m_trace_sink->io_access((mode ? Z8000_TRACE_SPECIAL : 0) | Z8000_TRACE_WORD, addr, val);
+            else
+                printf("  %sI/O RD16 [%04X] -> %04X\n", mode ? "S" : "", addr, val);
         }
         return val;
     }
 
     void write_byte(u16 addr, u8 val, int mode) override {
         if (m_trace) {
-            printf("  %sI/O WR8  [%04X] <- %02X\n", mode ? "S" : "", addr, val);
-        }
-        if (mode == 0) {
-            // Normal I/O space
-            switch (addr & 0xFFFE) {
-                case 0x0000:
-                    if (addr & 1) m_io_data_reg = (m_io_data_reg & 0xFF00) | val;
-                    else m_io_data_reg = (m_io_data_reg & 0x00FF) | (val << 8);
-                    break;
-                case 0x0002:
-                    if (addr & 1) m_io_ctrl_reg = (m_io_ctrl_reg & 0xFF00) | val;
-                    else m_io_ctrl_reg = (m_io_ctrl_reg & 0x00FF) | (val << 8);
-                    break;
-                // Fixed ports and undefined ports ignore writes
-            }
-        } else {
-            // Special I/O space
-            switch (addr & 0xFFFE) {
-                case 0x0020:
-                    if (addr & 1) m_sio_data_reg = (m_sio_data_reg & 0xFF00) | val;
-                    else m_sio_data_reg = (m_sio_data_reg & 0x00FF) | (val << 8);
-                    break;
-            }
+            if (m_trace_sink)
+                m_trace_sink->io_access((mode ? Z8000_TRACE_SPECIAL : 0) | Z8000_TRACE_WRITE, addr, val);
+            else
+                printf("  %sI/O WR8  [%04X] <- %02X\n", mode ? "S" : "", addr, val);
         }
+        // Fixed ports and undefined ports ignore writes
+        z8000_io_map::write_byte(addr, val, mode);
     }
 
     void write_word(u16 addr, u16 val, int mode) override {
         addr &= 0xFFFE;
         if (m_trace) {
-            printf("  %sI/O WR16 [%04X] <- %04X\n", mode ? "S" : "", addr, val);
-        }
-        if (mode == 0) {
-            // Normal I/O space
-            switch (addr) {
-                case 0x0000: m_io_data_reg = val; break;
-                case 0x0002: m_io_ctrl_reg = val; break;
-                // Fixed ports and undefined ports ignore writes
-            }
-        } else {
-            // Special I/O space
-            switch (addr) {
-                case 0x0020: m_sio_data_reg = val; break;
-            }
+            if (m_trace_sink)
+                m_trace_sink->io_access((mode ? Z8000_TRACE_SPECIAL : 0) | Z8000_TRACE_WRITE | Z8000_TRACE_WORD, addr, val);
+            else
+                printf("  %sI/O WR16 [%04X] <- %04X\n", mode ? "S" : "", addr, val);
         }
+        z8000_io_map::write_word(addr, val, mode);
+    }
+
+    // Traced accesses are printed one by one
+    bool read_block(u16 addr, int mode, u16* data, u32 count, bool word) override {
+        return !m_trace && z8000_io_map::read_block(addr, mode, data, count, word);
+    }
+    bool write_block(u16 addr, int mode, const u16* data, u32 count, bool word) override {
+        return !m_trace && z8000_io_map::write_block(addr, mode, data, count, word);
     }
 
 private:
     bool m_trace;
-    // Loopback registers
-    u16 m_io_data_reg;   // Normal I/O 0x0000
-    u16 m_io_ctrl_reg;   // Normal I/O 0x0002
-    u16 m_sio_data_reg;  // Special I/O 0x0020
+    z8000_trace_sink* m_trace_sink;
+    // Loopback registers, big-endian
+    u8 m_io_regs[4];     // Normal I/O 0x0000 data, 0x0002 ctrl
+    u8 m_sio_regs[2];    // Special I/O 0x0020 data
 };
 
 #endif // MEMORY_H
@@ -0,0 +1,29 @@
+# Runs each of the differential test binaries in TESTS and fails unless
+# all of them pass and print the same digest of their reference runs
+if(NOT TESTS)
+  message(FATAL_ERROR "compare_digests.cmake: TESTS not set")
+endif()
+
+set(reference "")
+foreach(test IN LISTS TESTS)
+  get_filename_component(name ${test} NAME)
+  execute_process(COMMAND ${test} ${PROGRAMS}
+    RESULT_VARIABLE result
+    OUTPUT_VARIABLE output)
+  string(STRIP "${output}" output)
+  message(STATUS "${name}: ${output}")
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${name} failed")
+  endif()
+
+  string(REGEX MATCH "digest ([0-9a-f]+)" match "${output}")
+  if(NOT match)
+    message(FATAL_ERROR "${name} printed no digest")
+  endif()
+  if(reference STREQUAL "")
+    set(reference ${CMAKE_MATCH_1})
+    set(reference_name ${name})
+  elseif(NOT CMAKE_MATCH_1 STREQUAL reference)
+    message(FATAL_ERROR "${name} digest ${CMAKE_MATCH_1} differs from ${reference_name} digest ${reference}")
+  endif()
+endforeach()
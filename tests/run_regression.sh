@@ -5,6 +5,7 @@
 set -e
 
 EMU="../bin/z8000emu"
+EMU_FLAGS="${EMU_FLAGS:-}"     # e.g. EMU_FLAGS=-B to run through the block cache
 TEST_BIN="test_instructions.bin"
 
 # Colors for output
@@ -32,7 +33,7 @@ echo "=========================================="
 
 # Run emulator and capture output
 # Use -d to dump memory, we'll parse the results from 0x2300
-OUTPUT=$("$EMU" "$TEST_BIN" 2>&1)
+OUTPUT=$("$EMU" $EMU_FLAGS "$TEST_BIN" 2>&1)
 
 # Extract register values from output
 # Format: R0 =XXXX  R1 =XXXX  R2 =XXXX  R3 =XXXX
@@ -0,0 +1,274 @@
+// Z8000 Arithmetic Differential Test
+// Runs DAB, MULT, MULTL, DIV and DIVL through the CPU and checks results,
+// flags and cycles against the reference implementations: the 2KB
+// Z8000_dab table in z8000dab.h and, below, the generic multiply/divide
+// code they replaced.  DAB is checked for every byte and flag state, the
+// others for edge cases and a fixed random sample.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include <z8000/z8000.h>
+
+#include "test_util.h"
+#include "z8000dab.h"
+
+namespace {
+
+constexpr uint16_t F_C = 0x0080, F_Z = 0x0040, F_S = 0x0020, F_V = 0x0010, F_DA = 0x0008, F_H = 0x0004;
+constexpr uint16_t FLAGS = F_C | F_Z | F_S | F_V | F_DA | F_H;
+constexpr uint16_t SYSTEM = 0x4000;
+constexpr uint32_t CODE = 0x0100;
+
+struct outcome {
+    uint64_t result;
+    uint16_t flags;
+};
+
+/* reference: multiply words */
+outcome ref_mult(uint16_t dest, uint16_t value) {
+    uint32_t result = (int32_t)(int16_t)dest * (int16_t)value;
+    uint16_t flags = 0;
+    if (!result) flags |= F_Z; else if ((int32_t)result < 0) flags |= F_S;
+    if ((int32_t)result < -0x8000 || (int32_t)result >= 0x8000) flags |= F_C;
+    return { result, flags };
+}
+
+/* reference: multiply longs */
+outcome ref_multl(uint32_t dest, uint32_t value) {
+    uint64_t result = (int64_t)(int32_t)dest * (int32_t)value;
+    uint16_t flags = 0;
+    if (!result) flags |= F_Z; else if ((int64_t)result < 0) flags |= F_S;
+    if ((int64_t)result < -0x7fffffffL || (int64_t)result >= 0x7fffffffL) flags |= F_C;
+    return { result, flags };
+}
+
+/* reference: divide long by word */
+outcome ref_div(uint32_t dest, uint16_t value) {
+    uint32_t result = dest;
+    uint16_t remainder = 0;
+    uint16_t flags = 0;
+    if (value) {
+        uint16_t qsign = ((dest >> 16) ^ value) & 0x8000;
+        uint16_t rsign = (dest >> 16) & 0x8000;
+        if ((int32_t)dest < 0) dest = -dest;
+        if ((int16_t)value < 0) value = -value;
+        result = dest / value;
+        remainder = dest % value;
+        if (qsign) result = -result;
+        if (rsign) remainder = -remainder;
+        if ((int32_t)result < -0x8000 || (int32_t)result > 0x7fff) {
+            int32_t temp = (int32_t)result >> 1;
+            flags |= F_V;
+            if (temp >= -0x8000 && temp <= 0x7fff) {
+                if (!result) flags |= F_Z; else if ((int32_t)result < 0) flags |= F_S;
+                flags |= F_C;
+            }
+        } else {
+            if (!result) flags |= F_Z; else if ((int16_t)result < 0) flags |= F_S;
+        }
+        result = ((uint32_t)remainder << 16) | (result & 0xffff);
+    } else {
+        flags = F_Z | F_V;
+    }
+    return { result, flags };
+}
+
+/* reference: divide quad word by long */
+outcome ref_divl(uint64_t dest, uint32_t value) {
+    uint64_t result = dest;
+    uint32_t remainder = 0;
+    uint16_t flags = 0;
+    if (value) {
+        uint32_t qsign = ((dest >> 32) ^ value) & 0x80000000;
+        uint32_t rsign = (dest >> 32) & 0x80000000;
+        if ((int64_t)dest < 0) dest = -dest;
+        if ((int32_t)value < 0) value = -value;
+        result = dest / value;
+        remainder = dest % value;
+        if (qsign) result = -result;
+        if (rsign) remainder = -remainder;
+        if ((int64_t)result < -0x80000000LL || (int64_t)result > 0x7fffffff) {
+            int64_t temp = (int64_t)result >> 1;
+            flags |= F_V;
+            if (temp >= -0x80000000LL && temp <= 0x7fffffff) {
+                if (!result) flags |= F_Z; else if ((int64_t)result < 0) flags |= F_S;
+                flags |= F_C;
+            }
+        } else {
+            if (!result) flags |= F_Z; else if ((int32_t)result < 0) flags |= F_S;
+        }
+        result = ((uint64_t)remainder << 32) | (result & 0xffffffff);
+    } else {
+        flags = F_Z | F_V;
+    }
+    return { result, flags };
+}
+
+// The checker with a CPU on flat memory
+class cpu_tester : public tester {
+public:
+    cpu_tester() {
+        m_cpu.set_memory(&m_mem);
+        m_cpu.set_io(&m_io);
+        m_cpu.reset();
+    }
+
+    // Execute the one-word instruction op with the flags in fcw; returns
+    // the cycles it took
+    int exec(uint16_t op, uint16_t fcw) {
+        m_mem.write_word(CODE, op);
+        m_cpu.init_state(SYSTEM | fcw, CODE, 0, 0, 0, 0xfff0);
+        return m_cpu.step();
+    }
+
+    z8002_device& cpu() { return m_cpu; }
+
+private:
+    flat_memory m_mem;
+    null_io m_io;
+    z8002_device m_cpu;
+};
+
+// dab rh0, for every byte and every C, H, DA and V state
+void test_dab(cpu_tester& t) {
+    for (unsigned in = 0; in < 0x1000; in++) {
+        const uint8_t dest = in & 0xff;
+        const uint16_t fcw = (in & 0x100 ? F_C : 0) | (in & 0x200 ? F_H : 0) |
+                             (in & 0x400 ? F_DA : 0) | (in & 0x800 ? F_V : 0);
+        const uint16_t ref = Z8000_dab[in & 0x7ff];
+        uint16_t flags = fcw & (F_V | F_DA | F_H);
+        if (ref & 0x100) flags |= F_C;
+        if (!(ref & 0xff)) flags |= F_Z; else if (ref & 0x80) flags |= F_S;
+
+        t.cpu().set_reg(0, dest << 8 | 0x5a);
+        t.exec(0xB000, fcw);
+        const uint16_t r0 = t.cpu().get_reg(0);
+        const uint16_t got = t.cpu().get_fcw() & FLAGS;
+        t.check(r0 == ((ref & 0xff) << 8 | 0x5a) && got == flags,
+                "dab %02X fcw %04X: %04X flags %04X, expected %02X5A flags %04X",
+                dest, fcw, r0, got, ref & 0xff, flags);
+    }
+}
+
+// mult rr0,r2: R1 * R2 -> RR0
+void test_mult(cpu_tester& t, uint16_t dest, uint16_t value, int base) {
+    const outcome ref = ref_mult(dest, value);
+    t.cpu().set_reg(0, 0x1234);
+    t.cpu().set_reg(1, dest);
+    t.cpu().set_reg(2, value);
+    const int cycles = t.exec(0x9920, F_V);
+    const uint32_t got = t.cpu().get_reg_long(0);
+    const uint16_t flags = t.cpu().get_fcw() & FLAGS;
+    const int ref_cycles = base + (value ? 0 : 18 - 70);
+    t.check(got == ref.result && flags == ref.flags && cycles == ref_cycles,
+            "mult %04X * %04X: %08X flags %04X cycles %d, expected %08X flags %04X cycles %d",
+            dest, value, got, flags, cycles, (uint32_t)ref.result, ref.flags, ref_cycles);
+}
+
+// multl rq0,rr4: RR2 * RR4 -> RQ0
+void test_multl(cpu_tester& t, uint32_t dest, uint32_t value, int base) {
+    const outcome ref = ref_multl(dest, value);
+    t.cpu().set_reg_long(0, 0x12345678);
+    t.cpu().set_reg_long(2, dest);
+    t.cpu().set_reg_long(4, value);
+    const int cycles = t.exec(0x9840, F_V);
+    const uint64_t got = (uint64_t)t.cpu().get_reg_long(0) << 32 | t.cpu().get_reg_long(2);
+    const uint16_t flags = t.cpu().get_fcw() & FLAGS;
+    int ref_cycles = base + 30 - 282;
+    if (value) {
+        ref_cycles = base;
+        for (int n = 0; n < 32; n++)
+            if (dest & (1u << n)) ref_cycles += 7;
+    }
+    t.check(got == ref.result && flags == ref.flags && cycles == ref_cycles,
+            "multl %08X * %08X: %016llX flags %04X cycles %d, expected %016llX flags %04X cycles %d",
+            dest, value, (unsigned long long)got, flags, cycles,
+            (unsigned long long)ref.result, ref.flags, ref_cycles);
+}
+
+// div rr0,r4: RR0 / R4 -> R0 remainder, R1 quotient
+void test_div(cpu_tester& t, uint32_t dest, uint16_t value, int base) {
+    const outcome ref = ref_div(dest, value);
+    t.cpu().set_reg_long(0, dest);
+    t.cpu().set_reg(4, value);
+    const int cycles = t.exec(0x9B40, F_C | F_V);
+    const uint32_t got = t.cpu().get_reg_long(0);
+    const uint16_t flags = t.cpu().get_fcw() & FLAGS;
+    t.check(got == ref.result && flags == ref.flags && cycles == base,
+            "div %08X / %04X: %08X flags %04X cycles %d, expected %08X flags %04X cycles %d",
+            dest, value, got, flags, cycles, (uint32_t)ref.result, ref.flags, base);
+}
+
+// divl rq0,rr4: RQ0 / RR4 -> RR0 remainder, RR2 quotient
+void test_divl(cpu_tester& t, uint64_t dest, uint32_t value, int base) {
+    const outcome ref = ref_divl(dest, value);
+    t.cpu().set_reg_long(0, dest >> 32);
+    t.cpu().set_reg_long(2, dest);
+    t.cpu().set_reg_long(4, value);
+    const int cycles = t.exec(0x9A40, F_C | F_V);
+    const uint64_t got = (uint64_t)t.cpu().get_reg_long(0) << 32 | t.cpu().get_reg_long(2);
+    const uint16_t flags = t.cpu().get_fcw() & FLAGS;
+    t.check(got == ref.result && flags == ref.flags && cycles == base,
+            "divl %016llX / %08X: %016llX flags %04X cycles %d, expected %016llX flags %04X cycles %d",
+            (unsigned long long)dest, value, (unsigned long long)got, flags, cycles,
+            (unsigned long long)ref.result, ref.flags, base);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned samples = argc > 1 ? strtoul(argv[1], nullptr, 0) : 1000000;
+    cpu_tester t;
+    std::mt19937_64 rng(0x28000);
+
+    test_dab(t);
+
+    // Base cycles: a non-zero multiplier and no one bits in the multiplicand
+    t.cpu().set_reg(1, 0);
+    t.cpu().set_reg(2, 1);
+    const int mult_base = t.exec(0x9920, 0);
+    t.cpu().set_reg_long(2, 0);
+    t.cpu().set_reg_long(4, 1);
+    const int multl_base = t.exec(0x9840, 0);
+    t.cpu().set_reg_long(0, 0);
+    t.cpu().set_reg(4, 1);
+    const int div_base = t.exec(0x9B40, 0);
+    t.cpu().set_reg_long(0, 0);
+    t.cpu().set_reg_long(2, 0);
+    t.cpu().set_reg_long(4, 1);
+    const int divl_base = t.exec(0x9A40, 0);
+
+    static const uint32_t edges[] = {
+        0, 1, 2, 3, 0x7f, 0x80, 0x7ffe, 0x7fff, 0x8000, 0x8001, 0xfffe, 0xffff,
+        0x10000, 0x17fff, 0x18000, 0x7ffffffe, 0x7fffffff, 0x80000000, 0x80000001,
+        0xffff0000, 0xffff7fff, 0xffff8000, 0xfffffffe, 0xffffffff,
+    };
+    for (uint32_t a : edges) {
+        for (uint32_t b : edges) {
+            test_mult(t, a, b, mult_base);
+            test_multl(t, a, b, multl_base);
+            test_div(t, a, b, div_base);
+            test_div(t, a << 15, b, div_base);
+            for (uint32_t c : edges)
+                test_divl(t, (uint64_t)a << 32 | c, b, divl_base);
+        }
+    }
+
+    // Random operands, with small divisors and quotients near the limits
+    // sampled more often than uniform values would give them
+    for (unsigned i = 0; i < samples; i++) {
+        const uint64_t a = rng(), b = rng();
+        const unsigned shift = rng() & 31;
+        test_mult(t, a, b, mult_base);
+        test_multl(t, a, b, multl_base);
+        test_div(t, a, b, div_base);
+        test_div(t, (int32_t)a >> (shift & 15), (int16_t)b >> (shift >> 1), div_base);
+        test_divl(t, a, b, divl_base);
+        test_divl(t, (int64_t)a >> shift, (int32_t)b >> (shift & 15), divl_base);
+    }
+
+    return t.report();
+}
@@ -0,0 +1,214 @@
+// Z8000 Breakpoint and Watchpoint Test
+// Stops at breakpoints and after watched memory and I/O accesses, and
+// checks where each run stopped, what get_debug_hit() reports and that
+// running on works: past a breakpoint on straight code, on every pass of
+// a JR and a DJNZ that loop on themselves, once for a repeating block
+// move however many slices it takes, and on every pass of a loop reading
+// a watched word.
+
+#include <vector>
+
+#include "test_util.h"
+
+namespace {
+
+constexpr uint64_t FOREVER = 100000;
+
+using stop_reason = z8002_device::stop_reason;
+
+// The checker with a CPU on flat memory
+class cpu_tester : public tester {
+public:
+    // A fresh CPU about to run code at 0x0100 in system mode
+    void load(const std::vector<uint16_t>& code) {
+        m_mem.clear();
+        m_cpu.clear_breakpoints();
+        m_mem.load(code);
+        m_cpu.set_memory(&m_mem);
+        m_cpu.set_io(&m_io);
+        m_cpu.reset();
+    }
+
+    stop_reason run(uint64_t cycles = FOREVER) {
+        return m_cpu.run_until(m_cpu.get_cycles() + cycles).reason;
+    }
+
+    z8002_device& cpu() { return m_cpu; }
+    flat_memory& mem() { return m_mem; }
+
+private:
+    flat_memory m_mem;
+    null_io m_io;
+    z8002_device m_cpu;
+};
+
+// Stops before the instruction, once; running on executes it
+void test_straight(cpu_tester& t) {
+    t.load({
+        0x2101, 0x0001,         // 0100 ld r1,#1
+        0xa910,                 // 0104 inc r1,#1
+        0xa910,                 // 0106 inc r1,#1
+        0x7a00,                 // 0108 halt
+    });
+    const int id = t.cpu().add_breakpoint(0x0104);
+
+    stop_reason r = t.run();
+    const z8000_debug_hit& hit = t.cpu().get_debug_hit();
+    t.check(r == stop_reason::breakpoint, "straight: first run did not stop at the breakpoint");
+    t.check(t.cpu().get_pc() == 0x0104 && t.cpu().get_reg(1) == 1, "straight: stopped at %04X with r1 %04X",
+            t.cpu().get_pc(), t.cpu().get_reg(1));
+    t.check(hit.kind == z8000_debug_hit::BREAKPOINT && hit.id == id && hit.pc == 0x0104 && hit.access == 0,
+            "straight: hit kind %d id %d pc %04X", hit.kind, hit.id, hit.pc);
+
+    r = t.run();
+    t.check(r == stop_reason::halt && t.cpu().get_reg(1) == 3, "straight: did not run on to the HALT");
+    t.check(t.cpu().get_debug_hit().kind == z8000_debug_hit::NONE, "straight: hit not cleared by the next run");
+}
+
+// A JR to itself stops at its breakpoint on every pass, and step() runs it
+// regardless
+void test_self_jr(cpu_tester& t) {
+    t.load({
+        0xa910,                 // 0100 inc r1,#1
+        0xe8ff,                 // 0102 jr $
+    });
+    t.cpu().add_breakpoint(0x0102);
+
+    uint64_t last = 0, pass = 0;
+    for (int i = 0; i < 5; i++) {
+        const stop_reason r = t.run();
+        t.check(r == stop_reason::breakpoint && t.cpu().get_pc() == 0x0102,
+                "self jr: run %d stopped at %04X, reason %d", i, t.cpu().get_pc(), int(r));
+        if (i > 1)
+            t.check(t.cpu().get_cycles() - last == pass, "self jr: run %d took %llu cycles, not %llu", i,
+                    (unsigned long long)(t.cpu().get_cycles() - last), (unsigned long long)pass);
+        pass = t.cpu().get_cycles() - last;
+        last = t.cpu().get_cycles();
+    }
+    t.check(pass > 0 && t.cpu().get_reg(1) == 1, "self jr: no pass executed, or r1 %04X", t.cpu().get_reg(1));
+
+    t.cpu().step();
+    t.check(t.cpu().get_pc() == 0x0102 && t.cpu().get_cycles() - last == pass, "self jr: step() did not run the JR");
+    t.check(t.run() == stop_reason::breakpoint && t.cpu().get_cycles() - last == pass,
+            "self jr: no stop after step()");
+}
+
+// A DJNZ to itself stops on every pass until it falls through
+void test_self_djnz(cpu_tester& t) {
+    t.load({
+        0x2102, 0x0003,         // 0100 ld r2,#3
+        0xf281,                 // 0104 djnz r2,$
+        0x7a00,                 // 0106 halt
+    });
+    t.cpu().add_breakpoint(0x0104);
+
+    unsigned stops = 0;
+    stop_reason r;
+    while ((r = t.run()) == stop_reason::breakpoint && stops < 10) {
+        t.check(t.cpu().get_reg(2) == 3 - stops, "self djnz: stop %u with r2 %04X", stops, t.cpu().get_reg(2));
+        stops++;
+    }
+    t.check(stops == 3 && r == stop_reason::halt && t.cpu().get_reg(2) == 0,
+            "self djnz: %u stops, reason %d, r2 %04X", stops, int(r), t.cpu().get_reg(2));
+}
+
+// A repeating block move stops once, before its first element, however
+// many slices its elements are spread over
+void test_repeat(cpu_tester& t) {
+    t.load({
+        0x2104, 0x2000,         // 0100 ld r4,#0x2000
+        0x2105, 0x1000,         // 0104 ld r5,#0x1000
+        0x2106, 0x0032,         // 0108 ld r6,#50
+        0xbb51, 0x0640,         // 010C ldir @r4,@r5,r6
+        0x7a00,                 // 0110 halt
+    });
+    for (uint32_t i = 0; i < 50; i++)
+        t.mem().write_word(0x1000 + 2 * i, uint16_t(0x5a00 + i));
+    t.cpu().add_breakpoint(0x010c);
+
+    unsigned stops = 0, slices = 0;
+    stop_reason r;
+    while ((r = t.run(7)) != stop_reason::halt && slices < 1000) {
+        stops += r == stop_reason::breakpoint;
+        slices++;
+    }
+    t.check(stops == 1, "repeat: %u breakpoint stops in %u slices", stops, slices);
+    t.check(r == stop_reason::halt && t.cpu().get_reg(6) == 0, "repeat: did not finish, r6 %04X",
+            t.cpu().get_reg(6));
+    bool copied = true;
+    for (uint32_t i = 0; i < 50; i++)
+        copied &= t.mem().read_word(0x2000 + 2 * i) == uint16_t(0x5a00 + i);
+    t.check(copied, "repeat: block not copied");
+}
+
+// Memory and I/O watches stop after the access, reporting it
+void test_watch(cpu_tester& t) {
+    const std::vector<uint16_t> code = {
+        0x2101, 0x1234,         // 0100 ld r1,#0x1234
+        0x6f01, 0x2000,         // 0104 ld 0x2000,r1
+        0x6102, 0x2000,         // 0108 ld r2,0x2000
+        0x3b16, 0x0010,         // 010C out #0x10,r1
+        0x7a00,                 // 0110 halt
+    };
+
+    t.load(code);
+    int id = t.cpu().add_watchpoint(0x2000, 0x2001, z8000_debug_hit::WRITE);
+    stop_reason r = t.run();
+    const z8000_debug_hit& hit = t.cpu().get_debug_hit();
+    t.check(r == stop_reason::watchpoint && t.cpu().get_pc() == 0x0108, "watch write: reason %d at %04X",
+            int(r), t.cpu().get_pc());
+    t.check(hit.kind == z8000_debug_hit::MEMORY && hit.id == id && hit.access == z8000_debug_hit::WRITE
+                && hit.pc == 0x0104 && hit.addr == 0x2000 && hit.value == 0x1234,
+            "watch write: hit kind %d access %d pc %04X addr %04X value %04X", hit.kind, hit.access, hit.pc,
+            hit.addr, hit.value);
+    t.check(t.run() == stop_reason::halt, "watch write: the read stopped as well");
+
+    t.load(code);
+    t.cpu().add_watchpoint(0x2000, 0x2000, z8000_debug_hit::READ);
+    r = t.run();
+    t.check(r == stop_reason::watchpoint && t.cpu().get_pc() == 0x010c && t.cpu().get_reg(2) == 0x1234,
+            "watch read: reason %d at %04X", int(r), t.cpu().get_pc());
+    t.check(hit.access == z8000_debug_hit::READ && hit.pc == 0x0108, "watch read: access %d pc %04X",
+            hit.access, hit.pc);
+
+    t.load(code);
+    id = t.cpu().add_io_watchpoint(0, 0x0010, 0x0010, z8000_debug_hit::WRITE);
+    t.cpu().add_io_watchpoint(1, 0x0010, 0x0010, z8000_debug_hit::WRITE);
+    r = t.run();
+    t.check(r == stop_reason::watchpoint && t.cpu().get_pc() == 0x0110, "watch io: reason %d at %04X", int(r),
+            t.cpu().get_pc());
+    t.check(hit.kind == z8000_debug_hit::IO && hit.id == id && hit.space == 0 && hit.addr == 0x0010
+                && hit.value == 0x1234 && hit.pc == 0x010c,
+            "watch io: hit kind %d id %d space %d port %04X value %04X", hit.kind, hit.id, hit.space, hit.addr,
+            hit.value);
+}
+
+// A loop reading a watched word stops after every read
+void test_watch_loop(cpu_tester& t) {
+    t.load({
+        0x6103, 0x2000,         // 0100 ld r3,0x2000
+        0xe8fd,                 // 0104 jr 0x0100
+    });
+    t.cpu().add_watchpoint(0x2000, 0x2001, z8000_debug_hit::READ);
+
+    for (int i = 0; i < 4; i++) {
+        const stop_reason r = t.run();
+        t.check(r == stop_reason::watchpoint && t.cpu().get_pc() == 0x0104,
+                "watch loop: run %d reason %d at %04X", i, int(r), t.cpu().get_pc());
+    }
+}
+
+} // anonymous namespace
+
+int main() {
+    cpu_tester t;
+
+    test_straight(t);
+    test_self_jr(t);
+    test_self_djnz(t);
+    test_repeat(t);
+    test_watch(t);
+    test_watch_loop(t);
+
+    return t.report();
+}
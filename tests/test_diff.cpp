@@ -0,0 +1,265 @@
+// Z8000 Execution Path Differential Test
+// Runs random Z8002 programs through the plain interpreter and through
+// the block cache, micro-op translation and idle skipping, and checks
+// that every path ends each run on the same registers, FCW, PC, cycle
+// count and memory.  The programs are built from instructions the
+// micro-ops cover, loops on themselves, polling loops and random words,
+// with a device event storing into the polled data now and then.
+//
+// The build options that change the interpreter itself, lazy flags and
+// threaded dispatch, cannot be mixed in one binary.  The test is built
+// once per option and prints a digest of the reference outcomes, and
+// compare_digests.cmake checks that every build printed the same one.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <z8000/z8000.h>
+
+#include "memory.h"
+
+namespace {
+
+constexpr uint32_t CODE = 0x0100, CODE_END = 0x2000, DATA = 0x8000;
+constexpr uint64_t CYCLES = 200000;
+
+// A random word, but not LDPS, which prints when it switches the SEG bit
+uint16_t any_word(std::mt19937& rng) {
+    for (;;) {
+        const uint16_t w = uint16_t(rng());
+        if ((w >> 8) != 0x39 && (w >> 8) != 0x79)
+            return w;
+    }
+}
+
+struct config {
+    const char* name;
+    bool blocks;
+    unsigned hot;
+    unsigned idle;
+};
+
+const config configs[] = {
+    { "interpreter", false, 0, 0 },
+    { "interpreter+idle", false, 0, z8002_device::IDLE_ALL },
+    { "blocks", true, 0, 0 },
+    { "blocks+hot1", true, 1, 0 },
+    { "blocks+hot2", true, 2, 0 },
+    { "blocks+hot64", true, 64, 0 },
+    { "blocks+idle", true, 0, z8002_device::IDLE_ALL },
+    { "blocks+hot1+idle", true, 1, z8002_device::IDLE_ALL },
+    { "blocks+hot64+spin", true, 64, z8002_device::IDLE_SPIN },
+};
+
+// Guest code: instructions the micro-ops translate, a few that they do
+// not, self-loops, polling loops, and random words
+std::vector<uint16_t> generate(std::mt19937& rng) {
+    std::vector<uint16_t> code;
+    auto rnd = [&](unsigned n) { return unsigned(rng() % n); };
+    auto reg = [&] { return rnd(16); };
+    auto data = [&] { return uint16_t(DATA + 2 * rnd(64)); };
+
+    while (CODE + 2 * code.size() < CODE_END - 16) {
+        switch (rnd(20)) {
+        case 0: case 1: case 2: {                   // ld/add/sub/cp/and/or/xor rd,rs
+            static const uint16_t ops[] = { 0xa100, 0x8100, 0x8300, 0x8b00, 0x8700, 0x8500, 0x8900 };
+            code.push_back(ops[rnd(7)] | reg() << 4 | reg());
+            break;
+        }
+        case 3: case 4: {                           // the same with #imm16
+            static const uint16_t ops[] = { 0x2100, 0x0100, 0x0300, 0x0b00, 0x0700, 0x0500, 0x0900 };
+            code.push_back(ops[rnd(7)] | reg());
+            code.push_back(any_word(rng));
+            break;
+        }
+        case 5:                                     // inc/dec rd,#n
+            code.push_back((rnd(2) ? 0xa900 : 0xab00) | reg() << 4 | rnd(16));
+            break;
+        case 6:                                     // ldk, clr, ldb rbd,rbs, ldb rbd,#imm8
+            switch (rnd(4)) {
+            case 0: code.push_back(0xbd00 | reg() << 4 | rnd(16)); break;
+            case 1: code.push_back(0x8d08 | reg() << 4); break;
+            case 2: code.push_back(0xa000 | reg() << 4 | reg()); break;
+            default: code.push_back(0xc000 | reg() << 8 | rnd(256)); break;
+            }
+            break;
+        case 7: case 8:                             // ld rd,addr; ld addr,rs
+            code.push_back((rnd(2) ? 0x6100 : 0x6f00) | reg());
+            code.push_back(data());
+            break;
+        case 9:                                     // jr cc, a few words back or forward
+            code.push_back(0xe000 | rnd(16) << 8 | uint8_t(int(rnd(24)) - 16));
+            break;
+        case 10:                                    // djnz rd,back
+            code.push_back(0xf080 | (1 + reg() % 15) << 8 | (1 + rnd(8)));
+            break;
+        case 11:                                    // jr cc,$ and djnz rd,$
+            if (rnd(2))
+                code.push_back(0xe0ff | rnd(16) << 8);
+            else
+                code.push_back(0xf081 | (1 + reg() % 15) << 8);
+            break;
+        case 12: {                                  // poll: ld rd,addr; cp rd,#n; jr ne,poll
+            const unsigned r = reg();
+            code.push_back(0x6100 | r);
+            code.push_back(data());
+            code.push_back(0x0b00 | r);
+            code.push_back(uint16_t(rnd(4)));
+            code.push_back(0xeefb);
+            break;
+        }
+        case 13: {                                  // poll a port: in rd,#port; cp; jr
+            const unsigned r = reg();
+            code.push_back(0x3b04 | r << 4);
+            code.push_back(uint16_t(rnd(2) ? 0x0010 : 0x0002));
+            code.push_back(0x0b00 | r);
+            code.push_back(uint16_t(rnd(4)));
+            code.push_back(0xe0fb | (rnd(2) ? 0x0e00 : 0x0600));
+            break;
+        }
+        case 14:                                    // out #port,rs
+            code.push_back(0x3b06 | reg() << 4);
+            code.push_back(uint16_t(rnd(4)));
+            break;
+        default:                                    // anything
+            code.push_back(any_word(rng));
+            break;
+        }
+    }
+    return code;
+}
+
+struct outcome {
+    uint16_t regs[16];
+    uint16_t fcw;
+    uint32_t pc;
+    uint64_t cycles;
+    bool halted;
+    std::vector<uint8_t> mem;
+    uint16_t ports[3];
+};
+
+outcome run(const std::vector<uint16_t>& code, uint32_t seed, const config& cfg) {
+    MemoryRegion mem(0x10000);
+    IOPorts io;
+    std::mt19937 rng(seed);
+
+    // Random data and PSA; the reset vector enters the code in system mode
+    for (uint32_t a = 0; a < 0x10000; a += 2)
+        mem.write_word(a, any_word(rng));
+    mem.write_word(2, 0x4000);
+    mem.write_word(4, CODE);
+    for (size_t i = 0; i < code.size(); i++)
+        mem.write_word(CODE + 2 * i, code[i]);
+
+    z8002_device cpu;
+    cpu.set_memory(&mem);
+    cpu.set_io(&io);
+    cpu.set_block_cache(cfg.blocks);
+    cpu.set_block_hot_threshold(cfg.hot);
+    cpu.set_idle_skip(cfg.idle);
+    cpu.reset();
+
+    // A device storing into the polled words at odd intervals
+    std::function<void(uint64_t)> poke = [&](uint64_t due) {
+        const uint32_t addr = DATA + 2 * (rng() % 64);
+        mem.write_word(addr, uint16_t(rng() % 4));
+        cpu.invalidate_code(addr, 2);
+        cpu.schedule_event(due + 500 + rng() % 5000, poke);
+    };
+    cpu.schedule_event(1000 + rng() % 5000, poke);
+
+    // The same slices for every configuration
+    while (cpu.get_cycles() < CYCLES) {
+        cpu.run_until(cpu.get_cycles() + 1 + rng() % 20000);
+        if (cpu.is_halted() && cpu.next_event() == z8000_scheduler::NEVER)
+            break;
+    }
+
+    outcome o;
+    for (int i = 0; i < 16; i++)
+        o.regs[i] = cpu.get_reg(i);
+    o.fcw = cpu.get_fcw();
+    o.pc = cpu.get_pc();
+    o.cycles = cpu.get_cycles();
+    o.halted = cpu.is_halted();
+    o.mem.assign(mem.data(), mem.data() + mem.size());
+    o.ports[0] = io.read_word(0x0000, 0);
+    o.ports[1] = io.read_word(0x0002, 0);
+    o.ports[2] = io.read_word(0x0020, 1);
+    return o;
+}
+
+bool same(const outcome& a, const outcome& b) {
+    return !memcmp(a.regs, b.regs, sizeof a.regs) && a.fcw == b.fcw && a.pc == b.pc
+           && a.cycles == b.cycles && a.halted == b.halted && a.mem == b.mem
+           && !memcmp(a.ports, b.ports, sizeof a.ports);
+}
+
+// FNV-1a, over everything same() compares
+uint64_t digest(uint64_t h, const void* data, size_t size) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++)
+        h = (h ^ p[i]) * 0x100000001b3ull;
+    return h;
+}
+
+uint64_t digest(uint64_t h, const outcome& o) {
+    const uint8_t halted = o.halted;
+    h = digest(h, o.regs, sizeof o.regs);
+    h = digest(h, &o.fcw, sizeof o.fcw);
+    h = digest(h, &o.pc, sizeof o.pc);
+    h = digest(h, &o.cycles, sizeof o.cycles);
+    h = digest(h, &halted, 1);
+    h = digest(h, o.mem.data(), o.mem.size());
+    return digest(h, o.ports, sizeof o.ports);
+}
+
+void report(const outcome& ref, const outcome& o) {
+    printf("  PC %04X/%04X FCW %04X/%04X cycles %llu/%llu halted %d/%d\n", ref.pc, o.pc, ref.fcw,
+           o.fcw, (unsigned long long)ref.cycles, (unsigned long long)o.cycles, ref.halted, o.halted);
+    for (int i = 0; i < 16; i++)
+        if (ref.regs[i] != o.regs[i])
+            printf("  R%d %04X/%04X\n", i, ref.regs[i], o.regs[i]);
+    for (size_t a = 0; a < ref.mem.size(); a++)
+        if (ref.mem[a] != o.mem[a]) {
+            printf("  first memory difference at %04zX\n", a);
+            break;
+        }
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    const unsigned programs = argc > 1 ? strtoul(argv[1], nullptr, 0) : 300;
+    unsigned failures = 0;
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    // The core logs the random programs' invalid opcodes to stderr
+    if (!freopen("/dev/null", "w", stderr))
+        return 1;
+
+    for (uint32_t seed = 0; seed < programs; seed++) {
+        std::mt19937 rng(seed);
+        const std::vector<uint16_t> code = generate(rng);
+        const outcome ref = run(code, seed, configs[0]);
+        hash = digest(hash, ref);
+        for (size_t c = 1; c < sizeof(configs) / sizeof(configs[0]); c++) {
+            const outcome o = run(code, seed, configs[c]);
+            if (same(ref, o))
+                continue;
+            if (++failures <= 20) {
+                printf("FAIL: seed %u, %s differs from %s\n", seed, configs[c].name, configs[0].name);
+                report(ref, o);
+            }
+        }
+    }
+
+    printf("digest %016llx\n", (unsigned long long)hash);
+    printf("%u programs, %u failures\n", programs, failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,167 @@
+// Z8000 I/O Port Map Test
+// Exercises z8000_io_map directly: words made from byte handlers and
+// bytes from word handlers, reads and writes alike; loopback registers
+// widened to whole words; unmapped ports, set_unmapped() and unmap();
+// the two spaces kept apart; and which block transfers are served in one
+// call and which are handed back to the CPU.
+
+#include <vector>
+
+#include <z8000/z8000_iomap.h>
+
+#include "test_util.h"
+
+namespace {
+
+using io_map = z8000_io_map;
+
+// Calls a handler received, as port/value pairs
+struct call {
+    uint16_t port, value;
+    bool operator==(const call& o) const { return port == o.port && value == o.value; }
+};
+
+// Words from a byte device and bytes from a word device
+void test_synthesis(tester& t) {
+    io_map io;
+    std::vector<call> byte_writes, word_writes;
+
+    io_map::handler bytes;
+    bytes.read_byte = [](uint16_t port) { return uint8_t(port + 0x10); };
+    bytes.write_byte = [&](uint16_t port, uint8_t value) { byte_writes.push_back({ port, value }); };
+    io.map(io_map::NORMAL, 0x0100, 0x01ff, bytes);
+
+    io_map::handler words;
+    words.read_word = [](uint16_t port) { return uint16_t(0xa000 | port); };
+    words.write_word = [&](uint16_t port, uint16_t value) { word_writes.push_back({ port, value }); };
+    io.map(io_map::NORMAL, 0x0200, 0x02ff, words);
+
+    t.check(io.read_word(0x0120, 0) == 0x3031, "synthesis: word from bytes %04X", io.read_word(0x0120, 0));
+    t.check(io.read_byte(0x0220, 0) == 0xa2 && io.read_byte(0x0221, 0) == 0x20,
+            "synthesis: bytes from word %02X %02X", io.read_byte(0x0220, 0), io.read_byte(0x0221, 0));
+
+    io.write_word(0x0140, 0x1234, 0);
+    t.check(byte_writes == std::vector<call>{ { 0x0140, 0x12 }, { 0x0141, 0x34 } },
+            "synthesis: word write to bytes made %zu calls", byte_writes.size());
+
+    io.write_byte(0x0240, 0x56, 0);
+    io.write_byte(0x0241, 0x78, 0);
+    t.check(word_writes == std::vector<call>{ { 0x0240, 0x5600 }, { 0x0240, 0x0078 } },
+            "synthesis: byte writes to a word device made %zu calls", word_writes.size());
+
+    // A handler's own width is used as it is
+    t.check(io.read_byte(0x0121, 0) == 0x31 && io.read_word(0x0222, 0) == 0xa222, "synthesis: direct widths");
+}
+
+// Registers read back what was written, at either width, over whole words
+void test_registers(tester& t) {
+    io_map io;
+    uint8_t regs[4] = { 0x11, 0x22, 0x33, 0x44 };
+    io.map_registers(io_map::SPECIAL, 0x0031, 0x0032, regs);
+
+    t.check(io.read_word(0x0030, 1) == 0x1122 && io.read_word(0x0032, 1) == 0x3344,
+            "registers: range not widened to 0030..0033");
+    t.check(io.read_byte(0x0030, 1) == 0x11 && io.read_byte(0x0033, 1) == 0x44, "registers: byte reads");
+    t.check(io.read_word(0x0030, 0) == 0xffff, "registers: visible in the normal space");
+
+    io.write_word(0x0030, 0xbeef, 1);
+    io.write_byte(0x0033, 0x99, 1);
+    t.check(regs[0] == 0xbe && regs[1] == 0xef && regs[2] == 0x33 && regs[3] == 0x99,
+            "registers: stored %02X %02X %02X %02X", regs[0], regs[1], regs[2], regs[3]);
+    t.check(io.read_word(0x0032, 1) == 0x3399, "registers: word read after a byte write");
+}
+
+// Unmapped ports, their values per space, and unmap()
+void test_unmapped(tester& t) {
+    io_map io;
+    t.check(io.read_byte(0x1234, 0) == 0xff && io.read_word(0x1234, 1) == 0xffff, "unmapped: default values");
+
+    io.set_unmapped(io_map::NORMAL, 0xde, 0xdead);
+    t.check(io.read_byte(0x1234, 0) == 0xde && io.read_word(0x1234, 0) == 0xdead,
+            "unmapped: set_unmapped() values");
+    t.check(io.read_word(0x1234, 1) == 0xffff, "unmapped: set_unmapped() changed the other space");
+
+    uint16_t latch = 0;
+    io_map::handler h;
+    h.read_word = [&](uint16_t) { return latch; };
+    h.write_word = [&](uint16_t, uint16_t value) { latch = value; };
+    io.map(io_map::NORMAL, 0x00fe, 0x0101, h);     // across a table page
+    io.write_word(0x0100, 0x4321, 0);
+    t.check(latch == 0x4321 && io.read_word(0x00fe, 0) == 0x4321, "unmapped: mapping across pages");
+
+    io.unmap(io_map::NORMAL, 0x0100, 0x0101);
+    io.write_word(0x0100, 0x1111, 0);
+    t.check(latch == 0x4321 && io.read_word(0x0100, 0) == 0xdead, "unmapped: unmap() left the handler");
+    t.check(io.read_word(0x00fe, 0) == 0x4321, "unmapped: unmap() took more than its range");
+
+    // Mapping over a range replaces what was there
+    io_map::handler other;
+    other.read_word = [](uint16_t) { return uint16_t(0x5555); };
+    io.map(io_map::NORMAL, 0x00fe, 0x00ff, other);
+    t.check(io.read_word(0x00fe, 0) == 0x5555, "unmapped: map() did not replace");
+}
+
+// Blocks go to block handlers; registers and unmapped ports are served
+// without a call; anything else goes back to the CPU untouched
+void test_blocks(tester& t) {
+    io_map io;
+    io.set_unmapped(io_map::NORMAL, 0xde, 0xdead);
+
+    std::vector<uint16_t> received;
+    io_map::handler fifo;
+    fifo.read_block = [](uint16_t, uint16_t* data, uint32_t count, bool word) {
+        for (uint32_t i = 0; i < count; i++)
+            data[i] = uint16_t(word ? 0x100 + i : i);
+    };
+    fifo.write_block = [&](uint16_t, const uint16_t* data, uint32_t count, bool) {
+        received.insert(received.end(), data, data + count);
+    };
+    io.map(io_map::NORMAL, 0x0010, 0x0011, fifo);
+
+    uint8_t regs[2] = { 0x12, 0x34 };
+    io.map_registers(io_map::NORMAL, 0x0020, 0x0021, regs);
+
+    unsigned calls = 0;
+    io_map::handler plain;
+    plain.read_word = [&](uint16_t) { calls++; return uint16_t(0); };
+    plain.write_byte = [&](uint16_t, uint8_t) { calls++; };
+    io.map(io_map::NORMAL, 0x0030, 0x0031, plain);
+
+    uint16_t data[3] = { 0, 0, 0 };
+    t.check(io.read_block(0x0010, 0, data, 3, true) && data[0] == 0x100 && data[2] == 0x102,
+            "blocks: read_block handler not used");
+    const uint16_t out[3] = { 7, 8, 9 };
+    t.check(io.write_block(0x0010, 0, out, 3, false) && received == std::vector<uint16_t>{ 7, 8, 9 },
+            "blocks: write_block handler not used");
+
+    t.check(io.read_block(0x0020, 0, data, 3, true) && data[0] == 0x1234 && data[2] == 0x1234,
+            "blocks: register word block %04X", data[0]);
+    t.check(io.read_block(0x0021, 0, data, 2, false) && data[0] == 0x34 && data[1] == 0x34,
+            "blocks: register byte block %04X", data[0]);
+    t.check(io.write_block(0x0020, 0, out, 3, true) && regs[0] == 0x00 && regs[1] == 0x09,
+            "blocks: register kept %02X%02X, not the last value", regs[0], regs[1]);
+
+    t.check(io.read_block(0x0040, 0, data, 3, true) && data[0] == 0xdead && data[2] == 0xdead,
+            "blocks: unmapped word block %04X", data[0]);
+    t.check(io.read_block(0x0040, 0, data, 2, false) && data[1] == 0xde, "blocks: unmapped byte block");
+    t.check(io.write_block(0x0040, 0, out, 3, true), "blocks: unmapped write block not dropped");
+
+    data[0] = data[1] = data[2] = 0x7777;
+    t.check(!io.read_block(0x0030, 0, data, 3, true) && data[0] == 0x7777 && data[2] == 0x7777,
+            "blocks: read_block without a block handler was served");
+    t.check(!io.write_block(0x0030, 0, out, 3, false), "blocks: write_block without a block handler was served");
+    t.check(calls == 0, "blocks: %u handler calls on the way back to the CPU", calls);
+}
+
+} // anonymous namespace
+
+int main() {
+    tester t;
+
+    test_synthesis(t);
+    test_registers(t);
+    test_unmapped(t);
+    test_blocks(t);
+
+    return t.report();
+}
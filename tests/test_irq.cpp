@@ -0,0 +1,323 @@
+// Z8000 Interrupt Test
+// Drives the NVI, VI and NMI inputs of a Z8002 around a program that
+// enables and disables interrupts with EI and DI, with handlers that
+// count, capture the identifier pushed on the stack and acknowledge
+// through a port.  Checks that NVI and VI are taken while asserted and
+// enabled and again after IRET while held, NMI once per assertion; that
+// a line asserted while masked is taken when EI enables it and not if it
+// was cleared in between; that a pending request is dropped when the
+// FCW loaded on taking a higher-priority interrupt masks it; and that
+// the VI identifier selects the PSA entry.  Also checks the latency
+// statistics of get_irq_stats(), and that the cached PSA vectors follow
+// the PSAP when LDCTL moves it.
+
+#include <vector>
+
+#include "test_util.h"
+
+namespace {
+
+constexpr uint16_t ACK_NVI = 0x50, ACK_VI = 0x52, NMI_PORT = 0x56;
+constexpr uint32_t NVI_HANDLER = 0x0300, VI_HANDLER = 0x0340, VI_HANDLER_5 = 0x0360, NMI_HANDLER = 0x0380;
+constexpr uint32_t PSA2 = 0x0400, NVI_HANDLER2 = 0x03c0, VI_HANDLER2 = 0x03e0;
+
+// Main program; the stops used below are at the addresses on the left
+const std::vector<uint16_t> PROGRAM = {
+    0x210f, 0xf000,             // 0100 ld r15,#0xf000
+    0xa910,                     // 0104 inc r1,#1
+    0xa910,                     // 0106 inc r1,#1
+    0x7c04,                     // 0108 ei vi,nvi
+    0xa920,                     // 010A inc r2,#1
+    0x7c00,                     // 010C di vi,nvi
+    0xa920,                     // 010E inc r2,#1
+    0x7c04,                     // 0110 ei vi,nvi
+    0xe8ff,                     // 0112 jr $
+};
+
+// Handlers: count, capture the identifier (and for NVI the NMI count),
+// acknowledge, return
+const std::vector<uint16_t> NVI_CODE = {
+    0xa9a0,                     // inc r10,#1
+    0x21f9,                     // ld r9,@r15
+    0xa1c8,                     // ld r8,r12
+    0x3b06, ACK_NVI,            // out #ACK_NVI,r0
+    0x7b00,                     // iret
+};
+const std::vector<uint16_t> VI_CODE = {
+    0xa9b0,                     // inc r11,#1
+    0x21f9,                     // ld r9,@r15
+    0x3b06, ACK_VI,             // out #ACK_VI,r0
+    0x7b00,                     // iret
+};
+const std::vector<uint16_t> VI_CODE_5 = {
+    0xa9bf,                     // inc r11,#16
+    0x21f9,                     // ld r9,@r15
+    0x3b06, ACK_VI,             // out #ACK_VI,r0
+    0x7b00,                     // iret
+};
+// Moves the PSA to PSA2 halfway
+const std::vector<uint16_t> PSAP_PROGRAM = {
+    0x210f, 0xf000,             // 0100 ld r15,#0xf000
+    0x7c04,                     // 0104 ei vi,nvi
+    0xa920,                     // 0106 inc r2,#1
+    0x2101, PSA2,               // 0108 ld r1,#PSA2
+    0x7d1d,                     // 010C ldctl psapoff,r1
+    0xa920,                     // 010E inc r2,#1
+    0xe8ff,                     // 0110 jr $
+};
+const std::vector<uint16_t> NVI_CODE2 = {
+    0xa9d0,                     // inc r13,#1
+    0x3b06, ACK_NVI,            // out #ACK_NVI,r0
+    0x7b00,                     // iret
+};
+const std::vector<uint16_t> VI_CODE2 = {
+    0xa970,                     // inc r7,#1
+    0x3b06, ACK_VI,             // out #ACK_VI,r0
+    0x7b00,                     // iret
+};
+const std::vector<uint16_t> NMI_CODE = {
+    0xa9c0,                     // inc r12,#1
+    0x3b06, NMI_PORT,           // out #NMI_PORT,r0
+    0x7b00,                     // iret
+};
+
+// A CPU with the program and handlers loaded, and the I/O bus of a device
+// acknowledging the interrupts: an acknowledge clears the line unless hold
+// is set, and the NMI handler clears NVI if clear_nvi_in_nmi is set
+struct machine : machine_base<z8002_device> {
+    bool hold = false;
+    bool clear_nvi_in_nmi = false;
+
+    explicit machine(const std::vector<uint16_t>& program = PROGRAM) {
+        put(0x0002, { 0x4000, 0x0100 });                // reset: system mode, interrupts disabled
+        put(0x0014, { 0x4000, NMI_HANDLER });           // NMI
+        put(0x0018, { 0x4000, NVI_HANDLER });           // NVI
+        put(0x001c, { 0x4000 });                        // VI FCW
+        put(0x001e + 2 * 3, { VI_HANDLER });            // VI identifier 3
+        put(0x001e + 2 * 5, { VI_HANDLER_5 });          // VI identifier 5
+        put(PSA2 + 0x18, { 0x4000, NVI_HANDLER2, 0x4000 });   // NVI, VI FCW at PSA2
+        put(PSA2 + 0x1e + 2 * 3, { VI_HANDLER2 });
+        put(0x0100, program);
+        put(NVI_HANDLER, NVI_CODE);
+        put(NVI_HANDLER2, NVI_CODE2);
+        put(VI_HANDLER2, VI_CODE2);
+        put(VI_HANDLER, VI_CODE);
+        put(VI_HANDLER_5, VI_CODE_5);
+        put(NMI_HANDLER, NMI_CODE);
+        cpu.reset();
+    }
+
+    // Run until about to execute the instruction at pc.  step() takes a
+    // pending request before its instruction, so a stop with one pending
+    // does not count, and a handler is seen after its first instruction
+    bool run_to(uint32_t pc) {
+        for (int i = 0; i < 2000; i++) {
+            cpu.step();
+            if (cpu.get_pc() == pc && !cpu.interrupt_pending())
+                return true;
+        }
+        return false;
+    }
+
+    void write_word(uint16_t port, uint16_t, int) override {
+        if (port == NMI_PORT) {
+            if (clear_nvi_in_nmi)
+                cpu.set_input_line(z8002_device::NVI_LINE, CLEAR_LINE);
+        } else if (!hold) {
+            cpu.set_input_line(port == ACK_NVI ? z8002_device::NVI_LINE : z8002_device::VI_LINE, CLEAR_LINE);
+        }
+    }
+};
+
+// Taken while asserted and enabled, again and again while held
+void test_level(tester& t) {
+    machine m;
+    t.check(m.run_to(0x010a), "level: did not reach the EI");
+    m.hold = true;
+    m.cpu.set_input_line(z8002_device::NVI_LINE, ASSERT_LINE, 0x0011);
+    m.cpu.run_until(m.cpu.get_cycles() + 2000);
+    t.check(m.reg(10) > 10 && m.reg(9) == 0x0011, "level: held NVI taken %u times, identifier %04X", m.reg(10),
+            m.reg(9));
+    t.check(m.reg(2) == 0, "level: main program ran %u instructions while NVI was held", m.reg(2));
+
+    m.hold = false;
+    m.cpu.run_until(m.cpu.get_cycles() + 100);
+    const uint16_t taken = m.reg(10);
+    m.cpu.run_until(m.cpu.get_cycles() + 2000);
+    t.check(m.reg(10) == taken && m.reg(2) == 2, "level: NVI taken after the acknowledge cleared it");
+}
+
+// Taken once per assertion, enabled or not
+void test_edge(tester& t) {
+    machine m;
+    t.check(m.run_to(0x0104), "edge: did not start");
+    m.cpu.set_input_line(z8002_device::NMI_LINE, ASSERT_LINE);
+    m.cpu.run_until(m.cpu.get_cycles() + 2000);
+    t.check(m.reg(12) == 1, "edge: held NMI taken %u times", m.reg(12));
+
+    m.cpu.set_input_line(z8002_device::NMI_LINE, ASSERT_LINE);
+    m.cpu.run_until(m.cpu.get_cycles() + 500);
+    t.check(m.reg(12) == 1, "edge: NMI asserted again without a clear was taken");
+
+    m.cpu.set_input_line(z8002_device::NMI_LINE, CLEAR_LINE);
+    m.cpu.set_input_line(z8002_device::NMI_LINE, ASSERT_LINE);
+    m.cpu.run_until(m.cpu.get_cycles() + 500);
+    t.check(m.reg(12) == 2, "edge: NMI after a clear taken %u times in all", m.reg(12));
+}
+
+// Masked lines wait for EI; a line cleared while masked is forgotten
+void test_masked(tester& t) {
+    {
+        machine m;
+        m.cpu.set_input_line(z8002_device::NVI_LINE, ASSERT_LINE, 0x0022);
+        t.check(m.run_to(0x0108) && m.reg(10) == 0, "masked: NVI taken while disabled at reset");
+        t.check(m.run_to(0x010a) && m.reg(10) == 1 && m.reg(9) == 0x0022,
+                "masked: NVI not taken right after EI, count %u", m.reg(10));
+    }
+    {
+        machine m;
+        m.cpu.set_input_line(z8002_device::NVI_LINE, ASSERT_LINE);
+        t.check(m.run_to(0x0108), "masked: did not reach the EI");
+        m.cpu.set_input_line(z8002_device::NVI_LINE, CLEAR_LINE);
+        t.check(m.run_to(0x0112) && m.reg(10) == 0, "masked: NVI cleared while masked was taken");
+    }
+    {
+        // Asserted after DI, taken at the next EI
+        machine m;
+        t.check(m.run_to(0x010e), "masked: did not reach the DI");
+        m.cpu.set_input_line(z8002_device::VI_LINE, ASSERT_LINE, 0x0003);
+        t.check(!m.cpu.interrupt_pending(), "masked: VI asserted after DI is pending");
+        t.check(m.run_to(0x0110) && m.reg(11) == 0, "masked: VI taken after DI");
+        t.check(m.run_to(0x0112) && m.reg(11) == 1, "masked: VI not taken at the second EI");
+    }
+}
+
+// NMI and NVI pending together: NMI goes first and its FCW masks NVI,
+// which drops the NVI request, so nothing is pending in the NMI handler;
+// IRET enables NVI again and it is taken if the line is still asserted,
+// after the NMI handler
+void test_dropped(tester& t) {
+    for (const bool clear : { false, true }) {
+        machine m;
+        m.clear_nvi_in_nmi = clear;
+        t.check(m.run_to(0x010a), "dropped: did not reach the EI");
+        m.cpu.set_input_line(z8002_device::NVI_LINE, ASSERT_LINE);
+        m.cpu.set_input_line(z8002_device::NMI_LINE, ASSERT_LINE);
+        t.check(m.run_to(NMI_HANDLER + 2) && !m.cpu.interrupt_pending(),
+                "dropped: NVI still pending in the NMI handler");
+        t.check(m.run_to(0x010c), "dropped: did not get back to the main program");
+        t.check(m.reg(12) == 1, "dropped: NMI taken %u times", m.reg(12));
+        if (clear)
+            t.check(m.reg(10) == 0, "dropped: NVI cleared in the NMI handler was still taken");
+        else
+            t.check(m.reg(10) == 1 && m.reg(8) == 1, "dropped: NVI taken %u times, %u NMIs before it", m.reg(10),
+                    m.reg(8));
+    }
+}
+
+// The VI identifier selects the PSA entry and is pushed for the handler
+void test_vector(tester& t) {
+    machine m;
+    t.check(m.run_to(0x010a), "vector: did not reach the EI");
+    m.cpu.set_input_line(z8002_device::VI_LINE, ASSERT_LINE, 0x0203);
+    m.cpu.run_until(m.cpu.get_cycles() + 500);
+    t.check(m.reg(11) == 1 && m.reg(9) == 0x0203, "vector: identifier 3 gave r11 %u, pushed %04X", m.reg(11),
+            m.reg(9));
+
+    m.cpu.set_input_line(z8002_device::VI_LINE, ASSERT_LINE, 0x0105);
+    m.cpu.run_until(m.cpu.get_cycles() + 500);
+    t.check(m.reg(11) == 17 && m.reg(9) == 0x0105, "vector: identifier 5 gave r11 %u, pushed %04X", m.reg(11),
+            m.reg(9));
+}
+
+// Latency: from assertion to acknowledge, masked time included; for a
+// line held asserted, from the previous acknowledge
+void test_latency(tester& t) {
+    {
+        machine m;
+        t.check(m.run_to(0x0104), "latency: did not start");
+        const uint64_t asserted = m.cpu.get_cycles();
+        m.cpu.set_input_line(z8002_device::NVI_LINE, ASSERT_LINE);
+        t.check(m.run_to(0x0108), "latency: did not reach the EI");
+        m.cpu.step();
+        const uint64_t enabled = m.cpu.get_cycles();
+        m.cpu.step();
+        const z8002_device::irq_stats& nvi = m.cpu.get_irq_stats(z8002_device::NVI_LINE);
+        t.check(nvi.count == 1 && nvi.latency == enabled - asserted && nvi.max_latency == nvi.latency,
+                "latency: masked NVI count %llu latency %llu max %llu, expected latency %llu",
+                (unsigned long long)nvi.count, (unsigned long long)nvi.latency,
+                (unsigned long long)nvi.max_latency, (unsigned long long)(enabled - asserted));
+
+        t.check(m.run_to(0x010c), "latency: did not get back to the main program");
+        m.cpu.set_input_line(z8002_device::NMI_LINE, ASSERT_LINE);
+        m.cpu.step();
+        const z8002_device::irq_stats& nmi = m.cpu.get_irq_stats(z8002_device::NMI_LINE);
+        t.check(nmi.count == 1 && nmi.latency == 0, "latency: NMI count %llu latency %llu",
+                (unsigned long long)nmi.count, (unsigned long long)nmi.latency);
+        t.check(m.cpu.get_irq_stats(z8002_device::VI_LINE).count == 0, "latency: VI counted");
+
+        m.cpu.reset();
+        t.check(nvi.count == 1 && nmi.count == 1, "latency: reset() cleared the statistics");
+        m.cpu.clear_irq_stats();
+        t.check(nvi.count == 0 && nvi.latency == 0 && nvi.max_latency == 0 && nmi.count == 0,
+                "latency: clear_irq_stats() left counts");
+    }
+    {
+        machine m;
+        m.hold = true;
+        t.check(m.run_to(0x010a), "latency: did not reach the EI");
+        m.cpu.set_input_line(z8002_device::NVI_LINE, ASSERT_LINE);
+        t.check(m.run_to(NVI_HANDLER + 2), "latency: held NVI not taken");
+        t.check(m.run_to(NVI_HANDLER + 2), "latency: held NVI not taken again");
+        const uint64_t second = m.cpu.get_cycles();
+        t.check(m.run_to(NVI_HANDLER + 2), "latency: held NVI not taken a third time");
+        const uint64_t third = m.cpu.get_cycles();
+
+        // Enabled when asserted, the first is taken at once; held, each one
+        // after waits for a pass of the handler
+        const z8002_device::irq_stats& nvi = m.cpu.get_irq_stats(z8002_device::NVI_LINE);
+        t.check(nvi.count == 3 && nvi.max_latency == third - second,
+                "latency: held NVI count %llu max %llu, handler %llu cycles", (unsigned long long)nvi.count,
+                (unsigned long long)nvi.max_latency, (unsigned long long)(third - second));
+        t.check(nvi.latency == 2 * (third - second), "latency: held NVI total %llu, handler %llu cycles",
+                (unsigned long long)nvi.latency, (unsigned long long)(third - second));
+    }
+}
+
+// NVI and VI through the PSA, then again after LDCTL has moved it: the
+// vectors cached on the first round must not be used on the second.  The
+// breakpoints are set once, as setting one drops the cached vectors too;
+// the second round returns to the breakpoint it was raised at
+void test_psap(tester& t) {
+    machine m(PSAP_PROGRAM);
+    m.cpu.add_breakpoint(0x0108);
+    m.cpu.add_breakpoint(0x010e);
+    auto run = [&m] { m.cpu.run_until(m.cpu.get_cycles() + 10000); return m.cpu.get_pc(); };
+
+    m.cpu.set_input_line(z8002_device::NVI_LINE, ASSERT_LINE);
+    m.cpu.set_input_line(z8002_device::VI_LINE, ASSERT_LINE, 0x0003);
+    t.check(run() == 0x0108 && m.reg(10) == 1 && m.reg(11) == 1 && m.reg(13) == 0 && m.reg(7) == 0,
+            "psap: first round went to NVI %u/%u, VI %u/%u", m.reg(10), m.reg(13), m.reg(11), m.reg(7));
+
+    t.check(run() == 0x010e && m.cpu.get_psap_off() == PSA2, "psap: PSAP is %04X", m.cpu.get_psap_off());
+    m.cpu.set_input_line(z8002_device::NVI_LINE, ASSERT_LINE);
+    m.cpu.set_input_line(z8002_device::VI_LINE, ASSERT_LINE, 0x0003);
+    t.check(run() == 0x010e && m.reg(10) == 1 && m.reg(11) == 1 && m.reg(13) == 1 && m.reg(7) == 1,
+            "psap: second round went to NVI %u/%u, VI %u/%u", m.reg(10), m.reg(13), m.reg(11), m.reg(7));
+}
+
+} // anonymous namespace
+
+int main() {
+    tester t;
+
+    test_level(t);
+    test_edge(t);
+    test_masked(t);
+    test_dropped(t);
+    test_vector(t);
+    test_latency(t);
+    test_psap(t);
+
+    return t.report();
+}
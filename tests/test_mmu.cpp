@@ -0,0 +1,145 @@
+// Z8001 Segment Translation Test
+// Runs a program from a segment the MMU maps elsewhere that reads and
+// then writes one word through @rr2, and checks where the accesses went
+// and the descriptor's REFERENCED and CHANGED bits; with the MMU turned
+// off the same addresses are physical again.  Against segments too short,
+// read-only, CPU-inhibited and execute-only, checks that each access
+// raises a segment trap taken after its instruction, that the stores are
+// suppressed, what inhibited reads return and what
+// get_segment_violation() records.
+
+#include <vector>
+
+#include "test_util.h"
+
+namespace {
+
+constexpr uint32_t CODE_SEG = 5, CODE = 0x040000;  // segment 5 is mapped to 0x040000
+constexpr uint32_t SEGTRAP_HANDLER = 0x0200;
+constexpr uint16_t OLD = 0x1234, NEW = 0x5678;
+
+// Reads the word at <<seg>>offset into r1 and stores NEW over it; the
+// segment trap handler counts in r10
+struct machine : machine_base<z8001_device> {
+    machine(uint8_t seg, uint16_t offset) : machine_base(0x100000) {
+        put(0x0002, { 0xc000, 0x8000 | CODE_SEG << 8, 0x0000 });    // reset: segmented system mode
+        put(0x0022, { 0xc000, 0x8000, SEGTRAP_HANDLER });           // segment trap
+        put(SEGTRAP_HANDLER, {
+            0xa9a0,                 // inc r10,#1
+            0x7b00,                 // iret
+        });
+        const std::vector<uint16_t> program = {
+            0x210e, 0x0000,         // 0000 ld r14,#0
+            0x210f, 0xf000,         // 0004 ld r15,#0xf000
+            0x2102, uint16_t(seg << 8), // 0008 ld r2,#seg
+            0x2103, offset,         // 000C ld r3,#offset
+            0x2121,                 // 0010 ld r1,@rr2
+            0x2104, NEW,            // 0012 ld r4,#NEW
+            0x2f24,                 // 0016 ld @rr2,r4
+            0x7a00,                 // 0018 halt
+        };
+        put(CODE, program);
+        put(CODE_SEG << 16, program);   // where it is with the MMU off
+
+        z8000_segment code;
+        code.base = CODE >> 8;
+        code.limit = 0x00;
+        cpu.set_segment(CODE_SEG, code);
+        cpu.set_mmu(true);
+        cpu.reset();
+    }
+
+    void run() { cpu.run_until(cpu.get_cycles() + 10000); }
+};
+
+// Logical addresses go where the descriptors say, fetches included
+void test_translation(tester& t) {
+    machine m(1, 0x0010);
+    z8000_segment data;
+    data.base = 0x0200;                 // 0x020000
+    data.limit = 0x0f;
+    m.cpu.set_segment(1, data);
+    m.put(0x020010, { OLD });
+    m.put(0x010010, { 0xaaaa });
+
+    m.run();
+    t.check(m.cpu.is_halted() && m.reg(10) == 0, "translation: halted %d after %u traps", m.cpu.is_halted(),
+            m.reg(10));
+    t.check(m.reg(1) == OLD, "translation: read %04X", m.reg(1));
+    t.check(m.mem.read_word(0x020010) == NEW && m.mem.read_word(0x010010) == 0xaaaa,
+            "translation: stored at the wrong address");
+    const uint8_t attributes = m.cpu.get_segment(1).attributes;
+    t.check(attributes == (z8000_segment::REFERENCED | z8000_segment::CHANGED),
+            "translation: segment 1 attributes %02X", attributes);
+    t.check(m.cpu.get_segment(CODE_SEG).attributes == z8000_segment::REFERENCED,
+            "translation: code segment attributes %02X", m.cpu.get_segment(CODE_SEG).attributes);
+    t.check(m.cpu.get_segment_violation().type == 0, "translation: violation recorded");
+
+    // Off, the same program runs from and stores to the identity addresses
+    m.cpu.set_mmu(false);
+    m.cpu.reset();
+    m.run();
+    t.check(!m.cpu.mmu_enabled() && m.reg(1) == 0xaaaa && m.mem.read_word(0x010010) == NEW,
+            "translation: MMU off read %04X", m.reg(1));
+}
+
+// One segment against each check: what the read returned, that the store
+// was suppressed and what the first violation recorded
+struct violation_case {
+    const char* name;
+    uint8_t attributes;
+    uint16_t offset;
+    unsigned traps;
+    uint16_t read;
+    uint8_t type;
+    bool write;                 // the first violation was the store
+};
+
+void test_violations(tester& t) {
+    using v = z8000_segment_violation;
+    const violation_case cases[] = {
+        { "length", 0, 0x1010, 2, OLD, v::LENGTH, false },
+        { "read-only", z8000_segment::READ_ONLY, 0x0010, 1, OLD, v::READ_ONLY, true },
+        { "inhibit", z8000_segment::CPU_INHIBIT, 0x0010, 2, 0xffff, v::CPU_INHIBIT, false },
+        { "exec-only", z8000_segment::EXEC_ONLY, 0x0010, 2, OLD, v::EXEC_ONLY, false },
+    };
+
+    for (const violation_case& c : cases) {
+        machine m(1, c.offset);
+        z8000_segment data;
+        data.base = 0x0200;
+        data.limit = 0x0f;
+        data.attributes = c.attributes;
+        m.cpu.set_segment(1, data);
+        m.put(0x020000 + c.offset, { OLD });
+
+        m.run();
+        const z8000_segment_violation& got = m.cpu.get_segment_violation();
+        t.check(m.cpu.is_halted() && m.reg(10) == c.traps, "%s: %u traps, halted %d", c.name, m.reg(10),
+                m.cpu.is_halted());
+        t.check(m.reg(1) == c.read, "%s: read %04X", c.name, m.reg(1));
+        t.check(m.mem.read_word(0x020000 + c.offset) == OLD, "%s: store went ahead", c.name);
+        t.check(got.type == c.type && got.segment == 1 && got.offset == c.offset && got.write == c.write
+                    && !got.fetch,
+                "%s: recorded type %02X segment %u offset %04X write %d fetch %d", c.name, got.type,
+                got.segment, got.offset, got.write, got.fetch);
+
+        // Taken after the store, not in the middle of it
+        const uint16_t pushed = m.mem.read_word(0xf000 - 2);
+        t.check(pushed == 0x0018, "%s: last trap returned to %04X", c.name, pushed);
+
+        m.cpu.clear_segment_violation();
+        t.check(m.cpu.get_segment_violation().type == 0, "%s: violation not cleared", c.name);
+    }
+}
+
+} // anonymous namespace
+
+int main() {
+    tester t;
+
+    test_translation(t);
+    test_violations(t);
+
+    return t.report();
+}
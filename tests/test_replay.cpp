@@ -0,0 +1,368 @@
+// Z8000 I/O Record and Replay Test
+// Records a run against a device that hands out a pseudo-random sequence,
+// sums what it is sent, serves INIR and OTIR in blocks and interrupts the
+// CPU on a timer, then replays the recording without the device: the
+// replay must make every recorded access without diverging and end on
+// the same CPU state and memory.  A program changed after the recording
+// must be reported diverged at the cycle of its first different access,
+// and damaged recordings must be turned away with the documented errors.
+
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <z8000/z8000.h>
+#include <z8000/z8000_iomap.h>
+#include <z8000/z8000_replay.h>
+
+#include "memory.h"
+#include "test_util.h"
+
+namespace {
+
+constexpr uint64_t CYCLES = 100000;
+constexpr uint16_t SEQUENCE = 0x40, SUM = 0x42, ACK = 0x44;
+
+// Main loop: a word from SEQUENCE added to r5 and sent to SUM, four more
+// read into 0x2000 with INIR and sent back with OTIR, one of them added
+// to r5.  NVI handler: acknowledge, count in r11.
+std::vector<uint16_t> program(uint16_t added = 0x2006) {
+    return {
+        0x2104, 0x2000,         // 0100 ld r4,#0x2000
+        0x2106, SEQUENCE,       // 0104 ld r6,#SEQUENCE
+        0x2108, SUM,            // 0108 ld r8,#SUM
+        0x3b14, SEQUENCE,       // 010C in r1,#SEQUENCE
+        0x8115,                 // 0110 add r5,r1
+        0x3b56, SUM,            // 0112 out #SUM,r5
+        0x2107, 0x0004,         // 0116 ld r7,#4
+        0x2104, 0x2000,         // 011A ld r4,#0x2000
+        0x3b60, 0x0740,         // 011E inir @r4,@r6,r7
+        0x2107, 0x0004,         // 0122 ld r7,#4
+        0x2109, 0x2000,         // 0126 ld r9,#0x2000
+        0x3b92, 0x0780,         // 012A otir @r8,@r9,r7
+        0x4105, added,          // 012E add r5,added
+        0xe8ec,                 // 0132 jr 0x010C
+    };
+}
+
+const std::vector<uint16_t> HANDLER = {
+    0x3ba4, ACK,                // 0200 in r10,#ACK
+    0xa9b0,                     // 0204 inc r11,#1
+    0x7b00,                     // 0206 iret
+};
+
+void load(MemoryRegion& mem, const std::vector<uint16_t>& code) {
+    mem.write_word(2, 0x4800);          // system mode, NVI enabled
+    mem.write_word(4, 0x0100);
+    mem.write_word(0x18, 0x4000);       // NVI handler with NVI disabled
+    mem.write_word(0x1a, 0x0200);
+    for (size_t i = 0; i < code.size(); i++)
+        mem.write_word(0x0100 + 2 * i, code[i]);
+    for (size_t i = 0; i < HANDLER.size(); i++)
+        mem.write_word(0x0200 + 2 * i, HANDLER[i]);
+}
+
+// The device.  Its interrupt goes through raise, which is the recorder's
+// set_input_line() while recording.
+class device : public z8000_io_map {
+public:
+    using line_fn = std::function<void(int line, int state)>;
+
+    device(z8002_device& cpu, line_fn raise) : m_cpu(cpu), m_raise(std::move(raise)) {
+        handler seq;
+        seq.read_word = [this](uint16_t) { return next(); };
+        seq.read_block = [this](uint16_t, uint16_t* data, uint32_t count, bool) {
+            for (uint32_t i = 0; i < count; i++)
+                data[i] = next();
+        };
+        map(NORMAL, SEQUENCE, SEQUENCE + 1, seq);
+
+        handler sum;
+        sum.write_word = [this](uint16_t, uint16_t value) { m_sum += value; };
+        sum.write_block = [this](uint16_t, const uint16_t* data, uint32_t count, bool) {
+            for (uint32_t i = 0; i < count; i++)
+                m_sum += data[i];
+        };
+        map(NORMAL, SUM, SUM + 1, sum);
+
+        handler ack;
+        ack.read_word = [this](uint16_t) {
+            m_raise(z8002_device::NVI_LINE, CLEAR_LINE);
+            return ++m_acks;
+        };
+        map(NORMAL, ACK, ACK + 1, ack);
+    }
+
+    // Interrupt every few thousand cycles
+    void start() { m_cpu.schedule_event(1500, [this](uint64_t due) { tick(due); }); }
+
+private:
+    uint16_t next() { return m_seq = uint16_t(m_seq * 25173 + 13849); }
+    void tick(uint64_t due) {
+        m_raise(z8002_device::NVI_LINE, ASSERT_LINE);
+        m_cpu.schedule_event(due + 2000 + (next() & 0x7ff), [this](uint64_t d) { tick(d); });
+    }
+
+    z8002_device& m_cpu;
+    line_fn m_raise;
+    uint16_t m_seq = 1, m_sum = 0, m_acks = 0;
+};
+
+// Logs each access with its cycle, on the way to the device
+class access_log : public z8000_io_bus {
+public:
+    struct entry {
+        uint64_t cycle;
+        uint16_t port, value;
+        bool write;
+        bool operator!=(const entry& o) const { return port != o.port || value != o.value || write != o.write; }
+    };
+
+    access_log(z8002_device& cpu, z8000_io_bus& io) : m_cpu(cpu), m_io(io) {}
+
+    uint8_t read_byte(uint16_t port, int mode) override { return log(port, m_io.read_byte(port, mode), false); }
+    uint16_t read_word(uint16_t port, int mode) override { return log(port, m_io.read_word(port, mode), false); }
+    void write_byte(uint16_t port, uint8_t value, int mode) override {
+        m_io.write_byte(port, log(port, value, true), mode);
+    }
+    void write_word(uint16_t port, uint16_t value, int mode) override {
+        m_io.write_word(port, log(port, value, true), mode);
+    }
+    bool read_block(uint16_t port, int mode, uint16_t* data, uint32_t count, bool word) override {
+        if (!m_io.read_block(port, mode, data, count, word))
+            return false;
+        for (uint32_t i = 0; i < count; i++)
+            log(port, data[i], false);
+        return true;
+    }
+    bool write_block(uint16_t port, int mode, const uint16_t* data, uint32_t count, bool word) override {
+        if (!m_io.write_block(port, mode, data, count, word))
+            return false;
+        for (uint32_t i = 0; i < count; i++)
+            log(port, data[i], true);
+        return true;
+    }
+
+    std::vector<entry> entries;
+
+private:
+    uint16_t log(uint16_t port, uint16_t value, bool write) {
+        entries.push_back({ m_cpu.get_cycles(), port, value, write });
+        return value;
+    }
+
+    z8002_device& m_cpu;
+    z8000_io_bus& m_io;
+};
+
+struct outcome {
+    z8000_state state;
+    std::vector<uint8_t> mem;
+};
+
+// A run against the device, recorded to path if given, with its accesses
+// logged to log if given
+outcome run_live(const std::vector<uint16_t>& code, const char* path, std::vector<access_log::entry>* log) {
+    MemoryRegion mem;
+    z8002_device cpu;
+    z8000_io_recorder* recorder_ptr = nullptr;
+    device dev(cpu, [&](int line, int state) {
+        if (recorder_ptr)
+            recorder_ptr->set_input_line(line, state);
+        else
+            cpu.set_input_line(line, state);
+    });
+    access_log logger(cpu, dev);
+    z8000_io_recorder recorder(cpu, logger);
+    load(mem, code);
+    cpu.set_memory(&mem);
+    if (path) {
+        recorder.open(path);
+        recorder_ptr = &recorder;
+        cpu.set_io(&recorder);
+    } else {
+        cpu.set_io(&logger);
+    }
+    cpu.reset();
+    dev.start();
+    cpu.run_until(CYCLES);
+    recorder.close();
+
+    outcome o;
+    cpu.save_state(o.state);
+    o.mem.assign(mem.data(), mem.data() + mem.size());
+    if (log)
+        *log = logger.entries;
+    return o;
+}
+
+std::string temp_path() {
+    char path[] = "/tmp/z8000_replay_XXXXXX";
+    const int fd = mkstemp(path);
+    if (fd >= 0)
+        close(fd);
+    return path;
+}
+
+std::vector<uint8_t> read_file(const std::string& path) {
+    std::vector<uint8_t> data;
+    if (FILE* f = fopen(path.c_str(), "rb")) {
+        int c;
+        while ((c = fgetc(f)) != EOF)
+            data.push_back(uint8_t(c));
+        fclose(f);
+    }
+    return data;
+}
+
+void write_file(const std::string& path, const std::vector<uint8_t>& data) {
+    if (FILE* f = fopen(path.c_str(), "wb")) {
+        fwrite(data.data(), 1, data.size(), f);
+        fclose(f);
+    }
+}
+
+// The replay reproduces the recorded run exactly
+void test_replay(tester& t, const std::string& path) {
+    std::vector<access_log::entry> log;
+    const outcome recorded = run_live(program(), path.c_str(), &log);
+    t.check(recorded.state.regs[11] > 10 && log.size() > 1000, "replay: %u interrupts, %zu accesses recorded",
+            recorded.state.regs[11], log.size());
+
+    MemoryRegion mem;
+    z8002_device cpu;
+    z8000_io_replayer replayer(cpu);
+    load(mem, program());
+    cpu.set_memory(&mem);
+    cpu.set_io(&replayer);
+    const char* err = replayer.open(path.c_str());
+    t.check(!err, "replay: open() said %s", err ? err : "");
+    cpu.reset();
+    replayer.start();
+    cpu.run_until(replayer.end_cycle());
+
+    z8000_state state;
+    cpu.save_state(state);
+    t.check(!replayer.diverged(), "replay: diverged at cycle %llu after %zu accesses",
+            (unsigned long long)replayer.divergence_cycle(), replayer.accesses_replayed());
+    t.check(replayer.end_cycle() == recorded.state.total_cycles && replayer.accesses_replayed() == log.size(),
+            "replay: ended at %llu after %zu accesses, recorded %llu and %zu",
+            (unsigned long long)replayer.end_cycle(), replayer.accesses_replayed(),
+            (unsigned long long)recorded.state.total_cycles, log.size());
+    t.check(!memcmp(&state, &recorded.state, sizeof state), "replay: ended at PC %04X r5 %04X r11 %04X, recorded "
+            "PC %04X r5 %04X r11 %04X", state.pc, state.regs[5], state.regs[11], recorded.state.pc,
+            recorded.state.regs[5], recorded.state.regs[11]);
+    t.check(!memcmp(mem.data(), recorded.mem.data(), recorded.mem.size()), "replay: memory differs");
+
+    // Again from the start on the same replayer
+    mem.clear();
+    load(mem, program());
+    cpu.reset();
+    replayer.start();
+    cpu.run_until(replayer.end_cycle());
+    cpu.save_state(state);
+    t.check(!replayer.diverged() && !memcmp(&state, &recorded.state, sizeof state), "replay: second start() "
+            "ended elsewhere");
+}
+
+// A changed program diverges at its first access that differs
+void test_divergence(tester& t, const std::string& path) {
+    std::vector<access_log::entry> original, changed;
+    run_live(program(), nullptr, &original);
+    run_live(program(0x2004), nullptr, &changed);
+    size_t first = 0;
+    while (first < original.size() && first < changed.size() && !(original[first] != changed[first]))
+        first++;
+    t.check(first > 10 && first < changed.size(), "divergence: changed program differs at access %zu", first);
+    if (first >= changed.size())
+        return;
+
+    MemoryRegion mem;
+    z8002_device cpu;
+    z8000_io_replayer replayer(cpu);
+    load(mem, program(0x2004));
+    cpu.set_memory(&mem);
+    cpu.set_io(&replayer);
+    replayer.open(path.c_str());
+    cpu.reset();
+    replayer.start();
+    const z8002_device::run_result r = cpu.run_until(replayer.end_cycle());
+
+    t.check(replayer.diverged() && r.reason == z8002_device::stop_reason::request,
+            "divergence: not reported, reason %d", int(r.reason));
+    t.check(replayer.divergence_cycle() == changed[first].cycle && replayer.accesses_replayed() == first,
+            "divergence: at cycle %llu after %zu accesses, expected %llu after %zu",
+            (unsigned long long)replayer.divergence_cycle(), replayer.accesses_replayed(),
+            (unsigned long long)changed[first].cycle, first);
+}
+
+// Damaged recordings are turned away
+void test_errors(tester& t, const std::string& path) {
+    const std::string bad_path = temp_path();
+    const std::vector<uint8_t> good = read_file(path);
+    z8002_device cpu;
+
+    auto open = [&](const std::vector<uint8_t>& data) -> std::string {
+        write_file(bad_path, data);
+        z8000_io_replayer replayer(cpu);
+        const char* err = replayer.open(bad_path.c_str());
+        return err ? err : "";
+    };
+    auto expect = [&](const std::string& got, const char* want, const char* what) {
+        t.check(got == want, "errors: %s gave \"%s\", not \"%s\"", what, got.c_str(), want);
+    };
+
+    // Header, then a word read of port 0x40 at cycle 5
+    const std::vector<uint8_t> header(good.begin(), good.begin() + 8);
+    std::vector<uint8_t> data = header;
+    data.insert(data.end(), { z8000_replay_format::READ_WORD, 5, 0x40, 0x00, 0x34, 0x12 });
+    expect(open(data), "recording is truncated", "no END record");
+    data.push_back(z8000_replay_format::END);
+    data.push_back(0);
+    expect(open(data), "", "a complete recording");
+
+    expect(open(std::vector<uint8_t>(good.begin(), good.end() - 1)), "corrupt recording", "a cut END record");
+    expect(open(std::vector<uint8_t>(good.begin(), good.begin() + 12)), "corrupt recording",
+           "a cut access record");
+
+    data = header;
+    data.insert(data.end(), { 7, 0 });
+    expect(open(data), "corrupt recording", "an unknown tag");
+
+    data = good;
+    data[0] ^= 0xff;
+    expect(open(data), "not a recording", "a bad magic");
+    expect(open(std::vector<uint8_t>(good.begin(), good.begin() + 5)), "not a recording", "a cut header");
+
+    data = good;
+    data[4]++;
+    expect(open(data), "unsupported recording version", "another version");
+
+    z8001_device z8001;
+    z8000_io_replayer replayer(z8001);
+    const char* err = replayer.open(path.c_str());
+    t.check(err && !strcmp(err, "recorded on a different CPU model"), "errors: a Z8001 opened a Z8002 recording");
+    t.check(z8000_io_replayer::recorded_model(path.c_str()) == 8002, "errors: recorded_model() is not 8002");
+
+    remove(bad_path.c_str());
+    err = replayer.open(bad_path.c_str());
+    t.check(err && !strcmp(err, "cannot open file"), "errors: a missing file gave %s", err ? err : "no error");
+}
+
+} // anonymous namespace
+
+int main() {
+    tester t;
+    const std::string path = temp_path();
+
+    test_replay(t, path);
+    test_divergence(t, path);
+    test_errors(t, path);
+
+    remove(path.c_str());
+    return t.report();
+}
@@ -0,0 +1,234 @@
+// Z8000 Device Event Test
+// Checks z8000_scheduler on its own: events fire earliest first and in
+// scheduling order within a cycle, cancelled ones never, and callbacks
+// may schedule and cancel others, those due by now firing in the same
+// call.  Then through a Z8002: events fire at the first instruction
+// boundary past their cycle, a periodic device rescheduling from its
+// cycle does not drift, and an event raising an interrupt wakes a HALT
+// waiting in wait_until() or run_until(), which returns once no event is
+// left to end it.
+
+#include <functional>
+#include <vector>
+
+#include "test_util.h"
+
+namespace {
+
+using scheduler = z8000_scheduler;
+
+constexpr uint16_t ACK_NVI = 0x50;
+constexpr uint32_t NVI_HANDLER = 0x0300;
+
+// Counts r1 round a loop
+const std::vector<uint16_t> SPIN = {
+    0xa910,                     // 0100 inc r1,#1
+    0xe8fe,                     // 0102 jr 0x0100
+};
+
+// Halts with NVI enabled, counting wake-ups in r1
+const std::vector<uint16_t> SLEEPER = {
+    0x210f, 0xf000,             // 0100 ld r15,#0xf000
+    0x7c04,                     // 0104 ei vi,nvi
+    0x7a00,                     // 0106 halt
+    0xa910,                     // 0108 inc r1,#1
+    0xe8fd,                     // 010A jr 0x0106
+};
+
+const std::vector<uint16_t> NVI_CODE = {
+    0xa9a0,                     // inc r10,#1
+    0x3b06, ACK_NVI,            // out #ACK_NVI,r0
+    0x7b00,                     // iret
+};
+
+// A CPU with a program at 0x0100, an NVI handler, and a port that clears
+// NVI when the handler acknowledges it
+struct machine : machine_base<z8002_device> {
+    explicit machine(const std::vector<uint16_t>& program) {
+        put(0x0002, { 0x4000, 0x0100 });                // reset: system mode, interrupts disabled
+        put(0x0018, { 0x4000, NVI_HANDLER });           // NVI
+        put(0x0100, program);
+        put(NVI_HANDLER, NVI_CODE);
+        cpu.reset();
+    }
+
+    // An event at cycle raising NVI
+    uint64_t interrupt_at(uint64_t cycle) {
+        return cpu.schedule_event(cycle, [this](uint64_t) {
+            cpu.set_input_line(z8002_device::NVI_LINE, ASSERT_LINE);
+        });
+    }
+
+    void write_word(uint16_t port, uint16_t, int) override {
+        if (port == ACK_NVI)
+            cpu.set_input_line(z8002_device::NVI_LINE, CLEAR_LINE);
+    }
+};
+
+// Earliest first, scheduling order within a cycle, each told its cycle
+void test_order(tester& t) {
+    scheduler s;
+    std::vector<int> fired;
+    std::vector<uint64_t> cycles;
+    auto note = [&](int n) { return [&, n](uint64_t cycle) { fired.push_back(n); cycles.push_back(cycle); }; };
+
+    t.check(s.empty() && s.next() == scheduler::NEVER, "order: new scheduler not empty");
+    s.add(30, note(1));
+    s.add(10, note(2));
+    s.add(20, note(3));
+    s.add(10, note(4));
+    s.add(20, note(5));
+    t.check(s.next() == 10, "order: next() is %llu", (unsigned long long)s.next());
+
+    s.fire(9);
+    t.check(fired.empty(), "order: fired %zu events before their cycle", fired.size());
+    s.fire(25);
+    t.check(fired == std::vector<int>{ 2, 4, 3, 5 }, "order: fired %zu events, or out of order", fired.size());
+    t.check(cycles == std::vector<uint64_t>{ 10, 10, 20, 20 }, "order: callbacks not given their own cycles");
+    t.check(s.next() == 30, "order: next() after firing is %llu", (unsigned long long)s.next());
+
+    s.fire(1000);
+    t.check(fired.size() == 5 && fired.back() == 1 && cycles.back() == 30 && s.empty(),
+            "order: last event fired %zu", fired.size());
+}
+
+// Cancelled events never fire; ids are not reused
+void test_cancel(tester& t) {
+    scheduler s;
+    std::vector<int> fired;
+    auto note = [&](int n) { return [&, n](uint64_t) { fired.push_back(n); }; };
+
+    const uint64_t a = s.add(10, note(1));
+    const uint64_t b = s.add(20, note(2));
+    const uint64_t c = s.add(5, note(3));
+    t.check(a != b && b != c && a != c, "cancel: ids repeat");
+
+    t.check(s.cancel(c) && s.next() == 10, "cancel: earliest event not removed, next() %llu",
+            (unsigned long long)s.next());
+    t.check(!s.cancel(c), "cancel: cancelled twice");
+    t.check(!s.cancel(9999), "cancel: cancelled an unknown id");
+
+    const uint64_t d = s.add(10, note(4));
+    t.check(d != a && d != b && d != c, "cancel: id %llu reused", (unsigned long long)d);
+    s.fire(100);
+    t.check(fired == std::vector<int>{ 1, 4, 2 }, "cancel: fired %zu events", fired.size());
+    t.check(!s.cancel(a), "cancel: cancelled an event that has fired");
+}
+
+// Callbacks rescheduling themselves and cancelling others
+void test_callbacks(tester& t) {
+    scheduler s;
+    std::vector<uint64_t> ticks;
+
+    // A periodic device rescheduling from the cycle it was due at
+    std::function<void(uint64_t)> tick = [&](uint64_t cycle) {
+        ticks.push_back(cycle);
+        if (ticks.size() < 5)
+            s.add(cycle + 10, tick);
+    };
+    s.add(10, tick);
+    s.fire(35);
+    t.check(ticks == std::vector<uint64_t>{ 10, 20, 30 }, "callbacks: %zu ticks by 35", ticks.size());
+    t.check(s.next() == 40, "callbacks: next tick at %llu", (unsigned long long)s.next());
+    s.fire(1000);
+    t.check(ticks.size() == 5 && ticks.back() == 50 && s.empty(), "callbacks: %zu ticks in all", ticks.size());
+
+    // One event cancels a later one due in the same call; another adds
+    // one already due, which fires in the same call
+    std::vector<int> fired;
+    uint64_t victim = 0;
+    s.add(10, [&](uint64_t) { fired.push_back(1); s.cancel(victim); });
+    victim = s.add(20, [&](uint64_t) { fired.push_back(2); });
+    s.add(15, [&](uint64_t) {
+        fired.push_back(3);
+        s.add(5, [&](uint64_t cycle) { fired.push_back(int(cycle)); });
+    });
+    s.fire(30);
+    t.check(fired == std::vector<int>{ 1, 3, 5 } && s.empty(), "callbacks: fired %zu events", fired.size());
+}
+
+// Events through the CPU: on the first boundary past their cycle, and
+// periodic ones at exact multiples however the instructions fall
+void test_cpu_events(tester& t) {
+    machine m(SPIN);
+
+    uint64_t seen = 0;
+    m.cpu.schedule_event(1001, [&](uint64_t) { seen = m.cpu.get_cycles(); });
+    std::vector<uint64_t> ticks;
+    std::function<void(uint64_t)> tick = [&](uint64_t cycle) {
+        ticks.push_back(cycle);
+        m.cpu.schedule_event(cycle + 97, tick);
+    };
+    m.cpu.schedule_event(97, tick);
+
+    const uint64_t cancelled = m.cpu.schedule_event(500, [&](uint64_t) { seen = 1; });
+    t.check(m.cpu.next_event() == 97, "cpu: next_event() is %llu", (unsigned long long)m.cpu.next_event());
+    t.check(m.cpu.cancel_event(cancelled), "cpu: cancel_event() failed");
+
+    m.cpu.run_until(10000);
+    t.check(seen >= 1001 && seen < 1001 + 16, "cpu: event for 1001 fired at %llu", (unsigned long long)seen);
+    bool exact = ticks.size() == 10000 / 97;
+    for (size_t i = 0; exact && i < ticks.size(); i++)
+        exact = ticks[i] == 97 * (i + 1);
+    t.check(exact, "cpu: %zu periodic ticks, or not at multiples of 97", ticks.size());
+    t.check(m.cpu.next_event() == 97 * (ticks.size() + 1), "cpu: next tick at %llu",
+            (unsigned long long)m.cpu.next_event());
+}
+
+// A halted CPU waits for the event that interrupts it
+void test_halt(tester& t) {
+    machine m(SLEEPER);
+
+    m.cpu.wait_until(1000);
+    t.check(m.cpu.get_cycles() == 0, "halt: wait_until() moved the clock of a running CPU");
+
+    m.cpu.run();
+    const uint64_t halted = m.cpu.get_cycles();
+    t.check(m.cpu.is_halted() && m.cpu.get_pc() == 0x0108, "halt: not halted, PC %04X", m.cpu.get_pc());
+
+    // Nothing due: the clock moves to the target
+    m.cpu.wait_until(halted + 100);
+    t.check(m.cpu.get_cycles() == halted + 100 && m.cpu.is_halted(), "halt: idle wait ended at %llu",
+            (unsigned long long)(m.cpu.get_cycles() - halted));
+
+    // An event that does not interrupt is passed; the one that does ends the wait
+    unsigned quiet = 0;
+    m.cpu.schedule_event(halted + 150, [&](uint64_t) { quiet++; });
+    m.interrupt_at(halted + 300);
+    m.cpu.wait_until(halted + 10000);
+    t.check(quiet == 1 && m.cpu.get_cycles() == halted + 300 && m.cpu.interrupt_pending(),
+            "halt: wait ended at %llu, quiet event fired %u times", (unsigned long long)(m.cpu.get_cycles() - halted),
+            quiet);
+
+    m.cpu.run();
+    t.check(m.cpu.get_reg(10) == 1 && m.cpu.get_reg(1) == 1 && m.cpu.is_halted(),
+            "halt: handler ran %u times, woke %u times", m.cpu.get_reg(10), m.cpu.get_reg(1));
+
+    // run_until() waits the same way, and again after the handler
+    const uint64_t again = m.cpu.get_cycles();
+    m.interrupt_at(again + 400);
+    m.interrupt_at(again + 2000);
+    const z8002_device::run_result r = m.cpu.run_until(again + 5000);
+    t.check(m.cpu.get_reg(10) == 3 && m.cpu.get_reg(1) == 3 && m.cpu.is_halted(),
+            "halt: run_until() woke %u times", m.cpu.get_reg(1));
+
+    // With nothing left to end the HALT it returns before the target
+    t.check(r.reason == z8002_device::stop_reason::halt && m.cpu.get_cycles() > again + 2000
+                && m.cpu.get_cycles() < again + 5000,
+            "halt: run_until() ended at %llu, reason %d", (unsigned long long)(m.cpu.get_cycles() - again),
+            int(r.reason));
+}
+
+} // anonymous namespace
+
+int main() {
+    tester t;
+
+    test_order(t);
+    test_cancel(t);
+    test_callbacks(t);
+    test_cpu_events(t);
+    test_halt(t);
+
+    return t.report();
+}
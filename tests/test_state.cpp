@@ -0,0 +1,213 @@
+// Z8000 Checkpoint Test
+// Runs a program storing all over memory, takes a checkpoint with
+// save_state() and MemoryRegion::snapshot(), runs on, rolls back with
+// load_state() and restore() and runs the same stretch again, which must
+// end on the same CPU state and memory, with and without the block cache
+// and on a second CPU.  Also checks that load_state() turns away states
+// of another version, size or model without touching the CPU, and that
+// restore() copies back exactly the pages written since the snapshot.
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <z8000/z8000.h>
+
+#include "memory.h"
+#include "test_util.h"
+
+namespace {
+
+constexpr uint32_t CODE = 0x0100;
+constexpr uint64_t FIRST = 20000, SECOND = 50000;
+
+// A linear congruential sequence in r1, each value stored at 0x4000 plus
+// its low bits, with r4 counting the stores
+const std::vector<uint16_t> PROGRAM = {
+    0x2101, 0x0001,         // 0100 ld r1,#1
+    0xa112,                 // 0104 ld r2,r1
+    0x0702, 0x3ffe,         // 0106 and r2,#0x3ffe
+    0x6f21, 0x4000,         // 010A ld 0x4000(r2),r1
+    0xa113,                 // 010E ld r3,r1
+    0x8111,                 // 0110 add r1,r1
+    0x8111,                 // 0112 add r1,r1
+    0x8131,                 // 0114 add r1,r3
+    0x0101, 0x3619,         // 0116 add r1,#0x3619
+    0xa940,                 // 011A inc r4,#1
+    0xe8f3,                 // 011C jr 0x0104
+};
+
+void load_program(MemoryRegion& mem) {
+    mem.write_word(2, 0x4000);
+    mem.write_word(4, CODE);
+    for (size_t i = 0; i < PROGRAM.size(); i++)
+        mem.write_word(CODE + 2 * i, PROGRAM[i]);
+}
+
+bool same_state(const z8000_state& a, const z8000_state& b) {
+    return !memcmp(&a, &b, sizeof a);
+}
+
+bool same_memory(const MemoryRegion& mem, const std::vector<uint8_t>& copy) {
+    return !memcmp(mem.data(), copy.data(), copy.size());
+}
+
+std::vector<uint8_t> copy_of(const MemoryRegion& mem) {
+    return std::vector<uint8_t>(mem.data(), mem.data() + mem.size());
+}
+
+// Run, checkpoint, run on, roll back, run the same stretch again
+void test_round_trip(tester& t, bool blocks) {
+    const char* name = blocks ? "blocks" : "interpreter";
+    MemoryRegion mem;
+    IOPorts io;
+    z8002_device cpu;
+    load_program(mem);
+    cpu.set_memory(&mem);
+    cpu.set_io(&io);
+    cpu.set_block_cache(blocks);
+    cpu.reset();
+
+    cpu.run_until(FIRST);
+    z8000_state checkpoint;
+    cpu.save_state(checkpoint);
+    mem.snapshot();
+    const std::vector<uint8_t> at_checkpoint = copy_of(mem);
+
+    cpu.run_until(FIRST + SECOND);
+    z8000_state first;
+    cpu.save_state(first);
+    const std::vector<uint8_t> first_mem = copy_of(mem);
+    t.check(mem.dirty_pages() > 1 && first.regs[4] > 1000, "%s: the program stored nothing", name);
+
+    t.check(cpu.load_state(checkpoint), "%s: load_state() refused its own state", name);
+    mem.restore();
+    t.check(mem.dirty_pages() == 0 && same_memory(mem, at_checkpoint), "%s: restore() did not roll back",
+            name);
+    z8000_state again;
+    cpu.save_state(again);
+    t.check(same_state(again, checkpoint), "%s: state after load_state() differs from the checkpoint", name);
+
+    cpu.run_until(FIRST + SECOND);
+    cpu.save_state(again);
+    t.check(same_state(again, first), "%s: second run ended at PC %04X, cycles %llu, r4 %04X; first at "
+            "PC %04X, cycles %llu, r4 %04X", name, again.pc, (unsigned long long)again.total_cycles,
+            again.regs[4], first.pc, (unsigned long long)first.total_cycles, first.regs[4]);
+    t.check(same_memory(mem, first_mem), "%s: second run left different memory", name);
+
+    // The same stretch on another CPU picking up the checkpoint
+    mem.restore();
+    z8002_device other;
+    other.set_memory(&mem);
+    other.set_io(&io);
+    other.set_block_cache(blocks);
+    t.check(other.load_state(checkpoint), "%s: second CPU refused the state", name);
+    other.run_until(FIRST + SECOND);
+    other.save_state(again);
+    t.check(same_state(again, first) && same_memory(mem, first_mem), "%s: second CPU ended elsewhere", name);
+}
+
+// States of another version, size or model leave the CPU as it was
+void test_rejects(tester& t) {
+    MemoryRegion mem;
+    IOPorts io;
+    z8002_device cpu;
+    load_program(mem);
+    cpu.set_memory(&mem);
+    cpu.set_io(&io);
+    cpu.reset();
+    cpu.run_until(1000);
+
+    z8000_state good, before, after;
+    cpu.save_state(good);
+    cpu.run_until(2000);
+    cpu.save_state(before);
+
+    z8000_state bad = good;
+    bad.version = z8000_state::VERSION + 1;
+    t.check(!cpu.load_state(bad), "rejects: accepted version %u", bad.version);
+    bad = good;
+    bad.magic ^= 1;
+    t.check(!cpu.load_state(bad), "rejects: accepted a bad magic");
+    bad = good;
+    bad.size--;
+    t.check(!cpu.load_state(bad), "rejects: accepted size %u", bad.size);
+    cpu.save_state(after);
+    t.check(same_state(before, after), "rejects: a refused state changed the CPU");
+
+    z8001_device z8001;
+    z8001.set_memory(&mem);
+    z8001.set_io(&io);
+    t.check(!z8001.load_state(good), "rejects: a Z8001 accepted a Z8002 state");
+
+    t.check(cpu.load_state(good), "rejects: refused the good state");
+
+    // The PSAP is 256-byte aligned, whatever the state says
+    bad = good;
+    bad.psapoff = 0x1234;
+    t.check(cpu.load_state(bad) && cpu.get_psap_off() == 0x1200, "rejects: PSAP offset loaded as %04X",
+            cpu.get_psap_off());
+}
+
+// restore() puts back the pages stored to since the snapshot, and only
+// those, however they were stored to
+void test_copy_on_write(tester& t) {
+    MemoryRegion mem(0x10000);
+    for (uint32_t a = 0; a < 0x10000; a += 2)
+        mem.write_word(a, uint16_t(a * 7));
+    const std::vector<uint8_t> original = copy_of(mem);
+
+    mem.snapshot();
+    t.check(mem.has_snapshot() && mem.dirty_pages() == 0, "cow: snapshot() left dirty pages");
+    t.check(mem.page_map()->write[0x2000 >> Z8000_PAGE_SHIFT] == nullptr,
+            "cow: page not write-protected after snapshot()");
+
+    mem.write_word(0x2000, 0x1111);
+    mem.write_byte(0x2001, 0x22);
+    t.check(mem.dirty_pages() == 1, "cow: %zu dirty pages after two stores to one page", mem.dirty_pages());
+    t.check(mem.page_map()->write[0x2000 >> Z8000_PAGE_SHIFT] != nullptr,
+            "cow: page still write-protected after its first store");
+
+    const uint8_t bytes[4] = { 1, 2, 3, 4 };
+    mem.load(0x8000 - 2, bytes, sizeof bytes);
+    t.check(mem.dirty_pages() == 3, "cow: load() across a page boundary dirtied %zu pages in all",
+            mem.dirty_pages());
+
+    mem.restore();
+    t.check(mem.dirty_pages() == 0 && same_memory(mem, original), "cow: restore() did not put memory back");
+    t.check(mem.page_map()->write[0x2000 >> Z8000_PAGE_SHIFT] == nullptr,
+            "cow: page not write-protected again after restore()");
+
+    // A second round from the same snapshot
+    mem.write_word(0xfffe, 0xabcd);
+    mem.restore();
+    mem.restore();
+    t.check(same_memory(mem, original), "cow: second restore() did not put memory back");
+
+    mem.drop_snapshot();
+    mem.write_word(0x2000, 0x3333);
+    t.check(!mem.has_snapshot() && mem.dirty_pages() == 0, "cow: stores tracked without a snapshot");
+
+    // clear() drops a snapshot instead of saving every page for it
+    mem.snapshot();
+    mem.clear();
+    t.check(!mem.has_snapshot() && mem.read_word(0x2000) == 0 && mem.page_map()->write[0] != nullptr,
+            "cow: clear() kept the snapshot");
+}
+
+} // anonymous namespace
+
+int main() {
+    tester t;
+
+    // load_state() reports the states it turns away on stderr
+    if (!freopen("/dev/null", "w", stderr))
+        return 1;
+
+    test_round_trip(t, false);
+    test_round_trip(t, true);
+    test_rejects(t);
+    test_copy_on_write(t);
+
+    return t.report();
+}
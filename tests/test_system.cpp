@@ -0,0 +1,135 @@
+// Z8000 Multi-CPU System Test
+// Two Z8002s pass a series of values through a shared window, one waiting
+// for the other's acknowledgement before sending the next.  The window
+// sits at a different address on each side, one bus publishes a page map
+// and the other does not.  Every quantum size must deliver the same sum,
+// and with threads the same registers and cycle counts as without.
+
+#include <cstdio>
+#include <vector>
+
+#include <z8000/z8000.h>
+#include <z8000/z8000_system.h>
+
+#include "test_util.h"
+
+namespace {
+
+constexpr uint16_t COUNT = 500;
+constexpr uint32_t WINDOW_A = 0x8000, WINDOW_B = 0x4000;
+
+// Just enough of an assembler for backward JRs
+struct program {
+    std::vector<uint16_t> words;
+    size_t here() const { return words.size(); }
+    void emit(std::initializer_list<uint16_t> w) { words.insert(words.end(), w); }
+    void jr(unsigned cc, size_t target) {
+        const int dsp = (int(target) - int(words.size()) - 1);
+        words.push_back(0xe000 | (cc << 8) | (dsp & 0xff));
+    }
+};
+
+constexpr unsigned EQ = 6, NE = 14;
+
+// Sender: r1 counts, data = 3 * r1 at +0, sequence r1 at +4, then wait
+// for the acknowledgement at +2
+std::vector<uint16_t> sender(uint32_t w) {
+    program p;
+    p.emit({0x2101, 0});                    // ld r1,#0
+    const size_t loop = p.here();
+    p.emit({0x4b01, uint16_t(w + 2)});      // cp r1,ack
+    p.jr(NE, loop);
+    p.emit({0xa910});                       // inc r1,#1
+    p.emit({0xa112, 0x8112, 0x8112});       // ld r2,r1; add r2,r1; add r2,r1
+    p.emit({0x6f02, uint16_t(w)});          // ld data,r2
+    p.emit({0x6f01, uint16_t(w + 4)});      // ld seq,r1
+    p.emit({0x0b01, COUNT});                // cp r1,#COUNT
+    p.jr(NE, loop);
+    const size_t done = p.here();
+    p.emit({0x4b01, uint16_t(w + 2)});      // cp r1,ack
+    p.jr(NE, done);
+    p.emit({0x7a00});                       // halt
+    return p.words;
+}
+
+// Receiver: wait for a new sequence number, add the data to r5 and
+// acknowledge
+std::vector<uint16_t> receiver(uint32_t w) {
+    program p;
+    p.emit({0x2103, 0, 0x2105, 0});         // ld r3,#0; ld r5,#0
+    const size_t loop = p.here();
+    p.emit({0x6104, uint16_t(w + 4)});      // ld r4,seq
+    p.emit({0x8b34});                       // cp r4,r3
+    p.jr(EQ, loop);
+    p.emit({0x6106, uint16_t(w)});          // ld r6,data
+    p.emit({0x8165});                       // add r5,r6
+    p.emit({0xa143});                       // ld r3,r4
+    p.emit({0x6f03, uint16_t(w + 2)});      // ld ack,r3
+    p.emit({0x0b03, COUNT});                // cp r3,#COUNT
+    p.jr(NE, loop);
+    p.emit({0x7a00});                       // halt
+    return p.words;
+}
+
+struct outcome {
+    z8000_system::stop_reason reason;
+    uint16_t sum;
+    uint64_t cycles[2];
+    uint64_t syncs;
+};
+
+outcome run(uint32_t quantum, bool threads) {
+    flat_memory mem_a(true), mem_b(false);
+    null_io io_a, io_b;
+    z8002_device a, b;
+    mem_a.load(sender(WINDOW_A));
+    mem_b.load(receiver(WINDOW_B));
+    a.set_memory(&mem_a);
+    a.set_io(&io_a);
+    a.set_block_cache(true);
+    b.set_memory(&mem_b);
+    b.set_io(&io_b);
+    a.reset();
+    b.reset();
+
+    z8000_system sys;
+    sys.add_cpu(&a);
+    sys.add_cpu(&b);
+    const int w = sys.add_window(0x100);
+    sys.map_window(w, 0, &mem_a, WINDOW_A);
+    sys.map_window(w, 1, &mem_b, WINDOW_B);
+    sys.set_quantum(quantum);
+    sys.set_threads(threads);
+
+    outcome o{};
+    sys.set_sync([&](uint64_t) { o.syncs++; });
+    o.reason = sys.run_until(z8000_scheduler::NEVER).reason;
+    o.sum = b.get_reg(5);
+    o.cycles[0] = a.get_cycles();
+    o.cycles[1] = b.get_cycles();
+    return o;
+}
+
+} // anonymous namespace
+
+int main() {
+    const uint16_t expect = uint16_t(3u * COUNT * (COUNT + 1) / 2);
+    tester t;
+
+    for (uint32_t quantum : {1u, 7u, 100u, 1000u, 10000u}) {
+        const outcome seq = run(quantum, false);
+        const outcome thr = run(quantum, true);
+        const bool ok = seq.reason == z8000_system::stop_reason::halt && seq.sum == expect
+                        && thr.reason == seq.reason && thr.sum == seq.sum
+                        && thr.cycles[0] == seq.cycles[0] && thr.cycles[1] == seq.cycles[1]
+                        && thr.syncs == seq.syncs;
+        printf("quantum %5u: sum %04X cycles %llu/%llu syncs %llu%s\n", quantum, seq.sum,
+               (unsigned long long)seq.cycles[0], (unsigned long long)seq.cycles[1],
+               (unsigned long long)seq.syncs, ok ? "" : "  FAILED");
+        t.check(ok, "quantum %u: expected sum %04X; threaded: sum %04X cycles %llu/%llu syncs %llu", quantum,
+                expect, thr.sum, (unsigned long long)thr.cycles[0], (unsigned long long)thr.cycles[1],
+                (unsigned long long)thr.syncs);
+    }
+
+    return t.report();
+}
@@ -0,0 +1,124 @@
+// Helpers Shared by the Z8000 Unit Tests
+// A checker that counts checks and prints the first failures, a plain
+// 64KB memory, an I/O bus with nothing on it and a fixture for tests
+// driving a program on a CPU.
+
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <z8000/z8000.h>
+
+#include "memory.h"
+
+class tester {
+public:
+    void check(bool ok, const char* fmt, ...) {
+        checks++;
+        if (ok)
+            return;
+        if (++failures <= 20) {
+            va_list ap;
+            va_start(ap, fmt);
+            printf("FAIL: ");
+            vprintf(fmt, ap);
+            printf("\n");
+            va_end(ap);
+        }
+    }
+
+    // Print the totals; returns the exit status
+    int report() const {
+        printf("%u checks, %u failures\n", checks, failures);
+        return failures ? 1 : 0;
+    }
+
+    unsigned checks = 0;
+    unsigned failures = 0;
+};
+
+// 64KB of memory with none of MemoryRegion's bookkeeping.  With direct
+// set it publishes a page map, so the CPU reaches it without calls.
+class flat_memory : public z8000_memory_bus {
+public:
+    explicit flat_memory(bool direct = false) : m_direct(direct) {
+        for (unsigned i = 0; i < PAGES; i++)
+            m_pages[i] = &m_mem[i << Z8000_PAGE_SHIFT];
+        m_map.read = m_pages;
+        m_map.write = m_pages;
+        m_map.mask = PAGES - 1;
+    }
+
+    // The page map points into this object
+    flat_memory(const flat_memory&) = delete;
+    flat_memory& operator=(const flat_memory&) = delete;
+
+    uint8_t read_byte(uint32_t addr) override { return m_mem[addr & 0xffff]; }
+    uint16_t read_word(uint32_t addr) override {
+        addr &= 0xfffe;
+        return (m_mem[addr] << 8) | m_mem[addr + 1];
+    }
+    void write_byte(uint32_t addr, uint8_t val) override { m_mem[addr & 0xffff] = val; }
+    void write_word(uint32_t addr, uint16_t val) override {
+        addr &= 0xfffe;
+        m_mem[addr] = val >> 8;
+        m_mem[addr + 1] = val;
+    }
+    void write_word(uint32_t addr, uint16_t val, uint16_t mask) override {
+        write_word(addr, (read_word(addr) & ~mask) | (val & mask));
+    }
+    const z8000_page_map* page_map() override { return m_direct ? &m_map : nullptr; }
+
+    // Reset vector (system mode) and code at 0x0100
+    void load(const std::vector<uint16_t>& code) {
+        write_word(2, 0x4000);
+        write_word(4, 0x0100);
+        for (size_t i = 0; i < code.size(); i++)
+            write_word(0x0100 + 2 * i, code[i]);
+    }
+
+    void clear() { memset(m_mem, 0, sizeof m_mem); }
+
+private:
+    static constexpr unsigned PAGES = 0x10000 >> Z8000_PAGE_SHIFT;
+    uint8_t m_mem[0x10000] = {};
+    uint8_t* m_pages[PAGES];
+    z8000_page_map m_map;
+    bool m_direct;
+};
+
+// Reads return all ones, writes go nowhere
+class null_io : public z8000_io_bus {
+public:
+    uint8_t read_byte(uint16_t, int) override { return 0xff; }
+    uint16_t read_word(uint16_t, int) override { return 0xffff; }
+    void write_byte(uint16_t, uint8_t, int) override {}
+    void write_word(uint16_t, uint16_t, int) override {}
+};
+
+// A CPU on a MemoryRegion of size bytes.  The machine is the CPU's I/O
+// bus, so a test can override write_word() to play the device.  Load the
+// program with put() before calling cpu.reset().
+template <typename Cpu>
+struct machine_base : null_io {
+    MemoryRegion mem;
+    Cpu cpu;
+
+    explicit machine_base(size_t size = 0x10000) : mem(size) {
+        cpu.set_memory(&mem);
+        cpu.set_io(this);
+    }
+
+    void put(uint32_t addr, const std::vector<uint16_t>& words) {
+        for (size_t i = 0; i < words.size(); i++)
+            mem.write_word(addr + 2 * i, words[i]);
+    }
+
+    uint16_t reg(int n) const { return cpu.get_reg(n); }
+};
+
+#endif // TEST_UTIL_H
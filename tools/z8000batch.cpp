@@ -0,0 +1,503 @@
+// Z8000 Batch Runner
+// Runs a manifest of guest binaries on a work-stealing thread pool and
+// prints one JSON result line per job, optionally a JUnit report as well.
+// Each worker keeps one CPU and memory region per model and resets them
+// in place between jobs.
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <getopt.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <z8000/z8000.h>
+
+#include "memory.h"
+
+void print_usage(const char* progname) {
+    printf("Z8000 Batch Runner\n");
+    printf("Usage: %s [options] <manifest>\n\n", progname);
+    printf("Options:\n");
+    printf("  -j, --jobs <n>       Worker threads (default: number of CPUs)\n");
+    printf("  -c, --cycles <n>     Default cycle limit per job (default: unlimited)\n");
+    printf("  -o, --output <file>  Write results to file (default: stdout)\n");
+    printf("  --junit <file>       Also write a JUnit XML report to file\n");
+    printf("  -h, --help           Show this help\n");
+    printf("\nManifest: one job per line, '#' starts a comment:\n");
+    printf("  [job options] <binary-file>\n");
+    printf("Job options (as for z8000emu):\n");
+    printf("  -s                   Z8001 segmented mode\n");
+    printf("  -b <addr>            Load address in hex\n");
+    printf("  -e <addr>            Override entry point\n");
+    printf("  -c <n>               Cycle limit for this job\n");
+    printf("  -B                   Execute through the block cache\n");
+    printf("  -x <reg>=<value>     Expect register R<n> to hold value (hex) at the end\n");
+    printf("\nA job passes when it halts and every expected register matches.\n");
+    printf("\nOutput: one JSON object per line, in completion order, e.g.\n");
+    printf("  {\"job\":0,\"file\":\"t.bin\",\"status\":\"ok\",\"cpu\":\"z8002\",\"halted\":true,"
+           "\"cycles\":1234,\"pc\":260,\"fcw\":16384,\"regs\":[...],\"pass\":true}\n");
+    printf("The exit status is 1 if any job failed or could not be loaded.\n");
+}
+
+struct Job {
+    size_t index = 0;
+    std::string file;
+    bool segmented = false;
+    bool block_cache = false;
+    uint32_t base_addr = 0;
+    uint32_t entry_addr = 0;
+    bool entry_set = false;
+    uint64_t max_cycles = 0;   // 0 = run until halt
+    std::vector<std::pair<int, uint16_t>> expect;   // -x: register, value
+};
+
+// Outcome of a job: the JSON line, and for the JUnit report
+struct Result {
+    std::string json;
+    std::string error;         // not loaded
+    std::string failure;       // loaded but failed
+    double seconds = 0;
+};
+
+bool parse_number(const std::string& str, int base, uint64_t& val) {
+    const char* s = str.c_str();
+    if (base == 16 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X'))
+        s += 2;
+    char* end;
+    errno = 0;
+    val = strtoull(s, &end, base);
+    return *s && !*end && errno == 0;
+}
+
+void json_string(std::string& out, const std::string& str) {
+    out += '"';
+    for (unsigned char c : str) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (c < 0x20) {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+// Parse "[options] file" into job; returns an error message or empty
+std::string parse_job(const std::string& text, Job& job) {
+    std::vector<std::string> words;
+    size_t pos = 0;
+    while ((pos = text.find_first_not_of(" \t\r", pos)) != std::string::npos) {
+        size_t end = text.find_first_of(" \t\r", pos);
+        words.push_back(text.substr(pos, end - pos));
+        pos = end;
+    }
+
+    for (size_t i = 0; i < words.size(); i++) {
+        const std::string& w = words[i];
+        uint64_t val;
+        if (w == "-s") {
+            job.segmented = true;
+        } else if (w == "-B") {
+            job.block_cache = true;
+        } else if (w == "-b" || w == "-e" || w == "-c") {
+            if (i + 1 >= words.size())
+                return "option " + w + " needs an argument";
+            if (!parse_number(words[++i], w == "-c" ? 10 : 16, val))
+                return "bad argument for " + w + ": " + words[i];
+            if (w == "-b") {
+                job.base_addr = val;
+            } else if (w == "-e") {
+                job.entry_addr = val;
+                job.entry_set = true;
+            } else {
+                job.max_cycles = val;
+            }
+        } else if (w == "-x") {
+            if (i + 1 >= words.size())
+                return "option -x needs an argument";
+            const std::string& arg = words[++i];
+            size_t eq = arg.find('=');
+            uint64_t reg;
+            if (eq == std::string::npos || eq < 2 || (arg[0] != 'R' && arg[0] != 'r') ||
+                !parse_number(arg.substr(1, eq - 1), 10, reg) || reg > 15 ||
+                !parse_number(arg.substr(eq + 1), 16, val) || val > 0xFFFF)
+                return "bad argument for -x: " + arg;
+            job.expect.emplace_back(int(reg), uint16_t(val));
+        } else if (w[0] == '-') {
+            return "unknown option " + w;
+        } else if (job.file.empty()) {
+            job.file = w;
+        } else {
+            return "more than one binary file";
+        }
+    }
+    if (job.file.empty())
+        return "no binary file";
+    if (!job.entry_set)
+        job.entry_addr = job.base_addr;
+    return std::string();
+}
+
+// Load the binary and apply the entry override, as z8000emu does
+std::string load_job(const Job& job, MemoryRegion& memory) {
+    size_t len;
+    if (const char* error = memory.load_file(job.base_addr, job.file.c_str(), len))
+        return error;
+
+    if (job.entry_set) {
+        if (job.segmented) {
+            uint16_t seg = (job.entry_addr >> 16) & 0x7F;
+            memory.write_word(4, (seg << 8) | 0x8000);
+            memory.write_word(6, job.entry_addr & 0xFFFF);
+            if (memory.read_word(2) == 0)
+                memory.write_word(2, 0xC000);  // segmented system mode
+        } else {
+            memory.write_word(4, job.entry_addr & 0xFFFF);
+            if (memory.read_word(2) == 0)
+                memory.write_word(2, 0x4000);  // system mode
+        }
+    }
+    return std::string();
+}
+
+// A CPU and its memory, built once per worker and model and reset in
+// place for every job.  The memory keeps a snapshot of itself blank, so
+// restore() zeroes only the pages the previous job loaded or wrote
+// instead of a fresh 8MB region being mapped for each job.
+struct Machine {
+    // Z8001 has 23-bit (8MB) address space, Z8002 has 16-bit (64KB)
+    explicit Machine(bool segmented)
+        : memory(segmented ? 0x800000 : 0x10000)
+        , cpu(segmented ? new z8001_device() : new z8002_device()) {
+        memory.snapshot();
+        cpu->set_memory(&memory);
+        cpu->set_io(&io);
+    }
+
+    MemoryRegion memory;
+    IOPorts io;
+    std::unique_ptr<z8002_device> cpu;
+};
+
+// Empty if the job passed, otherwise why not
+std::string check_job(const Job& job, const z8002_device& cpu) {
+    char buf[64];
+    if (!cpu.is_halted()) {
+        snprintf(buf, sizeof(buf), "not halted after %llu cycles", (unsigned long long)cpu.get_cycles());
+        return buf;
+    }
+    std::string failure;
+    for (const auto& e : job.expect) {
+        if (cpu.get_reg(e.first) == e.second)
+            continue;
+        snprintf(buf, sizeof(buf), "%sR%d=%04X, expected %04X", failure.empty() ? "" : ", ",
+                 e.first, cpu.get_reg(e.first), e.second);
+        failure += buf;
+    }
+    return failure;
+}
+
+Result run_job(const Job& job, Machine& machine) {
+    Result result;
+    std::string& out = result.json;
+    out = "{\"job\":" + std::to_string(job.index) + ",\"file\":";
+    json_string(out, job.file);
+
+    machine.memory.restore();
+    machine.io.clear();
+    result.error = load_job(job, machine.memory);
+    if (!result.error.empty()) {
+        out += ",\"status\":\"error\",\"error\":";
+        json_string(out, result.error);
+        out += "}";
+        return result;
+    }
+
+    z8002_device& cpu = *machine.cpu;
+    cpu.set_block_cache(job.block_cache);
+    cpu.invalidate_block_cache();
+    cpu.reset();
+
+    if (job.max_cycles)
+        cpu.run_until(job.max_cycles);
+    else
+        cpu.run(-1);
+
+    char buf[160];
+    snprintf(buf, sizeof(buf),
+             ",\"status\":\"ok\",\"cpu\":\"%s\",\"halted\":%s,\"cycles\":%llu,\"pc\":%u,\"fcw\":%u,\"regs\":[",
+             job.segmented ? "z8001" : "z8002", cpu.is_halted() ? "true" : "false",
+             (unsigned long long)cpu.get_cycles(), cpu.get_pc(), cpu.get_fcw());
+    out += buf;
+    for (int i = 0; i < 16; i++) {
+        if (i)
+            out += ',';
+        out += std::to_string(cpu.get_reg(i));
+    }
+    result.failure = check_job(job, cpu);
+    if (result.failure.empty()) {
+        out += "],\"pass\":true}";
+    } else {
+        out += "],\"pass\":false,\"failure\":";
+        json_string(out, result.failure);
+        out += "}";
+    }
+    return result;
+}
+
+void xml_string(FILE* out, const std::string& str) {
+    for (unsigned char c : str) {
+        switch (c) {
+            case '<':  fputs("&lt;", out); break;
+            case '>':  fputs("&gt;", out); break;
+            case '&':  fputs("&amp;", out); break;
+            case '"':  fputs("&quot;", out); break;
+            default:
+                if (c < 0x20)
+                    fprintf(out, "&#%u;", c);
+                else
+                    fputc(c, out);
+        }
+    }
+}
+
+// One testsuite named after the manifest, one testcase per job in
+// manifest order
+void write_junit(FILE* out, const char* suite, const std::vector<Job>& jobs,
+                 const std::vector<Result>& results) {
+    size_t failures = 0, errors = 0;
+    double seconds = 0;
+    for (const Result& r : results) {
+        errors += !r.error.empty();
+        failures += !r.failure.empty();
+        seconds += r.seconds;
+    }
+
+    fprintf(out, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuite name=\"");
+    xml_string(out, suite);
+    fprintf(out, "\" tests=\"%zu\" failures=\"%zu\" errors=\"%zu\" time=\"%.6f\">\n",
+            results.size(), failures, errors, seconds);
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        fprintf(out, "  <testcase classname=\"");
+        xml_string(out, suite);
+        fprintf(out, "\" name=\"");
+        xml_string(out, jobs[i].file);
+        fprintf(out, "\" time=\"%.6f\"", r.seconds);
+        if (r.error.empty() && r.failure.empty()) {
+            fprintf(out, "/>\n");
+            continue;
+        }
+        fprintf(out, ">\n    <%s message=\"", r.error.empty() ? "failure" : "error");
+        xml_string(out, r.error.empty() ? r.failure : r.error);
+        fprintf(out, "\"/>\n  </testcase>\n");
+    }
+    fprintf(out, "</testsuite>\n");
+}
+
+// Work-stealing pool: each worker owns a deque of job indices, takes work
+// from the front of its own deque and steals from the back of the others
+// once it runs dry.  Jobs vary wildly in length, so this keeps all
+// threads busy without a central queue being hit for every job.
+class JobPool {
+public:
+    JobPool(const std::vector<Job>& jobs, unsigned workers, FILE* out)
+        : m_jobs(jobs), m_results(jobs.size()), m_queues(workers), m_out(out) {
+        // Contiguous slices keep stealing rare when job lengths are even
+        for (size_t i = 0; i < jobs.size(); i++)
+            m_queues[i * workers / jobs.size()].jobs.push_back(i);
+    }
+
+    void run() {
+        std::vector<std::thread> threads;
+        for (unsigned w = 0; w < m_queues.size(); w++)
+            threads.emplace_back(&JobPool::worker, this, w);
+        for (std::thread& t : threads)
+            t.join();
+    }
+
+    // In job order, once run() has returned
+    const std::vector<Result>& results() const { return m_results; }
+
+private:
+    struct Queue {
+        std::mutex lock;
+        std::deque<size_t> jobs;
+    };
+
+    bool take(unsigned self, size_t& job) {
+        {
+            Queue& q = m_queues[self];
+            std::lock_guard<std::mutex> guard(q.lock);
+            if (!q.jobs.empty()) {
+                job = q.jobs.front();
+                q.jobs.pop_front();
+                return true;
+            }
+        }
+        // Jobs are never added after start-up, so one pass over the other
+        // queues finding nothing means all work has been handed out
+        for (size_t i = 1; i < m_queues.size(); i++) {
+            Queue& q = m_queues[(self + i) % m_queues.size()];
+            std::lock_guard<std::mutex> guard(q.lock);
+            if (!q.jobs.empty()) {
+                job = q.jobs.back();
+                q.jobs.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void worker(unsigned self) {
+        std::unique_ptr<Machine> machines[2];   // Z8002, Z8001
+        size_t job;
+        while (take(self, job)) {
+            const Job& j = m_jobs[job];
+            std::unique_ptr<Machine>& machine = machines[j.segmented];
+            if (!machine)
+                machine.reset(new Machine(j.segmented));
+
+            auto start = std::chrono::steady_clock::now();
+            Result& result = m_results[job];
+            result = run_job(j, *machine);
+            result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            std::lock_guard<std::mutex> guard(m_out_lock);
+            fprintf(m_out, "%s\n", result.json.c_str());
+            fflush(m_out);
+        }
+    }
+
+    const std::vector<Job>& m_jobs;
+    std::vector<Result> m_results;      // each written by one worker only
+    std::vector<Queue> m_queues;
+    FILE* m_out;
+    std::mutex m_out_lock;
+};
+
+int main(int argc, char* argv[]) {
+    unsigned workers = std::thread::hardware_concurrency();
+    uint64_t default_cycles = 0;
+    const char* output = nullptr;
+    const char* junit = nullptr;
+
+    static struct option long_options[] = {
+        {"jobs",   required_argument, 0, 'j'},
+        {"cycles", required_argument, 0, 'c'},
+        {"output", required_argument, 0, 'o'},
+        {"junit",  required_argument, 0, 'J'},
+        {"help",   no_argument,       0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    int opt;
+    uint64_t val;
+    while ((opt = getopt_long(argc, argv, "j:c:o:h", long_options, nullptr)) != -1) {
+        switch (opt) {
+            case 'j':
+                if (!parse_number(optarg, 10, val) || val == 0) {
+                    fprintf(stderr, "Error: Bad worker count '%s'\n", optarg);
+                    return 1;
+                }
+                workers = val;
+                break;
+            case 'c':
+                if (!parse_number(optarg, 10, default_cycles)) {
+                    fprintf(stderr, "Error: Bad cycle limit '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'o':
+                output = optarg;
+                break;
+            case 'J':
+                junit = optarg;
+                break;
+            case 'h':
+                print_usage(argv[0]);
+                return 0;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (optind >= argc) {
+        fprintf(stderr, "Error: No manifest specified\n\n");
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    FILE* manifest = fopen(argv[optind], "r");
+    if (!manifest) {
+        fprintf(stderr, "Error: Cannot open manifest '%s'\n", argv[optind]);
+        return 1;
+    }
+
+    std::vector<Job> jobs;
+    char line[4096];
+    int line_no = 0;
+    bool manifest_ok = true;
+    while (fgets(line, sizeof(line), manifest)) {
+        line_no++;
+        std::string text(line);
+        text = text.substr(0, text.find_first_of("#\n"));
+        if (text.find_first_not_of(" \t\r") == std::string::npos)
+            continue;
+
+        Job job;
+        job.index = jobs.size();
+        job.max_cycles = default_cycles;
+        std::string error = parse_job(text, job);
+        if (!error.empty()) {
+            fprintf(stderr, "Error: %s:%d: %s\n", argv[optind], line_no, error.c_str());
+            manifest_ok = false;
+            continue;
+        }
+        jobs.push_back(job);
+    }
+    fclose(manifest);
+    if (!manifest_ok)
+        return 1;
+
+    FILE* out = stdout;
+    if (output && !(out = fopen(output, "w"))) {
+        fprintf(stderr, "Error: Cannot create '%s'\n", output);
+        return 1;
+    }
+
+    FILE* junit_out = nullptr;
+    if (junit && !(junit_out = fopen(junit, "w"))) {
+        fprintf(stderr, "Error: Cannot create '%s'\n", junit);
+        return 1;
+    }
+
+    if (workers > jobs.size())
+        workers = jobs.size();
+    JobPool pool(jobs, workers ? workers : 1, out);
+    pool.run();
+
+    bool passed = true;
+    for (const Result& r : pool.results())
+        passed &= r.error.empty() && r.failure.empty();
+
+    if (junit_out) {
+        write_junit(junit_out, argv[optind], jobs, pool.results());
+        fclose(junit_out);
+    }
+    if (out != stdout)
+        fclose(out);
+    return passed ? 0 : 1;
+}
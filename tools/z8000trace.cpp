@@ -0,0 +1,208 @@
+// Z8000 Trace Viewer
+// Disassembles and prints a binary trace written by z8000emu -T, in the
+// same layout as the z8000emu -t/-m/-i text trace.
+
+#include <cstdio>
+#include <cstring>
+#include <getopt.h>
+#include <vector>
+
+#include <z8000/z8000.h>
+#include <z8000/z8000_trace.h>
+
+void print_usage(const char* progname) {
+    printf("Z8000 Trace Viewer\n");
+    printf("Usage: %s [options] <trace-file>\n\n", progname);
+    printf("Options:\n");
+    printf("  -c, --cycles         Prefix each instruction with its cycle stamp\n");
+    printf("  -h, --help           Show this help\n");
+}
+
+// Serves the opcode words of one recorded instruction to the disassembler
+class InsnBus : public z8000_memory_bus, public z8000_disassembler::config {
+public:
+    InsnBus(uint16_t model) : m_model(model), m_insn(nullptr) {}
+
+    void set(const z8000_trace_insn* insn) { m_insn = insn; }
+
+    uint16_t read_word(uint32_t addr) override {
+        uint32_t i = ((addr - m_insn->pc) & 0xFFFF) >> 1;
+        return i < m_insn->words() ? m_insn->op[i] : 0xFFFF;
+    }
+    uint8_t read_byte(uint32_t addr) override {
+        return (addr & 1) ? read_word(addr) & 0xFF : read_word(addr) >> 8;
+    }
+    void write_byte(uint32_t, uint8_t) override {}
+    void write_word(uint32_t, uint16_t) override {}
+    void write_word(uint32_t, uint16_t, uint16_t) override {}
+
+    bool get_segmented_mode() const override {
+        return m_model == 8001 && (m_insn->fcw & 0x8000);  // FCW SEG bit
+    }
+
+private:
+    uint16_t m_model;
+    const z8000_trace_insn* m_insn;
+};
+
+class TracePrinter {
+public:
+    TracePrinter(uint16_t model, bool cycles)
+        : m_model(model), m_cycles(cycles), m_bus(model), m_disasm(&m_bus) {
+        m_opcodes.set_bus(&m_bus);
+    }
+
+    void record(const uint8_t* rec) {
+        switch (rec[0]) {
+            case Z8000_TRACE_INSN:
+                insn(reinterpret_cast<const z8000_trace_insn*>(rec));
+                break;
+            case Z8000_TRACE_REGS:
+                regs(reinterpret_cast<const z8000_trace_regs*>(rec));
+                break;
+            case Z8000_TRACE_MEM:
+            case Z8000_TRACE_IO:
+                // Accesses precede the instruction that made them
+                m_pending.insert(m_pending.end(), rec, rec + rec[1]);
+                break;
+            default:
+                break;
+        }
+    }
+
+    void finish() { flush(); }
+
+private:
+    void insn(const z8000_trace_insn* insn) {
+        m_bus.set(insn);
+        char text[z8000_disassembler::MAX_TEXT];
+        util::text_appender stream(text, sizeof(text));
+        offs_t size = m_disasm.disassemble(stream, insn->pc, m_opcodes, m_opcodes) & 0x0FFFFFFF;
+
+        if (m_cycles)
+            printf("%10llu ", (unsigned long long)insn->cycles);
+        if (m_bus.get_segmented_mode() && (insn->pc >> 16))
+            printf("<<%X>>%04X:", (insn->pc >> 16) & 0x7F, insn->pc & 0xFFFF);
+        else
+            printf("PC=%04X:", insn->pc & 0xFFFF);
+        for (offs_t i = 0; i < size; i += 2)
+            printf(" %04X", m_bus.read_word(insn->pc + i));
+        for (offs_t i = size; i < 6; i += 2)
+            printf("     ");
+        printf("  %s\n", text);
+        flush();
+    }
+
+    void flush() {
+        for (size_t pos = 0; pos < m_pending.size(); pos += m_pending[pos + 1]) {
+            const uint8_t* rec = &m_pending[pos];
+            if (rec[0] == Z8000_TRACE_MEM)
+                mem(reinterpret_cast<const z8000_trace_mem*>(rec));
+            else
+                io(reinterpret_cast<const z8000_trace_io*>(rec));
+        }
+        m_pending.clear();
+    }
+
+    void mem(const z8000_trace_mem* rec) {
+        const bool word = rec->flags & Z8000_TRACE_WORD;
+        printf("  MEM %s%s [%04X] %s ", rec->flags & Z8000_TRACE_WRITE ? "WR" : "RD",
+               word ? "16" : "8 ", rec->addr, rec->flags & Z8000_TRACE_WRITE ? "<-" : "->");
+        printf(word ? "%04X" : "%02X", rec->value);
+        if (rec->mask != 0xFFFF)
+            printf(" (mask %04X)", rec->mask);
+        printf("\n");
+    }
+
+    void io(const z8000_trace_io* rec) {
+        const bool word = rec->flags & Z8000_TRACE_WORD;
+        printf("  %sI/O %s%s [%04X] %s ", rec->flags & Z8000_TRACE_SPECIAL ? "S" : "",
+               rec->flags & Z8000_TRACE_WRITE ? "WR" : "RD", word ? "16" : "8 ",
+               rec->port, rec->flags & Z8000_TRACE_WRITE ? "<-" : "->");
+        printf(word ? "%04X\n" : "%02X\n", rec->value);
+    }
+
+    // Only the registers that changed, as "R3=0012 R4=FFFE"
+    void regs(const z8000_trace_regs* rec) {
+        flush();
+        if (m_model == 8001)
+            printf("  => PC=<<%02X>>%04X FCW=%04X", (rec->pc >> 16) & 0x7F, rec->pc & 0xFFFF, rec->fcw);
+        else
+            printf("  => PC=%04X FCW=%04X", rec->pc & 0xFFFF, rec->fcw);
+        int n = 0;
+        for (int i = 0; i < 16; i++)
+            if (rec->mask & (1 << i))
+                printf(" R%d=%04X", i, rec->value[n++]);
+        printf("\n");
+    }
+
+    uint16_t m_model;
+    bool m_cycles;
+    InsnBus m_bus;
+    z8000_disassembler m_disasm;
+    data_buffer m_opcodes;
+    std::vector<uint8_t> m_pending;
+};
+
+int main(int argc, char* argv[]) {
+    bool cycles = false;
+
+    static struct option long_options[] = {
+        {"cycles", no_argument, 0, 'c'},
+        {"help",   no_argument, 0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "ch", long_options, nullptr)) != -1) {
+        switch (opt) {
+            case 'c':
+                cycles = true;
+                break;
+            case 'h':
+                print_usage(argv[0]);
+                return 0;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (optind >= argc) {
+        fprintf(stderr, "Error: No trace file specified\n\n");
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    FILE* file = fopen(argv[optind], "rb");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot open trace file '%s'\n", argv[optind]);
+        return 1;
+    }
+
+    z8000_trace_header header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != z8000_trace_header::MAGIC) {
+        fprintf(stderr, "Error: '%s' is not a Z8000 trace file\n", argv[optind]);
+        fclose(file);
+        return 1;
+    }
+    if (header.version != z8000_trace_header::VERSION || header.byte_order != 0x0102) {
+        fprintf(stderr, "Error: '%s': unsupported trace version %u or byte order %04X\n",
+                argv[optind], header.version, header.byte_order);
+        fclose(file);
+        return 1;
+    }
+
+    TracePrinter printer(header.model, cycles);
+    alignas(8) uint8_t rec[256];
+    while (fread(rec, 2, 1, file) == 1) {
+        if (rec[1] < 2 || (rec[1] > 2 && fread(rec + 2, rec[1] - 2, 1, file) != 1)) {
+            fprintf(stderr, "Error: '%s': truncated record\n", argv[optind]);
+            break;
+        }
+        printer.record(rec);
+    }
+    printer.finish();
+    fclose(file);
+    return 0;
+}